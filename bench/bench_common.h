@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+/*
+ * engine_bench helpers. Each suite times its cases with MeasureMs and prints one Report line per case.
+ * Numbers are only meaningful in Release builds (Debug keeps logging and skips optimisation).
+ */
+namespace Bench {
+
+/** Best wall time in ms of fn_ic() over lRounds_ic rounds, after one untimed warm-up call. */
+template<typename Fn>
+double MeasureMs(uint32_t lRounds_ic, Fn&& fn_ic) {
+    using Clock = std::chrono::steady_clock;
+    fn_ic();
+    double fBestMs = 1.0e30;
+    for (uint32_t i = 0u; i < lRounds_ic; ++i) {
+        const Clock::time_point tStart = Clock::now();
+        fn_ic();
+        const std::chrono::duration<double, std::milli> tElapsed = Clock::now() - tStart;
+        fBestMs = std::min(fBestMs, tElapsed.count());
+    }
+    return fBestMs;
+}
+
+/** One result line: case name, time, and a throughput of fUnits_ic per run (skipped when pUnit_ic is null). */
+inline void Report(const char* pCase_ic, double fMs_ic, double fUnits_ic = 0.0, const char* pUnit_ic = nullptr) {
+    if ((pUnit_ic != nullptr) && (fMs_ic > 0.0))
+        std::printf("  %-40s %10.3f ms  %10.2f M%s/s\n", pCase_ic, fMs_ic, fUnits_ic / (fMs_ic * 1000.0), pUnit_ic);
+    else
+        std::printf("  %-40s %10.3f ms\n", pCase_ic, fMs_ic);
+}
+
+inline const void* volatile g_pSink = nullptr;
+
+/** Keep a result alive so the optimiser cannot drop the work that produced it. */
+inline void KeepAlive(const void* p_ic) {
+    g_pSink = p_ic;
+}
+
+} // namespace Bench
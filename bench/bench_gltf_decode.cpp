@@ -0,0 +1,347 @@
+/*
+ * gltf_decode: GetMeshDataFromGltf over every primitive of the bundled models (the .glb files in models/, loaded with GltfLoader)
+ * and of a synthetic indexed grid (float3 positions, normalized uint16 UVs, normalized int8 normals, uint32 indices),
+ * against the per-component switch path it replaced.
+ */
+#include "bench_common.h"
+#include "gltf_loader.h"
+#include "gltf_mesh_utils.h"
+#include "vulkan/vulkan_utils.h"
+#include <tiny_gltf.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kGridSide = 448u;  // 200704 vertices, 400K triangles
+constexpr uint32_t kRounds = 10u;
+
+/** Append lBytes_ic of data as a new buffer view; returns its index. */
+int AddBufferView(tinygltf::Model& model_io, const void* pData_ic, size_t zBytes_ic) {
+    tinygltf::Buffer& buf = model_io.buffers[0];
+    tinygltf::BufferView bv;
+    bv.buffer = 0;
+    bv.byteOffset = buf.data.size();
+    bv.byteLength = zBytes_ic;
+    buf.data.resize(buf.data.size() + ((zBytes_ic + 3u) & ~size_t(3u)));
+    std::memcpy(buf.data.data() + bv.byteOffset, pData_ic, zBytes_ic);
+    model_io.bufferViews.push_back(bv);
+    return static_cast<int>(model_io.bufferViews.size() - 1u);
+}
+
+int AddAccessor(tinygltf::Model& model_io, int lBufferView_ic, int lComponentType_ic, int lType_ic, size_t zCount_ic, bool bNormalized_ic) {
+    tinygltf::Accessor acc;
+    acc.bufferView = lBufferView_ic;
+    acc.componentType = lComponentType_ic;
+    acc.type = lType_ic;
+    acc.count = zCount_ic;
+    acc.normalized = bNormalized_ic;
+    model_io.accessors.push_back(acc);
+    return static_cast<int>(model_io.accessors.size() - 1u);
+}
+
+tinygltf::Model BuildGridModel(uint32_t lSide_ic) {
+    const size_t zVertices = size_t(lSide_ic) * lSide_ic;
+    std::vector<float> vecPositions(zVertices * 3u);
+    std::vector<uint16_t> vecUVs(zVertices * 2u);
+    std::vector<int8_t> vecNormals(zVertices * 3u);
+    for (uint32_t y = 0u; y < lSide_ic; ++y) {
+        for (uint32_t x = 0u; x < lSide_ic; ++x) {
+            const size_t v = size_t(y) * lSide_ic + x;
+            const float fU = float(x) / float(lSide_ic - 1u);
+            const float fV = float(y) / float(lSide_ic - 1u);
+            vecPositions[v * 3u + 0u] = fU * 100.0f;
+            vecPositions[v * 3u + 1u] = std::sin(fU * 20.0f) * std::cos(fV * 20.0f);
+            vecPositions[v * 3u + 2u] = fV * 100.0f;
+            vecUVs[v * 2u + 0u] = static_cast<uint16_t>(fU * 65535.0f);
+            vecUVs[v * 2u + 1u] = static_cast<uint16_t>(fV * 65535.0f);
+            vecNormals[v * 3u + 0u] = static_cast<int8_t>((x * 7u) % 255u - 127);
+            vecNormals[v * 3u + 1u] = 127;
+            vecNormals[v * 3u + 2u] = static_cast<int8_t>((y * 5u) % 255u - 127);
+        }
+    }
+    std::vector<uint32_t> vecIndices;
+    vecIndices.reserve(size_t(lSide_ic - 1u) * (lSide_ic - 1u) * 6u);
+    for (uint32_t y = 0u; y + 1u < lSide_ic; ++y) {
+        for (uint32_t x = 0u; x + 1u < lSide_ic; ++x) {
+            const uint32_t l00 = y * lSide_ic + x;
+            const uint32_t l10 = l00 + 1u;
+            const uint32_t l01 = l00 + lSide_ic;
+            const uint32_t l11 = l01 + 1u;
+            vecIndices.insert(vecIndices.end(), { l00, l01, l10, l10, l01, l11 });
+        }
+    }
+
+    tinygltf::Model model;
+    model.buffers.resize(1u);
+    tinygltf::Primitive prim;
+    prim.mode = TINYGLTF_MODE_TRIANGLES;
+    prim.attributes["POSITION"] = AddAccessor(model, AddBufferView(model, vecPositions.data(), vecPositions.size() * sizeof(float)),
+                                              TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, zVertices, false);
+    prim.attributes["TEXCOORD_0"] = AddAccessor(model, AddBufferView(model, vecUVs.data(), vecUVs.size() * sizeof(uint16_t)),
+                                                TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_VEC2, zVertices, true);
+    prim.attributes["NORMAL"] = AddAccessor(model, AddBufferView(model, vecNormals.data(), vecNormals.size()),
+                                            TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_TYPE_VEC3, zVertices, true);
+    prim.indices = AddAccessor(model, AddBufferView(model, vecIndices.data(), vecIndices.size() * sizeof(uint32_t)),
+                               TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT, TINYGLTF_TYPE_SCALAR, vecIndices.size(), false);
+    tinygltf::Mesh mesh;
+    mesh.primitives.push_back(prim);
+    model.meshes.push_back(mesh);
+    return model;
+}
+
+/* Baseline: the decode GetMeshDataFromGltf used before the gather kernels (switch per component, one float
+ * vector per attribute, then an interleave pass). Triangle lists only, which is what the bundled models use. */
+size_t ComponentSizeBytes(int lComponentType_ic) {
+    switch (lComponentType_ic) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE:
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        return 1u;
+    case TINYGLTF_COMPONENT_TYPE_SHORT:
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        return 2u;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+    case TINYGLTF_COMPONENT_TYPE_FLOAT:
+        return 4u;
+    default:
+        return 0u;
+    }
+}
+
+float ReadComponentAsFloat(const unsigned char* p_ic, int lComponentType_ic, bool bNormalized_ic) {
+    switch (lComponentType_ic) {
+    case TINYGLTF_COMPONENT_TYPE_FLOAT: {
+        float v = 0.f;
+        std::memcpy(&v, p_ic, sizeof(float));
+        return v;
+    }
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
+        const uint8_t v = *p_ic;
+        return bNormalized_ic ? (static_cast<float>(v) / 255.0f) : static_cast<float>(v);
+    }
+    case TINYGLTF_COMPONENT_TYPE_BYTE: {
+        const int8_t v = *reinterpret_cast<const int8_t*>(p_ic);
+        return bNormalized_ic ? std::max(-1.0f, static_cast<float>(v) / 127.0f) : static_cast<float>(v);
+    }
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+        uint16_t v = 0;
+        std::memcpy(&v, p_ic, sizeof(uint16_t));
+        return bNormalized_ic ? (static_cast<float>(v) / 65535.0f) : static_cast<float>(v);
+    }
+    case TINYGLTF_COMPONENT_TYPE_SHORT: {
+        int16_t v = 0;
+        std::memcpy(&v, p_ic, sizeof(int16_t));
+        return bNormalized_ic ? std::max(-1.0f, static_cast<float>(v) / 32767.0f) : static_cast<float>(v);
+    }
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
+        uint32_t v = 0;
+        std::memcpy(&v, p_ic, sizeof(uint32_t));
+        return bNormalized_ic ? static_cast<float>(static_cast<double>(v) / 4294967295.0) : static_cast<float>(v);
+    }
+    default:
+        return 0.f;
+    }
+}
+
+/** First element of an accessor's data and its stride (byteStride honoured); null when it overruns the buffer. */
+const unsigned char* AccessorData(const tinygltf::Model& model_ic, const tinygltf::Accessor& acc_ic, size_t zElementSize_ic,
+                                  size_t& zStride_out) {
+    const tinygltf::BufferView& bv = model_ic.bufferViews[size_t(acc_ic.bufferView)];
+    const tinygltf::Buffer& buf = model_ic.buffers[size_t(bv.buffer)];
+    zStride_out = (bv.byteStride > 0) ? size_t(bv.byteStride) : zElementSize_ic;
+    const size_t zBase = size_t(bv.byteOffset) + size_t(acc_ic.byteOffset);
+    if (zBase + size_t(acc_ic.count) * zStride_out > buf.data.size())
+        return nullptr;
+    return buf.data.data() + zBase;
+}
+
+bool ReadAccessorAsFloatN(const tinygltf::Model& model_ic, int lAccessor_ic, size_t zComponents_ic, std::vector<float>& vecOut_out) {
+    vecOut_out.clear();
+    const tinygltf::Accessor& acc = model_ic.accessors[size_t(lAccessor_ic)];
+    const size_t zComponentSize = ComponentSizeBytes(acc.componentType);
+    size_t zStride = 0u;
+    const unsigned char* pSrc = AccessorData(model_ic, acc, zComponents_ic * zComponentSize, zStride);
+    if ((pSrc == nullptr) || (zComponentSize == 0u))
+        return false;
+    vecOut_out.resize(acc.count * zComponents_ic);
+    for (size_t i = 0; i < acc.count; ++i) {
+        for (size_t c = 0; c < zComponents_ic; ++c)
+            vecOut_out[i * zComponents_ic + c] = ReadComponentAsFloat(pSrc + i * zStride + c * zComponentSize,
+                                                                      acc.componentType, acc.normalized);
+    }
+    return true;
+}
+
+bool ReadIndices(const tinygltf::Model& model_ic, int lAccessor_ic, std::vector<uint32_t>& vecOut_out) {
+    vecOut_out.clear();
+    const tinygltf::Accessor& acc = model_ic.accessors[size_t(lAccessor_ic)];
+    const size_t zComponentSize = ComponentSizeBytes(acc.componentType);
+    size_t zStride = 0u;
+    const unsigned char* pSrc = AccessorData(model_ic, acc, zComponentSize, zStride);
+    if ((pSrc == nullptr) || (zComponentSize == 0u))
+        return false;
+    vecOut_out.resize(acc.count);
+    for (size_t i = 0; i < acc.count; ++i) {
+        const unsigned char* p = pSrc + i * zStride;
+        switch (acc.componentType) {
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            vecOut_out[i] = *p;
+            break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+            uint16_t v = 0;
+            std::memcpy(&v, p, sizeof(uint16_t));
+            vecOut_out[i] = v;
+            break;
+        }
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+            std::memcpy(&vecOut_out[i], p, sizeof(uint32_t));
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DecodeBaseline(const tinygltf::Model& model_ic, int lMesh_ic, int lPrimitive_ic, std::vector<VertexData>& vecOut_out) {
+    vecOut_out.clear();
+    const tinygltf::Primitive& prim = model_ic.meshes[size_t(lMesh_ic)].primitives[size_t(lPrimitive_ic)];
+    if (prim.mode != TINYGLTF_MODE_TRIANGLES)
+        return false;
+    const auto itPos = prim.attributes.find("POSITION");
+    std::vector<float> vecPositions, vecUVs, vecNormals;
+    if ((itPos == prim.attributes.end()) || (ReadAccessorAsFloatN(model_ic, itPos->second, 3u, vecPositions) == false))
+        return false;
+    const size_t zVertices = vecPositions.size() / 3u;
+    const auto itUV = prim.attributes.find("TEXCOORD_0");
+    if ((itUV != prim.attributes.end()) && (ReadAccessorAsFloatN(model_ic, itUV->second, 2u, vecUVs) == true) && (vecUVs.size() / 2u != zVertices))
+        vecUVs.clear();
+    const auto itNormal = prim.attributes.find("NORMAL");
+    if ((itNormal != prim.attributes.end()) && (ReadAccessorAsFloatN(model_ic, itNormal->second, 3u, vecNormals) == true) && (vecNormals.size() / 3u != zVertices))
+        vecNormals.clear();
+
+    std::vector<uint32_t> vecIndices;
+    if (prim.indices >= 0) {
+        if (ReadIndices(model_ic, prim.indices, vecIndices) == false)
+            return false;
+    } else {
+        vecIndices.resize(zVertices);
+        for (size_t i = 0; i < zVertices; ++i)
+            vecIndices[i] = static_cast<uint32_t>(i);
+    }
+
+    vecOut_out.reserve(vecIndices.size());
+    for (uint32_t idx : vecIndices) {
+        if (idx >= zVertices)
+            continue;
+        VertexData v;
+        std::memcpy(v.position, &vecPositions[idx * 3u], sizeof(v.position));
+        if (vecUVs.empty() == false) {
+            std::memcpy(v.uv, &vecUVs[idx * 2u], sizeof(v.uv));
+        } else {
+            v.uv[0] = 0.f;
+            v.uv[1] = 0.f;
+        }
+        if (vecNormals.empty() == false) {
+            std::memcpy(v.normal, &vecNormals[idx * 3u], sizeof(v.normal));
+        } else {
+            v.normal[0] = 0.f;
+            v.normal[1] = 0.f;
+            v.normal[2] = 1.f;
+        }
+        vecOut_out.push_back(v);
+    }
+    return vecOut_out.empty() == false;
+}
+
+float MaxAbsDifference(const std::vector<VertexData>& vecA_ic, const std::vector<VertexData>& vecB_ic) {
+    if (vecA_ic.size() != vecB_ic.size())
+        return INFINITY;
+    float fMax = 0.f;
+    for (size_t i = 0; i < vecA_ic.size(); ++i) {
+        const float* pA = vecA_ic[i].position;
+        const float* pB = vecB_ic[i].position;
+        for (size_t c = 0; c < sizeof(VertexData) / sizeof(float); ++c)
+            fMax = std::max(fMax, std::fabs(pA[c] - pB[c]));
+    }
+    return fMax;
+}
+
+/** One decoded primitive per entry: every primitive of every mesh, in order. */
+struct PrimitiveRef {
+    int lMesh = 0;
+    int lPrimitive = 0;
+};
+
+std::vector<PrimitiveRef> ListPrimitives(const tinygltf::Model& model_ic) {
+    std::vector<PrimitiveRef> vecPrimitives;
+    for (size_t m = 0; m < model_ic.meshes.size(); ++m)
+        for (size_t p = 0; p < model_ic.meshes[m].primitives.size(); ++p)
+            vecPrimitives.push_back({ static_cast<int>(m), static_cast<int>(p) });
+    return vecPrimitives;
+}
+
+/** Decode every primitive of the model with the kernels and with the baseline, and report both. */
+void BenchModel(const char* pLabel_ic, const tinygltf::Model& model_ic) {
+    const std::vector<PrimitiveRef> vecPrimitives = ListPrimitives(model_ic);
+    std::vector<std::vector<VertexData>> vecBaseline(vecPrimitives.size());
+    std::vector<std::vector<VertexData>> vecKernels(vecPrimitives.size());
+    std::vector<Meshlet> vecMeshlets;
+    size_t zMeshlets = 0u;
+
+    const double fBaselineMs = Bench::MeasureMs(kRounds, [&]() {
+        for (size_t i = 0; i < vecPrimitives.size(); ++i)
+            DecodeBaseline(model_ic, vecPrimitives[i].lMesh, vecPrimitives[i].lPrimitive, vecBaseline[i]);
+    });
+    const double fKernelMs = Bench::MeasureMs(kRounds, [&]() {
+        for (size_t i = 0; i < vecPrimitives.size(); ++i)
+            GetMeshDataFromGltf(model_ic, vecPrimitives[i].lMesh, vecPrimitives[i].lPrimitive, vecKernels[i]);
+    });
+    const double fMeshletMs = Bench::MeasureMs(kRounds, [&]() {
+        zMeshlets = 0u;
+        for (size_t i = 0; i < vecPrimitives.size(); ++i) {
+            GetMeshDataFromGltf(model_ic, vecPrimitives[i].lMesh, vecPrimitives[i].lPrimitive, vecKernels[i], &vecMeshlets);
+            zMeshlets += vecMeshlets.size();
+        }
+    });
+    Bench::KeepAlive(vecBaseline.data());
+    Bench::KeepAlive(vecMeshlets.data());
+
+    size_t zOutVertices = 0u;
+    float fMaxDifference = 0.f;
+    for (size_t i = 0; i < vecPrimitives.size(); ++i) {
+        zOutVertices += vecKernels[i].size();
+        fMaxDifference = std::max(fMaxDifference, MaxAbsDifference(vecKernels[i], vecBaseline[i]));
+    }
+    std::printf("  %s: %zu primitives, %zu expanded vertices\n", pLabel_ic, vecPrimitives.size(), zOutVertices);
+    Bench::Report("baseline (per-component switch)", fBaselineMs, double(zOutVertices), "vert");
+    Bench::Report("GetMeshDataFromGltf", fKernelMs, double(zOutVertices), "vert");
+    Bench::Report("GetMeshDataFromGltf + meshlets", fMeshletMs, double(zOutVertices), "vert");
+    std::printf("  max |kernel - baseline| = %g, %zu meshlets\n", double(fMaxDifference), zMeshlets);
+}
+
+} // namespace
+
+void RunGltfDecodeBench() {
+    /* Bundled models, loaded the way levels load them (images left encoded: decode time is not part of this suite). */
+    const char* const kModels[] = { "models/DamagedHelmet.glb", "models/Duck.glb", "models/BoxTextured.glb" };
+    for (const char* pModel : kModels) {
+        GltfLoader loader;
+        loader.SetDeferImageDecode(true);
+        if ((loader.LoadFromFile(VulkanUtils::GetResourcePath(pModel)) == false) || (loader.GetModel() == nullptr)) {
+            std::printf("  %s: could not be loaded, skipped\n", pModel);
+            continue;
+        }
+        BenchModel(pModel, *loader.GetModel());
+    }
+
+    /* Synthetic grid: quantized UVs and normals, which none of the bundled models use. */
+    const tinygltf::Model model = BuildGridModel(kGridSide);
+    const size_t zVertices = size_t(kGridSide) * kGridSide;
+    char szLabel[96];
+    std::snprintf(szLabel, sizeof(szLabel), "grid %ux%u (%zu source vertices)", kGridSide, kGridSide, zVertices);
+    BenchModel(szLabel, model);
+}
@@ -0,0 +1,258 @@
+/*
+ * level_import: the worker phase of importing levels/helmet_stress (SceneManager::PrefetchGltfSources with a cold
+ * cache) on JobQueues of 1, 2, 4 ... N workers. Phase 1 parses each distinct glTF source (one task per file, images
+ * kept encoded); phase 2 runs one task per primitive (GetMeshDataFromGltf + meshlets) and one per material texture
+ * slot (decode, RGBA8 expansion, CPU mips, BC encode with the role's format, as on a device with BC). .vmesh / .vtex
+ * cache files are neither read nor written. The main thread waits through WaitForTask, so it helps run tasks too.
+ */
+#include "bench_common.h"
+#include "bc_codec.h"
+#include "cpu_topology.h"
+#include "gltf_loader.h"
+#include "gltf_mesh_utils.h"
+#include "job_queue.h"
+#include "mip_generator.h"
+#include "pixel_convert.h"
+#include "vulkan/vulkan_utils.h"
+#include <nlohmann/json.hpp>
+#include <tiny_gltf.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr const char* kLevelPath = "levels/helmet_stress/level.json";
+constexpr uint32_t kRounds = 2u;
+
+/** Texture slot roles, as SceneManager lists them; colour roles filter mips in linear space (sRGB). */
+enum class SlotRole : uint8_t { BaseColor, MetallicRoughness, Emissive, Normal, Occlusion };
+
+BCFormat GetRoleBCFormat(SlotRole eRole_ic) {
+    switch (eRole_ic) {
+    case SlotRole::BaseColor:
+    case SlotRole::Emissive:          return BCFormat::BC7;
+    case SlotRole::Normal:            return BCFormat::BC5;
+    case SlotRole::MetallicRoughness: return BCFormat::BC1;
+    case SlotRole::Occlusion:         return BCFormat::BC4;
+    }
+    return BCFormat::BC7;
+}
+
+/** Distinct glTF sources of the level (instances share them), resolved against the level's directory. */
+std::vector<std::string> ReadLevelSources(const std::string& sLevelPath_ic) {
+    std::vector<std::string> vecSources;
+    std::ifstream file(sLevelPath_ic);
+    if (file.is_open() == false)
+        return vecSources;
+    const nlohmann::json jLevel = nlohmann::json::parse(file, nullptr, false);
+    if ((jLevel.is_discarded() == true) || (jLevel.contains("instances") == false) || (jLevel["instances"].is_array() == false))
+        return vecSources;
+    const std::filesystem::path baseDir = std::filesystem::path(sLevelPath_ic).parent_path();
+    std::set<std::string> seen;
+    for (const nlohmann::json& jInst : jLevel["instances"]) {
+        if ((jInst.contains("source") == false) || (jInst["source"].is_string() == false))
+            continue;
+        const std::string sSource = jInst["source"].get<std::string>();
+        if (sSource.rfind("procedural:", 0) == 0)
+            continue;
+        const std::string sPath = (baseDir / sSource).lexically_normal().string();
+        if (seen.insert(sPath).second == true)
+            vecSources.push_back(sPath);
+    }
+    return vecSources;
+}
+
+struct ParseTask {
+    std::string sPath;
+    std::unique_ptr<tinygltf::Model> pModel;
+};
+
+struct MeshTask {
+    const tinygltf::Model* pModel = nullptr;
+    int lMesh = 0;
+    int lPrimitive = 0;
+    std::vector<VertexData> vecVertices;
+    std::vector<Meshlet> vecMeshlets;
+};
+
+struct TextureTask {
+    const tinygltf::Image* pImage = nullptr;
+    SlotRole eRole = SlotRole::BaseColor;
+    std::vector<uint8_t> vecEncoded;
+};
+
+void RunParseTask(ParseTask* pTask_io) {
+    GltfLoader loader;
+    loader.SetDeferImageDecode(true);
+    if (loader.LoadFromFile(pTask_io->sPath) == true)
+        pTask_io->pModel = loader.ReleaseModel();
+}
+
+void RunMeshTask(MeshTask* pTask_io) {
+    GetMeshDataFromGltf(*pTask_io->pModel, pTask_io->lMesh, pTask_io->lPrimitive, pTask_io->vecVertices, &pTask_io->vecMeshlets);
+}
+
+/* TextureManager::CookTexture for a BC role: level 0 expanded into the chain, CPU mips, every level encoded. */
+void RunTextureTask(TextureTask* pTask_io) {
+    std::vector<uint8_t> vecPixels;
+    int iWidth = 0;
+    int iHeight = 0;
+    int iComponents = 0;
+    if (DecodeGltfImage(*pTask_io->pImage, vecPixels, iWidth, iHeight, iComponents) == false)
+        return;
+    const uint32_t lWidth = static_cast<uint32_t>(iWidth);
+    const uint32_t lHeight = static_cast<uint32_t>(iHeight);
+    std::vector<MipLevelDesc> vecLevels;
+    std::vector<uint8_t> vecChain(ComputeMipChainLayout(lWidth, lHeight, ComputeMipLevelCount(lWidth, lHeight), vecLevels));
+    ExpandToRGBA8(vecPixels.data(), size_t(lWidth) * lHeight, static_cast<uint32_t>(iComponents), vecChain.data());
+    const bool bSrgb = (pTask_io->eRole == SlotRole::BaseColor) || (pTask_io->eRole == SlotRole::Emissive);
+    GenerateMipLevelsRGBA8(vecChain.data(), vecLevels, bSrgb);
+
+    const BCFormat eBC = GetRoleBCFormat(pTask_io->eRole);
+    size_t zTotal = 0u;
+    for (const MipLevelDesc& st : vecLevels)
+        zTotal += GetBCImageSize(eBC, st.lWidth, st.lHeight);
+    pTask_io->vecEncoded.resize(zTotal);
+    size_t zOffset = 0u;
+    for (const MipLevelDesc& st : vecLevels) {
+        EncodeBCImage(eBC, vecChain.data() + st.zOffset, st.lWidth, st.lHeight, pTask_io->vecEncoded.data() + zOffset);
+        zOffset += GetBCImageSize(eBC, st.lWidth, st.lHeight);
+    }
+}
+
+/** Texture slots of every material, one per (image, role) like the texture cache keys. */
+void ListTextureSlots(const tinygltf::Model& model_ic, std::vector<std::unique_ptr<TextureTask>>& vecTasks_out) {
+    std::set<std::pair<int, SlotRole>> seen;
+    for (const tinygltf::Material& mat : model_ic.materials) {
+        const std::pair<int, SlotRole> slots[] = {
+            { mat.pbrMetallicRoughness.baseColorTexture.index, SlotRole::BaseColor },
+            { mat.pbrMetallicRoughness.metallicRoughnessTexture.index, SlotRole::MetallicRoughness },
+            { mat.emissiveTexture.index, SlotRole::Emissive },
+            { mat.normalTexture.index, SlotRole::Normal },
+            { mat.occlusionTexture.index, SlotRole::Occlusion },
+        };
+        for (const auto& [iTexture, eRole] : slots) {
+            if ((iTexture < 0) || (size_t(iTexture) >= model_ic.textures.size()))
+                continue;
+            const int iImage = model_ic.textures[size_t(iTexture)].source;
+            if ((iImage < 0) || (size_t(iImage) >= model_ic.images.size()) || (seen.insert({ iImage, eRole }).second == false))
+                continue;
+            auto pTask = std::make_unique<TextureTask>();
+            pTask->pImage = &model_ic.images[size_t(iImage)];
+            pTask->eRole = eRole;
+            vecTasks_out.push_back(std::move(pTask));
+        }
+    }
+}
+
+struct ImportRun {
+    double fParseMs = 0.0;
+    double fDecodeMs = 0.0;
+    size_t zMeshTasks = 0u;
+    size_t zTextureTasks = 0u;
+};
+
+/** Both phases once on jobQueue_io, waiting for each before the next like PrefetchGltfSources. */
+ImportRun RunImport(JobQueue& jobQueue_io, const std::vector<std::string>& vecSources_ic) {
+    using Clock = std::chrono::steady_clock;
+    ImportRun stRun;
+    const Clock::time_point tStart = Clock::now();
+
+    std::vector<std::unique_ptr<ParseTask>> vecParse;
+    std::vector<std::shared_ptr<TaskResult>> vecHandles;
+    for (const std::string& sPath : vecSources_ic) {
+        auto pTask = std::make_unique<ParseTask>();
+        pTask->sPath = sPath;
+        vecHandles.push_back(jobQueue_io.SubmitTask(std::bind(&RunParseTask, pTask.get())));
+        vecParse.push_back(std::move(pTask));
+    }
+    for (const std::shared_ptr<TaskResult>& pHandle : vecHandles)
+        jobQueue_io.WaitForTask(pHandle);
+    const Clock::time_point tParsed = Clock::now();
+
+    std::vector<std::unique_ptr<MeshTask>> vecMeshes;
+    std::vector<std::unique_ptr<TextureTask>> vecTextures;
+    vecHandles.clear();
+    for (const std::unique_ptr<ParseTask>& pParse : vecParse) {
+        if (pParse->pModel == nullptr)
+            continue;
+        const tinygltf::Model& model = *pParse->pModel;
+        for (size_t m = 0; m < model.meshes.size(); ++m) {
+            for (size_t p = 0; p < model.meshes[m].primitives.size(); ++p) {
+                auto pTask = std::make_unique<MeshTask>();
+                pTask->pModel = &model;
+                pTask->lMesh = static_cast<int>(m);
+                pTask->lPrimitive = static_cast<int>(p);
+                vecHandles.push_back(jobQueue_io.SubmitTask(std::bind(&RunMeshTask, pTask.get())));
+                vecMeshes.push_back(std::move(pTask));
+            }
+        }
+        const size_t zFirstTexture = vecTextures.size();
+        ListTextureSlots(model, vecTextures);
+        for (size_t i = zFirstTexture; i < vecTextures.size(); ++i)
+            vecHandles.push_back(jobQueue_io.SubmitTask(std::bind(&RunTextureTask, vecTextures[i].get())));
+    }
+    for (const std::shared_ptr<TaskResult>& pHandle : vecHandles)
+        jobQueue_io.WaitForTask(pHandle);
+    const Clock::time_point tDone = Clock::now();
+
+    for (const std::unique_ptr<TextureTask>& pTask : vecTextures)
+        Bench::KeepAlive(pTask->vecEncoded.data());
+    stRun.fParseMs = std::chrono::duration<double, std::milli>(tParsed - tStart).count();
+    stRun.fDecodeMs = std::chrono::duration<double, std::milli>(tDone - tParsed).count();
+    stRun.zMeshTasks = vecMeshes.size();
+    stRun.zTextureTasks = vecTextures.size();
+    return stRun;
+}
+
+} // namespace
+
+void RunLevelImportBench() {
+    const std::string sLevelPath = VulkanUtils::GetResourcePath(kLevelPath);
+    const std::vector<std::string> vecSources = ReadLevelSources(sLevelPath);
+    if (vecSources.empty() == true) {
+        std::printf("  %s: no glTF sources found, skipped\n", sLevelPath.c_str());
+        return;
+    }
+    const CpuTopology stTopology = CpuTopology::Query();
+    const uint32_t lMaxWorkers = std::max<uint32_t>(1u, static_cast<uint32_t>(stTopology.vecCores.size()));
+    std::vector<uint32_t> vecWorkerCounts;
+    for (uint32_t lWorkers = 1u; lWorkers < lMaxWorkers; lWorkers *= 2u)
+        vecWorkerCounts.push_back(lWorkers);
+    vecWorkerCounts.push_back(lMaxWorkers);
+    std::printf("  %s: %zu distinct sources, %zu logical CPUs, best of %u\n", kLevelPath, vecSources.size(),
+                stTopology.vecCores.size(), kRounds);
+
+    double fSerialMs = 0.0;
+    for (uint32_t lWorkers : vecWorkerCounts) {
+        WorkerPoolOptions stOptions;
+        stOptions.lWorkerThreads = lWorkers;
+        JobQueue jobQueue;
+        jobQueue.Start(stOptions);
+        ImportRun stBest;
+        const double fMs = Bench::MeasureMs(kRounds, [&]() {
+            const ImportRun stRun = RunImport(jobQueue, vecSources);
+            if ((stBest.fParseMs == 0.0) || (stRun.fParseMs + stRun.fDecodeMs < stBest.fParseMs + stBest.fDecodeMs))
+                stBest = stRun;
+        });
+        jobQueue.Stop();
+        if (lWorkers == 1u)
+            fSerialMs = fMs;
+
+        char szCase[64];
+        std::snprintf(szCase, sizeof(szCase), "%u worker%s", lWorkers, (lWorkers == 1u) ? "" : "s");
+        Bench::Report(szCase, fMs);
+        std::printf("  %-40s parse %.1f ms, %zu mesh + %zu texture tasks %.1f ms, x%.2f vs. 1 worker\n", "",
+                    stBest.fParseMs, stBest.zMeshTasks, stBest.zTextureTasks, stBest.fDecodeMs,
+                    (fMs > 0.0) ? fSerialMs / fMs : 0.0);
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * engine_bench: CPU micro-benchmarks of engine subsystems (no window; suites that need a GPU say so).
+ * Usage: engine_bench [suite...]   (no arguments runs every suite; --list prints the names)
+ */
+#include <cstdio>
+#include <cstring>
+
+void RunGltfDecodeBench();
+void RunLevelImportBench();
+void RunMipsBench();
+void RunMpscRingBench();
+void RunPipelineCacheBench();
+void RunPixelConvertBench();
+void RunSceneSpawnBench();
+void RunSchedulerBench();
+void RunWorkerAffinityBench();
+
+namespace {
+
+struct BenchSuite {
+    const char* pName;
+    const char* pDescription;
+    void (*pfnRun)();
+};
+
+constexpr BenchSuite kSuites[] = {
+    { "gltf_decode", "glTF accessor decode of the bundled models and a synthetic grid (loaders/gltf_mesh_utils)", &RunGltfDecodeBench },
+    { "level_import", "helmet_stress parse + mesh/texture decode phase on 1, 2, 4 ... N workers (managers/scene_manager)", &RunLevelImportBench },
+    { "mips",        "CPU RGBA8 mip chain, linear / sRGB, calling thread / JobQueue (loaders/mip_generator)", &RunMipsBench },
+    { "mpsc_ring",   "MpscRing vs. mutex + std::queue with 1 / 4 / 8 producers (thread/mpsc_ring)", &RunMpscRingBench },
+    { "pipeline_cache", "Startup pipelines built cold vs. with a saved VkPipelineCache; needs a GPU (vulkan/vulkan_pipeline_cache)", &RunPipelineCacheBench },
+    { "pixel_convert", "RGBA8 expansion and sRGB <-> linear kernels vs. a per-channel loop (loaders/pixel_convert)", &RunPixelConvertBench },
+    { "scene_spawn", "100K renderables: per-object CreateGameObject vs. CreateGameObjects (scene/scene_unified)", &RunSceneSpawnBench },
+    { "scheduler",   "TaskScheduler throughput, steal / idle counters; old mutex queue baseline (thread/task_scheduler)", &RunSchedulerBench },
+    { "worker_affinity", "Texture load + mip cook under worker_affinity none / pin / numa (thread/cpu_topology)", &RunWorkerAffinityBench },
+};
+
+void RunSuite(const BenchSuite& stSuite_ic) {
+    std::printf("[%s] %s\n", stSuite_ic.pName, stSuite_ic.pDescription);
+    stSuite_ic.pfnRun();
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if ((argc > 1) && (std::strcmp(argv[1], "--list") == 0)) {
+        for (const BenchSuite& stSuite : kSuites)
+            std::printf("%-16s %s\n", stSuite.pName, stSuite.pDescription);
+        return 0;
+    }
+    if (argc <= 1) {
+        for (const BenchSuite& stSuite : kSuites)
+            RunSuite(stSuite);
+        return 0;
+    }
+    int lResult = 0;
+    for (int i = 1; i < argc; ++i) {
+        const BenchSuite* pSuite = nullptr;
+        for (const BenchSuite& stSuite : kSuites) {
+            if (std::strcmp(stSuite.pName, argv[i]) == 0)
+                pSuite = &stSuite;
+        }
+        if (pSuite == nullptr) {
+            std::fprintf(stderr, "Unknown suite '%s' (see --list)\n", argv[i]);
+            lResult = 1;
+            continue;
+        }
+        RunSuite(*pSuite);
+    }
+    return lResult;
+}
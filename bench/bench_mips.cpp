@@ -0,0 +1,64 @@
+/*
+ * mips: CPU mip chain generation (loaders/mip_generator) for RGBA8 images, linear and sRGB, on the calling
+ * thread and split into row bands on JobQueue workers.
+ */
+#include "bench_common.h"
+#include "mip_generator.h"
+#include "thread/job_queue.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRounds = 5u;
+
+std::vector<uint8_t> MakeTestImage(uint32_t lWidth_ic, uint32_t lHeight_ic) {
+    std::vector<uint8_t> vecPixels(size_t(lWidth_ic) * lHeight_ic * 4u);
+    uint32_t uState = 0x9E3779B9u;
+    for (size_t i = 0; i < vecPixels.size(); i += 4u) {
+        uState = uState * 1664525u + 1013904223u;
+        vecPixels[i + 0u] = static_cast<uint8_t>(uState >> 24);
+        vecPixels[i + 1u] = static_cast<uint8_t>(uState >> 16);
+        vecPixels[i + 2u] = static_cast<uint8_t>((i / 4u) & 0xFFu);
+        vecPixels[i + 3u] = 255u;
+    }
+    return vecPixels;
+}
+
+void BenchImage(uint32_t lWidth_ic, uint32_t lHeight_ic, JobQueue* pJobQueue_ic) {
+    const std::vector<uint8_t> vecBase = MakeTestImage(lWidth_ic, lHeight_ic);
+    const uint32_t lLevels = ComputeMipLevelCount(lWidth_ic, lHeight_ic);
+    const double fPixels = double(lWidth_ic) * double(lHeight_ic);
+    std::vector<uint8_t> vecChain;
+    std::vector<MipLevelDesc> vecLevels;
+    char szCase[64];
+
+    const double fLinearMs = Bench::MeasureMs(kRounds, [&]() {
+        BuildMipChainRGBA8(vecBase.data(), lWidth_ic, lHeight_ic, lLevels, false, vecChain, vecLevels);
+    });
+    std::snprintf(szCase, sizeof(szCase), "%ux%u linear", lWidth_ic, lHeight_ic);
+    Bench::Report(szCase, fLinearMs, fPixels, "px");
+
+    const double fSrgbMs = Bench::MeasureMs(kRounds, [&]() {
+        BuildMipChainRGBA8(vecBase.data(), lWidth_ic, lHeight_ic, lLevels, true, vecChain, vecLevels);
+    });
+    std::snprintf(szCase, sizeof(szCase), "%ux%u sRGB", lWidth_ic, lHeight_ic);
+    Bench::Report(szCase, fSrgbMs, fPixels, "px");
+
+    const double fJobsMs = Bench::MeasureMs(kRounds, [&]() {
+        BuildMipChainRGBA8(vecBase.data(), lWidth_ic, lHeight_ic, lLevels, true, vecChain, vecLevels, pJobQueue_ic);
+    });
+    std::snprintf(szCase, sizeof(szCase), "%ux%u sRGB, %zu workers", lWidth_ic, lHeight_ic, pJobQueue_ic->GetWorkerThreadCount());
+    Bench::Report(szCase, fJobsMs, fPixels, "px");
+    Bench::KeepAlive(vecChain.data());
+}
+
+} // namespace
+
+void RunMipsBench() {
+    JobQueue jobQueue;
+    jobQueue.Start();
+    BenchImage(2048u, 2048u, &jobQueue);
+    BenchImage(1023u, 777u, &jobQueue);  // Odd edges on every level
+    jobQueue.Stop();
+}
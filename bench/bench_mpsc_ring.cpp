@@ -0,0 +1,129 @@
+/*
+ * mpsc_ring: MpscRing (thread/mpsc_ring) under producer contention against mutex + std::queue, with the item the
+ * JobQueue completion path carries (CompletedLoadJob). 1 / 4 / 8 producers, one consumer.
+ */
+#include "bench_common.h"
+#include "mpsc_ring.h"
+#include "job_queue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kItemsPerProducer = 50000u;
+constexpr uint32_t kRingCapacity = 1024u;
+constexpr uint32_t kRounds = 3u;
+
+class LockedQueue {
+public:
+    bool TryPush(CompletedLoadJob& stJob_io) {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_queue.push(std::move(stJob_io));
+        return true;
+    }
+    bool TryPop(CompletedLoadJob& stJob_out) {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        if (this->m_queue.empty() == true)
+            return false;
+        stJob_out = std::move(this->m_queue.front());
+        this->m_queue.pop();
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::queue<CompletedLoadJob> m_queue;
+};
+
+struct ContentionResult {
+    double fTotalMs = 0.0;
+    double fPushNs = 0.0;       // Mean producer time per successful push (retries included)
+    uint64_t uFullRetries = 0u; // Pushes that found the ring full and had to retry
+};
+
+/* Producers push kItemsPerProducer jobs each (yield and retry when full); the consumer pops until all arrived. */
+template<typename Queue>
+ContentionResult RunContention(Queue& queue_io, uint32_t lProducers_ic) {
+    using Clock = std::chrono::steady_clock;
+    std::atomic<uint32_t> lReady{0u};
+    std::atomic<bool> bGo{false};
+    std::atomic<uint64_t> uProducerNs{0u};
+    std::atomic<uint64_t> uRetries{0u};
+    std::vector<std::thread> vecProducers;
+    for (uint32_t p = 0u; p < lProducers_ic; ++p) {
+        vecProducers.emplace_back([&]() {
+            lReady.fetch_add(1u);
+            while (bGo.load(std::memory_order_acquire) == false)
+                std::this_thread::yield();
+            uint64_t uLocalRetries = 0u;
+            const Clock::time_point tStart = Clock::now();
+            for (uint32_t i = 0u; i < kItemsPerProducer; ++i) {
+                CompletedLoadJob stJob;
+                stJob.eType = LoadJobType::LoadTexture;
+                stJob.sPath = "textures/albedo.png";
+                while (queue_io.TryPush(stJob) == false) {
+                    ++uLocalRetries;
+                    std::this_thread::yield();
+                }
+            }
+            uProducerNs.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tStart).count()));
+            uRetries.fetch_add(uLocalRetries);
+        });
+    }
+    while (lReady.load() != lProducers_ic)
+        std::this_thread::yield();
+
+    const Clock::time_point tStart = Clock::now();
+    bGo.store(true, std::memory_order_release);
+    const uint64_t uExpected = uint64_t(lProducers_ic) * kItemsPerProducer;
+    uint64_t uReceived = 0u;
+    CompletedLoadJob stJob;
+    while (uReceived < uExpected) {
+        if (queue_io.TryPop(stJob) == true)
+            ++uReceived;
+        else
+            std::this_thread::yield();
+    }
+    const std::chrono::duration<double, std::milli> tTotal = Clock::now() - tStart;
+    for (std::thread& thread : vecProducers)
+        thread.join();
+
+    ContentionResult stResult;
+    stResult.fTotalMs = tTotal.count();
+    stResult.fPushNs = double(uProducerNs.load()) / double(uExpected);
+    stResult.uFullRetries = uRetries.load();
+    return stResult;
+}
+
+/* Best total time over kRounds runs (a fresh queue each run). */
+template<typename Queue, typename MakeFn>
+void BenchQueue(const char* pName_ic, uint32_t lProducers_ic, MakeFn&& fnMake_ic) {
+    ContentionResult stBest;
+    stBest.fTotalMs = 1.0e30;
+    for (uint32_t r = 0u; r < kRounds; ++r) {
+        std::unique_ptr<Queue> pQueue = fnMake_ic();
+        const ContentionResult stResult = RunContention(*pQueue, lProducers_ic);
+        if (stResult.fTotalMs < stBest.fTotalMs)
+            stBest = stResult;
+    }
+    char szCase[64];
+    std::snprintf(szCase, sizeof(szCase), "%s, %u producer(s)", pName_ic, lProducers_ic);
+    Bench::Report(szCase, stBest.fTotalMs, double(lProducers_ic) * kItemsPerProducer, "item");
+    std::printf("    mean push %.0f ns, full-ring retries %llu\n", stBest.fPushNs, static_cast<unsigned long long>(stBest.uFullRetries));
+}
+
+} // namespace
+
+void RunMpscRingBench() {
+    std::printf("  %u items per producer, ring capacity %u, %u hardware threads\n", kItemsPerProducer, kRingCapacity,
+                std::thread::hardware_concurrency());
+    for (uint32_t lProducers : { 1u, 4u, 8u }) {
+        BenchQueue<MpscRing<CompletedLoadJob>>("MpscRing", lProducers, []() { return std::make_unique<MpscRing<CompletedLoadJob>>(kRingCapacity); });
+        BenchQueue<LockedQueue>("mutex + std::queue", lProducers, []() { return std::make_unique<LockedQueue>(); });
+    }
+}
@@ -0,0 +1,324 @@
+/*
+ * pipeline_cache: the graphics pipelines VulkanApp builds at startup (vert / frag with every GraphicsPipelineParams
+ * variant its materials register, deduplicated like PipelineManager with StripDynamicState, plus the time-demo
+ * pipeline) on a headless device (vulkan/vulkan_pipeline_cache). Cold: an empty VulkanPipelineCache, as on a first
+ * launch; the last cold round saves the cache file. Warm: Create loads that file, as on every later launch.
+ * Needs a Vulkan device and the compiled shaders (shaders/ next to the executable or its parent: build the app or
+ * the compile_shaders target first); the suite says why it skipped otherwise.
+ * Drivers keep their own shader caches as well (Mesa: MESA_SHADER_CACHE_DISABLE=true, NVIDIA:
+ * __GL_SHADER_DISK_CACHE=0); without disabling them "cold" only measures what the engine's cache adds.
+ */
+#include "bench_common.h"
+#include "job_queue.h"
+#include "scene/object.h"
+#include "vulkan_config.h"
+#include "vulkan_device.h"
+#include "vulkan_instance.h"
+#include "vulkan_pipeline.h"
+#include "vulkan_pipeline_cache.h"
+#include "vulkan_render_pass.h"
+#include "vulkan_shader_manager.h"
+#include "vulkan_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kRounds = 5u;
+constexpr uint32_t kBindlessTextures = 4096u;  // BindlessTextureTable::kMaxTextures
+
+struct PipelineDesc {
+    std::string sVertPath;
+    std::string sFragPath;
+    GraphicsPipelineParams stParams;
+    const PipelineLayoutDescriptor* pLayout;
+};
+
+/* Headless device with the render pass and descriptor set layouts VulkanApp::InitVulkan creates. */
+class HeadlessContext {
+public:
+    ~HeadlessContext() { this->Destroy(); }
+
+    /** False (with the reason in sWhy_out) when there is no usable device. */
+    bool Create(std::string& sWhy_out) {
+        try {
+            return this->CreateOrThrow(sWhy_out);
+        } catch (const std::exception& e) {
+            sWhy_out = e.what();
+            return false;
+        }
+    }
+
+    void Destroy() {
+        const VkDevice device = this->m_device.GetDevice();
+        this->m_vecShaders.clear();
+        if (this->m_shaderManager.IsValid() == true)
+            this->m_shaderManager.Destroy();
+        this->m_jobQueue.Stop();
+        if (this->m_textureLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, this->m_textureLayout, nullptr);
+        if (this->m_mainLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, this->m_mainLayout, nullptr);
+        this->m_textureLayout = VK_NULL_HANDLE;
+        this->m_mainLayout = VK_NULL_HANDLE;
+        this->m_renderPass.Destroy();
+        this->m_device.Destroy();
+        this->m_instance.Destroy();
+    }
+
+    /** Load every module up front so the timed builds do not read files. False if one is missing. */
+    bool LoadShaders(const std::vector<PipelineDesc>& vecPipelines_ic, std::string& sWhy_out) {
+        for (const PipelineDesc& stDesc : vecPipelines_ic) {
+            for (const std::string& sPath : { stDesc.sVertPath, stDesc.sFragPath }) {
+                ShaderModulePtr pModule = this->m_shaderManager.GetShader(this->m_device.GetDevice(), sPath);
+                if (pModule == nullptr) {
+                    sWhy_out = "cannot load " + sPath;
+                    return false;
+                }
+                this->m_vecShaders.push_back(pModule);
+            }
+        }
+        return true;
+    }
+
+    /** Wall time to create all of vecPipelines_ic with cache_ic; the pipelines are destroyed afterwards, untimed. */
+    double BuildMs(const std::vector<PipelineDesc>& vecPipelines_ic, VkPipelineCache cache_ic) {
+        std::vector<std::unique_ptr<VulkanPipeline>> vecBuilt;
+        vecBuilt.reserve(vecPipelines_ic.size());
+        const auto tStart = std::chrono::steady_clock::now();
+        for (const PipelineDesc& stDesc : vecPipelines_ic) {
+            vecBuilt.push_back(std::make_unique<VulkanPipeline>());
+            vecBuilt.back()->Create(this->m_device.GetDevice(), this->m_renderPass.Get(), &this->m_shaderManager,
+                                    stDesc.sVertPath, stDesc.sFragPath, stDesc.stParams, *stDesc.pLayout,
+                                    this->m_renderPass.HasDepthAttachment(), cache_ic,
+                                    this->m_device.GetExtendedDynamicState());
+        }
+        const std::chrono::duration<double, std::milli> tElapsed = std::chrono::steady_clock::now() - tStart;
+        for (std::unique_ptr<VulkanPipeline>& pPipeline : vecBuilt)
+            pPipeline->Destroy();
+        return tElapsed.count();
+    }
+
+    const VulkanDevice& GetDevice() const { return this->m_device; }
+    VkDescriptorSetLayout GetMainLayout() const { return this->m_mainLayout; }
+    VkDescriptorSetLayout GetTextureLayout() const { return this->m_textureLayout; }
+
+private:
+    bool CreateOrThrow(std::string& sWhy_out) {
+        // No window, but VulkanDevice enables VK_KHR_swapchain, which depends on VK_KHR_surface
+        std::vector<const char*> vecExtensions = { VK_KHR_SURFACE_EXTENSION_NAME };
+        if constexpr (VulkanUtils::ENABLE_VALIDATION_LAYERS)
+            vecExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        this->m_instance.Create(vecExtensions.data(), static_cast<uint32_t>(vecExtensions.size()));
+        this->m_device.Create(this->m_instance.Get());
+        const VkDevice device = this->m_device.GetDevice();
+
+        VkFormat eDepthFormat = VK_FORMAT_UNDEFINED;
+        for (VkFormat eCandidate : { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT }) {
+            VkFormatProperties stProps = {};
+            vkGetPhysicalDeviceFormatProperties(this->m_device.GetPhysicalDevice(), eCandidate, &stProps);
+            if ((eDepthFormat == VK_FORMAT_UNDEFINED) &&
+                ((stProps.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0u))
+                eDepthFormat = eCandidate;
+        }
+        RenderPassDescriptor stRpDesc = {
+            .colorFormat       = VK_FORMAT_B8G8R8A8_SRGB,
+            .colorLoadOp       = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .colorStoreOp      = VK_ATTACHMENT_STORE_OP_STORE,
+            .colorFinalLayout  = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+            .depthFormat       = eDepthFormat,
+            .depthLoadOp       = VK_ATTACHMENT_LOAD_OP_CLEAR,
+            .depthStoreOp      = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .depthFinalLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            .sampleCount       = VK_SAMPLE_COUNT_1_BIT,
+        };
+        this->m_renderPass.Create(device, stRpDesc);
+
+        // Set 0 "main_frag_tex" (bindings 1, 2, 3, 8) and set 1, the bindless texture array
+        const VkShaderStageFlags uVertFrag = static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+        const VkDescriptorSetLayoutBinding aMainBindings[] = {
+            { 1u, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1u, uVertFrag, nullptr },
+            { 2u, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1u, uVertFrag, nullptr },
+            { 3u, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr },
+            { 8u, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1u, VK_SHADER_STAGE_VERTEX_BIT, nullptr },
+        };
+        VkDescriptorSetLayoutCreateInfo stMainInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0u,
+            .bindingCount = static_cast<uint32_t>(sizeof(aMainBindings) / sizeof(aMainBindings[0])),
+            .pBindings = aMainBindings,
+        };
+        if (vkCreateDescriptorSetLayout(device, &stMainInfo, nullptr, &this->m_mainLayout) != VK_SUCCESS) {
+            sWhy_out = "descriptor set layout main_frag_tex failed";
+            return false;
+        }
+        VkPhysicalDeviceVulkan12Properties stProps12 = {};
+        stProps12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+        VkPhysicalDeviceProperties2 stProps = {};
+        stProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        stProps.pNext = &stProps12;
+        vkGetPhysicalDeviceProperties2(this->m_device.GetPhysicalDevice(), &stProps);
+        const uint32_t lTextures = std::max(std::min({ kBindlessTextures,
+                                                       stProps12.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                                       stProps12.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                                       stProps12.maxDescriptorSetUpdateAfterBindSamplers,
+                                                       stProps12.maxDescriptorSetUpdateAfterBindSampledImages,
+                                                       stProps12.maxPerStageUpdateAfterBindResources }), 1u);
+        const VkDescriptorBindingFlags uBindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                                                       VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                                       VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        VkDescriptorSetLayoutBindingFlagsCreateInfo stFlagsInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+            .pNext = nullptr,
+            .bindingCount = 1u,
+            .pBindingFlags = &uBindingFlags,
+        };
+        const VkDescriptorSetLayoutBinding stTextureBinding = {
+            0u, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, lTextures, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr
+        };
+        VkDescriptorSetLayoutCreateInfo stTextureInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+            .pNext = &stFlagsInfo,
+            .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+            .bindingCount = 1u,
+            .pBindings = &stTextureBinding,
+        };
+        if (vkCreateDescriptorSetLayout(device, &stTextureInfo, nullptr, &this->m_textureLayout) != VK_SUCCESS) {
+            sWhy_out = "bindless texture layout failed";
+            return false;
+        }
+
+        this->m_jobQueue.Start();
+        this->m_shaderManager.Create(&this->m_jobQueue);
+        return true;
+    }
+
+    VulkanInstance m_instance;
+    VulkanDevice m_device;
+    VulkanRenderPass m_renderPass;
+    VkDescriptorSetLayout m_mainLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout m_textureLayout = VK_NULL_HANDLE;
+    JobQueue m_jobQueue;
+    VulkanShaderManager m_shaderManager;
+    std::vector<ShaderModulePtr> m_vecShaders;
+};
+
+/* Append stParams_ic unless a pipeline of the same program already covers it (PipelineManager's variant lookup). */
+void AddVariant(std::vector<PipelineDesc>& vecPipelines_io, const std::string& sVert_ic, const std::string& sFrag_ic,
+                const GraphicsPipelineParams& stParams_ic, const PipelineLayoutDescriptor* pLayout_ic,
+                const ExtendedDynamicState& stDynamic_ic) {
+    const GraphicsPipelineParams stStripped = StripDynamicState(stParams_ic, stDynamic_ic);
+    for (const PipelineDesc& stDesc : vecPipelines_io) {
+        if ((stDesc.sVertPath == sVert_ic) && (stDesc.sFragPath == sFrag_ic) && (stDesc.stParams == stStripped) &&
+            (*stDesc.pLayout == *pLayout_ic))
+            return;
+    }
+    vecPipelines_io.push_back({ sVert_ic, sFrag_ic, stStripped, pLayout_ic });
+}
+
+/* The materials VulkanApp::InitVulkan registers (default config), as pipelines. */
+std::vector<PipelineDesc> ListStartupPipelines(const PipelineLayoutDescriptor* pMainLayout_ic,
+                                               const PipelineLayoutDescriptor* pTimeDemoLayout_ic,
+                                               const ExtendedDynamicState& stDynamic_ic) {
+    GraphicsPipelineParams stMain = {
+        .topology                = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .primitiveRestartEnable  = VK_FALSE,
+        .polygonMode             = VK_POLYGON_MODE_FILL,
+        .cullMode                = static_cast<VkCullModeFlags>((VulkanConfig().bCullBackFaces == true) ? VK_CULL_MODE_BACK_BIT : VK_CULL_MODE_NONE),
+        .frontFace               = VK_FRONT_FACE_COUNTER_CLOCKWISE,
+        .lineWidth               = static_cast<float>(1.0f),
+        .rasterizationSamples    = VK_SAMPLE_COUNT_1_BIT,
+    };
+    GraphicsPipelineParams stDoubleSided = stMain;
+    stDoubleSided.cullMode = VK_CULL_MODE_NONE;
+    GraphicsPipelineParams stWire = stMain;
+    stWire.polygonMode = VK_POLYGON_MODE_LINE;
+    GraphicsPipelineParams stTransparent = stMain;
+    stTransparent.blendEnable = VK_TRUE;
+    stTransparent.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    stTransparent.depthWriteEnable = VK_FALSE;
+
+    const std::string sVert = VulkanUtils::GetResourcePath("shaders/vert.spv");
+    const std::string sFrag = VulkanUtils::GetResourcePath("shaders/frag.spv");
+    std::vector<PipelineDesc> vecPipelines;
+    // main, wire, mask, transparent, then the double-sided (_ds) materials
+    for (const GraphicsPipelineParams& stParams : { stMain, stWire, stMain, stTransparent, stDoubleSided })
+        AddVariant(vecPipelines, sVert, sFrag, stParams, pMainLayout_ic, stDynamic_ic);
+    AddVariant(vecPipelines, VulkanUtils::GetResourcePath("shaders/time_demo.vert.spv"),
+               VulkanUtils::GetResourcePath("shaders/time_demo.frag.spv"), stMain, pTimeDemoLayout_ic, stDynamic_ic);
+    return vecPipelines;
+}
+
+} // namespace
+
+void RunPipelineCacheBench() {
+    HeadlessContext context;
+    std::string sWhy;
+    if (context.Create(sWhy) == false) {
+        std::printf("  skipped: no Vulkan device (%s)\n", sWhy.c_str());
+        return;
+    }
+    const ExtendedDynamicState& stDynamic = context.GetDevice().GetExtendedDynamicState();
+    const VkShaderStageFlags uVertFrag = static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
+    const PipelineLayoutDescriptor stMainLayout = {
+        .pushConstantRanges = { { .stageFlags = uVertFrag, .offset = 0u, .size = kInstancedPushConstantSize } },
+        .descriptorSetLayouts = { context.GetMainLayout(), context.GetTextureLayout() },
+    };
+    const PipelineLayoutDescriptor stTimeDemoLayout = {
+        .pushConstantRanges = { { .stageFlags = uVertFrag, .offset = 0u, .size = 128u } },
+        .descriptorSetLayouts = { context.GetMainLayout() },
+    };
+    const std::vector<PipelineDesc> vecPipelines = ListStartupPipelines(&stMainLayout, &stTimeDemoLayout, stDynamic);
+    if (context.LoadShaders(vecPipelines, sWhy) == false) {
+        std::printf("  skipped: %s (build the app or compile_shaders first)\n", sWhy.c_str());
+        return;
+    }
+    VkPhysicalDeviceProperties stProps = {};
+    vkGetPhysicalDeviceProperties(context.GetDevice().GetPhysicalDevice(), &stProps);
+    std::printf("  %s: %zu pipelines (extended dynamic state %s), best of %u\n", stProps.deviceName,
+                vecPipelines.size(), (stDynamic.bEnabled == true) ? "on" : "off", kRounds);
+
+    const std::filesystem::path cachePath = std::filesystem::temp_directory_path() / "engine_bench_pipeline_cache.bin";
+    const VkDevice device = context.GetDevice().GetDevice();
+    const VkPhysicalDevice physicalDevice = context.GetDevice().GetPhysicalDevice();
+    std::error_code ec;
+    double fColdFirstMs = 0.0;
+    double fColdMs = 1.0e30;
+    double fNoCacheMs = 1.0e30;
+    double fWarmMs = 1.0e30;
+    size_t zLoadedBytes = 0u;
+    for (uint32_t r = 0u; r < kRounds; ++r) {
+        std::filesystem::remove(cachePath, ec);
+        VulkanPipelineCache cache;
+        cache.Create(device, physicalDevice, cachePath.string());
+        const double fMs = context.BuildMs(vecPipelines, cache.Get());
+        if (r == 0u)
+            fColdFirstMs = fMs;
+        fColdMs = std::min(fColdMs, fMs);
+        if (r + 1u == kRounds)
+            cache.Save();
+    }
+    for (uint32_t r = 0u; r < kRounds; ++r)
+        fNoCacheMs = std::min(fNoCacheMs, context.BuildMs(vecPipelines, VK_NULL_HANDLE));
+    for (uint32_t r = 0u; r < kRounds; ++r) {
+        VulkanPipelineCache cache;
+        cache.Create(device, physicalDevice, cachePath.string());
+        zLoadedBytes = cache.GetLoadedBytes();
+        fWarmMs = std::min(fWarmMs, context.BuildMs(vecPipelines, cache.Get()));
+    }
+    std::filesystem::remove(cachePath, ec);
+
+    Bench::Report("cold: first build in the process", fColdFirstMs);
+    Bench::Report("cold: empty VulkanPipelineCache", fColdMs);
+    Bench::Report("no VkPipelineCache", fNoCacheMs);
+    Bench::Report("warm: cache loaded from file", fWarmMs);
+    std::printf("  %-40s %10zu B loaded (%s)\n", "", zLoadedBytes,
+                (zLoadedBytes > 0u) ? "header matched this device and driver" : "not loaded: file rejected or empty");
+}
@@ -0,0 +1,59 @@
+/*
+ * pixel_convert: RGBA8 expansion and sRGB <-> linear kernels (loaders/pixel_convert) on a 4096x1024 image,
+ * against the per-pixel, per-channel loop the texture loader used before.
+ */
+#include "bench_common.h"
+#include "pixel_convert.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr size_t kPixels = 4096u * 1024u;
+constexpr uint32_t kRounds = 10u;
+
+/* The old expansion: channel switch per pixel, one byte at a time. */
+void ExpandPerChannel(const uint8_t* pSrc_ic, size_t zPixels_ic, uint32_t lChannels_ic, uint8_t* pDst_out) {
+    for (size_t i = 0; i < zPixels_ic; ++i) {
+        for (uint32_t c = 0u; c < 4u; ++c) {
+            uint8_t cValue = 255u;
+            if (lChannels_ic == 1u)
+                cValue = (c < 3u) ? pSrc_ic[i] : static_cast<uint8_t>(255u);
+            else if (lChannels_ic == 2u)
+                cValue = (c < 3u) ? pSrc_ic[i * 2u] : pSrc_ic[i * 2u + 1u];
+            else if (c < lChannels_ic)
+                cValue = pSrc_ic[i * lChannels_ic + c];
+            pDst_out[i * 4u + c] = cValue;
+        }
+    }
+}
+
+} // namespace
+
+void RunPixelConvertBench() {
+    std::printf("  path: %s, %zu pixels\n", GetPixelConvertPath(), kPixels);
+    std::vector<uint8_t> vecSrc(kPixels * 4u);
+    uint32_t uState = 1u;
+    for (uint8_t& cByte : vecSrc) {
+        uState = uState * 1664525u + 1013904223u;
+        cByte = static_cast<uint8_t>(uState >> 24);
+    }
+    std::vector<uint8_t> vecDst(kPixels * 4u);
+    std::vector<float> vecLinear(kPixels * 4u);
+    const char* kChannelNames[] = { "grey", "grey+alpha", "RGB" };
+    char szCase[64];
+
+    for (uint32_t lChannels = 1u; lChannels <= 3u; ++lChannels) {
+        const double fLoopMs = Bench::MeasureMs(kRounds, [&]() { ExpandPerChannel(vecSrc.data(), kPixels, lChannels, vecDst.data()); });
+        std::snprintf(szCase, sizeof(szCase), "%s -> RGBA8, per-channel loop", kChannelNames[lChannels - 1u]);
+        Bench::Report(szCase, fLoopMs, double(kPixels), "px");
+        const double fKernelMs = Bench::MeasureMs(kRounds, [&]() { ExpandToRGBA8(vecSrc.data(), kPixels, lChannels, vecDst.data()); });
+        std::snprintf(szCase, sizeof(szCase), "%s -> RGBA8, ExpandToRGBA8", kChannelNames[lChannels - 1u]);
+        Bench::Report(szCase, fKernelMs, double(kPixels), "px");
+    }
+    const double fDecodeMs = Bench::MeasureMs(kRounds, [&]() { DecodeSrgbRGBA8ToLinear(vecSrc.data(), kPixels, vecLinear.data()); });
+    Bench::Report("DecodeSrgbRGBA8ToLinear", fDecodeMs, double(kPixels), "px");
+    const double fEncodeMs = Bench::MeasureMs(kRounds, [&]() { EncodeLinearToSrgbRGBA8(vecLinear.data(), kPixels, vecDst.data()); });
+    Bench::Report("EncodeLinearToSrgbRGBA8", fEncodeMs, double(kPixels), "px");
+    Bench::KeepAlive(vecDst.data());
+}
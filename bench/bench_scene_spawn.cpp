@@ -0,0 +1,88 @@
+/*
+ * scene_spawn: 100K renderables into an empty Scene (scene/scene_unified). Per-object CreateGameObject +
+ * AddTransform + AddRenderer with a change callback (the old stress-test path), the same inside Reserve +
+ * BeginBulkEdit / EndBulkEdit, and CreateGameObjects with an archetype (what the stress generator uses now).
+ * The Scene is created and destroyed outside the timed region.
+ */
+#include "bench_common.h"
+#include "scene_unified.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kObjects = 100000u;
+constexpr uint32_t kRounds = 5u;
+
+void PlaceObject(Transform& transform_io, uint32_t lIndex_ic) {
+    transform_io.position[0] = static_cast<float>(lIndex_ic % 316u);
+    transform_io.position[2] = static_cast<float>(lIndex_ic / 316u);
+    transform_io.bDirty = true;
+}
+
+/* Best time of fnSpawn_ic(scene) over kRounds fresh scenes (one untimed warm-up); callbacks of the last run. */
+template<typename Fn>
+double MeasureSpawnMs(Fn&& fnSpawn_ic, uint32_t& lCallbacks_out) {
+    double fBestMs = 1.0e30;
+    for (uint32_t r = 0u; r <= kRounds; ++r) {
+        std::unique_ptr<Scene> pScene = std::make_unique<Scene>("bench");
+        uint32_t lCallbacks = 0u;
+        pScene->SetChangeCallback([&lCallbacks]() { ++lCallbacks; });
+        const auto tStart = std::chrono::steady_clock::now();
+        fnSpawn_ic(*pScene);
+        const std::chrono::duration<double, std::milli> tElapsed = std::chrono::steady_clock::now() - tStart;
+        Bench::KeepAlive(pScene->GetTransforms().data());
+        if (r > 0u)
+            fBestMs = std::min(fBestMs, tElapsed.count());
+        lCallbacks_out = lCallbacks;
+    }
+    return fBestMs;
+}
+
+void SpawnPerObject(Scene& scene_io) {
+    Transform transform;
+    RendererComponent renderer;
+    for (uint32_t i = 0u; i < kObjects; ++i) {
+        const uint32_t lId = scene_io.CreateGameObject();
+        PlaceObject(transform, i);
+        scene_io.AddTransform(lId, transform);
+        scene_io.AddRenderer(lId, renderer);
+    }
+}
+
+void SpawnPerObjectBulkEdit(Scene& scene_io) {
+    scene_io.BeginBulkEdit();
+    scene_io.Reserve(kObjects, kObjects);
+    SpawnPerObject(scene_io);
+    scene_io.EndBulkEdit();
+}
+
+void SpawnArchetype(Scene& scene_io) {
+    GameObjectArchetype archetype;
+    archetype.bHasRenderer = true;
+    archetype.namePrefix = "Prop";
+    const SpawnRange range = scene_io.CreateGameObjects(kObjects, archetype);
+    std::vector<Transform>& vecTransforms = scene_io.GetTransforms();
+    for (uint32_t i = 0u; i < range.count; ++i)
+        PlaceObject(vecTransforms[range.firstTransform + i], i);
+}
+
+void ReportSpawn(const char* pCase_ic, double fMs_ic, uint32_t lCallbacks_ic) {
+    Bench::Report(pCase_ic, fMs_ic, static_cast<double>(kObjects), "obj");
+    std::printf("  %-40s %10u change callbacks\n", "", lCallbacks_ic);
+}
+
+} // namespace
+
+void RunSceneSpawnBench() {
+    std::printf("  %u renderables (GameObject + Transform + Renderer), best of %u\n", kObjects, kRounds);
+    uint32_t lCallbacks = 0u;
+    double fMs = MeasureSpawnMs(&SpawnPerObject, lCallbacks);
+    ReportSpawn("CreateGameObject per object", fMs, lCallbacks);
+    fMs = MeasureSpawnMs(&SpawnPerObjectBulkEdit, lCallbacks);
+    ReportSpawn("per object, Reserve + bulk edit", fMs, lCallbacks);
+    fMs = MeasureSpawnMs(&SpawnArchetype, lCallbacks);
+    ReportSpawn("CreateGameObjects (archetype)", fMs, lCallbacks);
+}
@@ -0,0 +1,150 @@
+/*
+ * scheduler: TaskScheduler (thread/task_scheduler) throughput and its steal / idle counters on three workloads,
+ * plus the old JobQueue design (one mutex-guarded queue, notify_all per submit) on the flat workload.
+ */
+#include "bench_common.h"
+#include "task_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kFlatTasks = 100000u;
+constexpr uint32_t kTreeDepth = 16u;          // 2^16 leaves, spawned from workers
+constexpr uint32_t kParallelForCount = 1u << 20;
+constexpr uint32_t kParallelForGrain = 1024u;
+constexpr uint32_t kWorkPerTask = 200u;       // Iterations of BusyWork per task (~0.2-0.5 us)
+constexpr uint32_t kRounds = 5u;
+
+std::atomic<uint64_t> g_uSink{0u};
+
+void BusyWork(uint32_t lIterations_ic) {
+    uint64_t uValue = lIterations_ic;
+    for (uint32_t i = 0u; i < lIterations_ic; ++i)
+        uValue = uValue * 6364136223846793005ull + 1442695040888963407ull;
+    g_uSink.fetch_add(uValue & 1u, std::memory_order_relaxed);
+}
+
+/* The pre-TaskScheduler JobQueue: one std::queue behind one mutex, notify_all on every submit. */
+class MutexQueuePool {
+public:
+    explicit MutexQueuePool(uint32_t lWorkers_ic) {
+        for (uint32_t i = 0u; i < lWorkers_ic; ++i)
+            this->m_vecThreads.emplace_back([this]() { this->WorkerLoop(); });
+    }
+    ~MutexQueuePool() {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            this->m_bStop = true;
+        }
+        this->m_cv.notify_all();
+        for (std::thread& thread : this->m_vecThreads)
+            thread.join();
+    }
+    void Submit(std::function<void()> fnTask_in) {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            this->m_queue.push_back(std::move(fnTask_in));
+            ++this->m_lPending;
+        }
+        this->m_cv.notify_all();
+    }
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(this->m_mutex);
+        this->m_idleCv.wait(lock, [this]() { return this->m_lPending == 0u; });
+    }
+
+private:
+    void WorkerLoop() {
+        for (;;) {
+            std::function<void()> fnTask;
+            {
+                std::unique_lock<std::mutex> lock(this->m_mutex);
+                this->m_cv.wait(lock, [this]() { return (this->m_bStop == true) || (this->m_queue.empty() == false); });
+                if ((this->m_bStop == true) && (this->m_queue.empty() == true))
+                    return;
+                fnTask = std::move(this->m_queue.front());
+                this->m_queue.pop_front();
+            }
+            fnTask();
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            if (--this->m_lPending == 0u)
+                this->m_idleCv.notify_all();
+        }
+    }
+
+    std::vector<std::thread> m_vecThreads;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_idleCv;
+    uint32_t m_lPending = 0u;
+    bool m_bStop = false;
+};
+
+void SpawnTree(TaskScheduler& scheduler_io, TaskGroup& group_io, uint32_t lDepth_ic) {
+    if (lDepth_ic == 0u) {
+        BusyWork(kWorkPerTask);
+        return;
+    }
+    scheduler_io.Submit([&scheduler_io, &group_io, lDepth_ic]() { SpawnTree(scheduler_io, group_io, lDepth_ic - 1u); }, &group_io);
+    SpawnTree(scheduler_io, group_io, lDepth_ic - 1u);
+}
+
+void ReportStats(const TaskSchedulerStats& stStats_ic) {
+    std::printf("    executed %llu: local %llu, shared %llu, steals %llu (failed %llu), sleeps %llu, shared lock waits %llu, deque overflows %llu\n",
+                static_cast<unsigned long long>(stStats_ic.uExecuted), static_cast<unsigned long long>(stStats_ic.uLocalPops),
+                static_cast<unsigned long long>(stStats_ic.uInjectedPops), static_cast<unsigned long long>(stStats_ic.uSteals),
+                static_cast<unsigned long long>(stStats_ic.uFailedSteals), static_cast<unsigned long long>(stStats_ic.uSleeps),
+                static_cast<unsigned long long>(stStats_ic.uSharedContended), static_cast<unsigned long long>(stStats_ic.uDequeOverflows));
+}
+
+/* Fresh scheduler per workload so the counters cover that workload only (warm-up and rounds included). */
+template<typename Fn>
+void RunScheduled(const char* pCase_ic, uint32_t lWorkers_ic, double fTasksPerRun_ic, Fn&& fnRun_ic) {
+    TaskScheduler scheduler;
+    scheduler.Start(lWorkers_ic);
+    const double fMs = Bench::MeasureMs(kRounds, [&]() { fnRun_ic(scheduler); });
+    Bench::Report(pCase_ic, fMs, fTasksPerRun_ic, "task");
+    ReportStats(scheduler.GetStats());
+    scheduler.Stop();
+}
+
+} // namespace
+
+void RunSchedulerBench() {
+    const uint32_t lWorkers = std::max(2u, std::thread::hardware_concurrency() - 1u);
+    std::printf("  %u workers (%u hardware threads), %u iterations of busy work per task\n", lWorkers,
+                std::thread::hardware_concurrency(), kWorkPerTask);
+
+    {
+        MutexQueuePool pool(lWorkers);
+        const double fMs = Bench::MeasureMs(kRounds, [&]() {
+            for (uint32_t i = 0u; i < kFlatTasks; ++i)
+                pool.Submit([]() { BusyWork(kWorkPerTask); });
+            pool.WaitIdle();
+        });
+        Bench::Report("flat: mutex queue + notify_all (old)", fMs, double(kFlatTasks), "task");
+    }
+    RunScheduled("flat: TaskScheduler, main thread submits", lWorkers, double(kFlatTasks), [](TaskScheduler& scheduler_io) {
+        TaskGroup group;
+        for (uint32_t i = 0u; i < kFlatTasks; ++i)
+            scheduler_io.Submit([]() { BusyWork(kWorkPerTask); }, &group);
+        scheduler_io.Wait(group);
+    });
+    RunScheduled("tree: TaskScheduler, workers submit", lWorkers, double(1u << kTreeDepth), [](TaskScheduler& scheduler_io) {
+        TaskGroup group;
+        scheduler_io.Submit([&scheduler_io, &group]() { SpawnTree(scheduler_io, group, kTreeDepth); }, &group);
+        scheduler_io.Wait(group);
+    });
+    RunScheduled("ParallelFor 1M items, grain 1024", lWorkers, double(kParallelForCount / kParallelForGrain), [](TaskScheduler& scheduler_io) {
+        scheduler_io.ParallelFor(kParallelForCount, kParallelForGrain, [](uint32_t lBegin, uint32_t lEnd) { BusyWork((lEnd - lBegin) / 4u); });
+    });
+}
@@ -0,0 +1,6 @@
+/*
+ * stb_image implementation for engine_bench (the app gets it from texture_manager.cpp, which the bench does not build).
+ * GltfLoader reads image headers through it when loading the bundled models.
+ */
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
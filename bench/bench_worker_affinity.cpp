@@ -0,0 +1,106 @@
+/*
+ * worker_affinity: the texture-load path (SubmitLoadTexture: read, sRGB mip chain on the worker, drain with
+ * ProcessCompletedJobs) under each WorkerAffinity policy (thread/cpu_topology, config threads.worker_affinity).
+ * Files are written to a temp directory first, so later runs read from the page cache. The main thread's affinity
+ * is restored after each policy (Pin and Numa reserve it a core).
+ */
+#include "bench_common.h"
+#include "cpu_topology.h"
+#include "job_queue.h"
+#include "mip_generator.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kTextures = 48u;
+constexpr uint32_t kSize = 512u;  // 512x512 RGBA8 (1 MiB per file)
+constexpr uint32_t kRounds = 3u;
+
+std::vector<std::string> WriteTextures(const std::filesystem::path& dir_ic) {
+    std::filesystem::create_directories(dir_ic);
+    std::vector<uint8_t> vecPixels(size_t(kSize) * kSize * 4u);
+    std::vector<std::string> vecPaths;
+    uint32_t uState = 0x2545F491u;
+    for (uint32_t t = 0u; t < kTextures; ++t) {
+        for (size_t i = 0u; i < vecPixels.size(); ++i) {
+            uState = uState * 1664525u + 1013904223u;
+            vecPixels[i] = static_cast<uint8_t>(uState >> 24);
+        }
+        const std::filesystem::path path = dir_ic / ("tex_" + std::to_string(t) + ".rgba");
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(vecPixels.data()), static_cast<std::streamsize>(vecPixels.size()));
+        vecPaths.push_back(path.string());
+    }
+    return vecPaths;
+}
+
+/* Worker side of one texture: the cook step LoadTexture jobs run before the main thread uploads. */
+void CookTexture(std::vector<uint8_t>& vecData_io) {
+    if (vecData_io.size() != size_t(kSize) * kSize * 4u)
+        return;
+    std::vector<uint8_t> vecChain;
+    std::vector<MipLevelDesc> vecLevels;
+    BuildMipChainRGBA8(vecData_io.data(), kSize, kSize, ComputeMipLevelCount(kSize, kSize), true, vecChain, vecLevels);
+    vecData_io.swap(vecChain);
+}
+
+void BenchPolicy(WorkerAffinity eAffinity_ic, const std::vector<std::string>& vecPaths_ic,
+                 const std::vector<uint32_t>& vecAllCpus_ic) {
+    WorkerPoolOptions stOptions;
+    stOptions.eAffinity = eAffinity_ic;
+    const WorkerPoolPlan stPlan = PlanWorkerPool(CpuTopology::Query(), stOptions);
+
+    JobQueue jobQueue;
+    jobQueue.Start(stOptions);
+    size_t zCookedBytes = 0u;
+    const double fMs = Bench::MeasureMs(kRounds, [&]() {
+        for (const std::string& sPath : vecPaths_ic)
+            jobQueue.SubmitLoadTexture(sPath, &CookTexture);
+        uint32_t lCompleted = 0u;
+        while (lCompleted < vecPaths_ic.size()) {
+            const uint32_t lBefore = lCompleted;
+            jobQueue.ProcessCompletedJobs([&](LoadJobType, const std::string&, std::vector<uint8_t> vecData) {
+                zCookedBytes = vecData.size();
+                ++lCompleted;
+            });
+            if (lCompleted == lBefore)
+                std::this_thread::yield();  // The app polls once per frame; do not take a worker's core
+        }
+    });
+    const TaskSchedulerStats stStats = jobQueue.GetScheduler().GetStats();
+    jobQueue.Stop();
+    SetCurrentThreadAffinity(vecAllCpus_ic);
+
+    char szCase[64];
+    std::snprintf(szCase, sizeof(szCase), "%s: %zu workers, %u groups, main cpu %d", WorkerAffinityToString(eAffinity_ic),
+                  stPlan.vecWorkers.size(), stPlan.lGroupCount, stPlan.iMainCpu);
+    Bench::Report(szCase, fMs, double(kTextures) * double(kSize) * double(kSize), "px");
+    std::printf("  %-40s steals %llu (cross-group %llu), sleeps %llu, %zu B per cooked texture\n", "",
+                static_cast<unsigned long long>(stStats.uSteals), static_cast<unsigned long long>(stStats.uCrossGroupSteals),
+                static_cast<unsigned long long>(stStats.uSleeps), zCookedBytes);
+}
+
+} // namespace
+
+void RunWorkerAffinityBench() {
+    const CpuTopology stTopology = CpuTopology::Query();
+    std::vector<uint32_t> vecAllCpus;
+    for (const CpuCore& stCore : stTopology.vecCores)
+        vecAllCpus.push_back(stCore.lCpu);
+    std::printf("  %zu logical CPUs, %u physical, %u NUMA nodes%s%s; %u textures of %ux%u, best of %u\n",
+                stTopology.vecCores.size(), stTopology.GetPhysicalCoreCount(), stTopology.lNodeCount,
+                (stTopology.bHybrid == true) ? ", hybrid" : "", (stTopology.bFromOs == true) ? "" : " (guessed)",
+                kTextures, kSize, kSize, kRounds);
+
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "engine_bench_worker_affinity";
+    const std::vector<std::string> vecPaths = WriteTextures(dir);
+    for (WorkerAffinity eAffinity : { WorkerAffinity::None, WorkerAffinity::Pin, WorkerAffinity::Numa })
+        BenchPolicy(eAffinity, vecPaths, vecAllCpus);
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+}
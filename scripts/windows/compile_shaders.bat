@@ -44,6 +44,8 @@ if "%COMPILER%"=="glslc" (
     if %ERRORLEVEL% NEQ 0 ( echo Error compiling debug line fragment shader! & exit /b 1 )
     glslc %SHADER_SOURCE_DIR%\gpu_cull.comp -o %OUTPUT_DIR%\gpu_cull.spv
     if %ERRORLEVEL% NEQ 0 ( echo Error compiling GPU cull compute shader! & exit /b 1 )
+    glslc %SHADER_SOURCE_DIR%\meshlet_cull.comp -o %OUTPUT_DIR%\meshlet_cull.comp.spv
+    if %ERRORLEVEL% NEQ 0 ( echo Error compiling meshlet cull compute shader! & exit /b 1 )
 ) else (
     glslangValidator -V %SHADER_SOURCE_DIR%\vert.vert -o %OUTPUT_DIR%\vert.spv
     if %ERRORLEVEL% NEQ 0 ( echo Error compiling vertex shader! & exit /b 1 )
@@ -55,6 +57,8 @@ if "%COMPILER%"=="glslc" (
     if %ERRORLEVEL% NEQ 0 ( echo Error compiling debug line fragment shader! & exit /b 1 )
     glslangValidator -V %SHADER_SOURCE_DIR%\gpu_cull.comp -o %OUTPUT_DIR%\gpu_cull.spv
     if %ERRORLEVEL% NEQ 0 ( echo Error compiling GPU cull compute shader! & exit /b 1 )
+    glslangValidator -V %SHADER_SOURCE_DIR%\meshlet_cull.comp -o %OUTPUT_DIR%\meshlet_cull.comp.spv
+    if %ERRORLEVEL% NEQ 0 ( echo Error compiling meshlet cull compute shader! & exit /b 1 )
 )
 
 echo Shaders compiled successfully!
@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 /*
  * PBR Fragment Shader - Metallic-Roughness Workflow
@@ -39,24 +40,11 @@ layout(std140, set = 0, binding = 1) uniform GlobalUBO {
     float _pad1;
 } globalUBO;
 
-/* ---- Texture Sampler (binding 0) ---- */
-layout(set = 0, binding = 0) uniform sampler2D uTex;
-
-/* ---- Metallic-Roughness Texture (binding 4) ---- */
-/* glTF spec: Green channel = roughness, Blue channel = metallic */
-layout(set = 0, binding = 4) uniform sampler2D uMetallicRoughnessTex;
-
-/* ---- Emissive Texture (binding 5) ---- */
-/* glTF spec: RGB emissive color, multiplied by emissiveFactor from material */
-layout(set = 0, binding = 5) uniform sampler2D uEmissiveTex;
-
-/* ---- Normal Texture (binding 6) ---- */
-/* glTF spec: Tangent-space normal map (RGB where XYZ = normal * 0.5 + 0.5) */
-layout(set = 0, binding = 6) uniform sampler2D uNormalTex;
-
-/* ---- Occlusion Texture (binding 7) ---- */
-/* glTF spec: Ambient occlusion in red channel */
-layout(set = 0, binding = 7) uniform sampler2D uOcclusionTex;
+/* ---- Bindless Textures (set 1, binding 0) ---- */
+/* Every scene texture (BindlessTextureTable); slot 0 = default white. Objects pick slots via ObjectData.texIndices:
+ * baseColor, metallic-roughness (glTF: G=roughness, B=metallic), emissive (RGB), normal (tangent space, XY),
+ * occlusion (R). Indices vary per object within a draw, hence nonuniformEXT. */
+layout(set = 1, binding = 0) uniform sampler2D uTextures[];
 
 /* ---- Object Data SSBO (binding 2) ---- */
 struct ObjectData {
@@ -64,8 +52,8 @@ struct ObjectData {
     vec4 emissive;   // Emissive RGB + strength (16 bytes)
     vec4 matProps;   // x=metallic, y=roughness, z=normalScale, w=occlusion (16 bytes)
     vec4 baseColor;  // Base color RGBA (16 bytes)
-    vec4 reserved0;  // 16 bytes
-    vec4 reserved1;  // 16 bytes
+    uvec4 texIndices;  // Bindless slots: x=baseColor, y=metallicRoughness, z=emissive, w=normal (16 bytes)
+    uvec4 texIndices2; // Bindless slots: x=occlusion, yzw unused (16 bytes)
     vec4 reserved2;  // 16 bytes
     vec4 reserved3;  // 16 bytes
     vec4 reserved4;  // 16 bytes
@@ -216,15 +204,15 @@ void main() {
     
     // Sample texture with UV wrapping
     vec2 uv = fract(inUV);
-    vec4 texColor = texture(uTex, uv);
+    vec4 texColor = texture(uTextures[nonuniformEXT(objData.texIndices.x)], uv);
     
     // Sample metallic-roughness texture (glTF: G=roughness, B=metallic)
     // Note: metallic-roughness is stored in LINEAR space per glTF spec
-    vec4 mrTex = texture(uMetallicRoughnessTex, uv);
+    vec4 mrTex = texture(uTextures[nonuniformEXT(objData.texIndices.y)], uv);
     
     // Sample emissive texture (glTF: RGB emissive, multiplied by emissiveFactor)
     // Emissive textures are in sRGB space - must convert to linear
-    vec3 emissiveTex = sRGBToLinear(texture(uEmissiveTex, uv).rgb);
+    vec3 emissiveTex = sRGBToLinear(texture(uTextures[nonuniformEXT(objData.texIndices.z)], uv).rgb);
     
     // Material properties: factor * texture (per glTF spec)
     // Base color textures are in sRGB space - must convert to linear for PBR calculations
@@ -238,13 +226,16 @@ void main() {
     // Normal mapping using screenspace-derived TBN (works without vertex tangents)
     vec3 N = normalize(inNormal);
     {
-        // Sample normal texture (glTF: tangent-space normal, XYZ = normal * 0.5 + 0.5)
-        vec3 normalTex = texture(uNormalTex, uv).rgb;
+        // Sample normal texture (glTF: tangent-space normal, XY = normal * 0.5 + 0.5)
+        // Only XY is read: BC5 normal maps store two channels, Z is rebuilt from the unit length
+        vec2 normalXY = texture(uTextures[nonuniformEXT(objData.texIndices.w)], uv).rg;
         // Check if normal map is valid (not default white texture = (1,1,1))
         float normalScale = objData.matProps.z;
-        if (normalTex != vec3(1.0, 1.0, 1.0) && normalScale > 0.0) {
+        if (normalXY != vec2(1.0, 1.0) && normalScale > 0.0) {
             // Convert from [0,1] to [-1,1] range
-            vec3 tangentNormal = normalTex * 2.0 - 1.0;
+            vec3 tangentNormal;
+            tangentNormal.xy = normalXY * 2.0 - 1.0;
+            tangentNormal.z = sqrt(clamp(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0, 1.0));
             tangentNormal.xy *= normalScale;
             tangentNormal = normalize(tangentNormal);
             
@@ -366,7 +357,7 @@ void main() {
     
     // Ambient lighting with procedural environment reflection (fake IBL)
     // Apply ambient occlusion from texture (glTF: red channel, multiplied by occlusionStrength)
-    float ao = texture(uOcclusionTex, uv).r;
+    float ao = texture(uTextures[nonuniformEXT(objData.texIndices2.x)], uv).r;
     float occlusionStrength = objData.matProps.w;
     ao = mix(1.0, ao, occlusionStrength); // Blend based on strength (0 = no AO, 1 = full AO)
     
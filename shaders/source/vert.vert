@@ -27,8 +27,8 @@ struct ObjectData {
     vec4 emissive;   // Emissive RGB + strength (16 bytes)
     vec4 matProps;   // x=metallic, y=roughness, z=normalScale, w=occlusion (16 bytes)
     vec4 baseColor;  // Base color RGBA (16 bytes)
-    vec4 reserved0;  // 16 bytes
-    vec4 reserved1;  // 16 bytes
+    uvec4 texIndices;  // Bindless texture slots (frag only) (16 bytes)
+    uvec4 texIndices2; // 16 bytes
     vec4 reserved2;  // 16 bytes
     vec4 reserved3;  // 16 bytes
     vec4 reserved4;  // 16 bytes
@@ -7,6 +7,7 @@
  */
 #include "vulkan_app.h"
 #include "config_loader.h"
+#include "core/alloc_counter.h"
 #include "camera/camera_controller.h"
 #include "scene/object.h"
 #include "scene/scene_unified.h"
@@ -14,14 +15,16 @@
 #include "vulkan/vulkan_utils.h"
 #include <SDL3/SDL_keyboard.h>
 #include <SDL3/SDL_stdinc.h>
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <functional>
+#include <set>
 #include <stdexcept>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 static const char* SHADER_VERT_PATH     = "shaders/vert.spv";
@@ -38,6 +41,8 @@ static const char* PIPELINE_KEY_WIRE_UNTEX = "wire_untex";
 static const char* PIPELINE_KEY_MASK_UNTEX = "mask_untex";
 static const char* PIPELINE_KEY_TRANSPARENT_UNTEX = "transparent_untex";
 static constexpr float kDefaultPanSpeed = 0.012f;
+/** Longest wait for prewarmed pipelines after a blocking level load. */
+static constexpr float kPrewarmWaitTimeoutMs = 10000.f;
 
 #if EDITOR_BUILD
 /** Return wireframe pipeline key for a given pipeline key; if no wire variant, return same key. */
@@ -101,6 +106,67 @@ namespace {
             }
         }
     }
+
+    /** Meshes with fewer meshlets stay on the instanced per-object path (one draw per meshlet would cost more than it culls). */
+    constexpr uint32_t kMeshletCullMinMeshlets = 8u;
+
+    /** Fewest draw calls worth a recording task of their own (task + secondary command buffer overhead). */
+    constexpr uint32_t kMinDrawsPerRecordTask = 64u;
+
+    /** Point dc_io at batch_ic. Keeps dc_io's vectors and key string (their capacity is reused frame to frame) and resets every other field. */
+    void AssignBatchDrawCall(DrawCall& dc_io, const DrawBatch& batch_ic, uint32_t lPushSize_ic, uint32_t lInstanceCount_ic,
+                             const float* pLocalTransform_ic, uint32_t lObjectIndex_ic) {
+        std::vector<VkDescriptorSet> vecDescriptorSets = std::move(dc_io.descriptorSets);
+        std::vector<uint32_t> vecDynamicOffsets = std::move(dc_io.dynamicOffsets);
+        std::string sPipelineKey = std::move(dc_io.pipelineKey);
+        dc_io = DrawCall{};
+        dc_io.pipeline           = batch_ic.pipeline;
+        dc_io.pipelineLayout     = batch_ic.pipelineLayout;
+        dc_io.vertexBuffer       = batch_ic.vertexBuffer;
+        dc_io.vertexBufferOffset = batch_ic.vertexBufferOffset;
+        dc_io.pushConstantSize   = lPushSize_ic;  // Push constants built per-viewport
+        dc_io.vertexCount        = batch_ic.vertexCount;
+        dc_io.instanceCount      = lInstanceCount_ic;
+        dc_io.firstVertex        = batch_ic.firstVertex;
+        dc_io.pLocalTransform    = pLocalTransform_ic;
+        dc_io.objectIndex        = lObjectIndex_ic;
+        dc_io.rasterState        = batch_ic.rasterState;
+        vecDescriptorSets.assign(batch_ic.descriptorSets.begin(), batch_ic.descriptorSets.end());
+        vecDynamicOffsets.clear();
+        sPipelineKey.assign(batch_ic.pipelineKey);
+        dc_io.descriptorSets = std::move(vecDescriptorSets);
+        dc_io.dynamicOffsets = std::move(vecDynamicOffsets);
+        dc_io.pipelineKey    = std::move(sPipelineKey);
+    }
+
+    /** Normal-cone culling is only valid when back faces are culled: single-sided solid pipelines (not _ds, wire, transparent). */
+    bool IsMeshletConeCullAllowed(const std::string& sPipelineKey_ic, bool bCullBackFaces_ic) {
+        if (bCullBackFaces_ic == false)
+            return false;
+        if ((sPipelineKey_ic.rfind("main_", 0) != 0) && (sPipelineKey_ic.rfind("mask_", 0) != 0))
+            return false;
+        return (sPipelineKey_ic.size() < 3u) || (sPipelineKey_ic.compare(sPipelineKey_ic.size() - 3u, 3u, "_ds") != 0);
+    }
+
+    /** Rotation and positive uniform scale only (orthogonal basis columns of equal length, determinant > 0). The meshlet
+     *  cone test transforms the cone with the model basis; non-uniform scale or shear bends normals away from it and
+     *  widens the spread, and a reflection flips the winding so the rasterizer's front face points along -(M * axis). */
+    bool IsSimilarityTransform(const float* pModel_ic) {
+        const float* c0 = pModel_ic;
+        const float* c1 = pModel_ic + 4;
+        const float* c2 = pModel_ic + 8;
+        auto dot3 = [](const float* a, const float* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+        auto det3 = [](const float* a, const float* b, const float* c) {
+            return (a[1] * b[2] - a[2] * b[1]) * c[0] + (a[2] * b[0] - a[0] * b[2]) * c[1] + (a[0] * b[1] - a[1] * b[0]) * c[2];
+        };
+        const float fLen0 = dot3(c0, c0);
+        const float fLen1 = dot3(c1, c1);
+        const float fLen2 = dot3(c2, c2);
+        const float fTolerance = 1e-3f * std::max(fLen0, std::max(fLen1, fLen2));
+        return (std::fabs(fLen0 - fLen1) <= fTolerance) && (std::fabs(fLen0 - fLen2) <= fTolerance) &&
+               (std::fabs(dot3(c0, c1)) <= fTolerance) && (std::fabs(dot3(c0, c2)) <= fTolerance) &&
+               (std::fabs(dot3(c1, c2)) <= fTolerance) && (det3(c0, c1, c2) > 0.f);
+    }
 }
 
 VulkanApp::VulkanApp(const VulkanConfig& config_in)
@@ -109,10 +175,16 @@ VulkanApp::VulkanApp(const VulkanConfig& config_in)
     , m_config(config_in) {
     VulkanUtils::LogTrace("VulkanApp constructor");
     m_camera.SetPosition(m_config.fInitialCameraX, m_config.fInitialCameraY, m_config.fInitialCameraZ);
-    m_jobQueue.Start();
+    WorkerPoolOptions stWorkerOptions;
+    stWorkerOptions.lWorkerThreads = m_config.lWorkerThreads;
+    stWorkerOptions.eAffinity = WorkerAffinityFromString(m_config.sWorkerAffinity);
+    stWorkerOptions.bReserveMainCore = m_config.bReserveMainCore;
+    stWorkerOptions.bAvoidEfficiencyCores = m_config.bAvoidEfficiencyCores;
+    m_jobQueue.Start(stWorkerOptions);
     m_shaderManager.Create(&m_jobQueue);
     InitWindow();
     InitVulkan();
+    BuildFrameGraph();
 }
 
 VulkanApp::~VulkanApp() {
@@ -143,6 +215,13 @@ void VulkanApp::InitVulkan() {
     this->m_instance.Create(vecExtensions.data(), static_cast<uint32_t>(vecExtensions.size()));
     this->m_pWindow->CreateSurface(this->m_instance.Get());
     this->m_device.Create(this->m_instance.Get(), this->m_pWindow->GetSurface());
+
+    VkPhysicalDeviceMemoryProperties stMemoryProps = {};
+    vkGetPhysicalDeviceMemoryProperties(this->m_device.GetPhysicalDevice(), &stMemoryProps);
+    this->m_memoryBackend.Create(this->m_device.GetDevice(), this->m_device.GetPhysicalDevice(), this->m_device.SupportsMemoryBudget());
+    this->m_memoryAllocator.Create(&this->m_memoryBackend, stMemoryProps);
+    VulkanMemory::SetAllocator(&this->m_memoryAllocator, this->m_device.GetLimits().nonCoherentAtomSize);
+    this->m_pipelineCache.Create(this->m_device.GetDevice(), this->m_device.GetPhysicalDevice(), this->m_config.sPipelineCacheFile);
     
     /* Validate config against GPU device limits. May clamp values if exceeding limits. */
     ValidateConfigGPULimits(this->m_config, this->m_device.GetLimits());
@@ -198,14 +277,8 @@ void VulkanApp::InitVulkan() {
     static const std::string kLayoutKeyMainFragTex("main_frag_tex");
     this->m_descriptorSetLayoutManager.SetDevice(this->m_device.GetDevice());
     {
+        /* Bindings 0 and 4-7 (material textures) moved to the bindless texture array in set 1. */
         std::vector<VkDescriptorSetLayoutBinding> bindings = {
-            {
-                .binding            = 0u,
-                .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                .descriptorCount    = 1u,
-                .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
-                .pImmutableSamplers = nullptr,
-            },
             {
                 .binding            = 1u,
                 .descriptorType     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
@@ -228,34 +301,6 @@ void VulkanApp::InitVulkan() {
                 .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
                 .pImmutableSamplers = nullptr,
             },
-            {
-                .binding            = 4u,
-                .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                .descriptorCount    = 1u,
-                .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
-                .pImmutableSamplers = nullptr,
-            },
-            {
-                .binding            = 5u,
-                .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                .descriptorCount    = 1u,
-                .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
-                .pImmutableSamplers = nullptr,
-            },
-            {
-                .binding            = 6u,
-                .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                .descriptorCount    = 1u,
-                .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
-                .pImmutableSamplers = nullptr,
-            },
-            {
-                .binding            = 7u,
-                .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                .descriptorCount    = 1u,
-                .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
-                .pImmutableSamplers = nullptr,
-            },
             {
                 /* Visible indices SSBO for GPU-driven indirect draw (from GPUCuller). */
                 .binding            = 8u,
@@ -268,6 +313,10 @@ void VulkanApp::InitVulkan() {
         if (this->m_descriptorSetLayoutManager.RegisterLayout(kLayoutKeyMainFragTex, bindings) == VK_NULL_HANDLE)
             throw std::runtime_error("VulkanApp::InitVulkan: descriptor set layout main_frag_tex failed");
     }
+    /* Set 1: bindless texture array (own update-after-bind layout and pool; see BindlessTextureTable). */
+    if (this->m_bindlessTextures.Create(this->m_device.GetDevice(), this->m_device.GetPhysicalDevice(),
+                                        BindlessTextureTable::kMaxTextures, this->m_config.lMaxFramesInFlight) == false)
+        throw std::runtime_error("VulkanApp::InitVulkan: bindless texture table failed");
 
     // Use instanced push constants (96 bytes) for batched instanced rendering
     constexpr uint32_t kMainPushConstantSize = kInstancedPushConstantSize;
@@ -276,13 +325,13 @@ void VulkanApp::InitVulkan() {
         .pushConstantRanges = {
             { .stageFlags = static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), .offset = 0u, .size = kMainPushConstantSize }
         },
-        .descriptorSetLayouts = { pMainFragLayout },
+        .descriptorSetLayouts = { pMainFragLayout, this->m_bindlessTextures.GetLayout() },
     };
     PipelineLayoutDescriptor stUntexturedLayoutDesc = {
         .pushConstantRanges = {
             { .stageFlags = static_cast<VkShaderStageFlags>(VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT), .offset = 0u, .size = kMainPushConstantSize }
         },
-        .descriptorSetLayouts = { pMainFragLayout },
+        .descriptorSetLayouts = { pMainFragLayout, this->m_bindlessTextures.GetLayout() },
     };
     // glTF 2.0 spec mandates counter-clockwise winding for front faces.
     // We use CCW here to match the spec. DoubleSided materials disable culling entirely.
@@ -342,15 +391,45 @@ void VulkanApp::InitVulkan() {
     this->m_meshManager.SetPhysicalDevice(this->m_device.GetPhysicalDevice());
     this->m_meshManager.SetQueue(this->m_device.GetGraphicsQueue());
     this->m_meshManager.SetQueueFamilyIndex(this->m_device.GetQueueFamilyIndices().graphicsFamily);
+    this->m_meshManager.SetCookedMeshDir((this->m_config.bEnableMeshCooking == true) ? this->m_config.sMeshCacheDir : std::string());
     this->m_textureManager.SetDevice(this->m_device.GetDevice());
     this->m_textureManager.SetPhysicalDevice(this->m_device.GetPhysicalDevice());
     this->m_textureManager.SetQueue(this->m_device.GetGraphicsQueue());
     this->m_textureManager.SetQueueFamilyIndex(this->m_device.GetQueueFamilyIndices().graphicsFamily);
+    {
+        TextureSamplingSettings stSampling;
+        stSampling.bGenerateMips = (this->m_config.sTextureMipMode != "off");
+        stSampling.bCpuMips = (this->m_config.sTextureMipMode == "cpu");
+        stSampling.fMaxAnisotropy = this->m_config.fTextureMaxAnisotropy;
+        stSampling.fMipLodBias = this->m_config.fTextureLodBias;
+        stSampling.fMaxLod = this->m_config.fTextureMaxLod;
+        this->m_textureManager.SetSamplingSettings(stSampling);
+    }
+    this->m_textureManager.SetCompressionEnabled(this->m_config.bTextureCompression);
+    this->m_textureManager.SetCookedTextureDir((this->m_config.bEnableTextureCooking == true) ? this->m_config.sTextureCacheDir : std::string());
+    {
+        TextureStreamingSettings stStreaming;
+        stStreaming.bEnabled = this->m_config.bTextureStreaming;
+        stStreaming.lBudgetMB = this->m_config.lTextureBudgetMB;
+        stStreaming.lTailSize = this->m_config.lTextureStreamTailSize;
+        stStreaming.lMaxUploadsPerFrame = this->m_config.lTextureStreamUploadsPerFrame;
+        this->m_textureManager.SetStreamingSettings(stStreaming);
+    }
+    this->m_textureManager.SetTextureArrayMaxSize(this->m_config.lTextureArrayMaxSize);
     this->m_sceneManager.SetDependencies(&this->m_materialManager, &this->m_meshManager, &this->m_textureManager);
+    this->m_sceneManager.SetJobQueue(&this->m_jobQueue);
     this->m_meshManager.SetJobQueue(&this->m_jobQueue);
     this->m_textureManager.SetJobQueue(&this->m_jobQueue);
-    /* Start resource manager thread for async cleanup */
-    this->m_resourceManagerThread.Start();
+    /* Trimmed and replaced GPU objects are destroyed once no frame in flight uses them (see DrawFrame). */
+    this->m_meshManager.SetReleaseQueue(&this->m_releaseQueue);
+    this->m_textureManager.SetReleaseQueue(&this->m_releaseQueue);
+    this->m_pipelineManager.SetReleaseQueue(&this->m_releaseQueue);
+    /* Pipelines build on workers with the shared cache; draw batches pick them up once UpdateBuilds reports them. */
+    this->m_pipelineManager.SetJobQueue(&this->m_jobQueue);
+    this->m_pipelineManager.SetPipelineCache(this->m_pipelineCache.Get());
+    /* Cull mode, front face, depth and (with EDS3) polygon mode set per draw: solid, double-sided and wireframe
+       materials of one shader pair share a pipeline. RecordDrawRange sets the state. */
+    this->m_pipelineManager.SetExtendedDynamicState(this->m_device.GetExtendedDynamicState());
     
     /* Register all managers with cleanup orchestrator */
     this->m_resourceCleanupManager.SetManagers(
@@ -366,7 +445,7 @@ void VulkanApp::InitVulkan() {
     // Editor: Level path is optional - File menu handles level selection
     if (!m_config.sLevelPath.empty()) {
         std::string levelPath = VulkanUtils::GetResourcePath(m_config.sLevelPath);
-        if (!this->m_sceneManager.LoadLevelFromFile(levelPath)) {
+        if (!this->LoadLevel(levelPath)) {
             VulkanUtils::LogErr("Failed to load level: {}", levelPath);
             this->m_sceneManager.SetCurrentScene(std::make_unique<Scene>("empty"));
         } else {
@@ -381,7 +460,7 @@ void VulkanApp::InitVulkan() {
     // Release: Level path is optional - main menu will handle level selection
     if (!m_config.sLevelPath.empty()) {
         std::string levelPath = VulkanUtils::GetResourcePath(m_config.sLevelPath);
-        if (this->m_sceneManager.LoadLevelFromFile(levelPath)) {
+        if (this->LoadLevel(levelPath)) {
             this->m_bLevelLoaded = true;
             this->m_mainMenu.SetLevelLoaded(true);
             this->m_mainMenu.SetVisible(false);  // Hide main menu when level is loaded via command line
@@ -435,7 +514,10 @@ void VulkanApp::InitVulkan() {
                             this->m_swapchain.GetImageCount());
 
     uint32_t lMaxFramesInFlight = (this->m_config.lMaxFramesInFlight >= 1u) ? this->m_config.lMaxFramesInFlight : static_cast<uint32_t>(1u);
+    /* Secondary pools for parallel recording: every scheduler worker plus the main thread, per frame in flight. */
+    this->m_commandBuffers.CreateSecondaryPools(lMaxFramesInFlight, this->m_jobQueue.GetScheduler().GetWorkerCount() + 1u);
     this->m_sync.Create(this->m_device.GetDevice(), lMaxFramesInFlight, this->m_swapchain.GetImageCount());
+    this->m_frameArenas.Create(lMaxFramesInFlight);
 
     /* Initialize frame context manager for per-frame resource tracking. */
     if (!this->m_frameContextManager.Create(this->m_device.GetDevice(),
@@ -511,7 +593,8 @@ void VulkanApp::InitVulkan() {
                                       this->m_device.GetPhysicalDevice(),
                                       &this->m_shaderManager,
                                       this->m_config.lMaxObjects,
-                                      kMaxBatches)) {
+                                      kMaxBatches,
+                                      this->m_pipelineCache.Get())) {
             VulkanUtils::LogInfo("GPUCuller initialized ({} max objects, {} max batches)", 
                                  this->m_config.lMaxObjects, kMaxBatches);
             this->m_gpuCullerEnabled = true;
@@ -527,12 +610,34 @@ void VulkanApp::InitVulkan() {
         this->m_gpuIndirectDrawEnabled = false;
     }
 
+    /* Meshlet culler: cluster-level frustum + normal cone culling for high-poly meshes.
+       Needs the GPU culler's batch layout and vkCmdDrawIndirectCount. */
+    this->m_meshletCullerEnabled = false;
+    if ((this->m_config.bEnableMeshletCulling == true) && (this->m_gpuCullerEnabled == true)) {
+        constexpr uint32_t kMaxBatches = 256;  // Same batch ids as GPUCuller
+        if (this->m_device.SupportsDrawIndirectCount() == false) {
+            VulkanUtils::LogWarn("MeshletCuller disabled: device lacks drawIndirectCount (using per-object culling)");
+        } else if (this->m_meshletCuller.Create(this->m_device.GetDevice(),
+                                                this->m_device.GetPhysicalDevice(),
+                                                &this->m_shaderManager,
+                                                this->m_config.lMaxMeshlets,
+                                                this->m_config.lMaxObjects,
+                                                this->m_config.lMaxMeshletDraws,
+                                                kMaxBatches,
+                                                this->m_pipelineCache.Get())) {
+            this->m_meshletCullerEnabled = true;
+        } else {
+            VulkanUtils::LogWarn("MeshletCuller creation failed (using per-object culling)");
+        }
+    }
+
     /* Add main/wire to the map only after ring buffer is ready (descriptor writes use ring buffer). */
     EnsureMainDescriptorSetWritten();
 
     /* Initialize light debug renderer if enabled. Creates separate pipeline for debug line drawing. */
     if (this->m_config.bShowLightDebug) {
-        if (!this->m_lightDebugRenderer.Create(this->m_device.GetDevice(), this->m_renderPass.Get(), this->m_device.GetPhysicalDevice())) {
+        if (!this->m_lightDebugRenderer.Create(this->m_device.GetDevice(), this->m_renderPass.Get(), this->m_device.GetPhysicalDevice(),
+                                               this->m_pipelineCache.Get())) {
             VulkanUtils::LogErr("Failed to create light debug renderer (continuing without debug visualization)");
         }
     }
@@ -627,19 +732,10 @@ void VulkanApp::EnsureMainDescriptorSetWritten() {
     std::shared_ptr<TextureHandle> pDefaultTex = this->m_textureManager.GetOrCreateDefaultTexture();
     if (pDefaultTex == nullptr || (pDefaultTex->IsValid() == false))
         return;
-    std::shared_ptr<TextureHandle> pDefaultNormalTex = this->m_textureManager.GetOrCreateDefaultNormalTexture();
-    std::shared_ptr<TextureHandle> pDefaultOcclusionTex = this->m_textureManager.GetOrCreateDefaultOcclusionTexture();
-    if (pDefaultNormalTex == nullptr || (pDefaultNormalTex->IsValid() == false))
-        pDefaultNormalTex = pDefaultTex;
-    if (pDefaultOcclusionTex == nullptr || (pDefaultOcclusionTex->IsValid() == false))
-        pDefaultOcclusionTex = pDefaultTex;
-    /* Keep a reference so TextureManager::TrimUnused() does not destroy the default texture (descriptor set uses its view/sampler). */
+    /* Keep a reference so TextureManager::TrimUnused() does not destroy the default texture (bindless slot 0 uses its view). */
     this->m_pDefaultTexture = pDefaultTex;
-    VkDescriptorImageInfo stImageInfo = {
-        .sampler     = pDefaultTex->GetSampler(),
-        .imageView   = pDefaultTex->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
+    /* White 1x1: neutral for every role (base color, MR/emissive/occlusion factors as-is, normal map "absent" sentinel). */
+    this->m_bindlessTextures.SetDefaultTexture(pDefaultTex);
     VkDescriptorBufferInfo stGlobalUBOInfo = {
         .buffer = this->m_globalUBOBuffer.GetBuffer(),
         .offset = 0,
@@ -657,28 +753,6 @@ void VulkanApp::EnsureMainDescriptorSetWritten() {
         .offset = 0,
         .range  = VK_WHOLE_SIZE,
     };
-    /* Default MR texture: white (1,1,1,1) so metallic/roughness factors are used as-is */
-    VkDescriptorImageInfo stMRImageInfo = {
-        .sampler     = pDefaultTex->GetSampler(),
-        .imageView   = pDefaultTex->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    /* Default emissive texture: white (1,1,1,1) so emissiveFactor is used as-is */
-    VkDescriptorImageInfo stEmissiveImageInfo = {
-        .sampler     = pDefaultTex->GetSampler(),
-        .imageView   = pDefaultTex->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    VkDescriptorImageInfo stNormalImageInfo = {
-        .sampler     = pDefaultNormalTex->GetSampler(),
-        .imageView   = pDefaultNormalTex->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    VkDescriptorImageInfo stOcclusionImageInfo = {
-        .sampler     = pDefaultOcclusionTex->GetSampler(),
-        .imageView   = pDefaultOcclusionTex->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
     VkBuffer visibleIndicesBuffer = (this->m_gpuCullerEnabled && this->m_gpuCuller.IsValid())
         ? this->m_gpuCuller.GetVisibleIndicesBuffer()
         : this->m_placeholderVisibleIndicesSSBO.GetBuffer();
@@ -687,401 +761,85 @@ void VulkanApp::EnsureMainDescriptorSetWritten() {
         .offset = 0,
         .range  = VK_WHOLE_SIZE,
     };
-    std::array<VkWriteDescriptorSet, 9> writeDescriptors = {{
-        { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 0, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .pImageInfo = &stImageInfo, .pBufferInfo = nullptr, .pTexelBufferView = nullptr },
+    std::array<VkWriteDescriptorSet, 4> writeDescriptors = {{
         { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 1, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .pImageInfo = nullptr, .pBufferInfo = &stGlobalUBOInfo, .pTexelBufferView = nullptr },
         { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 2, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, .pImageInfo = nullptr, .pBufferInfo = &stBufferInfo, .pTexelBufferView = nullptr },
         { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 3, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .pImageInfo = nullptr, .pBufferInfo = &stLightBufferInfo, .pTexelBufferView = nullptr },
-        { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 4, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .pImageInfo = &stMRImageInfo, .pBufferInfo = nullptr, .pTexelBufferView = nullptr },
-        { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 5, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .pImageInfo = &stEmissiveImageInfo, .pBufferInfo = nullptr, .pTexelBufferView = nullptr },
-        { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 6, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .pImageInfo = &stNormalImageInfo, .pBufferInfo = nullptr, .pTexelBufferView = nullptr },
-        { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 7, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .pImageInfo = &stOcclusionImageInfo, .pBufferInfo = nullptr, .pTexelBufferView = nullptr },
         { .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, .pNext = nullptr, .dstSet = this->m_descriptorSetMain, .dstBinding = 8, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .pImageInfo = nullptr, .pBufferInfo = &stVisibleIndicesInfo, .pTexelBufferView = nullptr },
     }};
     vkUpdateDescriptorSets(this->m_device.GetDevice(), static_cast<uint32_t>(writeDescriptors.size()), writeDescriptors.data(), 0, nullptr);
     
-    /* Register descriptor set for all pipeline keys (both textured and untextured). */
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MAIN_TEX)] = { this->m_descriptorSetMain };
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_WIRE_TEX)] = { this->m_descriptorSetMain };
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MASK_TEX)] = { this->m_descriptorSetMain };
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_TRANSPARENT_TEX)] = { this->m_descriptorSetMain };
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MAIN_UNTEX)] = { this->m_descriptorSetMain };
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_WIRE_UNTEX)] = { this->m_descriptorSetMain };
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MASK_UNTEX)] = { this->m_descriptorSetMain };
-    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_TRANSPARENT_UNTEX)] = { this->m_descriptorSetMain };
+    /* Register descriptor sets for all pipeline keys (both textured and untextured): one pair serves every batch. */
+    const std::vector<VkDescriptorSet> vecMainSets = { this->m_descriptorSetMain, this->m_bindlessTextures.GetSet() };
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MAIN_TEX)] = vecMainSets;
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_WIRE_TEX)] = vecMainSets;
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MASK_TEX)] = vecMainSets;
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_TRANSPARENT_TEX)] = vecMainSets;
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MAIN_UNTEX)] = vecMainSets;
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_WIRE_UNTEX)] = vecMainSets;
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_MASK_UNTEX)] = vecMainSets;
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_TRANSPARENT_UNTEX)] = vecMainSets;
+    /* Time demo layout has set 0 only (binding 1 GlobalUBO). */
+    this->m_pipelineDescriptorSets[std::string(PIPELINE_KEY_TIME_DEMO)] = { this->m_descriptorSetMain };
 }
 
-VkDescriptorSet VulkanApp::GetOrCreateDescriptorSetForTexture(std::shared_ptr<TextureHandle> pTexture) {
-    if (!pTexture || !pTexture->IsValid())
-        return VK_NULL_HANDLE;
-    
-    TextureHandle* pRawTexture = pTexture.get();
-    
-    // Check cache
-    auto it = m_textureDescriptorSets.find(pRawTexture);
-    if (it != m_textureDescriptorSets.end())
-        return it->second;
-    
-    // Allocate new descriptor set
-    VkDescriptorSet newSet = m_descriptorPoolManager.AllocateSet(std::string("main_frag_tex")); // Same layout as main descriptor set
-    if (newSet == VK_NULL_HANDLE) {
-        VulkanUtils::LogErr("GetOrCreateDescriptorSetForTexture: failed to allocate descriptor set");
-        return VK_NULL_HANDLE;
-    }
-    
-    // Get default MR texture (white = metallic/roughness factors used as-is)
-    std::shared_ptr<TextureHandle> pDefaultMRTex = m_textureManager.GetOrCreateDefaultTexture();
-    if (!pDefaultMRTex || !pDefaultMRTex->IsValid()) {
-        VulkanUtils::LogErr("GetOrCreateDescriptorSetForTexture: failed to get default MR texture");
-        return VK_NULL_HANDLE;
-    }
-    
-    // Write texture to descriptor set
-    VkDescriptorImageInfo imageInfo = {
-        .sampler     = pTexture->GetSampler(),
-        .imageView   = pTexture->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    
-    /* Use ring buffer for object data SSBO. */
-    VkDescriptorBufferInfo bufferInfo = {
-        .buffer = this->m_objectDataRingBuffer.GetBuffer(),
-        .offset = 0,
-        .range  = this->m_frameSize,
-    };
-    
-    VkDescriptorBufferInfo lightBufferInfo = {
-        .buffer = this->m_lightBuffer,
-        .offset = 0,
-        .range  = VK_WHOLE_SIZE,
-    };
-    
-    /* Default MR texture: white (1,1,1,1) so metallic/roughness factors are used as-is */
-    VkDescriptorImageInfo mrImageInfo = {
-        .sampler     = pDefaultMRTex->GetSampler(),
-        .imageView   = pDefaultMRTex->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    
-    std::array<VkWriteDescriptorSet, 4> writes = {{
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 0,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo       = &imageInfo,
-            .pBufferInfo      = nullptr,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 2,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
-            .pImageInfo       = nullptr,
-            .pBufferInfo      = &bufferInfo,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 3,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .pImageInfo       = nullptr,
-            .pBufferInfo      = &lightBufferInfo,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 4,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo       = &mrImageInfo,
-            .pBufferInfo      = nullptr,
-            .pTexelBufferView = nullptr,
+void VulkanApp::UpdateBindlessTextures() {
+    this->m_frameGraph.AssertAccess(this->m_frameRes.bindlessTextures, true);
+    std::set<const TextureHandle*> texturesInUse;
+    bool bMissingSlot = false;
+    const auto& renderObjects = this->m_batchedDrawList.GetLastRenderObjects();
+    for (const auto& ro : renderObjects) {
+        for (const std::shared_ptr<TextureHandle>* pTexture : { &ro.texture, &ro.pMetallicRoughnessTexture, &ro.pEmissiveTexture,
+                                                                &ro.pNormalTexture, &ro.pOcclusionTexture }) {
+            if ((*pTexture == nullptr) || ((*pTexture)->IsValid() == false))
+                continue;
+            if (texturesInUse.insert(pTexture->get()).second == false)
+                continue;
+            const bool bHadSlot = ((*pTexture)->GetBindlessIndex() != TextureHandle::kNoBindlessIndex);
+            if (this->m_bindlessTextures.Register(*pTexture) == false)
+                bMissingSlot = true;
+            else if (bHadSlot == false)
+                this->m_bTextureIndicesChanged = true;
         }
-    }};
-    vkUpdateDescriptorSets(m_device.GetDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
-    
-    // Cache it (with reference to keep texture alive)
-    m_textureDescriptorSets[pRawTexture] = newSet;
-    m_descriptorSetTextures[newSet] = pTexture;
-    
-    return newSet;
-}
-
-VkDescriptorSet VulkanApp::GetOrCreateDescriptorSetForTextures(std::shared_ptr<TextureHandle> pBaseColorTexture,
-                                                                std::shared_ptr<TextureHandle> pMetallicRoughnessTexture,
-                                                                std::shared_ptr<TextureHandle> pEmissiveTexture,
-                                                                std::shared_ptr<TextureHandle> pNormalTexture,
-                                                                std::shared_ptr<TextureHandle> pOcclusionTexture) {
-    if (!pBaseColorTexture || !pBaseColorTexture->IsValid())
-        return VK_NULL_HANDLE;
-    
-    // Create combined cache key from all texture pointers
-    TextureHandle* pRawBaseColor = pBaseColorTexture.get();
-    TextureHandle* pRawMR = pMetallicRoughnessTexture ? pMetallicRoughnessTexture.get() : nullptr;
-    TextureHandle* pRawEmissive = pEmissiveTexture ? pEmissiveTexture.get() : nullptr;
-    TextureHandle* pRawNormal = pNormalTexture ? pNormalTexture.get() : nullptr;
-    TextureHandle* pRawOcclusion = pOcclusionTexture ? pOcclusionTexture.get() : nullptr;
-    
-    // Use tuple cache key for (baseColor, MR, emissive, normal, occlusion)
-    auto cacheKey = std::make_tuple(pRawBaseColor, pRawMR, pRawEmissive, pRawNormal, pRawOcclusion);
-    
-    auto it = m_textureQuintupleDescriptorSets.find(cacheKey);
-    if (it != m_textureQuintupleDescriptorSets.end())
-        return it->second;
-    
-    // Allocate new descriptor set
-    VkDescriptorSet newSet = m_descriptorPoolManager.AllocateSet(std::string("main_frag_tex"));
-    if (newSet == VK_NULL_HANDLE) {
-        VulkanUtils::LogErr("GetOrCreateDescriptorSetForTextures: failed to allocate descriptor set");
-        return VK_NULL_HANDLE;
-    }
-    
-    // Get default texture for MR and emissive (white = factors used as-is)
-    std::shared_ptr<TextureHandle> pDefaultTex = m_textureManager.GetOrCreateDefaultTexture();
-    if (!pDefaultTex || !pDefaultTex->IsValid()) {
-        VulkanUtils::LogErr("GetOrCreateDescriptorSetForTextures: failed to get default texture");
-        return VK_NULL_HANDLE;
     }
-    
-    std::shared_ptr<TextureHandle> pMRToUse = (pMetallicRoughnessTexture && pMetallicRoughnessTexture->IsValid()) 
-        ? pMetallicRoughnessTexture : pDefaultTex;
-    std::shared_ptr<TextureHandle> pEmissiveToUse = (pEmissiveTexture && pEmissiveTexture->IsValid()) 
-        ? pEmissiveTexture : pDefaultTex;
-    std::shared_ptr<TextureHandle> pNormalToUse = (pNormalTexture && pNormalTexture->IsValid()) 
-        ? pNormalTexture : pDefaultTex;
-    std::shared_ptr<TextureHandle> pOcclusionToUse = (pOcclusionTexture && pOcclusionTexture->IsValid()) 
-        ? pOcclusionTexture : pDefaultTex;
-    
-    // Write textures to descriptor set
-    VkDescriptorImageInfo baseColorImageInfo = {
-        .sampler     = pBaseColorTexture->GetSampler(),
-        .imageView   = pBaseColorTexture->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    VkDescriptorBufferInfo globalUBOBufferInfo = {
-        .buffer = this->m_globalUBOBuffer.GetBuffer(),
-        .offset = 0,
-        .range  = 64u,
-    };
-    /* Use ring buffer for object data SSBO. */
-    VkDescriptorBufferInfo bufferInfo = {
-        .buffer = this->m_objectDataRingBuffer.GetBuffer(),
-        .offset = 0,
-        .range  = this->m_frameSize,
-    };
-    
-    VkDescriptorBufferInfo lightBufferInfo = {
-        .buffer = this->m_lightBuffer,
-        .offset = 0,
-        .range  = VK_WHOLE_SIZE,
-    };
-    
-    /* Visible indices SSBO for GPU-driven indirect draw (binding 8).
-       Uses placeholder buffer until GPU culler's actual buffer is swapped in. */
-    VkBuffer visibleIndicesBuffer = this->m_gpuCullerEnabled && this->m_gpuCuller.IsValid()
-        ? this->m_gpuCuller.GetVisibleIndicesBuffer()
-        : this->m_placeholderVisibleIndicesSSBO.GetBuffer();
-    VkDescriptorBufferInfo visibleIndicesBufferInfo = {
-        .buffer = visibleIndicesBuffer,
-        .offset = 0,
-        .range  = VK_WHOLE_SIZE,
-    };
-    
-    VkDescriptorImageInfo mrImageInfo = {
-        .sampler     = pMRToUse->GetSampler(),
-        .imageView   = pMRToUse->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    
-    VkDescriptorImageInfo emissiveImageInfo = {
-        .sampler     = pEmissiveToUse->GetSampler(),
-        .imageView   = pEmissiveToUse->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    
-    VkDescriptorImageInfo normalImageInfo = {
-        .sampler     = pNormalToUse->GetSampler(),
-        .imageView   = pNormalToUse->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    
-    VkDescriptorImageInfo occlusionImageInfo = {
-        .sampler     = pOcclusionToUse->GetSampler(),
-        .imageView   = pOcclusionToUse->GetView(),
-        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    
-    std::array<VkWriteDescriptorSet, 9> writes = {{
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 0,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo       = &baseColorImageInfo,
-            .pBufferInfo      = nullptr,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 1,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-            .pImageInfo       = nullptr,
-            .pBufferInfo      = &globalUBOBufferInfo,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 2,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
-            .pImageInfo       = nullptr,
-            .pBufferInfo      = &bufferInfo,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 3,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .pImageInfo       = nullptr,
-            .pBufferInfo      = &lightBufferInfo,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 4,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo       = &mrImageInfo,
-            .pBufferInfo      = nullptr,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 5,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo       = &emissiveImageInfo,
-            .pBufferInfo      = nullptr,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 6,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo       = &normalImageInfo,
-            .pBufferInfo      = nullptr,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 7,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo       = &occlusionImageInfo,
-            .pBufferInfo      = nullptr,
-            .pTexelBufferView = nullptr,
-        },
-        {
-            .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext            = nullptr,
-            .dstSet           = newSet,
-            .dstBinding       = 8,
-            .dstArrayElement  = 0,
-            .descriptorCount  = 1,
-            .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .pImageInfo       = nullptr,
-            .pBufferInfo      = &visibleIndicesBufferInfo,
-            .pTexelBufferView = nullptr,
-        }
-    }};
-    vkUpdateDescriptorSets(m_device.GetDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
-    
-    // Cache it
-    m_textureQuintupleDescriptorSets[cacheKey] = newSet;
-    
-    return newSet;
+    this->m_bBindlessSlotsPending = bMissingSlot;
+    const uint32_t lReleased = this->m_bindlessTextures.ReleaseUnused(texturesInUse);
+    VulkanUtils::LogDebug("Bindless textures: {} registered, {} released", this->m_bindlessTextures.GetRegisteredCount(), lReleased);
 }
 
-void VulkanApp::CleanupUnusedTextureDescriptorSets() {
-    if (m_sceneManager.GetCurrentScene() == nullptr)
-        return;
-
-    std::set<TextureHandle*> texturesInUse;
-    const auto& renderObjects = m_batchedDrawList.GetLastRenderObjects();
-    for (const auto& ro : renderObjects) {
-        if (ro.texture && ro.texture->IsValid()) texturesInUse.insert(ro.texture.get());
-        if (ro.pMetallicRoughnessTexture && ro.pMetallicRoughnessTexture->IsValid()) texturesInUse.insert(ro.pMetallicRoughnessTexture.get());
-        if (ro.pEmissiveTexture && ro.pEmissiveTexture->IsValid()) texturesInUse.insert(ro.pEmissiveTexture.get());
-        if (ro.pNormalTexture && ro.pNormalTexture->IsValid()) texturesInUse.insert(ro.pNormalTexture.get());
-        if (ro.pOcclusionTexture && ro.pOcclusionTexture->IsValid()) texturesInUse.insert(ro.pOcclusionTexture.get());
-    }
-    
-    // Also keep default texture alive
-    if (m_pDefaultTexture && m_pDefaultTexture->IsValid()) {
-        texturesInUse.insert(m_pDefaultTexture.get());
-    }
-    
-    // Find unused descriptor sets
-    std::vector<VkDescriptorSet> setsToFree;
-    for (auto it = m_textureDescriptorSets.begin(); it != m_textureDescriptorSets.end(); ) {
-        if (texturesInUse.find(it->first) == texturesInUse.end()) {
-            setsToFree.push_back(it->second);
-            m_descriptorSetTextures.erase(it->second);
-            it = m_textureDescriptorSets.erase(it);
-        } else {
-            ++it;
+void VulkanApp::RequestTextureResidency(const float* pCamPos_ic, float fPixelsPerUnit_ic, bool bPerspective_ic) {
+    this->m_frameGraph.AssertAccess(this->m_frameRes.visibility, false);
+    this->m_frameGraph.AssertAccess(this->m_frameRes.textureStreaming, true);
+    const std::vector<RenderObject>& vecRenderObjects = this->m_batchedDrawList.GetLastRenderObjects();
+    for (uint32_t lIdx : this->m_batchedDrawList.GetVisibleObjectIndices()) {
+        if (lIdx >= vecRenderObjects.size())
+            continue;
+        const RenderObject& ro = vecRenderObjects[lIdx];
+        /* Bounding sphere diameter on screen; the camera inside the sphere counts as distance = radius. */
+        float fScreenPixels = 2.f * ro.boundsRadius * fPixelsPerUnit_ic;
+        if (bPerspective_ic == true) {
+            const float fDx = ro.boundsCenterX - pCamPos_ic[0];
+            const float fDy = ro.boundsCenterY - pCamPos_ic[1];
+            const float fDz = ro.boundsCenterZ - pCamPos_ic[2];
+            const float fDistance = std::max(std::sqrt(fDx * fDx + fDy * fDy + fDz * fDz), std::max(ro.boundsRadius, 1e-3f));
+            fScreenPixels /= fDistance;
         }
+        this->m_textureManager.RequestResidency(ro.texture.get(), fScreenPixels);
+        this->m_textureManager.RequestResidency(ro.pMetallicRoughnessTexture.get(), fScreenPixels);
+        this->m_textureManager.RequestResidency(ro.pEmissiveTexture.get(), fScreenPixels);
+        this->m_textureManager.RequestResidency(ro.pNormalTexture.get(), fScreenPixels);
+        this->m_textureManager.RequestResidency(ro.pOcclusionTexture.get(), fScreenPixels);
     }
-    
-    // Free unused descriptor sets
-    for (VkDescriptorSet set : setsToFree) {
-        m_descriptorPoolManager.FreeSet(set);
-    }
-    
-    if (!setsToFree.empty()) {
-        VulkanUtils::LogDebug("Cleaned up {} unused texture descriptor sets", setsToFree.size());
+}
+
+void VulkanApp::RebindStreamedTextures(const std::vector<TextureHandle*>& vecChanged_ic) {
+    for (TextureHandle* pTexture : vecChanged_ic) {
+        if (this->m_bindlessTextures.Rebind(pTexture) == false)
+            continue;
+        this->m_bTextureIndicesChanged = true;
+        /* Table full: the texture lost its slot; UpdateBindlessTextures registers it again once one frees up. */
+        if (pTexture->GetBindlessIndex() == TextureHandle::kNoBindlessIndex)
+            this->m_bBindlessSlotsPending = true;
     }
 }
 
@@ -1100,10 +858,13 @@ void VulkanApp::RecreateSwapchainAndDependents() {
     VkResult r = vkDeviceWaitIdle(this->m_device.GetDevice());
     if (r != VK_SUCCESS)
         VulkanUtils::LogErr("vkDeviceWaitIdle before recreate failed: {}", static_cast<int>(r));
+    this->m_releaseQueue.Flush();
 
     this->m_framebuffers.Destroy();
     this->m_depthImage.Destroy();
     this->m_pipelineManager.DestroyPipelines();
+    /* Prewarmed pipelines went too: prewarm the level's materials again for the new render pass. */
+    this->m_zPrewarmedMaterials = 0u;
     
     /* Mark batched draw list dirty since pipelines were destroyed.
        This ensures batches are rebuilt with new pipeline handles. */
@@ -1137,15 +898,396 @@ void VulkanApp::RecreateSwapchainAndDependents() {
                             this->m_device.GetQueueFamilyIndices().graphicsFamily,
                             this->m_swapchain.GetImageCount());
     uint32_t lMaxFramesInFlight = (this->m_config.lMaxFramesInFlight >= 1u) ? this->m_config.lMaxFramesInFlight : static_cast<uint32_t>(1u);
+    this->m_commandBuffers.CreateSecondaryPools(lMaxFramesInFlight, this->m_jobQueue.GetScheduler().GetWorkerCount() + 1u);
     this->m_sync.Destroy();
     this->m_sync.Create(this->m_device.GetDevice(), lMaxFramesInFlight, this->m_swapchain.GetImageCount());
 }
 
+void VulkanApp::PrepareMeshletCulling(const float fFrustumPlanes_ic[6][4], const float* pCamPos_ic, bool bSceneRebuilt_ic) {
+    this->m_frameGraph.AssertAccess(this->m_frameRes.cullInputs, true);
+    const std::vector<DrawBatch>& vecOpaque = this->m_batchedDrawList.GetOpaqueBatches();
+    const std::vector<DrawBatch>& vecTransparent = this->m_batchedDrawList.GetTransparentBatches();
+    const std::vector<RenderObject>& vecRenderObjects = this->m_batchedDrawList.GetLastRenderObjects();
+    const std::vector<DrawBatch>* pBatchLists[2] = { &vecOpaque, &vecTransparent };
+
+    /* Meshlet table: one copy per distinct high-poly mesh, rebuilt only when batches change. */
+    if ((bSceneRebuilt_ic == true) || (this->m_meshletTableOffsets.empty() == true)) {
+        this->m_meshletTable.clear();
+        this->m_meshletTableOffsets.clear();
+        for (const std::vector<DrawBatch>* pBatches : pBatchLists) {
+            for (const DrawBatch& stBatch : *pBatches) {
+                const MeshHandle* pMesh = stBatch.key.mesh.get();
+                if ((pMesh == nullptr) || (pMesh->GetMeshlets().size() < static_cast<size_t>(kMeshletCullMinMeshlets)))
+                    continue;
+                if (this->m_meshletTableOffsets.find(pMesh) != this->m_meshletTableOffsets.end())
+                    continue;
+                const std::vector<Meshlet>& vecMeshlets = pMesh->GetMeshlets();
+                if (this->m_meshletTable.size() + vecMeshlets.size() > static_cast<size_t>(this->m_meshletCuller.GetMaxMeshlets())) {
+                    VulkanUtils::LogWarn("MeshletCuller: meshlet table full ({}), remaining meshes use per-object culling. Increase 'max_meshlets' in config.",
+                                         this->m_meshletCuller.GetMaxMeshlets());
+                    break;
+                }
+                this->m_meshletTableOffsets[pMesh] = static_cast<uint32_t>(this->m_meshletTable.size());
+                this->m_meshletTable.insert(this->m_meshletTable.end(), vecMeshlets.begin(), vecMeshlets.end());
+            }
+        }
+        this->m_meshletCuller.UploadMeshlets(this->m_meshletTable.data(), static_cast<uint32_t>(this->m_meshletTable.size()));
+    }
+
+    /* Batch ids follow the GPUCuller numbering (opaque then transparent). */
+    const size_t zBatchCount = std::min(vecOpaque.size() + vecTransparent.size(), static_cast<size_t>(this->m_meshletCuller.GetMaxBatches()));
+    this->m_meshletBatchesCache.assign(zBatchCount, MeshletCullBatch{});
+    this->m_meshletInstancesCache.clear();
+    if (this->m_meshletTableOffsets.empty() == true) {
+        this->m_meshletCuller.UpdateParams(fFrustumPlanes_ic, pCamPos_ic, 0u, 0u, 0u);
+        return;
+    }
+
+    const uint64_t uMaxDrawsPerBatch = static_cast<uint64_t>(this->m_device.GetLimits().maxDrawIndirectCount);
+    uint64_t uDrawCursor = 0u;
+    uint32_t lBatchId = 0u;
+    for (const std::vector<DrawBatch>* pBatches : pBatchLists) {
+        for (const DrawBatch& stBatch : *pBatches) {
+            const uint32_t lThisBatch = lBatchId++;
+            if (static_cast<size_t>(lThisBatch) >= zBatchCount)
+                break;
+            if ((stBatch.pipelineKey == PIPELINE_KEY_TIME_DEMO) || (stBatch.objectIndices.empty() == true))
+                continue;
+            auto itMesh = this->m_meshletTableOffsets.find(stBatch.key.mesh.get());
+            if (itMesh == this->m_meshletTableOffsets.end())
+                continue;
+
+            const uint32_t lMeshletCount = static_cast<uint32_t>(stBatch.key.mesh->GetMeshlets().size());
+            const uint64_t uCapacity = static_cast<uint64_t>(stBatch.objectIndices.size()) * static_cast<uint64_t>(lMeshletCount);
+            if ((uCapacity > uMaxDrawsPerBatch) ||
+                (uDrawCursor + uCapacity > static_cast<uint64_t>(this->m_meshletCuller.GetMaxDraws())) ||
+                (this->m_meshletInstancesCache.size() + stBatch.objectIndices.size() > static_cast<size_t>(this->m_meshletCuller.GetMaxInstances())))
+                continue;  // Over capacity: keep this batch on the per-object path
+
+            const uint32_t lFlags = (IsMeshletConeCullAllowed(stBatch.pipelineKey, this->m_config.bCullBackFaces) == true) ? kMeshletCullFlagCone : 0u;
+            uint32_t lLocalIdx = 0u;
+            for (uint32_t lObjIdx : stBatch.objectIndices) {
+                if (lObjIdx >= vecRenderObjects.size())
+                    continue;
+                MeshletCullInstance stInst = {};
+                std::memcpy(stInst.model, vecRenderObjects[lObjIdx].worldMatrix, sizeof(stInst.model));
+                /* Same SSBO index the GPUCuller writes to visible indices. */
+                stInst.objectIndex = stBatch.firstInstanceIndex + lLocalIdx;
+                stInst.batchId = lThisBatch;
+                stInst.meshletOffset = itMesh->second;
+                stInst.meshletCount = lMeshletCount;
+                /* Cone axis and cutoff only survive rotation + positive uniform scale: frustum test only otherwise */
+                stInst.flags = (IsSimilarityTransform(stInst.model) == true) ? lFlags : (lFlags & ~kMeshletCullFlagCone);
+                stInst.firstVertex = stBatch.firstVertex;
+                this->m_meshletInstancesCache.push_back(stInst);
+                ++lLocalIdx;
+            }
+
+            MeshletCullBatch& stSection = this->m_meshletBatchesCache[lThisBatch];
+            stSection.drawOffset = static_cast<uint32_t>(uDrawCursor);
+            stSection.drawCapacity = static_cast<uint32_t>(uCapacity);
+            uDrawCursor += uCapacity;
+        }
+    }
+
+    this->m_meshletCuller.UploadInstances(this->m_meshletInstancesCache.data(), static_cast<uint32_t>(this->m_meshletInstancesCache.size()));
+    this->m_meshletCuller.UploadBatches(this->m_meshletBatchesCache.data(), static_cast<uint32_t>(this->m_meshletBatchesCache.size()));
+    this->m_meshletCuller.UpdateParams(fFrustumPlanes_ic, pCamPos_ic,
+                                       static_cast<uint32_t>(this->m_meshletInstancesCache.size()),
+                                       static_cast<uint32_t>(this->m_meshletBatchesCache.size()),
+                                       static_cast<uint32_t>(this->m_meshletTable.size()));
+}
+
+bool VulkanApp::GetMeshletDrawRange(uint32_t lBatchId_ic, VkDeviceSize& uDrawOffset_out, VkDeviceSize& uCountOffset_out,
+                                    uint32_t& lMaxDraws_out) const {
+    if ((this->m_meshletCullerEnabled == false) || (this->m_meshletCuller.IsValid() == false))
+        return false;
+    if (static_cast<size_t>(lBatchId_ic) >= this->m_meshletBatchesCache.size())
+        return false;
+    const MeshletCullBatch& stSection = this->m_meshletBatchesCache[lBatchId_ic];
+    if (stSection.drawCapacity == 0u)
+        return false;
+    uDrawOffset_out = static_cast<VkDeviceSize>(stSection.drawOffset) * sizeof(VkDrawIndirectCommand);
+    uCountOffset_out = static_cast<VkDeviceSize>(lBatchId_ic) * sizeof(uint32_t);
+    lMaxDraws_out = stSection.drawCapacity;
+    return true;
+}
+
+void VulkanApp::BuildFrameGraph() {
+    FrameGraph& graph = this->m_frameGraph;
+    FrameResources& res = this->m_frameRes;
+    graph.Clear();
+    res.sceneTransforms  = graph.AddResource("scene_transforms");
+    res.renderObjects    = graph.AddResource("render_objects");   // Batches and their render objects
+    res.visibility       = graph.AddResource("visibility");       // CPU frustum-culled object indices
+    res.descriptorSets   = graph.AddResource("descriptor_sets");
+    res.bindlessTextures = graph.AddResource("bindless_textures");
+    res.lightBuffer      = graph.AddResource("light_buffer");
+    res.objectData       = graph.AddResource("object_data");      // This frame's ObjectData ring slot
+    res.cullInputs       = graph.AddResource("cull_inputs");      // GPU / meshlet culler host-visible inputs
+    res.textureStreaming = graph.AddResource("texture_streaming");
+    res.drawCalls        = graph.AddResource("draw_calls");
+
+    /* Declaration order is the old serial order; stages without a path between them run in parallel. */
+    graph.AddStage("transforms", {}, { res.sceneTransforms, res.renderObjects }, TaskAffinity::Any,
+                   [this]() { this->StageTransforms(); });
+    graph.AddStage("lights", { res.sceneTransforms }, { res.lightBuffer }, TaskAffinity::Any,
+                   [this]() { this->StageLights(); });
+    graph.AddStage("descriptor_sets", {}, { res.descriptorSets }, TaskAffinity::MainThread,
+                   [this]() { this->StageDescriptorSets(); });
+    graph.AddStage("rebuild_batches", { res.sceneTransforms, res.descriptorSets },
+                   { res.renderObjects, res.visibility, res.bindlessTextures }, TaskAffinity::MainThread,
+                   [this]() { this->StageRebuildBatches(); });
+    graph.AddStage("object_data", { res.renderObjects, res.bindlessTextures }, { res.objectData }, TaskAffinity::Any,
+                   [this]() { this->StageObjectData(); });
+    graph.AddStage("visibility", { res.renderObjects }, { res.visibility }, TaskAffinity::Any,
+                   [this]() { this->StageVisibility(); });
+    graph.AddStage("texture_residency", { res.renderObjects, res.visibility }, { res.textureStreaming }, TaskAffinity::MainThread,
+                   [this]() { this->StageTextureResidency(); });
+    graph.AddStage("gpu_culling", { res.renderObjects }, { res.cullInputs }, TaskAffinity::Any,
+                   [this]() { this->StageGpuCulling(); });
+    graph.AddStage("draw_calls", { res.renderObjects }, { res.drawCalls }, TaskAffinity::Any,
+                   [this]() { this->StageDrawCalls(); });
+    graph.Compile();
+}
+
+void VulkanApp::StageTransforms() {
+    Scene* pScene = this->m_framePrep.pScene;
+    if (pScene != nullptr) {
+        pScene->UpdateTransformHierarchy();
+        this->m_batchedDrawList.RefreshWorldMatricesFromScene(pScene);
+    }
+}
+
+void VulkanApp::StageLights() {
+    if (this->m_framePrep.pScene != nullptr) {
+        this->m_lightManager.SetScene(this->m_framePrep.pScene);
+        this->m_lightManager.UpdateLightBuffer();
+    }
+}
+
+void VulkanApp::StageDescriptorSets() {
+    /* Ensure main descriptor set is written (default texture) before drawing main/wire; idempotent. */
+    EnsureMainDescriptorSetWritten();
+}
+
+void VulkanApp::StageRebuildBatches() {
+    FramePrep& stPrep = this->m_framePrep;
+    /* Build draw list from scene (frustum culling, push size validation, sort by pipeline/mesh). */
+    /* Use BatchedDrawList for efficient instanced rendering with dirty tracking.
+       Only rebuilds batches when scene changes, not every frame. Missing pipelines are built on workers. */
+    stPrep.bSceneRebuilt = this->m_batchedDrawList.RebuildIfDirty(stPrep.pScene,
+                               this->m_device.GetDevice(), stPrep.renderPassForBatching, stPrep.bBatchHasDepth,
+                               &this->m_pipelineManager, &this->m_materialManager, &this->m_shaderManager,
+                               &this->m_pipelineDescriptorSets);
+    /* Scene changed: give new textures bindless slots (written to ObjectData below) and release dropped ones.
+       Textures left without a slot (table full) retry every frame until one frees up. */
+    if ((stPrep.bSceneRebuilt == true) || (this->m_bBindlessSlotsPending == true))
+        UpdateBindlessTextures();
+    /* Slot changes (rebuild or streaming swap) must reach every ring frame, like a rebuild. */
+    stPrep.bObjectDataRebuilt = (stPrep.bSceneRebuilt == true) || (this->m_bTextureIndicesChanged == true);
+}
+
+void VulkanApp::StageObjectData() {
+    /* Update object data SSBO using TieredInstanceManager.
+       - Static: Only when scene rebuilds
+       - SemiStatic: When scene rebuilds OR object dirty flag set
+       - Dynamic: Every frame
+       - Procedural: Compute shader (future) - placeholder for now
+       Must happen AFTER RebuildIfDirty so batches are valid. */
+    const FramePrep& stPrep = this->m_framePrep;
+    uint32_t lFrameIndex = this->m_sync.GetCurrentFrameIndex();
+    ObjectData* pObjectData = this->m_objectDataRingBuffer.GetFrameData(lFrameIndex);
+    if (pObjectData == nullptr || stPrep.pScene == nullptr)
+        return;
+#if EDITOR_BUILD
+    this->m_tieredInstanceManager.UpdateSSBO(
+        pObjectData,
+        this->m_config.lMaxObjects,
+        this->m_batchedDrawList.GetLastRenderObjects(),
+        this->m_batchedDrawList.GetOpaqueBatches(),
+        this->m_batchedDrawList.GetTransparentBatches(),
+        stPrep.bObjectDataRebuilt,
+        false,
+        stPrep.movedIds);
+#else
+    this->m_tieredInstanceManager.UpdateSSBO(
+        pObjectData,
+        this->m_config.lMaxObjects,
+        this->m_batchedDrawList.GetLastRenderObjects(),
+        this->m_batchedDrawList.GetOpaqueBatches(),
+        this->m_batchedDrawList.GetTransparentBatches(),
+        stPrep.bObjectDataRebuilt,
+        false);
+#endif
+}
+
+void VulkanApp::StageVisibility() {
+    /* Update visibility (frustum culling) each frame - fast operation on existing batches */
+    this->m_batchedDrawList.UpdateVisibility(this->m_framePrep.fViewProj, this->m_framePrep.pScene);
+}
+
+void VulkanApp::StageTextureResidency() {
+    if (this->m_textureManager.GetStreamingSettings().bEnabled == false)
+        return;
+    /* Streaming feedback: pixels covered by one world unit at distance 1 (perspective) or anywhere (ortho). */
+    const float fDrawH = static_cast<float>(this->m_framePrep.lDrawHeight);
+    const float fPixelsPerUnit = (this->m_config.bUsePerspective == true)
+        ? fDrawH / (2.f * std::tan(this->m_config.fCameraFovYRad * 0.5f))
+        : fDrawH / (2.f * ((this->m_config.fOrthoHalfExtent > 0.f) ? this->m_config.fOrthoHalfExtent : kOrthoFallbackHalfExtent));
+    RequestTextureResidency(this->m_framePrep.fCamPos, fPixelsPerUnit, this->m_config.bUsePerspective);
+}
+
+void VulkanApp::StageGpuCulling() {
+    const FramePrep& stPrep = this->m_framePrep;
+    /* Update GPU culler with frustum and object bounds (parallel to CPU culling for verification).
+       GPU culler will be used for indirect draw in Phase 4. */
+    if (this->m_gpuCullerEnabled && stPrep.pScene != nullptr) {
+        // Extract frustum planes from view-projection matrix
+        float frustumPlanes[6][4];
+        ExtractFrustumPlanesFromViewProj(stPrep.fViewProj, frustumPlanes);
+        
+        const std::vector<RenderObject>& renderObjects = this->m_batchedDrawList.GetLastRenderObjects();
+        const auto& opaqueBatchesForCull = this->m_batchedDrawList.GetOpaqueBatches();
+        const auto& transparentBatchesForCull = this->m_batchedDrawList.GetTransparentBatches();
+        const uint32_t totalBatches = static_cast<uint32_t>(opaqueBatchesForCull.size() + transparentBatchesForCull.size());
+        
+        // Count total objects across all batches
+        size_t totalCullObjects = 0;
+        for (const auto& batch : opaqueBatchesForCull) {
+            totalCullObjects += batch.objectIndices.size();
+        }
+        for (const auto& batch : transparentBatchesForCull) {
+            totalCullObjects += batch.objectIndices.size();
+        }
+        
+        // Warn if scene exceeds GPU culler capacity
+        if ((totalCullObjects > this->m_config.lMaxObjects) && (this->m_bWarnedCullCapacity.exchange(true) == false)) {
+            VulkanUtils::LogWarn("Scene has {} objects but GPU culler limit is {} - some objects will not render! "
+                                 "Increase 'max_objects' in config.", 
+                                 totalCullObjects, this->m_config.lMaxObjects);
+        }
+        
+        if (totalCullObjects > 0 && totalBatches > 0) {
+            this->m_cullObjectsCache.resize(totalCullObjects);
+            
+            size_t cullIdx = 0;
+            uint32_t batchId = 0;
+            
+            // Helper to process batches and set up GPU culler
+            auto processBatchesForCull = [&](const std::vector<DrawBatch>& batches) {
+                for (const DrawBatch& batch : batches) {
+                    // Set up draw info for this batch (vertexCount, firstVertex)
+                    this->m_gpuCuller.SetBatchDrawInfo(batchId, batch.vertexCount, batch.firstVertex);
+                    
+                    uint32_t localIdx = 0;
+                    for (uint32_t objIdx : batch.objectIndices) {
+                        if (objIdx >= renderObjects.size()) continue;
+
+                        const RenderObject& ro = renderObjects[objIdx];
+                        CullObjectData& cullObj = this->m_cullObjectsCache[cullIdx];
+
+                        cullObj.boundingSphere[0] = ro.boundsCenterX;
+                        cullObj.boundingSphere[1] = ro.boundsCenterY;
+                        cullObj.boundingSphere[2] = ro.boundsCenterZ;
+                        cullObj.boundingSphere[3] = ro.boundsRadius;
+                        
+                        // SSBO offset = batch.firstInstanceIndex + local index within batch
+                        cullObj.objectIndex = batch.firstInstanceIndex + localIdx;
+                        cullObj.batchId = batchId;
+                        cullObj._pad0 = 0;
+                        cullObj._pad1 = 0;
+                        
+                        ++cullIdx;
+                        ++localIdx;
+                    }
+                    ++batchId;
+                }
+            };
+            
+            processBatchesForCull(opaqueBatchesForCull);
+            processBatchesForCull(transparentBatchesForCull);
+            
+            // Update frustum planes in GPU culler (with batch count)
+            this->m_gpuCuller.UpdateFrustum(frustumPlanes, static_cast<uint32_t>(totalCullObjects), totalBatches);
+            
+            // Upload cull objects to GPU
+            this->m_gpuCuller.UploadCullObjects(this->m_cullObjectsCache.data(), static_cast<uint32_t>(totalCullObjects));
+        }
+
+        if (this->m_meshletCullerEnabled == true) {
+            PrepareMeshletCulling(frustumPlanes, stPrep.fCamPos, stPrep.bSceneRebuilt);
+        }
+    }
+}
+
+void VulkanApp::StageDrawCalls() {
+    /* Convert batches to DrawCall format.
+       Each batch = 1 draw call with instanceCount = number of objects in batch.
+       GPU uses batchStartIndex + gl_InstanceIndex to look up per-object data in SSBO.
+       Exception: time_demo pipeline uses 128-byte push (viewProj + model) and one draw per object.
+       Draw calls are overwritten in place, so their vectors and key strings are not reallocated every frame. */
+    size_t zDrawCount = 0u;
+    const auto& opaqueBatches = this->m_batchedDrawList.GetOpaqueBatches();
+    const auto& transparentBatches = this->m_batchedDrawList.GetTransparentBatches();
+    const auto& renderObjects = this->m_batchedDrawList.GetLastRenderObjects();
+    constexpr uint32_t kTimeDemoPushSize = 128u;
+    
+    size_t reserveCount = 0;
+    for (const auto& b : opaqueBatches)
+        reserveCount += (b.pipelineKey == "time_demo") ? b.objectIndices.size() : 1;
+    for (const auto& b : transparentBatches)
+        reserveCount += (b.pipelineKey == "time_demo") ? b.objectIndices.size() : 1;
+    this->m_drawCalls.reserve(reserveCount);
+
+    /* Next draw call slot: last frame's element when there is one. */
+    auto nextDrawCall = [&]() -> DrawCall& {
+        if (zDrawCount == this->m_drawCalls.size())
+            this->m_drawCalls.emplace_back();
+        return this->m_drawCalls[zDrawCount++];
+    };
+    
+    /* Helper to create draw call from batch (instanced path) */
+    auto createDrawCallFromBatch = [&](const DrawBatch& batch) {
+        if (batch.objectIndices.empty()) return;
+        if (batch.pipeline == VK_NULL_HANDLE) return;
+        
+        // Instanced; objectIndex = batchStartIndex for SSBO
+        AssignBatchDrawCall(nextDrawCall(), batch, kInstancedPushConstantSize,
+                            static_cast<uint32_t>(batch.objectIndices.size()), nullptr, batch.firstInstanceIndex);
+    };
+    
+    /* Helper: one DrawCall per object for time_demo (128-byte push viewProj + model) */
+    auto createTimeDemoDrawCalls = [&](const DrawBatch& batch) {
+        if (batch.pipeline == VK_NULL_HANDLE || batch.objectIndices.empty()) return;
+        for (uint32_t objIdx : batch.objectIndices) {
+            if (objIdx >= renderObjects.size()) continue;
+            const float* pModel = renderObjects[objIdx].worldMatrix;
+            AssignBatchDrawCall(nextDrawCall(), batch, kTimeDemoPushSize, 1u, pModel, 0u);
+        }
+    };
+    
+    for (const auto& batch : opaqueBatches) {
+        if (batch.pipelineKey == "time_demo")
+            createTimeDemoDrawCalls(batch);
+        else
+            createDrawCallFromBatch(batch);
+    }
+    for (const auto& batch : transparentBatches) {
+        if (batch.pipelineKey == "time_demo")
+            createTimeDemoDrawCalls(batch);
+        else
+            createDrawCallFromBatch(batch);
+    }
+    this->m_drawCalls.resize(zDrawCount);  // Drop slots left over from a frame with more draws
+}
+
 void VulkanApp::MainLoop() {
     VulkanUtils::LogTrace("MainLoop");
     bool bQuit = static_cast<bool>(false);
     while (bQuit == false) {
         const auto frameStart = std::chrono::steady_clock::now();
+        const uint64_t uAllocsAtFrameStart = AllocCounter::GetAllocationCount();
 
         /* Update global UBO (binding 1): time, deltaTime for shaders. */
         {
@@ -1160,26 +1302,58 @@ void VulkanApp::MainLoop() {
         }
 
         this->m_jobQueue.ProcessCompletedJobs(this->m_completedJobHandler);
-        /* Clean up unused texture descriptor sets before trimming textures */
-        CleanupUnusedTextureDescriptorSets();
-        
-        /* Enqueue unified resource cleanup to worker thread (non-blocking) */
-        this->m_resourceManagerThread.EnqueueCommand(
-            ResourceManagerThread::Command(ResourceManagerThread::CommandType::TrimAll,
-                std::bind(&VulkanApp::OnTrimAllCaches, this))
-        );
+        /* Pipelines finished on workers: rebuild the batches that skipped them. */
+        if (this->m_pipelineManager.UpdateBuilds() > 0u)
+            this->m_batchedDrawList.SetDirty();
+        if (this->m_bPipelineStartupReported == false) {
+            const PipelineBuildStats stBuild = this->m_pipelineManager.GetBuildStats();
+            if ((stBuild.fFirstReadyMs > 0.0f) && (stBuild.lBuilt > 0u)) {
+                const double dSinceLaunchMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - this->m_launchTime).count();
+                VulkanUtils::LogInfo("Startup pipelines: {} ready {:.1f} ms after first request ({:.1f} ms build time, {:.0f} ms since launch), pipeline cache {}",
+                                     stBuild.lBuilt, stBuild.fFirstReadyMs, stBuild.fBuildMs, dSinceLaunchMs,
+                                     this->m_pipelineCache.WasLoaded() ? "warm" : "cold");
+                this->m_bPipelineStartupReported = true;
+            }
+        }
+        /* Progressive level load: swap placeholders for resident glTF objects within the per-frame budget. */
+        if (this->m_sceneManager.UpdateLevelLoad(this->m_config.fLevelLoadBudgetMs) > 0u)
+            this->m_batchedDrawList.SetDirty();
+        this->PrewarmLevelPipelines();
+        /* The load screen stays up until the level's pipelines are built; each pipeline counts as one step. */
+        {
+            LevelLoadProgress stLoadProgress = this->m_sceneManager.GetLevelLoadProgress();
+            const PipelinePrewarmProgress stPrewarm = this->m_pipelineManager.GetPrewarmProgress();
+            if ((stLoadProgress.isLoading == true) || (stPrewarm.lReady < stPrewarm.lTotal)) {
+                stLoadProgress.isLoading = true;
+                stLoadProgress.pipelinesTotal = stPrewarm.lTotal;
+                stLoadProgress.pipelinesReady = stPrewarm.lReady;
+                const uint32_t lSteps = stLoadProgress.totalSources + stLoadProgress.totalInstances + stPrewarm.lTotal;
+                const uint32_t lDone = (stLoadProgress.totalSources - stLoadProgress.pendingSources) +
+                                       stLoadProgress.resolvedInstances + stPrewarm.lReady;
+                stLoadProgress.fraction = (lSteps > 0u) ? static_cast<float>(lDone) / static_cast<float>(lSteps) : 1.0f;
+            }
+            this->m_levelSelector.SetLoadProgress(stLoadProgress);
+        }
+        /* Texture streaming: residency changes replace images, so swapped textures move to fresh bindless slots. */
+        ++this->m_uFrameSerial;
+        this->m_releaseQueue.BeginFrame(this->m_uFrameSerial);
+        this->m_frameArenas.BeginFrame(this->m_uFrameSerial);
+        this->m_bindlessTextures.BeginFrame(this->m_uFrameSerial);
+        this->m_vecStreamedTextures.clear();
+        this->m_textureManager.UpdateStreaming(this->m_vecStreamedTextures);
+        RebindStreamedTextures(this->m_vecStreamedTextures);
 
 #if EDITOR_BUILD
         /* Process events with editor handler (ImGui gets first pass) */
         bQuit = this->m_pWindow->PollEventsWithHandler(
-            std::bind(&VulkanApp::OnEditorEvent, this, std::placeholders::_1));
+            [this](const SDL_Event& evt) { return OnEditorEvent(evt); });
         
         /* Begin editor frame */
         this->m_editorLayer.BeginFrame();
 #else
         /* Process events with runtime overlay handler */
         bQuit = this->m_pWindow->PollEventsWithHandler(
-            std::bind(&VulkanApp::OnRuntimeEvent, this, std::placeholders::_1));
+            [this](const SDL_Event& evt) { return OnRuntimeEvent(evt); });
 #endif
         if (bQuit == true)
             break;
@@ -1265,256 +1439,31 @@ void VulkanApp::MainLoop() {
         float fCamPos[3];
         this->m_camera.GetPosition(fCamPos[0], fCamPos[1], fCamPos[2]);
 
-        Scene* pScene = this->m_sceneManager.GetCurrentScene();
-        if (pScene != nullptr) {
-            pScene->UpdateTransformHierarchy();
-            this->m_batchedDrawList.RefreshWorldMatricesFromScene(pScene);
-        }
-
-        {
-            if (pScene) {
-                this->m_lightManager.SetScene(pScene);
-                this->m_lightManager.UpdateLightBuffer();
-            }
-        }
-
-        /* Ensure main descriptor set is written (default texture) before drawing main/wire; idempotent. */
-        EnsureMainDescriptorSetWritten();
-
-        /* Build draw list from scene (frustum culling, push size validation, sort by pipeline/mesh). */
-        /* Use std::bind to create callback for per-object PBR texture descriptor sets */
-        auto getTextureDescriptorSet = std::bind(
-            &VulkanApp::GetOrCreateDescriptorSetForTextures, this,
-            std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
-            std::placeholders::_4, std::placeholders::_5);
-        
-        /* Use BatchedDrawList for efficient instanced rendering with dirty tracking.
-           Only rebuilds batches when scene changes, not every frame.
-           Editor uses viewport's offscreen render pass; Runtime uses main swapchain render pass. */
-#if EDITOR_BUILD
-        VkRenderPass offscreenRenderPass = this->m_viewportManager.GetOffscreenRenderPass();
-        VkRenderPass renderPassForBatching = (offscreenRenderPass != VK_NULL_HANDLE) 
-            ? offscreenRenderPass 
-            : this->m_renderPass.Get();
-        bool batchRenderPassHasDepth = (offscreenRenderPass != VK_NULL_HANDLE) 
-            ? true 
-            : this->m_renderPass.HasDepthAttachment();
-#else
-        // Runtime: render directly to swapchain using main render pass
-        VkRenderPass renderPassForBatching = this->m_renderPass.Get();
-        bool batchRenderPassHasDepth = this->m_renderPass.HasDepthAttachment();
-#endif
-        bool bSceneRebuilt = this->m_batchedDrawList.RebuildIfDirty(pScene,
-                                  this->m_device.GetDevice(), renderPassForBatching, batchRenderPassHasDepth,
-                                  &this->m_pipelineManager, &this->m_materialManager, &this->m_shaderManager,
-                                  &this->m_pipelineDescriptorSets, getTextureDescriptorSet);
-        
-        /* Update object data SSBO using TieredInstanceManager.
-           - Static: Only when scene rebuilds
-           - SemiStatic: When scene rebuilds OR object dirty flag set
-           - Dynamic: Every frame
-           - Procedural: Compute shader (future) - placeholder for now
-           Must happen AFTER RebuildIfDirty so batches are valid. */
-        {
-            uint32_t lFrameIndex = this->m_sync.GetCurrentFrameIndex();
-            ObjectData* pObjectData = this->m_objectDataRingBuffer.GetFrameData(lFrameIndex);
-            
-            if (pObjectData != nullptr && pScene != nullptr) {
+        /* Render prep (transforms, lights, batches, SSBO, culling, draw calls) runs as the CPU frame graph
+           (BuildFrameGraph): worker stages overlap the main-thread Vulkan stages. */
+        FramePrep& stPrep = this->m_framePrep;
+        stPrep.pScene = this->m_sceneManager.GetCurrentScene();
+        std::memcpy(stPrep.fViewProj, fViewProj, sizeof(fViewProj));
+        std::memcpy(stPrep.fCamPos, fCamPos, sizeof(fCamPos));
+        stPrep.lDrawHeight = lDrawH;
+        /* Editor uses viewport's offscreen render pass; Runtime uses main swapchain render pass. */
 #if EDITOR_BUILD
-                std::unordered_set<uint32_t> movedIds = this->m_editorLayer.ConsumeMovedObjectIds();
-                const std::unordered_set<uint32_t>* pMovedIds = movedIds.empty() ? nullptr : &movedIds;
-                this->m_tieredInstanceManager.UpdateSSBO(
-                    pObjectData,
-                    this->m_config.lMaxObjects,
-                    this->m_batchedDrawList.GetLastRenderObjects(),
-                    this->m_batchedDrawList.GetOpaqueBatches(),
-                    this->m_batchedDrawList.GetTransparentBatches(),
-                    bSceneRebuilt,
-                    false,
-                    pMovedIds);
+        const VkRenderPass offscreenRenderPass = this->m_viewportManager.GetOffscreenRenderPass();
+        stPrep.renderPassForBatching = (offscreenRenderPass != VK_NULL_HANDLE) ? offscreenRenderPass : this->m_renderPass.Get();
+        stPrep.bBatchHasDepth = (offscreenRenderPass != VK_NULL_HANDLE) ? true : this->m_renderPass.HasDepthAttachment();
+        /* Editor layer is main-thread state: take the gizmo moves before the SSBO stage runs on a worker. */
+        stPrep.movedIds = this->m_editorLayer.ConsumeMovedObjectIds(this->m_frameArenas.Get());
 #else
-                this->m_tieredInstanceManager.UpdateSSBO(
-                    pObjectData,
-                    this->m_config.lMaxObjects,
-                    this->m_batchedDrawList.GetLastRenderObjects(),
-                    this->m_batchedDrawList.GetOpaqueBatches(),
-                    this->m_batchedDrawList.GetTransparentBatches(),
-                    bSceneRebuilt,
-                    false);
+        stPrep.renderPassForBatching = this->m_renderPass.Get();
+        stPrep.bBatchHasDepth = this->m_renderPass.HasDepthAttachment();
 #endif
-            }
-        }
-        
-        /* Update visibility (frustum culling) each frame - fast operation on existing batches */
-        this->m_batchedDrawList.UpdateVisibility(fViewProj, pScene);
-        
-        /* Update GPU culler with frustum and object bounds (parallel to CPU culling for verification).
-           GPU culler will be used for indirect draw in Phase 4. */
-        if (this->m_gpuCullerEnabled && pScene != nullptr) {
-            // Extract frustum planes from view-projection matrix
-            float frustumPlanes[6][4];
-            ExtractFrustumPlanesFromViewProj(fViewProj, frustumPlanes);
-            
-            const std::vector<RenderObject>& renderObjects = this->m_batchedDrawList.GetLastRenderObjects();
-            const auto& opaqueBatchesForCull = this->m_batchedDrawList.GetOpaqueBatches();
-            const auto& transparentBatchesForCull = this->m_batchedDrawList.GetTransparentBatches();
-            const uint32_t totalBatches = static_cast<uint32_t>(opaqueBatchesForCull.size() + transparentBatchesForCull.size());
-            
-            // Count total objects across all batches
-            size_t totalCullObjects = 0;
-            for (const auto& batch : opaqueBatchesForCull) {
-                totalCullObjects += batch.objectIndices.size();
-            }
-            for (const auto& batch : transparentBatchesForCull) {
-                totalCullObjects += batch.objectIndices.size();
-            }
-            
-            // Warn if scene exceeds GPU culler capacity
-            if (totalCullObjects > this->m_config.lMaxObjects) {
-                static bool warnedOnce = false;
-                if (!warnedOnce) {
-                    VulkanUtils::LogWarn("Scene has {} objects but GPU culler limit is {} - some objects will not render! "
-                                         "Increase 'max_objects' in config.", 
-                                         totalCullObjects, this->m_config.lMaxObjects);
-                    warnedOnce = true;
-                }
-            }
-            
-            if (totalCullObjects > 0 && totalBatches > 0) {
-                this->m_cullObjectsCache.resize(totalCullObjects);
-                
-                size_t cullIdx = 0;
-                uint32_t batchId = 0;
-                
-                // Helper to process batches and set up GPU culler
-                auto processBatchesForCull = [&](const std::vector<DrawBatch>& batches) {
-                    for (const DrawBatch& batch : batches) {
-                        // Set up draw info for this batch (vertexCount, firstVertex)
-                        this->m_gpuCuller.SetBatchDrawInfo(batchId, batch.vertexCount, batch.firstVertex);
-                        
-                        uint32_t localIdx = 0;
-                        for (uint32_t objIdx : batch.objectIndices) {
-                            if (objIdx >= renderObjects.size()) continue;
-
-                            const RenderObject& ro = renderObjects[objIdx];
-                            CullObjectData& cullObj = this->m_cullObjectsCache[cullIdx];
-
-                            cullObj.boundingSphere[0] = ro.boundsCenterX;
-                            cullObj.boundingSphere[1] = ro.boundsCenterY;
-                            cullObj.boundingSphere[2] = ro.boundsCenterZ;
-                            cullObj.boundingSphere[3] = ro.boundsRadius;
-                            
-                            // SSBO offset = batch.firstInstanceIndex + local index within batch
-                            cullObj.objectIndex = batch.firstInstanceIndex + localIdx;
-                            cullObj.batchId = batchId;
-                            cullObj._pad0 = 0;
-                            cullObj._pad1 = 0;
-                            
-                            ++cullIdx;
-                            ++localIdx;
-                        }
-                        ++batchId;
-                    }
-                };
-                
-                processBatchesForCull(opaqueBatchesForCull);
-                processBatchesForCull(transparentBatchesForCull);
-                
-                // Update frustum planes in GPU culler (with batch count)
-                this->m_gpuCuller.UpdateFrustum(frustumPlanes, static_cast<uint32_t>(totalCullObjects), totalBatches);
-                
-                // Upload cull objects to GPU
-                this->m_gpuCuller.UploadCullObjects(this->m_cullObjectsCache.data(), static_cast<uint32_t>(totalCullObjects));
-            }
-        }
-        
-        /* Convert batches to DrawCall format.
-           Each batch = 1 draw call with instanceCount = number of objects in batch.
-           GPU uses batchStartIndex + gl_InstanceIndex to look up per-object data in SSBO.
-           Exception: time_demo pipeline uses 128-byte push (viewProj + model) and one draw per object. */
-        this->m_drawCalls.clear();
-        const auto& opaqueBatches = this->m_batchedDrawList.GetOpaqueBatches();
-        const auto& transparentBatches = this->m_batchedDrawList.GetTransparentBatches();
-        const auto& renderObjects = this->m_batchedDrawList.GetLastRenderObjects();
-        constexpr uint32_t kTimeDemoPushSize = 128u;
-        
-        size_t reserveCount = 0;
-        for (const auto& b : opaqueBatches)
-            reserveCount += (b.pipelineKey == "time_demo") ? b.objectIndices.size() : 1;
-        for (const auto& b : transparentBatches)
-            reserveCount += (b.pipelineKey == "time_demo") ? b.objectIndices.size() : 1;
-        this->m_drawCalls.reserve(reserveCount);
-        
-        /* Helper to create draw call from batch (instanced path) */
-        auto createDrawCallFromBatch = [&](const DrawBatch& batch) {
-            if (batch.objectIndices.empty()) return;
-            if (batch.pipeline == VK_NULL_HANDLE) return;
-            
-            DrawCall dc = {
-                .pipeline           = batch.pipeline,
-                .pipelineLayout     = batch.pipelineLayout,
-                .vertexBuffer       = batch.vertexBuffer,
-                .vertexBufferOffset = batch.vertexBufferOffset,
-                .pPushConstants     = nullptr,  // Push constants built per-viewport
-                .pushConstantSize   = kInstancedPushConstantSize,
-                .vertexCount        = batch.vertexCount,
-                .instanceCount      = static_cast<uint32_t>(batch.objectIndices.size()),  // Instanced!
-                .firstVertex        = batch.firstVertex,
-                .firstInstance      = 0,
-                .descriptorSets     = batch.descriptorSets,
-                .instanceBuffer     = VK_NULL_HANDLE,
-                .instanceBufferOffset = 0,
-                .dynamicOffsets     = {},
-                .pLocalTransform    = nullptr,
-                .color              = {1.0f, 1.0f, 1.0f, 1.0f},
-                .objectIndex        = batch.firstInstanceIndex,  // batchStartIndex for SSBO
-                .pipelineKey        = batch.pipelineKey,
-            };
-            this->m_drawCalls.push_back(dc);
-        };
-        
-        /* Helper: one DrawCall per object for time_demo (128-byte push viewProj + model) */
-        auto createTimeDemoDrawCalls = [&](const DrawBatch& batch) {
-            if (batch.pipeline == VK_NULL_HANDLE || batch.objectIndices.empty()) return;
-            for (uint32_t objIdx : batch.objectIndices) {
-                if (objIdx >= renderObjects.size()) continue;
-                const float* pModel = renderObjects[objIdx].worldMatrix;
-                DrawCall dc = {
-                    .pipeline           = batch.pipeline,
-                    .pipelineLayout     = batch.pipelineLayout,
-                    .vertexBuffer       = batch.vertexBuffer,
-                    .vertexBufferOffset = batch.vertexBufferOffset,
-                    .pPushConstants     = nullptr,
-                    .pushConstantSize   = kTimeDemoPushSize,
-                    .vertexCount        = batch.vertexCount,
-                    .instanceCount      = 1,
-                    .firstVertex        = batch.firstVertex,
-                    .firstInstance      = 0,
-                    .descriptorSets     = batch.descriptorSets,
-                    .instanceBuffer     = VK_NULL_HANDLE,
-                    .instanceBufferOffset = 0,
-                    .dynamicOffsets     = {},
-                    .pLocalTransform    = pModel,
-                    .color              = {1.0f, 1.0f, 1.0f, 1.0f},
-                    .objectIndex        = 0,
-                    .pipelineKey        = batch.pipelineKey,
-                };
-                this->m_drawCalls.push_back(dc);
-            }
-        };
-        
-        for (const auto& batch : opaqueBatches) {
-            if (batch.pipelineKey == "time_demo")
-                createTimeDemoDrawCalls(batch);
-            else
-                createDrawCallFromBatch(batch);
-        }
-        for (const auto& batch : transparentBatches) {
-            if (batch.pipelineKey == "time_demo")
-                createTimeDemoDrawCalls(batch);
-            else
-                createDrawCallFromBatch(batch);
-        }
+        stPrep.bSceneRebuilt = false;
+        stPrep.bObjectDataRebuilt = false;
+        this->m_frameGraph.Execute(this->m_jobQueue.GetScheduler());
+        this->m_bTextureIndicesChanged = false;
+        /* Cache entries only lose their last outside reference when the batches drop them: trim on rebuild only. */
+        if (stPrep.bSceneRebuilt == true)
+            this->m_resourceCleanupManager.TrimAllCaches();
 
 #if EDITOR_BUILD
         /* Draw editor panels and gizmos, then end ImGui frame. */
@@ -1552,7 +1501,7 @@ void VulkanApp::MainLoop() {
                     VulkanUtils::LogInfo("Loading level: {}", pLevel->path);
                     this->m_sceneManager.UnloadScene();
                     
-                    if (this->m_sceneManager.LoadLevelFromFile(pLevel->path)) {
+                    if (this->LoadLevel(pLevel->path)) {
                         VulkanUtils::LogInfo("Level loaded successfully: {}", pLevel->name);
                         this->m_levelSelector.SetCurrentLevelPath(pLevel->path);
                         this->m_editorLayer.SetLevelPath(pLevel->path);
@@ -1564,9 +1513,10 @@ void VulkanApp::MainLoop() {
                 // Force draw list rebuild
                 this->m_batchedDrawList.SetDirty();
                 
-                // Trim unused resources
+                // Trim unused resources (GPU idle since the wait above: nothing to defer)
                 this->m_meshManager.TrimUnused();
                 this->m_textureManager.TrimUnused();
+                this->m_releaseQueue.Flush();
             }
         }
 #else
@@ -1633,6 +1583,63 @@ void VulkanApp::MainLoop() {
             stats.gpuCulledVisible  = this->m_gpuCullStats.gpuVisibleCount;
             stats.gpuCulledTotal    = this->m_gpuCullStats.totalObjectCount;
             stats.gpuCpuMismatch    = this->m_gpuCullStats.mismatchDetected;
+            stats.meshletCullerActive = this->m_meshletCullerEnabled && this->m_meshletCuller.IsValid();
+            stats.meshletsVisible     = this->m_meshletVisibleCount;
+            stats.meshletsSubmitted   = 0;
+            for (const MeshletCullBatch& stSection : this->m_meshletBatchesCache)
+                stats.meshletsSubmitted += stSection.drawCapacity;
+
+            // Texture streaming residency
+            const TextureStreamingStats& streamStats = this->m_textureManager.GetStreamingStats();
+            stats.texturesStreamed       = streamStats.lStreamed;
+            stats.texturesFullyResident  = streamStats.lFullyResident;
+            stats.textureResidentMB      = static_cast<float>(static_cast<double>(streamStats.uResidentBytes) / (1024.0 * 1024.0));
+            stats.textureWantedMB        = static_cast<float>(static_cast<double>(streamStats.uWantedBytes) / (1024.0 * 1024.0));
+            stats.textureBudgetMB        = static_cast<float>(static_cast<double>(streamStats.uBudgetBytes) / (1024.0 * 1024.0));
+            stats.textureStreamChanges   = streamStats.lUpgrades + streamStats.lEvictions;
+
+            // CPU frame graph
+            const FrameGraphStats& graphStats = this->m_frameGraph.GetStats();
+            stats.cpuPrepMs       = graphStats.fWallMs;
+            stats.cpuPrepSerialMs = graphStats.fSerialMs;
+            stats.cpuWorkers      = this->m_jobQueue.GetScheduler().GetWorkerCount();
+
+            // Command recording of the last frame (thread slots: workers, then the main thread)
+            if (this->m_vecRecordThreadMs.empty() == false) {
+                const size_t zWorkers = this->m_vecRecordThreadMs.size() - 1u;
+                stats.recordMainMs      = this->m_vecRecordThreadMs.back();
+                stats.recordWorkers     = static_cast<uint32_t>(std::min(zWorkers, static_cast<size_t>(RenderStats::kMaxRecordWorkers)));
+                stats.recordSecondaries = this->m_lRecordedSecondaries;
+                for (uint32_t lWorker = 0; lWorker < stats.recordWorkers; ++lWorker)
+                    stats.recordWorkerMs[lWorker] = this->m_vecRecordThreadMs[lWorker];
+            }
+
+            // Per-frame memory (allocations of the last complete frame)
+            stats.heapCounted        = AllocCounter::IsEnabled();
+            stats.heapAllocsPerFrame = static_cast<uint32_t>(std::min<uint64_t>(this->m_uLastFrameAllocations, UINT32_MAX));
+            stats.frameArenaKB       = static_cast<float>(static_cast<double>(this->m_frameArenas.GetStats().zUsed) / 1024.0);
+
+            // Device memory blocks, categories and the first device-local heap's budget
+            const DeviceMemoryStats memStats = this->m_memoryAllocator.GetStats();
+            constexpr double dMiB = 1024.0 * 1024.0;
+            stats.gpuMemBlocks        = memStats.lBlocks;
+            stats.gpuMemDedicated     = memStats.lDedicated;
+            stats.gpuMemBlockMB       = static_cast<float>(static_cast<double>(memStats.uBlockBytes) / dMiB);
+            stats.gpuMemUsedMB        = static_cast<float>(static_cast<double>(memStats.uBlockUsedBytes) / dMiB);
+            stats.gpuMemDedicatedMB   = static_cast<float>(static_cast<double>(memStats.uDedicatedBytes) / dMiB);
+            stats.gpuMemFragmentation = memStats.fFragmentation;
+            static_assert(std::size(RenderStats{}.gpuMemCategoryMB) == static_cast<size_t>(MemoryCategory::Count));
+            for (size_t zCategory = 0; zCategory < static_cast<size_t>(MemoryCategory::Count); ++zCategory)
+                stats.gpuMemCategoryMB[zCategory] = static_cast<float>(static_cast<double>(memStats.auCategoryBytes[zCategory]) / dMiB);
+            const VkPhysicalDeviceMemoryProperties& memProps = this->m_memoryAllocator.GetMemoryProperties();
+            for (uint32_t lHeap = 0; lHeap < memStats.lHeapCount; ++lHeap) {
+                if ((memProps.memoryHeaps[lHeap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0)
+                    continue;
+                stats.gpuHeapUsageMB      = static_cast<float>(static_cast<double>(memStats.astHeaps[lHeap].uUsage) / dMiB);
+                stats.gpuHeapBudgetMB     = static_cast<float>(static_cast<double>(memStats.astHeaps[lHeap].uBudget) / dMiB);
+                stats.gpuHeapDriverBudget = memStats.bDriverBudget;
+                break;
+            }
             
             this->m_runtimeOverlay.SetRenderStats(stats);
         }
@@ -1685,7 +1692,7 @@ void VulkanApp::MainLoop() {
                     VulkanUtils::LogInfo("Loading level: {}", pLevel->path);
                     this->m_sceneManager.UnloadScene();
                     
-                    if (this->m_sceneManager.LoadLevelFromFile(pLevel->path)) {
+                    if (this->LoadLevel(pLevel->path)) {
                         VulkanUtils::LogInfo("Level loaded successfully: {}", pLevel->name);
                         this->m_levelSelector.SetCurrentLevelPath(pLevel->path);
                         this->m_bLevelLoaded = true;
@@ -1699,9 +1706,10 @@ void VulkanApp::MainLoop() {
                 // Force draw list rebuild
                 this->m_batchedDrawList.SetDirty();
                 
-                // Trim unused resources
+                // Trim unused resources (GPU idle since the wait above: nothing to defer)
                 this->m_meshManager.TrimUnused();
                 this->m_textureManager.TrimUnused();
+                this->m_releaseQueue.Flush();
                 
                 // Clear main menu's load request flag
                 this->m_mainMenu.ClearLevelLoadRequest();
@@ -1712,6 +1720,7 @@ void VulkanApp::MainLoop() {
         /* Always present (empty draw list = clear only) so swapchain and frame advance stay valid. */
         if (!DrawFrame(this->m_drawCalls, fViewProj))
             break;
+        this->m_uLastFrameAllocations = AllocCounter::GetAllocationCount() - uAllocsAtFrameStart;
 
         /* FPS in window title (smoothed, update every 0.25 s). */
         const auto frameEnd = std::chrono::steady_clock::now();
@@ -1722,8 +1731,10 @@ void VulkanApp::MainLoop() {
         constexpr double kFpsTitleIntervalSec = 0.25;
         if (std::chrono::duration<double>(frameEnd - this->m_lastFpsTitleUpdate).count() >= kFpsTitleIntervalSec) {
             const int iFps = static_cast<int>(std::round(static_cast<double>(1.0) / static_cast<double>(this->m_avgFrameTimeSec)));
-            const std::string sBaseTitle = (this->m_config.sWindowTitle.empty() == true) ? std::string("Vulkan App") : this->m_config.sWindowTitle;
-            this->m_pWindow->SetTitle((sBaseTitle + " - " + std::to_string(iFps) + " FPS").c_str());
+            const char* pBaseTitle = (this->m_config.sWindowTitle.empty() == true) ? "Vulkan App" : this->m_config.sWindowTitle.c_str();
+            char szTitle[256];
+            std::snprintf(szTitle, sizeof(szTitle), "%s - %d FPS", pBaseTitle, iFps);  // No string building: keeps the frame off the heap
+            this->m_pWindow->SetTitle(szTitle);
             this->m_lastFpsTitleUpdate = frameEnd;
         }
     }
@@ -1769,12 +1780,63 @@ void VulkanApp::ApplyConfig(const VulkanConfig& stNewConfig_ic) {
  * Callback functions (extracted from lambdas per coding guidelines)
  * ============================================================================ */
 
-void VulkanApp::OnSceneChanged() {
-    this->m_batchedDrawList.SetDirty();
+bool VulkanApp::LoadLevel(const std::string& sPath_ic) {
+    /* The previous level's prewarmed pipelines are trimmed once nothing draws with them. */
+    this->m_pipelineManager.ClearPrewarm();
+    this->m_vecLevelMaterialIds.clear();
+    this->m_zPrewarmedMaterials = 0u;
+    bool bLoaded = false;
+    if (this->m_config.bAsyncLevelLoad == true)
+        bLoaded = this->m_sceneManager.BeginLevelLoadAsync(sPath_ic);
+    else
+        bLoaded = this->m_sceneManager.LoadLevelFromFile(sPath_ic);
+    /* Blocking load: every material is known, so the next PrewarmLevelPipelines compiles them all up front. */
+    this->m_bPrewarmWait = (bLoaded == true) && (this->m_sceneManager.IsLevelLoading() == false);
+    return bLoaded;
 }
 
-void VulkanApp::OnTrimAllCaches() {
-    this->m_resourceCleanupManager.TrimAllCaches();
+void VulkanApp::PrewarmLevelPipelines() {
+    this->m_sceneManager.ConsumeLevelMaterialIds(this->m_vecLevelMaterialIds);
+    /* Same render pass as the draw batches (see MainLoop render prep). */
+#if EDITOR_BUILD
+    const VkRenderPass offscreenRenderPass = this->m_viewportManager.GetOffscreenRenderPass();
+    const VkRenderPass renderPass = (offscreenRenderPass != VK_NULL_HANDLE) ? offscreenRenderPass : this->m_renderPass.Get();
+    const bool bHasDepth = (offscreenRenderPass != VK_NULL_HANDLE) ? true : this->m_renderPass.HasDepthAttachment();
+#else
+    const VkRenderPass renderPass = this->m_renderPass.Get();
+    const bool bHasDepth = this->m_renderPass.HasDepthAttachment();
+#endif
+    if (renderPass == VK_NULL_HANDLE)
+        return;
+    const VkDevice device = this->m_device.GetDevice();
+    for (; this->m_zPrewarmedMaterials < this->m_vecLevelMaterialIds.size(); ++this->m_zPrewarmedMaterials) {
+        std::shared_ptr<MaterialHandle> pMaterial = this->m_materialManager.GetMaterial(this->m_vecLevelMaterialIds[this->m_zPrewarmedMaterials]);
+        if (pMaterial == nullptr)
+            continue;
+        pMaterial->PrewarmPipeline(device, renderPass, &this->m_pipelineManager, &this->m_shaderManager, bHasDepth);
+#if EDITOR_BUILD
+        /* Wireframe viewports draw the wire variant on the offscreen render pass (RecordViewports). */
+        if (offscreenRenderPass != VK_NULL_HANDLE) {
+            const std::string sWireKey = GetWireframePipelineKey(pMaterial->pipelineKey);
+            std::shared_ptr<MaterialHandle> pWireMat = (sWireKey != pMaterial->pipelineKey) ? this->m_materialManager.GetMaterial(sWireKey) : nullptr;
+            if (pWireMat != nullptr)
+                pWireMat->PrewarmPipeline(device, offscreenRenderPass, &this->m_pipelineManager, &this->m_shaderManager, true);
+        }
+#endif
+    }
+    if (this->m_bPrewarmWait == true) {
+        this->m_bPrewarmWait = false;
+        const auto tStart = std::chrono::steady_clock::now();
+        this->m_pipelineManager.WaitForPrewarm(kPrewarmWaitTimeoutMs);
+        const PipelinePrewarmProgress stPrewarm = this->m_pipelineManager.GetPrewarmProgress();
+        VulkanUtils::LogInfo("Level pipelines: {} prewarmed in {:.1f} ms", stPrewarm.lTotal,
+                             std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tStart).count());
+        this->m_batchedDrawList.SetDirty();
+    }
+}
+
+void VulkanApp::OnSceneChanged() {
+    this->m_batchedDrawList.SetDirty();
 }
 
 bool VulkanApp::OnEditorEvent(const SDL_Event& evt_ic) {
@@ -1840,12 +1902,163 @@ void VulkanApp::RenderRuntimeUI(VkCommandBuffer cmd) {
 #endif
 }
 
-#if EDITOR_BUILD
-void VulkanApp::RenderViewports(VkCommandBuffer cmd, const std::vector<DrawCall>* pDrawCalls_ic, const float* pViewProj_ic,
-                                Scene* pScene_ic) {
-    /* Per-viewport temporary push constant buffer (96 bytes for instanced rendering) */
+void VulkanApp::RecordDrawRange(VkCommandBuffer cmd, const SceneViewRecord& view_ic, const std::vector<DrawCall>& vecDrawCalls_ic,
+                                uint32_t lBegin_ic, uint32_t lEnd_ic) const {
+    /* Dynamic state is not inherited by secondary command buffers */
+    vkCmdSetViewport(cmd, 0, 1, &view_ic.viewport);
+    vkCmdSetScissor(cmd, 0, 1, &view_ic.scissor);
+
+    /* Per-view push constant scratch (96 bytes for instanced rendering) */
     alignas(16) uint8_t vpPushData[kInstancedPushConstantSize];
-    
+    const bool bUseIndirectDraw = this->m_gpuIndirectDrawEnabled && this->m_gpuCullerEnabled;
+    const bool bPipelineOverrides = (view_ic.vecPipelines.empty() == false);
+    const bool bRasterOverrides = (view_ic.vecRasterStates.empty() == false);
+    const ExtendedDynamicState& stDynamicState = this->m_device.GetExtendedDynamicState();
+
+    /* Batches share the per-pipeline sets (bindless textures) and often a vertex buffer: skip binds identical to the previous draw's. */
+    VkPipeline pBoundPipeline = VK_NULL_HANDLE;
+    RasterDynamicState stBoundRaster = {};
+    bool bRasterSet = false;
+    const DrawCall* pBoundSets = nullptr;
+    VkBuffer pBoundVertexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize uBoundVertexOffset = 0;
+
+    for (uint32_t i = lBegin_ic; i < lEnd_ic; ++i) {
+        const DrawCall& dc = vecDrawCalls_ic[i];
+        const VkPipeline pipelineToUse = (bPipelineOverrides == true) ? view_ic.vecPipelines[i] : dc.pipeline;
+        if (pipelineToUse != pBoundPipeline) {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineToUse);
+            pBoundPipeline = pipelineToUse;
+        }
+        /* Extended dynamic state: every draw needs it set once per command buffer, then only changes */
+        if (stDynamicState.bEnabled == true) {
+            const RasterDynamicState& stRaster = (bRasterOverrides == true) ? view_ic.vecRasterStates[i] : dc.rasterState;
+            if ((bRasterSet == false) || ((stRaster == stBoundRaster) == false)) {
+                CmdSetRasterDynamicState(cmd, stDynamicState, stRaster, (bRasterSet == true) ? &stBoundRaster : nullptr);
+                stBoundRaster = stRaster;
+                bRasterSet = true;
+            }
+        }
+        const bool bSameSets = (pBoundSets != nullptr) && (pBoundSets->pipelineLayout == dc.pipelineLayout) &&
+                               (pBoundSets->descriptorSets == dc.descriptorSets);
+        if ((dc.descriptorSets.empty() == false) && (bSameSets == false)) {
+            pBoundSets = &dc;
+            /* Pass the current frame's dynamic offset for the object data SSBO.
+               Binding 2 is STORAGE_BUFFER_DYNAMIC, requiring exactly 1 dynamic offset. */
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipelineLayout,
+                static_cast<uint32_t>(0), static_cast<uint32_t>(dc.descriptorSets.size()), dc.descriptorSets.data(),
+                static_cast<uint32_t>(1), &this->m_currentFrameObjectDataOffset);
+        }
+
+        /* Meshlet-culled batch: draws come from the meshlet culler (firstInstance = ObjectData index).
+           With indirect draw every draw call is one culler batch, so the batch id is the draw index. */
+        VkDeviceSize uMeshletDrawOffset = 0;
+        VkDeviceSize uMeshletCountOffset = 0;
+        uint32_t lMeshletMaxDraws = 0;
+        const bool bMeshletDraw = (bUseIndirectDraw == true) && (dc.pushConstantSize == kInstancedPushConstantSize) &&
+            (GetMeshletDrawRange(i, uMeshletDrawOffset, uMeshletCountOffset, lMeshletMaxDraws) == true);
+
+        /* Recompute push constants with the view's viewProj (instanced layout) */
+        if (dc.pushConstantSize == kInstancedPushConstantSize) {
+            std::memcpy(vpPushData, view_ic.viewProj, static_cast<size_t>(64));
+            std::memcpy(vpPushData + static_cast<size_t>(64), view_ic.camPos, static_cast<size_t>(12));
+            float camW = static_cast<float>(1.0f);
+            std::memcpy(vpPushData + static_cast<size_t>(76), &camW, static_cast<size_t>(4));
+            
+            /* For indirect draw: batchStartIndex = 0 (offset is in firstInstance)
+               For direct draw: batchStartIndex = dc.objectIndex (SSBO offset) */
+            uint32_t batchStartIndex = bUseIndirectDraw ? 0 : dc.objectIndex;
+            std::memcpy(vpPushData + static_cast<size_t>(80), &batchStartIndex, static_cast<size_t>(4));
+            
+            /* useIndirection = 1 for GPU indirect draw, 0 for direct indexing (and meshlet draws) */
+            uint32_t useIndirection = ((bUseIndirectDraw == true) && (bMeshletDraw == false)) ? 1 : 0;
+            std::memcpy(vpPushData + static_cast<size_t>(84), &useIndirection, static_cast<size_t>(4));
+            std::memset(vpPushData + static_cast<size_t>(88), static_cast<int>(0), static_cast<size_t>(8));
+            
+            vkCmdPushConstants(cmd, dc.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                static_cast<uint32_t>(0), kInstancedPushConstantSize, vpPushData);
+        } else if (dc.pushConstantSize == 128u && dc.pLocalTransform != nullptr) {
+            /* Time-demo (and similar) per-object push: viewProj (64) + model (64) */
+            alignas(16) uint8_t timeDemoPush[128];
+            std::memcpy(timeDemoPush, view_ic.viewProj, static_cast<size_t>(64));
+            std::memcpy(timeDemoPush + 64, dc.pLocalTransform, static_cast<size_t>(64));
+            vkCmdPushConstants(cmd, dc.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                0, 128, timeDemoPush);
+        } else if ((dc.pushConstantSize > static_cast<uint32_t>(0)) && (dc.pPushConstants != nullptr)) {
+            vkCmdPushConstants(cmd, dc.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                static_cast<uint32_t>(0), dc.pushConstantSize, dc.pPushConstants);
+        }
+        
+        if ((dc.vertexBuffer != pBoundVertexBuffer) || (dc.vertexBufferOffset != uBoundVertexOffset)) {
+            vkCmdBindVertexBuffers(cmd, static_cast<uint32_t>(0), static_cast<uint32_t>(1), &dc.vertexBuffer, &dc.vertexBufferOffset);
+            pBoundVertexBuffer = dc.vertexBuffer;
+            uBoundVertexOffset = dc.vertexBufferOffset;
+        }
+        
+        if (bMeshletDraw == true) {
+            /* GPU meshlet draw: commands and count written by meshlet_cull.comp */
+            vkCmdDrawIndirectCount(cmd, this->m_meshletCuller.GetDrawBuffer(), uMeshletDrawOffset,
+                                   this->m_meshletCuller.GetDrawCountBuffer(), uMeshletCountOffset,
+                                   lMeshletMaxDraws, sizeof(VkDrawIndirectCommand));
+        } else if (bUseIndirectDraw) {
+            /* GPU indirect draw: instanceCount written by compute shader */
+            VkDeviceSize indirectOffset = static_cast<VkDeviceSize>(i) * sizeof(VkDrawIndirectCommand);
+            vkCmdDrawIndirect(cmd, this->m_gpuCuller.GetIndirectBuffer(), indirectOffset, 1, sizeof(VkDrawIndirectCommand));
+        } else {
+            /* Direct draw: CPU-specified instanceCount */
+            vkCmdDraw(cmd, dc.vertexCount, dc.instanceCount, dc.firstVertex, dc.firstInstance);
+        }
+    }
+}
+
+void VulkanApp::RecordSceneSecondaries(const std::vector<DrawCall>& vecDrawCalls_ic, uint32_t lFrameIndex_ic) {
+    const uint32_t lDraws = static_cast<uint32_t>(vecDrawCalls_ic.size());
+    const uint32_t lSlots = this->m_commandBuffers.GetSecondarySlotCount();
+    /* Enough draws per range to pay for a task and a secondary buffer; no more ranges per view than threads. */
+    const uint32_t lRangesPerView = std::clamp((lDraws + kMinDrawsPerRecordTask - 1u) / kMinDrawsPerRecordTask, 1u, std::max(lSlots, 1u));
+    const uint32_t lDrawsPerRange = std::max((lDraws + lRangesPerView - 1u) / lRangesPerView, 1u);
+
+    this->m_vecRecordTasks.clear();
+    for (uint32_t lView = 0; lView < static_cast<uint32_t>(this->m_vecViewRecords.size()); ++lView) {
+        for (uint32_t lBegin = 0; lBegin < lDraws; lBegin += lDrawsPerRange)
+            this->m_vecRecordTasks.push_back({ lView, lBegin, std::min(lBegin + lDrawsPerRange, lDraws), VK_NULL_HANDLE });
+    }
+
+    /* One task per range; each thread records into its own pool (thread slot), so no two threads share a pool. */
+    TaskScheduler& scheduler = this->m_jobQueue.GetScheduler();
+    scheduler.ParallelFor(static_cast<uint32_t>(this->m_vecRecordTasks.size()), 1u,
+        [this, &scheduler, &vecDrawCalls_ic, lFrameIndex_ic](uint32_t lFirst, uint32_t lLast) {
+            const auto tStart = std::chrono::steady_clock::now();
+            const uint32_t lSlot = scheduler.GetThreadSlot();
+            for (uint32_t t = lFirst; t < lLast; ++t) {
+                RecordTask& stTask = this->m_vecRecordTasks[t];
+                const SceneViewRecord& view = this->m_vecViewRecords[stTask.lView];
+                stTask.pCmd = this->m_commandBuffers.BeginSecondary(lFrameIndex_ic, lSlot, view.renderPass, view.framebuffer);
+                RecordDrawRange(stTask.pCmd, view, vecDrawCalls_ic, stTask.lBegin, stTask.lEnd);
+                this->m_commandBuffers.EndSecondary(stTask.pCmd);
+            }
+            this->m_vecRecordThreadMs[lSlot] += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+        }, TaskPriority::High);
+
+    /* Tasks are in view order, then draw order: that is the execution order. */
+    for (const RecordTask& stTask : this->m_vecRecordTasks)
+        this->m_vecViewRecords[stTask.lView].vecSecondaries.push_back(stTask.pCmd);
+    this->m_lRecordedSecondaries += static_cast<uint32_t>(this->m_vecRecordTasks.size());
+}
+
+VkCommandBuffer VulkanApp::BeginMainThreadSecondary(const SceneViewRecord& view_ic, uint32_t lFrameIndex_ic) {
+    VkCommandBuffer cmd = this->m_commandBuffers.BeginSecondary(lFrameIndex_ic, this->m_jobQueue.GetScheduler().GetThreadSlot(),
+                                                                view_ic.renderPass, view_ic.framebuffer);
+    vkCmdSetViewport(cmd, 0, 1, &view_ic.viewport);
+    vkCmdSetScissor(cmd, 0, 1, &view_ic.scissor);
+    ++this->m_lRecordedSecondaries;
+    return cmd;
+}
+
+#if EDITOR_BUILD
+void VulkanApp::RecordViewports(const std::vector<DrawCall>& vecDrawCalls_ic, Scene* pScene_ic, uint32_t lFrameIndex_ic) {
+    /* Views are reused frame to frame (their vectors keep their capacity) */
+    size_t zViews = 0;
     auto& vps = this->m_viewportManager.GetViewports();
     for (auto& vp : vps) {
         if (vp.config.bVisible == false) {
@@ -1854,6 +2067,26 @@ void VulkanApp::RenderViewports(VkCommandBuffer cmd, const std::vector<DrawCall>
         if (vp.renderTarget.IsValid() == false) {
             continue;
         }
+        if (zViews == this->m_vecViewRecords.size()) {
+            this->m_vecViewRecords.emplace_back();
+        }
+        SceneViewRecord& view = this->m_vecViewRecords[zViews++];
+        view.vecSecondaries.clear();
+        view.vecPipelines.clear();
+        view.vecRasterStates.clear();
+        view.viewportId = vp.config.id;
+        view.renderPass = this->m_viewportManager.GetOffscreenRenderPass();
+        view.framebuffer = vp.renderTarget.framebuffer;
+        view.viewport = {
+            .x        = static_cast<float>(0.0f),
+            .y        = static_cast<float>(0.0f),
+            .width    = static_cast<float>(vp.renderTarget.width),
+            .height   = static_cast<float>(vp.renderTarget.height),
+            .minDepth = static_cast<float>(0.0f),
+            .maxDepth = static_cast<float>(1.0f),
+        };
+        view.scissor = { .offset = { 0, 0 }, .extent = { vp.renderTarget.width, vp.renderTarget.height } };
+        view.bLightDebug = (vp.config.bShowLightDebug == true) && (this->m_lightDebugRenderer.IsReady() == true) && (pScene_ic != nullptr);
         
         /* Get the camera for this viewport (main camera or scene camera) */
         Camera* pVpCamera = this->m_viewportManager.GetCameraForViewport(vp, pScene_ic, &this->m_camera);
@@ -1862,8 +2095,7 @@ void VulkanApp::RenderViewports(VkCommandBuffer cmd, const std::vector<DrawCall>
         }
         
         /* Get camera position for this viewport */
-        float vpCamPos[3];
-        pVpCamera->GetPosition(vpCamPos[0], vpCamPos[1], vpCamPos[2]);
+        pVpCamera->GetPosition(view.camPos[0], view.camPos[1], view.camPos[2]);
         
         /* Get view matrix from the viewport's camera */
         alignas(16) float vpViewMat[16];
@@ -1886,109 +2118,70 @@ void VulkanApp::RenderViewports(VkCommandBuffer cmd, const std::vector<DrawCall>
         }
         
         /* Combine projection and view for this viewport */
-        alignas(16) float vpViewProj[16];
-        ObjectMat4Multiply(vpViewProj, vpProjMat, vpViewMat);
-        
-        /* Begin viewport render pass */
-        this->m_viewportManager.BeginViewportRender(vp.config.id, cmd);
-        
-        /* Determine if we need to switch to wireframe pipeline for this viewport */
-        const bool bWireframeMode = (vp.config.renderMode == ViewportRenderMode::Wireframe);
-        
-        /* Track batch index for GPU indirect draw */
-        uint32_t batchIndex = 0;
-        const bool bUseIndirectDraw = this->m_gpuIndirectDrawEnabled && this->m_gpuCullerEnabled;
+        ObjectMat4Multiply(view.viewProj, vpProjMat, vpViewMat);
         
-        /* Render scene draw calls to this viewport with recomputed MVP */
-        for (const auto& dc : *pDrawCalls_ic) {
-            /* Select the appropriate pipeline based on viewport render mode */
-            VkPipeline pipelineToUse = dc.pipeline;
-            
-            if ((bWireframeMode == true) && (dc.pipelineKey.empty() == false)) {
-                /* Get the wireframe variant of this pipeline */
-                std::string wireKey = GetWireframePipelineKey(dc.pipelineKey);
-                if (wireKey != dc.pipelineKey) {
-                    auto pWireMat = this->m_materialManager.GetMaterial(wireKey);
-                    if (pWireMat != nullptr) {
-                        VkPipeline wirePipe = pWireMat->GetPipelineIfReady(
-                            this->m_device.GetDevice(),
-                            this->m_viewportManager.GetOffscreenRenderPass(),
-                            &this->m_pipelineManager,
-                            &this->m_shaderManager,
-                            true
-                        );
-                        if (wirePipe != VK_NULL_HANDLE) {
-                            pipelineToUse = wirePipe;
+        /* Wireframe viewports: resolve the wireframe variant of each pipeline here (material and pipeline
+           managers are main-thread state; the recording tasks only read view.vecPipelines). With extended
+           dynamic state the wire material's raster state goes along (with EDS3 its pipeline is the solid one). */
+        if (vp.config.renderMode == ViewportRenderMode::Wireframe) {
+            const bool bDynamicState = this->m_device.GetExtendedDynamicState().bEnabled;
+            view.vecPipelines.reserve(vecDrawCalls_ic.size());
+            if (bDynamicState == true)
+                view.vecRasterStates.reserve(vecDrawCalls_ic.size());
+            for (const auto& dc : vecDrawCalls_ic) {
+                VkPipeline pipelineToUse = dc.pipeline;
+                RasterDynamicState stRaster = dc.rasterState;
+                if (dc.pipelineKey.empty() == false) {
+                    std::string wireKey = GetWireframePipelineKey(dc.pipelineKey);
+                    if (wireKey != dc.pipelineKey) {
+                        auto pWireMat = this->m_materialManager.GetMaterial(wireKey);
+                        if (pWireMat != nullptr) {
+                            VkPipeline wirePipe = pWireMat->GetPipelineIfReady(
+                                this->m_device.GetDevice(),
+                                this->m_viewportManager.GetOffscreenRenderPass(),
+                                &this->m_pipelineManager,
+                                &this->m_shaderManager,
+                                true
+                            );
+                            if (wirePipe != VK_NULL_HANDLE) {
+                                pipelineToUse = wirePipe;
+                                stRaster = GetRasterDynamicState(pWireMat->pipelineParams);
+                            }
                         }
                     }
                 }
-            }
-            
-            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineToUse);
-            if (dc.descriptorSets.empty() == false) {
-                /* Pass the current frame's dynamic offset for the object data SSBO.
-                   Binding 2 is STORAGE_BUFFER_DYNAMIC, requiring exactly 1 dynamic offset. */
-                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, dc.pipelineLayout,
-                    static_cast<uint32_t>(0), static_cast<uint32_t>(dc.descriptorSets.size()), dc.descriptorSets.data(),
-                    static_cast<uint32_t>(1), &this->m_currentFrameObjectDataOffset);
-            }
-            
-            /* Recompute push constants with viewport-specific viewProj (instanced layout) */
-            if (dc.pushConstantSize == kInstancedPushConstantSize) {
-                std::memcpy(vpPushData, vpViewProj, static_cast<size_t>(64));
-                std::memcpy(vpPushData + static_cast<size_t>(64), vpCamPos, static_cast<size_t>(12));
-                float camW = static_cast<float>(1.0f);
-                std::memcpy(vpPushData + static_cast<size_t>(76), &camW, static_cast<size_t>(4));
-                
-                /* For indirect draw: batchStartIndex = 0 (offset is in firstInstance)
-                   For direct draw: batchStartIndex = dc.objectIndex (SSBO offset) */
-                uint32_t batchStartIndex = bUseIndirectDraw ? 0 : dc.objectIndex;
-                std::memcpy(vpPushData + static_cast<size_t>(80), &batchStartIndex, static_cast<size_t>(4));
-                
-                /* useIndirection = 1 for GPU indirect draw, 0 for direct indexing */
-                uint32_t useIndirection = bUseIndirectDraw ? 1 : 0;
-                std::memcpy(vpPushData + static_cast<size_t>(84), &useIndirection, static_cast<size_t>(4));
-                std::memset(vpPushData + static_cast<size_t>(88), static_cast<int>(0), static_cast<size_t>(8));
-                
-                vkCmdPushConstants(cmd, dc.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                    static_cast<uint32_t>(0), kInstancedPushConstantSize, vpPushData);
-            } else if (dc.pushConstantSize == 128u && dc.pLocalTransform != nullptr) {
-                /* Time-demo (and similar) per-object push: viewProj (64) + model (64) */
-                alignas(16) uint8_t timeDemoPush[128];
-                std::memcpy(timeDemoPush, vpViewProj, static_cast<size_t>(64));
-                std::memcpy(timeDemoPush + 64, dc.pLocalTransform, static_cast<size_t>(64));
-                vkCmdPushConstants(cmd, dc.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                    0, 128, timeDemoPush);
-            } else if ((dc.pushConstantSize > static_cast<uint32_t>(0)) && (dc.pPushConstants != nullptr)) {
-                vkCmdPushConstants(cmd, dc.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                    static_cast<uint32_t>(0), dc.pushConstantSize, dc.pPushConstants);
-            }
-            
-            VkDeviceSize offset = dc.vertexBufferOffset;
-            vkCmdBindVertexBuffers(cmd, static_cast<uint32_t>(0), static_cast<uint32_t>(1), &dc.vertexBuffer, &offset);
-            
-            if (bUseIndirectDraw) {
-                /* GPU indirect draw: instanceCount written by compute shader */
-                VkDeviceSize indirectOffset = static_cast<VkDeviceSize>(batchIndex) * sizeof(VkDrawIndirectCommand);
-                vkCmdDrawIndirect(cmd, this->m_gpuCuller.GetIndirectBuffer(), indirectOffset, 1, sizeof(VkDrawIndirectCommand));
-                ++batchIndex;
-            } else {
-                /* Direct draw: CPU-specified instanceCount */
-                vkCmdDraw(cmd, dc.vertexCount, dc.instanceCount, dc.firstVertex, dc.firstInstance);
+                view.vecPipelines.push_back(pipelineToUse);
+                if (bDynamicState == true)
+                    view.vecRasterStates.push_back(stRaster);
             }
         }
-        
-        /* Render light debug visualizations (inside the viewport render pass, per-viewport toggle) */
-        const bool bVpLightDebug = vp.config.bShowLightDebug && this->m_lightDebugRenderer.IsReady();
-        if ((bVpLightDebug == true) && (pScene_ic != nullptr)) {
-            this->m_lightDebugRenderer.Draw(cmd, pScene_ic, vpViewProj);
+    }
+    this->m_vecViewRecords.resize(zViews);
+
+    RecordSceneSecondaries(vecDrawCalls_ic, lFrameIndex_ic);
+
+    /* Light debug visualizations (per-viewport toggle): main thread, after the scene draws of the viewport */
+    const auto tStart = std::chrono::steady_clock::now();
+    for (SceneViewRecord& view : this->m_vecViewRecords) {
+        if (view.bLightDebug == false) {
+            continue;
         }
-        
-        /* End viewport render pass */
-        this->m_viewportManager.EndViewportRender(vp.config.id, cmd);
+        VkCommandBuffer cmd = BeginMainThreadSecondary(view, lFrameIndex_ic);
+        this->m_lightDebugRenderer.Draw(cmd, pScene_ic, view.viewProj);
+        this->m_commandBuffers.EndSecondary(cmd);
+        view.vecSecondaries.push_back(cmd);
+    }
+    this->m_vecRecordThreadMs.back() += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+}
+
+void VulkanApp::ExecuteViewports(VkCommandBuffer cmd) {
+    for (const SceneViewRecord& view : this->m_vecViewRecords) {
+        this->m_viewportManager.BeginViewportRender(view.viewportId, cmd, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        if (view.vecSecondaries.empty() == false) {
+            vkCmdExecuteCommands(cmd, static_cast<uint32_t>(view.vecSecondaries.size()), view.vecSecondaries.data());
+        }
+        this->m_viewportManager.EndViewportRender(view.viewportId, cmd);
     }
-    
-    (void)pViewProj_ic; /* May be used for future features */
 }
 #endif
 
@@ -1998,6 +2191,7 @@ void VulkanApp::Cleanup() {
     VkResult r = vkDeviceWaitIdle(this->m_device.GetDevice());
     if (r != VK_SUCCESS)
         VulkanUtils::LogErr("vkDeviceWaitIdle before cleanup failed: {}", static_cast<int>(r));
+    this->m_releaseQueue.Flush();
 
 #if EDITOR_BUILD
     this->m_editorLayer.Shutdown();
@@ -2015,19 +2209,12 @@ void VulkanApp::Cleanup() {
     /* Drop scene refs so MeshHandles are only owned by MeshManager; then clear cache to destroy buffers. */
     this->m_sceneManager.UnloadScene();
     this->m_meshManager.Destroy();
+    /* Bindless table holds texture references: drop them before the texture manager destroys its cache. */
+    this->m_bindlessTextures.Destroy();
     this->m_textureManager.Destroy();
     this->m_pipelineDescriptorSets.clear();
     this->m_pDefaultTexture.reset();
     
-    // Free all texture descriptor sets
-    for (auto& pair : m_textureDescriptorSets) {
-        if (pair.second != VK_NULL_HANDLE && m_descriptorPoolManager.IsValid()) {
-            m_descriptorPoolManager.FreeSet(pair.second);
-        }
-    }
-    m_textureDescriptorSets.clear();
-    m_descriptorSetTextures.clear();
-    
     if (this->m_descriptorSetMain != VK_NULL_HANDLE && this->m_descriptorPoolManager.IsValid()) {
         this->m_descriptorPoolManager.FreeSet(this->m_descriptorSetMain);
         this->m_descriptorSetMain = VK_NULL_HANDLE;
@@ -2042,6 +2229,8 @@ void VulkanApp::Cleanup() {
     
     /* Clean up GPU culler. */
     this->m_gpuCuller.Destroy();
+    this->m_meshletCuller.Destroy();
+    this->m_meshletCullerEnabled = false;
     
     /* Clean up light manager (owns the light SSBO). */
     this->m_lightManager.Destroy();
@@ -2056,6 +2245,10 @@ void VulkanApp::Cleanup() {
     this->m_descriptorPoolManager.Destroy();
     this->m_descriptorSetLayoutManager.Destroy();
     this->m_shaderManager.Destroy();
+    this->m_pipelineCache.Save();
+    this->m_pipelineCache.Destroy();
+    VulkanMemory::SetAllocator(nullptr, this->m_device.GetLimits().nonCoherentAtomSize);
+    this->m_memoryAllocator.Destroy();
     this->m_device.Destroy();
     if ((this->m_pWindow != nullptr) && (this->m_instance.IsValid() == true))
         this->m_pWindow->DestroySurface(this->m_instance.Get());
@@ -2090,9 +2283,10 @@ bool VulkanApp::DrawFrame(const std::vector<DrawCall>& vecDrawCalls_ic, const fl
         VulkanUtils::LogErr("vkWaitForFences failed: {}", static_cast<int>(r));
         return false;
     }
-    /* Safe to destroy pipelines and mesh buffers that were trimmed (all in-flight work finished). */
-    this->m_pipelineManager.ProcessPendingDestroys();
-    this->m_meshManager.ProcessPendingDestroys();
+    /* Every frame before this one has completed (all fences waited): run their deferred releases. */
+    this->m_releaseQueue.Collect(this->m_uFrameSerial - 1u);
+    /* ...and this frame slot's secondary command buffers can be re-recorded. */
+    this->m_commandBuffers.ResetSecondaryPools(lFrameIndex);
 
     /* GPU culler stats: readback visible count and update stats struct.
        Readback every frame (GPU work already finished, no stall). */
@@ -2102,6 +2296,8 @@ bool VulkanApp::DrawFrame(const std::vector<DrawCall>& vecDrawCalls_ic, const fl
         this->m_gpuCullStats.totalObjectCount = static_cast<uint32_t>(this->m_cullObjectsCache.size());
         this->m_gpuCullStats.mismatchDetected = (this->m_gpuCullStats.gpuVisibleCount != this->m_gpuCullStats.cpuVisibleCount);
         this->m_gpuCullStats.framesSinceLastReadback = 0;
+        if ((this->m_meshletCullerEnabled == true) && (this->m_meshletCuller.IsValid() == true))
+            this->m_meshletVisibleCount = this->m_meshletCuller.ReadbackVisibleCount();
         
         // Log mismatch periodically (every 60 frames) to avoid spam
         static uint32_t s_logCounter = 0;
@@ -2164,35 +2360,34 @@ bool VulkanApp::DrawFrame(const std::vector<DrawCall>& vecDrawCalls_ic, const fl
     vecClearValues[1].depthStencil = { .depth = static_cast<float>(1.0f), .stencil = static_cast<uint32_t>(0) };
     const uint32_t lClearValueCount = (this->m_renderPass.HasDepthAttachment() == true) ? static_cast<uint32_t>(2u) : static_cast<uint32_t>(1u);
 
-    /* Build post-scene callback for ImGui rendering only (inside swapchain render pass). */
-    std::function<void(VkCommandBuffer)> postSceneCallback = nullptr;
-#if EDITOR_BUILD
-    postSceneCallback = std::bind(&VulkanApp::RenderEditorUI, this, std::placeholders::_1);
-#else
-    postSceneCallback = std::bind(&VulkanApp::RenderRuntimeUI, this, std::placeholders::_1);
-#endif
+    /* Scene draws go to secondary command buffers recorded in parallel (RecordSceneSecondaries); the primary
+       runs the culler dispatches and executes the secondaries in order inside each render pass. */
+    this->m_vecRecordThreadMs.assign(std::max(this->m_commandBuffers.GetSecondarySlotCount(), 1u), 0.f);
+    this->m_lRecordedSecondaries = 0;
 
 #if EDITOR_BUILD
-    /* Pre-scene callback for viewport rendering (all viewports render to offscreen targets).
+    /* Editor mode: Scene renders to offscreen viewports (one render pass each, executed before the main pass).
        Light debug is controlled per-viewport via bShowLightDebug. */
     Scene* pScene = this->m_sceneManager.GetCurrentScene();
-
-    auto viewportCallback = std::bind(
-        &VulkanApp::RenderViewports, this, std::placeholders::_1,
-        &vecDrawCalls_ic, pViewProjMat16_ic, pScene);
+    RecordViewports(vecDrawCalls_ic, pScene, lFrameIndex);
     
     /* GPU culler dispatch happens before any render passes */
-    std::function<void(VkCommandBuffer)> preSceneCallback = [this, viewportCallback](VkCommandBuffer cmd) {
+    std::function<void(VkCommandBuffer)> preSceneCallback = [this](VkCommandBuffer cmd) {
         if (this->m_gpuCullerEnabled && this->m_gpuCuller.IsValid()) {
             this->m_gpuCuller.ResetCounters(cmd);
             this->m_gpuCuller.Dispatch(cmd);
             this->m_gpuCuller.BarrierAfterDispatch(cmd);
         }
-        viewportCallback(cmd);
+        if (this->m_meshletCullerEnabled && this->m_meshletCuller.IsValid()) {
+            this->m_meshletCuller.ResetCounters(cmd);
+            this->m_meshletCuller.Dispatch(cmd);
+            this->m_meshletCuller.BarrierAfterDispatch(cmd);
+        }
+        ExecuteViewports(cmd);
     };
     
-    /* Editor mode: Scene renders to offscreen viewports via preSceneCallback.
-       Main render pass only renders ImGui which displays the viewport textures. */
+    /* Main render pass only renders ImGui (inline) which displays the viewport textures. */
+    std::function<void(VkCommandBuffer)> postSceneCallback = [this](VkCommandBuffer cmd) { RenderEditorUI(cmd); };
     std::vector<DrawCall> emptyDrawCalls;
 
     this->m_commandBuffers.Record(lImageIndex, this->m_renderPass.Get(),
@@ -2201,14 +2396,19 @@ bool VulkanApp::DrawFrame(const std::vector<DrawCall>& vecDrawCalls_ic, const fl
                             vecClearValues.data(), lClearValueCount, preSceneCallback, postSceneCallback);
 #else
     /* Release/Runtime mode: Render scene directly to swapchain render pass.
-       No viewport system - render directly to screen. */
+       No viewport system - one view with the main camera. */
+    this->m_vecViewRecords.resize(1u);
+    SceneViewRecord& view = this->m_vecViewRecords[0];
+    view.vecSecondaries.clear();
+    view.renderPass = this->m_renderPass.Get();
+    view.framebuffer = this->m_framebuffers.Get()[lImageIndex];
+    view.viewport = stViewport;
+    view.scissor = stScissor;
     
     /* Get camera matrices for main camera */
     alignas(16) float rtViewMat[16];
     this->m_camera.GetViewMatrix(rtViewMat);
-    
-    float rtCamPos[3];
-    this->m_camera.GetPosition(rtCamPos[0], rtCamPos[1], rtCamPos[2]);
+    this->m_camera.GetPosition(view.camPos[0], view.camPos[1], view.camPos[2]);
     
     /* Compute projection matrix for swapchain aspect ratio */
     const float rtAspect = (stExtent.height > static_cast<uint32_t>(0)) 
@@ -2227,50 +2427,17 @@ bool VulkanApp::DrawFrame(const std::vector<DrawCall>& vecDrawCalls_ic, const fl
     }
     
     // Combine projection and view for Runtime rendering
-    alignas(16) float rtViewProj[16];
-    ObjectMat4Multiply(rtViewProj, rtProjMat, rtViewMat);
+    ObjectMat4Multiply(view.viewProj, rtProjMat, rtViewMat);
     
-    // Resize push constant buffer to fit all draw calls
-    this->m_runtimePushConstantBuffer.resize(vecDrawCalls_ic.size());
+    RecordSceneSecondaries(vecDrawCalls_ic, lFrameIndex);
     
-    // Check if GPU indirect draw is enabled
-    const bool bRuntimeUseIndirectDraw = this->m_gpuIndirectDrawEnabled && this->m_gpuCullerEnabled;
-    
-    // Build push constant data for each draw call using main camera's viewProj
-    // Mutable copy of draw calls so we can set pPushConstants
-    std::vector<DrawCall> runtimeDrawCalls = vecDrawCalls_ic;
-    for (size_t i = 0; i < runtimeDrawCalls.size(); ++i) {
-        auto& dc = runtimeDrawCalls[i];
-        auto& pcData = this->m_runtimePushConstantBuffer[i];
-        
-        // Instanced layout: viewProj (64) + camPos (16) + batchStartIndex (4) + useIndirection (4) + padding (8) = 96 bytes
-        std::memcpy(pcData.data(), rtViewProj, 64);  // viewProj at offset 0
-        std::memcpy(pcData.data() + 64, rtCamPos, 12);  // camPos xyz at offset 64
-        float camW = 1.0f;
-        std::memcpy(pcData.data() + 76, &camW, 4);  // camPos.w at offset 76
-        
-        // For indirect draw: batchStartIndex = 0 (offset is in firstInstance)
-        // For direct draw: batchStartIndex = dc.objectIndex (SSBO offset)
-        uint32_t batchStartIndex = bRuntimeUseIndirectDraw ? 0 : dc.objectIndex;
-        std::memcpy(pcData.data() + 80, &batchStartIndex, 4);  // batchStartIndex at offset 80
-        
-        uint32_t useIndirection = bRuntimeUseIndirectDraw ? 1 : 0;
-        std::memcpy(pcData.data() + 84, &useIndirection, 4);  // useIndirection at offset 84
-        std::memset(pcData.data() + 88, 0, 8);  // Padding at offset 88
-        
-        dc.pPushConstants = pcData.data();
-        dc.pushConstantSize = kInstancedPushConstantSize;
-        
-        /* Set indirect draw buffer for GPU-driven rendering */
-        if (bRuntimeUseIndirectDraw) {
-            dc.indirectBuffer = this->m_gpuCuller.GetIndirectBuffer();
-            dc.indirectOffset = static_cast<VkDeviceSize>(i) * sizeof(VkDrawIndirectCommand);
-        }
-        
-        /* Set dynamic offset for object data SSBO binding. */
-        dc.dynamicOffsets.clear();
-        dc.dynamicOffsets.push_back(this->m_currentFrameObjectDataOffset);
-    }
+    /* UI on top of the scene: ImGui draw data is main-thread state, so its secondary is recorded here */
+    const auto tUiStart = std::chrono::steady_clock::now();
+    VkCommandBuffer pUiCmd = BeginMainThreadSecondary(view, lFrameIndex);
+    RenderRuntimeUI(pUiCmd);
+    this->m_commandBuffers.EndSecondary(pUiCmd);
+    view.vecSecondaries.push_back(pUiCmd);
+    this->m_vecRecordThreadMs.back() += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tUiStart).count();
     
     /* Runtime: GPU culler dispatch before render pass */
     std::function<void(VkCommandBuffer)> preSceneCallback = [this](VkCommandBuffer cmd) {
@@ -2279,13 +2446,18 @@ bool VulkanApp::DrawFrame(const std::vector<DrawCall>& vecDrawCalls_ic, const fl
             this->m_gpuCuller.Dispatch(cmd);
             this->m_gpuCuller.BarrierAfterDispatch(cmd);
         }
+        if (this->m_meshletCullerEnabled && this->m_meshletCuller.IsValid()) {
+            this->m_meshletCuller.ResetCounters(cmd);
+            this->m_meshletCuller.Dispatch(cmd);
+            this->m_meshletCuller.BarrierAfterDispatch(cmd);
+        }
     };
     
-    /* Runtime: Pass actual draw calls to render scene directly to swapchain */
-    this->m_commandBuffers.Record(lImageIndex, this->m_renderPass.Get(),
+    /* Runtime: execute the scene and UI secondaries in the swapchain render pass */
+    this->m_commandBuffers.RecordSecondaries(lImageIndex, this->m_renderPass.Get(),
                             this->m_framebuffers.Get()[lImageIndex],
-                            stRenderArea, stViewport, stScissor, runtimeDrawCalls,
-                            vecClearValues.data(), lClearValueCount, preSceneCallback, postSceneCallback);
+                            stRenderArea, view.vecSecondaries,
+                            vecClearValues.data(), lClearValueCount, preSceneCallback);
 #endif
 
     VkCommandBuffer pCmd = this->m_commandBuffers.Get(lImageIndex);
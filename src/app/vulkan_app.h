@@ -1,14 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <glm/glm.hpp>
 #include "camera.h"
+#include "core/frame_arena.h"
 #include "core/frame_context.h"
 #include "core/light_component.h"
 #include "core/light_manager.h"
 #include "core/light_debug_renderer.h"
 #include "render/gpu_buffer.h"
 #include "render/descriptor_cache.h"
+#include "managers/deferred_release_queue.h"
 #include "managers/descriptor_pool_manager.h"
 #include "managers/descriptor_set_layout_manager.h"
 #include "managers/material_manager.h"
@@ -18,25 +21,30 @@
 #include "managers/scene_manager.h"
 #include "managers/texture_manager.h"
 #include "render/batched_draw_list.h"
+#include "render/bindless_texture_table.h"
 #include "render/tiered_instance_manager.h"
 #include "render/gpu_culler.h"
+#include "render/meshlet_culler.h"
 #include "render/viewport_manager.h"
+#include "thread/frame_graph.h"
 #include "thread/job_queue.h"
-#include "thread/resource_manager_thread.h"
 #include "vulkan_config.h"
 #include "vulkan_command_buffers.h"
 #include "vulkan_depth_image.h"
 #include "vulkan_device.h"
 #include "vulkan_framebuffers.h"
 #include "vulkan_instance.h"
+#include "vulkan_memory.h"
+#include "vulkan_pipeline_cache.h"
 #include "vulkan_render_pass.h"
 #include "vulkan_swapchain.h"
 #include "vulkan_sync.h"
 #include "window/window.h"
 #include <chrono>
 #include <map>
-#include <tuple>
+#include <unordered_map>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -64,8 +72,8 @@ struct ObjectData {
     glm::vec4 emissive;           // 16 bytes - RGB + strength (offset 64)
     glm::vec4 matProps;           // 16 bytes - x=metallic, y=roughness, z=normalScale, w=occlusionStrength (offset 80)
     glm::vec4 baseColor;          // 16 bytes - RGBA color (offset 96)
-    glm::vec4 reserved0;          // 16 bytes - reserved for future (lighting) (offset 112)
-    glm::vec4 reserved1;          // 16 bytes - reserved for future (animation) (offset 128)
+    glm::uvec4 texIndices;        // 16 bytes - bindless slots: x=baseColor, y=metallicRoughness, z=emissive, w=normal (offset 112)
+    glm::uvec4 texIndices2;       // 16 bytes - bindless slots: x=occlusion, yzw unused (offset 128)
     glm::vec4 reserved2;          // 16 bytes - reserved for future (physics) (offset 144)
     glm::vec4 reserved3;          // 16 bytes - reserved for future (particles) (offset 160)
     glm::vec4 reserved4;          // 16 bytes - reserved for future (phase 3B) (offset 176)
@@ -81,11 +89,13 @@ constexpr size_t kObjDataOffset_Model     = 0;
 constexpr size_t kObjDataOffset_Emissive  = 64;
 constexpr size_t kObjDataOffset_MatProps  = 80;
 constexpr size_t kObjDataOffset_BaseColor = 96;
+constexpr size_t kObjDataOffset_TexIndices = 112;
 static_assert(sizeof(ObjectData) == 256, "ObjectData must be 256 bytes");
 static_assert(offsetof(ObjectData, model) == kObjDataOffset_Model, "model must be at offset 0");
 static_assert(offsetof(ObjectData, emissive) == kObjDataOffset_Emissive, "emissive must be at offset 64");
 static_assert(offsetof(ObjectData, matProps) == kObjDataOffset_MatProps, "matProps must be at offset 80");
 static_assert(offsetof(ObjectData, baseColor) == kObjDataOffset_BaseColor, "baseColor must be at offset 96");
+static_assert(offsetof(ObjectData, texIndices) == kObjDataOffset_TexIndices, "texIndices must be at offset 112");
 
 class VulkanApp {
 public:
@@ -106,41 +116,99 @@ private:
      */
     bool DrawFrame(const std::vector<DrawCall>& vecDrawCalls_ic, const float* pViewProjMat16_ic);
     void RecreateSwapchainAndDependents();
-    /** Write default texture into the main descriptor set when ready; then add main/wire to m_pipelineDescriptorSets. Idempotent. */
+    /** Write the main descriptor set and the default bindless slot when ready; then fill m_pipelineDescriptorSets. Idempotent. */
     void EnsureMainDescriptorSetWritten();
-    
-    /** Get or create a descriptor set for a single texture. Returns VK_NULL_HANDLE on failure. Caches result. */
-    VkDescriptorSet GetOrCreateDescriptorSetForTexture(std::shared_ptr<TextureHandle> pTexture);
-    
-    /** Get or create a descriptor set for the given textures. Returns VK_NULL_HANDLE on failure. Caches result. */
-    VkDescriptorSet GetOrCreateDescriptorSetForTextures(std::shared_ptr<TextureHandle> pBaseColorTexture,
-                                                        std::shared_ptr<TextureHandle> pMetallicRoughnessTexture,
-                                                        std::shared_ptr<TextureHandle> pEmissiveTexture,
-                                                        std::shared_ptr<TextureHandle> pNormalTexture,
-                                                        std::shared_ptr<TextureHandle> pOcclusionTexture);
-    
-    /** Clean up descriptor sets for textures that are no longer referenced by any objects. Call after scene changes. */
-    void CleanupUnusedTextureDescriptorSets();
+    /** After a batch rebuild (or while a texture waits for a slot): give every texture of the render list a bindless
+     *  slot and release slots no object uses. */
+    void UpdateBindlessTextures();
+    /** Texture streaming: report the projected size of every visible object's textures (after UpdateVisibility). */
+    void RequestTextureResidency(const float* pCamPos_ic, float fPixelsPerUnit_ic, bool bPerspective_ic);
+    /** Streamed textures whose image was replaced move to fresh bindless slots (the old slots are still in flight). */
+    void RebindStreamedTextures(const std::vector<TextureHandle*>& vecChanged_ic);
+    /** Fill meshlet culler inputs for batches whose mesh has enough meshlets (same batch ids as GPUCuller). */
+    void PrepareMeshletCulling(const float fFrustumPlanes_ic[6][4], const float* pCamPos_ic, bool bSceneRebuilt_ic);
+    /** If batch lBatchId_ic is meshlet-culled, return its draw command / draw count offsets in the meshlet culler buffers. */
+    bool GetMeshletDrawRange(uint32_t lBatchId_ic, VkDeviceSize& uDrawOffset_out, VkDeviceSize& uCountOffset_out,
+                             uint32_t& lMaxDraws_out) const;
     void OnCompletedLoadJob(LoadJobType eType_ic, const std::string& sPath_ic, std::vector<uint8_t> vecData_in);
+    /** Load a level JSON: progressive (placeholders, resolved per frame) if config assets.async_level_load, else blocking. */
+    bool LoadLevel(const std::string& sPath_ic);
+    /** Level-load stage (per frame): start worker builds of the pipelines of the level's materials and their editor
+     *  wireframe variants. After a blocking load, waits for them so the level's first frame does not compile. */
+    void PrewarmLevelPipelines();
     void ApplyConfig(const VulkanConfig& stNewConfig_ic);
     
     /* Callback functions (extracted from lambdas per coding guidelines). */
     void OnSceneChanged();
-    void OnTrimAllCaches();
     bool OnEditorEvent(const SDL_Event& evt_ic);
     bool OnRuntimeEvent(const SDL_Event& evt_ic);
+    /* CPU frame graph: stages of the per-frame render prep, declared with the resources they touch. */
+    void BuildFrameGraph();
+    void StageTransforms();
+    void StageLights();
+    void StageDescriptorSets();
+    void StageRebuildBatches();
+    void StageObjectData();
+    void StageVisibility();
+    void StageTextureResidency();
+    void StageGpuCulling();
+    void StageDrawCalls();
     void RenderEditorUI(VkCommandBuffer cmd);
     void RenderRuntimeUI(VkCommandBuffer cmd);
+    /* Parallel command recording: scene draws of every view go to secondary command buffers (see m_vecViewRecords). */
+    struct SceneViewRecord;
+    /** Record draws [lBegin_ic, lEnd_ic) of one view into cmd. Worker-safe: reads only state fixed for the frame. */
+    void RecordDrawRange(VkCommandBuffer cmd, const SceneViewRecord& view_ic, const std::vector<DrawCall>& vecDrawCalls_ic,
+                         uint32_t lBegin_ic, uint32_t lEnd_ic) const;
+    /** Split every view's draws into ranges, record them in parallel on the scheduler; fills each view's vecSecondaries in order. */
+    void RecordSceneSecondaries(const std::vector<DrawCall>& vecDrawCalls_ic, uint32_t lFrameIndex_ic);
+    /** Main thread: begin a secondary of the main thread's pool inside view_ic's render pass (viewport and scissor set). */
+    VkCommandBuffer BeginMainThreadSecondary(const SceneViewRecord& view_ic, uint32_t lFrameIndex_ic);
 #if EDITOR_BUILD
-    void RenderViewports(VkCommandBuffer cmd, const std::vector<DrawCall>* pDrawCalls_ic, const float* pViewProj_ic,
-                         Scene* pScene_ic);
+    /** Fill m_vecViewRecords from the visible viewports (cameras, wireframe pipelines), then record their secondaries. */
+    void RecordViewports(const std::vector<DrawCall>& vecDrawCalls_ic, Scene* pScene_ic, uint32_t lFrameIndex_ic);
+    /** Primary: one render pass per recorded viewport, executing its secondaries. */
+    void ExecuteViewports(VkCommandBuffer cmd);
 #endif
 
     /* ======== Threading & Job Queue ======== */
     JobQueue::CompletedJobHandler m_completedJobHandler;
     JobQueue m_jobQueue;
-    ResourceManagerThread m_resourceManagerThread;
+    /** Per-frame render prep run on m_jobQueue's scheduler (BuildFrameGraph); resource ids in m_frameRes. */
+    FrameGraph m_frameGraph;
+    struct FrameResources {
+        FrameResourceId sceneTransforms  = 0u;
+        FrameResourceId renderObjects    = 0u;
+        FrameResourceId visibility       = 0u;
+        FrameResourceId descriptorSets   = 0u;
+        FrameResourceId bindlessTextures = 0u;
+        FrameResourceId lightBuffer      = 0u;
+        FrameResourceId objectData       = 0u;
+        FrameResourceId cullInputs       = 0u;
+        FrameResourceId textureStreaming = 0u;
+        FrameResourceId drawCalls        = 0u;
+    } m_frameRes;
+    /** Inputs of this frame's graph stages (set by MainLoop before Execute) and what the batch stage decided. */
+    struct FramePrep {
+        Scene*       pScene = nullptr;
+        alignas(16) float fViewProj[16] = {};
+        float        fCamPos[3] = {};
+        uint32_t     lDrawHeight = 0u;
+        VkRenderPass renderPassForBatching = VK_NULL_HANDLE;
+        bool         bBatchHasDepth = false;
+        bool         bSceneRebuilt = false;
+        bool         bObjectDataRebuilt = false;
+#if EDITOR_BUILD
+        std::span<const uint32_t> movedIds;  // Sorted, in the frame arena
+#endif
+    } m_framePrep;
     ResourceCleanupManager m_resourceCleanupManager;
+    /** Trimmed / replaced GPU objects, destroyed in DrawFrame once the frames that may use them have completed. */
+    DeferredReleaseQueue m_releaseQueue;
+    /** Per-frame transient CPU data (one arena per frame in flight, reset in MainLoop at frame start). */
+    FrameArenas m_frameArenas;
+    /** Heap allocations (operator new) during the last complete frame; see AllocCounter. */
+    uint64_t m_uLastFrameAllocations = 0u;
 
     /* ======== Configuration ======== */
     VulkanConfig m_config;
@@ -149,6 +217,11 @@ private:
     std::unique_ptr<Window> m_pWindow;
     VulkanInstance m_instance;
     VulkanDevice m_device;
+    /* Device memory for buffers, meshes, textures and render targets (installed for VulkanMemory helpers). */
+    VulkanMemoryBackend m_memoryBackend;
+    DeviceMemoryAllocator m_memoryAllocator;
+    /* Shared by all pipeline creation; loaded at startup, saved at shutdown. */
+    VulkanPipelineCache m_pipelineCache;
     VulkanSwapchain m_swapchain;
     VulkanRenderPass m_renderPass;
     VulkanDepthImage m_depthImage;
@@ -174,17 +247,20 @@ private:
     /** Per-frame descriptor cache for transient allocations (reset each frame). */
     DescriptorCache           m_descriptorCache;
     std::map<std::string, std::vector<VkDescriptorSet>> m_pipelineDescriptorSets;
-    VkDescriptorSet           m_descriptorSetMain = VK_NULL_HANDLE;  /* single set for textured pipelines (default texture) */
+    VkDescriptorSet           m_descriptorSetMain = VK_NULL_HANDLE;  /* set 0 of every main pipeline (UBO, object/light SSBOs, visible indices) */
+    /** Set 1 of the textured/untextured pipelines: every scene texture, indexed per object (ObjectData::texIndices). */
+    BindlessTextureTable      m_bindlessTextures;
     /** Keep default texture alive so TrimUnused() does not destroy it. */
     std::shared_ptr<TextureHandle> m_pDefaultTexture;
     /** Keep material references alive so TrimUnused() does not destroy them. */
     std::vector<std::shared_ptr<MaterialHandle>> m_cachedMaterials;
-    /** Per-texture descriptor set cache: texture -> descriptor set. */
-    std::map<TextureHandle*, VkDescriptorSet> m_textureDescriptorSets;
-    /** Per-texture-quintuple descriptor set cache. */
-    std::map<std::tuple<TextureHandle*, TextureHandle*, TextureHandle*, TextureHandle*, TextureHandle*>, VkDescriptorSet> m_textureQuintupleDescriptorSets;
-    /** Reverse map: descriptor set -> texture (for reference counting and cleanup). */
-    std::map<VkDescriptorSet, std::shared_ptr<TextureHandle>> m_descriptorSetTextures;
+    /** Streamed textures whose image changed this frame (TextureManager::UpdateStreaming output, reused). */
+    std::vector<TextureHandle*> m_vecStreamedTextures;
+    /** Bindless slots moved outside a batch rebuild: ObjectData must be re-uploaded for every frame in flight. */
+    bool m_bTextureIndicesChanged = false;
+    /** Some texture in use has no bindless slot (table full): retry registration every frame. */
+    bool m_bBindlessSlotsPending = false;
+    uint64_t m_uFrameSerial = 0u;
 
     /* ======== GPU Buffers (SSBO for lights, UBO global) ======== */
     /** Light data SSBO buffer (16 byte header + 256 lights × 64 bytes = ~16KB). */
@@ -212,10 +288,23 @@ private:
     std::vector<CullObjectData> m_cullObjectsCache;
     /** Whether GPU culler is enabled and ready. */
     bool m_gpuCullerEnabled = false;
+    /** Over-capacity warning already logged; StageGpuCulling runs on a frame graph worker, so atomic. */
+    std::atomic<bool> m_bWarnedCullCapacity{false};
     /** Whether to use GPU indirect draw (vkCmdDrawIndirect with GPU-written instanceCount). */
     bool m_gpuIndirectDrawEnabled = false;
     /** Placeholder visible indices SSBO for binding 8 (before indirect draw is active). */
     GPUBuffer m_placeholderVisibleIndicesSSBO;
+
+    /** Meshlet (cluster) culling for high-poly meshes; draws via vkCmdDrawIndirectCount. */
+    MeshletCuller m_meshletCuller;
+    bool m_meshletCullerEnabled = false;
+    /** Meshlet table uploaded to the culler (rebuilt on scene rebuild) and each mesh's offset into it. */
+    std::vector<Meshlet> m_meshletTable;
+    std::unordered_map<const MeshHandle*, uint32_t> m_meshletTableOffsets;
+    std::vector<MeshletCullInstance> m_meshletInstancesCache;
+    /** Per batch id: output section; drawCapacity == 0 means the batch uses the per-object path. */
+    std::vector<MeshletCullBatch> m_meshletBatchesCache;
+    uint32_t m_meshletVisibleCount = 0;
     
     /** GPU culling stats (updated each frame). */
     struct GPUCullStats {
@@ -237,10 +326,36 @@ private:
     LevelSelector m_levelSelector;
 
     /* ======== Build-Specific Components ======== */
-#if !EDITOR_BUILD
-    /** Push constant storage for Runtime mode. */
-    std::vector<std::array<uint8_t, 96>> m_runtimePushConstantBuffer;
-#endif
+    /* ======== Parallel Command Recording ======== */
+    /** One scene view of the frame (editor viewport, or the swapchain in Runtime): fixed before recording starts. */
+    struct SceneViewRecord {
+        alignas(16) float viewProj[16] = {};
+        float         camPos[3]   = {};
+        VkViewport    viewport    = {};
+        VkRect2D      scissor     = {};
+        VkRenderPass  renderPass  = VK_NULL_HANDLE;
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        uint32_t      viewportId  = 0;
+        bool          bLightDebug = false;
+        /** Per draw call: pipeline to bind (wireframe variants, resolved on the main thread). Empty = DrawCall::pipeline. */
+        std::vector<VkPipeline> vecPipelines;
+        /** Per draw call, with extended dynamic state: raster state matching vecPipelines. Empty = DrawCall::rasterState. */
+        std::vector<RasterDynamicState> vecRasterStates;
+        /** Recorded this frame, in execution order. */
+        std::vector<VkCommandBuffer> vecSecondaries;
+    };
+    /** One range of one view's draws, recorded into one secondary by whichever thread runs it. */
+    struct RecordTask {
+        uint32_t        lView  = 0;
+        uint32_t        lBegin = 0;
+        uint32_t        lEnd   = 0;
+        VkCommandBuffer pCmd   = VK_NULL_HANDLE;
+    };
+    std::vector<SceneViewRecord> m_vecViewRecords;
+    std::vector<RecordTask> m_vecRecordTasks;
+    /** Recording time of the last frame per thread slot (TaskScheduler::GetThreadSlot; last = main thread). */
+    std::vector<float> m_vecRecordThreadMs;
+    uint32_t m_lRecordedSecondaries = 0;
 
 #if EDITOR_BUILD
     EditorLayer m_editorLayer;
@@ -256,4 +371,11 @@ private:
     /** Total elapsed time in seconds (for global UBO). */
     float m_totalTimeSec = 0.f;
     std::chrono::steady_clock::time_point m_lastFpsTitleUpdate;
+    /** Construction time; startup pipeline readiness is reported against it once (cold vs warm pipeline cache). */
+    std::chrono::steady_clock::time_point m_launchTime = std::chrono::steady_clock::now();
+    bool m_bPipelineStartupReported = false;
+    /** Material ids of the loading level (SceneManager::ConsumeLevelMaterialIds); the first m_zPrewarmedMaterials are prewarmed. */
+    std::vector<std::string> m_vecLevelMaterialIds;
+    size_t m_zPrewarmedMaterials = 0u;
+    bool m_bPrewarmWait = false;
 };
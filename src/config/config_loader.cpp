@@ -42,6 +42,20 @@ struct ConfigLimits {
     static constexpr uint32_t kMaxMaxObjects = 10000000;  // 10M
     static constexpr uint32_t kMinDescSets = 1;
     static constexpr uint32_t kMaxDescSets = 100000;
+    
+    // Texture streaming
+    static constexpr uint32_t kMinTextureBudgetMB = 16;
+    static constexpr uint32_t kMaxTextureBudgetMB = 65536;
+    static constexpr uint32_t kMinStreamTailSize = 1;
+    static constexpr uint32_t kMaxStreamTailSize = 16384;
+    static constexpr uint32_t kMinStreamUploads = 1;
+    static constexpr uint32_t kMaxStreamUploads = 64;
+    static constexpr uint32_t kMinTextureArraySize = 0;  // 0 = off
+    static constexpr uint32_t kMaxTextureArraySize = 1024;
+
+    // Threads
+    static constexpr uint32_t kMinWorkerThreads = 0;  // 0 = auto
+    static constexpr uint32_t kMaxWorkerThreads = 256;
 };
 
 bool ValidateAndClamp(uint32_t& value, uint32_t minVal, uint32_t maxVal, const char* fieldName) {
@@ -134,16 +148,70 @@ void ApplyJsonToConfig(const json& jRoot, VulkanConfig& stConfig) {
             stConfig.fClearColorA = static_cast<float>(jRender["clear_color_a"].get<double>());
         if ((jRender.contains("enable_gpu_culling") == true) && (jRender["enable_gpu_culling"].is_boolean() == true))
             stConfig.bEnableGPUCulling = jRender["enable_gpu_culling"].get<bool>();
+        if ((jRender.contains("enable_meshlet_culling") == true) && (jRender["enable_meshlet_culling"].is_boolean() == true))
+            stConfig.bEnableMeshletCulling = jRender["enable_meshlet_culling"].get<bool>();
     }
     if (jRoot.contains("debug") == true) {
         const json& jDebug = jRoot["debug"];
         if ((jDebug.contains("show_light_debug") == true) && (jDebug["show_light_debug"].is_boolean() == true))
             stConfig.bShowLightDebug = jDebug["show_light_debug"].get<bool>();
     }
+    if (jRoot.contains("assets") == true) {
+        const json& jAssets = jRoot["assets"];
+        if ((jAssets.contains("enable_mesh_cooking") == true) && (jAssets["enable_mesh_cooking"].is_boolean() == true))
+            stConfig.bEnableMeshCooking = jAssets["enable_mesh_cooking"].get<bool>();
+        if ((jAssets.contains("mesh_cache_dir") == true) && (jAssets["mesh_cache_dir"].is_string() == true))
+            stConfig.sMeshCacheDir = jAssets["mesh_cache_dir"].get<std::string>();
+        if ((jAssets.contains("async_level_load") == true) && (jAssets["async_level_load"].is_boolean() == true))
+            stConfig.bAsyncLevelLoad = jAssets["async_level_load"].get<bool>();
+        if ((jAssets.contains("level_load_budget_ms") == true) && (jAssets["level_load_budget_ms"].is_number() == true))
+            stConfig.fLevelLoadBudgetMs = jAssets["level_load_budget_ms"].get<float>();
+        if ((jAssets.contains("texture_mip_mode") == true) && (jAssets["texture_mip_mode"].is_string() == true))
+            stConfig.sTextureMipMode = jAssets["texture_mip_mode"].get<std::string>();
+        if ((jAssets.contains("texture_max_anisotropy") == true) && (jAssets["texture_max_anisotropy"].is_number() == true))
+            stConfig.fTextureMaxAnisotropy = static_cast<float>(jAssets["texture_max_anisotropy"].get<double>());
+        if ((jAssets.contains("texture_lod_bias") == true) && (jAssets["texture_lod_bias"].is_number() == true))
+            stConfig.fTextureLodBias = static_cast<float>(jAssets["texture_lod_bias"].get<double>());
+        if ((jAssets.contains("texture_max_lod") == true) && (jAssets["texture_max_lod"].is_number() == true))
+            stConfig.fTextureMaxLod = static_cast<float>(jAssets["texture_max_lod"].get<double>());
+        if ((jAssets.contains("texture_compression") == true) && (jAssets["texture_compression"].is_boolean() == true))
+            stConfig.bTextureCompression = jAssets["texture_compression"].get<bool>();
+        if ((jAssets.contains("enable_texture_cooking") == true) && (jAssets["enable_texture_cooking"].is_boolean() == true))
+            stConfig.bEnableTextureCooking = jAssets["enable_texture_cooking"].get<bool>();
+        if ((jAssets.contains("texture_cache_dir") == true) && (jAssets["texture_cache_dir"].is_string() == true))
+            stConfig.sTextureCacheDir = jAssets["texture_cache_dir"].get<std::string>();
+        if ((jAssets.contains("pipeline_cache_file") == true) && (jAssets["pipeline_cache_file"].is_string() == true))
+            stConfig.sPipelineCacheFile = jAssets["pipeline_cache_file"].get<std::string>();
+        if ((jAssets.contains("texture_streaming") == true) && (jAssets["texture_streaming"].is_boolean() == true))
+            stConfig.bTextureStreaming = jAssets["texture_streaming"].get<bool>();
+        if ((jAssets.contains("texture_budget_mb") == true) && (jAssets["texture_budget_mb"].is_number_unsigned() == true))
+            stConfig.lTextureBudgetMB = jAssets["texture_budget_mb"].get<uint32_t>();
+        if ((jAssets.contains("texture_stream_tail_size") == true) && (jAssets["texture_stream_tail_size"].is_number_unsigned() == true))
+            stConfig.lTextureStreamTailSize = jAssets["texture_stream_tail_size"].get<uint32_t>();
+        if ((jAssets.contains("texture_stream_uploads_per_frame") == true) && (jAssets["texture_stream_uploads_per_frame"].is_number_unsigned() == true))
+            stConfig.lTextureStreamUploadsPerFrame = jAssets["texture_stream_uploads_per_frame"].get<uint32_t>();
+        if ((jAssets.contains("texture_array_max_size") == true) && (jAssets["texture_array_max_size"].is_number_unsigned() == true))
+            stConfig.lTextureArrayMaxSize = jAssets["texture_array_max_size"].get<uint32_t>();
+    }
+    if (jRoot.contains("threads") == true) {
+        const json& jThreads = jRoot["threads"];
+        if ((jThreads.contains("worker_threads") == true) && (jThreads["worker_threads"].is_number_unsigned() == true))
+            stConfig.lWorkerThreads = jThreads["worker_threads"].get<uint32_t>();
+        if ((jThreads.contains("worker_affinity") == true) && (jThreads["worker_affinity"].is_string() == true))
+            stConfig.sWorkerAffinity = jThreads["worker_affinity"].get<std::string>();
+        if ((jThreads.contains("reserve_main_core") == true) && (jThreads["reserve_main_core"].is_boolean() == true))
+            stConfig.bReserveMainCore = jThreads["reserve_main_core"].get<bool>();
+        if ((jThreads.contains("avoid_efficiency_cores") == true) && (jThreads["avoid_efficiency_cores"].is_boolean() == true))
+            stConfig.bAvoidEfficiencyCores = jThreads["avoid_efficiency_cores"].get<bool>();
+    }
     if (jRoot.contains("gpu_resources") == true) {
         const json& jGpu = jRoot["gpu_resources"];
         if ((jGpu.contains("max_objects") == true) && (jGpu["max_objects"].is_number_unsigned() == true))
             stConfig.lMaxObjects = jGpu["max_objects"].get<uint32_t>();
+        if ((jGpu.contains("max_meshlets") == true) && (jGpu["max_meshlets"].is_number_unsigned() == true))
+            stConfig.lMaxMeshlets = jGpu["max_meshlets"].get<uint32_t>();
+        if ((jGpu.contains("max_meshlet_draws") == true) && (jGpu["max_meshlet_draws"].is_number_unsigned() == true))
+            stConfig.lMaxMeshletDraws = jGpu["max_meshlet_draws"].get<uint32_t>();
         if ((jGpu.contains("desc_cache_max_sets") == true) && (jGpu["desc_cache_max_sets"].is_number_unsigned() == true))
             stConfig.lDescCacheMaxSets = jGpu["desc_cache_max_sets"].get<uint32_t>();
         if ((jGpu.contains("desc_cache_uniform_buffers") == true) && (jGpu["desc_cache_uniform_buffers"].is_number_unsigned() == true))
@@ -195,6 +263,20 @@ bool ValidateConfig(VulkanConfig& stConfig) {
     bAllValid &= ValidateAndClampColor(stConfig.fClearColorB, "render.clear_color_b");
     bAllValid &= ValidateAndClampColor(stConfig.fClearColorA, "render.clear_color_a");
     
+    // Texture streaming validation
+    bAllValid &= ValidateAndClamp(stConfig.lTextureBudgetMB, ConfigLimits::kMinTextureBudgetMB, ConfigLimits::kMaxTextureBudgetMB, "assets.texture_budget_mb");
+    bAllValid &= ValidateAndClamp(stConfig.lTextureStreamTailSize, ConfigLimits::kMinStreamTailSize, ConfigLimits::kMaxStreamTailSize, "assets.texture_stream_tail_size");
+    bAllValid &= ValidateAndClamp(stConfig.lTextureStreamUploadsPerFrame, ConfigLimits::kMinStreamUploads, ConfigLimits::kMaxStreamUploads, "assets.texture_stream_uploads_per_frame");
+    bAllValid &= ValidateAndClamp(stConfig.lTextureArrayMaxSize, ConfigLimits::kMinTextureArraySize, ConfigLimits::kMaxTextureArraySize, "assets.texture_array_max_size");
+    
+    // Threads validation
+    bAllValid &= ValidateAndClamp(stConfig.lWorkerThreads, ConfigLimits::kMinWorkerThreads, ConfigLimits::kMaxWorkerThreads, "threads.worker_threads");
+    if ((stConfig.sWorkerAffinity != "none") && (stConfig.sWorkerAffinity != "pin") && (stConfig.sWorkerAffinity != "numa")) {
+        VulkanUtils::LogWarn("Config 'threads.worker_affinity' \"{}\" unknown (none, pin, numa), using \"none\"", stConfig.sWorkerAffinity);
+        stConfig.sWorkerAffinity = "none";
+        bAllValid = false;
+    }
+    
     // GPU resources validation
     bAllValid &= ValidateAndClamp(stConfig.lMaxObjects, ConfigLimits::kMinMaxObjects, ConfigLimits::kMaxMaxObjects, "gpu_resources.max_objects");
     bAllValid &= ValidateAndClamp(stConfig.lDescCacheMaxSets, ConfigLimits::kMinDescSets, ConfigLimits::kMaxDescSets, "gpu_resources.desc_cache_max_sets");
@@ -286,8 +368,32 @@ VulkanConfig GetDefaultConfig() {
     stCfg.fClearColorB = 0.4f;
     stCfg.fClearColorA = 1.f;
     stCfg.bEnableGPUCulling = true;
+    stCfg.bEnableMeshletCulling = true;
     stCfg.bShowLightDebug = true;
+    stCfg.bEnableMeshCooking = true;
+    stCfg.sMeshCacheDir = "cache/meshes";
+    stCfg.bAsyncLevelLoad = true;
+    stCfg.fLevelLoadBudgetMs = 4.0f;
+    stCfg.sTextureMipMode = "gpu";
+    stCfg.fTextureMaxAnisotropy = 8.0f;
+    stCfg.fTextureLodBias = 0.0f;
+    stCfg.fTextureMaxLod = 1000.0f;
+    stCfg.bTextureCompression = true;
+    stCfg.bEnableTextureCooking = true;
+    stCfg.sTextureCacheDir = "cache/textures";
+    stCfg.sPipelineCacheFile = "cache/pipeline_cache.bin";
+    stCfg.bTextureStreaming = true;
+    stCfg.lTextureBudgetMB = 512;
+    stCfg.lTextureStreamTailSize = 64;
+    stCfg.lTextureStreamUploadsPerFrame = 2;
+    stCfg.lTextureArrayMaxSize = 256;
+    stCfg.lWorkerThreads = 0;
+    stCfg.sWorkerAffinity = "none";
+    stCfg.bReserveMainCore = true;
+    stCfg.bAvoidEfficiencyCores = true;
     stCfg.lMaxObjects = 100000;  // 100k objects - uses ~400MB for GPU culling buffers
+    stCfg.lMaxMeshlets = 65536;
+    stCfg.lMaxMeshletDraws = 262144;
     stCfg.lDescCacheMaxSets = 1000;
     stCfg.lDescCacheUniformBuffers = 500;
     stCfg.lDescCacheSamplers = 500;
@@ -327,7 +433,7 @@ VulkanConfig LoadConfigFromFileOrCreate(const std::string& sUserPath_ic, const s
         stmUser.close();
         
         // Check for missing required sections (if any section is missing, we'll rewrite)
-        const char* requiredSections[] = {"window", "swapchain", "camera", "render", "debug", "gpu_resources", "editor"};
+        const char* requiredSections[] = {"window", "swapchain", "camera", "render", "debug", "assets", "threads", "gpu_resources", "editor"};
         for (const char* section : requiredSections) {
             if (!jUser.contains(section)) {
                 VulkanUtils::LogWarn("Config missing section '{}', will regenerate config file with defaults", section);
@@ -408,13 +514,41 @@ void SaveConfigToFile(const std::string& sPath_ic, const VulkanConfig& stConfig_
             { "clear_color_g", stConfig_ic.fClearColorG },
             { "clear_color_b", stConfig_ic.fClearColorB },
             { "clear_color_a", stConfig_ic.fClearColorA },
-            { "enable_gpu_culling", stConfig_ic.bEnableGPUCulling }
+            { "enable_gpu_culling", stConfig_ic.bEnableGPUCulling },
+            { "enable_meshlet_culling", stConfig_ic.bEnableMeshletCulling }
         }},
         { "debug", {
             { "show_light_debug", stConfig_ic.bShowLightDebug }
         }},
+        { "assets", {
+            { "enable_mesh_cooking", stConfig_ic.bEnableMeshCooking },
+            { "mesh_cache_dir", stConfig_ic.sMeshCacheDir },
+            { "async_level_load", stConfig_ic.bAsyncLevelLoad },
+            { "level_load_budget_ms", stConfig_ic.fLevelLoadBudgetMs },
+            { "texture_mip_mode", stConfig_ic.sTextureMipMode },
+            { "texture_max_anisotropy", stConfig_ic.fTextureMaxAnisotropy },
+            { "texture_lod_bias", stConfig_ic.fTextureLodBias },
+            { "texture_max_lod", stConfig_ic.fTextureMaxLod },
+            { "texture_compression", stConfig_ic.bTextureCompression },
+            { "enable_texture_cooking", stConfig_ic.bEnableTextureCooking },
+            { "texture_cache_dir", stConfig_ic.sTextureCacheDir },
+            { "pipeline_cache_file", stConfig_ic.sPipelineCacheFile },
+            { "texture_streaming", stConfig_ic.bTextureStreaming },
+            { "texture_budget_mb", stConfig_ic.lTextureBudgetMB },
+            { "texture_stream_tail_size", stConfig_ic.lTextureStreamTailSize },
+            { "texture_stream_uploads_per_frame", stConfig_ic.lTextureStreamUploadsPerFrame },
+            { "texture_array_max_size", stConfig_ic.lTextureArrayMaxSize }
+        }},
+        { "threads", {
+            { "worker_threads", stConfig_ic.lWorkerThreads },
+            { "worker_affinity", stConfig_ic.sWorkerAffinity },
+            { "reserve_main_core", stConfig_ic.bReserveMainCore },
+            { "avoid_efficiency_cores", stConfig_ic.bAvoidEfficiencyCores }
+        }},
         { "gpu_resources", {
             { "max_objects", stConfig_ic.lMaxObjects },
+            { "max_meshlets", stConfig_ic.lMaxMeshlets },
+            { "max_meshlet_draws", stConfig_ic.lMaxMeshletDraws },
             { "desc_cache_max_sets", stConfig_ic.lDescCacheMaxSets },
             { "desc_cache_uniform_buffers", stConfig_ic.lDescCacheUniformBuffers },
             { "desc_cache_samplers", stConfig_ic.lDescCacheSamplers },
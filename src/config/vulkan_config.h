@@ -62,6 +62,9 @@ struct VulkanConfig {
     float fClearColorA = 1.f;
     /** Enable GPU-driven frustum culling via compute shader. Runs parallel to CPU for verification. */
     bool bEnableGPUCulling = true;
+    /** Enable meshlet (cluster) culling for high-poly glTF meshes: frustum + normal cone per meshlet, drawn via vkCmdDrawIndirectCount.
+     *  Requires GPU culling and device drawIndirectCount support; otherwise those batches use per-object culling. */
+    bool bEnableMeshletCulling = true;
 
     /* --- Debug --- */
     /** Show light debug visualization (wireframe spheres/cones for lights). */
@@ -71,9 +74,63 @@ struct VulkanConfig {
     /** Path to ImGui layout ini file (docking, window positions). */
     std::string sEditorLayoutPath = "config/imgui_layout.ini";
 
+    /* --- Assets --- */
+    /** Cook glTF primitives to .vmesh (GPU-layout vertices + AABB + LODs + meshlets) and load them memory-mapped on later runs.
+     *  Files are keyed by source path + content hash; stale ones are re-cooked automatically. */
+    bool bEnableMeshCooking = true;
+    /** Directory for cooked .vmesh files (relative to the working directory, like editor.layout_file). */
+    std::string sMeshCacheDir = "cache/meshes";
+    /** Progressive level load: placeholders first, glTFs resolve as JobQueue results arrive (false = blocking load). */
+    bool bAsyncLevelLoad = true;
+    /** Main-thread time per frame spent resolving streamed instances (mesh/texture upload), in ms. */
+    float fLevelLoadBudgetMs = 4.0f;
+    /** Texture mip chains: "gpu" (vkCmdBlitImage at upload; CPU fallback if the format cannot be linearly blitted),
+     *  "cpu" (box filter on JobQueue workers) or "off" (single level). */
+    std::string sTextureMipMode = "gpu";
+    /** Sampler anisotropy (1 = off). Clamped to the device limit; ignored without samplerAnisotropy support. */
+    float fTextureMaxAnisotropy = 8.0f;
+    /** Sampler mip LOD bias (negative = sharper) and max LOD (clamped to each texture's level count). */
+    float fTextureLodBias = 0.0f;
+    float fTextureMaxLod = 1000.0f;
+    /** Cook textures to BC7 (colour) / BC5 (normal) / BC1 (metallic-roughness) / BC4 (occlusion) on the CPU at load.
+     *  Needs textureCompressionBC; otherwise (or when false) RGBA8 is uploaded. DDS/KTX2 files are used as stored. */
+    bool bTextureCompression = true;
+    /** Persistent texture cache: cooked textures (final format, all mips) keyed by source image hash + cook settings. */
+    bool bEnableTextureCooking = true;
+    /** Directory for cooked .vtex files (relative to the working directory, like mesh_cache_dir). */
+    std::string sTextureCacheDir = "cache/textures";
+    /** VkPipelineCache file, loaded at startup when it matches the device and driver and saved at shutdown.
+     *  Empty = in-memory cache only. */
+    std::string sPipelineCacheFile = "cache/pipeline_cache.bin";
+    /** Texture streaming: only the mip tail is uploaded at load; finer levels follow the on-screen size of the objects
+     *  using them, within lTextureBudgetMB (least recently used textures drop back to their tail). Forces CPU mips. */
+    bool bTextureStreaming = true;
+    /** VRAM budget for streamed textures in MB. */
+    uint32_t lTextureBudgetMB = 512;
+    /** Largest mip (in texels per side) that stays resident for every streamed texture. */
+    uint32_t lTextureStreamTailSize = 64;
+    /** Residency changes (texture re-uploads) per frame. */
+    uint32_t lTextureStreamUploadsPerFrame = 2;
+    /** Non-streamed textures up to this size (texels per side) share 2D-array images, one layer each. 0 disables. */
+    uint32_t lTextureArrayMaxSize = 256;
+
+    /* --- Threads --- */
+    /** JobQueue / TaskScheduler worker threads. 0 = one per usable logical CPU, at most 16. */
+    uint32_t lWorkerThreads = 0;
+    /** Worker placement: "none" (OS schedules), "pin" (one logical CPU per worker, physical cores first) or "numa"
+     *  (workers split across NUMA nodes, each restricted to its node's cores and stealing within the node first). */
+    std::string sWorkerAffinity = "none";
+    /** pin / numa: keep one performance core for the main (render) thread; it is pinned there and no worker uses it. */
+    bool bReserveMainCore = true;
+    /** Hybrid CPUs (P/E cores): keep workers off efficiency cores. */
+    bool bAvoidEfficiencyCores = true;
+
     /* --- GPU Resources --- */
     /** Maximum objects per frame in SSBO. Memory = lMaxObjects × 256 × lMaxFramesInFlight. */
     uint32_t lMaxObjects = 4096;
+    /** Meshlet culler: meshlet table capacity (48 B each) and emitted draw capacity (16 B each). */
+    uint32_t lMaxMeshlets = 65536;
+    uint32_t lMaxMeshletDraws = 262144;
     /** Descriptor cache: max sets per frame. */
     uint32_t lDescCacheMaxSets = 1000;
     /** Descriptor cache: uniform buffer descriptors per frame. */
@@ -0,0 +1,98 @@
+/*
+ * AllocCounter — counting replacement of the global operator new / delete (ENGINE_COUNT_ALLOCATIONS builds).
+ */
+#include "alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(ENGINE_COUNT_ALLOCATIONS) && ENGINE_COUNT_ALLOCATIONS
+
+namespace {
+
+/* Constant-initialized: valid before any static constructor allocates. */
+std::atomic<uint64_t> g_uAllocations{0u};
+
+void* CountedAlloc(std::size_t zSize_ic) {
+    g_uAllocations.fetch_add(1u, std::memory_order_relaxed);
+    return std::malloc((zSize_ic != 0u) ? zSize_ic : 1u);
+}
+
+void* CountedAlignedAlloc(std::size_t zSize_ic, std::align_val_t eAlign_ic) {
+    g_uAllocations.fetch_add(1u, std::memory_order_relaxed);
+    const std::size_t zAlign = static_cast<std::size_t>(eAlign_ic);
+    const std::size_t zSize = ((zSize_ic != 0u ? zSize_ic : 1u) + zAlign - 1u) & ~(zAlign - 1u);
+#ifdef _WIN32
+    return _aligned_malloc(zSize, zAlign);
+#else
+    return std::aligned_alloc(zAlign, zSize);
+#endif
+}
+
+void AlignedFree(void* p_in) {
+#ifdef _WIN32
+    _aligned_free(p_in);
+#else
+    std::free(p_in);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t zSize) {
+    if (void* p = CountedAlloc(zSize))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t zSize) {
+    if (void* p = CountedAlloc(zSize))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t zSize, const std::nothrow_t&) noexcept { return CountedAlloc(zSize); }
+void* operator new[](std::size_t zSize, const std::nothrow_t&) noexcept { return CountedAlloc(zSize); }
+void* operator new(std::size_t zSize, std::align_val_t eAlign) {
+    if (void* p = CountedAlignedAlloc(zSize, eAlign))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t zSize, std::align_val_t eAlign) {
+    if (void* p = CountedAlignedAlloc(zSize, eAlign))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t zSize, std::align_val_t eAlign, const std::nothrow_t&) noexcept { return CountedAlignedAlloc(zSize, eAlign); }
+void* operator new[](std::size_t zSize, std::align_val_t eAlign, const std::nothrow_t&) noexcept { return CountedAlignedAlloc(zSize, eAlign); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { AlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { AlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { AlignedFree(p); }
+
+bool AllocCounter::IsEnabled() {
+    return true;
+}
+
+uint64_t AllocCounter::GetAllocationCount() {
+    return g_uAllocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool AllocCounter::IsEnabled() {
+    return false;
+}
+
+uint64_t AllocCounter::GetAllocationCount() {
+    return 0u;
+}
+
+#endif
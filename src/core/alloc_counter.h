@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Heap allocation counter. Builds configured with ENGINE_COUNT_ALLOCATIONS (CMake option, off by default) replace
+ * the global operator new / delete with versions that count every allocation (all threads, one relaxed atomic
+ * increment each). The app samples the count around a frame to check that steady-state frames do not touch the
+ * heap. C allocations (SDL, ImGui's default allocator, the Vulkan driver) go through malloc and are not counted.
+ */
+namespace AllocCounter {
+
+/** True when the counting operator new is compiled in. */
+bool IsEnabled();
+/** operator new calls since start (0 when disabled). */
+uint64_t GetAllocationCount();
+
+} // namespace AllocCounter
@@ -0,0 +1,117 @@
+/*
+ * LinearArena / FrameArenas / thread scratch — bump allocation for per-frame transient CPU data.
+ */
+#include "frame_arena.h"
+#include <algorithm>
+
+namespace {
+
+size_t AlignUp(size_t zValue_ic, size_t zAlign_ic) {
+    return (zValue_ic + (zAlign_ic - 1u)) & ~(zAlign_ic - 1u);
+}
+
+/* Offset within pBase_ic where an allocation at or after zOffset_ic satisfies zAlign_ic. */
+size_t AlignedOffset(const std::byte* pBase_ic, size_t zOffset_ic, size_t zAlign_ic) {
+    const uintptr_t uAddress = reinterpret_cast<uintptr_t>(pBase_ic) + zOffset_ic;
+    return zOffset_ic + (AlignUp(uAddress, zAlign_ic) - uAddress);
+}
+
+} // namespace
+
+LinearArena::LinearArena(size_t zBlockSize_ic)
+    : m_zBlockSize(std::max<size_t>(zBlockSize_ic, 256u)) {
+}
+
+void* LinearArena::Allocate(size_t zBytes_ic, size_t zAlign_ic) {
+    const size_t zAlign = std::max<size_t>(zAlign_ic, 1u);
+    const size_t zBytes = std::max<size_t>(zBytes_ic, 1u);
+    if (this->m_lBlock < this->m_vecBlocks.size()) {
+        Block& stBlock = this->m_vecBlocks[this->m_lBlock];
+        const size_t zStart = AlignedOffset(stBlock.pData.get(), this->m_zOffset, zAlign);
+        if (zStart + zBytes <= stBlock.zSize) {
+            this->m_zUsed += (zStart + zBytes) - this->m_zOffset;
+            this->m_zOffset = zStart + zBytes;
+            this->m_zHighWater = std::max(this->m_zHighWater, this->m_zUsed);
+            return stBlock.pData.get() + zStart;
+        }
+    }
+    this->NextBlock(zBytes, zAlign);
+    Block& stBlock = this->m_vecBlocks[this->m_lBlock];
+    const size_t zStart = AlignedOffset(stBlock.pData.get(), 0u, zAlign);
+    this->m_zUsed += zStart + zBytes;
+    this->m_zOffset = zStart + zBytes;
+    this->m_zHighWater = std::max(this->m_zHighWater, this->m_zUsed);
+    return stBlock.pData.get() + zStart;
+}
+
+void LinearArena::NextBlock(size_t zBytes_ic, size_t zAlign_ic) {
+    const size_t zNeeded = zBytes_ic + zAlign_ic;
+    // Blocks left over from an earlier, larger frame (kept by Rewind) are reused before allocating
+    uint32_t lNext = (this->m_vecBlocks.empty() == true) ? 0u : (this->m_lBlock + 1u);
+    while ((lNext < this->m_vecBlocks.size()) && (this->m_vecBlocks[lNext].zSize < zNeeded))
+        ++lNext;
+    if (lNext >= this->m_vecBlocks.size()) {
+        // Geometric growth: a frame that keeps outgrowing the arena needs only a few blocks
+        const size_t zLast = (this->m_vecBlocks.empty() == true) ? (this->m_zBlockSize / 2u) : this->m_vecBlocks.back().zSize;
+        const size_t zSize = std::max(zLast * 2u, AlignUp(zNeeded, 256u));
+        this->m_vecBlocks.push_back({ std::make_unique<std::byte[]>(zSize), zSize });
+        lNext = static_cast<uint32_t>(this->m_vecBlocks.size() - 1u);
+        if (lNext != 0u)
+            ++this->m_uOverflows;
+    }
+    this->m_lBlock = lNext;
+    this->m_zOffset = 0u;
+}
+
+void LinearArena::Reset() {
+    if (this->m_vecBlocks.size() > 1u) {
+        // The last frame needed several blocks: replace them with one that holds the high-water mark
+        size_t zSize = 0u;
+        for (const Block& stBlock : this->m_vecBlocks)
+            zSize += stBlock.zSize;
+        zSize = AlignUp(std::max(zSize, this->m_zHighWater), 256u);
+        this->m_vecBlocks.clear();
+        this->m_vecBlocks.push_back({ std::make_unique<std::byte[]>(zSize), zSize });
+    }
+    this->m_lBlock = 0u;
+    this->m_zOffset = 0u;
+    this->m_zUsed = 0u;
+}
+
+void LinearArena::Rewind(const Marker& stMarker_ic) {
+    this->m_lBlock = stMarker_ic.lBlock;
+    this->m_zOffset = stMarker_ic.zOffset;
+    this->m_zUsed = stMarker_ic.zUsed;
+}
+
+ArenaStats LinearArena::GetStats() const {
+    ArenaStats stStats;
+    stStats.zUsed = this->m_zUsed;
+    stStats.zHighWater = this->m_zHighWater;
+    stStats.lBlocks = static_cast<uint32_t>(this->m_vecBlocks.size());
+    stStats.uOverflows = this->m_uOverflows;
+    for (const Block& stBlock : this->m_vecBlocks)
+        stStats.zCapacity += stBlock.zSize;
+    return stStats;
+}
+
+void FrameArenas::Create(uint32_t lFramesInFlight_ic, size_t zBlockSize_ic) {
+    this->m_vecArenas.clear();
+    for (uint32_t i = 0u; i < std::max(lFramesInFlight_ic, 1u); ++i)
+        this->m_vecArenas.emplace_back(zBlockSize_ic);
+    this->m_lCurrent = 0u;
+}
+
+void FrameArenas::BeginFrame(uint64_t uFrameSerial_ic) {
+    this->m_lCurrent = static_cast<uint32_t>(uFrameSerial_ic % this->m_vecArenas.size());
+    this->m_vecArenas[this->m_lCurrent].Reset();
+}
+
+ArenaStats FrameArenas::GetStats() const {
+    return this->m_vecArenas[this->m_lCurrent].GetStats();
+}
+
+LinearArena& GetThreadScratchArena() {
+    thread_local LinearArena t_scratch;
+    return t_scratch;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/** Counters of a LinearArena (see GetStats). */
+struct ArenaStats {
+    size_t   zUsed      = 0u;  // Bytes handed out since the last Reset (including alignment padding)
+    size_t   zCapacity  = 0u;  // Bytes owned (all blocks)
+    size_t   zHighWater = 0u;  // Largest zUsed seen
+    uint32_t lBlocks    = 0u;
+    uint64_t uOverflows = 0u;  // Times a new block had to be allocated (should stop after warm-up)
+};
+
+/**
+ * LinearArena — bump allocator over a list of blocks. Allocate moves a cursor; nothing is freed on its own.
+ * Reset releases everything at once; after a frame that overflowed into more blocks, Reset folds them into one
+ * block large enough for the high-water mark, so a steady workload ends up in a single block and stops touching
+ * the heap. GetMarker / Rewind release everything allocated after the marker (stack-like scratch use).
+ * Not thread-safe: one thread uses an arena at a time.
+ */
+class LinearArena {
+public:
+    static constexpr size_t kDefaultBlockSize = 64u * 1024u;
+
+    explicit LinearArena(size_t zBlockSize_ic = kDefaultBlockSize);
+    ~LinearArena() = default;
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+    LinearArena(LinearArena&&) noexcept = default;
+    LinearArena& operator=(LinearArena&&) noexcept = default;
+
+    /** zBytes_ic bytes aligned to zAlign_ic (power of two). Valid until Reset or a Rewind to an older marker. */
+    void* Allocate(size_t zBytes_ic, size_t zAlign_ic = alignof(std::max_align_t));
+    /** Uninitialized storage for zCount_ic objects of T (trivially destructible: the arena never runs destructors). */
+    template <typename T>
+    T* AllocateArray(size_t zCount_ic) {
+        static_assert(std::is_trivially_destructible_v<T>, "LinearArena: arena memory is released without destructors");
+        return static_cast<T*>(this->Allocate(zCount_ic * sizeof(T), alignof(T)));
+    }
+
+    /** Release every allocation. Folds overflow blocks into one (the only heap traffic after warm-up). */
+    void Reset();
+
+    struct Marker {
+        uint32_t lBlock  = 0u;
+        size_t   zOffset = 0u;
+        size_t   zUsed   = 0u;
+    };
+    Marker GetMarker() const { return { this->m_lBlock, this->m_zOffset, this->m_zUsed }; }
+    /** Release everything allocated after stMarker_ic (blocks are kept for reuse). */
+    void Rewind(const Marker& stMarker_ic);
+
+    ArenaStats GetStats() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> pData;
+        size_t zSize = 0u;
+    };
+
+    /* Move to the next block that can hold zBytes_ic at zAlign_ic, allocating one if none can. */
+    void NextBlock(size_t zBytes_ic, size_t zAlign_ic);
+
+    size_t m_zBlockSize = kDefaultBlockSize;
+    std::vector<Block> m_vecBlocks;
+    uint32_t m_lBlock = 0u;  // Block the cursor is in
+    size_t m_zOffset = 0u;   // Cursor within that block
+    size_t m_zUsed = 0u;
+    size_t m_zHighWater = 0u;
+    uint64_t m_uOverflows = 0u;
+};
+
+/**
+ * ArenaAllocator — STL allocator over a LinearArena. deallocate is a no-op (memory comes back with the arena's
+ * Reset / Rewind), so containers should reserve up front: every regrowth leaves the old buffer in the arena.
+ * The container must not outlive the arena's next Reset (or the Rewind of the scope it was created in).
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(LinearArena& arena_io) noexcept : m_pArena(&arena_io) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other_ic) noexcept : m_pArena(other_ic.GetArena()) {}
+
+    T* allocate(size_t zCount_ic) { return static_cast<T*>(this->m_pArena->Allocate(zCount_ic * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) noexcept {}
+
+    LinearArena* GetArena() const noexcept { return this->m_pArena; }
+
+private:
+    LinearArena* m_pArena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a_ic, const ArenaAllocator<U>& b_ic) noexcept {
+    return a_ic.GetArena() == b_ic.GetArena();
+}
+
+/** std::vector whose storage lives in a LinearArena. */
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+/**
+ * FrameArenas — one LinearArena per frame in flight for per-frame transient CPU data. BeginFrame resets the
+ * arena of the new frame: what frame N allocates stays valid until frame N + framesInFlight begins, so the next
+ * frame may still read it. Main thread only (worker stages use ScratchScope).
+ */
+class FrameArenas {
+public:
+    FrameArenas() : m_vecArenas(1u) {}
+
+    void Create(uint32_t lFramesInFlight_ic, size_t zBlockSize_ic = LinearArena::kDefaultBlockSize);
+    /** Start of frame uFrameSerial_ic: reset and select its arena. */
+    void BeginFrame(uint64_t uFrameSerial_ic);
+
+    LinearArena& Get() { return this->m_vecArenas[this->m_lCurrent]; }
+    template <typename T>
+    ArenaAllocator<T> GetAllocator() { return ArenaAllocator<T>(this->Get()); }
+    /** Counters of the current frame's arena. */
+    ArenaStats GetStats() const;
+
+private:
+    std::vector<LinearArena> m_vecArenas;
+    uint32_t m_lCurrent = 0u;
+};
+
+/** Scratch arena of the calling thread (created on first use; per worker and per main thread). */
+LinearArena& GetThreadScratchArena();
+
+/**
+ * ScratchScope — temporary allocations on the calling thread's scratch arena, released when the scope ends.
+ * Scopes nest (a callee may open its own); containers built from GetAllocator must not escape the scope.
+ */
+class ScratchScope {
+public:
+    ScratchScope() : m_arena(GetThreadScratchArena()), m_stMarker(m_arena.GetMarker()) {}
+    ~ScratchScope() { this->m_arena.Rewind(this->m_stMarker); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    LinearArena& GetArena() { return this->m_arena; }
+    template <typename T>
+    ArenaAllocator<T> GetAllocator() { return ArenaAllocator<T>(this->m_arena); }
+
+private:
+    LinearArena& m_arena;
+    LinearArena::Marker m_stMarker;
+};
@@ -40,7 +40,8 @@ static VkShaderModule CreateShaderModule(VkDevice device, const std::vector<char
 }
 
 /* ---- Create ---- */
-bool LightDebugRenderer::Create(VkDevice device, VkRenderPass renderPass, VkPhysicalDevice physicalDevice) {
+bool LightDebugRenderer::Create(VkDevice device, VkRenderPass renderPass, VkPhysicalDevice physicalDevice,
+                                VkPipelineCache pipelineCache) {
     m_device = device;
     m_physicalDevice = physicalDevice;
 
@@ -184,7 +185,7 @@ bool LightDebugRenderer::Create(VkDevice device, VkRenderPass renderPass, VkPhys
     pipelineCI.renderPass = renderPass;
     pipelineCI.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineCI, nullptr, &m_pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &m_pipeline) != VK_SUCCESS) {
         VulkanUtils::LogWarn("LightDebugRenderer: Failed to create pipeline");
         Destroy();
         return false;
@@ -203,10 +204,7 @@ void LightDebugRenderer::Destroy() {
         vkDestroyBuffer(m_device, m_vertexBuffer, nullptr);
         m_vertexBuffer = VK_NULL_HANDLE;
     }
-    if (m_vertexMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_device, m_vertexMemory, nullptr);
-        m_vertexMemory = VK_NULL_HANDLE;
-    }
+    VulkanMemory::Free(m_device, m_vertexMemory);
     if (m_pipeline != VK_NULL_HANDLE) {
         vkDestroyPipeline(m_device, m_pipeline, nullptr);
         m_pipeline = VK_NULL_HANDLE;
@@ -237,24 +235,24 @@ bool LightDebugRenderer::UpdateVertexBuffer(const std::vector<DebugLineVertex>&
     if (m_bufferCapacity < vertices.size()) {
         if (m_vertexBuffer != VK_NULL_HANDLE) {
             vkDestroyBuffer(m_device, m_vertexBuffer, nullptr);
-            vkFreeMemory(m_device, m_vertexMemory, nullptr);
+            m_vertexBuffer = VK_NULL_HANDLE;
+            VulkanMemory::Free(m_device, m_vertexMemory);
         }
 
         uint32_t newCap = static_cast<uint32_t>(vertices.size() * 2);
         if (VulkanUtils::CreateBuffer(m_device, m_physicalDevice,
                 newCap * sizeof(DebugLineVertex),
                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Buffer,
                 &m_vertexBuffer, &m_vertexMemory) != VK_SUCCESS)
             return false;
         m_bufferCapacity = newCap;
     }
 
-    /* Copy data */
-    void* pData = nullptr;
-    vkMapMemory(m_device, m_vertexMemory, 0, bufferSize, 0, &pData);
-    std::memcpy(pData, vertices.data(), bufferSize);
-    vkUnmapMemory(m_device, m_vertexMemory);
+    /* Copy data (host-visible allocations stay mapped) */
+    if (m_vertexMemory.pMapped == nullptr)
+        return false;
+    std::memcpy(m_vertexMemory.pMapped, vertices.data(), bufferSize);
 
     m_vertexCount = static_cast<uint32_t>(vertices.size());
     return true;
@@ -12,6 +12,7 @@
 
 #include "light_component.h"
 #include "light_manager.h" // For EmissiveLightData
+#include "vulkan/vulkan_memory.h"
 #include <vector>
 #include <vulkan/vulkan.h>
 #include <cstdint>
@@ -39,9 +40,11 @@ public:
      * @param device Vulkan logical device.
      * @param renderPass Render pass compatible with debug drawing.
      * @param physicalDevice For memory allocation.
+     * @param pipelineCache Pipeline cache (VK_NULL_HANDLE = none).
      * @return true on success.
      */
-    bool Create(VkDevice device, VkRenderPass renderPass, VkPhysicalDevice physicalDevice);
+    bool Create(VkDevice device, VkRenderPass renderPass, VkPhysicalDevice physicalDevice,
+                VkPipelineCache pipelineCache = VK_NULL_HANDLE);
 
     /**
      * Cleanup all Vulkan resources.
@@ -94,7 +97,7 @@ private:
 
     /* Dynamic vertex buffer */
     VkBuffer            m_vertexBuffer      = VK_NULL_HANDLE;
-    VkDeviceMemory      m_vertexMemory      = VK_NULL_HANDLE;
+    MemoryAllocation    m_vertexMemory;
     uint32_t            m_vertexCount       = 0;
     uint32_t            m_bufferCapacity    = 0;
 
@@ -19,12 +19,12 @@ void LightManager::Create(VkDevice device, VkPhysicalDevice physicalDevice) {
     // Create light buffer (host-visible for easy updates)
     if (VulkanUtils::CreateBuffer(m_device, m_physicalDevice, kLightBufferSize,
             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Buffer,
             &m_lightBuffer, &m_lightBufferMemory) != VK_SUCCESS)
         throw std::runtime_error("LightManager: Failed to create light buffer");
 
-    // Map permanently for updates
-    vkMapMemory(m_device, m_lightBufferMemory, 0, kLightBufferSize, 0, &m_mappedMemory);
+    // Host-visible allocations stay mapped
+    m_mappedMemory = m_lightBufferMemory.pMapped;
 
     // Initialize with zero lights
     std::memset(m_mappedMemory, 0, kLightBufferSize);
@@ -33,20 +33,14 @@ void LightManager::Create(VkDevice device, VkPhysicalDevice physicalDevice) {
 void LightManager::Destroy() {
     if (m_device == VK_NULL_HANDLE) return;
 
-    if (m_mappedMemory != nullptr) {
-        vkUnmapMemory(m_device, m_lightBufferMemory);
-        m_mappedMemory = nullptr;
-    }
+    m_mappedMemory = nullptr;
 
     if (m_lightBuffer != VK_NULL_HANDLE) {
         vkDestroyBuffer(m_device, m_lightBuffer, nullptr);
         m_lightBuffer = VK_NULL_HANDLE;
     }
 
-    if (m_lightBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_device, m_lightBufferMemory, nullptr);
-        m_lightBufferMemory = VK_NULL_HANDLE;
-    }
+    VulkanMemory::Free(m_device, m_lightBufferMemory);
 
     m_device = VK_NULL_HANDLE;
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "light_component.h"
+#include "vulkan/vulkan_memory.h"
 #include <vector>
 #include <vulkan/vulkan.h>
 
@@ -60,7 +61,7 @@ private:
     class Scene* m_pScene = nullptr;
 
     VkBuffer m_lightBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory m_lightBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation m_lightBufferMemory;
     void* m_mappedMemory = nullptr;
 
     uint32_t m_activeLightCount = 0;
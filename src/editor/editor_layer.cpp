@@ -9,6 +9,7 @@
 #include "core/camera_component.h"
 #include "managers/mesh_manager.h"
 #include "scene/scene_unified.h"
+#include "core/frame_arena.h"
 #include "scene/level_selector.h"
 #include "camera/camera.h"
 #include "config/vulkan_config.h"
@@ -593,8 +594,10 @@ void EditorLayer::DrawHierarchyPanel(Scene* pScene) {
     ImGui::Begin("Hierarchy");
 
     if (pScene) {
-        // Get root objects (those without parents)
-        std::vector<uint32_t> roots = pScene->GetRootObjects();
+        // Get root objects (those without parents); scratch memory, released when the panel is done
+        ScratchScope scratch;
+        ArenaVector<uint32_t> roots(scratch.GetAllocator<uint32_t>());
+        pScene->GetRootObjects(roots);
         
         // "[Root]" drop target for unparenting objects
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 0.6f, 0.6f, 1.0f));
@@ -619,6 +622,8 @@ void EditorLayer::DrawHierarchyPanel(Scene* pScene) {
             if (!pGO || !pGO->bActive) return;
             
             bool hasChildren = !pGO->children.empty();
+            char nameBuf[128];
+            const char* name = pScene->GetGameObjectName(*pGO, nameBuf, sizeof(nameBuf));
             
             ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
             if (goId == m_selectedObjectId) {
@@ -632,7 +637,7 @@ void EditorLayer::DrawHierarchyPanel(Scene* pScene) {
                 reinterpret_cast<void*>(static_cast<intptr_t>(goId)),
                 flags,
                 "%s [%u]",
-                pGO->name.empty() ? "Unnamed" : pGO->name.c_str(),
+                name,
                 goId
             );
             
@@ -644,7 +649,7 @@ void EditorLayer::DrawHierarchyPanel(Scene* pScene) {
             // Drag source for reparenting
             if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_None)) {
                 ImGui::SetDragDropPayload("GAMEOBJECT_ID", &goId, sizeof(uint32_t));
-                ImGui::Text("Move: %s", pGO->name.empty() ? "Unnamed" : pGO->name.c_str());
+                ImGui::Text("Move: %s", name);
                 ImGui::EndDragDropSource();
             }
             
@@ -685,7 +690,7 @@ void EditorLayer::DrawInspectorPanel(Scene* pScene) {
         if (pGO) {
             // Name
             char nameBuf[256];
-            std::snprintf(nameBuf, sizeof(nameBuf), "%s", pGO->name.c_str());
+            std::snprintf(nameBuf, sizeof(nameBuf), "%s", pScene->GetGameObjectName(*pGO).c_str());
             if (ImGui::InputText("Name", nameBuf, sizeof(nameBuf))) {
                 pGO->name = nameBuf;
             }
@@ -704,7 +709,7 @@ void EditorLayer::DrawInspectorPanel(Scene* pScene) {
                     if (currentParent != NO_PARENT) {
                         const GameObject* pParentGO = pScene->FindGameObject(currentParent);
                         if (pParentGO) {
-                            currentParentName = pParentGO->name.empty() ? "Unnamed" : pParentGO->name;
+                            currentParentName = pScene->GetGameObjectName(*pParentGO);
                             currentParentName += " [" + std::to_string(currentParent) + "]";
                         }
                     }
@@ -723,7 +728,7 @@ void EditorLayer::DrawInspectorPanel(Scene* pScene) {
                             if (go.id == m_selectedObjectId) continue; // Can't parent to self
                             if (pScene->WouldCreateCycle(m_selectedObjectId, go.id)) continue; // Skip cycles
                             
-                            std::string label = go.name.empty() ? "Unnamed" : go.name;
+                            std::string label = pScene->GetGameObjectName(go);
                             label += " [" + std::to_string(go.id) + "]";
                             
                             if (ImGui::Selectable(label.c_str(), currentParent == go.id)) {
@@ -1001,22 +1006,8 @@ void EditorLayer::DrawGizmo(Scene* pScene, Camera* pCamera) {
         proj[0][0] = proj[1][1] / viewportAspect;
     }
 
-    glm::mat4 model = glm::mat4(1.0f);
-    if (m_pRenderScene) {
-        auto renderList = m_pRenderScene->BuildRenderList(nullptr, false);
-        for (const auto& ro : renderList) {
-            if (ro.gameObjectId == m_selectedObjectId) {
-                const float* m = ro.worldMatrix;
-                model = glm::mat4(m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7],
-                                  m[8], m[9], m[10], m[11], m[12], m[13], m[14], m[15]);
-                break;
-            }
-        }
-    }
-    /* Fallback when object has no renderer: use world matrix so gizmo is in world space. */
-    if (model == glm::mat4(1.0f) && pTransform) {
-        model = glm::make_mat4(pTransform->worldMatrix);
-    }
+    /* World matrix straight from the transform (what the render list would copy), so the gizmo is in world space. */
+    glm::mat4 model = glm::make_mat4(pTransform->worldMatrix);
 
     // Convert gizmo operation
     ImGuizmo::OPERATION op = ImGuizmo::TRANSLATE;
@@ -1091,7 +1082,8 @@ void EditorLayer::DrawGizmo(Scene* pScene, Camera* pCamera) {
         pTransform->scale[2] = scale.z;
 
         pTransform->bDirty = true;
-        m_objectsMovedThisFrame.insert(m_selectedObjectId);
+        if (std::find(m_objectsMovedThisFrame.begin(), m_objectsMovedThisFrame.end(), m_selectedObjectId) == m_objectsMovedThisFrame.end())
+            m_objectsMovedThisFrame.push_back(m_selectedObjectId);
     }
 
     m_bGizmoUsing = ImGuizmo::IsUsing();
@@ -1115,10 +1107,14 @@ void EditorLayer::SetSelectedObject(uint32_t gameObjectId) {
     m_selectedObjectId = gameObjectId;
 }
 
-std::unordered_set<uint32_t> EditorLayer::ConsumeMovedObjectIds() {
-    std::unordered_set<uint32_t> out = std::move(m_objectsMovedThisFrame);
-    m_objectsMovedThisFrame.clear();
-    return out;
+std::span<const uint32_t> EditorLayer::ConsumeMovedObjectIds(LinearArena& arena_io) {
+    if (m_objectsMovedThisFrame.empty()) return {};
+    const size_t count = m_objectsMovedThisFrame.size();
+    uint32_t* pIds = arena_io.AllocateArray<uint32_t>(count);
+    std::copy(m_objectsMovedThisFrame.begin(), m_objectsMovedThisFrame.end(), pIds);
+    std::sort(pIds, pIds + count);
+    m_objectsMovedThisFrame.clear();  // Keeps its capacity
+    return { pIds, count };
 }
 
 void EditorLayer::SelectAtScreenPos(Scene* pScene, Camera* pCamera, float screenX, float screenY, uint32_t viewportW, uint32_t viewportH) {
@@ -1201,13 +1197,14 @@ void EditorLayer::SaveCurrentLevel(Scene* pScene) {
             if (go.HasLight() && !go.HasRenderer()) continue;
 
             nlohmann::json instance;
-            instance["name"] = go.name;
+            const std::string goName = pScene->GetGameObjectName(go);
+            instance["name"] = goName;
 
             // Find source path from renderer component if available
             if (go.HasRenderer() && go.rendererIndex < renderers.size()) {
                 // Note: RendererComponent doesn't store sourcePath currently.
                 // We preserve the name which can be used to identify the object.
-                instance["source"] = "mesh:" + go.name;
+                instance["source"] = "mesh:" + goName;
             } else {
                 instance["source"] = "unknown";
             }
@@ -1245,7 +1242,7 @@ void EditorLayer::SaveCurrentLevel(Scene* pScene) {
 
             nlohmann::json instance;
             instance["source"] = "light";
-            instance["name"] = pGo->name;
+            instance["name"] = pScene->GetGameObjectName(*pGo);
             instance["transform"] = {
                 {"position", {pTransform->position[0], pTransform->position[1], pTransform->position[2]}},
                 {"scale", {pTransform->scale[0], pTransform->scale[1], pTransform->scale[2]}}
@@ -1319,7 +1316,7 @@ void EditorLayer::DrawCamerasPanel(Scene* pScene) {
         ImGui::PushID(static_cast<int>(go.id));
         
         // Build camera label
-        std::string label = go.name.empty() ? ("Camera " + std::to_string(go.id)) : go.name;
+        std::string label = pScene->GetGameObjectName(go);
         
         bool opened = ImGui::CollapsingHeader(label.c_str(), ImGuiTreeNodeFlags_DefaultOpen);
         
@@ -1343,7 +1340,7 @@ void EditorLayer::DrawCamerasPanel(Scene* pScene) {
             
             // Camera name (editable)
             char nameBuf[64] = {};
-            const std::string& goName = go.name;
+            const std::string goName = pScene->GetGameObjectName(go);
             size_t copyLen = goName.size() < sizeof(nameBuf) - 1 ? goName.size() : sizeof(nameBuf) - 1;
             for (size_t ci = 0; ci < copyLen; ++ci) {
                 nameBuf[ci] = goName[ci];
@@ -1547,7 +1544,7 @@ void EditorLayer::DrawViewportsPanel(ViewportManager* pViewportManager, Scene* p
                     const auto& gameObjects = pScene->GetGameObjects();
                     for (const auto& go : gameObjects) {
                         if (go.bActive && go.HasCamera()) {
-                            std::string label = go.name.empty() ? ("Camera " + std::to_string(go.id)) : go.name;
+                            std::string label = pScene->GetGameObjectName(go);
                             cameraOptions.push_back({go.id, label});
                         }
                     }
@@ -9,8 +9,8 @@
 
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
+#include <span>
 #include <string>
-#include <unordered_set>
 #include <vector>
 #include <cstdint>
 #include <functional>
@@ -19,6 +19,7 @@ struct SDL_Window;
 class Scene;  // unified scene (scene_unified.h)
 class Camera;
 struct Transform;
+class LinearArena;
 class LevelSelector;
 struct VulkanConfig;
 class ViewportManager;
@@ -123,8 +124,8 @@ public:
     /** Get currently selected GameObject ID. UINT32_MAX if none. */
     uint32_t GetSelectedObject() const { return m_selectedObjectId; }
 
-    /** Returns set of game object IDs whose transform was changed this frame (e.g. by gizmo); clears the set. Used so SSBO only re-uploads moved objects in editor. */
-    std::unordered_set<uint32_t> ConsumeMovedObjectIds();
+    /** Returns the game object IDs whose transform was changed this frame (e.g. by gizmo), sorted, copied into arena_io (the frame arena); clears the list. Used so SSBO only re-uploads moved objects in editor. */
+    std::span<const uint32_t> ConsumeMovedObjectIds(LinearArena& arena_io);
 
     /** Perform ray cast selection from screen position. */
     void SelectAtScreenPos(Scene* pScene, Camera* pCamera, float screenX, float screenY, uint32_t viewportW, uint32_t viewportH);
@@ -217,7 +218,7 @@ private:
     float m_cachedScale[3] = {1.f, 1.f, 1.f};
 
     /** Game object IDs that had their transform changed this frame (e.g. by gizmo). Consumed before SSBO update so only moved objects are re-uploaded. */
-    std::unordered_set<uint32_t> m_objectsMovedThisFrame;
+    std::vector<uint32_t> m_objectsMovedThisFrame;
 
     // Level path for saving
     std::string m_currentLevelPath;
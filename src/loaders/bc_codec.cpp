@@ -0,0 +1,659 @@
+/*
+ * BC codec — CPU encoders (BC1/BC3/BC4/BC5, BC7 mode 6) and decoders for cooking textures and checking cooked output.
+ */
+#include "bc_codec.h"
+#include "thread/job_queue.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/** Block rows per worker task; smaller images are encoded on the calling thread. */
+constexpr uint32_t kBlockRowsPerTask = 16u;
+constexpr size_t kMinBlocksForWorkers = 64u * 64u;
+
+constexpr uint8_t kBC7Weights2[4]  = { 0, 21, 43, 64 };
+constexpr uint8_t kBC7Weights3[8]  = { 0, 9, 18, 27, 37, 46, 55, 64 };
+constexpr uint8_t kBC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+inline uint8_t Bc7Interpolate(uint32_t e0, uint32_t e1, uint32_t w) {
+    return static_cast<uint8_t>(((64u - w) * e0 + w * e1 + 32u) >> 6u);
+}
+
+/** Little-endian 128-bit bit stream (BC7 block layout). */
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* pBlock) : m_pBlock(pBlock) { std::memset(pBlock, 0, 16u); }
+    void Write(uint32_t uValue, uint32_t lBits) {
+        for (uint32_t i = 0u; i < lBits; ++i, ++m_lPos) {
+            if ((uValue >> i) & 1u)
+                m_pBlock[m_lPos >> 3u] |= static_cast<uint8_t>(1u << (m_lPos & 7u));
+        }
+    }
+private:
+    uint8_t* m_pBlock;
+    uint32_t m_lPos = 0u;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* pBlock) : m_pBlock(pBlock) {}
+    uint32_t Read(uint32_t lBits) {
+        uint32_t uValue = 0u;
+        for (uint32_t i = 0u; i < lBits; ++i, ++m_lPos)
+            uValue |= static_cast<uint32_t>((m_pBlock[m_lPos >> 3u] >> (m_lPos & 7u)) & 1u) << i;
+        return uValue;
+    }
+private:
+    const uint8_t* m_pBlock;
+    uint32_t m_lPos = 0u;
+};
+
+// ---- Endpoint fitting -------------------------------------------------------
+
+/**
+ * Principal-axis endpoints of 16 points with lChannels components: mean +/- extent along the dominant eigenvector
+ * (power iteration on the covariance). Falls back to the bounding box diagonal when the block is flat.
+ */
+void FitPrincipalEndpoints(const float (*pPts)[4], uint32_t lChannels, float* pE0, float* pE1) {
+    float fMean[4] = { 0.f, 0.f, 0.f, 0.f };
+    float fMin[4] = { 255.f, 255.f, 255.f, 255.f };
+    float fMax[4] = { 0.f, 0.f, 0.f, 0.f };
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        for (uint32_t c = 0u; c < lChannels; ++c) {
+            fMean[c] += pPts[i][c];
+            fMin[c] = std::min(fMin[c], pPts[i][c]);
+            fMax[c] = std::max(fMax[c], pPts[i][c]);
+        }
+    }
+    for (uint32_t c = 0u; c < lChannels; ++c)
+        fMean[c] /= 16.f;
+
+    float fCov[4][4] = {};
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        for (uint32_t a = 0u; a < lChannels; ++a) {
+            const float fDa = pPts[i][a] - fMean[a];
+            for (uint32_t b = a; b < lChannels; ++b)
+                fCov[a][b] += fDa * (pPts[i][b] - fMean[b]);
+        }
+    }
+    for (uint32_t a = 0u; a < lChannels; ++a)
+        for (uint32_t b = 0u; b < a; ++b)
+            fCov[a][b] = fCov[b][a];
+
+    float fAxis[4] = { 0.f, 0.f, 0.f, 0.f };
+    for (uint32_t c = 0u; c < lChannels; ++c)
+        fAxis[c] = fMax[c] - fMin[c];
+    for (uint32_t lIter = 0u; lIter < 6u; ++lIter) {
+        float fNext[4] = { 0.f, 0.f, 0.f, 0.f };
+        float fLen = 0.f;
+        for (uint32_t a = 0u; a < lChannels; ++a) {
+            for (uint32_t b = 0u; b < lChannels; ++b)
+                fNext[a] += fCov[a][b] * fAxis[b];
+            fLen = std::max(fLen, std::fabs(fNext[a]));
+        }
+        if (fLen <= 1e-6f)
+            break;
+        for (uint32_t c = 0u; c < lChannels; ++c)
+            fAxis[c] = fNext[c] / fLen;
+    }
+    float fAxisLenSq = 0.f;
+    for (uint32_t c = 0u; c < lChannels; ++c)
+        fAxisLenSq += fAxis[c] * fAxis[c];
+    if (fAxisLenSq <= 1e-12f) {
+        for (uint32_t c = 0u; c < lChannels; ++c) {
+            pE0[c] = fMin[c];
+            pE1[c] = fMax[c];
+        }
+        return;
+    }
+
+    float fTMin = 1e30f;
+    float fTMax = -1e30f;
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        float fT = 0.f;
+        for (uint32_t c = 0u; c < lChannels; ++c)
+            fT += (pPts[i][c] - fMean[c]) * fAxis[c];
+        fTMin = std::min(fTMin, fT);
+        fTMax = std::max(fTMax, fT);
+    }
+    fTMin /= fAxisLenSq;
+    fTMax /= fAxisLenSq;
+    for (uint32_t c = 0u; c < lChannels; ++c) {
+        pE0[c] = std::clamp(fMean[c] + fAxis[c] * fTMin, 0.f, 255.f);
+        pE1[c] = std::clamp(fMean[c] + fAxis[c] * fTMax, 0.f, 255.f);
+    }
+}
+
+/**
+ * Least-squares endpoints for fixed interpolation weights (t in [0,1] per texel): minimizes
+ * sum |(1-t) e0 + t e1 - p|^2. Returns false when the system is singular (all texels on one weight).
+ */
+bool RefineEndpoints(const float (*pPts)[4], const float* pT, uint32_t lChannels, float* pE0, float* pE1) {
+    float fA = 0.f, fB = 0.f, fC = 0.f;
+    float fX[4] = { 0.f, 0.f, 0.f, 0.f };
+    float fY[4] = { 0.f, 0.f, 0.f, 0.f };
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        const float fT = pT[i];
+        const float fS = 1.f - fT;
+        fA += fS * fS;
+        fB += fS * fT;
+        fC += fT * fT;
+        for (uint32_t c = 0u; c < lChannels; ++c) {
+            fX[c] += fS * pPts[i][c];
+            fY[c] += fT * pPts[i][c];
+        }
+    }
+    const float fDet = fA * fC - fB * fB;
+    if (std::fabs(fDet) < 1e-6f)
+        return false;
+    const float fInv = 1.f / fDet;
+    for (uint32_t c = 0u; c < lChannels; ++c) {
+        pE0[c] = std::clamp((fC * fX[c] - fB * fY[c]) * fInv, 0.f, 255.f);
+        pE1[c] = std::clamp((fA * fY[c] - fB * fX[c]) * fInv, 0.f, 255.f);
+    }
+    return true;
+}
+
+// ---- BC1 --------------------------------------------------------------------
+
+inline uint16_t PackRgb565(const float* pRgb) {
+    const uint32_t r = static_cast<uint32_t>(std::clamp(pRgb[0] * (31.f / 255.f) + 0.5f, 0.f, 31.f));
+    const uint32_t g = static_cast<uint32_t>(std::clamp(pRgb[1] * (63.f / 255.f) + 0.5f, 0.f, 63.f));
+    const uint32_t b = static_cast<uint32_t>(std::clamp(pRgb[2] * (31.f / 255.f) + 0.5f, 0.f, 31.f));
+    return static_cast<uint16_t>((r << 11u) | (g << 5u) | b);
+}
+
+inline void UnpackRgb565(uint16_t uColor, uint8_t* pRgb) {
+    const uint32_t r = (uColor >> 11u) & 31u;
+    const uint32_t g = (uColor >> 5u) & 63u;
+    const uint32_t b = uColor & 31u;
+    pRgb[0] = static_cast<uint8_t>((r << 3u) | (r >> 2u));
+    pRgb[1] = static_cast<uint8_t>((g << 2u) | (g >> 4u));
+    pRgb[2] = static_cast<uint8_t>((b << 3u) | (b >> 2u));
+}
+
+/** 4-colour BC1 palette (c0 > c1 ordering, or BC3 colour block). */
+void Bc1Palette4(uint16_t uC0, uint16_t uC1, uint8_t (*pPalette)[4]) {
+    UnpackRgb565(uC0, pPalette[0]);
+    UnpackRgb565(uC1, pPalette[1]);
+    for (uint32_t c = 0u; c < 3u; ++c) {
+        pPalette[2][c] = static_cast<uint8_t>((2u * pPalette[0][c] + pPalette[1][c]) / 3u);
+        pPalette[3][c] = static_cast<uint8_t>((pPalette[0][c] + 2u * pPalette[1][c]) / 3u);
+    }
+    for (uint32_t i = 0u; i < 4u; ++i)
+        pPalette[i][3] = 255u;
+}
+
+/** Pick the nearest palette entry per texel; returns the summed squared RGB error. */
+uint32_t Bc1SelectIndices(const uint8_t* pRgba, const uint8_t (*pPalette)[4], uint32_t* pIndices) {
+    uint32_t uTotal = 0u;
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        uint32_t uBest = UINT32_MAX;
+        uint32_t lBestIdx = 0u;
+        for (uint32_t p = 0u; p < 4u; ++p) {
+            uint32_t uErr = 0u;
+            for (uint32_t c = 0u; c < 3u; ++c) {
+                const int32_t iD = static_cast<int32_t>(pRgba[i * 4u + c]) - static_cast<int32_t>(pPalette[p][c]);
+                uErr += static_cast<uint32_t>(iD * iD);
+            }
+            if (uErr < uBest) {
+                uBest = uErr;
+                lBestIdx = p;
+            }
+        }
+        pIndices[i] = lBestIdx;
+        uTotal += uBest;
+    }
+    return uTotal;
+}
+
+/** Opaque 4-colour BC1 block (also the colour half of BC3). */
+void EncodeBC1Color(const uint8_t* pRgba, uint8_t* pBlock) {
+    float fPts[16][4];
+    for (uint32_t i = 0u; i < 16u; ++i)
+        for (uint32_t c = 0u; c < 4u; ++c)
+            fPts[i][c] = static_cast<float>(pRgba[i * 4u + c]);
+
+    float fE0[4] = {}, fE1[4] = {};
+    FitPrincipalEndpoints(fPts, 3u, fE0, fE1);
+
+    uint16_t uBestC0 = 0u, uBestC1 = 0u;
+    uint32_t lBestIdx[16] = {};
+    uint32_t uBestErr = UINT32_MAX;
+    for (uint32_t lPass = 0u; lPass < 2u; ++lPass) {
+        uint16_t uC0 = PackRgb565(fE1);
+        uint16_t uC1 = PackRgb565(fE0);
+        if (uC0 < uC1)
+            std::swap(uC0, uC1);
+        uint8_t uPalette[4][4];
+        Bc1Palette4(uC0, uC1, uPalette);
+        uint32_t lIdx[16];
+        const uint32_t uErr = Bc1SelectIndices(pRgba, uPalette, lIdx);
+        if (uErr < uBestErr) {
+            uBestErr = uErr;
+            uBestC0 = uC0;
+            uBestC1 = uC1;
+            std::memcpy(lBestIdx, lIdx, sizeof(lIdx));
+        }
+        // Refine: palette index -> weight of c1 (0, 1, 1/3, 2/3)
+        static constexpr float kWeights[4] = { 0.f, 1.f, 1.f / 3.f, 2.f / 3.f };
+        float fT[16];
+        for (uint32_t i = 0u; i < 16u; ++i)
+            fT[i] = kWeights[lIdx[i]];
+        float fR0[4] = {}, fR1[4] = {};
+        if (RefineEndpoints(fPts, fT, 3u, fR0, fR1) == false)
+            break;
+        // fR0 weights c0 (the larger 565 value), fR1 c1: keep fE1 = "c0 side" convention for the next pass
+        std::memcpy(fE1, fR0, sizeof(fR0));
+        std::memcpy(fE0, fR1, sizeof(fR1));
+    }
+
+    uint32_t uBits = 0u;
+    if (uBestC0 != uBestC1) {
+        for (uint32_t i = 0u; i < 16u; ++i)
+            uBits |= lBestIdx[i] << (2u * i);
+    }
+    pBlock[0] = static_cast<uint8_t>(uBestC0 & 0xFFu);
+    pBlock[1] = static_cast<uint8_t>(uBestC0 >> 8u);
+    pBlock[2] = static_cast<uint8_t>(uBestC1 & 0xFFu);
+    pBlock[3] = static_cast<uint8_t>(uBestC1 >> 8u);
+    for (uint32_t b = 0u; b < 4u; ++b)
+        pBlock[4u + b] = static_cast<uint8_t>((uBits >> (8u * b)) & 0xFFu);
+}
+
+void DecodeBC1Color(const uint8_t* pBlock, bool bForceFourColor, uint8_t* pRgba) {
+    const uint16_t uC0 = static_cast<uint16_t>(pBlock[0] | (pBlock[1] << 8u));
+    const uint16_t uC1 = static_cast<uint16_t>(pBlock[2] | (pBlock[3] << 8u));
+    uint8_t uPalette[4][4];
+    if ((uC0 > uC1) || (bForceFourColor == true)) {
+        Bc1Palette4(uC0, uC1, uPalette);
+    } else {
+        UnpackRgb565(uC0, uPalette[0]);
+        UnpackRgb565(uC1, uPalette[1]);
+        for (uint32_t c = 0u; c < 3u; ++c) {
+            uPalette[2][c] = static_cast<uint8_t>((uPalette[0][c] + uPalette[1][c]) / 2u);
+            uPalette[3][c] = 0u;
+        }
+        uPalette[0][3] = uPalette[1][3] = uPalette[2][3] = 255u;
+        uPalette[3][3] = 0u;
+    }
+    const uint32_t uBits = static_cast<uint32_t>(pBlock[4]) | (static_cast<uint32_t>(pBlock[5]) << 8u) |
+                           (static_cast<uint32_t>(pBlock[6]) << 16u) | (static_cast<uint32_t>(pBlock[7]) << 24u);
+    for (uint32_t i = 0u; i < 16u; ++i)
+        std::memcpy(pRgba + i * 4u, uPalette[(uBits >> (2u * i)) & 3u], 4u);
+}
+
+// ---- BC4 --------------------------------------------------------------------
+
+/** 8-value palette when a0 > a1, else 6 values + 0 + 255. */
+void Bc4Palette(uint8_t uA0, uint8_t uA1, uint8_t* pPalette) {
+    pPalette[0] = uA0;
+    pPalette[1] = uA1;
+    if (uA0 > uA1) {
+        for (uint32_t i = 1u; i < 7u; ++i)
+            pPalette[1u + i] = static_cast<uint8_t>(((7u - i) * uA0 + i * uA1) / 7u);
+    } else {
+        for (uint32_t i = 1u; i < 5u; ++i)
+            pPalette[1u + i] = static_cast<uint8_t>(((5u - i) * uA0 + i * uA1) / 5u);
+        pPalette[6] = 0u;
+        pPalette[7] = 255u;
+    }
+}
+
+/** Encode 16 single-channel values read from pRgba at lChannel (stride 4). */
+void EncodeBC4Channel(const uint8_t* pRgba, uint32_t lChannel, uint8_t* pBlock) {
+    uint8_t uMin = 255u, uMax = 0u;
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        uMin = std::min(uMin, pRgba[i * 4u + lChannel]);
+        uMax = std::max(uMax, pRgba[i * 4u + lChannel]);
+    }
+    pBlock[0] = uMax;
+    pBlock[1] = uMin;
+    uint64_t uBits = 0u;
+    if (uMax != uMin) {
+        uint8_t uPalette[8];
+        Bc4Palette(uMax, uMin, uPalette);
+        for (uint32_t i = 0u; i < 16u; ++i) {
+            const int32_t iV = pRgba[i * 4u + lChannel];
+            uint32_t lBest = 0u;
+            int32_t iBestErr = 256;
+            for (uint32_t p = 0u; p < 8u; ++p) {
+                const int32_t iErr = std::abs(iV - static_cast<int32_t>(uPalette[p]));
+                if (iErr < iBestErr) {
+                    iBestErr = iErr;
+                    lBest = p;
+                }
+            }
+            uBits |= static_cast<uint64_t>(lBest) << (3u * i);
+        }
+    }
+    for (uint32_t b = 0u; b < 6u; ++b)
+        pBlock[2u + b] = static_cast<uint8_t>((uBits >> (8u * b)) & 0xFFu);
+}
+
+void DecodeBC4Channel(const uint8_t* pBlock, uint32_t lChannel, uint8_t* pRgba) {
+    uint8_t uPalette[8];
+    Bc4Palette(pBlock[0], pBlock[1], uPalette);
+    uint64_t uBits = 0u;
+    for (uint32_t b = 0u; b < 6u; ++b)
+        uBits |= static_cast<uint64_t>(pBlock[2u + b]) << (8u * b);
+    for (uint32_t i = 0u; i < 16u; ++i)
+        pRgba[i * 4u + lChannel] = uPalette[(uBits >> (3u * i)) & 7u];
+}
+
+// ---- BC7 (mode 6 encode; modes 4-6 decode) ---------------------------------
+
+/** Quantize an RGBA endpoint to 7 bits + shared p-bit (mode 6); picks the p-bit with the lower error. */
+void QuantizeMode6Endpoint(const float* pE, uint32_t* pQ, uint32_t& lP) {
+    float fBestErr = 1e30f;
+    for (uint32_t p = 0u; p < 2u; ++p) {
+        uint32_t lQ[4];
+        float fErr = 0.f;
+        for (uint32_t c = 0u; c < 4u; ++c) {
+            lQ[c] = static_cast<uint32_t>(std::clamp((pE[c] - static_cast<float>(p)) * 0.5f + 0.5f, 0.f, 127.f));
+            const float fD = static_cast<float>((lQ[c] << 1u) | p) - pE[c];
+            fErr += fD * fD;
+        }
+        if (fErr < fBestErr) {
+            fBestErr = fErr;
+            lP = p;
+            std::memcpy(pQ, lQ, sizeof(lQ));
+        }
+    }
+}
+
+uint32_t Mode6SelectIndices(const uint8_t* pRgba, const uint8_t* pE0, const uint8_t* pE1, uint32_t* pIndices) {
+    uint8_t uPalette[16][4];
+    for (uint32_t w = 0u; w < 16u; ++w)
+        for (uint32_t c = 0u; c < 4u; ++c)
+            uPalette[w][c] = Bc7Interpolate(pE0[c], pE1[c], kBC7Weights4[w]);
+    uint32_t uTotal = 0u;
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        uint32_t uBest = UINT32_MAX;
+        uint32_t lBestIdx = 0u;
+        for (uint32_t w = 0u; w < 16u; ++w) {
+            uint32_t uErr = 0u;
+            for (uint32_t c = 0u; c < 4u; ++c) {
+                const int32_t iD = static_cast<int32_t>(pRgba[i * 4u + c]) - static_cast<int32_t>(uPalette[w][c]);
+                uErr += static_cast<uint32_t>(iD * iD);
+            }
+            if (uErr < uBest) {
+                uBest = uErr;
+                lBestIdx = w;
+            }
+        }
+        pIndices[i] = lBestIdx;
+        uTotal += uBest;
+    }
+    return uTotal;
+}
+
+void EncodeBC7Mode6(const uint8_t* pRgba, uint8_t* pBlock) {
+    float fPts[16][4];
+    for (uint32_t i = 0u; i < 16u; ++i)
+        for (uint32_t c = 0u; c < 4u; ++c)
+            fPts[i][c] = static_cast<float>(pRgba[i * 4u + c]);
+
+    float fE0[4] = {}, fE1[4] = {};
+    FitPrincipalEndpoints(fPts, 4u, fE0, fE1);
+
+    uint32_t lBestQ0[4] = {}, lBestQ1[4] = {}, lBestP0 = 0u, lBestP1 = 0u;
+    uint32_t lBestIdx[16] = {};
+    uint32_t uBestErr = UINT32_MAX;
+    for (uint32_t lPass = 0u; lPass < 2u; ++lPass) {
+        uint32_t lQ0[4], lQ1[4], lP0 = 0u, lP1 = 0u;
+        QuantizeMode6Endpoint(fE0, lQ0, lP0);
+        QuantizeMode6Endpoint(fE1, lQ1, lP1);
+        uint8_t uE0[4], uE1[4];
+        for (uint32_t c = 0u; c < 4u; ++c) {
+            uE0[c] = static_cast<uint8_t>((lQ0[c] << 1u) | lP0);
+            uE1[c] = static_cast<uint8_t>((lQ1[c] << 1u) | lP1);
+        }
+        uint32_t lIdx[16];
+        const uint32_t uErr = Mode6SelectIndices(pRgba, uE0, uE1, lIdx);
+        if (uErr < uBestErr) {
+            uBestErr = uErr;
+            std::memcpy(lBestQ0, lQ0, sizeof(lQ0));
+            std::memcpy(lBestQ1, lQ1, sizeof(lQ1));
+            lBestP0 = lP0;
+            lBestP1 = lP1;
+            std::memcpy(lBestIdx, lIdx, sizeof(lIdx));
+        }
+        if (uErr == 0u)
+            break;
+        float fT[16];
+        for (uint32_t i = 0u; i < 16u; ++i)
+            fT[i] = static_cast<float>(kBC7Weights4[lIdx[i]]) / 64.f;
+        if (RefineEndpoints(fPts, fT, 4u, fE0, fE1) == false)
+            break;
+    }
+
+    // Anchor texel 0 stores 3 index bits: its index must be < 8 (swap endpoints + invert indices otherwise)
+    if (lBestIdx[0] >= 8u) {
+        std::swap(lBestQ0, lBestQ1);
+        std::swap(lBestP0, lBestP1);
+        for (uint32_t i = 0u; i < 16u; ++i)
+            lBestIdx[i] = 15u - lBestIdx[i];
+    }
+
+    BitWriter stWriter(pBlock);
+    stWriter.Write(1u << 6u, 7u);  // Mode 6
+    for (uint32_t c = 0u; c < 4u; ++c) {
+        stWriter.Write(lBestQ0[c], 7u);
+        stWriter.Write(lBestQ1[c], 7u);
+    }
+    stWriter.Write(lBestP0, 1u);
+    stWriter.Write(lBestP1, 1u);
+    stWriter.Write(lBestIdx[0], 3u);
+    for (uint32_t i = 1u; i < 16u; ++i)
+        stWriter.Write(lBestIdx[i], 4u);
+}
+
+/** Read 16 indices of lBits each (texel 0 = anchor, one bit shorter). */
+void ReadBc7Indices(BitReader& stReader, uint32_t lBits, uint32_t* pIndices) {
+    pIndices[0] = stReader.Read(lBits - 1u);
+    for (uint32_t i = 1u; i < 16u; ++i)
+        pIndices[i] = stReader.Read(lBits);
+}
+
+inline uint8_t ExpandBits(uint32_t uValue, uint32_t lBits) {
+    return static_cast<uint8_t>((uValue << (8u - lBits)) | (uValue >> (2u * lBits - 8u)));
+}
+
+bool DecodeBC7(const uint8_t* pBlock, uint8_t* pRgba) {
+    uint32_t lMode = 0u;
+    while ((lMode < 8u) && (((pBlock[0] >> lMode) & 1u) == 0u))
+        ++lMode;
+    if ((lMode != 4u) && (lMode != 5u) && (lMode != 6u))
+        return false;
+
+    BitReader stReader(pBlock);
+    stReader.Read(lMode + 1u);
+    uint8_t uE0[4], uE1[4];
+    uint32_t lColorIdx[16], lAlphaIdx[16];
+    const uint8_t* pColorWeights = kBC7Weights4;
+    const uint8_t* pAlphaWeights = kBC7Weights4;
+    uint32_t lRotation = 0u;
+
+    if (lMode == 6u) {
+        uint32_t lQ0[4], lQ1[4];
+        for (uint32_t c = 0u; c < 4u; ++c) {
+            lQ0[c] = stReader.Read(7u);
+            lQ1[c] = stReader.Read(7u);
+        }
+        const uint32_t lP0 = stReader.Read(1u);
+        const uint32_t lP1 = stReader.Read(1u);
+        for (uint32_t c = 0u; c < 4u; ++c) {
+            uE0[c] = static_cast<uint8_t>((lQ0[c] << 1u) | lP0);
+            uE1[c] = static_cast<uint8_t>((lQ1[c] << 1u) | lP1);
+        }
+        ReadBc7Indices(stReader, 4u, lColorIdx);
+        std::memcpy(lAlphaIdx, lColorIdx, sizeof(lColorIdx));
+    } else {
+        lRotation = stReader.Read(2u);
+        const uint32_t lIdxMode = (lMode == 4u) ? stReader.Read(1u) : 0u;
+        const uint32_t lColorBits = (lMode == 4u) ? 5u : 7u;
+        const uint32_t lAlphaBits = (lMode == 4u) ? 6u : 8u;
+        for (uint32_t c = 0u; c < 3u; ++c) {
+            uE0[c] = ExpandBits(stReader.Read(lColorBits), lColorBits);
+            uE1[c] = ExpandBits(stReader.Read(lColorBits), lColorBits);
+        }
+        const uint32_t lA0 = stReader.Read(lAlphaBits);
+        const uint32_t lA1 = stReader.Read(lAlphaBits);
+        uE0[3] = (lAlphaBits == 8u) ? static_cast<uint8_t>(lA0) : ExpandBits(lA0, lAlphaBits);
+        uE1[3] = (lAlphaBits == 8u) ? static_cast<uint8_t>(lA1) : ExpandBits(lA1, lAlphaBits);
+        // Primary index set is 2-bit; mode 4 also has a 3-bit set (idxMode selects which one drives colour)
+        uint32_t lPrimary[16], lSecondary[16];
+        ReadBc7Indices(stReader, 2u, lPrimary);
+        ReadBc7Indices(stReader, (lMode == 4u) ? 3u : 2u, lSecondary);
+        const uint8_t* pSecondaryWeights = (lMode == 4u) ? kBC7Weights3 : kBC7Weights2;
+        if (lIdxMode == 0u) {
+            std::memcpy(lColorIdx, lPrimary, sizeof(lPrimary));
+            std::memcpy(lAlphaIdx, lSecondary, sizeof(lSecondary));
+            pColorWeights = kBC7Weights2;
+            pAlphaWeights = pSecondaryWeights;
+        } else {
+            std::memcpy(lColorIdx, lSecondary, sizeof(lSecondary));
+            std::memcpy(lAlphaIdx, lPrimary, sizeof(lPrimary));
+            pColorWeights = pSecondaryWeights;
+            pAlphaWeights = kBC7Weights2;
+        }
+    }
+
+    for (uint32_t i = 0u; i < 16u; ++i) {
+        uint8_t* pOut = pRgba + i * 4u;
+        for (uint32_t c = 0u; c < 3u; ++c)
+            pOut[c] = Bc7Interpolate(uE0[c], uE1[c], pColorWeights[lColorIdx[i]]);
+        pOut[3] = Bc7Interpolate(uE0[3], uE1[3], pAlphaWeights[lAlphaIdx[i]]);
+        if (lRotation != 0u)
+            std::swap(pOut[3], pOut[lRotation - 1u]);
+    }
+    return true;
+}
+
+/** Encode block rows [lRowBegin, lRowEnd) of an image (edge texels replicated into partial blocks). */
+void EncodeBlockRows(BCFormat eFormat, const uint8_t* pRgba, uint32_t lWidth, uint32_t lHeight, uint8_t* pOut,
+                     uint32_t lRowBegin, uint32_t lRowEnd) {
+    const uint32_t lBlocksX = (lWidth + 3u) / 4u;
+    const uint32_t lBlockBytes = GetBCBlockBytes(eFormat);
+    uint8_t uTexels[64];
+    for (uint32_t lBy = lRowBegin; lBy < lRowEnd; ++lBy) {
+        for (uint32_t lBx = 0u; lBx < lBlocksX; ++lBx) {
+            for (uint32_t lY = 0u; lY < 4u; ++lY) {
+                const uint32_t lSy = std::min(lBy * 4u + lY, lHeight - 1u);
+                for (uint32_t lX = 0u; lX < 4u; ++lX) {
+                    const uint32_t lSx = std::min(lBx * 4u + lX, lWidth - 1u);
+                    std::memcpy(uTexels + (lY * 4u + lX) * 4u, pRgba + (static_cast<size_t>(lSy) * lWidth + lSx) * 4u, 4u);
+                }
+            }
+            EncodeBCBlock(eFormat, uTexels, pOut + (static_cast<size_t>(lBy) * lBlocksX + lBx) * lBlockBytes);
+        }
+    }
+}
+
+} // namespace
+
+uint32_t GetBCBlockBytes(BCFormat eFormat_ic) {
+    return ((eFormat_ic == BCFormat::BC1) || (eFormat_ic == BCFormat::BC4)) ? 8u : 16u;
+}
+
+size_t GetBCImageSize(BCFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic) {
+    return static_cast<size_t>((lWidth_ic + 3u) / 4u) * ((lHeight_ic + 3u) / 4u) * GetBCBlockBytes(eFormat_ic);
+}
+
+void EncodeBCBlock(BCFormat eFormat_ic, const uint8_t* pRgba_ic, uint8_t* pBlock_out) {
+    switch (eFormat_ic) {
+    case BCFormat::BC1:
+        EncodeBC1Color(pRgba_ic, pBlock_out);
+        break;
+    case BCFormat::BC3:
+        EncodeBC4Channel(pRgba_ic, 3u, pBlock_out);
+        EncodeBC1Color(pRgba_ic, pBlock_out + 8);
+        break;
+    case BCFormat::BC4:
+        EncodeBC4Channel(pRgba_ic, 0u, pBlock_out);
+        break;
+    case BCFormat::BC5:
+        EncodeBC4Channel(pRgba_ic, 0u, pBlock_out);
+        EncodeBC4Channel(pRgba_ic, 1u, pBlock_out + 8);
+        break;
+    case BCFormat::BC7:
+        EncodeBC7Mode6(pRgba_ic, pBlock_out);
+        break;
+    }
+}
+
+bool DecodeBCBlock(BCFormat eFormat_ic, const uint8_t* pBlock_ic, uint8_t* pRgba_out) {
+    switch (eFormat_ic) {
+    case BCFormat::BC1:
+        DecodeBC1Color(pBlock_ic, false, pRgba_out);
+        return true;
+    case BCFormat::BC3:
+        DecodeBC1Color(pBlock_ic + 8, true, pRgba_out);
+        DecodeBC4Channel(pBlock_ic, 3u, pRgba_out);
+        return true;
+    case BCFormat::BC4:
+    case BCFormat::BC5:
+        for (uint32_t i = 0u; i < 16u; ++i) {
+            pRgba_out[i * 4u + 1u] = 0u;
+            pRgba_out[i * 4u + 2u] = 0u;
+            pRgba_out[i * 4u + 3u] = 255u;
+        }
+        DecodeBC4Channel(pBlock_ic, 0u, pRgba_out);
+        if (eFormat_ic == BCFormat::BC5)
+            DecodeBC4Channel(pBlock_ic + 8, 1u, pRgba_out);
+        return true;
+    case BCFormat::BC7:
+        return DecodeBC7(pBlock_ic, pRgba_out);
+    }
+    return false;
+}
+
+void EncodeBCImage(BCFormat eFormat_ic, const uint8_t* pRgba_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                   uint8_t* pOut_out, JobQueue* pJobQueue_ic) {
+    if ((pRgba_ic == nullptr) || (pOut_out == nullptr) || (lWidth_ic == 0u) || (lHeight_ic == 0u))
+        return;
+    const uint32_t lBlocksY = (lHeight_ic + 3u) / 4u;
+    const size_t zBlocks = static_cast<size_t>((lWidth_ic + 3u) / 4u) * lBlocksY;
+    const bool bUseWorkers = (pJobQueue_ic != nullptr) && (pJobQueue_ic->GetWorkerThreadCount() > 1u);
+    if ((bUseWorkers == false) || (zBlocks < kMinBlocksForWorkers) || (lBlocksY <= kBlockRowsPerTask)) {
+        EncodeBlockRows(eFormat_ic, pRgba_ic, lWidth_ic, lHeight_ic, pOut_out, 0u, lBlocksY);
+        return;
+    }
+    /* Bands after the first go to workers; the calling thread encodes the first band, then helps. */
+    pJobQueue_ic->GetScheduler().ParallelFor(lBlocksY, kBlockRowsPerTask, [&](uint32_t lRowBegin, uint32_t lRowEnd) {
+        EncodeBlockRows(eFormat_ic, pRgba_ic, lWidth_ic, lHeight_ic, pOut_out, lRowBegin, lRowEnd);
+    });
+}
+
+bool DecodeBCImage(BCFormat eFormat_ic, const uint8_t* pData_ic, uint32_t lWidth_ic, uint32_t lHeight_ic, uint8_t* pRgba_out) {
+    if ((pData_ic == nullptr) || (pRgba_out == nullptr))
+        return false;
+    const uint32_t lBlocksX = (lWidth_ic + 3u) / 4u;
+    const uint32_t lBlocksY = (lHeight_ic + 3u) / 4u;
+    const uint32_t lBlockBytes = GetBCBlockBytes(eFormat_ic);
+    uint8_t uTexels[64];
+    for (uint32_t lBy = 0u; lBy < lBlocksY; ++lBy) {
+        for (uint32_t lBx = 0u; lBx < lBlocksX; ++lBx) {
+            if (DecodeBCBlock(eFormat_ic, pData_ic + (static_cast<size_t>(lBy) * lBlocksX + lBx) * lBlockBytes, uTexels) == false)
+                return false;
+            for (uint32_t lY = 0u; lY < 4u; ++lY) {
+                const uint32_t lDy = lBy * 4u + lY;
+                if (lDy >= lHeight_ic)
+                    break;
+                for (uint32_t lX = 0u; lX < 4u; ++lX) {
+                    const uint32_t lDx = lBx * 4u + lX;
+                    if (lDx >= lWidth_ic)
+                        break;
+                    std::memcpy(pRgba_out + (static_cast<size_t>(lDy) * lWidth_ic + lDx) * 4u, uTexels + (lY * 4u + lX) * 4u, 4u);
+                }
+            }
+        }
+    }
+    return true;
+}
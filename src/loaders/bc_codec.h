@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class JobQueue;
+
+/**
+ * Block-compressed texture formats produced/consumed by the CPU codec (4x4 texel blocks).
+ * BC1: RGB 5:6:5 endpoints, 2-bit indices (opaque). BC3: BC1 colour + BC4 alpha. BC4: one channel (R).
+ * BC5: two channels (R, G as two BC4 blocks). BC7: RGBA; the encoder emits mode 6 only (one subset, 7.7.7.7 + p-bit endpoints, 4-bit indices).
+ */
+enum class BCFormat : uint8_t {
+    BC1,
+    BC3,
+    BC4,
+    BC5,
+    BC7,
+};
+
+/** Bytes per 4x4 block (8 for BC1/BC4, 16 otherwise). */
+uint32_t GetBCBlockBytes(BCFormat eFormat_ic);
+/** Bytes of a w x h image (partial edge blocks count as full blocks). */
+size_t GetBCImageSize(BCFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic);
+
+/**
+ * Encode one 4x4 block. pRgba_ic = 16 texels, RGBA8, row-major. BC4 reads R; BC5 reads R and G.
+ * Encoders are deterministic (same input -> same bytes), so cooked output can be compared byte for byte.
+ */
+void EncodeBCBlock(BCFormat eFormat_ic, const uint8_t* pRgba_ic, uint8_t* pBlock_out);
+/**
+ * Decode one block to 16 RGBA8 texels. BC4 -> (r, 0, 0, 255), BC5 -> (r, g, 0, 255).
+ * BC7: modes 4, 5 and 6 (single subset) are decoded; returns false for the partitioned modes 0-3 and 7.
+ */
+bool DecodeBCBlock(BCFormat eFormat_ic, const uint8_t* pBlock_ic, uint8_t* pRgba_out);
+
+/**
+ * Encode a whole RGBA8 image (edge blocks replicate the last row/column).
+ * pJobQueue_ic: optional; large images are split into block-row bands on JobQueue workers (waits before returning).
+ * Must not be called from a JobQueue worker when non-null.
+ * @param pOut_out  GetBCImageSize(eFormat_ic, w, h) bytes.
+ */
+void EncodeBCImage(BCFormat eFormat_ic, const uint8_t* pRgba_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                   uint8_t* pOut_out, JobQueue* pJobQueue_ic = nullptr);
+/** Decode a whole image into w * h * 4 bytes of RGBA8. False if any block cannot be decoded. */
+bool DecodeBCImage(BCFormat eFormat_ic, const uint8_t* pData_ic, uint32_t lWidth_ic, uint32_t lHeight_ic, uint8_t* pRgba_out);
@@ -12,6 +12,7 @@
 extern "C" {
     unsigned char *stbi_load_from_memory(unsigned char const *buffer, int len, int *x, int *y, int *channels_in_file, int desired_channels);
     void stbi_image_free(void *retval_from_stbi_load);
+    int stbi_info_from_memory(unsigned char const *buffer, int len, int *x, int *y, int *comp);
 }
 
 namespace {
@@ -28,17 +29,34 @@ bool IsGlb(const std::vector<uint8_t>& bytes) {
 /**
  * Custom image loader for TinyGLTF using stb_image.
  * Required because TINYGLTF_NO_STB_IMAGE is defined to avoid conflicts with texture_manager.
+ * user_data: the loader's m_bDeferImageDecode flag (true = keep the encoded bytes, read the header only).
  */
 bool CustomLoadImageData(tinygltf::Image *image, const int image_idx, std::string *err,
                          std::string *warn, int req_width, int req_height,
                          const unsigned char *bytes, int size, void *user_data) {
     (void)warn;
-    (void)user_data;
     (void)image_idx;
     (void)req_width;
     (void)req_height;
     
     int w = 0, h = 0, comp = 0;
+    const bool* pDefer = static_cast<const bool*>(user_data);
+    if (pDefer != nullptr && *pDefer) {
+        if (!stbi_info_from_memory(bytes, size, &w, &h, &comp)) {
+            if (err) {
+                (*err) += "Failed to read image header with stb_image.\n";
+            }
+            return false;
+        }
+        image->width = w;
+        image->height = h;
+        image->component = comp;
+        image->bits = 8;
+        image->as_is = true;
+        image->image.assign(bytes, bytes + size);
+        return true;
+    }
+
     unsigned char *data = stbi_load_from_memory(bytes, size, &w, &h, &comp, 0);
     if (!data) {
         if (err) {
@@ -64,7 +82,7 @@ GltfLoader::GltfLoader() {
     m_model = std::make_unique<tinygltf::Model>();
     
     // Set custom image loader (TINYGLTF_NO_STB_IMAGE is defined, so we need to provide our own)
-    m_loader->SetImageLoader(CustomLoadImageData, nullptr);
+    m_loader->SetImageLoader(CustomLoadImageData, &m_bDeferImageDecode);
 }
 
 GltfLoader::~GltfLoader() = default;
@@ -118,6 +136,12 @@ tinygltf::Model* GltfLoader::GetModel() {
     return m_model.get();
 }
 
+std::unique_ptr<tinygltf::Model> GltfLoader::ReleaseModel() {
+    std::unique_ptr<tinygltf::Model> pModel = std::move(m_model);
+    m_model = std::make_unique<tinygltf::Model>();
+    return pModel;
+}
+
 bool GltfLoader::WriteToFile(const tinygltf::Model& model, const std::string& path) {
     if (m_loader == nullptr || path.empty())
         return false;
@@ -129,3 +153,19 @@ void GltfLoader::Clear() {
     m_model.reset();
     m_model = std::make_unique<tinygltf::Model>();
 }
+
+bool DecodeGltfImage(const tinygltf::Image& image, std::vector<uint8_t>& vecPixels_out,
+                     int& iWidth_out, int& iHeight_out, int& iComponents_out) {
+    if (!image.as_is || image.image.empty())
+        return false;
+    int w = 0, h = 0, comp = 0;
+    unsigned char* data = stbi_load_from_memory(image.image.data(), static_cast<int>(image.image.size()), &w, &h, &comp, 0);
+    if (!data)
+        return false;
+    vecPixels_out.assign(data, data + static_cast<size_t>(w) * static_cast<size_t>(h) * static_cast<size_t>(comp));
+    stbi_image_free(data);
+    iWidth_out = w;
+    iHeight_out = h;
+    iComponents_out = comp;
+    return true;
+}
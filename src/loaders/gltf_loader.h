@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -7,6 +8,7 @@
 namespace tinygltf {
 class Model;
 class TinyGLTF;
+struct Image;
 }
 
 /**
@@ -34,6 +36,15 @@ public:
     const tinygltf::Model* GetModel() const;
     tinygltf::Model* GetModel();
 
+    /** Take ownership of the loaded model (no copy); the loader is left with an empty model. */
+    std::unique_ptr<tinygltf::Model> ReleaseModel();
+
+    /**
+     * Keep images encoded (PNG/JPEG bytes in Image::image, Image::as_is = true; width/height/component from the
+     * header only). Decoding is then left to the consumer (DecodeGltfImage), e.g. only on a texture cache miss.
+     */
+    void SetDeferImageDecode(bool bDefer_ic) { this->m_bDeferImageDecode = bDefer_ic; }
+
     /** Write model to file (.glb or .gltf). Returns true on success. */
     bool WriteToFile(const tinygltf::Model& model, const std::string& path);
 
@@ -42,4 +53,12 @@ public:
 private:
     std::unique_ptr<tinygltf::TinyGLTF> m_loader;
     std::unique_ptr<tinygltf::Model> m_model;
+    bool m_bDeferImageDecode = false;  // Read by the image loader callback (user data)
 };
+
+/**
+ * Decode an image kept encoded by SetDeferImageDecode into 8-bit pixels (its own component count).
+ * Thread-safe. Returns false if the image is not encoded (as_is == false) or stb_image cannot decode it.
+ */
+bool DecodeGltfImage(const tinygltf::Image& image, std::vector<uint8_t>& vecPixels_out,
+                     int& iWidth_out, int& iHeight_out, int& iComponents_out);
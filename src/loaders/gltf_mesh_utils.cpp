@@ -3,10 +3,19 @@
  */
 #include "gltf_mesh_utils.h"
 #include <tiny_gltf.h>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <algorithm>
 #include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLTF_DECODE_SSE2 1
+#else
+#define GLTF_DECODE_SSE2 0
+#endif
 
 namespace {
 
@@ -36,46 +45,21 @@ size_t TypeComponentCount(int type) {
     }
 }
 
-float ReadComponentAsFloat(const unsigned char* p, int componentType, bool normalized) {
-    switch (componentType) {
-    case TINYGLTF_COMPONENT_TYPE_FLOAT: {
-        float v = 0.f;
-        std::memcpy(&v, p, sizeof(float));
-        return v;
-    }
-    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
-        const uint8_t v = *reinterpret_cast<const uint8_t*>(p);
-        return normalized ? (static_cast<float>(v) / 255.0f) : static_cast<float>(v);
-    }
-    case TINYGLTF_COMPONENT_TYPE_BYTE: {
-        const int8_t v = *reinterpret_cast<const int8_t*>(p);
-        if (!normalized) return static_cast<float>(v);
-        return std::max(-1.0f, static_cast<float>(v) / 127.0f);
-    }
-    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
-        uint16_t v = 0;
-        std::memcpy(&v, p, sizeof(uint16_t));
-        return normalized ? (static_cast<float>(v) / 65535.0f) : static_cast<float>(v);
-    }
-    case TINYGLTF_COMPONENT_TYPE_SHORT: {
-        int16_t v = 0;
-        std::memcpy(&v, p, sizeof(int16_t));
-        if (!normalized) return static_cast<float>(v);
-        return std::max(-1.0f, static_cast<float>(v) / 32767.0f);
-    }
-    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
-        uint32_t v = 0;
-        std::memcpy(&v, p, sizeof(uint32_t));
-        if (!normalized) return static_cast<float>(v);
-        return static_cast<float>(static_cast<double>(v) / 4294967295.0);
-    }
-    default:
-        return 0.f;
-    }
-}
+/**
+ * Validated byte view of an accessor: element i starts at pData + i * zStride.
+ * Sparse accessors are not supported (same as before); accessors without bufferView fail.
+ */
+struct AccessorView {
+    const unsigned char* pData = nullptr;
+    size_t zStride = 0u;
+    size_t zCount = 0u;
+    size_t zComponents = 0u;
+    int componentType = 0;
+    bool bNormalized = false;
+};
 
-bool ReadAccessorAsFloatN(const tinygltf::Model& model, int accessorIndex, int expectedType, std::vector<float>& outData) {
-    outData.clear();
+bool GetAccessorView(const tinygltf::Model& model, int accessorIndex, int expectedType, AccessorView& out) {
+    out = AccessorView{};
     if (accessorIndex < 0 || size_t(accessorIndex) >= model.accessors.size())
         return false;
     const tinygltf::Accessor& acc = model.accessors[size_t(accessorIndex)];
@@ -97,68 +81,136 @@ bool ReadAccessorAsFloatN(const tinygltf::Model& model, int accessorIndex, int e
     const size_t elementSize = compCount * compSize;
     const size_t stride = (bv.byteStride > 0) ? size_t(bv.byteStride) : elementSize;
     const size_t baseOffset = size_t(bv.byteOffset) + size_t(acc.byteOffset);
-    if (baseOffset + size_t(acc.count) * stride > buf.data.size())
+    if (acc.count > 0 && baseOffset + (size_t(acc.count) - 1u) * stride + elementSize > buf.data.size())
         return false;
 
-    outData.resize(size_t(acc.count) * compCount);
-    const unsigned char* src = buf.data.data() + baseOffset;
-    for (size_t i = 0; i < size_t(acc.count); ++i) {
-        const unsigned char* elem = src + i * stride;
-        for (size_t c = 0; c < compCount; ++c) {
-            outData[i * compCount + c] = ReadComponentAsFloat(elem + c * compSize, acc.componentType, acc.normalized);
+    out.pData = buf.data.data() + baseOffset;
+    out.zStride = stride;
+    out.zCount = size_t(acc.count);
+    out.zComponents = compCount;
+    out.componentType = acc.componentType;
+    out.bNormalized = acc.normalized;
+    return true;
+}
+
+/** One component to float (glTF 2.0 normalization rules); resolved at compile time per kernel. */
+template<typename T, bool bNormalized>
+inline float ConvertComponent(const unsigned char* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    if constexpr (std::is_same_v<T, float> || !bNormalized) {
+        return static_cast<float>(v);
+    } else if constexpr (std::is_signed_v<T>) {
+        return std::max(-1.0f, static_cast<float>(v) / static_cast<float>(std::numeric_limits<T>::max()));
+    } else if constexpr (sizeof(T) == 4u) {
+        return static_cast<float>(static_cast<double>(v) / 4294967295.0);
+    } else {
+        return static_cast<float>(v) / static_cast<float>(std::numeric_limits<T>::max());
+    }
+}
+
+/**
+ * Gather kernel: dst[i * zDstStride + c] = convert(src[pIndices[i]].c) for c < N (pIndices null = identity).
+ * Writes straight into the interleaved destination; one instantiation per (component type, normalized, N),
+ * so the per-component switch of the old path is gone.
+ *  - float: N * 4 byte copy per element (lowered to vector moves).
+ *  - normalized uint16 (quantized UV/normal): SSE2 widen + convert + scale, 4 lanes at once.
+ */
+template<typename T, bool bNormalized, size_t N>
+void GatherElements(const AccessorView& view, const uint32_t* pIndices, size_t zCount, float* pDst, size_t zDstStride) {
+    for (size_t i = 0; i < zCount; ++i) {
+        const size_t zSrc = (pIndices != nullptr) ? size_t(pIndices[i]) : i;
+        const unsigned char* pElem = view.pData + zSrc * view.zStride;
+        float* pOut = pDst + i * zDstStride;
+        if constexpr (std::is_same_v<T, float>) {
+            std::memcpy(pOut, pElem, N * sizeof(float));
+        }
+#if GLTF_DECODE_SSE2
+        else if constexpr (std::is_same_v<T, uint16_t> && bNormalized) {
+            uint64_t uBits = 0u;
+            std::memcpy(&uBits, pElem, N * sizeof(uint16_t));
+            const __m128i v16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&uBits));
+            const __m128i v32 = _mm_unpacklo_epi16(v16, _mm_setzero_si128());
+            const __m128 vF = _mm_mul_ps(_mm_cvtepi32_ps(v32), _mm_set1_ps(1.0f / 65535.0f));
+            alignas(16) float fLanes[4];
+            _mm_store_ps(fLanes, vF);
+            std::memcpy(pOut, fLanes, N * sizeof(float));
+        }
+#endif
+        else {
+            for (size_t c = 0; c < N; ++c)
+                pOut[c] = ConvertComponent<T, bNormalized>(pElem + c * sizeof(T));
         }
     }
-    return true;
 }
 
-bool ReadIndexAccessorAsU32(const tinygltf::Model& model, int accessorIndex, std::vector<uint32_t>& outIndices) {
-    outIndices.clear();
-    if (accessorIndex < 0 || size_t(accessorIndex) >= model.accessors.size())
-        return false;
-    const tinygltf::Accessor& acc = model.accessors[size_t(accessorIndex)];
-    if (acc.type != TINYGLTF_TYPE_SCALAR)
+using GatherFn = void (*)(const AccessorView&, const uint32_t*, size_t, float*, size_t);
+
+/** Pick the kernel once per attribute. Returns nullptr for unsupported component types. */
+template<size_t N>
+GatherFn SelectGatherKernel(int componentType, bool normalized) {
+    switch (componentType) {
+    case TINYGLTF_COMPONENT_TYPE_FLOAT:
+        return &GatherElements<float, false, N>;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        return normalized ? &GatherElements<uint8_t, true, N> : &GatherElements<uint8_t, false, N>;
+    case TINYGLTF_COMPONENT_TYPE_BYTE:
+        return normalized ? &GatherElements<int8_t, true, N> : &GatherElements<int8_t, false, N>;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        return normalized ? &GatherElements<uint16_t, true, N> : &GatherElements<uint16_t, false, N>;
+    case TINYGLTF_COMPONENT_TYPE_SHORT:
+        return normalized ? &GatherElements<int16_t, true, N> : &GatherElements<int16_t, false, N>;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        return normalized ? &GatherElements<uint32_t, true, N> : &GatherElements<uint32_t, false, N>;
+    default:
+        return nullptr;
+    }
+}
+
+/** Decode an N-component attribute at the given source indices into an interleaved float destination. */
+template<size_t N>
+bool GatherAttribute(const AccessorView& view, const uint32_t* pIndices, size_t zCount, float* pDst, size_t zDstStride) {
+    if (view.zComponents != N)
         return false;
-    if (acc.bufferView < 0 || size_t(acc.bufferView) >= model.bufferViews.size())
+    GatherFn pfnGather = SelectGatherKernel<N>(view.componentType, view.bNormalized);
+    if (pfnGather == nullptr)
         return false;
+    pfnGather(view, pIndices, zCount, pDst, zDstStride);
+    return true;
+}
 
-    const tinygltf::BufferView& bv = model.bufferViews[size_t(acc.bufferView)];
-    if (bv.buffer < 0 || size_t(bv.buffer) >= model.buffers.size())
-        return false;
-    const tinygltf::Buffer& buf = model.buffers[size_t(bv.buffer)];
+template<typename T>
+void CopyIndices(const AccessorView& view, std::vector<uint32_t>& outIndices) {
+    for (size_t i = 0; i < view.zCount; ++i) {
+        T v;
+        std::memcpy(&v, view.pData + i * view.zStride, sizeof(T));
+        outIndices[i] = static_cast<uint32_t>(v);
+    }
+}
 
-    const size_t compSize = ComponentSizeBytes(acc.componentType);
-    if (compSize == 0u)
+bool ReadIndexAccessorAsU32(const tinygltf::Model& model, int accessorIndex, std::vector<uint32_t>& outIndices) {
+    outIndices.clear();
+    AccessorView view;
+    if (!GetAccessorView(model, accessorIndex, TINYGLTF_TYPE_SCALAR, view))
         return false;
-    const size_t stride = (bv.byteStride > 0) ? size_t(bv.byteStride) : compSize;
-    const size_t baseOffset = size_t(bv.byteOffset) + size_t(acc.byteOffset);
-    if (baseOffset + size_t(acc.count) * stride > buf.data.size())
+    outIndices.resize(view.zCount);
+    switch (view.componentType) {
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        CopyIndices<uint8_t>(view, outIndices);
+        return true;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        CopyIndices<uint16_t>(view, outIndices);
+        return true;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        if (view.zStride == sizeof(uint32_t))
+            std::memcpy(outIndices.data(), view.pData, view.zCount * sizeof(uint32_t));
+        else
+            CopyIndices<uint32_t>(view, outIndices);
+        return true;
+    default:
+        outIndices.clear();
         return false;
-
-    outIndices.resize(size_t(acc.count));
-    const unsigned char* src = buf.data.data() + baseOffset;
-    for (size_t i = 0; i < size_t(acc.count); ++i) {
-        const unsigned char* p = src + i * stride;
-        switch (acc.componentType) {
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-            outIndices[i] = static_cast<uint32_t>(*reinterpret_cast<const uint8_t*>(p));
-            break;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
-            uint16_t v = 0;
-            std::memcpy(&v, p, sizeof(uint16_t));
-            outIndices[i] = static_cast<uint32_t>(v);
-            break;
-        }
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
-            uint32_t v = 0;
-            std::memcpy(&v, p, sizeof(uint32_t));
-            outIndices[i] = v;
-            break;
-        }
-        default:
-            return false;
-        }
     }
-    return true;
 }
 
 bool BuildTriangleListIndices(const tinygltf::Primitive& prim,
@@ -210,8 +262,11 @@ bool BuildTriangleListIndices(const tinygltf::Primitive& prim,
 } // namespace
 
 bool GetMeshDataFromGltf(const tinygltf::Model& model, int meshIndex, int primitiveIndex,
-                         std::vector<VertexData>& outVertices) {
+                         std::vector<VertexData>& outVertices,
+                         std::vector<Meshlet>* pOutMeshlets) {
     outVertices.clear();
+    if (pOutMeshlets != nullptr)
+        pOutMeshlets->clear();
     if (meshIndex < 0 || size_t(meshIndex) >= model.meshes.size())
         return false;
     const tinygltf::Mesh& mesh = model.meshes[size_t(meshIndex)];
@@ -225,36 +280,32 @@ bool GetMeshDataFromGltf(const tinygltf::Model& model, int meshIndex, int primit
         std::cerr << "[GetMeshDataFromGltf] Missing POSITION attribute.\n";
         return false;
     }
-    std::vector<float> positions;
-    if (!ReadAccessorAsFloatN(model, itPos->second, TINYGLTF_TYPE_VEC3, positions)) {
+    AccessorView posView;
+    if (!GetAccessorView(model, itPos->second, TINYGLTF_TYPE_VEC3, posView)) {
         std::cerr << "[GetMeshDataFromGltf] Failed to read POSITION data.\n";
         return false;
     }
-    const size_t vertexCount = positions.size() / 3u;
+    const size_t vertexCount = posView.zCount;
     if (vertexCount == 0)
         return false;
 
     // TEXCOORD_0 (UV) is optional, default to (0,0)
-    std::vector<float> uvs;
+    AccessorView uvView;
     auto itUV = prim.attributes.find("TEXCOORD_0");
-    if (itUV != prim.attributes.end() && ReadAccessorAsFloatN(model, itUV->second, TINYGLTF_TYPE_VEC2, uvs)) {
-        if (uvs.size() / 2u != vertexCount) {
-            std::cerr << "[GetMeshDataFromGltf] UV count mismatch, ignoring UVs.\n";
-            uvs.clear();
-        }
+    bool hasUVs = (itUV != prim.attributes.end()) && GetAccessorView(model, itUV->second, TINYGLTF_TYPE_VEC2, uvView);
+    if (hasUVs && uvView.zCount != vertexCount) {
+        std::cerr << "[GetMeshDataFromGltf] UV count mismatch, ignoring UVs.\n";
+        hasUVs = false;
     }
-    const bool hasUVs = !uvs.empty();
 
     // NORMAL is optional, default to (0,0,1)
-    std::vector<float> normals;
+    AccessorView normView;
     auto itNorm = prim.attributes.find("NORMAL");
-    if (itNorm != prim.attributes.end() && ReadAccessorAsFloatN(model, itNorm->second, TINYGLTF_TYPE_VEC3, normals)) {
-        if (normals.size() / 3u != vertexCount) {
-            std::cerr << "[GetMeshDataFromGltf] Normal count mismatch, ignoring normals.\n";
-            normals.clear();
-        }
+    bool hasNormals = (itNorm != prim.attributes.end()) && GetAccessorView(model, itNorm->second, TINYGLTF_TYPE_VEC3, normView);
+    if (hasNormals && normView.zCount != vertexCount) {
+        std::cerr << "[GetMeshDataFromGltf] Normal count mismatch, ignoring normals.\n";
+        hasNormals = false;
     }
-    const bool hasNormals = !normals.empty();
 
     // Read source indices (if any)
     std::vector<uint32_t> sourceIndices;
@@ -278,38 +329,69 @@ bool GetMeshDataFromGltf(const tinygltf::Model& model, int meshIndex, int primit
         return false;
     }
 
-    // Build interleaved vertex data
-    outVertices.reserve(indices.size());
-    for (uint32_t idx : indices) {
-        if (idx >= vertexCount) {
-            std::cerr << "[GetMeshDataFromGltf] Index " << idx << " out of range.\n";
+    // Drop whole triangles with out-of-range corners (keeps the stream triangle-aligned for meshlets)
+    size_t kept = 0;
+    for (size_t t = 0; t + 2u < indices.size(); t += 3u) {
+        if (indices[t] >= vertexCount || indices[t + 1u] >= vertexCount || indices[t + 2u] >= vertexCount) {
+            std::cerr << "[GetMeshDataFromGltf] Triangle " << (t / 3u) << " has out-of-range index, skipped.\n";
             continue;
         }
-        VertexData v;
-        v.position[0] = positions[idx * 3 + 0];
-        v.position[1] = positions[idx * 3 + 1];
-        v.position[2] = positions[idx * 3 + 2];
+        indices[kept++] = indices[t];
+        indices[kept++] = indices[t + 1u];
+        indices[kept++] = indices[t + 2u];
+    }
+    indices.resize(kept);
+    if (indices.empty())
+        return false;
 
-        if (hasUVs) {
-            v.uv[0] = uvs[idx * 2 + 0];
-            v.uv[1] = uvs[idx * 2 + 1];
-        } else {
+    // Decode each attribute once per source vertex into interleaved vertices (one pass per attribute over a
+    // buffer the size of the accessor, which stays in cache), then expand through the indices with one 32-byte
+    // copy per corner. Gathering straight into the expanded stream walked the large output once per attribute.
+    constexpr size_t kFloatsPerVertex = sizeof(VertexData) / sizeof(float);
+    std::vector<VertexData> sourceVertices(vertexCount);
+    float* pDst = &sourceVertices[0].position[0];
+    if (!GatherAttribute<3>(posView, nullptr, vertexCount, pDst + offsetof(VertexData, position) / sizeof(float), kFloatsPerVertex)) {
+        std::cerr << "[GetMeshDataFromGltf] Unsupported POSITION component type.\n";
+        return false;
+    }
+    if (hasUVs)
+        hasUVs = GatherAttribute<2>(uvView, nullptr, vertexCount, pDst + offsetof(VertexData, uv) / sizeof(float), kFloatsPerVertex);
+    if (!hasUVs) {
+        for (VertexData& v : sourceVertices) {
             v.uv[0] = 0.f;
             v.uv[1] = 0.f;
         }
-
-        if (hasNormals) {
-            v.normal[0] = normals[idx * 3 + 0];
-            v.normal[1] = normals[idx * 3 + 1];
-            v.normal[2] = normals[idx * 3 + 2];
-        } else {
+    }
+    if (hasNormals)
+        hasNormals = GatherAttribute<3>(normView, nullptr, vertexCount, pDst + offsetof(VertexData, normal) / sizeof(float), kFloatsPerVertex);
+    if (!hasNormals) {
+        for (VertexData& v : sourceVertices) {
             v.normal[0] = 0.f;
             v.normal[1] = 0.f;
             v.normal[2] = 1.f;
         }
+    }
+    outVertices.reserve(indices.size());
+    for (uint32_t idx : indices)
+        outVertices.push_back(sourceVertices[idx]);
 
-        outVertices.push_back(v);
+    // Meshlets cluster by source vertex: use the accessor in place when it is tightly packed float3, else decode once
+    if (pOutMeshlets != nullptr) {
+        const bool packedFloat3 = (posView.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT) &&
+                                  (posView.zStride == 3u * sizeof(float)) &&
+                                  (reinterpret_cast<uintptr_t>(posView.pData) % alignof(float) == 0u);
+        std::vector<float> positions;
+        const float* pPositions = nullptr;
+        if (packedFloat3) {
+            pPositions = reinterpret_cast<const float*>(posView.pData);
+        } else {
+            positions.resize(vertexCount * 3u);
+            GatherAttribute<3>(posView, nullptr, vertexCount, positions.data(), 3u);
+            pPositions = positions.data();
+        }
+        if (!BuildMeshlets(pPositions, vertexCount, indices, *pOutMeshlets))
+            pOutMeshlets->clear();
     }
 
-    return !outVertices.empty();
+    return true;
 }
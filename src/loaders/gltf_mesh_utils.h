@@ -1,5 +1,6 @@
 #pragma once
 
+#include "meshlet_builder.h"
 #include <cstdint>
 #include <vector>
 #include <tiny_gltf.h>
@@ -21,6 +22,11 @@ constexpr uint32_t kVertexStride = sizeof(VertexData);
  * Extract vertex data (position + UV + normal) from a glTF mesh for upload to GPU.
  * Expands indexed primitives to non-indexed (so engine can use vkCmdDraw without index buffer).
  * Returns true and fills outVertices on success. Missing UVs default to (0,0); missing normals default to (0,0,1).
+ * Attributes are decoded once per source vertex by kernels specialised per component type, then expanded through
+ * the indices into outVertices.
+ * Triangles referencing out-of-range vertices are dropped whole.
+ * If pOutMeshlets is non-null, it receives meshlets over the expanded stream (empty if building failed).
  */
 bool GetMeshDataFromGltf(const tinygltf::Model& model, int meshIndex, int primitiveIndex,
-                         std::vector<VertexData>& outVertices);
+                         std::vector<VertexData>& outVertices,
+                         std::vector<Meshlet>* pOutMeshlets = nullptr);
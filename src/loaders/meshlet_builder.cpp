@@ -0,0 +1,167 @@
+/*
+ * Meshlet builder — greedy triangle clustering + bounding sphere / normal cone per cluster.
+ */
+#include "meshlet_builder.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/** Sentinel for "source vertex not yet used by the current meshlet". */
+constexpr uint32_t kNoMeshlet = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Fill bounds and cone of one meshlet from its triangle range [lFirstTri_ic, lFirstTri_ic + lTriCount_ic).
+ * Sphere: AABB center + max vertex distance (cheap, slightly conservative).
+ * Cone: normalized average of unit face normals; cutoff = sin(spread) so the cull test is
+ *   dot(center - cam, axis) >= cutoff * |center - cam| + radius  (all triangles back-facing).
+ */
+void ComputeMeshletBounds(const float* pPositions_ic, const std::vector<uint32_t>& vecIndices_ic,
+                          uint32_t lFirstTri_ic, uint32_t lTriCount_ic, Meshlet& stMeshlet_out) {
+    float fMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float fMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (uint32_t lT = 0u; lT < lTriCount_ic; ++lT) {
+        for (uint32_t lC = 0u; lC < 3u; ++lC) {
+            const float* pP = pPositions_ic + static_cast<size_t>(vecIndices_ic[(lFirstTri_ic + lT) * 3u + lC]) * 3u;
+            for (uint32_t lAxis = 0u; lAxis < 3u; ++lAxis) {
+                fMin[lAxis] = std::min(fMin[lAxis], pP[lAxis]);
+                fMax[lAxis] = std::max(fMax[lAxis], pP[lAxis]);
+            }
+        }
+    }
+    const float fCenter[3] = { (fMin[0] + fMax[0]) * 0.5f, (fMin[1] + fMax[1]) * 0.5f, (fMin[2] + fMax[2]) * 0.5f };
+
+    float fRadiusSq = 0.f;
+    float fAxis[3] = { 0.f, 0.f, 0.f };
+    std::vector<float> vecNormals;
+    vecNormals.reserve(static_cast<size_t>(lTriCount_ic) * 3u);
+    for (uint32_t lT = 0u; lT < lTriCount_ic; ++lT) {
+        const float* pA = pPositions_ic + static_cast<size_t>(vecIndices_ic[(lFirstTri_ic + lT) * 3u + 0u]) * 3u;
+        const float* pB = pPositions_ic + static_cast<size_t>(vecIndices_ic[(lFirstTri_ic + lT) * 3u + 1u]) * 3u;
+        const float* pC = pPositions_ic + static_cast<size_t>(vecIndices_ic[(lFirstTri_ic + lT) * 3u + 2u]) * 3u;
+        const float* pCorners[3] = { pA, pB, pC };
+        for (const float* pP : pCorners) {
+            const float fDx = pP[0] - fCenter[0];
+            const float fDy = pP[1] - fCenter[1];
+            const float fDz = pP[2] - fCenter[2];
+            fRadiusSq = std::max(fRadiusSq, fDx * fDx + fDy * fDy + fDz * fDz);
+        }
+
+        /* Face normal (glTF front faces are CCW). Degenerate triangles do not contribute to the cone. */
+        const float fE1[3] = { pB[0] - pA[0], pB[1] - pA[1], pB[2] - pA[2] };
+        const float fE2[3] = { pC[0] - pA[0], pC[1] - pA[1], pC[2] - pA[2] };
+        float fN[3] = { fE1[1] * fE2[2] - fE1[2] * fE2[1],
+                        fE1[2] * fE2[0] - fE1[0] * fE2[2],
+                        fE1[0] * fE2[1] - fE1[1] * fE2[0] };
+        const float fLen = std::sqrt(fN[0] * fN[0] + fN[1] * fN[1] + fN[2] * fN[2]);
+        if (fLen <= static_cast<float>(1e-12f))
+            continue;
+        fN[0] /= fLen;
+        fN[1] /= fLen;
+        fN[2] /= fLen;
+        fAxis[0] += fN[0];
+        fAxis[1] += fN[1];
+        fAxis[2] += fN[2];
+        vecNormals.insert(vecNormals.end(), { fN[0], fN[1], fN[2] });
+    }
+
+    stMeshlet_out.boundingSphere[0] = fCenter[0];
+    stMeshlet_out.boundingSphere[1] = fCenter[1];
+    stMeshlet_out.boundingSphere[2] = fCenter[2];
+    stMeshlet_out.boundingSphere[3] = std::sqrt(fRadiusSq);
+
+    /* Degenerate cone by default: zero axis + cutoff 1 never passes the back-face test. */
+    stMeshlet_out.coneAxis[0] = 0.f;
+    stMeshlet_out.coneAxis[1] = 0.f;
+    stMeshlet_out.coneAxis[2] = 0.f;
+    stMeshlet_out.coneCutoff = 1.f;
+
+    const float fAxisLen = std::sqrt(fAxis[0] * fAxis[0] + fAxis[1] * fAxis[1] + fAxis[2] * fAxis[2]);
+    if ((vecNormals.empty() == true) || (fAxisLen <= static_cast<float>(1e-6f)))
+        return;
+    fAxis[0] /= fAxisLen;
+    fAxis[1] /= fAxisLen;
+    fAxis[2] /= fAxisLen;
+
+    float fMinDot = 1.f;
+    for (size_t zN = 0u; zN < vecNormals.size(); zN += 3u) {
+        const float fDot = fAxis[0] * vecNormals[zN] + fAxis[1] * vecNormals[zN + 1u] + fAxis[2] * vecNormals[zN + 2u];
+        fMinDot = std::min(fMinDot, fDot);
+    }
+    /* Spread >= 90 degrees: some triangle always faces the camera, keep the cone degenerate. */
+    if (fMinDot <= 0.f)
+        return;
+
+    stMeshlet_out.coneAxis[0] = fAxis[0];
+    stMeshlet_out.coneAxis[1] = fAxis[1];
+    stMeshlet_out.coneAxis[2] = fAxis[2];
+    stMeshlet_out.coneCutoff = std::sqrt(std::max(0.f, 1.f - fMinDot * fMinDot));
+}
+
+} // namespace
+
+bool BuildMeshlets(const float* pPositions_ic, size_t zPositionCount_ic,
+                   const std::vector<uint32_t>& vecIndices_ic,
+                   std::vector<Meshlet>& vecMeshlets_out,
+                   uint32_t lMaxVertices_ic,
+                   uint32_t lMaxTriangles_ic) {
+    vecMeshlets_out.clear();
+    if ((pPositions_ic == nullptr) || (zPositionCount_ic == 0u) || (vecIndices_ic.size() < 3u) || ((vecIndices_ic.size() % 3u) != 0u))
+        return false;
+    if ((lMaxVertices_ic < 3u) || (lMaxTriangles_ic == 0u))
+        return false;
+
+    const uint32_t lTriangleCount = static_cast<uint32_t>(vecIndices_ic.size() / 3u);
+    vecMeshlets_out.reserve(static_cast<size_t>(lTriangleCount / lMaxTriangles_ic) + 1u);
+
+    /* vecStamp[v] == current meshlet ordinal when source vertex v is already counted in it. */
+    std::vector<uint32_t> vecStamp(zPositionCount_ic, kNoMeshlet);
+    uint32_t lMeshletOrdinal = 0u;
+    uint32_t lFirstTri = 0u;
+    uint32_t lTriCount = 0u;
+    uint32_t lUniqueCount = 0u;
+
+    for (uint32_t lT = 0u; lT < lTriangleCount; ++lT) {
+        uint32_t lNewVerts = 0u;
+        for (uint32_t lC = 0u; lC < 3u; ++lC) {
+            const uint32_t lIdx = vecIndices_ic[lT * 3u + lC];
+            if (lIdx >= zPositionCount_ic)
+                return false;
+            if (vecStamp[lIdx] != lMeshletOrdinal)
+                ++lNewVerts;
+        }
+
+        if ((lTriCount > 0u) && ((lUniqueCount + lNewVerts > lMaxVertices_ic) || (lTriCount + 1u > lMaxTriangles_ic))) {
+            Meshlet stMeshlet = {};
+            ComputeMeshletBounds(pPositions_ic, vecIndices_ic, lFirstTri, lTriCount, stMeshlet);
+            stMeshlet.firstVertex = lFirstTri * 3u;
+            stMeshlet.vertexCount = lTriCount * 3u;
+            vecMeshlets_out.push_back(stMeshlet);
+
+            ++lMeshletOrdinal;
+            lFirstTri = lT;
+            lTriCount = 0u;
+            lUniqueCount = 0u;
+        }
+
+        for (uint32_t lC = 0u; lC < 3u; ++lC) {
+            const uint32_t lIdx = vecIndices_ic[lT * 3u + lC];
+            if (vecStamp[lIdx] != lMeshletOrdinal) {
+                vecStamp[lIdx] = lMeshletOrdinal;
+                ++lUniqueCount;
+            }
+        }
+        ++lTriCount;
+    }
+
+    if (lTriCount > 0u) {
+        Meshlet stMeshlet = {};
+        ComputeMeshletBounds(pPositions_ic, vecIndices_ic, lFirstTri, lTriCount, stMeshlet);
+        stMeshlet.firstVertex = lFirstTri * 3u;
+        stMeshlet.vertexCount = lTriCount * 3u;
+        vecMeshlets_out.push_back(stMeshlet);
+    }
+    return true;
+}
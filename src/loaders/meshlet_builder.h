@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Meshlet limits (classic mesh-shader sizes; also keep clusters small enough for useful cone culling).
+ */
+constexpr uint32_t kMeshletMaxVertices  = 64u;
+constexpr uint32_t kMeshletMaxTriangles = 124u;
+
+/**
+ * Meshlet — contiguous triangle range of a non-indexed mesh plus culling bounds (mesh-local space).
+ *
+ * Meshes are expanded to triangle lists (see GetMeshDataFromGltf), so a meshlet is simply
+ * [firstVertex, firstVertex + vertexCount) in the vertex buffer and can be drawn with vkCmdDraw*.
+ * Must match meshlet_cull.comp MeshletData struct (48 bytes).
+ */
+struct Meshlet {
+    float boundingSphere[4];  // xyz = center, w = radius
+    float coneAxis[3];        // Average face normal (zero when the cone is degenerate)
+    float coneCutoff;         // sin(cone half-angle); 1 when degenerate (never culled)
+    uint32_t firstVertex;     // First vertex in the expanded triangle list
+    uint32_t vertexCount;     // Triangle count * 3
+    uint32_t _pad0;
+    uint32_t _pad1;
+};
+static_assert(sizeof(Meshlet) == 48, "Meshlet must be 48 bytes");
+
+/**
+ * Split a triangle list into meshlets (greedy, in index order) and compute bounds + normal cone per meshlet.
+ * A meshlet is closed when adding the next triangle would exceed lMaxVertices_ic unique source vertices or
+ * lMaxTriangles_ic triangles. Triangle order is preserved, so meshlet ranges map 1:1 onto the expanded vertex stream.
+ *
+ * @param pPositions_ic      Source positions (3 floats per source vertex).
+ * @param zPositionCount_ic  Number of source vertices in pPositions_ic.
+ * @param vecIndices_ic      Triangle list indices (size multiple of 3); all must be < zPositionCount_ic.
+ * @param vecMeshlets_out    Filled with meshlets (cleared first).
+ * @return false if input is empty or malformed.
+ */
+bool BuildMeshlets(const float* pPositions_ic, size_t zPositionCount_ic,
+                   const std::vector<uint32_t>& vecIndices_ic,
+                   std::vector<Meshlet>& vecMeshlets_out,
+                   uint32_t lMaxVertices_ic = kMeshletMaxVertices,
+                   uint32_t lMaxTriangles_ic = kMeshletMaxTriangles);
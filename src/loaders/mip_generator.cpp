@@ -0,0 +1,195 @@
+/*
+ * Mip generator — CPU 2x2 box filter for RGBA8 mip chains (sRGB-correct), optionally split over JobQueue workers.
+ */
+#include "mip_generator.h"
+#include "pixel_convert.h"
+#include "thread/job_queue.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MIPGEN_SSE2 1
+#else
+#define MIPGEN_SSE2 0
+#endif
+
+namespace {
+
+/** Destination rows per worker task; smaller levels are filtered on the calling thread. */
+constexpr uint32_t kRowsPerTask = 64u;
+constexpr size_t kMinPixelsForWorkers = 256u * 256u;
+
+/** Rounded average of four RGBA8 pixels, all channels linear (UNORM data). */
+inline void AverageUnorm4(const uint8_t* pA, const uint8_t* pB, const uint8_t* pC, const uint8_t* pD, uint8_t* pOut) {
+    for (uint32_t c = 0u; c < 4u; ++c)
+        pOut[c] = static_cast<uint8_t>((static_cast<uint32_t>(pA[c]) + pB[c] + pC[c] + pD[c] + 2u) >> 2u);
+}
+
+#if MIPGEN_SSE2
+/** Two destination pixels from 4x2 source pixels (UNORM): 16-bit sums, +2, >>2. */
+inline void AverageUnormPairSse2(const uint8_t* pRow0, const uint8_t* pRow1, uint8_t* pOut) {
+    const __m128i vZero = _mm_setzero_si128();
+    __m128i vRow0;
+    __m128i vRow1;
+    std::memcpy(&vRow0, pRow0, 16u);
+    std::memcpy(&vRow1, pRow1, 16u);
+    /* lo = source pixels 0,1 ; hi = source pixels 2,3 (8 x u16 each) */
+    const __m128i vLo = _mm_add_epi16(_mm_unpacklo_epi8(vRow0, vZero), _mm_unpacklo_epi8(vRow1, vZero));
+    const __m128i vHi = _mm_add_epi16(_mm_unpackhi_epi8(vRow0, vZero), _mm_unpackhi_epi8(vRow1, vZero));
+    const __m128i vSum0 = _mm_add_epi16(vLo, _mm_srli_si128(vLo, 8));
+    const __m128i vSum1 = _mm_add_epi16(vHi, _mm_srli_si128(vHi, 8));
+    __m128i vAvg = _mm_unpacklo_epi64(vSum0, vSum1);
+    vAvg = _mm_srli_epi16(_mm_add_epi16(vAvg, _mm_set1_epi16(2)), 2);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(pOut), _mm_packus_epi16(vAvg, vZero));
+}
+#endif
+
+/** One destination row of linear RGBA from two linear source rows: ((A + B) + (C + D)) * 0.25, edges clamped. */
+void AverageLinearRow(const float* pRow0, const float* pRow1, uint32_t lSrcWidth, float* pOut, uint32_t lDstWidth) {
+    for (uint32_t lX = 0u; lX < lDstWidth; ++lX) {
+        const size_t zSx0 = static_cast<size_t>(std::min(lX * 2u, lSrcWidth - 1u)) * 4u;
+        const size_t zSx1 = static_cast<size_t>(std::min(lX * 2u + 1u, lSrcWidth - 1u)) * 4u;
+#if MIPGEN_SSE2
+        const __m128 vTop = _mm_add_ps(_mm_loadu_ps(pRow0 + zSx0), _mm_loadu_ps(pRow0 + zSx1));
+        const __m128 vBottom = _mm_add_ps(_mm_loadu_ps(pRow1 + zSx0), _mm_loadu_ps(pRow1 + zSx1));
+        _mm_storeu_ps(pOut + static_cast<size_t>(lX) * 4u, _mm_mul_ps(_mm_add_ps(vTop, vBottom), _mm_set1_ps(0.25f)));
+#else
+        for (uint32_t c = 0u; c < 4u; ++c)
+            pOut[static_cast<size_t>(lX) * 4u + c] = ((pRow0[zSx0 + c] + pRow0[zSx1 + c]) + (pRow1[zSx0 + c] + pRow1[zSx1 + c])) * 0.25f;
+#endif
+    }
+}
+
+/**
+ * sRGB rows: decode both source rows to linear once, average in float, encode the destination row
+ * (alpha stays linear; see DecodeSrgbRGBA8ToLinear / EncodeLinearToSrgbRGBA8).
+ */
+void DownsampleSrgbRows(const uint8_t* pSrc, uint32_t lSrcWidth, uint32_t lSrcHeight, uint8_t* pDst, uint32_t lDstWidth,
+                        uint32_t lRowBegin, uint32_t lRowEnd) {
+    const size_t zSrcPitch = static_cast<size_t>(lSrcWidth) * 4u;
+    const size_t zDstPitch = static_cast<size_t>(lDstWidth) * 4u;
+    std::vector<float> vecLinear(zSrcPitch * 2u + zDstPitch);
+    float* pLinear0 = vecLinear.data();
+    float* pLinear1 = pLinear0 + zSrcPitch;
+    float* pAverage = pLinear1 + zSrcPitch;
+
+    for (uint32_t lY = lRowBegin; lY < lRowEnd; ++lY) {
+        const uint32_t lSy0 = std::min(lY * 2u, lSrcHeight - 1u);
+        const uint32_t lSy1 = std::min(lY * 2u + 1u, lSrcHeight - 1u);
+        DecodeSrgbRGBA8ToLinear(pSrc + static_cast<size_t>(lSy0) * zSrcPitch, lSrcWidth, pLinear0);
+        /* Odd height: the last destination row reuses the last source row. */
+        const float* pRow1 = pLinear0;
+        if (lSy1 != lSy0) {
+            DecodeSrgbRGBA8ToLinear(pSrc + static_cast<size_t>(lSy1) * zSrcPitch, lSrcWidth, pLinear1);
+            pRow1 = pLinear1;
+        }
+        AverageLinearRow(pLinear0, pRow1, lSrcWidth, pAverage, lDstWidth);
+        EncodeLinearToSrgbRGBA8(pAverage, lDstWidth, pDst + static_cast<size_t>(lY) * zDstPitch);
+    }
+}
+
+} // namespace
+
+uint32_t ComputeMipLevelCount(uint32_t lWidth_ic, uint32_t lHeight_ic) {
+    uint32_t lSize = std::max(lWidth_ic, lHeight_ic);
+    if (lSize == 0u)
+        return 0u;
+    uint32_t lLevels = 1u;
+    while (lSize > 1u) {
+        lSize >>= 1u;
+        ++lLevels;
+    }
+    return lLevels;
+}
+
+void DownsampleRGBA8Rows(const uint8_t* pSrc_ic, uint32_t lSrcWidth_ic, uint32_t lSrcHeight_ic,
+                         uint8_t* pDst_out, uint32_t lDstWidth_ic,
+                         uint32_t lRowBegin_ic, uint32_t lRowEnd_ic, bool bSrgb_ic) {
+    if (bSrgb_ic == true) {
+        DownsampleSrgbRows(pSrc_ic, lSrcWidth_ic, lSrcHeight_ic, pDst_out, lDstWidth_ic, lRowBegin_ic, lRowEnd_ic);
+        return;
+    }
+    const size_t zSrcPitch = static_cast<size_t>(lSrcWidth_ic) * 4u;
+    const size_t zDstPitch = static_cast<size_t>(lDstWidth_ic) * 4u;
+
+    for (uint32_t lY = lRowBegin_ic; lY < lRowEnd_ic; ++lY) {
+        const uint32_t lSy0 = std::min(lY * 2u, lSrcHeight_ic - 1u);
+        const uint32_t lSy1 = std::min(lY * 2u + 1u, lSrcHeight_ic - 1u);
+        const uint8_t* pRow0 = pSrc_ic + static_cast<size_t>(lSy0) * zSrcPitch;
+        const uint8_t* pRow1 = pSrc_ic + static_cast<size_t>(lSy1) * zSrcPitch;
+        uint8_t* pOut = pDst_out + static_cast<size_t>(lY) * zDstPitch;
+
+        uint32_t lX = 0u;
+#if MIPGEN_SSE2
+        /* Interior pairs: source columns 2x .. 2x+3 all in range. */
+        for (; (lX + 1u < lDstWidth_ic) && (lX * 2u + 3u < lSrcWidth_ic); lX += 2u)
+            AverageUnormPairSse2(pRow0 + static_cast<size_t>(lX) * 8u, pRow1 + static_cast<size_t>(lX) * 8u,
+                                 pOut + static_cast<size_t>(lX) * 4u);
+#endif
+        for (; lX < lDstWidth_ic; ++lX) {
+            const size_t zSx0 = static_cast<size_t>(std::min(lX * 2u, lSrcWidth_ic - 1u)) * 4u;
+            const size_t zSx1 = static_cast<size_t>(std::min(lX * 2u + 1u, lSrcWidth_ic - 1u)) * 4u;
+            AverageUnorm4(pRow0 + zSx0, pRow0 + zSx1, pRow1 + zSx0, pRow1 + zSx1, pOut + static_cast<size_t>(lX) * 4u);
+        }
+    }
+}
+
+size_t ComputeMipChainLayout(uint32_t lWidth_ic, uint32_t lHeight_ic, uint32_t lLevelCount_ic, std::vector<MipLevelDesc>& vecLevels_out) {
+    vecLevels_out.clear();
+    if ((lWidth_ic == 0u) || (lHeight_ic == 0u))
+        return 0u;
+    const uint32_t lLevels = std::clamp(lLevelCount_ic, 1u, ComputeMipLevelCount(lWidth_ic, lHeight_ic));
+
+    size_t zTotal = 0u;
+    vecLevels_out.resize(lLevels);
+    for (uint32_t lLevel = 0u; lLevel < lLevels; ++lLevel) {
+        MipLevelDesc& st = vecLevels_out[lLevel];
+        st.lWidth  = std::max(lWidth_ic >> lLevel, 1u);
+        st.lHeight = std::max(lHeight_ic >> lLevel, 1u);
+        st.zOffset = zTotal;
+        st.zSize   = static_cast<size_t>(st.lWidth) * st.lHeight * 4u;
+        zTotal += st.zSize;
+    }
+    return zTotal;
+}
+
+void GenerateMipLevelsRGBA8(uint8_t* pChain_io, const std::vector<MipLevelDesc>& vecLevels_ic, bool bSrgb_ic, JobQueue* pJobQueue_ic) {
+    if (pChain_io == nullptr)
+        return;
+    const bool bUseWorkers = (pJobQueue_ic != nullptr) && (pJobQueue_ic->GetWorkerThreadCount() > 1u);
+    for (size_t lLevel = 1u; lLevel < vecLevels_ic.size(); ++lLevel) {
+        const MipLevelDesc& stSrc = vecLevels_ic[lLevel - 1u];
+        const MipLevelDesc& stDst = vecLevels_ic[lLevel];
+        const uint8_t* pSrc = pChain_io + stSrc.zOffset;
+        uint8_t* pDst = pChain_io + stDst.zOffset;
+
+        const size_t zPixels = static_cast<size_t>(stDst.lWidth) * stDst.lHeight;
+        if ((bUseWorkers == false) || (zPixels < kMinPixelsForWorkers) || (stDst.lHeight <= kRowsPerTask)) {
+            DownsampleRGBA8Rows(pSrc, stSrc.lWidth, stSrc.lHeight, pDst, stDst.lWidth, 0u, stDst.lHeight, bSrgb_ic);
+            continue;
+        }
+        /* Bands after the first go to workers; the calling thread filters the first band, then helps. */
+        pJobQueue_ic->GetScheduler().ParallelFor(stDst.lHeight, kRowsPerTask, [&](uint32_t lRowBegin, uint32_t lRowEnd) {
+            DownsampleRGBA8Rows(pSrc, stSrc.lWidth, stSrc.lHeight, pDst, stDst.lWidth, lRowBegin, lRowEnd, bSrgb_ic);
+        });
+    }
+}
+
+bool BuildMipChainRGBA8(const uint8_t* pBase_ic, uint32_t lWidth_ic, uint32_t lHeight_ic, uint32_t lLevelCount_ic,
+                        bool bSrgb_ic, std::vector<uint8_t>& vecChain_out, std::vector<MipLevelDesc>& vecLevels_out,
+                        JobQueue* pJobQueue_ic) {
+    vecChain_out.clear();
+    const size_t zTotal = ComputeMipChainLayout(lWidth_ic, lHeight_ic, lLevelCount_ic, vecLevels_out);
+    if ((pBase_ic == nullptr) || (zTotal == 0u)) {
+        vecLevels_out.clear();
+        return false;
+    }
+    vecChain_out.resize(zTotal);
+    std::memcpy(vecChain_out.data(), pBase_ic, vecLevels_out[0].zSize);
+    GenerateMipLevelsRGBA8(vecChain_out.data(), vecLevels_out, bSrgb_ic, pJobQueue_ic);
+    return true;
+}
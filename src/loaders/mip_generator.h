@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobQueue;
+
+/**
+ * One level of a tightly packed mip chain (level 0 first, each level directly after the previous one).
+ * Matches the layout expected by one VkBufferImageCopy per level. Also used for block-compressed chains.
+ */
+struct MipLevelDesc {
+    uint32_t lWidth  = 0u;
+    uint32_t lHeight = 0u;
+    size_t   zOffset = 0u;  // Byte offset of the level in the chain
+    size_t   zSize   = 0u;  // RGBA8: lWidth * lHeight * 4; BC: whole 4x4 blocks
+};
+
+/** Full chain length down to 1x1: floor(log2(max(w, h))) + 1. Returns 0 for an empty image. */
+uint32_t ComputeMipLevelCount(uint32_t lWidth_ic, uint32_t lHeight_ic);
+
+/**
+ * Downsample rows [lRowBegin_ic, lRowEnd_ic) of one destination level with a 2x2 box filter.
+ * Destination size is max(1, src / 2) per axis; odd source edges clamp (last row/column is reused).
+ * bSrgb_ic: RGB is averaged in linear space (alpha always linear), as vkCmdBlitImage does for _SRGB formats.
+ * Rows of one level are independent, so disjoint row ranges may run on different threads.
+ */
+void DownsampleRGBA8Rows(const uint8_t* pSrc_ic, uint32_t lSrcWidth_ic, uint32_t lSrcHeight_ic,
+                         uint8_t* pDst_out, uint32_t lDstWidth_ic,
+                         uint32_t lRowBegin_ic, uint32_t lRowEnd_ic, bool bSrgb_ic);
+
+/**
+ * Tightly packed RGBA8 layout of lLevelCount_ic levels (clamped to [1, ComputeMipLevelCount]).
+ * Returns the chain size in bytes; 0 (and no levels) for an empty image.
+ */
+size_t ComputeMipChainLayout(uint32_t lWidth_ic, uint32_t lHeight_ic, uint32_t lLevelCount_ic, std::vector<MipLevelDesc>& vecLevels_out);
+
+/**
+ * Filter levels 1..n of a chain laid out by ComputeMipChainLayout whose level 0 is already written
+ * (e.g. expanded straight into the chain). Same filtering and pJobQueue_ic rules as BuildMipChainRGBA8.
+ */
+void GenerateMipLevelsRGBA8(uint8_t* pChain_io, const std::vector<MipLevelDesc>& vecLevels_ic, bool bSrgb_ic,
+                            JobQueue* pJobQueue_ic = nullptr);
+
+/**
+ * CPU mip chain for an RGBA8 image (fallback when the format cannot be blitted with linear filtering,
+ * or when mip generation is configured to run on the CPU).
+ *
+ * @param pBase_ic         Level 0 pixels (lWidth_ic * lHeight_ic * 4 bytes); copied to the start of vecChain_out.
+ * @param lLevelCount_ic   Levels to produce (clamped to ComputeMipLevelCount); 1 = copy only.
+ * @param pJobQueue_ic     Optional: large levels are split into row bands and filtered on JobQueue workers
+ *                         (waits for each level before starting the next). Null = calling thread only.
+ *                         Must not be called from a JobQueue worker when non-null.
+ * @return false if the input is empty.
+ */
+bool BuildMipChainRGBA8(const uint8_t* pBase_ic, uint32_t lWidth_ic, uint32_t lHeight_ic, uint32_t lLevelCount_ic,
+                        bool bSrgb_ic, std::vector<uint8_t>& vecChain_out, std::vector<MipLevelDesc>& vecLevels_out,
+                        JobQueue* pJobQueue_ic = nullptr);
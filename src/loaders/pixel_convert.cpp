@@ -0,0 +1,304 @@
+/*
+ * Pixel conversion kernels — RGBA8 expansion and sRGB <-> linear for texture cooking and CPU mips.
+ */
+#include "pixel_convert.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+/* PIXCONV_FORCE_SCALAR: build only the scalar code (tests compare it with the SIMD build). */
+#if defined(PIXCONV_FORCE_SCALAR)
+#define PIXCONV_SSE2 0
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PIXCONV_SSE2 1
+#else
+#define PIXCONV_SSE2 0
+#endif
+
+/* pshufb for RGB -> RGBA; not in the x86-64 baseline, so only when the build targets it. */
+#if PIXCONV_SSE2 && (defined(__SSSE3__) || defined(__AVX__))
+#include <tmmintrin.h>
+#define PIXCONV_SSSE3 1
+#else
+#define PIXCONV_SSSE3 0
+#endif
+
+#if (PIXCONV_SSE2 == 0) && (defined(__aarch64__) || defined(_M_ARM64)) && (defined(PIXCONV_FORCE_SCALAR) == 0)
+#include <arm_neon.h>
+#define PIXCONV_NEON 1
+#else
+#define PIXCONV_NEON 0
+#endif
+
+namespace {
+
+/** Linear -> sRGB table resolution (linear value quantized to 1/4095 before encoding). */
+constexpr uint32_t kLinearToSrgbSize = 4096u;
+constexpr float kSrgbIndexScale = static_cast<float>(kLinearToSrgbSize - 1u);
+
+float SrgbToLinear(float fC) {
+    return (fC <= 0.04045f) ? (fC / 12.92f) : std::pow((fC + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToSrgb(float fL) {
+    return (fL <= 0.0031308f) ? (fL * 12.92f) : (1.055f * std::pow(fL, 1.0f / 2.4f) - 0.055f);
+}
+
+struct SrgbTables {
+    float   fDecode[256];
+    float   fAlpha[256];
+    uint8_t uEncode[kLinearToSrgbSize];
+
+    SrgbTables() {
+        constexpr float kInv255 = 1.0f / 255.0f;
+        for (uint32_t i = 0u; i < 256u; ++i) {
+            fDecode[i] = SrgbToLinear(static_cast<float>(i) / 255.0f);
+            fAlpha[i] = static_cast<float>(i) * kInv255;
+        }
+        for (uint32_t i = 0u; i < kLinearToSrgbSize; ++i) {
+            const float fS = LinearToSrgb(static_cast<float>(i) / kSrgbIndexScale);
+            uEncode[i] = static_cast<uint8_t>(std::clamp(fS * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+    }
+};
+
+const SrgbTables& GetSrgbTables() {
+    static const SrgbTables s_tables;
+    return s_tables;
+}
+
+/** Clamp to [0, 1] (NaN -> 0, like maxps), scale and round: table index for RGB, byte for alpha. */
+inline uint32_t QuantizeUnit(float fValue, float fScale) {
+    const float fClamped = (fValue > 0.0f) ? std::min(fValue, 1.0f) : 0.0f;
+    return static_cast<uint32_t>(fClamped * fScale + 0.5f);
+}
+
+/* ---- Scalar expansion (reference; also the tails of the SIMD loops) ---- */
+
+void ExpandGreyScalar(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    for (size_t i = 0; i < zPixels; ++i, pDst += 4) {
+        pDst[0] = pSrc[i]; pDst[1] = pSrc[i]; pDst[2] = pSrc[i]; pDst[3] = 255;
+    }
+}
+
+void ExpandGreyAlphaScalar(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    for (size_t i = 0; i < zPixels; ++i, pSrc += 2, pDst += 4) {
+        pDst[0] = pSrc[0]; pDst[1] = pSrc[0]; pDst[2] = pSrc[0]; pDst[3] = pSrc[1];
+    }
+}
+
+void ExpandRGBScalar(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        /* One 4-byte load per pixel (the 4th byte belongs to the next pixel, so not for the last one). */
+        for (; i + 1u < zPixels; ++i, pSrc += 3, pDst += 4) {
+            uint32_t uPixel;
+            std::memcpy(&uPixel, pSrc, 4u);
+            uPixel |= 0xFF000000u;
+            std::memcpy(pDst, &uPixel, 4u);
+        }
+    }
+    for (; i < zPixels; ++i, pSrc += 3, pDst += 4) {
+        pDst[0] = pSrc[0]; pDst[1] = pSrc[1]; pDst[2] = pSrc[2]; pDst[3] = 255;
+    }
+}
+
+/* ---- SIMD expansion: 16 (grey, RGB) or 8 (grey+alpha) pixels per iteration ---- */
+
+#if PIXCONV_SSE2
+size_t ExpandGreySse2(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    const __m128i vAlpha = _mm_set1_epi8(static_cast<char>(0xFF));
+    size_t i = 0;
+    for (; i + 16u <= zPixels; i += 16u) {
+        const __m128i vGrey = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+        /* (g, g) and (g, 255) byte pairs, interleaved as 16-bit lanes -> (g, g, g, 255) */
+        const __m128i vGGLo = _mm_unpacklo_epi8(vGrey, vGrey);
+        const __m128i vGGHi = _mm_unpackhi_epi8(vGrey, vGrey);
+        const __m128i vGALo = _mm_unpacklo_epi8(vGrey, vAlpha);
+        const __m128i vGAHi = _mm_unpackhi_epi8(vGrey, vAlpha);
+        __m128i* pOut = reinterpret_cast<__m128i*>(pDst + i * 4u);
+        _mm_storeu_si128(pOut + 0, _mm_unpacklo_epi16(vGGLo, vGALo));
+        _mm_storeu_si128(pOut + 1, _mm_unpackhi_epi16(vGGLo, vGALo));
+        _mm_storeu_si128(pOut + 2, _mm_unpacklo_epi16(vGGHi, vGAHi));
+        _mm_storeu_si128(pOut + 3, _mm_unpackhi_epi16(vGGHi, vGAHi));
+    }
+    return i;
+}
+
+size_t ExpandGreyAlphaSse2(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    const __m128i vLowByte = _mm_set1_epi16(0x00FF);
+    size_t i = 0;
+    for (; i + 8u <= zPixels; i += 8u) {
+        const __m128i vGA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i * 2u));
+        const __m128i vG = _mm_and_si128(vGA, vLowByte);
+        const __m128i vGG = _mm_or_si128(vG, _mm_slli_epi16(vG, 8));
+        __m128i* pOut = reinterpret_cast<__m128i*>(pDst + i * 4u);
+        _mm_storeu_si128(pOut + 0, _mm_unpacklo_epi16(vGG, vGA));
+        _mm_storeu_si128(pOut + 1, _mm_unpackhi_epi16(vGG, vGA));
+    }
+    return i;
+}
+#endif
+
+#if PIXCONV_SSSE3
+size_t ExpandRGBSsse3(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    /* 12 source bytes -> 4 pixels; the alpha lanes are zeroed by the shuffle (0x80) and set by the OR. */
+    const __m128i vShuffle = _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128);
+    const __m128i vAlpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    size_t i = 0;
+    for (; i + 16u <= zPixels; i += 16u) {
+        const __m128i* pIn = reinterpret_cast<const __m128i*>(pSrc + i * 3u);
+        const __m128i v0 = _mm_loadu_si128(pIn + 0);
+        const __m128i v1 = _mm_loadu_si128(pIn + 1);
+        const __m128i v2 = _mm_loadu_si128(pIn + 2);
+        __m128i* pOut = reinterpret_cast<__m128i*>(pDst + i * 4u);
+        _mm_storeu_si128(pOut + 0, _mm_or_si128(_mm_shuffle_epi8(v0, vShuffle), vAlpha));
+        _mm_storeu_si128(pOut + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(v1, v0, 12), vShuffle), vAlpha));
+        _mm_storeu_si128(pOut + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(v2, v1, 8), vShuffle), vAlpha));
+        _mm_storeu_si128(pOut + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(v2, 4), vShuffle), vAlpha));
+    }
+    return i;
+}
+#endif
+
+#if PIXCONV_NEON
+size_t ExpandGreyNeon(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    const uint8x16_t vAlpha = vdupq_n_u8(255);
+    size_t i = 0;
+    for (; i + 16u <= zPixels; i += 16u) {
+        const uint8x16_t vGrey = vld1q_u8(pSrc + i);
+        vst4q_u8(pDst + i * 4u, uint8x16x4_t{ { vGrey, vGrey, vGrey, vAlpha } });
+    }
+    return i;
+}
+
+size_t ExpandGreyAlphaNeon(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    size_t i = 0;
+    for (; i + 16u <= zPixels; i += 16u) {
+        const uint8x16x2_t vGA = vld2q_u8(pSrc + i * 2u);
+        vst4q_u8(pDst + i * 4u, uint8x16x4_t{ { vGA.val[0], vGA.val[0], vGA.val[0], vGA.val[1] } });
+    }
+    return i;
+}
+
+size_t ExpandRGBNeon(const uint8_t* pSrc, size_t zPixels, uint8_t* pDst) {
+    const uint8x16_t vAlpha = vdupq_n_u8(255);
+    size_t i = 0;
+    for (; i + 16u <= zPixels; i += 16u) {
+        const uint8x16x3_t vRGB = vld3q_u8(pSrc + i * 3u);
+        vst4q_u8(pDst + i * 4u, uint8x16x4_t{ { vRGB.val[0], vRGB.val[1], vRGB.val[2], vAlpha } });
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+const char* GetPixelConvertPath() {
+#if PIXCONV_SSSE3
+    return "SSSE3";
+#elif PIXCONV_SSE2
+    return "SSE2";
+#elif PIXCONV_NEON
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+void ExpandToRGBA8(const uint8_t* pSrc_ic, size_t zPixels_ic, uint32_t lChannels_ic, uint8_t* pDst_out) {
+    if ((pSrc_ic == nullptr) || (pDst_out == nullptr) || (zPixels_ic == 0u))
+        return;
+    size_t zDone = 0u;
+    switch (lChannels_ic) {
+    case 1u:
+#if PIXCONV_SSE2
+        zDone = ExpandGreySse2(pSrc_ic, zPixels_ic, pDst_out);
+#elif PIXCONV_NEON
+        zDone = ExpandGreyNeon(pSrc_ic, zPixels_ic, pDst_out);
+#endif
+        ExpandGreyScalar(pSrc_ic + zDone, zPixels_ic - zDone, pDst_out + zDone * 4u);
+        break;
+    case 2u:
+#if PIXCONV_SSE2
+        zDone = ExpandGreyAlphaSse2(pSrc_ic, zPixels_ic, pDst_out);
+#elif PIXCONV_NEON
+        zDone = ExpandGreyAlphaNeon(pSrc_ic, zPixels_ic, pDst_out);
+#endif
+        ExpandGreyAlphaScalar(pSrc_ic + zDone * 2u, zPixels_ic - zDone, pDst_out + zDone * 4u);
+        break;
+    case 3u:
+#if PIXCONV_SSSE3
+        zDone = ExpandRGBSsse3(pSrc_ic, zPixels_ic, pDst_out);
+#elif PIXCONV_NEON
+        zDone = ExpandRGBNeon(pSrc_ic, zPixels_ic, pDst_out);
+#endif
+        ExpandRGBScalar(pSrc_ic + zDone * 3u, zPixels_ic - zDone, pDst_out + zDone * 4u);
+        break;
+    case 4u:
+        std::memcpy(pDst_out, pSrc_ic, zPixels_ic * 4u);
+        break;
+    default:
+        break;
+    }
+}
+
+void DecodeSrgbRGBA8ToLinear(const uint8_t* pSrc_ic, size_t zPixels_ic, float* pDst_out) {
+    /* Table lookups (no gather below AVX2); the float stores are what the row kernels consume. */
+    const SrgbTables& st = GetSrgbTables();
+    for (size_t i = 0; i < zPixels_ic; ++i, pSrc_ic += 4, pDst_out += 4) {
+        pDst_out[0] = st.fDecode[pSrc_ic[0]];
+        pDst_out[1] = st.fDecode[pSrc_ic[1]];
+        pDst_out[2] = st.fDecode[pSrc_ic[2]];
+        pDst_out[3] = st.fAlpha[pSrc_ic[3]];
+    }
+}
+
+void EncodeLinearToSrgbRGBA8(const float* pSrc_ic, size_t zPixels_ic, uint8_t* pDst_out) {
+    const SrgbTables& st = GetSrgbTables();
+    size_t i = 0;
+#if PIXCONV_SSE2
+    /* Clamp, scale ((4095, 4095, 4095, 255)) and round four channels at once; RGB then indexes the table. */
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    const __m128 vHalf = _mm_set1_ps(0.5f);
+    const __m128 vScale = _mm_setr_ps(kSrgbIndexScale, kSrgbIndexScale, kSrgbIndexScale, 255.0f);
+    for (; i < zPixels_ic; ++i) {
+        const __m128 vClamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSrc_ic + i * 4u), vZero), vOne);
+        alignas(16) int32_t iIdx[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(iIdx), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(vClamped, vScale), vHalf)));
+        uint8_t* pOut = pDst_out + i * 4u;
+        pOut[0] = st.uEncode[iIdx[0]];
+        pOut[1] = st.uEncode[iIdx[1]];
+        pOut[2] = st.uEncode[iIdx[2]];
+        pOut[3] = static_cast<uint8_t>(iIdx[3]);
+    }
+#elif PIXCONV_NEON
+    const float32x4_t vZero = vdupq_n_f32(0.0f);
+    const float32x4_t vOne = vdupq_n_f32(1.0f);
+    const float32x4_t vHalf = vdupq_n_f32(0.5f);
+    const float fScale[4] = { kSrgbIndexScale, kSrgbIndexScale, kSrgbIndexScale, 255.0f };
+    const float32x4_t vScale = vld1q_f32(fScale);
+    for (; i < zPixels_ic; ++i) {
+        /* vmaxnmq: NaN -> 0, like the scalar path. */
+        const float32x4_t vClamped = vminq_f32(vmaxnmq_f32(vld1q_f32(pSrc_ic + i * 4u), vZero), vOne);
+        uint32_t lIdx[4];
+        vst1q_u32(lIdx, vcvtq_u32_f32(vaddq_f32(vmulq_f32(vClamped, vScale), vHalf)));
+        uint8_t* pOut = pDst_out + i * 4u;
+        pOut[0] = st.uEncode[lIdx[0]];
+        pOut[1] = st.uEncode[lIdx[1]];
+        pOut[2] = st.uEncode[lIdx[2]];
+        pOut[3] = static_cast<uint8_t>(lIdx[3]);
+    }
+#endif
+    for (; i < zPixels_ic; ++i) {
+        const float* pIn = pSrc_ic + i * 4u;
+        uint8_t* pOut = pDst_out + i * 4u;
+        pOut[0] = st.uEncode[QuantizeUnit(pIn[0], kSrgbIndexScale)];
+        pOut[1] = st.uEncode[QuantizeUnit(pIn[1], kSrgbIndexScale)];
+        pOut[2] = st.uEncode[QuantizeUnit(pIn[2], kSrgbIndexScale)];
+        pOut[3] = static_cast<uint8_t>(QuantizeUnit(pIn[3], 255.0f));
+    }
+}
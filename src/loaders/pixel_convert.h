@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Pixel conversion kernels for texture ingestion (channel expansion, sRGB <-> linear).
+ *
+ * SIMD paths are picked at compile time (SSE2 / SSSE3 / NEON, scalar otherwise) and produce exactly the same
+ * bytes as the scalar code, so cooked output does not depend on the build. Destinations are written front to
+ * back and never read, so they may point into mapped (write-combined) staging memory.
+ */
+
+/** SIMD path compiled in: "SSSE3", "SSE2", "NEON" or "scalar" (build define PIXCONV_FORCE_SCALAR). */
+const char* GetPixelConvertPath();
+
+/**
+ * Expand zPixels_ic pixels of lChannels_ic 8-bit channels (1-4) to RGBA8.
+ * 1: grey -> (g, g, g, 255); 2: grey+alpha -> (g, g, g, a); 3: RGB -> (r, g, b, 255); 4: copied.
+ * pSrc_ic and pDst_out must not overlap.
+ */
+void ExpandToRGBA8(const uint8_t* pSrc_ic, size_t zPixels_ic, uint32_t lChannels_ic, uint8_t* pDst_out);
+
+/** sRGB RGBA8 -> linear float RGBA (RGB through the sRGB curve, alpha / 255). pDst_out holds zPixels_ic * 4 floats. */
+void DecodeSrgbRGBA8ToLinear(const uint8_t* pSrc_ic, size_t zPixels_ic, float* pDst_out);
+
+/**
+ * Linear float RGBA -> sRGB RGBA8 (inverse of DecodeSrgbRGBA8ToLinear; values clamped to [0, 1]).
+ * RGB is encoded through a 4096-entry table (linear quantized to 1/4095), alpha rounded to nearest.
+ */
+void EncodeLinearToSrgbRGBA8(const float* pSrc_ic, size_t zPixels_ic, uint8_t* pDst_out);
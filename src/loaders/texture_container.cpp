@@ -0,0 +1,239 @@
+/*
+ * Texture containers — DDS / KTX2 parsing into GpuTextureData (RGBA8 and BC1/BC3/BC4/BC5/BC7, 2D, one layer).
+ */
+#include "texture_container.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kDdsMagic       = 0x20534444u;  // "DDS "
+constexpr size_t   kDdsHeaderSize  = 124u;
+constexpr size_t   kDdsDx10Size    = 20u;
+constexpr uint32_t kDdpfFourCC     = 0x4u;
+constexpr uint32_t kDdsCaps2Cubemap = 0x200u;
+
+constexpr uint8_t  kKtx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+constexpr size_t   kKtx2HeaderSize = 80u;  // Identifier + header + index, level index follows
+
+/* DXGI_FORMAT values used by DX10 DDS headers. */
+constexpr uint32_t kDxgiR8G8B8A8Unorm     = 28u;
+constexpr uint32_t kDxgiR8G8B8A8UnormSrgb = 29u;
+constexpr uint32_t kDxgiBC1Unorm          = 71u;
+constexpr uint32_t kDxgiBC1UnormSrgb      = 72u;
+constexpr uint32_t kDxgiBC3Unorm          = 77u;
+constexpr uint32_t kDxgiBC3UnormSrgb      = 78u;
+constexpr uint32_t kDxgiBC4Unorm          = 80u;
+constexpr uint32_t kDxgiBC5Unorm          = 83u;
+constexpr uint32_t kDxgiBC7Unorm          = 98u;
+constexpr uint32_t kDxgiBC7UnormSrgb      = 99u;
+
+constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<uint8_t>(a)) | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8u) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16u) | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24u);
+}
+
+uint32_t ReadU32(const uint8_t* p) {
+    uint32_t u = 0u;
+    std::memcpy(&u, p, sizeof(u));
+    return u;
+}
+
+uint64_t ReadU64(const uint8_t* p) {
+    uint64_t u = 0u;
+    std::memcpy(&u, p, sizeof(u));
+    return u;
+}
+
+VkFormat FormatFromDxgi(uint32_t uDxgi) {
+    switch (uDxgi) {
+    case kDxgiR8G8B8A8Unorm:     return VK_FORMAT_R8G8B8A8_UNORM;
+    case kDxgiR8G8B8A8UnormSrgb: return VK_FORMAT_R8G8B8A8_SRGB;
+    case kDxgiBC1Unorm:          return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    case kDxgiBC1UnormSrgb:      return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+    case kDxgiBC3Unorm:          return VK_FORMAT_BC3_UNORM_BLOCK;
+    case kDxgiBC3UnormSrgb:      return VK_FORMAT_BC3_SRGB_BLOCK;
+    case kDxgiBC4Unorm:          return VK_FORMAT_BC4_UNORM_BLOCK;
+    case kDxgiBC5Unorm:          return VK_FORMAT_BC5_UNORM_BLOCK;
+    case kDxgiBC7Unorm:          return VK_FORMAT_BC7_UNORM_BLOCK;
+    case kDxgiBC7UnormSrgb:      return VK_FORMAT_BC7_SRGB_BLOCK;
+    default:                     return VK_FORMAT_UNDEFINED;
+    }
+}
+
+VkFormat FormatFromFourCC(uint32_t uFourCC) {
+    if (uFourCC == MakeFourCC('D', 'X', 'T', '1')) return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+    if (uFourCC == MakeFourCC('D', 'X', 'T', '5')) return VK_FORMAT_BC3_UNORM_BLOCK;
+    if (uFourCC == MakeFourCC('A', 'T', 'I', '1') || uFourCC == MakeFourCC('B', 'C', '4', 'U')) return VK_FORMAT_BC4_UNORM_BLOCK;
+    if (uFourCC == MakeFourCC('A', 'T', 'I', '2') || uFourCC == MakeFourCC('B', 'C', '5', 'U')) return VK_FORMAT_BC5_UNORM_BLOCK;
+    return VK_FORMAT_UNDEFINED;
+}
+
+/** Lay out lLevels levels of eFormat back to back starting at zBase; false if they do not fit in zSize. */
+bool BuildPackedLevels(VkFormat eFormat, uint32_t lWidth, uint32_t lHeight, uint32_t lLevels, size_t zBase, size_t zSize,
+                       std::vector<MipLevelDesc>& vecLevels) {
+    size_t zOffset = zBase;
+    for (uint32_t lLevel = 0u; lLevel < lLevels; ++lLevel) {
+        MipLevelDesc st;
+        st.lWidth  = std::max(lWidth >> lLevel, 1u);
+        st.lHeight = std::max(lHeight >> lLevel, 1u);
+        st.zOffset = zOffset;
+        st.zSize   = GetTextureLevelSize(eFormat, st.lWidth, st.lHeight);
+        if ((st.zSize == 0u) || (zOffset + st.zSize > zSize))
+            return false;
+        zOffset += st.zSize;
+        vecLevels.push_back(st);
+    }
+    return true;
+}
+
+bool ParseDds(const uint8_t* pData, size_t zSize, GpuTextureData& stOut) {
+    if (zSize < 4u + kDdsHeaderSize || ReadU32(pData) != kDdsMagic)
+        return false;
+    const uint8_t* pHeader = pData + 4u;
+    if (ReadU32(pHeader) != kDdsHeaderSize)
+        return false;
+    const uint32_t lHeight = ReadU32(pHeader + 8u);
+    const uint32_t lWidth = ReadU32(pHeader + 12u);
+    const uint32_t lDepth = ReadU32(pHeader + 20u);
+    const uint32_t lMipCount = std::max(ReadU32(pHeader + 24u), 1u);
+    const uint32_t uPfFlags = ReadU32(pHeader + 76u);
+    const uint32_t uFourCC = ReadU32(pHeader + 80u);
+    const uint32_t uCaps2 = ReadU32(pHeader + 108u);
+    if ((uCaps2 & kDdsCaps2Cubemap) != 0u || lDepth > 1u)
+        return false;
+
+    size_t zDataOffset = 4u + kDdsHeaderSize;
+    VkFormat eFormat = VK_FORMAT_UNDEFINED;
+    if ((uPfFlags & kDdpfFourCC) != 0u && uFourCC == MakeFourCC('D', 'X', '1', '0')) {
+        if (zSize < zDataOffset + kDdsDx10Size)
+            return false;
+        const uint8_t* pDx10 = pData + zDataOffset;
+        const uint32_t lArraySize = ReadU32(pDx10 + 12u);
+        if (lArraySize > 1u)
+            return false;
+        eFormat = FormatFromDxgi(ReadU32(pDx10));
+        zDataOffset += kDdsDx10Size;
+    } else if ((uPfFlags & kDdpfFourCC) != 0u) {
+        eFormat = FormatFromFourCC(uFourCC);
+    }
+    if (eFormat == VK_FORMAT_UNDEFINED || lWidth == 0u || lHeight == 0u)
+        return false;
+
+    std::vector<MipLevelDesc> vecLevels;
+    const uint32_t lLevels = std::min(lMipCount, ComputeMipLevelCount(lWidth, lHeight));
+    if (BuildPackedLevels(eFormat, lWidth, lHeight, lLevels, 0u, zSize - zDataOffset, vecLevels) == false)
+        return false;
+    stOut.eFormat = eFormat;
+    stOut.lWidth = lWidth;
+    stOut.lHeight = lHeight;
+    stOut.vecLevels = std::move(vecLevels);
+    const size_t zPayload = stOut.vecLevels.back().zOffset + stOut.vecLevels.back().zSize;
+    stOut.vecData.assign(pData + zDataOffset, pData + zDataOffset + zPayload);
+    return true;
+}
+
+bool ParseKtx2(const uint8_t* pData, size_t zSize, GpuTextureData& stOut) {
+    if (zSize < kKtx2HeaderSize || std::memcmp(pData, kKtx2Identifier, sizeof(kKtx2Identifier)) != 0)
+        return false;
+    const VkFormat eFormat = static_cast<VkFormat>(ReadU32(pData + 12u));
+    const uint32_t lWidth = ReadU32(pData + 20u);
+    const uint32_t lHeight = ReadU32(pData + 24u);
+    const uint32_t lDepth = ReadU32(pData + 28u);
+    const uint32_t lLayers = ReadU32(pData + 32u);
+    const uint32_t lFaces = ReadU32(pData + 36u);
+    const uint32_t lLevelCount = std::max(ReadU32(pData + 40u), 1u);
+    const uint32_t uSupercompression = ReadU32(pData + 44u);
+    if (lWidth == 0u || lHeight == 0u || lDepth > 1u || lLayers > 1u || lFaces != 1u || uSupercompression != 0u)
+        return false;
+    if (GetTextureLevelSize(eFormat, 1u, 1u) == 0u)
+        return false;
+    const size_t zIndexEnd = kKtx2HeaderSize + static_cast<size_t>(lLevelCount) * 24u;
+    if (zSize < zIndexEnd)
+        return false;
+
+    // KTX2 stores levels in any order (usually smallest first); repack them level 0 first
+    const uint32_t lLevels = std::min(lLevelCount, ComputeMipLevelCount(lWidth, lHeight));
+    std::vector<MipLevelDesc> vecLevels;
+    if (BuildPackedLevels(eFormat, lWidth, lHeight, lLevels, 0u, SIZE_MAX, vecLevels) == false)
+        return false;
+    std::vector<uint8_t> vecData(vecLevels.back().zOffset + vecLevels.back().zSize);
+    for (uint32_t lLevel = 0u; lLevel < lLevels; ++lLevel) {
+        const uint8_t* pEntry = pData + kKtx2HeaderSize + static_cast<size_t>(lLevel) * 24u;
+        const uint64_t uOffset = ReadU64(pEntry);
+        const uint64_t uLength = ReadU64(pEntry + 8u);
+        const MipLevelDesc& st = vecLevels[lLevel];
+        if (uLength != st.zSize || uOffset > zSize || uLength > zSize - uOffset)
+            return false;
+        std::memcpy(vecData.data() + st.zOffset, pData + uOffset, st.zSize);
+    }
+    stOut.eFormat = eFormat;
+    stOut.lWidth = lWidth;
+    stOut.lHeight = lHeight;
+    stOut.vecLevels = std::move(vecLevels);
+    stOut.vecData = std::move(vecData);
+    return true;
+}
+
+} // namespace
+
+bool IsBlockCompressedFormat(VkFormat eFormat_ic) {
+    BCFormat eBC = BCFormat::BC1;
+    return GetBCFormat(eFormat_ic, eBC);
+}
+
+bool GetBCFormat(VkFormat eFormat_ic, BCFormat& eBC_out) {
+    switch (eFormat_ic) {
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        eBC_out = BCFormat::BC1;
+        return true;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+        eBC_out = BCFormat::BC3;
+        return true;
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+        eBC_out = BCFormat::BC4;
+        return true;
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+        eBC_out = BCFormat::BC5;
+        return true;
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+        eBC_out = BCFormat::BC7;
+        return true;
+    default:
+        return false;
+    }
+}
+
+size_t GetTextureLevelSize(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic) {
+    if (eFormat_ic == VK_FORMAT_R8G8B8A8_UNORM || eFormat_ic == VK_FORMAT_R8G8B8A8_SRGB)
+        return static_cast<size_t>(lWidth_ic) * lHeight_ic * 4u;
+    BCFormat eBC = BCFormat::BC1;
+    if (GetBCFormat(eFormat_ic, eBC) == true)
+        return GetBCImageSize(eBC, lWidth_ic, lHeight_ic);
+    return 0u;
+}
+
+bool ParseTextureContainer(const uint8_t* pData_ic, size_t zSize_ic, GpuTextureData& stData_out) {
+    stData_out = GpuTextureData{};
+    if (pData_ic == nullptr || zSize_ic < 4u)
+        return false;
+    const bool bOk = (ReadU32(pData_ic) == kDdsMagic) ? ParseDds(pData_ic, zSize_ic, stData_out)
+                                                      : ParseKtx2(pData_ic, zSize_ic, stData_out);
+    if (bOk == false)
+        stData_out = GpuTextureData{};
+    return bOk;
+}
+
+bool IsTextureContainerPath(const std::string& sPath_ic) {
+    const size_t zDot = sPath_ic.find_last_of('.');
+    if (zDot == std::string::npos)
+        return false;
+    std::string sExt = sPath_ic.substr(zDot + 1u);
+    for (char& c : sExt)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return sExt == "dds" || sExt == "ktx2";
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "bc_codec.h"
+#include "mip_generator.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+/**
+ * GPU-ready texture payload: final format, every mip level tightly packed (level 0 first).
+ * Produced by DDS/KTX2 parsing or by TextureManager::CookTexture; uploaded with one VkBufferImageCopy per level.
+ */
+struct GpuTextureData {
+    VkFormat eFormat = VK_FORMAT_UNDEFINED;
+    uint32_t lWidth  = 0u;
+    uint32_t lHeight = 0u;
+    std::vector<MipLevelDesc> vecLevels;  // zOffset/zSize into vecData
+    std::vector<uint8_t> vecData;
+};
+
+/** True for the BC1-BC7 block formats this engine uploads. */
+bool IsBlockCompressedFormat(VkFormat eFormat_ic);
+/** BCFormat of a block-compressed VkFormat (sRGB and UNORM variants map to the same codec). False if not BC1/3/4/5/7. */
+bool GetBCFormat(VkFormat eFormat_ic, BCFormat& eBC_out);
+/** Bytes of one w x h level in eFormat_ic (RGBA8 or BC). 0 for unsupported formats. */
+size_t GetTextureLevelSize(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic);
+
+/**
+ * Parse a DDS (legacy FourCC DXT1/DXT5/ATI1/ATI2/BC4U/BC5U or DX10 header) or KTX2 (no supercompression) file.
+ * Only single-layer 2D textures in RGBA8 or BC1/BC3/BC4/BC5/BC7 are accepted. Level data is copied into stData_out.
+ * @return false (stData_out cleared) if the container is malformed, truncated or uses an unsupported feature.
+ */
+bool ParseTextureContainer(const uint8_t* pData_ic, size_t zSize_ic, GpuTextureData& stData_out);
+/** Recognizes .dds / .ktx2 by extension (case-insensitive). */
+bool IsTextureContainerPath(const std::string& sPath_ic);
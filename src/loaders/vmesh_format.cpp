@@ -0,0 +1,260 @@
+/*
+ * .vmesh cooked mesh container — memory-mapped read, validation, atomic write.
+ */
+#include "vmesh_format.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <system_error>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint64_t kFnv1aPrime = 0x100000001b3ull;
+
+uint64_t AlignUp(uint64_t uValue_ic, uint64_t uAlignment_ic) {
+    return (uValue_ic + uAlignment_ic - 1u) & ~(uAlignment_ic - 1u);
+}
+
+/** True if [uOffset_ic, uOffset_ic + uBytes_ic) lies inside a mapping of zSize_ic bytes and is 4-byte aligned. */
+bool BlobInRange(uint64_t uOffset_ic, uint64_t uBytes_ic, size_t zSize_ic) {
+    if ((uOffset_ic % 4u) != 0u)
+        return false;
+    if (uOffset_ic > static_cast<uint64_t>(zSize_ic))
+        return false;
+    return uBytes_ic <= (static_cast<uint64_t>(zSize_ic) - uOffset_ic);
+}
+
+void WritePadding(std::ofstream& stmOut, uint64_t& uPos_io, uint64_t uTarget_ic) {
+    static const char kZeros[kVMeshBlobAlignment] = {};
+    while (uPos_io < uTarget_ic) {
+        const uint64_t uChunk = std::min<uint64_t>(uTarget_ic - uPos_io, kVMeshBlobAlignment);
+        stmOut.write(kZeros, static_cast<std::streamsize>(uChunk));
+        uPos_io += uChunk;
+    }
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// MappedFile
+// -----------------------------------------------------------------------------
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& sPath_ic) {
+    Close();
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE hFile = CreateFileA(sPath_ic.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER stSize = {};
+    if ((GetFileSizeEx(hFile, &stSize) == FALSE) || (stSize.QuadPart <= 0)) {
+        CloseHandle(hFile);
+        return false;
+    }
+    HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (hMapping == nullptr) {
+        CloseHandle(hFile);
+        return false;
+    }
+    void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (pView == nullptr) {
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+    this->m_hFile = hFile;
+    this->m_hMapping = hMapping;
+    this->m_pData = static_cast<const uint8_t*>(pView);
+    this->m_zSize = static_cast<size_t>(stSize.QuadPart);
+#else
+    const int iFd = ::open(sPath_ic.c_str(), O_RDONLY);
+    if (iFd < 0)
+        return false;
+    struct stat stStat = {};
+    if ((::fstat(iFd, &stStat) != 0) || (stStat.st_size <= 0)) {
+        ::close(iFd);
+        return false;
+    }
+    const size_t zSize = static_cast<size_t>(stStat.st_size);
+    void* pView = ::mmap(nullptr, zSize, PROT_READ, MAP_PRIVATE, iFd, 0);
+    ::close(iFd);  /* Mapping keeps the file referenced. */
+    if (pView == MAP_FAILED)
+        return false;
+    ::madvise(pView, zSize, MADV_SEQUENTIAL);
+    this->m_pData = static_cast<const uint8_t*>(pView);
+    this->m_zSize = zSize;
+#endif
+    return true;
+}
+
+void MappedFile::Close() {
+#if defined(_WIN32) || defined(_WIN64)
+    if (this->m_pData != nullptr)
+        UnmapViewOfFile(this->m_pData);
+    if (this->m_hMapping != nullptr)
+        CloseHandle(static_cast<HANDLE>(this->m_hMapping));
+    if (this->m_hFile != nullptr)
+        CloseHandle(static_cast<HANDLE>(this->m_hFile));
+    this->m_hMapping = nullptr;
+    this->m_hFile = nullptr;
+#else
+    if (this->m_pData != nullptr)
+        ::munmap(const_cast<uint8_t*>(this->m_pData), this->m_zSize);
+#endif
+    this->m_pData = nullptr;
+    this->m_zSize = 0u;
+}
+
+// -----------------------------------------------------------------------------
+// Hashing / paths
+// -----------------------------------------------------------------------------
+uint64_t HashBytesFnv1a(const void* pData_ic, size_t zSize_ic, uint64_t uSeed_ic) {
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData_ic);
+    uint64_t uHash = uSeed_ic;
+    for (size_t z = 0u; z < zSize_ic; ++z) {
+        uHash ^= static_cast<uint64_t>(pBytes[z]);
+        uHash *= kFnv1aPrime;
+    }
+    return uHash;
+}
+
+bool HashFileContents(const std::string& sPath_ic, uint64_t& uHash_out, uint64_t uSeed_ic) {
+    MappedFile stFile;
+    if (stFile.Open(sPath_ic) == false)
+        return false;
+    uHash_out = HashBytesFnv1a(stFile.GetData(), stFile.GetSize(), uSeed_ic);
+    return true;
+}
+
+std::string GetVMeshCachePath(const std::string& sCacheDir_ic, const std::string& sKey_ic) {
+    const uint64_t uKeyHash = HashBytesFnv1a(sKey_ic.data(), sKey_ic.size());
+    return (std::filesystem::path(sCacheDir_ic) / std::format("{:016x}.vmesh", uKeyHash)).string();
+}
+
+// -----------------------------------------------------------------------------
+// Read / write
+// -----------------------------------------------------------------------------
+bool ParseVMesh(const uint8_t* pData_ic, size_t zSize_ic, uint64_t uSourceKeyHash_ic, uint64_t uSourceContentHash_ic,
+                VMeshView& stView_out) {
+    stView_out = VMeshView{};
+    if ((pData_ic == nullptr) || (zSize_ic < sizeof(VMeshHeader)))
+        return false;
+    const VMeshHeader* pHeader = reinterpret_cast<const VMeshHeader*>(pData_ic);
+    if ((pHeader->magic != kVMeshMagic) || (pHeader->version != kVMeshVersion))
+        return false;
+    if ((pHeader->sourceKeyHash != uSourceKeyHash_ic) || (pHeader->sourceContentHash != uSourceContentHash_ic))
+        return false;
+    if ((pHeader->fileSize != static_cast<uint64_t>(zSize_ic)) || (pHeader->vertexStride == 0u) || (pHeader->vertexCount == 0u))
+        return false;
+
+    const uint64_t uVertexBytes  = static_cast<uint64_t>(pHeader->vertexStride) * pHeader->vertexCount;
+    const uint64_t uIndexBytes   = static_cast<uint64_t>(pHeader->indexCount) * sizeof(uint32_t);
+    const uint64_t uLodBytes     = static_cast<uint64_t>(pHeader->lodCount) * sizeof(VMeshLod);
+    const uint64_t uMeshletBytes = static_cast<uint64_t>(pHeader->meshletCount) * sizeof(Meshlet);
+    if ((BlobInRange(pHeader->vertexOffset, uVertexBytes, zSize_ic) == false) ||
+        (BlobInRange(pHeader->indexOffset, uIndexBytes, zSize_ic) == false) ||
+        (BlobInRange(pHeader->lodOffset, uLodBytes, zSize_ic) == false) ||
+        (BlobInRange(pHeader->meshletOffset, uMeshletBytes, zSize_ic) == false))
+        return false;
+
+    /* Meshlet ranges index the vertex blob directly; reject rather than let a corrupt file drive GPU draws. */
+    const Meshlet* pMeshlets = reinterpret_cast<const Meshlet*>(pData_ic + pHeader->meshletOffset);
+    for (uint32_t lM = 0u; lM < pHeader->meshletCount; ++lM) {
+        if (static_cast<uint64_t>(pMeshlets[lM].firstVertex) + pMeshlets[lM].vertexCount > pHeader->vertexCount)
+            return false;
+    }
+
+    stView_out.pHeader   = pHeader;
+    stView_out.pVertices = pData_ic + pHeader->vertexOffset;
+    stView_out.pIndices  = (pHeader->indexCount != 0u) ? reinterpret_cast<const uint32_t*>(pData_ic + pHeader->indexOffset) : nullptr;
+    stView_out.pLods     = (pHeader->lodCount != 0u) ? reinterpret_cast<const VMeshLod*>(pData_ic + pHeader->lodOffset) : nullptr;
+    stView_out.pMeshlets = (pHeader->meshletCount != 0u) ? pMeshlets : nullptr;
+    return true;
+}
+
+bool WriteVMeshFile(const std::string& sPath_ic, const VMeshCookInput& stInput_ic) {
+    if ((stInput_ic.pVertices == nullptr) || (stInput_ic.vertexStride == 0u) || (stInput_ic.vertexCount == 0u))
+        return false;
+    if ((stInput_ic.indexCount != 0u) && (stInput_ic.pIndices == nullptr))
+        return false;
+
+    const uint32_t lMeshletCount = (stInput_ic.pMeshlets != nullptr) ? static_cast<uint32_t>(stInput_ic.pMeshlets->size()) : 0u;
+    /* Only LOD 0 (full mesh) is produced today; the table lets simplified LODs be appended without a format change. */
+    const VMeshLod stLod0 = { 0u, stInput_ic.vertexCount, 0u, stInput_ic.indexCount };
+
+    VMeshHeader stHeader = {};
+    stHeader.magic             = kVMeshMagic;
+    stHeader.version           = kVMeshVersion;
+    stHeader.sourceKeyHash     = stInput_ic.sourceKeyHash;
+    stHeader.sourceContentHash = stInput_ic.sourceContentHash;
+    stHeader.vertexStride      = stInput_ic.vertexStride;
+    stHeader.vertexCount       = stInput_ic.vertexCount;
+    stHeader.indexCount        = stInput_ic.indexCount;
+    stHeader.meshletCount      = lMeshletCount;
+    stHeader.lodCount          = 1u;
+    std::memcpy(stHeader.aabbMin, stInput_ic.aabbMin, sizeof(stHeader.aabbMin));
+    std::memcpy(stHeader.aabbMax, stInput_ic.aabbMax, sizeof(stHeader.aabbMax));
+
+    const uint64_t uVertexBytes  = static_cast<uint64_t>(stInput_ic.vertexStride) * stInput_ic.vertexCount;
+    const uint64_t uIndexBytes   = static_cast<uint64_t>(stInput_ic.indexCount) * sizeof(uint32_t);
+    const uint64_t uLodBytes     = sizeof(VMeshLod);
+    const uint64_t uMeshletBytes = static_cast<uint64_t>(lMeshletCount) * sizeof(Meshlet);
+    stHeader.vertexOffset  = AlignUp(sizeof(VMeshHeader), kVMeshBlobAlignment);
+    stHeader.indexOffset   = AlignUp(stHeader.vertexOffset + uVertexBytes, kVMeshBlobAlignment);
+    stHeader.lodOffset     = AlignUp(stHeader.indexOffset + uIndexBytes, kVMeshBlobAlignment);
+    stHeader.meshletOffset = AlignUp(stHeader.lodOffset + uLodBytes, kVMeshBlobAlignment);
+    stHeader.fileSize      = stHeader.meshletOffset + uMeshletBytes;
+
+    std::error_code ec;
+    const std::filesystem::path finalPath(sPath_ic);
+    if (finalPath.has_parent_path() == true)
+        std::filesystem::create_directories(finalPath.parent_path(), ec);
+    std::filesystem::path tmpPath = finalPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream stmOut(tmpPath, std::ios::binary | std::ios::trunc);
+        if (stmOut.is_open() == false)
+            return false;
+        uint64_t uPos = 0u;
+        stmOut.write(reinterpret_cast<const char*>(&stHeader), sizeof(stHeader));
+        uPos += sizeof(stHeader);
+        WritePadding(stmOut, uPos, stHeader.vertexOffset);
+        stmOut.write(static_cast<const char*>(stInput_ic.pVertices), static_cast<std::streamsize>(uVertexBytes));
+        uPos += uVertexBytes;
+        WritePadding(stmOut, uPos, stHeader.indexOffset);
+        if (uIndexBytes != 0u)
+            stmOut.write(reinterpret_cast<const char*>(stInput_ic.pIndices), static_cast<std::streamsize>(uIndexBytes));
+        uPos += uIndexBytes;
+        WritePadding(stmOut, uPos, stHeader.lodOffset);
+        stmOut.write(reinterpret_cast<const char*>(&stLod0), static_cast<std::streamsize>(uLodBytes));
+        uPos += uLodBytes;
+        WritePadding(stmOut, uPos, stHeader.meshletOffset);
+        if (uMeshletBytes != 0u)
+            stmOut.write(reinterpret_cast<const char*>(stInput_ic.pMeshlets->data()), static_cast<std::streamsize>(uMeshletBytes));
+        if (stmOut.good() == false) {
+            stmOut.close();
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "meshlet_builder.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * .vmesh — cooked mesh container (one glTF primitive per file), loaded by memory mapping.
+ *
+ * Layout: VMeshHeader, then blobs at 16-byte aligned offsets recorded in the header:
+ *   vertices (GPU layout, vertexStride bytes each), indices (uint32, empty for non-indexed meshes),
+ *   LOD table (VMeshLod[lodCount], LOD 0 = full mesh), meshlets (Meshlet[meshletCount]).
+ * A file is valid only if magic, version, source key hash and source content hash all match;
+ * anything else is treated as stale and re-cooked from the source.
+ */
+constexpr uint32_t kVMeshMagic   = 0x48534D56u;  // "VMSH" little-endian
+/** Bump when the layout, VertexData or meshlet builder limits change (invalidates every cooked file). */
+constexpr uint32_t kVMeshVersion = 1u;
+constexpr uint64_t kVMeshBlobAlignment = 16u;
+
+/** One level of detail: vertex range (non-indexed) and index range (indexed; indexCount 0 if unused). */
+struct VMeshLod {
+    uint32_t firstVertex;
+    uint32_t vertexCount;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+};
+static_assert(sizeof(VMeshLod) == 16, "VMeshLod must be 16 bytes");
+
+struct VMeshHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceKeyHash;      // HashBytesFnv1a of the mesh key (source path + mesh/primitive index)
+    uint64_t sourceContentHash;  // Content hash of the source asset (see SceneManager::GetOrLoadGltfModel)
+    uint32_t vertexStride;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t meshletCount;
+    uint32_t lodCount;
+    uint32_t _pad0;
+    float    aabbMin[3];
+    float    aabbMax[3];
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t lodOffset;
+    uint64_t meshletOffset;
+    uint64_t fileSize;
+};
+static_assert(sizeof(VMeshHeader) == 112, "VMeshHeader must be 112 bytes");
+
+/** Non-owning view into a mapped .vmesh (valid while the MappedFile stays open). */
+struct VMeshView {
+    const VMeshHeader* pHeader   = nullptr;
+    const void*        pVertices = nullptr;
+    const uint32_t*    pIndices  = nullptr;
+    const VMeshLod*    pLods     = nullptr;
+    const Meshlet*     pMeshlets = nullptr;
+};
+
+/** Data to cook; pointers are borrowed for the duration of WriteVMeshFile. */
+struct VMeshCookInput {
+    uint64_t       sourceKeyHash     = 0u;
+    uint64_t       sourceContentHash = 0u;
+    const void*    pVertices         = nullptr;
+    uint32_t       vertexStride      = 0u;
+    uint32_t       vertexCount       = 0u;
+    const uint32_t* pIndices         = nullptr;
+    uint32_t       indexCount        = 0u;
+    const std::vector<Meshlet>* pMeshlets = nullptr;
+    float          aabbMin[3]        = { 0.f, 0.f, 0.f };
+    float          aabbMax[3]        = { 0.f, 0.f, 0.f };
+};
+
+/**
+ * Read-only memory-mapped file (mmap / MapViewOfFile). Non-copyable; unmapped on Close() or destruction.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /** Map the whole file. Returns false if missing, empty or mapping fails. */
+    bool Open(const std::string& sPath_ic);
+    void Close();
+
+    const uint8_t* GetData() const { return this->m_pData; }
+    size_t GetSize() const { return this->m_zSize; }
+    bool IsOpen() const { return this->m_pData != nullptr; }
+
+private:
+    const uint8_t* m_pData = nullptr;
+    size_t m_zSize = 0u;
+#if defined(_WIN32) || defined(_WIN64)
+    void* m_hFile = nullptr;
+    void* m_hMapping = nullptr;
+#endif
+};
+
+/** 64-bit FNV-1a; pass a previous result as uSeed_ic to chain several ranges. */
+constexpr uint64_t kFnv1aOffsetBasis = 0xcbf29ce484222325ull;
+uint64_t HashBytesFnv1a(const void* pData_ic, size_t zSize_ic, uint64_t uSeed_ic = kFnv1aOffsetBasis);
+
+/** Hash a file's bytes through a mapping. Returns false if the file cannot be mapped. */
+bool HashFileContents(const std::string& sPath_ic, uint64_t& uHash_out, uint64_t uSeed_ic = kFnv1aOffsetBasis);
+
+/** Cache file for a mesh key: sCacheDir_ic / <16 hex digits of HashBytesFnv1a(key)>.vmesh */
+std::string GetVMeshCachePath(const std::string& sCacheDir_ic, const std::string& sKey_ic);
+
+/**
+ * Validate a mapped .vmesh and fill views into it. Fails (returns false) on bad magic/version,
+ * hash mismatch (stale cache) or any blob outside the mapping.
+ */
+bool ParseVMesh(const uint8_t* pData_ic, size_t zSize_ic, uint64_t uSourceKeyHash_ic, uint64_t uSourceContentHash_ic,
+                VMeshView& stView_out);
+
+/** Write a .vmesh (to a temp file, then rename so readers never map a partial file). Creates parent dirs. */
+bool WriteVMeshFile(const std::string& sPath_ic, const VMeshCookInput& stInput_ic);
@@ -0,0 +1,125 @@
+/*
+ * .vtex cooked texture container — validation and atomic write (mapping via MappedFile in vmesh_format).
+ */
+#include "vtex_format.h"
+#include "vmesh_format.h"
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+
+namespace {
+
+uint64_t AlignUp(uint64_t uValue_ic, uint64_t uAlignment_ic) {
+    return (uValue_ic + uAlignment_ic - 1u) & ~(uAlignment_ic - 1u);
+}
+
+void WritePadding(std::ofstream& stmOut, uint64_t& uPos_io, uint64_t uTarget_ic) {
+    static const char kZeros[kVTexBlobAlignment] = {};
+    while (uPos_io < uTarget_ic) {
+        const uint64_t uChunk = std::min<uint64_t>(uTarget_ic - uPos_io, kVTexBlobAlignment);
+        stmOut.write(kZeros, static_cast<std::streamsize>(uChunk));
+        uPos_io += uChunk;
+    }
+}
+
+} // namespace
+
+std::string GetVTexCachePath(const std::string& sCacheDir_ic, uint64_t uSourceContentHash_ic, uint64_t uCookSettingsHash_ic) {
+    const uint64_t uHash = HashBytesFnv1a(&uCookSettingsHash_ic, sizeof(uCookSettingsHash_ic), uSourceContentHash_ic);
+    return (std::filesystem::path(sCacheDir_ic) / std::format("{:016x}.vtex", uHash)).string();
+}
+
+bool ParseVTex(const uint8_t* pData_ic, size_t zSize_ic, uint64_t uSourceContentHash_ic, uint64_t uCookSettingsHash_ic,
+               VTexView& stView_out) {
+    stView_out = VTexView{};
+    if ((pData_ic == nullptr) || (zSize_ic < sizeof(VTexHeader)))
+        return false;
+    const VTexHeader* pHeader = reinterpret_cast<const VTexHeader*>(pData_ic);
+    if ((pHeader->magic != kVTexMagic) || (pHeader->version != kVTexVersion))
+        return false;
+    if ((pHeader->sourceContentHash != uSourceContentHash_ic) || (pHeader->cookSettingsHash != uCookSettingsHash_ic))
+        return false;
+    if ((pHeader->fileSize != static_cast<uint64_t>(zSize_ic)) || (pHeader->levelCount == 0u) ||
+        (pHeader->width == 0u) || (pHeader->height == 0u))
+        return false;
+    const uint64_t uTableBytes = static_cast<uint64_t>(pHeader->levelCount) * sizeof(VTexLevel);
+    if (((pHeader->levelOffset % 8u) != 0u) || (pHeader->levelOffset > zSize_ic) || (uTableBytes > zSize_ic - pHeader->levelOffset))
+        return false;
+
+    const VTexLevel* pLevels = reinterpret_cast<const VTexLevel*>(pData_ic + pHeader->levelOffset);
+    for (uint32_t lL = 0u; lL < pHeader->levelCount; ++lL) {
+        const VTexLevel& st = pLevels[lL];
+        if ((st.width != std::max(pHeader->width >> lL, 1u)) || (st.height != std::max(pHeader->height >> lL, 1u)))
+            return false;
+        if ((st.size == 0u) || (st.offset > zSize_ic) || (st.size > zSize_ic - st.offset))
+            return false;
+    }
+    stView_out.pHeader = pHeader;
+    stView_out.pLevels = pLevels;
+    return true;
+}
+
+bool WriteVTexFile(const std::string& sPath_ic, const VTexCookInput& stInput_ic) {
+    if ((stInput_ic.pLevels == nullptr) || (stInput_ic.pLevels->empty() == true) || (stInput_ic.pData == nullptr))
+        return false;
+    const std::vector<MipLevelDesc>& vecLevels = *stInput_ic.pLevels;
+    const uint32_t lLevelCount = static_cast<uint32_t>(vecLevels.size());
+
+    VTexHeader stHeader = {};
+    stHeader.magic             = kVTexMagic;
+    stHeader.version           = kVTexVersion;
+    stHeader.sourceContentHash = stInput_ic.sourceContentHash;
+    stHeader.cookSettingsHash  = stInput_ic.cookSettingsHash;
+    stHeader.format            = stInput_ic.format;
+    stHeader.width             = stInput_ic.width;
+    stHeader.height            = stInput_ic.height;
+    stHeader.levelCount        = lLevelCount;
+    stHeader.levelOffset       = AlignUp(sizeof(VTexHeader), kVTexBlobAlignment);
+
+    std::vector<VTexLevel> vecTable(lLevelCount);
+    uint64_t uOffset = AlignUp(stHeader.levelOffset + static_cast<uint64_t>(lLevelCount) * sizeof(VTexLevel), kVTexBlobAlignment);
+    for (uint32_t lL = 0u; lL < lLevelCount; ++lL) {
+        vecTable[lL] = { vecLevels[lL].lWidth, vecLevels[lL].lHeight, uOffset, static_cast<uint64_t>(vecLevels[lL].zSize) };
+        uOffset = AlignUp(uOffset + vecLevels[lL].zSize, kVTexBlobAlignment);
+    }
+    stHeader.fileSize = vecTable.back().offset + vecTable.back().size;
+
+    std::error_code ec;
+    const std::filesystem::path finalPath(sPath_ic);
+    if (finalPath.has_parent_path() == true)
+        std::filesystem::create_directories(finalPath.parent_path(), ec);
+    /* Written from JobQueue workers: two sources with identical bytes may cook the same file concurrently. */
+    std::filesystem::path tmpPath = finalPath;
+    tmpPath += std::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream stmOut(tmpPath, std::ios::binary | std::ios::trunc);
+        if (stmOut.is_open() == false)
+            return false;
+        uint64_t uPos = 0u;
+        stmOut.write(reinterpret_cast<const char*>(&stHeader), sizeof(stHeader));
+        uPos += sizeof(stHeader);
+        WritePadding(stmOut, uPos, stHeader.levelOffset);
+        stmOut.write(reinterpret_cast<const char*>(vecTable.data()), static_cast<std::streamsize>(vecTable.size() * sizeof(VTexLevel)));
+        uPos += vecTable.size() * sizeof(VTexLevel);
+        for (uint32_t lL = 0u; lL < lLevelCount; ++lL) {
+            WritePadding(stmOut, uPos, vecTable[lL].offset);
+            stmOut.write(reinterpret_cast<const char*>(stInput_ic.pData + vecLevels[lL].zOffset), static_cast<std::streamsize>(vecLevels[lL].zSize));
+            uPos += vecLevels[lL].zSize;
+        }
+        if (stmOut.good() == false) {
+            stmOut.close();
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "mip_generator.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * .vtex — cooked texture container (final GPU format, every mip level in upload order), loaded by memory mapping.
+ *
+ * Layout: VTexHeader, level table (VTexLevel[levelCount], level 0 first), then level blobs at 16-byte aligned
+ * offsets recorded in the table. Files are content-addressed: the name and header carry the hash of the source
+ * bytes (encoded PNG/JPEG) and of the cook settings (format, mip mode), so a changed image or setting simply
+ * misses the cache. A file whose magic, version or hashes do not match is treated as stale and re-cooked.
+ */
+constexpr uint32_t kVTexMagic   = 0x58455456u;  // "VTEX" little-endian
+/** Bump when the layout, the mip filter or the BC encoders change (invalidates every cooked file). */
+constexpr uint32_t kVTexVersion = 1u;
+constexpr uint64_t kVTexBlobAlignment = 16u;
+
+struct VTexLevel {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;  // From the start of the file
+    uint64_t size;
+};
+static_assert(sizeof(VTexLevel) == 24, "VTexLevel must be 24 bytes");
+
+struct VTexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceContentHash;  // HashBytesFnv1a of the source image bytes
+    uint64_t cookSettingsHash;   // See TextureManager::GetCookSettingsHash
+    uint32_t format;             // VkFormat
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelCount;
+    uint64_t levelOffset;
+    uint64_t fileSize;
+};
+static_assert(sizeof(VTexHeader) == 56, "VTexHeader must be 56 bytes");
+
+/** Non-owning view into a mapped .vtex (valid while the MappedFile stays open). */
+struct VTexView {
+    const VTexHeader* pHeader = nullptr;
+    const VTexLevel*  pLevels = nullptr;
+};
+
+/** Data to cook; pointers are borrowed for the duration of WriteVTexFile. */
+struct VTexCookInput {
+    uint64_t       sourceContentHash = 0u;
+    uint64_t       cookSettingsHash  = 0u;
+    uint32_t       format            = 0u;
+    uint32_t       width             = 0u;
+    uint32_t       height            = 0u;
+    const std::vector<MipLevelDesc>* pLevels = nullptr;  // zOffset/zSize into pData
+    const uint8_t* pData             = nullptr;
+};
+
+/** Cache file for a cooked texture: sCacheDir_ic / <16 hex digits of the combined hashes>.vtex */
+std::string GetVTexCachePath(const std::string& sCacheDir_ic, uint64_t uSourceContentHash_ic, uint64_t uCookSettingsHash_ic);
+
+/**
+ * Validate a mapped .vtex and fill views into it. Fails (returns false) on bad magic/version,
+ * hash mismatch (stale cache) or any level outside the mapping.
+ */
+bool ParseVTex(const uint8_t* pData_ic, size_t zSize_ic, uint64_t uSourceContentHash_ic, uint64_t uCookSettingsHash_ic,
+               VTexView& stView_out);
+
+/** Write a .vtex (to a temp file, then rename so readers never map a partial file). Creates parent dirs. */
+bool WriteVTexFile(const std::string& sPath_ic, const VTexCookInput& stInput_ic);
@@ -0,0 +1,74 @@
+/*
+ * DeferredReleaseQueue — releases tagged with the frame serial, run once that frame's fence has been waited on.
+ */
+#include "deferred_release_queue.h"
+#include "vulkan/vulkan_utils.h"
+#include <iterator>
+
+DeferredReleaseQueue::~DeferredReleaseQueue() {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    if (this->m_releases.empty() == false)
+        VulkanUtils::LogWarn("DeferredReleaseQueue: {} releases never ran (Flush before destroying the device)", this->m_releases.size());
+}
+
+void DeferredReleaseQueue::BeginFrame(uint64_t uFrameSerial_ic) {
+    this->m_uFrameSerial.store(uFrameSerial_ic, std::memory_order_relaxed);
+}
+
+void DeferredReleaseQueue::Defer(std::function<void()> fnRelease_in) {
+    if (fnRelease_in == nullptr)
+        return;
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    // Read under the lock: a release queued after another never gets an older serial
+    this->m_releases.push_back({ this->m_uFrameSerial.load(std::memory_order_relaxed), std::move(fnRelease_in) });
+}
+
+uint32_t DeferredReleaseQueue::Collect(uint64_t uCompletedSerial_ic) {
+    this->m_vecRunning.clear();
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        while ((this->m_releases.empty() == false) && (this->m_releases.front().uFrame <= uCompletedSerial_ic)) {
+            this->m_vecRunning.push_back(std::move(this->m_releases.front()));
+            this->m_releases.pop_front();
+        }
+    }
+    this->m_lLastCollected = Run(this->m_vecRunning);
+    return this->m_lLastCollected;
+}
+
+uint32_t DeferredReleaseQueue::Flush() {
+    uint32_t lRan = 0u;
+    // Releases may queue more releases: repeat until nothing is left
+    while (true) {
+        std::vector<Release> vecReleases;
+        {
+            std::lock_guard<std::mutex> lock(this->m_mutex);
+            if (this->m_releases.empty() == true)
+                break;
+            vecReleases.assign(std::make_move_iterator(this->m_releases.begin()), std::make_move_iterator(this->m_releases.end()));
+            this->m_releases.clear();
+        }
+        lRan += Run(vecReleases);
+    }
+    return lRan;
+}
+
+uint32_t DeferredReleaseQueue::Run(std::vector<Release>& vecReleases_io) {
+    for (Release& stRelease : vecReleases_io)
+        stRelease.fnRelease();
+    const uint32_t lRan = static_cast<uint32_t>(vecReleases_io.size());
+    vecReleases_io.clear();
+    this->m_uTotalReleased += lRan;
+    return lRan;
+}
+
+DeferredReleaseStats DeferredReleaseQueue::GetStats() const {
+    DeferredReleaseStats stStats;
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        stStats.lPending = static_cast<uint32_t>(this->m_releases.size());
+    }
+    stStats.lLastCollected = this->m_lLastCollected;
+    stStats.uTotalReleased = this->m_uTotalReleased;
+    return stStats;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** Counters of a DeferredReleaseQueue (see GetStats). */
+struct DeferredReleaseStats {
+    uint32_t lPending       = 0u;  // Releases waiting for their frame to complete
+    uint32_t lLastCollected = 0u;  // Releases run by the last Collect
+    uint64_t uTotalReleased = 0u;  // Since creation (Collect + Flush)
+};
+
+/**
+ * DeferredReleaseQueue — GPU objects the CPU is done with but frames in flight may still use.
+ *
+ * Each release is tagged with the frame serial current when it is queued (BeginFrame) and runs in Collect once
+ * the fence of that frame has been waited on. Releases are queued in serial order, so Collect only looks at the
+ * releases it runs: the cost per frame is the number of objects released, not the size of any cache.
+ * Managers queue what they drop (trimmed cache entries, replaced streaming images) instead of destroying it.
+ *
+ * Defer / Retire from any thread; BeginFrame, Collect and Flush on the main thread. Releases run on the main
+ * thread, outside the queue lock (a release may queue further releases).
+ */
+class DeferredReleaseQueue {
+public:
+    DeferredReleaseQueue() = default;
+    ~DeferredReleaseQueue();
+
+    DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+    DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+
+    /** Start of frame: releases queued from now on belong to uFrameSerial_ic (must not decrease). */
+    void BeginFrame(uint64_t uFrameSerial_ic);
+    /** Run fnRelease_in once every frame up to the current serial has completed on the GPU. */
+    void Defer(std::function<void()> fnRelease_in);
+    /** Keep pObject_in alive until frames in flight are done with it; this last reference is dropped then. */
+    template <typename T>
+    void Retire(std::shared_ptr<T> pObject_in) {
+        if (pObject_in != nullptr)
+            Defer([pObject = std::move(pObject_in)]() mutable { pObject.reset(); });
+    }
+    template <typename T>
+    void Retire(std::unique_ptr<T> pObject_in) {
+        if (pObject_in != nullptr)
+            Retire(std::shared_ptr<T>(std::move(pObject_in)));
+    }
+
+    /**
+     * Main thread, after the fence wait: run releases of frames <= uCompletedSerial_ic (every command buffer
+     * submitted in those frames has finished). Returns how many ran.
+     */
+    uint32_t Collect(uint64_t uCompletedSerial_ic);
+    /** Run every queued release. Only when the device is idle (swapchain recreate, shutdown). */
+    uint32_t Flush();
+
+    uint64_t GetFrameSerial() const { return this->m_uFrameSerial.load(std::memory_order_relaxed); }
+    DeferredReleaseStats GetStats() const;
+
+private:
+    struct Release {
+        uint64_t              uFrame = 0u;
+        std::function<void()> fnRelease;
+    };
+
+    /* Run and count fnRelease of vecReleases_io (lock not held). */
+    uint32_t Run(std::vector<Release>& vecReleases_io);
+
+    mutable std::mutex m_mutex;
+    std::deque<Release> m_releases;  // Non-decreasing uFrame
+    std::atomic<uint64_t> m_uFrameSerial{0u};
+    std::vector<Release> m_vecRunning;  // Collect scratch (main thread)
+    uint32_t m_lLastCollected = 0u;
+    uint64_t m_uTotalReleased = 0u;
+};
@@ -6,10 +6,11 @@
  *
  * DescriptorSetLayoutManager: register descriptor set layouts by key; used for data-driven pipeline layouts and pool sizing.
  * DescriptorPoolManager: build pool from layout keys, allocate/free sets; main thread only.
- * PipelineManager: get-or-create by key; returns shared_ptr<PipelineHandle>. TrimUnused() + ProcessPendingDestroys() after fence wait. DestroyPipelines() on swapchain recreate.
+ * PipelineManager: get-or-create by key; returns shared_ptr<PipelineHandle>. TrimUnused() hands pipelines to the release queue. DestroyPipelines() on swapchain recreate.
  * MaterialManager: registry material id -> shared_ptr<MaterialHandle>; materials cache shared_ptr<PipelineHandle>; TrimUnused().
  * MeshManager:     get-or-create procedural by key; returns shared_ptr<MeshHandle> (draw params); TrimUnused().
  * TextureManager:  get-or-load texture by path; VkImage + view + sampler; optional async via JobQueue.
+ * DeferredReleaseQueue: GPU objects dropped by the managers, destroyed once the frame they were dropped in has completed.
  *
  * Dependency: Shaders (shared_ptr) -> Pipeline -> Material -> Scene. Draw list holds raw VkPipeline/layout. Descriptor sets per pipeline via map (pipelineKey -> sets).
  *
@@ -23,3 +24,4 @@
 #include "material_manager.h"
 #include "scene_manager.h"
 #include "resource_cleanup_manager.h"
+#include "deferred_release_queue.h"
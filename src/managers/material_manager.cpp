@@ -30,6 +30,17 @@ VkPipelineLayout MaterialHandle::GetPipelineLayoutIfReady(PipelineManager* pPipe
     return m_pCachedPipeline->GetLayout();
 }
 
+bool MaterialHandle::PrewarmPipeline(VkDevice device,
+                                     VkRenderPass renderPass,
+                                     PipelineManager* pPipelineManager,
+                                     VulkanShaderManager* pShaderManager,
+                                     bool renderPassHasDepth) const {
+    if (pPipelineManager == nullptr || pShaderManager == nullptr)
+        return false;
+    return pPipelineManager->PrewarmPipeline(pipelineKey, device, renderPass, pShaderManager,
+                                             pipelineParams, layoutDescriptor, renderPassHasDepth);
+}
+
 std::shared_ptr<MaterialHandle> MaterialManager::RegisterMaterial(const std::string& sMaterialId,
                                                                     const std::string& sPipelineKey,
                                                                     const PipelineLayoutDescriptor& layoutDescriptor,
@@ -33,6 +33,13 @@ struct MaterialHandle {
 
     VkPipelineLayout GetPipelineLayoutIfReady(PipelineManager* pPipelineManager);
 
+    /** Start building the pipeline for this render pass ahead of the first draw (PipelineManager::PrewarmPipeline). */
+    bool PrewarmPipeline(VkDevice device,
+                         VkRenderPass renderPass,
+                         PipelineManager* pPipelineManager,
+                         VulkanShaderManager* pShaderManager,
+                         bool renderPassHasDepth) const;
+
 private:
     mutable std::shared_ptr<PipelineHandle> m_pCachedPipeline;
 };
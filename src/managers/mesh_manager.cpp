@@ -1,12 +1,15 @@
 /*
- * MeshManager — procedural meshes with vertex buffers; async .obj load and upload.
+ * MeshManager — procedural meshes with vertex buffers; async .obj load and upload; cooked .vmesh load/write.
  */
 #include "mesh_manager.h"
+#include "deferred_release_queue.h"
+#include "vmesh_format.h"
 #include "thread/job_queue.h"
 #include "vulkan/vulkan_utils.h"
 #include <cstring>
 #include <stdexcept>
 #include <algorithm>
+#include <utility>
 
 
 
@@ -20,14 +23,15 @@ MeshHandle::~MeshHandle() {
 MeshHandle::MeshHandle(MeshHandle&& other) noexcept
     : m_device(other.m_device)
     , m_vertexBuffer(other.m_vertexBuffer)
-    , m_vertexBufferMemory(other.m_vertexBufferMemory)
+    , m_vertexBufferMemory(std::exchange(other.m_vertexBufferMemory, {}))
     , m_vertexCount(other.m_vertexCount)
     , m_instanceCount(other.m_instanceCount)
     , m_firstVertex(other.m_firstVertex)
-    , m_firstInstance(other.m_firstInstance) {
+    , m_firstInstance(other.m_firstInstance)
+    , m_aabb(other.m_aabb)
+    , m_meshlets(std::move(other.m_meshlets)) {
     other.m_device = VK_NULL_HANDLE;
     other.m_vertexBuffer = VK_NULL_HANDLE;
-    other.m_vertexBufferMemory = VK_NULL_HANDLE;
     other.m_vertexCount = 0u;
 }
 
@@ -36,19 +40,20 @@ MeshHandle& MeshHandle::operator=(MeshHandle&& other) noexcept {
     Destroy();
     m_device = other.m_device;
     m_vertexBuffer = other.m_vertexBuffer;
-    m_vertexBufferMemory = other.m_vertexBufferMemory;
+    m_vertexBufferMemory = std::exchange(other.m_vertexBufferMemory, {});
     m_vertexCount = other.m_vertexCount;
     m_instanceCount = other.m_instanceCount;
     m_firstVertex = other.m_firstVertex;
     m_firstInstance = other.m_firstInstance;
+    m_aabb = other.m_aabb;
+    m_meshlets = std::move(other.m_meshlets);
     other.m_device = VK_NULL_HANDLE;
     other.m_vertexBuffer = VK_NULL_HANDLE;
-    other.m_vertexBufferMemory = VK_NULL_HANDLE;
     other.m_vertexCount = 0u;
     return *this;
 }
 
-void MeshHandle::SetVertexBuffer(VkDevice device, VkBuffer buffer, VkDeviceMemory memory) {
+void MeshHandle::SetVertexBuffer(VkDevice device, VkBuffer buffer, const MemoryAllocation& memory) {
     Destroy();
     m_device = device;
     m_vertexBuffer = buffer;
@@ -67,10 +72,8 @@ void MeshHandle::Destroy() {
         vkDestroyBuffer(m_device, m_vertexBuffer, nullptr);
         m_vertexBuffer = VK_NULL_HANDLE;
     }
-    if (m_device != VK_NULL_HANDLE && m_vertexBufferMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_device, m_vertexBufferMemory, nullptr);
-        m_vertexBufferMemory = VK_NULL_HANDLE;
-    }
+    if (m_device != VK_NULL_HANDLE)
+        VulkanMemory::Free(m_device, m_vertexBufferMemory);
     m_device = VK_NULL_HANDLE;
     m_vertexCount = 0u;
 }
@@ -82,6 +85,10 @@ void MeshManager::SetJobQueue(JobQueue* pJobQueue) {
     m_pJobQueue = pJobQueue;
 }
 
+void MeshManager::SetReleaseQueue(DeferredReleaseQueue* pReleaseQueue) {
+    m_pReleaseQueue = pReleaseQueue;
+}
+
 void MeshManager::SetDevice(VkDevice device) {
     m_device = device;
 }
@@ -98,6 +105,10 @@ void MeshManager::SetQueueFamilyIndex(uint32_t queueFamilyIndex) {
     m_queueFamilyIndex = queueFamilyIndex;
 }
 
+void MeshManager::SetCookedMeshDir(const std::string& sDir_ic) {
+    this->m_sCookedMeshDir = sDir_ic;
+}
+
 std::shared_ptr<MeshHandle> MeshManager::CreateVertexBufferFromData(const void* pData, uint32_t vertexCount, uint32_t vertexStride) {
     if (m_device == VK_NULL_HANDLE || m_physicalDevice == VK_NULL_HANDLE || m_queue == VK_NULL_HANDLE ||
         pData == nullptr || vertexCount == 0u || vertexStride == 0u)
@@ -105,29 +116,25 @@ std::shared_ptr<MeshHandle> MeshManager::CreateVertexBufferFromData(const void*
     const VkDeviceSize bufferSize = static_cast<VkDeviceSize>(vertexStride) * vertexCount;
 
     VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    MemoryAllocation stagingMemory;
     {
         if (VulkanUtils::CreateBuffer(m_device, m_physicalDevice, bufferSize,
                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging,
                 &stagingBuffer, &stagingMemory) != VK_SUCCESS)
             return nullptr;
-        void* pMapped = nullptr;
-        vkMapMemory(m_device, stagingMemory, 0, bufferSize, 0, &pMapped);
-        if (pMapped) {
-            std::memcpy(pMapped, pData, static_cast<size_t>(bufferSize));
-            vkUnmapMemory(m_device, stagingMemory);
-        }
+        if (stagingMemory.pMapped)
+            std::memcpy(stagingMemory.pMapped, pData, static_cast<size_t>(bufferSize));
     }
 
     VkBuffer vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
+    MemoryAllocation vertexMemory;
     {
         if (VulkanUtils::CreateBuffer(m_device, m_physicalDevice, bufferSize,
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Mesh,
                 &vertexBuffer, &vertexMemory) != VK_SUCCESS) {
-            vkFreeMemory(m_device, stagingMemory, nullptr);
+            VulkanMemory::Free(m_device, stagingMemory);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
             return nullptr;
         }
@@ -144,9 +151,9 @@ std::shared_ptr<MeshHandle> MeshManager::CreateVertexBufferFromData(const void*
         };
         VkResult r = vkCreateCommandPool(m_device, &poolInfo, nullptr, &cmdPool);
         if (r != VK_SUCCESS) {
-            vkFreeMemory(m_device, vertexMemory, nullptr);
+            VulkanMemory::Free(m_device, vertexMemory);
             vkDestroyBuffer(m_device, vertexBuffer, nullptr);
-            vkFreeMemory(m_device, stagingMemory, nullptr);
+            VulkanMemory::Free(m_device, stagingMemory);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
             return nullptr;
         }
@@ -160,9 +167,9 @@ std::shared_ptr<MeshHandle> MeshManager::CreateVertexBufferFromData(const void*
         r = vkAllocateCommandBuffers(m_device, &allocInfo, &cmdBuf);
         if (r != VK_SUCCESS) {
             vkDestroyCommandPool(m_device, cmdPool, nullptr);
-            vkFreeMemory(m_device, vertexMemory, nullptr);
+            VulkanMemory::Free(m_device, vertexMemory);
             vkDestroyBuffer(m_device, vertexBuffer, nullptr);
-            vkFreeMemory(m_device, stagingMemory, nullptr);
+            VulkanMemory::Free(m_device, stagingMemory);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
             return nullptr;
         }
@@ -185,9 +192,9 @@ std::shared_ptr<MeshHandle> MeshManager::CreateVertexBufferFromData(const void*
         VkResult r = vkCreateFence(m_device, &fenceInfo, nullptr, &fence);
         if (r != VK_SUCCESS) {
             vkDestroyCommandPool(m_device, cmdPool, nullptr);
-            vkFreeMemory(m_device, vertexMemory, nullptr);
+            VulkanMemory::Free(m_device, vertexMemory);
             vkDestroyBuffer(m_device, vertexBuffer, nullptr);
-            vkFreeMemory(m_device, stagingMemory, nullptr);
+            VulkanMemory::Free(m_device, stagingMemory);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
             return nullptr;
         }
@@ -209,7 +216,7 @@ std::shared_ptr<MeshHandle> MeshManager::CreateVertexBufferFromData(const void*
 
     vkDestroyCommandPool(m_device, cmdPool, nullptr);
     vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-    vkFreeMemory(m_device, stagingMemory, nullptr);
+    VulkanMemory::Free(m_device, stagingMemory);
 
     auto handle = std::make_shared<MeshHandle>();
     handle->SetVertexBuffer(m_device, vertexBuffer, vertexMemory);
@@ -275,7 +282,8 @@ std::shared_ptr<MeshHandle> MeshManager::GetOrCreateFromPositions(const std::str
     return p;
 }
 
-std::shared_ptr<MeshHandle> MeshManager::GetOrCreateFromGltf(const std::string& key, const void* pVertexData, uint32_t vertexCount) {
+std::shared_ptr<MeshHandle> MeshManager::GetOrCreateFromGltf(const std::string& key, const void* pVertexData, uint32_t vertexCount,
+                                                             const std::vector<Meshlet>* pMeshlets) {
     if (key.empty() || pVertexData == nullptr || vertexCount == 0u)
         return nullptr;
     auto it = m_cache.find(key);
@@ -294,11 +302,74 @@ std::shared_ptr<MeshHandle> MeshManager::GetOrCreateFromGltf(const std::string&
             aabb.Expand(pPos[0], pPos[1], pPos[2]);
         }
         p->SetAABB(aabb);
+        if (pMeshlets != nullptr && !pMeshlets->empty())
+            p->SetMeshlets(*pMeshlets);
         m_cache[key] = p;
     }
     return p;
 }
 
+std::shared_ptr<MeshHandle> MeshManager::GetOrCreateFromCooked(const std::string& key, uint64_t uSourceHash_ic) {
+    if ((key.empty() == true) || (this->IsMeshCookingEnabled() == false))
+        return nullptr;
+    auto it = this->m_cache.find(key);
+    if (it != this->m_cache.end())
+        return it->second;
+
+    const std::string sPath = GetVMeshCachePath(this->m_sCookedMeshDir, key);
+    MappedFile stFile;
+    if (stFile.Open(sPath) == false)
+        return nullptr;
+    VMeshView stView;
+    const uint64_t uKeyHash = HashBytesFnv1a(key.data(), key.size());
+    if (ParseVMesh(stFile.GetData(), stFile.GetSize(), uKeyHash, uSourceHash_ic, stView) == false) {
+        VulkanUtils::LogDebug("MeshManager: cooked mesh \"{}\" is stale or invalid, re-cooking", sPath);
+        return nullptr;
+    }
+    const VMeshHeader& stHeader = *stView.pHeader;
+    constexpr uint32_t lGltfVertexStride = 32u; // sizeof(VertexData), as in GetOrCreateFromGltf
+    if (stHeader.vertexStride != lGltfVertexStride) {
+        VulkanUtils::LogWarn("MeshManager: cooked mesh \"{}\" has stride {} (expected {}), re-cooking",
+                             sPath, stHeader.vertexStride, lGltfVertexStride);
+        return nullptr;
+    }
+
+    /* Single copy: mapping -> staging buffer (no intermediate vector). */
+    std::shared_ptr<MeshHandle> p = CreateVertexBufferFromData(stView.pVertices, stHeader.vertexCount, stHeader.vertexStride);
+    if (p == nullptr)
+        return nullptr;
+    MeshAABB aabb;
+    aabb.Expand(stHeader.aabbMin[0], stHeader.aabbMin[1], stHeader.aabbMin[2]);
+    aabb.Expand(stHeader.aabbMax[0], stHeader.aabbMax[1], stHeader.aabbMax[2]);
+    p->SetAABB(aabb);
+    if (stHeader.meshletCount != 0u)
+        p->SetMeshlets(std::vector<Meshlet>(stView.pMeshlets, stView.pMeshlets + stHeader.meshletCount));
+    this->m_cache[key] = p;
+    return p;
+}
+
+bool MeshManager::WriteCookedMesh(const std::string& key, uint64_t uSourceHash_ic, const MeshHandle& stMesh_ic, const void* pVertexData_ic) {
+    if ((key.empty() == true) || (this->IsMeshCookingEnabled() == false) || (pVertexData_ic == nullptr) || (stMesh_ic.GetVertexCount() == 0u))
+        return false;
+    const MeshAABB& stAabb = stMesh_ic.GetAABB();
+    VMeshCookInput stInput;
+    stInput.sourceKeyHash     = HashBytesFnv1a(key.data(), key.size());
+    stInput.sourceContentHash = uSourceHash_ic;
+    stInput.pVertices         = pVertexData_ic;
+    stInput.vertexStride      = 32u; // sizeof(VertexData)
+    stInput.vertexCount       = stMesh_ic.GetVertexCount();
+    stInput.pMeshlets         = &stMesh_ic.GetMeshlets();
+    stInput.aabbMin[0] = stAabb.minX; stInput.aabbMin[1] = stAabb.minY; stInput.aabbMin[2] = stAabb.minZ;
+    stInput.aabbMax[0] = stAabb.maxX; stInput.aabbMax[1] = stAabb.maxY; stInput.aabbMax[2] = stAabb.maxZ;
+
+    const std::string sPath = GetVMeshCachePath(this->m_sCookedMeshDir, key);
+    if (WriteVMeshFile(sPath, stInput) == false) {
+        VulkanUtils::LogWarn("MeshManager: failed to write cooked mesh \"{}\" for \"{}\"", sPath, key);
+        return false;
+    }
+    return true;
+}
+
 std::shared_ptr<MeshHandle> MeshManager::GetOrCreateProcedural(const std::string& key) {
     auto it = m_cache.find(key);
     if (it != m_cache.end())
@@ -417,7 +488,9 @@ void MeshManager::TrimUnused() {
     std::unique_lock<std::shared_mutex> lock(m_mutex);
     for (auto it = m_cache.begin(); it != m_cache.end(); ) {
         if (it->second.use_count() == 1u) {
-            m_pendingDestroy.push_back(std::move(it->second));
+            /* Frames in flight may still draw from the buffer: destroy it once their fences have signalled. */
+            if (m_pReleaseQueue != nullptr)
+                m_pReleaseQueue->Retire(std::move(it->second));
             it = m_cache.erase(it);
         } else {
             ++it;
@@ -425,13 +498,7 @@ void MeshManager::TrimUnused() {
     }
 }
 
-void MeshManager::ProcessPendingDestroys() {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_pendingDestroy.clear();  /* shared_ptrs released → MeshHandle destructors → vkDestroyBuffer; safe after vkWaitForFences */
-}
-
 void MeshManager::Destroy() {
     m_pendingMeshPaths.clear();
-    m_pendingDestroy.clear();
     m_cache.clear();
 }
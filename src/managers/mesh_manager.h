@@ -7,9 +7,12 @@
 #include <vector>
 #include <shared_mutex>
 #include <vulkan/vulkan.h>
+#include "meshlet_builder.h"
+#include "vulkan/vulkan_memory.h"
 #include <cmath>
 #include <cfloat>
 
+class DeferredReleaseQueue;
 class JobQueue;
 
 /**
@@ -49,7 +52,7 @@ struct MeshAABB {
 /**
  * Mesh handle: owns vertex buffer (and optionally index buffer later). Destructor frees GPU resources.
  * Draw params: vertexCount, firstVertex, instanceCount, firstInstance; indexCount/firstIndex for future indexed draw.
- * Includes local-space AABB for frustum culling.
+ * Includes local-space AABB for frustum culling and optional meshlets (import-time clusters for GPU meshlet culling).
  */
 class MeshHandle {
 public:
@@ -61,9 +64,12 @@ public:
     MeshHandle(MeshHandle&& other) noexcept;
     MeshHandle& operator=(MeshHandle&& other) noexcept;
 
-    void SetVertexBuffer(VkDevice device, VkBuffer buffer, VkDeviceMemory memory);
+    /** Takes ownership of buffer and memory (released with VulkanMemory::Free). */
+    void SetVertexBuffer(VkDevice device, VkBuffer buffer, const MemoryAllocation& memory);
     void SetDrawParams(uint32_t vertexCount, uint32_t firstVertex = 0u, uint32_t instanceCount = 1u, uint32_t firstInstance = 0u);
     void SetAABB(const MeshAABB& aabb) { m_aabb = aabb; }
+    /** Meshlets over this mesh's vertex range (firstVertex relative to GetFirstVertex()). Empty = per-object culling only. */
+    void SetMeshlets(std::vector<Meshlet> vecMeshlets_in) { m_meshlets = std::move(vecMeshlets_in); }
 
     VkBuffer GetVertexBuffer() const { return m_vertexBuffer; }
     VkDeviceSize GetVertexBufferOffset() const { return 0; }
@@ -73,18 +79,20 @@ public:
     uint32_t GetFirstInstance() const { return m_firstInstance; }
     bool HasValidBuffer() const { return m_vertexBuffer != VK_NULL_HANDLE && m_device != VK_NULL_HANDLE; }
     const MeshAABB& GetAABB() const { return m_aabb; }
+    const std::vector<Meshlet>& GetMeshlets() const { return m_meshlets; }
 
 private:
     void Destroy();
 
     VkDevice m_device = VK_NULL_HANDLE;
     VkBuffer m_vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory m_vertexBufferMemory = VK_NULL_HANDLE;
+    MemoryAllocation m_vertexBufferMemory;
     uint32_t m_vertexCount   = 0u;
     uint32_t m_instanceCount = 1u;
     uint32_t m_firstVertex   = 0u;
     uint32_t m_firstInstance = 0u;
     MeshAABB m_aabb;
+    std::vector<Meshlet> m_meshlets;
 };
 
 /**
@@ -97,23 +105,38 @@ public:
     MeshManager() = default;
 
     void SetJobQueue(JobQueue* pJobQueue);
+    /** Trimmed meshes are handed to this queue (destroyed once frames in flight are done). nullptr = destroy at once. */
+    void SetReleaseQueue(DeferredReleaseQueue* pReleaseQueue);
     void SetDevice(VkDevice device);
     void SetPhysicalDevice(VkPhysicalDevice physicalDevice);
     void SetQueue(VkQueue queue);
     void SetQueueFamilyIndex(uint32_t queueFamilyIndex);
+    /** Directory for cooked .vmesh files (see vmesh_format.h). Empty disables cooking and cooked loads. */
+    void SetCookedMeshDir(const std::string& sDir_ic);
+    bool IsMeshCookingEnabled() const { return this->m_sCookedMeshDir.empty() == false; }
+    const std::string& GetCookedMeshDir() const { return this->m_sCookedMeshDir; }
 
     std::shared_ptr<MeshHandle> GetOrCreateProcedural(const std::string& key);
     /** Create mesh from position data; cache by key (e.g. gltfPath + ":" + meshIndex). */
     std::shared_ptr<MeshHandle> GetOrCreateFromPositions(const std::string& key, const float* pPositions, uint32_t vertexCount);
-    /** Create mesh from glTF (interleaved pos+UV+normal); cache by key (e.g. gltfPath + ":" + meshIndex + ":" + primitiveIndex). */
-    std::shared_ptr<MeshHandle> GetOrCreateFromGltf(const std::string& key, const void* pVertexData, uint32_t vertexCount);
+    /** Create mesh from glTF (interleaved pos+UV+normal); cache by key (e.g. gltfPath + ":" + meshIndex + ":" + primitiveIndex).
+     *  pMeshlets (optional) are copied onto the handle for GPU meshlet culling. */
+    std::shared_ptr<MeshHandle> GetOrCreateFromGltf(const std::string& key, const void* pVertexData, uint32_t vertexCount,
+                                                    const std::vector<Meshlet>* pMeshlets = nullptr);
+    /**
+     * Create mesh from its cooked .vmesh (memory-mapped; vertices are copied straight from the mapping into staging).
+     * Returns nullptr if cooking is disabled or the file is missing, corrupt or stale (key/content hash mismatch);
+     * the caller then decodes the source and calls WriteCookedMesh.
+     */
+    std::shared_ptr<MeshHandle> GetOrCreateFromCooked(const std::string& key, uint64_t uSourceHash_ic);
+    /** Cook a glTF mesh created by GetOrCreateFromGltf (vertices as passed there; AABB and meshlets from the handle). */
+    bool WriteCookedMesh(const std::string& key, uint64_t uSourceHash_ic, const MeshHandle& stMesh_ic, const void* pVertexData_ic);
     void RequestLoadMesh(const std::string& path);
     void OnCompletedMeshFile(const std::string& sPath_ic, std::vector<uint8_t> vecData_in);
 
     std::shared_ptr<MeshHandle> GetMesh(const std::string& key) const;
+    /** Remove cache entries only the cache references; their buffers are released through the release queue. Main thread. */
     void TrimUnused();
-    /** Destroy mesh buffers that were trimmed. Call at start of frame after vkWaitForFences (buffers may still be in use until then). */
-    void ProcessPendingDestroys();
     /** Clear all cached meshes (release buffers). Call before device destroy. */
     void Destroy();
 
@@ -122,13 +145,13 @@ private:
     bool ParseObj(const uint8_t* pData, size_t size, std::vector<float>& outPositions, uint32_t& outVertexCount);
 
     JobQueue* m_pJobQueue = nullptr;
+    DeferredReleaseQueue* m_pReleaseQueue = nullptr;
     VkDevice m_device = VK_NULL_HANDLE;
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
     VkQueue m_queue = VK_NULL_HANDLE;
     uint32_t m_queueFamilyIndex = 0u;
+    std::string m_sCookedMeshDir;
     mutable std::shared_mutex m_mutex;
     std::map<std::string, std::shared_ptr<MeshHandle>> m_cache;
     std::set<std::string> m_pendingMeshPaths;
-    /** Meshes trimmed from cache; destroyed in ProcessPendingDestroys() after fence wait. */
-    std::vector<std::shared_ptr<MeshHandle>> m_pendingDestroy;
 };
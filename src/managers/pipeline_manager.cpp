@@ -1,17 +1,26 @@
 /*
  * PipelineManager — request pipelines by key; returns shared_ptr<PipelineHandle>. TrimUnused
- * moves unused to pending; ProcessPendingDestroys() at safe time (after fence wait).
+ * hands unused pipelines to the DeferredReleaseQueue (destroyed after the fence wait).
+ * Pipelines are built on JobQueue workers with the shared pipeline cache.
  */
 #include "pipeline_manager.h"
+#include "deferred_release_queue.h"
+#include "thread/job_queue.h"
+#include "vulkan/vulkan_utils.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 void PipelineHandle::Create(VkDevice device, VkRenderPass renderPass,
                             VulkanShaderManager* pShaderManager,
                             const std::string& sVertPath, const std::string& sFragPath,
                             const GraphicsPipelineParams& pipelineParams,
                             const PipelineLayoutDescriptor& layoutDescriptor,
-                            bool renderPassHasDepth) {
+                            bool renderPassHasDepth,
+                            VkPipelineCache pipelineCache,
+                            const ExtendedDynamicState& dynamicState) {
     m_pipeline.Create(device, renderPass, pShaderManager, sVertPath, sFragPath,
-                      pipelineParams, layoutDescriptor, renderPassHasDepth);
+                      pipelineParams, layoutDescriptor, renderPassHasDepth, pipelineCache, dynamicState);
 }
 
 void PipelineHandle::Destroy() {
@@ -25,11 +34,13 @@ void PipelineManager::RequestPipeline(const std::string& sKey,
     std::unique_lock<std::shared_mutex> lock(m_mutex);
     if (pShaderManager == nullptr || !pShaderManager->IsValid())
         return;
-    auto it = m_entries.find(sKey);
-    if (it != m_entries.end())
+    if (m_keyPrograms.find(sKey) != m_keyPrograms.end())
         return;
-    m_entries[sKey].sVertPath = sVertPath;
-    m_entries[sKey].sFragPath = sFragPath;
+    const std::string sProgram = sVertPath + "|" + sFragPath;
+    m_keyPrograms[sKey] = sProgram;
+    PipelineProgram& program = m_programs[sProgram];
+    program.sVertPath = sVertPath;
+    program.sFragPath = sFragPath;
     pShaderManager->RequestLoad(sVertPath);
     pShaderManager->RequestLoad(sFragPath);
 }
@@ -44,78 +55,245 @@ std::shared_ptr<PipelineHandle> PipelineManager::GetPipelineHandleIfReady(const
     std::unique_lock<std::shared_mutex> lock(m_mutex);
     if (device == VK_NULL_HANDLE || renderPass == VK_NULL_HANDLE || pShaderManager == nullptr)
         return nullptr;
-    auto it = m_entries.find(sKey);
-    if (it == m_entries.end())
+    PipelineProgram* pProgram = FindProgram(sKey);
+    if (pProgram == nullptr)
         return nullptr;
 
-    PipelineEntry& entry = it->second;
-    if (!pShaderManager->IsLoadReady(entry.sVertPath))
-        pShaderManager->RequestLoad(entry.sVertPath);
-    if (!pShaderManager->IsLoadReady(entry.sFragPath))
-        pShaderManager->RequestLoad(entry.sFragPath);
-    if (!pShaderManager->IsLoadReady(entry.sVertPath) || !pShaderManager->IsLoadReady(entry.sFragPath))
+    PipelineVariant& variant = GetVariant(*pProgram, renderPass, pipelineParams, layoutDescriptor, renderPassHasDepth);
+    EnsureBuild(sKey, *pProgram, variant, device, pShaderManager);
+    return variant.handle;
+}
+
+bool PipelineManager::PrewarmPipeline(const std::string& sKey,
+                                      VkDevice device,
+                                      VkRenderPass renderPass,
+                                      VulkanShaderManager* pShaderManager,
+                                      const GraphicsPipelineParams& pipelineParams,
+                                      const PipelineLayoutDescriptor& layoutDescriptor,
+                                      bool renderPassHasDepth) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    if (device == VK_NULL_HANDLE || renderPass == VK_NULL_HANDLE || pShaderManager == nullptr)
+        return false;
+    PipelineProgram* pProgram = FindProgram(sKey);
+    if (pProgram == nullptr)
+        return false;
+
+    m_prewarmDevice = device;
+    m_pPrewarmShaderManager = pShaderManager;
+    PipelineVariant& variant = GetVariant(*pProgram, renderPass, pipelineParams, layoutDescriptor, renderPassHasDepth);
+    variant.bPrewarm = true;
+    EnsureBuild(sKey, *pProgram, variant, device, pShaderManager);
+    return true;
+}
+
+void PipelineManager::ClearPrewarm() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    for (auto& kv : m_programs) {
+        for (PipelineVariant& variant : kv.second.vecVariants)
+            variant.bPrewarm = false;
+    }
+}
+
+PipelinePrewarmProgress PipelineManager::GetPrewarmProgress() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    PipelinePrewarmProgress progress;
+    for (const auto& kv : m_programs) {
+        for (const PipelineVariant& variant : kv.second.vecVariants) {
+            if (!variant.bPrewarm)
+                continue;
+            ++progress.lTotal;
+            // A finished build still waiting for UpdateBuilds counts as ready
+            if (variant.bBuildFailed || (variant.handle && variant.handle->IsValid()) ||
+                (variant.pBuild && JobQueue::IsTaskDone(variant.pBuild->pTask)))
+                ++progress.lReady;
+        }
+    }
+    return progress;
+}
+
+bool PipelineManager::WaitForPrewarm(float fTimeoutMs) {
+    const auto tStart = std::chrono::steady_clock::now();
+    for (;;) {
+        UpdateBuilds();
+        const PipelinePrewarmProgress progress = GetPrewarmProgress();
+        if (progress.lReady >= progress.lTotal)
+            return true;
+        if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count() >= fTimeoutMs) {
+            VulkanUtils::LogWarn("PipelineManager: prewarm timed out with {}/{} pipelines ready", progress.lReady, progress.lTotal);
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+PipelineManager::PipelineProgram* PipelineManager::FindProgram(const std::string& sKey) {
+    auto it = m_keyPrograms.find(sKey);
+    if (it == m_keyPrograms.end())
         return nullptr;
+    return &m_programs[it->second];
+}
+
+PipelineManager::PipelineVariant& PipelineManager::GetVariant(PipelineProgram& program, VkRenderPass renderPass,
+                                                              const GraphicsPipelineParams& pipelineParams,
+                                                              const PipelineLayoutDescriptor& layoutDescriptor,
+                                                              bool renderPassHasDepth) {
+    // States set per draw are not part of the pipeline: e.g. cull NONE and BACK find the same variant
+    const GraphicsPipelineParams params = StripDynamicState(pipelineParams, m_dynamicState);
+    for (PipelineVariant& variant : program.vecVariants) {
+        if (variant.renderPass == renderPass && variant.params == params &&
+            variant.layout == layoutDescriptor && variant.renderPassHasDepth == renderPassHasDepth)
+            return variant;
+    }
+    PipelineVariant& variant = program.vecVariants.emplace_back();
+    variant.renderPass = renderPass;
+    variant.params = params;
+    variant.layout = layoutDescriptor;
+    variant.renderPassHasDepth = renderPassHasDepth;
+    return variant;
+}
 
-    ShaderModulePtr pVert = pShaderManager->GetShaderIfReady(device, entry.sVertPath);
-    ShaderModulePtr pFrag = pShaderManager->GetShaderIfReady(device, entry.sFragPath);
+void PipelineManager::EnsureBuild(const std::string& sKey, const PipelineProgram& program, PipelineVariant& variant,
+                                  VkDevice device, VulkanShaderManager* pShaderManager) {
+    FinishBuild(variant);
+    if (variant.handle || variant.pBuild || variant.bBuildFailed)
+        return;
+    if (!pShaderManager->IsLoadReady(program.sVertPath))
+        pShaderManager->RequestLoad(program.sVertPath);
+    if (!pShaderManager->IsLoadReady(program.sFragPath))
+        pShaderManager->RequestLoad(program.sFragPath);
+    if (!pShaderManager->IsLoadReady(program.sVertPath) || !pShaderManager->IsLoadReady(program.sFragPath))
+        return;
+
+    ShaderModulePtr pVert = pShaderManager->GetShaderIfReady(device, program.sVertPath);
+    ShaderModulePtr pFrag = pShaderManager->GetShaderIfReady(device, program.sFragPath);
     if (!pVert || !pFrag)
-        return nullptr;
+        return;
+    StartBuild(sKey, program, variant, device, pShaderManager, pVert, pFrag);
+}
+
+void PipelineManager::StartBuild(const std::string& sKey, const PipelineProgram& program, PipelineVariant& variant,
+                                 VkDevice device, VulkanShaderManager* pShaderManager, const ShaderModulePtr& pVert,
+                                 const ShaderModulePtr& pFrag) {
+    if (!m_bFirstBuildStarted) {
+        m_bFirstBuildStarted = true;
+        m_tFirstBuild = std::chrono::steady_clock::now();
+    }
+    auto pBuild = std::make_shared<PipelineBuild>();
+    pBuild->handle = std::make_shared<PipelineHandle>();
+    if (m_pJobQueue == nullptr) {
+        const auto tStart = std::chrono::steady_clock::now();
+        pBuild->handle->Create(device, variant.renderPass, pShaderManager, program.sVertPath, program.sFragPath,
+                               variant.params, variant.layout, variant.renderPassHasDepth, m_pipelineCache,
+                               m_dynamicState);
+        m_buildStats.fBuildMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+        ++m_buildStats.lBuilt;
+        variant.handle = std::move(pBuild->handle);
+        return;
+    }
+
+    // The worker gets copies of the build state. It holds the shader modules so a shader trim cannot drop them
+    // before the pipeline takes its own references.
+    variant.pBuild = pBuild;
+    ++m_buildStats.lPending;
+    pBuild->pTask = m_pJobQueue->SubmitTask(
+        [pBuild, sKey, device, pShaderManager, pVert, pFrag, renderPass = variant.renderPass, sVertPath = program.sVertPath,
+         sFragPath = program.sFragPath, params = variant.params, layout = variant.layout,
+         hasDepth = variant.renderPassHasDepth, pipelineCache = m_pipelineCache, dynamicState = m_dynamicState]() {
+            const auto tStart = std::chrono::steady_clock::now();
+            try {
+                pBuild->handle->Create(device, renderPass, pShaderManager, sVertPath, sFragPath,
+                                       params, layout, hasDepth, pipelineCache, dynamicState);
+            } catch (const std::exception& e) {
+                VulkanUtils::LogErr("PipelineManager: build of '{}' failed: {}", sKey, e.what());
+            }
+            pBuild->fMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+        });
+}
 
-    bool renderPassMatch = (entry.renderPass == renderPass);
-    bool paramsMatch    = (entry.lastParams == pipelineParams);
-    bool layoutMatch    = (entry.lastLayout == layoutDescriptor);
-    bool depthMatch     = (entry.lastRenderPassHasDepth == renderPassHasDepth);
-    if (!entry.handle || !entry.handle->IsValid() || !renderPassMatch || !paramsMatch || !layoutMatch || !depthMatch) {
-        if (entry.handle && entry.handle->IsValid()) {
-            m_pendingDestroy.push_back(std::move(entry.handle));
-            entry.handle.reset();
+bool PipelineManager::FinishBuild(PipelineVariant& variant) {
+    if (!variant.pBuild || !JobQueue::IsTaskDone(variant.pBuild->pTask))
+        return false;
+    std::shared_ptr<PipelineBuild> pBuild = std::move(variant.pBuild);
+    variant.pBuild.reset();
+    --m_buildStats.lPending;
+    m_buildStats.fBuildMs += pBuild->fMs;
+    if (!pBuild->handle->IsValid()) {
+        ++m_buildStats.lFailed;
+        variant.bBuildFailed = true;
+        return false;
+    }
+    ++m_buildStats.lBuilt;
+    variant.handle = std::move(pBuild->handle);
+    return true;
+}
+
+uint32_t PipelineManager::UpdateBuilds() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    uint32_t lReady = 0u;
+    for (auto& kv : m_programs) {
+        for (PipelineVariant& variant : kv.second.vecVariants) {
+            if (FinishBuild(variant))
+                ++lReady;
+            else if (variant.bPrewarm && m_pPrewarmShaderManager != nullptr)
+                EnsureBuild(kv.first, kv.second, variant, m_prewarmDevice, m_pPrewarmShaderManager);
         }
-        entry.handle = std::make_shared<PipelineHandle>();
-        entry.handle->Create(device, renderPass, pShaderManager, entry.sVertPath, entry.sFragPath,
-                            pipelineParams, layoutDescriptor, renderPassHasDepth);
-        entry.renderPass = renderPass;
-        entry.lastParams = pipelineParams;
-        entry.lastLayout = layoutDescriptor;
-        entry.lastRenderPassHasDepth = renderPassHasDepth;
     }
-    return entry.handle;
+    if (m_bFirstBuildStarted && m_buildStats.fFirstReadyMs == 0.0f && m_buildStats.lPending == 0u) {
+        m_buildStats.fFirstReadyMs = std::max(
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_tFirstBuild).count(), 0.001f);
+    }
+    return lReady;
+}
+
+PipelineBuildStats PipelineManager::GetBuildStats() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_buildStats;
 }
 
 void PipelineManager::TrimUnused() {
     std::unique_lock<std::shared_mutex> lock(m_mutex);
-    for (auto it = m_entries.begin(); it != m_entries.end(); ) {
-        if (it->second.handle && it->second.handle.use_count() == 1u) {
-            m_pendingDestroy.push_back(std::move(it->second.handle));
-            it = m_entries.erase(it);
-        } else {
-            ++it;
+    // Programs stay (they hold the shader paths from RequestPipeline); only unused pipelines go
+    for (auto& kv : m_programs) {
+        std::vector<PipelineVariant>& vecVariants = kv.second.vecVariants;
+        for (auto it = vecVariants.begin(); it != vecVariants.end(); ) {
+            if (!it->bPrewarm && it->handle && it->handle.use_count() == 1u) {
+                Release(std::move(it->handle));
+                it = vecVariants.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
 }
 
-void PipelineManager::ProcessPendingDestroys() {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    for (auto& p : m_pendingDestroy) {
-        if (p && p->IsValid())
-            p->Destroy();
+void PipelineManager::Release(std::shared_ptr<PipelineHandle> pHandle_in) {
+    if (m_pReleaseQueue == nullptr) {
+        if (pHandle_in->IsValid())
+            pHandle_in->Destroy();
+        return;
     }
-    m_pendingDestroy.clear();
+    m_pReleaseQueue->Defer([pHandle = std::move(pHandle_in)]() {
+        if (pHandle->IsValid())
+            pHandle->Destroy();
+    });
 }
 
 void PipelineManager::DestroyPipelines() {
     std::unique_lock<std::shared_mutex> lock(m_mutex);
-    for (auto& p : m_pendingDestroy) {
-        if (p && p->IsValid())
-            p->Destroy();
-    }
-    m_pendingDestroy.clear();
-    for (auto& kv : m_entries) {
-        if (kv.second.handle && kv.second.handle->IsValid())
-            kv.second.handle->Destroy();
-        kv.second.handle.reset();
-        kv.second.renderPass = VK_NULL_HANDLE;
-        kv.second.lastParams = {};
-        kv.second.lastLayout = {};
-        kv.second.lastRenderPassHasDepth = false;
+    for (auto& kv : m_programs) {
+        for (PipelineVariant& variant : kv.second.vecVariants) {
+            if (variant.pBuild) {
+                // Builds use the render pass and layouts about to be destroyed
+                m_pJobQueue->WaitForTask(variant.pBuild->pTask);
+                m_buildStats.fBuildMs += variant.pBuild->fMs;
+                --m_buildStats.lPending;
+                if (variant.pBuild->handle->IsValid())
+                    variant.pBuild->handle->Destroy();
+                variant.pBuild.reset();
+            }
+            if (variant.handle && variant.handle->IsValid())
+                variant.handle->Destroy();
+        }
+        kv.second.vecVariants.clear();
     }
 }
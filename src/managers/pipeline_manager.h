@@ -2,6 +2,7 @@
 
 #include "vulkan/vulkan_pipeline.h"
 #include "vulkan/vulkan_shader_manager.h"
+#include <chrono>
 #include <map>
 #include <memory>
 #include <shared_mutex>
@@ -9,6 +10,10 @@
 #include <vector>
 #include <vulkan/vulkan.h>
 
+class DeferredReleaseQueue;
+class JobQueue;
+struct TaskResult;
+
 /*
  * Handle that owns a VulkanPipeline. Materials hold shared_ptr<PipelineHandle> so pipelines
  * stay alive while any object uses that material. Destroy() is called at a safe time
@@ -20,7 +25,9 @@ struct PipelineHandle {
                 const std::string& sVertPath, const std::string& sFragPath,
                 const GraphicsPipelineParams& pipelineParams,
                 const PipelineLayoutDescriptor& layoutDescriptor,
-                bool renderPassHasDepth);
+                bool renderPassHasDepth,
+                VkPipelineCache pipelineCache = VK_NULL_HANDLE,
+                const ExtendedDynamicState& dynamicState = {});
     void Destroy();
     VkPipeline Get() const { return m_pipeline.Get(); }
     VkPipelineLayout GetLayout() const { return m_pipeline.GetLayout(); }
@@ -29,21 +36,56 @@ private:
     VulkanPipeline m_pipeline;
 };
 
+/** Pipeline build counters (see PipelineManager::GetBuildStats). */
+struct PipelineBuildStats {
+    uint32_t lBuilt = 0u;
+    uint32_t lFailed = 0u;
+    uint32_t lPending = 0u;       // Builds running on workers
+    float    fBuildMs = 0.0f;     // Sum of build times (worker CPU time)
+    /* Wall time from the first build request until no build was pending for the first time (0 = not yet):
+       startup pipeline cost, compare cold vs warm pipeline cache. */
+    float    fFirstReadyMs = 0.0f;
+};
+
+/** Pipelines pinned by PipelineManager::PrewarmPipeline: lReady counts the built and the failed ones. */
+struct PipelinePrewarmProgress {
+    uint32_t lTotal = 0u;
+    uint32_t lReady = 0u;
+};
+
 /*
- * Pipeline manager: request pipelines by key; returns shared_ptr<PipelineHandle>. TrimUnused()
- * moves unused handles to a pending list; call ProcessPendingDestroys() after vkWaitForFences
- * to destroy them safely. DestroyPipelines() on swapchain recreate.
+ * Pipeline manager: request pipelines by key; returns shared_ptr<PipelineHandle>. Keys with the same shaders share
+ * one pipeline per state they are asked for (render pass, params, layout, depth), so materials that share shaders
+ * (e.g. main_tex and main_tex_ds) or a wireframe material used by two render passes do not replace each other's
+ * pipelines. With extended dynamic state set, params that differ only in dynamic state (cull mode, front face,
+ * depth, polygon mode) are the same state: solid, double-sided and wireframe materials draw with one pipeline.
+ * Trimmed handles go to the DeferredReleaseQueue and are destroyed once no frame in flight can use them.
+ * DestroyPipelines() on swapchain recreate.
+ * With a JobQueue set, pipelines are built on worker threads: GetPipelineHandleIfReady returns nullptr until the
+ * build is done, and UpdateBuilds (once per frame) reports builds that finished so draw lists can pick them up.
+ * PrewarmPipeline starts a build ahead of the first draw (level load) and keeps it through TrimUnused.
  */
 class PipelineManager {
 public:
     PipelineManager() = default;
 
+    /** Queue for trimmed / replaced pipelines. nullptr = destroy at once (device must be idle). */
+    void SetReleaseQueue(DeferredReleaseQueue* pReleaseQueue) { m_pReleaseQueue = pReleaseQueue; }
+    /** Workers for pipeline builds. nullptr = build on the calling thread. */
+    void SetJobQueue(JobQueue* pJobQueue) { m_pJobQueue = pJobQueue; }
+    /** Cache passed to every pipeline build (VulkanPipelineCache). */
+    void SetPipelineCache(VkPipelineCache pipelineCache) { m_pipelineCache = pipelineCache; }
+    /** Dynamic state pipelines are built with (VulkanDevice::GetExtendedDynamicState). Set before the first
+     *  pipeline is requested; draws must then set the state themselves (CmdSetRasterDynamicState). */
+    void SetExtendedDynamicState(const ExtendedDynamicState& dynamicState) { m_dynamicState = dynamicState; }
+
     void RequestPipeline(const std::string& sKey,
                          VulkanShaderManager* pShaderManager,
                          const std::string& sVertPath,
                          const std::string& sFragPath);
 
-    /** Non-blocking: return shared_ptr<PipelineHandle> when shaders ready and pipeline built; else nullptr. */
+    /** Non-blocking: return shared_ptr<PipelineHandle> when shaders ready and pipeline built; else nullptr
+     *  (starts the build when needed). */
     std::shared_ptr<PipelineHandle> GetPipelineHandleIfReady(const std::string& sKey,
                                                              VkDevice device,
                                                              VkRenderPass renderPass,
@@ -52,25 +94,85 @@ public:
                                                              const PipelineLayoutDescriptor& layoutDescriptor,
                                                              bool renderPassHasDepth);
 
-    /** Remove cache entries where use_count() == 1; moved to pending destroy. Call once per frame. */
-    void TrimUnused();
+    /** Start building the pipeline for this state before anything draws with it; pinned until ClearPrewarm.
+     *  Waits for the shaders if they are still loading (UpdateBuilds starts the build). False if sKey is unknown. */
+    bool PrewarmPipeline(const std::string& sKey,
+                         VkDevice device,
+                         VkRenderPass renderPass,
+                         VulkanShaderManager* pShaderManager,
+                         const GraphicsPipelineParams& pipelineParams,
+                         const PipelineLayoutDescriptor& layoutDescriptor,
+                         bool renderPassHasDepth);
+    /** Unpin every prewarmed pipeline (next level); unused ones go with the next TrimUnused. */
+    void ClearPrewarm();
+    PipelinePrewarmProgress GetPrewarmProgress() const;
+    /** Block until every prewarmed pipeline is built or failed, at most fTimeoutMs. False on timeout. Main thread. */
+    bool WaitForPrewarm(float fTimeoutMs);
 
-    /** Destroy pipelines that were trimmed. Call at start of frame after vkWaitForFences. */
-    void ProcessPendingDestroys();
+    /** Take finished worker builds. Returns how many pipelines became ready (rebuild draw batches). Main thread. */
+    uint32_t UpdateBuilds();
 
+    PipelineBuildStats GetBuildStats() const;
+
+    /** Drop pipelines where use_count() == 1 (and not prewarmed); handed to the release queue. Main thread. */
+    void TrimUnused();
+
+    /** Waits for builds in flight, then destroys every pipeline. */
     void DestroyPipelines();
 
 private:
-    struct PipelineEntry {
-        std::string                    sVertPath;
-        std::string                    sFragPath;
+    /** A pipeline being built on a worker; fMs is written by the worker before pTask completes. */
+    struct PipelineBuild {
+        std::shared_ptr<PipelineHandle> handle;
+        std::shared_ptr<TaskResult>     pTask;
+        float                           fMs = 0.0f;
+    };
+    /** One pipeline of a program: the state it is built for (dynamic state stripped) and its build. */
+    struct PipelineVariant {
+        VkRenderPass                    renderPass = VK_NULL_HANDLE;
+        GraphicsPipelineParams          params = {};
+        PipelineLayoutDescriptor        layout = {};
+        bool                            renderPassHasDepth = false;
         std::shared_ptr<PipelineHandle> handle;
-        VkRenderPass                   renderPass = VK_NULL_HANDLE;
-        GraphicsPipelineParams         lastParams = {};
-        PipelineLayoutDescriptor       lastLayout = {};
-        bool                           lastRenderPassHasDepth = false;
+        std::shared_ptr<PipelineBuild>  pBuild;                // Build in flight
+        bool                            bBuildFailed = false;  // Not retried for this state
+        bool                            bPrewarm = false;      // Pinned by PrewarmPipeline
+    };
+    /** Shader pair shared by every key requested with it, and its pipelines. */
+    struct PipelineProgram {
+        std::string                  sVertPath;
+        std::string                  sFragPath;
+        std::vector<PipelineVariant> vecVariants;
     };
-    std::map<std::string, PipelineEntry> m_entries;
-    std::vector<std::shared_ptr<PipelineHandle>> m_pendingDestroy;
+
+    /** Program of sKey; nullptr when sKey was never requested (caller holds m_mutex). */
+    PipelineProgram* FindProgram(const std::string& sKey);
+    /** Variant of program for this state; added (not built) when missing (caller holds m_mutex). */
+    PipelineVariant& GetVariant(PipelineProgram& program, VkRenderPass renderPass,
+                                const GraphicsPipelineParams& pipelineParams,
+                                const PipelineLayoutDescriptor& layoutDescriptor, bool renderPassHasDepth);
+    /** Destroy pHandle_in once frames in flight are done with it (caller holds m_mutex). */
+    void Release(std::shared_ptr<PipelineHandle> pHandle_in);
+    /** Start variant's build unless it is built, building or failed; waits for the shaders (caller holds m_mutex). */
+    void EnsureBuild(const std::string& sKey, const PipelineProgram& program, PipelineVariant& variant, VkDevice device,
+                     VulkanShaderManager* pShaderManager);
+    /** Build variant's pipeline, on a worker when a JobQueue is set (caller holds m_mutex). */
+    void StartBuild(const std::string& sKey, const PipelineProgram& program, PipelineVariant& variant, VkDevice device,
+                    VulkanShaderManager* pShaderManager, const ShaderModulePtr& pVert, const ShaderModulePtr& pFrag);
+    /** Take variant's build if it has finished; true when it produced a pipeline (caller holds m_mutex). */
+    bool FinishBuild(PipelineVariant& variant);
+
+    std::map<std::string, std::string> m_keyPrograms;      // Key -> m_programs key (vert and frag path)
+    std::map<std::string, PipelineProgram> m_programs;
+    DeferredReleaseQueue* m_pReleaseQueue = nullptr;
+    JobQueue* m_pJobQueue = nullptr;
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+    ExtendedDynamicState m_dynamicState = {};
+    /* Last PrewarmPipeline arguments: UpdateBuilds starts prewarmed builds whose shaders were still loading. */
+    VkDevice m_prewarmDevice = VK_NULL_HANDLE;
+    VulkanShaderManager* m_pPrewarmShaderManager = nullptr;
+    PipelineBuildStats m_buildStats;
+    bool m_bFirstBuildStarted = false;
+    std::chrono::steady_clock::time_point m_tFirstBuild;
     mutable std::shared_mutex m_mutex;
 };
@@ -10,8 +10,8 @@ class VulkanShaderManager;
 
 /**
  * ResourceCleanupManager — centralized interface for trimming all manager caches.
- * Enqueued on worker thread to trim unused resources asynchronously.
- * Called once per frame by ResourceManagerThread.
+ * Main thread, when references can have dropped (draw list rebuild, level change); not every frame.
+ * Trimmed GPU objects go to the managers' DeferredReleaseQueue, so trimming never destroys anything in use.
  */
 class ResourceCleanupManager {
 public:
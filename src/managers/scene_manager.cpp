@@ -9,13 +9,20 @@
 #include "core/transform.h"
 #include "gltf_mesh_utils.h"
 #include "procedural_mesh_factory.h"
+#include "vmesh_format.h"
+#include "thread/job_queue.h"
 #include "vulkan/vulkan_utils.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <set>
+#include <unordered_map>
 #include <unordered_set>
 #include <tiny_gltf.h>
 
@@ -29,6 +36,18 @@ using json = nlohmann::json;
 // File-scoped glTF model cache (avoids incomplete type issues in header)
 // ============================================================================
 static std::map<std::string, std::unique_ptr<tinygltf::Model>> s_gltfModelCache;
+/** Content hash per cached glTF (file bytes + external buffers); keys cooked .vmesh files. 0 = unknown (no cooking). */
+static std::map<std::string, uint64_t> s_gltfSourceHashCache;
+
+/** Vertex data extracted on a worker during PrefetchGltfSources; consumed (moved out) by VisitGltfNode. */
+struct PreparedGltfMesh {
+    std::vector<VertexData> vertices;
+    std::vector<Meshlet> meshlets;
+    double fDecodeMs = 0.0;
+};
+static std::map<std::string, PreparedGltfMesh> s_preparedGltfMeshes;
+/** Textures cooked (mips + BC) or found in the .vtex cache on a worker after parse, by texture cache key; consumed by VisitGltfNode. */
+static std::map<std::string, CookedTextureResult> s_preparedGltfTextures;
 
 namespace {
 
@@ -210,6 +229,278 @@ void BuildNodeLocalMatrix(const tinygltf::Node& node, float* out16) {
     ObjectSetFromPositionRotationScale(out16, tx, ty, tz, qx, qy, qz, qw, sx, sy, sz);
 }
 
+/** Content hash for cooked meshes: file bytes plus external buffers (.gltf + .bin edits both invalidate). 0 = unreadable. */
+uint64_t ComputeGltfSourceHash(const std::string& path, const tinygltf::Model& model) {
+    uint64_t uHash = 0u;
+    if (!HashFileContents(path, uHash))
+        return 0u;
+    for (const tinygltf::Buffer& buffer : model.buffers) {
+        if (!buffer.uri.empty() && !buffer.data.empty())
+            uHash = HashBytesFnv1a(buffer.data.data(), buffer.data.size(), uHash);
+    }
+    return (uHash != 0u) ? uHash : 1u;
+}
+
+/** Worker task: read + parse one glTF (tinygltf decodes its images here) and hash it. */
+struct GltfParseTask {
+    std::string path;
+    bool hashSource = false;
+    std::unique_ptr<tinygltf::Model> pModel;
+    uint64_t sourceHash = 0u;
+};
+
+void RunGltfParseTask(GltfParseTask* pTask) {
+    GltfLoader loader;
+    loader.SetDeferImageDecode(true);  // Texture tasks decode only on a .vtex cache miss
+    if (!loader.LoadFromFile(pTask->path))
+        return;
+    pTask->pModel = loader.ReleaseModel();
+    if (pTask->hashSource)
+        pTask->sourceHash = ComputeGltfSourceHash(pTask->path, *pTask->pModel);
+}
+
+/** Worker task: extract one primitive unless its cooked .vmesh is valid (then the main thread maps it). */
+struct GltfMeshTask {
+    const tinygltf::Model* pModel = nullptr;
+    int meshIndex = -1;
+    int primIndex = -1;
+    std::string key;
+    std::string cookedPath;  // Empty = no cooked lookup
+    uint64_t sourceHash = 0u;
+    bool decoded = false;
+    PreparedGltfMesh result;
+};
+
+void RunGltfMeshTask(GltfMeshTask* pTask) {
+    if (!pTask->cookedPath.empty()) {
+        MappedFile cooked;
+        VMeshView view;
+        if (cooked.Open(pTask->cookedPath) &&
+            ParseVMesh(cooked.GetData(), cooked.GetSize(), HashBytesFnv1a(pTask->key.data(), pTask->key.size()), pTask->sourceHash, view))
+            return;
+    }
+    const auto decodeStart = std::chrono::steady_clock::now();
+    pTask->decoded = GetMeshDataFromGltf(*pTask->pModel, pTask->meshIndex, pTask->primIndex,
+                                         pTask->result.vertices, &pTask->result.meshlets);
+    pTask->result.fDecodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+}
+
+/** Insert a finished parse task into the model/hash caches. False if the source failed to load. */
+bool AdoptParsedGltf(GltfParseTask& task) {
+    if (!task.pModel)
+        return false;
+    const tinygltf::Model* pModel = task.pModel.get();
+    s_gltfModelCache[task.path] = std::move(task.pModel);
+    if (task.sourceHash != 0u)
+        s_gltfSourceHashCache[task.path] = task.sourceHash;
+    VulkanUtils::LogInfo("SceneManager: cached glTF \"{}\" ({} meshes, {} materials)",
+                         task.path, pModel->meshes.size(), pModel->materials.size());
+    return true;
+}
+
+/** One GltfMeshTask per node-referenced primitive of a cached source that is neither resident nor prepared yet. */
+void SubmitGltfMeshTasks(MeshManager& meshManager, JobQueue& jobQueue, const std::string& path,
+                         std::vector<std::unique_ptr<GltfMeshTask>>& tasks,
+                         std::vector<std::shared_ptr<TaskResult>>& handles) {
+    auto itModel = s_gltfModelCache.find(path);
+    if (itModel == s_gltfModelCache.end())
+        return;
+    const tinygltf::Model& model = *itModel->second;
+    auto itHash = s_gltfSourceHashCache.find(path);
+    const uint64_t sourceHash = (meshManager.IsMeshCookingEnabled() && itHash != s_gltfSourceHashCache.end()) ? itHash->second : 0u;
+    std::set<int> usedMeshes;
+    for (const tinygltf::Node& node : model.nodes) {
+        if (node.mesh >= 0 && size_t(node.mesh) < model.meshes.size())
+            usedMeshes.insert(node.mesh);
+    }
+    for (int meshIndex : usedMeshes) {
+        const tinygltf::Mesh& mesh = model.meshes[size_t(meshIndex)];
+        for (size_t primIndex = 0; primIndex < mesh.primitives.size(); ++primIndex) {
+            if (mesh.primitives[primIndex].material < 0)
+                continue;  // Skipped by VisitGltfNode
+            std::string key = path + ":" + std::to_string(meshIndex) + ":" + std::to_string(primIndex);
+            if (meshManager.GetMesh(key) || s_preparedGltfMeshes.count(key) != 0u)
+                continue;
+            auto pTask = std::make_unique<GltfMeshTask>();
+            pTask->pModel = &model;
+            pTask->meshIndex = meshIndex;
+            pTask->primIndex = static_cast<int>(primIndex);
+            if (sourceHash != 0u) {
+                pTask->cookedPath = GetVMeshCachePath(meshManager.GetCookedMeshDir(), key);
+                pTask->sourceHash = sourceHash;
+            }
+            pTask->key = std::move(key);
+            handles.push_back(jobQueue.SubmitTask(std::bind(&RunGltfMeshTask, pTask.get())));
+            tasks.push_back(std::move(pTask));
+        }
+    }
+}
+
+/**
+ * Texture cache key and image of one material texture slot. The role prefix keeps e.g. an image used as both
+ * base colour and occlusion in two differently encoded textures. False if the slot has no decoded image.
+ */
+bool ResolveGltfTexture(const tinygltf::Model& model, const std::string& gltfPath, int texIndex, TextureRole role,
+                        std::string& key, const tinygltf::Image*& pImage) {
+    if (texIndex < 0 || size_t(texIndex) >= model.textures.size())
+        return false;
+    const tinygltf::Texture& tex = model.textures[size_t(texIndex)];
+    if (tex.source < 0 || size_t(tex.source) >= model.images.size())
+        return false;
+    const tinygltf::Image& img = model.images[size_t(tex.source)];
+    if (img.image.empty() || img.width <= 0 || img.height <= 0 || img.component <= 0)
+        return false;
+    const char* prefix = "";
+    switch (role) {
+    case TextureRole::BaseColor:         prefix = ""; break;
+    case TextureRole::MetallicRoughness: prefix = "mr_"; break;
+    case TextureRole::Emissive:          prefix = "em_"; break;
+    case TextureRole::Normal:            prefix = "nrm_"; break;
+    case TextureRole::Occlusion:         prefix = "occ_"; break;
+    }
+    key = prefix + (img.uri.empty() ? ("tex_" + gltfPath + "_" + std::to_string(tex.source)) : img.uri);
+    pImage = &img;
+    return true;
+}
+
+/** Texture slots of a glTF material with the role each one is encoded for. */
+void GetGltfMaterialTextures(const tinygltf::Material& gltfMat, std::vector<std::pair<int, TextureRole>>& out) {
+    out.push_back({gltfMat.pbrMetallicRoughness.baseColorTexture.index, TextureRole::BaseColor});
+    out.push_back({gltfMat.pbrMetallicRoughness.metallicRoughnessTexture.index, TextureRole::MetallicRoughness});
+    out.push_back({gltfMat.emissiveTexture.index, TextureRole::Emissive});
+    out.push_back({gltfMat.normalTexture.index, TextureRole::Normal});
+    out.push_back({gltfMat.occlusionTexture.index, TextureRole::Occlusion});
+}
+
+/**
+ * Worker task: validate the cooked .vtex of one image, or decode + expand + mip + BC-encode it (and write the .vtex).
+ * Images are kept encoded by the parse task (GltfLoader::SetDeferImageDecode), so a warm cache skips decoding entirely.
+ */
+struct GltfTextureTask {
+    const TextureManager* pTextureManager = nullptr;
+    const tinygltf::Image* pImage = nullptr;
+    TextureRole role = TextureRole::BaseColor;
+    std::string key;
+    bool cooked = false;
+    CookedTextureResult result;
+};
+
+void RunGltfTextureTask(GltfTextureTask* pTask) {
+    const tinygltf::Image& img = *pTask->pImage;
+    if (img.as_is) {
+        pTask->cooked = pTask->pTextureManager->CookEncodedTexture(pTask->role, img.image.data(), img.image.size(), pTask->result);
+        return;
+    }
+    const auto cookStart = std::chrono::steady_clock::now();
+    pTask->cooked = pTask->pTextureManager->CookTexture(pTask->role, img.width, img.height, img.component,
+                                                         img.image.data(), pTask->result.stData);
+    pTask->result.fCookMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cookStart).count();
+}
+
+/** One GltfTextureTask per material texture slot of a cached source that is neither resident nor prepared yet. */
+void SubmitGltfTextureTasks(const TextureManager& textureManager, JobQueue& jobQueue, const std::string& path,
+                            std::vector<std::unique_ptr<GltfTextureTask>>& tasks,
+                            std::vector<std::shared_ptr<TaskResult>>& handles) {
+    auto itModel = s_gltfModelCache.find(path);
+    if (itModel == s_gltfModelCache.end())
+        return;
+    const tinygltf::Model& model = *itModel->second;
+    std::set<std::string> seenKeys;
+    std::vector<std::pair<int, TextureRole>> slots;
+    for (const tinygltf::Material& gltfMat : model.materials)
+        GetGltfMaterialTextures(gltfMat, slots);
+    for (const auto& [texIndex, role] : slots) {
+        std::string key;
+        const tinygltf::Image* pImage = nullptr;
+        if (!ResolveGltfTexture(model, path, texIndex, role, key, pImage))
+            continue;
+        if (!seenKeys.insert(key).second || textureManager.GetTexture(key) || s_preparedGltfTextures.count(key) != 0u)
+            continue;
+        auto pTask = std::make_unique<GltfTextureTask>();
+        pTask->pTextureManager = &textureManager;
+        pTask->pImage = pImage;
+        pTask->role = role;
+        pTask->key = std::move(key);
+        handles.push_back(jobQueue.SubmitTask(std::bind(&RunGltfTextureTask, pTask.get())));
+        tasks.push_back(std::move(pTask));
+    }
+}
+
+/** Move the output of finished texture tasks into s_preparedGltfTextures (tasks must be done). */
+void HarvestGltfTextureTasks(std::vector<std::unique_ptr<GltfTextureTask>>& tasks) {
+    for (std::unique_ptr<GltfTextureTask>& pTask : tasks) {
+        if (pTask->cooked)
+            s_preparedGltfTextures[pTask->key] = std::move(pTask->result);
+    }
+    tasks.clear();
+}
+
+/** Resident texture for a material slot: prepared by a worker if possible, otherwise cooked here. Null if unset. */
+std::shared_ptr<TextureHandle> LoadGltfTexture(TextureManager& textureManager, const tinygltf::Model& model,
+                                               const std::string& gltfPath, int texIndex, TextureRole role) {
+    std::string key;
+    const tinygltf::Image* pImage = nullptr;
+    if (!ResolveGltfTexture(model, gltfPath, texIndex, role, key, pImage))
+        return nullptr;
+    auto itPrepared = s_preparedGltfTextures.find(key);
+    if (itPrepared != s_preparedGltfTextures.end()) {
+        std::shared_ptr<TextureHandle> pTexture = textureManager.GetOrCreateFromCookResult(key, role, itPrepared->second);
+        s_preparedGltfTextures.erase(itPrepared);
+        if (pTexture)
+            return pTexture;
+    }
+    if (pImage->as_is)
+        return textureManager.GetOrCreateFromEncoded(key, pImage->image.data(), pImage->image.size(), role);
+    return textureManager.GetOrCreateFromMemory(key, pImage->width, pImage->height, pImage->component, pImage->image.data(), role);
+}
+
+/** Move the output of finished mesh tasks into s_preparedGltfMeshes (tasks must be done). */
+void HarvestGltfMeshTasks(std::vector<std::unique_ptr<GltfMeshTask>>& tasks) {
+    for (std::unique_ptr<GltfMeshTask>& pTask : tasks) {
+        if (pTask->decoded)
+            s_preparedGltfMeshes[pTask->key] = std::move(pTask->result);
+    }
+    tasks.clear();
+}
+
+bool ReadLevelJson(const std::string& path, json& j) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        VulkanUtils::LogErr("SceneManager: cannot open level \"{}\"", path);
+        return false;
+    }
+    try {
+        in >> j;
+    } catch (const json::exception&) {
+        VulkanUtils::LogErr("SceneManager: invalid JSON in level \"{}\"", path);
+        return false;
+    }
+    return true;
+}
+
+void LogMeshImportStats(const MeshImportStats& stats) {
+    VulkanUtils::LogInfo("SceneManager: mesh import: {} primitives decoded ({} verts, {:.2f} ms), {} from cooked cache",
+                         stats.lDecodedPrimitives, stats.uDecodedVertices, stats.fDecodeMs, stats.lCookedPrimitives);
+}
+
+void LogTextureCookStats(const TextureManager* pTextureManager) {
+    if (pTextureManager == nullptr)
+        return;
+    const TextureCookStats& stats = pTextureManager->GetCookStats();
+    VulkanUtils::LogInfo("SceneManager: texture import: {} cooked from source ({:.2f} ms), {} from cooked cache",
+                         stats.lCooked, stats.fCookMs, stats.lFromCache);
+}
+
+/** "warm" when nothing had to be decoded from source (every primitive and texture came from the cooked caches). */
+const char* GetImportTemperature(const MeshImportStats& stats, const TextureManager* pTextureManager) {
+    const uint32_t lTexturesCooked = (pTextureManager != nullptr) ? pTextureManager->GetCookStats().lCooked : 0u;
+    return (stats.lDecodedPrimitives == 0u && lTexturesCooked == 0u) ? "warm" : "cold";
+}
+
+/** Progressive load placeholder: procedural cube tinted grey, replaced once the glTF is resident. */
+const char* const kPlaceholderMeshSource = "procedural:cube";
+constexpr float kPlaceholderColor[4] = {0.6f, 0.6f, 0.6f, 1.f};
+
 } // namespace
 
 /**
@@ -239,8 +530,276 @@ struct GltfNodeVisitorContext {
     std::vector<std::pair<size_t, int>> objParentNodePairs;
     // Current parent node index being visited (-1 for root)
     int currentParentNode = -1;
+    // Source content hash for cooked meshes (0 = do not use/write .vmesh)
+    uint64_t sourceHash = 0u;
+};
+
+/**
+ * One entry of a level's "instances" array with model defaults and overrides resolved.
+ * Shared by LoadLevelFromFile and the progressive path (BeginLevelLoadAsync).
+ */
+struct LevelInstanceDesc {
+    std::string source;
+    std::string gltfPath;  // baseDir / source; empty for "procedural:" sources
+    std::string instanceName;
+    std::string parentName;
+    std::string materialOverride;
+    RenderMode renderMode = RenderMode::Auto;
+    InstanceTier instanceTier = InstanceTier::Static;
+    float transform[16];
+    bool hasColorOverride = false;
+    float colorOverride[4] = {1.f, 1.f, 1.f, 1.f};
+    bool hasEmissiveOverride = false;
+    float emissiveOverride[4] = {0.f, 0.f, 0.f, 1.f};
+    bool hasMetallicOverride = false;
+    float metallicOverride = 1.0f;
+    bool hasRoughnessOverride = false;
+    float roughnessOverride = 1.0f;
+};
+
+/** Progressive load: one glTF source moving through parse -> primitive extraction + texture cooking on the JobQueue. */
+struct AsyncGltfSource {
+    enum class Stage { Parsing, Parsed, Extracting, Ready, Failed };
+    Stage stage = Stage::Parsing;
+    std::unique_ptr<GltfParseTask> pParseTask;
+    std::shared_ptr<TaskResult> pParseDone;  // Null if the model was already cached
+    std::vector<std::unique_ptr<GltfMeshTask>> meshTasks;
+    std::vector<std::unique_ptr<GltfTextureTask>> textureTasks;
+    std::vector<std::shared_ptr<TaskResult>> extractDone;  // Mesh and texture tasks
+    uint32_t renderModeMask = 0u;  // Bit per RenderMode of the instances using this source
+};
+
+/** Progressive load: a glTF instance drawn as a placeholder until its source is Ready. */
+struct AsyncLevelInstance {
+    LevelInstanceDesc desc;
+    uint32_t placeholderId = UINT32_MAX;
+    bool resolved = false;
 };
 
+/** State of a progressive load, from BeginLevelLoadAsync to FinishLevelLoad / CancelLevelLoad. */
+struct AsyncLevelLoad {
+    std::string path;
+    std::chrono::steady_clock::time_point startTime;
+    std::map<std::string, AsyncGltfSource> sources;  // By resolved glTF path
+    std::vector<AsyncLevelInstance> instances;
+    uint32_t resolvedCount = 0u;
+    // JSON "parent" references; a parent may be a glTF node that only appears once its instance resolves
+    std::unordered_map<std::string, uint32_t> nameToId;
+    std::vector<std::pair<uint32_t, std::string>> pendingParents;  // (childId, parent name)
+};
+
+namespace {
+
+/** Parse "models" (reusable templates) and "instances" of a level JSON. Invalid instances are logged and skipped. */
+void ParseLevelInstances(const json& j, const std::filesystem::path& baseDir, std::vector<LevelInstanceDesc>& out) {
+    struct ModelDef {
+        std::string source;
+        std::string renderMode = "auto";
+        std::string instanceTier = "static";
+    };
+    std::map<std::string, ModelDef> modelDefs;
+    
+    if (j.contains("models") && j["models"].is_object()) {
+        for (auto& [modelName, modelJson] : j["models"].items()) {
+            if (!modelJson.is_object()) continue;
+            
+            ModelDef def;
+            if (modelJson.contains("source") && modelJson["source"].is_string()) {
+                def.source = modelJson["source"].get<std::string>();
+            }
+            if (modelJson.contains("renderMode") && modelJson["renderMode"].is_string()) {
+                def.renderMode = modelJson["renderMode"].get<std::string>();
+            }
+            if (modelJson.contains("instanceTier") && modelJson["instanceTier"].is_string()) {
+                def.instanceTier = modelJson["instanceTier"].get<std::string>();
+            }
+            
+            if (!def.source.empty()) {
+                modelDefs[modelName] = def;
+                VulkanUtils::LogInfo("SceneManager: registered model definition \"{}\" -> \"{}\"", 
+                                     modelName, def.source);
+            }
+        }
+    }
+
+    if (!j.contains("instances") || !j["instances"].is_array())
+        return;
+
+    for (const auto& jInst : j["instances"]) {
+        if (!jInst.is_object())
+            continue;
+        
+        LevelInstanceDesc desc;
+        std::string defaultRenderMode = "auto";
+        std::string defaultInstanceTier = "static";
+        
+        // Check for model reference first (new format)
+        if (jInst.contains("model") && jInst["model"].is_string()) {
+            const std::string modelRef = jInst["model"].get<std::string>();
+            auto it = modelDefs.find(modelRef);
+            if (it != modelDefs.end()) {
+                desc.source = it->second.source;
+                defaultRenderMode = it->second.renderMode;
+                defaultInstanceTier = it->second.instanceTier;
+            } else {
+                VulkanUtils::LogErr("SceneManager: unknown model reference \"{}\"", modelRef);
+                continue;
+            }
+        }
+        // Fall back to direct source (legacy format)
+        else if (jInst.contains("source") && jInst["source"].is_string()) {
+            desc.source = jInst["source"].get<std::string>();
+        }
+        else {
+            continue; // Neither model nor source specified
+        }
+        
+        // Parse instance name (override for source, used for parenting references)
+        if (jInst.contains("name") && jInst["name"].is_string()) {
+            desc.instanceName = jInst["name"].get<std::string>();
+        }
+        
+        // Parse parent reference (name of another instance)
+        if (jInst.contains("parent") && jInst["parent"].is_string()) {
+            desc.parentName = jInst["parent"].get<std::string>();
+        }
+        if (desc.source.empty())
+            continue;
+
+        // Parse renderMode (instance override takes precedence over model default)
+        std::string modeStr = defaultRenderMode;
+        if (jInst.contains("renderMode") && jInst["renderMode"].is_string()) {
+            modeStr = jInst["renderMode"].get<std::string>();
+        }
+        if (modeStr == "solid") desc.renderMode = RenderMode::Solid;
+        else if (modeStr == "wireframe") desc.renderMode = RenderMode::Wireframe;
+        else if (modeStr == "auto") desc.renderMode = RenderMode::Auto;
+        else {
+            VulkanUtils::LogErr("SceneManager: unknown renderMode \"{}\" for source \"{}\"", modeStr, desc.source);
+            continue;
+        }
+
+        // Parse instance tier (instance override takes precedence over model default)
+        std::string tierStr = defaultInstanceTier;
+        if (jInst.contains("instanceTier") && jInst["instanceTier"].is_string()) {
+            tierStr = jInst["instanceTier"].get<std::string>();
+        }
+        desc.instanceTier = ParseInstanceTier(tierStr);
+
+        float pos[3] = { 0.f, 0.f, 0.f };
+        float rot[4] = { 0.f, 0.f, 0.f, 1.f };
+        float scale[3] = { 1.f, 1.f, 1.f };
+        if (jInst.contains("position") && jInst["position"].is_array() && jInst["position"].size() >= 3) {
+            pos[0] = static_cast<float>(jInst["position"][0].get<double>());
+            pos[1] = static_cast<float>(jInst["position"][1].get<double>());
+            pos[2] = static_cast<float>(jInst["position"][2].get<double>());
+        }
+        if (jInst.contains("rotation") && jInst["rotation"].is_array() && jInst["rotation"].size() >= 4) {
+            rot[0] = static_cast<float>(jInst["rotation"][0].get<double>());
+            rot[1] = static_cast<float>(jInst["rotation"][1].get<double>());
+            rot[2] = static_cast<float>(jInst["rotation"][2].get<double>());
+            rot[3] = static_cast<float>(jInst["rotation"][3].get<double>());
+        }
+        if (jInst.contains("scale") && jInst["scale"].is_array() && jInst["scale"].size() >= 3) {
+            scale[0] = static_cast<float>(jInst["scale"][0].get<double>());
+            scale[1] = static_cast<float>(jInst["scale"][1].get<double>());
+            scale[2] = static_cast<float>(jInst["scale"][2].get<double>());
+        }
+
+        ObjectSetFromPositionRotationScale(desc.transform,
+            pos[0], pos[1], pos[2],
+            rot[0], rot[1], rot[2], rot[3],
+            scale[0], scale[1], scale[2]);
+
+        if (jInst.contains("color") && jInst["color"].is_array() && jInst["color"].size() >= 4) {
+            desc.hasColorOverride = true;
+            desc.colorOverride[0] = static_cast<float>(jInst["color"][0].get<double>());
+            desc.colorOverride[1] = static_cast<float>(jInst["color"][1].get<double>());
+            desc.colorOverride[2] = static_cast<float>(jInst["color"][2].get<double>());
+            desc.colorOverride[3] = static_cast<float>(jInst["color"][3].get<double>());
+        }
+
+        if (jInst.contains("emissive") && jInst["emissive"].is_array() && jInst["emissive"].size() >= 4) {
+            desc.hasEmissiveOverride = true;
+            desc.emissiveOverride[0] = static_cast<float>(jInst["emissive"][0].get<double>());
+            desc.emissiveOverride[1] = static_cast<float>(jInst["emissive"][1].get<double>());
+            desc.emissiveOverride[2] = static_cast<float>(jInst["emissive"][2].get<double>());
+            desc.emissiveOverride[3] = static_cast<float>(jInst["emissive"][3].get<double>());
+        }
+
+        // Parse metallic factor (default 1.0 for metals, override in JSON for procedural meshes)
+        if (jInst.contains("metallic") && jInst["metallic"].is_number()) {
+            desc.hasMetallicOverride = true;
+            desc.metallicOverride = static_cast<float>(jInst["metallic"].get<double>());
+        }
+
+        // Parse roughness factor (default 1.0, override in JSON for procedural meshes)
+        if (jInst.contains("roughness") && jInst["roughness"].is_number()) {
+            desc.hasRoughnessOverride = true;
+            desc.roughnessOverride = static_cast<float>(jInst["roughness"].get<double>());
+        }
+
+        // Optional material override for procedural instances (e.g. "time_demo")
+        if (jInst.contains("material") && jInst["material"].is_string()) {
+            desc.materialOverride = jInst["material"].get<std::string>();
+        }
+
+        if (desc.source.rfind("procedural:", 0) != 0)
+            desc.gltfPath = (baseDir / desc.source).string();
+        out.push_back(std::move(desc));
+    }
+}
+
+/** Apply queued JSON parent references whose parent exists by now. bFinal: report and drop the rest. */
+void ResolvePendingParents(Scene& scene, AsyncLevelLoad& load, bool bFinal) {
+    for (auto it = load.pendingParents.begin(); it != load.pendingParents.end();) {
+        const GameObject* pChild = scene.FindGameObject(it->first);
+        const std::string childName = pChild ? pChild->name : std::string();
+        auto itParent = load.nameToId.find(it->second);
+        if (itParent == load.nameToId.end()) {
+            if (!bFinal) {
+                ++it;
+                continue;
+            }
+            VulkanUtils::LogErr("SceneManager: parent \"{}\" not found for object \"{}\"", it->second, childName);
+        } else if (!scene.SetParent(it->first, itParent->second, true)) {
+            VulkanUtils::LogErr("SceneManager: failed to set parent \"{}\" for object \"{}\"", it->second, childName);
+        }
+        it = load.pendingParents.erase(it);
+    }
+}
+
+/**
+ * Drop a glTF instance's placeholder once its real objects exist (or its source failed). Objects parented to it by
+ * name go back to the pending list under that name, so they resolve like the sync loader would (to a glTF node of
+ * that name, or an error at the end of the load).
+ */
+void RemovePlaceholder(Scene& scene, AsyncLevelLoad& load, uint32_t placeholderId) {
+    const GameObject* pPlaceholder = scene.FindGameObject(placeholderId);
+    if (!pPlaceholder)
+        return;
+    const std::string placeholderName = pPlaceholder->name;
+    auto itName = load.nameToId.find(placeholderName);
+    if (itName != load.nameToId.end() && itName->second == placeholderId)
+        load.nameToId.erase(itName);
+    load.pendingParents.erase(std::remove_if(load.pendingParents.begin(), load.pendingParents.end(),
+                                             [placeholderId](const std::pair<uint32_t, std::string>& p) {
+                                                 return p.first == placeholderId;
+                                             }),
+                              load.pendingParents.end());
+    if (const std::vector<uint32_t>* pChildren = scene.GetChildren(placeholderId)) {
+        const std::vector<uint32_t> children = *pChildren;
+        for (uint32_t childId : children) {
+            scene.SetParent(childId, NO_PARENT, true);
+            load.pendingParents.push_back({childId, placeholderName});
+        }
+    }
+    scene.SetParent(placeholderId, NO_PARENT, true);
+    scene.DestroyGameObject(placeholderId);
+}
+
+} // namespace
+
 void SceneManager::PrepareAnimationImportStub(const tinygltf::Model& model, const std::string& gltfPath) {
     if (model.animations.empty())
         return;
@@ -308,108 +867,67 @@ void SceneManager::VisitGltfNode(GltfNodeVisitorContext& ctx, int nodeIndex, con
                 continue;
             }
 
-            std::vector<VertexData> vertices;
-            if (!GetMeshDataFromGltf(*ctx.model, meshIndex, static_cast<int>(primIndex), vertices)) {
-                VulkanUtils::LogErr("SceneManager: ExtractVertexData failed for \"{}\" mesh {} primitive {}",
-                                   ctx.gltfPath, meshIndex, primIndex);
-                continue;
-            }
-            const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+            // Already resident, or cooked .vmesh up to date: skip accessor decode entirely
             const std::string meshKey = ctx.gltfPath + ":" + std::to_string(meshIndex) + ":" + std::to_string(primIndex);
-            std::shared_ptr<MeshHandle> pMesh = m_pMeshManager->GetOrCreateFromGltf(meshKey, vertices.data(), vertexCount);
-            if (!pMesh) {
-                VulkanUtils::LogErr("SceneManager: GetOrCreateFromGltf failed for \"{}\" mesh {} primitive {}",
-                                   ctx.gltfPath, meshIndex, primIndex);
-                continue;
+            std::shared_ptr<MeshHandle> pMesh = m_pMeshManager->GetMesh(meshKey);
+            if (!pMesh && ctx.sourceHash != 0u) {
+                pMesh = m_pMeshManager->GetOrCreateFromCooked(meshKey, ctx.sourceHash);
+                if (pMesh)
+                    ++m_meshImportStats.lCookedPrimitives;
             }
-
-            std::shared_ptr<TextureHandle> pTexture;
-            if (m_pTextureManager && hasTexture) {
-                int texIdx = gltfMat.pbrMetallicRoughness.baseColorTexture.index;
-                if (texIdx >= 0 && size_t(texIdx) < ctx.model->textures.size()) {
-                    const tinygltf::Texture& tex = ctx.model->textures[size_t(texIdx)];
-                    if (tex.source >= 0 && size_t(tex.source) < ctx.model->images.size()) {
-                        const tinygltf::Image& img = ctx.model->images[size_t(tex.source)];
-                        if (!img.image.empty() && img.width > 0 && img.height > 0 && img.component > 0) {
-                            std::string texName = img.uri.empty()
-                                ? ("tex_" + ctx.gltfPath + "_" + std::to_string(tex.source))
-                                : img.uri;
-                            pTexture = m_pTextureManager->GetOrCreateFromMemory(texName, img.width, img.height, img.component, img.image.data());
-                        }
-                    }
+            if (!pMesh) {
+                std::vector<VertexData> vertices;
+                std::vector<Meshlet> meshlets;
+                bool decoded = false;
+                auto itPrepared = s_preparedGltfMeshes.find(meshKey);
+                if (itPrepared != s_preparedGltfMeshes.end()) {
+                    // Extracted on a worker by PrefetchGltfSources
+                    vertices = std::move(itPrepared->second.vertices);
+                    meshlets = std::move(itPrepared->second.meshlets);
+                    m_meshImportStats.fDecodeMs += itPrepared->second.fDecodeMs;
+                    s_preparedGltfMeshes.erase(itPrepared);
+                    decoded = true;
+                } else {
+                    const auto decodeStart = std::chrono::steady_clock::now();
+                    decoded = GetMeshDataFromGltf(*ctx.model, meshIndex, static_cast<int>(primIndex), vertices, &meshlets);
+                    m_meshImportStats.fDecodeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
                 }
-            }
-
-            // Load metallicRoughnessTexture from glTF (blue=metallic, green=roughness per glTF spec)
-            std::shared_ptr<TextureHandle> pMetallicRoughnessTexture;
-            if (m_pTextureManager) {
-                int mrTexIdx = gltfMat.pbrMetallicRoughness.metallicRoughnessTexture.index;
-                if (mrTexIdx >= 0 && size_t(mrTexIdx) < ctx.model->textures.size()) {
-                    const tinygltf::Texture& mrTex = ctx.model->textures[size_t(mrTexIdx)];
-                    if (mrTex.source >= 0 && size_t(mrTex.source) < ctx.model->images.size()) {
-                        const tinygltf::Image& mrImg = ctx.model->images[size_t(mrTex.source)];
-                        if (!mrImg.image.empty() && mrImg.width > 0 && mrImg.height > 0 && mrImg.component > 0) {
-                            std::string mrTexName = mrImg.uri.empty()
-                                ? ("mr_tex_" + ctx.gltfPath + "_" + std::to_string(mrTex.source))
-                                : ("mr_" + mrImg.uri);
-                            pMetallicRoughnessTexture = m_pTextureManager->GetOrCreateFromMemory(mrTexName, mrImg.width, mrImg.height, mrImg.component, mrImg.image.data());
-                        }
-                    }
+                if (!decoded) {
+                    VulkanUtils::LogErr("SceneManager: ExtractVertexData failed for \"{}\" mesh {} primitive {}",
+                                       ctx.gltfPath, meshIndex, primIndex);
+                    continue;
                 }
-            }
-
-            // Load emissiveTexture from glTF (emissive RGB per glTF spec)
-            std::shared_ptr<TextureHandle> pEmissiveTexture;
-            if (m_pTextureManager) {
-                int emTexIdx = gltfMat.emissiveTexture.index;
-                if (emTexIdx >= 0 && size_t(emTexIdx) < ctx.model->textures.size()) {
-                    const tinygltf::Texture& emTex = ctx.model->textures[size_t(emTexIdx)];
-                    if (emTex.source >= 0 && size_t(emTex.source) < ctx.model->images.size()) {
-                        const tinygltf::Image& emImg = ctx.model->images[size_t(emTex.source)];
-                        if (!emImg.image.empty() && emImg.width > 0 && emImg.height > 0 && emImg.component > 0) {
-                            std::string emTexName = emImg.uri.empty()
-                                ? ("em_tex_" + ctx.gltfPath + "_" + std::to_string(emTex.source))
-                                : ("em_" + emImg.uri);
-                            pEmissiveTexture = m_pTextureManager->GetOrCreateFromMemory(emTexName, emImg.width, emImg.height, emImg.component, emImg.image.data());
-                        }
-                    }
-                }
-            }
-
-            // Load normalTexture from glTF (tangent-space normal map)
-            std::shared_ptr<TextureHandle> pNormalTexture;
-            if (m_pTextureManager) {
-                int nrmTexIdx = gltfMat.normalTexture.index;
-                if (nrmTexIdx >= 0 && size_t(nrmTexIdx) < ctx.model->textures.size()) {
-                    const tinygltf::Texture& nrmTex = ctx.model->textures[size_t(nrmTexIdx)];
-                    if (nrmTex.source >= 0 && size_t(nrmTex.source) < ctx.model->images.size()) {
-                        const tinygltf::Image& nrmImg = ctx.model->images[size_t(nrmTex.source)];
-                        if (!nrmImg.image.empty() && nrmImg.width > 0 && nrmImg.height > 0 && nrmImg.component > 0) {
-                            std::string nrmTexName = nrmImg.uri.empty()
-                                ? ("nrm_tex_" + ctx.gltfPath + "_" + std::to_string(nrmTex.source))
-                                : ("nrm_" + nrmImg.uri);
-                            pNormalTexture = m_pTextureManager->GetOrCreateFromMemory(nrmTexName, nrmImg.width, nrmImg.height, nrmImg.component, nrmImg.image.data());
-                        }
-                    }
+                ++m_meshImportStats.lDecodedPrimitives;
+                m_meshImportStats.uDecodedVertices += vertices.size();
+                const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+                pMesh = m_pMeshManager->GetOrCreateFromGltf(meshKey, vertices.data(), vertexCount, &meshlets);
+                if (!pMesh) {
+                    VulkanUtils::LogErr("SceneManager: GetOrCreateFromGltf failed for \"{}\" mesh {} primitive {}",
+                                       ctx.gltfPath, meshIndex, primIndex);
+                    continue;
                 }
+                if (ctx.sourceHash != 0u)
+                    m_pMeshManager->WriteCookedMesh(meshKey, ctx.sourceHash, *pMesh, vertices.data());
             }
 
-            // Load occlusionTexture from glTF (ambient occlusion, red channel per spec)
-            std::shared_ptr<TextureHandle> pOcclusionTexture;
+            // Embedded images: cooked on a worker by PrefetchGltfSources / UpdateLevelLoad when available
+            std::shared_ptr<TextureHandle> pTexture;
+            std::shared_ptr<TextureHandle> pMetallicRoughnessTexture;  // Blue=metallic, green=roughness per glTF spec
+            std::shared_ptr<TextureHandle> pEmissiveTexture;
+            std::shared_ptr<TextureHandle> pNormalTexture;             // Tangent-space normal map
+            std::shared_ptr<TextureHandle> pOcclusionTexture;          // Ambient occlusion, red channel per spec
             if (m_pTextureManager) {
-                int occTexIdx = gltfMat.occlusionTexture.index;
-                if (occTexIdx >= 0 && size_t(occTexIdx) < ctx.model->textures.size()) {
-                    const tinygltf::Texture& occTex = ctx.model->textures[size_t(occTexIdx)];
-                    if (occTex.source >= 0 && size_t(occTex.source) < ctx.model->images.size()) {
-                        const tinygltf::Image& occImg = ctx.model->images[size_t(occTex.source)];
-                        if (!occImg.image.empty() && occImg.width > 0 && occImg.height > 0 && occImg.component > 0) {
-                            std::string occTexName = occImg.uri.empty()
-                                ? ("occ_tex_" + ctx.gltfPath + "_" + std::to_string(occTex.source))
-                                : ("occ_" + occImg.uri);
-                            pOcclusionTexture = m_pTextureManager->GetOrCreateFromMemory(occTexName, occImg.width, occImg.height, occImg.component, occImg.image.data());
-                        }
-                    }
-                }
+                if (hasTexture)
+                    pTexture = LoadGltfTexture(*m_pTextureManager, *ctx.model, ctx.gltfPath,
+                                               gltfMat.pbrMetallicRoughness.baseColorTexture.index, TextureRole::BaseColor);
+                pMetallicRoughnessTexture = LoadGltfTexture(*m_pTextureManager, *ctx.model, ctx.gltfPath,
+                                                            gltfMat.pbrMetallicRoughness.metallicRoughnessTexture.index, TextureRole::MetallicRoughness);
+                pEmissiveTexture = LoadGltfTexture(*m_pTextureManager, *ctx.model, ctx.gltfPath,
+                                                   gltfMat.emissiveTexture.index, TextureRole::Emissive);
+                pNormalTexture = LoadGltfTexture(*m_pTextureManager, *ctx.model, ctx.gltfPath,
+                                                 gltfMat.normalTexture.index, TextureRole::Normal);
+                pOcclusionTexture = LoadGltfTexture(*m_pTextureManager, *ctx.model, ctx.gltfPath,
+                                                    gltfMat.occlusionTexture.index, TextureRole::Occlusion);
             }
 
             Object obj;
@@ -523,385 +1041,126 @@ void SceneManager::SetDependencies(MaterialManager* pMaterialManager_ic, MeshMan
     m_pMaterialManager = pMaterialManager_ic;
     m_pMeshManager = pMeshManager_ic;
     m_pTextureManager = pTextureManager_ic;
-}
-
-void SceneManager::UnloadScene() {
-    m_currentScene.reset();
-    m_proceduralMeshCache.clear();
-    ClearGltfCache();
-}
-
-void SceneManager::SetCurrentScene(std::unique_ptr<Scene> scene) {
-    m_currentScene = std::move(scene);
-}
-
-void SceneManager::EnsureDefaultLevelFile(const std::string& path) {
-    std::ifstream in(path);
-    if (in.is_open()) {
-        in.close();
-        return;
-    }
-    std::filesystem::path p(path);
-    std::filesystem::path baseDir = p.parent_path();
-    if (!baseDir.empty())
-        std::filesystem::create_directories(baseDir);
-    json j = GetDefaultLevelJson();
-    std::ofstream out(path);
-    if (out.is_open())
-        out << j.dump(2);
-    VulkanUtils::LogInfo("SceneManager: created default level \"{}\"", path);
-    EnsureDefaultPrimitives(baseDir, m_gltfLoader);
-}
-
-bool SceneManager::LoadLevelFromFile(const std::string& path) {
-    if (m_pMaterialManager == nullptr || m_pMeshManager == nullptr) {
-        VulkanUtils::LogErr("SceneManager::LoadLevelFromFile: SetDependencies not called");
-        return false;
-    }
-    std::ifstream in(path);
-    if (!in.is_open()) {
-        VulkanUtils::LogErr("SceneManager::LoadLevelFromFile: cannot open \"{}\"", path);
-        return false;
-    }
-    json j;
-    try {
-        in >> j;
-    } catch (const json::exception&) {
-        VulkanUtils::LogErr("SceneManager::LoadLevelFromFile: invalid JSON \"{}\"", path);
-        return false;
-    }
-    in.close();
-
-    std::filesystem::path levelPath(path);
-    std::filesystem::path baseDir = levelPath.parent_path();
-    if (baseDir.empty())
-        baseDir = ".";
-
-    std::string sceneName = "default";
-    if (j.contains("name") && j["name"].is_string())
-        sceneName = j["name"].get<std::string>();
-
-    std::vector<Object> objs;
-
-    std::vector<std::string> instanceParentNames;
-    std::vector<std::pair<size_t, size_t>> gltfHierarchyPairs;
-
-    // ========================================================================
-    // Parse model definitions (reusable templates for instances)
-    // ========================================================================
-    struct ModelDef {
-        std::string source;
-        std::string renderMode = "auto";
-        std::string instanceTier = "static";
-    };
-    std::map<std::string, ModelDef> modelDefs;
-    
-    if (j.contains("models") && j["models"].is_object()) {
-        for (auto& [modelName, modelJson] : j["models"].items()) {
-            if (!modelJson.is_object()) continue;
-            
-            ModelDef def;
-            if (modelJson.contains("source") && modelJson["source"].is_string()) {
-                def.source = modelJson["source"].get<std::string>();
-            }
-            if (modelJson.contains("renderMode") && modelJson["renderMode"].is_string()) {
-                def.renderMode = modelJson["renderMode"].get<std::string>();
-            }
-            if (modelJson.contains("instanceTier") && modelJson["instanceTier"].is_string()) {
-                def.instanceTier = modelJson["instanceTier"].get<std::string>();
-            }
-            
-            if (!def.source.empty()) {
-                modelDefs[modelName] = def;
-                VulkanUtils::LogInfo("SceneManager: registered model definition \"{}\" -> \"{}\"", 
-                                     modelName, def.source);
-            }
-        }
-    }
-
-    if (!j.contains("instances") || !j["instances"].is_array()) {
-        SetCurrentScene(std::make_unique<Scene>(sceneName));
-        VulkanUtils::LogInfo("SceneManager: loaded level \"{}\" (no instances)", path);
-        return true;
-    }
-
-    for (const auto& jInst : j["instances"]) {
-        if (!jInst.is_object())
-            continue;
-        
-        // Resolve source and defaults from model definition or direct specification
-        std::string source;
-        std::string defaultRenderMode = "auto";
-        std::string defaultInstanceTier = "static";
-        
-        // Check for model reference first (new format)
-        if (jInst.contains("model") && jInst["model"].is_string()) {
-            const std::string modelRef = jInst["model"].get<std::string>();
-            auto it = modelDefs.find(modelRef);
-            if (it != modelDefs.end()) {
-                source = it->second.source;
-                defaultRenderMode = it->second.renderMode;
-                defaultInstanceTier = it->second.instanceTier;
-            } else {
-                VulkanUtils::LogErr("SceneManager: unknown model reference \"{}\"", modelRef);
-                continue;
-            }
-        }
-        // Fall back to direct source (legacy format)
-        else if (jInst.contains("source") && jInst["source"].is_string()) {
-            source = jInst["source"].get<std::string>();
-        }
-        else {
-            continue; // Neither model nor source specified
-        }
-        
-        // Parse instance name (override for source, used for parenting references)
-        std::string instanceName;
-        if (jInst.contains("name") && jInst["name"].is_string()) {
-            instanceName = jInst["name"].get<std::string>();
-        }
-        
-        // Parse parent reference (name of another instance)
-        std::string parentName;
-        if (jInst.contains("parent") && jInst["parent"].is_string()) {
-            parentName = jInst["parent"].get<std::string>();
-        }
-        if (source.empty())
-            continue;
-
-        // Parse renderMode (instance override takes precedence over model default)
-        RenderMode renderMode = RenderMode::Auto;
-        std::string modeStr = defaultRenderMode;
-        if (jInst.contains("renderMode") && jInst["renderMode"].is_string()) {
-            modeStr = jInst["renderMode"].get<std::string>();
-        }
-        if (modeStr == "solid") renderMode = RenderMode::Solid;
-        else if (modeStr == "wireframe") renderMode = RenderMode::Wireframe;
-        else if (modeStr == "auto") renderMode = RenderMode::Auto;
-        else {
-            VulkanUtils::LogErr("SceneManager: unknown renderMode \"{}\" for source \"{}\"", modeStr, source);
-            continue;
-        }
-
-        // Parse instance tier (instance override takes precedence over model default)
-        std::string tierStr = defaultInstanceTier;
-        if (jInst.contains("instanceTier") && jInst["instanceTier"].is_string()) {
-            tierStr = jInst["instanceTier"].get<std::string>();
-        }
-        InstanceTier instanceTier = ParseInstanceTier(tierStr);
-
-        float pos[3] = { 0.f, 0.f, 0.f };
-        float rot[4] = { 0.f, 0.f, 0.f, 1.f };
-        float scale[3] = { 1.f, 1.f, 1.f };
-        if (jInst.contains("position") && jInst["position"].is_array() && jInst["position"].size() >= 3) {
-            pos[0] = static_cast<float>(jInst["position"][0].get<double>());
-            pos[1] = static_cast<float>(jInst["position"][1].get<double>());
-            pos[2] = static_cast<float>(jInst["position"][2].get<double>());
-        }
-        if (jInst.contains("rotation") && jInst["rotation"].is_array() && jInst["rotation"].size() >= 4) {
-            rot[0] = static_cast<float>(jInst["rotation"][0].get<double>());
-            rot[1] = static_cast<float>(jInst["rotation"][1].get<double>());
-            rot[2] = static_cast<float>(jInst["rotation"][2].get<double>());
-            rot[3] = static_cast<float>(jInst["rotation"][3].get<double>());
-        }
-        if (jInst.contains("scale") && jInst["scale"].is_array() && jInst["scale"].size() >= 3) {
-            scale[0] = static_cast<float>(jInst["scale"][0].get<double>());
-            scale[1] = static_cast<float>(jInst["scale"][1].get<double>());
-            scale[2] = static_cast<float>(jInst["scale"][2].get<double>());
-        }
+}
 
-        float instanceTransform[16];
-        ObjectSetFromPositionRotationScale(instanceTransform,
-            pos[0], pos[1], pos[2],
-            rot[0], rot[1], rot[2], rot[3],
-            scale[0], scale[1], scale[2]);
+void SceneManager::SetJobQueue(JobQueue* pJobQueue_ic) {
+    m_pJobQueue = pJobQueue_ic;
+}
 
-        bool hasColorOverride = false;
-        float colorOverride[4] = {1.f, 1.f, 1.f, 1.f};
-        if (jInst.contains("color") && jInst["color"].is_array() && jInst["color"].size() >= 4) {
-            hasColorOverride = true;
-            colorOverride[0] = static_cast<float>(jInst["color"][0].get<double>());
-            colorOverride[1] = static_cast<float>(jInst["color"][1].get<double>());
-            colorOverride[2] = static_cast<float>(jInst["color"][2].get<double>());
-            colorOverride[3] = static_cast<float>(jInst["color"][3].get<double>());
-        }
+SceneManager::~SceneManager() {
+    CancelLevelLoad();
+}
 
-        bool hasEmissiveOverride = false;
-        float emissiveOverride[4] = {0.f, 0.f, 0.f, 1.f};
-        if (jInst.contains("emissive") && jInst["emissive"].is_array() && jInst["emissive"].size() >= 4) {
-            hasEmissiveOverride = true;
-            emissiveOverride[0] = static_cast<float>(jInst["emissive"][0].get<double>());
-            emissiveOverride[1] = static_cast<float>(jInst["emissive"][1].get<double>());
-            emissiveOverride[2] = static_cast<float>(jInst["emissive"][2].get<double>());
-            emissiveOverride[3] = static_cast<float>(jInst["emissive"][3].get<double>());
-        }
+void SceneManager::UnloadScene() {
+    CancelLevelLoad();
+    m_currentScene.reset();
+    m_proceduralMeshCache.clear();
+    ClearGltfCache();
+}
 
-        // Parse metallic factor (default 1.0 for metals, override in JSON for procedural meshes)
-        float metallicOverride = 1.0f;
-        bool hasMetallicOverride = false;
-        if (jInst.contains("metallic") && jInst["metallic"].is_number()) {
-            hasMetallicOverride = true;
-            metallicOverride = static_cast<float>(jInst["metallic"].get<double>());
-        }
+void SceneManager::SetCurrentScene(std::unique_ptr<Scene> scene) {
+    CancelLevelLoad();  // Placeholder ids refer to the scene being replaced
+    m_currentScene = std::move(scene);
+}
 
-        // Parse roughness factor (default 1.0, override in JSON for procedural meshes)
-        float roughnessOverride = 1.0f;
-        bool hasRoughnessOverride = false;
-        if (jInst.contains("roughness") && jInst["roughness"].is_number()) {
-            hasRoughnessOverride = true;
-            roughnessOverride = static_cast<float>(jInst["roughness"].get<double>());
-        }
+void SceneManager::EnsureDefaultLevelFile(const std::string& path) {
+    std::ifstream in(path);
+    if (in.is_open()) {
+        in.close();
+        return;
+    }
+    std::filesystem::path p(path);
+    std::filesystem::path baseDir = p.parent_path();
+    if (!baseDir.empty())
+        std::filesystem::create_directories(baseDir);
+    json j = GetDefaultLevelJson();
+    std::ofstream out(path);
+    if (out.is_open())
+        out << j.dump(2);
+    VulkanUtils::LogInfo("SceneManager: created default level \"{}\"", path);
+    EnsureDefaultPrimitives(baseDir, m_gltfLoader);
+}
 
-        // Optional material override for procedural instances (e.g. "time_demo")
-        std::string materialOverride;
-        if (jInst.contains("material") && jInst["material"].is_string()) {
-            materialOverride = jInst["material"].get<std::string>();
-        }
+bool SceneManager::LoadLevelFromFile(const std::string& path) {
+    if (m_pMaterialManager == nullptr || m_pMeshManager == nullptr) {
+        VulkanUtils::LogErr("SceneManager::LoadLevelFromFile: SetDependencies not called");
+        return false;
+    }
+    CancelLevelLoad();
+    ResetLevelMaterials();
+    const auto startTime = std::chrono::steady_clock::now();
+    json j;
+    if (!ReadLevelJson(path, j))
+        return false;
+    m_meshImportStats = MeshImportStats{};
+    if (m_pTextureManager)
+        m_pTextureManager->ResetCookStats();
 
-        if (source.rfind("procedural:", 0) == 0) {
-            std::shared_ptr<MeshHandle> pMesh = LoadProceduralMesh(source);
-            if (!pMesh) {
-                VulkanUtils::LogErr("SceneManager: failed to create procedural mesh \"{}\"", source);
-                continue;
-            }
+    std::filesystem::path levelPath(path);
+    std::filesystem::path baseDir = levelPath.parent_path();
+    if (baseDir.empty())
+        baseDir = ".";
 
-            std::shared_ptr<MaterialHandle> pMaterial;
-            if (!materialOverride.empty()) {
-                pMaterial = m_pMaterialManager->GetMaterial(materialOverride);
-            }
-            if (!pMaterial) {
-                // Use textured pipeline for procedural meshes - default white texture enables PBR with factors
-                const std::string pipelineKey = ResolvePipelineKey("OPAQUE", renderMode, true, false);
-                pMaterial = m_pMaterialManager->GetMaterial(pipelineKey);
-            }
-            if (!pMaterial) {
-                VulkanUtils::LogErr("SceneManager: material not found for procedural \"{}\" (override=\"{}\")", source, materialOverride);
-                continue;
-            }
+    std::string sceneName = "default";
+    if (j.contains("name") && j["name"].is_string())
+        sceneName = j["name"].get<std::string>();
+
+    std::vector<LevelInstanceDesc> instances;
+    ParseLevelInstances(j, baseDir, instances);
+
+    if (!j.contains("instances") || !j["instances"].is_array()) {
+        SetCurrentScene(std::make_unique<Scene>(sceneName));
+        VulkanUtils::LogInfo("SceneManager: loaded level \"{}\" (no instances)", path);
+        return true;
+    }
+
+    // CPU phase: parse/extract every glTF source on the JobQueue
+    {
+        std::vector<std::string> prefetchPaths;
+        std::set<std::string> seenPaths;
+        for (const LevelInstanceDesc& desc : instances) {
+            if (!desc.gltfPath.empty() && seenPaths.insert(desc.gltfPath).second)
+                prefetchPaths.push_back(desc.gltfPath);
+        }
+        PrefetchGltfSources(prefetchPaths);
+    }
+
+    std::vector<Object> objs;
+    std::vector<std::string> instanceParentNames;
+    std::vector<std::pair<size_t, size_t>> gltfHierarchyPairs;
 
+    // Main-thread phase: Vulkan objects (mesh/texture upload) and GameObjects
+    for (const LevelInstanceDesc& desc : instances) {
+        if (desc.gltfPath.empty()) {
             Object obj;
-            // Use explicit name from JSON if provided, otherwise fall back to source
-            obj.name = instanceName.empty() ? source : instanceName;
-            obj.pMesh = pMesh;
-            obj.pMaterial = pMaterial;
-            // Assign all PBR textures with proper defaults for full PBR support
-            if (m_pTextureManager) {
-                obj.pTexture = m_pTextureManager->GetOrCreateDefaultTexture();                    // White base color
-                obj.pMetallicRoughnessTexture = m_pTextureManager->GetOrCreateDefaultMRTexture(); // MR factors used as-is
-                obj.pEmissiveTexture = m_pTextureManager->GetOrCreateDefaultEmissiveTexture();    // No emission by default
-                obj.pNormalTexture = m_pTextureManager->GetOrCreateDefaultNormalTexture();        // Flat normal
-                obj.pOcclusionTexture = m_pTextureManager->GetOrCreateDefaultOcclusionTexture();  // No occlusion
-            }
-            std::memcpy(obj.localTransform, instanceTransform, sizeof(instanceTransform));
-            if (hasColorOverride) {
-                obj.color[0] = colorOverride[0];
-                obj.color[1] = colorOverride[1];
-                obj.color[2] = colorOverride[2];
-                obj.color[3] = colorOverride[3];
-            }
-            if (hasEmissiveOverride) {
-                obj.emissive[0] = emissiveOverride[0];
-                obj.emissive[1] = emissiveOverride[1];
-                obj.emissive[2] = emissiveOverride[2];
-                obj.emissive[3] = emissiveOverride[3];
-                
-                // Auto-enable light emission if emissive override is non-zero
-                float emissiveLen = emissiveOverride[0] + emissiveOverride[1] + emissiveOverride[2];
-                if (emissiveLen > 0.001f) {
-                    obj.emitsLight = true;
-                }
-            }
-            if (hasMetallicOverride) {
-                obj.metallicFactor = metallicOverride;
-            }
-            if (hasRoughnessOverride) {
-                obj.roughnessFactor = roughnessOverride;
-            }
-            obj.instanceTier = instanceTier;
-            obj.pushData.resize(kInstancedPushConstantSize);
-            obj.pushDataSize = kInstancedPushConstantSize;
-            instanceParentNames.push_back(parentName);  // Track parent for hierarchy resolution
+            if (!BuildProceduralObject(desc, obj))
+                continue;
+            instanceParentNames.push_back(desc.parentName);  // Track parent for hierarchy resolution
             objs.push_back(std::move(obj));
             continue;
         }
 
-        const std::filesystem::path resolvedPath = baseDir / source;
-        const std::string gltfPath = resolvedPath.string();
-        
         // Use cached model loading (avoids re-parsing same file for multiple instances)
-        const tinygltf::Model* model = GetOrLoadGltfModel(gltfPath);
+        const tinygltf::Model* model = GetOrLoadGltfModel(desc.gltfPath);
         if (!model || model->meshes.empty()) {
-            VulkanUtils::LogErr("SceneManager: glTF has no meshes \"{}\"", gltfPath);
+            VulkanUtils::LogErr("SceneManager: glTF has no meshes \"{}\"", desc.gltfPath);
             continue;
         }
 
-        PrepareAnimationImportStub(*model, gltfPath);
+        PrepareAnimationImportStub(*model, desc.gltfPath);
+        NoteGltfMaterials(*model, desc.renderMode);
 
-        std::vector<int> roots;
-        if (!model->scenes.empty()) {
-            int sceneIndex = model->defaultScene;
-            if (sceneIndex < 0 || size_t(sceneIndex) >= model->scenes.size())
-                sceneIndex = 0;
-            const tinygltf::Scene& sceneDef = model->scenes[size_t(sceneIndex)];
-            roots.assign(sceneDef.nodes.begin(), sceneDef.nodes.end());
-        }
-        if (roots.empty()) {
-            roots.reserve(model->nodes.size());
-            for (size_t i = 0; i < model->nodes.size(); ++i)
-                roots.push_back(static_cast<int>(i));
-        }
-
-        GltfNodeVisitorContext ctx{
-            model,
-            gltfPath,
-            renderMode,
-            objs,
-            instanceTransform,
-            hasColorOverride,
-            colorOverride,
-            hasEmissiveOverride,
-            emissiveOverride,
-            hasMetallicOverride,
-            metallicOverride,
-            hasRoughnessOverride,
-            roughnessOverride,
-            instanceTier,
-            {},  // nodeToFirstObjIndex
-            {},  // objParentNodePairs
-            -1   // currentParentNode (root)
-        };
-        
-        // Track how many objects exist before loading this glTF
-        size_t objCountBefore = objs.size();
-        
-        float identity[16];
-        MatIdentity(identity);
-        for (int rootNode : roots)
-            VisitGltfNode(ctx, rootNode, identity);
-        
         // Apply the same parent reference to all objects loaded from this glTF instance
-        // Also track glTF internal hierarchy for later resolution
-        size_t objCountAfter = objs.size();
-        for (size_t objIdx = objCountBefore; objIdx < objCountAfter; ++objIdx) {
-            instanceParentNames.push_back(parentName);
-        }
-        
-        // Store glTF hierarchy info: (childObjIndex, parentObjIndex) pairs
-        // Convert from (childObjIndex, parentNodeIndex) to (childObjIndex, parentObjIndex)
-        for (const auto& pair : ctx.objParentNodePairs) {
-            size_t childObjIdx = pair.first;
-            int parentNodeIdx = pair.second;
-            auto it = ctx.nodeToFirstObjIndex.find(parentNodeIdx);
-            if (it != ctx.nodeToFirstObjIndex.end()) {
-                // Store negative index to mark this as glTF internal hierarchy (vs JSON parent name)
-                // We'll resolve this after GameObjects are created
-                gltfHierarchyPairs.push_back({childObjIdx, it->second});
-            }
+        const size_t objCountBefore = objs.size();
+        AppendGltfInstanceObjects(desc, *model, objs, gltfHierarchyPairs);
+        for (size_t objIdx = objCountBefore; objIdx < objs.size(); ++objIdx) {
+            instanceParentNames.push_back(desc.parentName);
         }
     }
 
     // Build unified Scene from parsed Objects
     auto scene = std::make_unique<Scene>(sceneName);
+    scene->Reserve(objs.size(), objs.size());
     std::vector<uint32_t> goIds(objs.size(), UINT32_MAX);
 
     for (size_t i = 0; i < objs.size(); ++i) {
@@ -953,11 +1212,457 @@ bool SceneManager::LoadLevelFromFile(const std::string& path) {
     SetCurrentScene(std::move(scene));
     LoadLightsFromJson(j);
 
-    VulkanUtils::LogInfo("SceneManager: loaded level \"{}\" ({} objects, {} lights)",
-                         path, objectCount, m_currentScene ? m_currentScene->GetLights().size() : 0u);
+    VulkanUtils::LogInfo("SceneManager: loaded level \"{}\" in {:.1f} ms, {} ({} objects, {} lights)",
+                         path, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count(),
+                         GetImportTemperature(m_meshImportStats, m_pTextureManager),
+                         objectCount, m_currentScene ? m_currentScene->GetLights().size() : 0u);
+    LogMeshImportStats(m_meshImportStats);
+    LogTextureCookStats(m_pTextureManager);
+    s_preparedGltfMeshes.clear();  // Primitives prepared but not reached from any scene root
+    s_preparedGltfTextures.clear();
+    return true;
+}
+
+
+bool SceneManager::BuildProceduralObject(const LevelInstanceDesc& desc, Object& out) {
+    std::shared_ptr<MeshHandle> pMesh = LoadProceduralMesh(desc.source);
+    if (!pMesh) {
+        VulkanUtils::LogErr("SceneManager: failed to create procedural mesh \"{}\"", desc.source);
+        return false;
+    }
+
+    std::string materialId = desc.materialOverride;
+    std::shared_ptr<MaterialHandle> pMaterial;
+    if (!materialId.empty()) {
+        pMaterial = m_pMaterialManager->GetMaterial(materialId);
+    }
+    if (!pMaterial) {
+        // Use textured pipeline for procedural meshes - default white texture enables PBR with factors
+        materialId = ResolvePipelineKey("OPAQUE", desc.renderMode, true, false);
+        pMaterial = m_pMaterialManager->GetMaterial(materialId);
+    }
+    if (!pMaterial) {
+        VulkanUtils::LogErr("SceneManager: material not found for procedural \"{}\" (override=\"{}\")", desc.source, desc.materialOverride);
+        return false;
+    }
+    NoteLevelMaterial(materialId);
+
+    Object& obj = out;
+    // Use explicit name from JSON if provided, otherwise fall back to source
+    obj.name = desc.instanceName.empty() ? desc.source : desc.instanceName;
+    obj.pMesh = pMesh;
+    obj.pMaterial = pMaterial;
+    // Assign all PBR textures with proper defaults for full PBR support
+    if (m_pTextureManager) {
+        obj.pTexture = m_pTextureManager->GetOrCreateDefaultTexture();                    // White base color
+        obj.pMetallicRoughnessTexture = m_pTextureManager->GetOrCreateDefaultMRTexture(); // MR factors used as-is
+        obj.pEmissiveTexture = m_pTextureManager->GetOrCreateDefaultEmissiveTexture();    // No emission by default
+        obj.pNormalTexture = m_pTextureManager->GetOrCreateDefaultNormalTexture();        // Flat normal
+        obj.pOcclusionTexture = m_pTextureManager->GetOrCreateDefaultOcclusionTexture();  // No occlusion
+    }
+    std::memcpy(obj.localTransform, desc.transform, sizeof(desc.transform));
+    if (desc.hasColorOverride) {
+        obj.color[0] = desc.colorOverride[0];
+        obj.color[1] = desc.colorOverride[1];
+        obj.color[2] = desc.colorOverride[2];
+        obj.color[3] = desc.colorOverride[3];
+    }
+    if (desc.hasEmissiveOverride) {
+        obj.emissive[0] = desc.emissiveOverride[0];
+        obj.emissive[1] = desc.emissiveOverride[1];
+        obj.emissive[2] = desc.emissiveOverride[2];
+        obj.emissive[3] = desc.emissiveOverride[3];
+        
+        // Auto-enable light emission if emissive override is non-zero
+        float emissiveLen = desc.emissiveOverride[0] + desc.emissiveOverride[1] + desc.emissiveOverride[2];
+        if (emissiveLen > 0.001f) {
+            obj.emitsLight = true;
+        }
+    }
+    if (desc.hasMetallicOverride) {
+        obj.metallicFactor = desc.metallicOverride;
+    }
+    if (desc.hasRoughnessOverride) {
+        obj.roughnessFactor = desc.roughnessOverride;
+    }
+    obj.instanceTier = desc.instanceTier;
+    obj.pushData.resize(kInstancedPushConstantSize);
+    obj.pushDataSize = kInstancedPushConstantSize;
+    return true;
+}
+
+void SceneManager::AppendGltfInstanceObjects(const LevelInstanceDesc& desc, const tinygltf::Model& model,
+                                             std::vector<Object>& objs, std::vector<std::pair<size_t, size_t>>& hierarchyPairs) {
+    std::vector<int> roots;
+    if (!model.scenes.empty()) {
+        int sceneIndex = model.defaultScene;
+        if (sceneIndex < 0 || size_t(sceneIndex) >= model.scenes.size())
+            sceneIndex = 0;
+        const tinygltf::Scene& sceneDef = model.scenes[size_t(sceneIndex)];
+        roots.assign(sceneDef.nodes.begin(), sceneDef.nodes.end());
+    }
+    if (roots.empty()) {
+        roots.reserve(model.nodes.size());
+        for (size_t i = 0; i < model.nodes.size(); ++i)
+            roots.push_back(static_cast<int>(i));
+    }
+
+    GltfNodeVisitorContext ctx{
+        &model,
+        desc.gltfPath,
+        desc.renderMode,
+        objs,
+        desc.transform,
+        desc.hasColorOverride,
+        desc.colorOverride,
+        desc.hasEmissiveOverride,
+        desc.emissiveOverride,
+        desc.hasMetallicOverride,
+        desc.metallicOverride,
+        desc.hasRoughnessOverride,
+        desc.roughnessOverride,
+        desc.instanceTier,
+        {},  // nodeToFirstObjIndex
+        {},  // objParentNodePairs
+        -1   // currentParentNode (root)
+    };
+    if (m_pMeshManager->IsMeshCookingEnabled()) {
+        auto itHash = s_gltfSourceHashCache.find(desc.gltfPath);
+        if (itHash != s_gltfSourceHashCache.end())
+            ctx.sourceHash = itHash->second;
+    }
+    
+    float identity[16];
+    MatIdentity(identity);
+    for (int rootNode : roots)
+        VisitGltfNode(ctx, rootNode, identity);
+    
+    // Store glTF hierarchy info: (childObjIndex, parentObjIndex) pairs
+    // Convert from (childObjIndex, parentNodeIndex) to (childObjIndex, parentObjIndex)
+    for (const auto& pair : ctx.objParentNodePairs) {
+        size_t childObjIdx = pair.first;
+        int parentNodeIdx = pair.second;
+        auto it = ctx.nodeToFirstObjIndex.find(parentNodeIdx);
+        if (it != ctx.nodeToFirstObjIndex.end()) {
+            hierarchyPairs.push_back({childObjIdx, it->second});
+        }
+    }
+}
+
+bool SceneManager::BeginLevelLoadAsync(const std::string& path) {
+    if (m_pJobQueue == nullptr)
+        return LoadLevelFromFile(path);
+    if (m_pMaterialManager == nullptr || m_pMeshManager == nullptr) {
+        VulkanUtils::LogErr("SceneManager::BeginLevelLoadAsync: SetDependencies not called");
+        return false;
+    }
+    CancelLevelLoad();
+    ResetLevelMaterials();
+    const auto startTime = std::chrono::steady_clock::now();
+    json j;
+    if (!ReadLevelJson(path, j))
+        return false;
+    m_meshImportStats = MeshImportStats{};
+    if (m_pTextureManager)
+        m_pTextureManager->ResetCookStats();
+
+    std::filesystem::path levelPath(path);
+    std::filesystem::path baseDir = levelPath.parent_path();
+    if (baseDir.empty())
+        baseDir = ".";
+
+    std::string sceneName = "default";
+    if (j.contains("name") && j["name"].is_string())
+        sceneName = j["name"].get<std::string>();
+
+    std::vector<LevelInstanceDesc> descs;
+    ParseLevelInstances(j, baseDir, descs);
+
+    auto pLoad = std::make_unique<AsyncLevelLoad>();
+    pLoad->path = path;
+    pLoad->startTime = startTime;
+    auto scene = std::make_unique<Scene>(sceneName);
+    scene->Reserve(descs.size(), descs.size());
+    const bool hashSources = m_pMeshManager->IsMeshCookingEnabled();
+
+    for (LevelInstanceDesc& desc : descs) {
+        Object obj;
+        if (desc.gltfPath.empty()) {
+            if (!BuildProceduralObject(desc, obj))
+                continue;
+        } else {
+            LevelInstanceDesc placeholderDesc = desc;
+            placeholderDesc.source = kPlaceholderMeshSource;
+            placeholderDesc.materialOverride.clear();
+            placeholderDesc.hasColorOverride = true;
+            std::memcpy(placeholderDesc.colorOverride, kPlaceholderColor, sizeof(kPlaceholderColor));
+            placeholderDesc.hasEmissiveOverride = false;
+            if (!BuildProceduralObject(placeholderDesc, obj))
+                continue;
+            obj.name = desc.instanceName.empty() ? desc.source : desc.instanceName;
+        }
+
+        const uint32_t goId = scene->CreateGameObject(obj.name);
+        Transform t;
+        ObjectToTransform(obj, t);
+        scene->AddTransform(goId, t);
+        RendererComponent renderer;
+        ObjectToRenderer(obj, renderer);
+        scene->AddRenderer(goId, renderer);
+        pLoad->nameToId.emplace(obj.name, goId);
+        if (!desc.parentName.empty())
+            pLoad->pendingParents.push_back({goId, desc.parentName});
+        if (desc.gltfPath.empty())
+            continue;
+
+        // First instance of a source queues its parse (embedded images are decoded there too)
+        if (pLoad->sources.count(desc.gltfPath) == 0u) {
+            AsyncGltfSource& source = pLoad->sources[desc.gltfPath];
+            if (s_gltfModelCache.count(desc.gltfPath) != 0u) {
+                source.stage = AsyncGltfSource::Stage::Parsed;
+            } else {
+                source.pParseTask = std::make_unique<GltfParseTask>();
+                source.pParseTask->path = desc.gltfPath;
+                source.pParseTask->hashSource = hashSources;
+                source.pParseDone = m_pJobQueue->SubmitTask(std::bind(&RunGltfParseTask, source.pParseTask.get()));
+            }
+        }
+        pLoad->sources[desc.gltfPath].renderModeMask |= 1u << static_cast<uint32_t>(desc.renderMode);
+        AsyncLevelInstance instance;
+        instance.desc = std::move(desc);
+        instance.placeholderId = goId;
+        pLoad->instances.push_back(std::move(instance));
+    }
+
+    const size_t objectCount = scene->GetGameObjectCount();
+    SetCurrentScene(std::move(scene));
+    LoadLightsFromJson(j);
+    ResolvePendingParents(*m_currentScene, *pLoad, false);
+    m_pAsyncLoad = std::move(pLoad);
+
+    VulkanUtils::LogInfo("SceneManager: level \"{}\" started in {:.2f} ms ({} objects, {} placeholders, {} glTF sources queued)",
+                         path, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count(),
+                         objectCount, m_pAsyncLoad->instances.size(), m_pAsyncLoad->sources.size());
+    if (m_pAsyncLoad->instances.empty())
+        FinishLevelLoad();
     return true;
 }
 
+uint32_t SceneManager::UpdateLevelLoad(float fBudgetMs_ic) {
+    if (!m_pAsyncLoad || !m_currentScene)
+        return 0u;
+    AsyncLevelLoad& load = *m_pAsyncLoad;
+    const auto updateStart = std::chrono::steady_clock::now();
+
+    // Worker side: parsed sources get their primitives extracted and textures cooked; then they become Ready
+    for (auto& [path, source] : load.sources) {
+        if (source.stage == AsyncGltfSource::Stage::Parsing && JobQueue::IsTaskDone(source.pParseDone)) {
+            if (AdoptParsedGltf(*source.pParseTask)) {
+                ++m_meshImportStats.lParsedSources;
+                source.stage = AsyncGltfSource::Stage::Parsed;
+            } else {
+                VulkanUtils::LogErr("SceneManager: failed to load glTF \"{}\"", path);
+                source.stage = AsyncGltfSource::Stage::Failed;
+            }
+            source.pParseTask.reset();
+            source.pParseDone.reset();
+        }
+        if (source.stage == AsyncGltfSource::Stage::Parsed) {
+            // Materials are known once parsed: their pipelines build while primitives extract
+            auto itModel = s_gltfModelCache.find(path);
+            if (itModel != s_gltfModelCache.end() && itModel->second) {
+                for (uint32_t mode = 0u; mode <= static_cast<uint32_t>(RenderMode::Wireframe); ++mode) {
+                    if ((source.renderModeMask & (1u << mode)) != 0u)
+                        NoteGltfMaterials(*itModel->second, static_cast<RenderMode>(mode));
+                }
+            }
+            SubmitGltfMeshTasks(*m_pMeshManager, *m_pJobQueue, path, source.meshTasks, source.extractDone);
+            if (m_pTextureManager)
+                SubmitGltfTextureTasks(*m_pTextureManager, *m_pJobQueue, path, source.textureTasks, source.extractDone);
+            source.stage = AsyncGltfSource::Stage::Extracting;
+        }
+        if (source.stage == AsyncGltfSource::Stage::Extracting) {
+            bool allDone = true;
+            for (const std::shared_ptr<TaskResult>& handle : source.extractDone) {
+                if (!JobQueue::IsTaskDone(handle)) {
+                    allDone = false;
+                    break;
+                }
+            }
+            if (allDone) {
+                HarvestGltfMeshTasks(source.meshTasks);
+                HarvestGltfTextureTasks(source.textureTasks);
+                source.extractDone.clear();
+                source.stage = AsyncGltfSource::Stage::Ready;
+            }
+        }
+    }
+
+    // Main thread: swap placeholders for real objects (buffer/texture upload) until the frame budget is spent.
+    // The scene is live: everything resolved this frame goes out as one change notification.
+    m_currentScene->BeginBulkEdit();
+    uint32_t resolvedNow = 0u;
+    for (size_t i = 0; i < load.instances.size(); ++i) {
+        if (load.instances[i].resolved)
+            continue;
+        const AsyncGltfSource::Stage stage = load.sources[load.instances[i].desc.gltfPath].stage;
+        if (stage != AsyncGltfSource::Stage::Ready && stage != AsyncGltfSource::Stage::Failed)
+            continue;
+        ResolveAsyncInstance(load, i);
+        load.instances[i].resolved = true;
+        ++load.resolvedCount;
+        ++resolvedNow;
+        if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - updateStart).count() >= fBudgetMs_ic)
+            break;
+    }
+    if (resolvedNow > 0u)
+        ResolvePendingParents(*m_currentScene, load, false);
+    m_currentScene->EndBulkEdit();
+    if (load.resolvedCount == load.instances.size())
+        FinishLevelLoad();
+    return resolvedNow;
+}
+
+void SceneManager::ResolveAsyncInstance(AsyncLevelLoad& load, size_t instanceIndex) {
+    const AsyncLevelInstance& instance = load.instances[instanceIndex];
+    const LevelInstanceDesc& desc = instance.desc;
+    Scene& scene = *m_currentScene;
+
+    // Failed sources are not retried here (GetOrLoadGltfModel would parse on the main thread)
+    const bool sourceReady = (load.sources[desc.gltfPath].stage == AsyncGltfSource::Stage::Ready);
+    const tinygltf::Model* model = sourceReady ? GetOrLoadGltfModel(desc.gltfPath) : nullptr;
+    if (!model || model->meshes.empty()) {
+        VulkanUtils::LogErr("SceneManager: glTF has no meshes \"{}\"", desc.gltfPath);
+        RemovePlaceholder(scene, load, instance.placeholderId);
+        return;
+    }
+
+    PrepareAnimationImportStub(*model, desc.gltfPath);
+
+    std::vector<Object> objs;
+    std::vector<std::pair<size_t, size_t>> hierarchyPairs;
+    AppendGltfInstanceObjects(desc, *model, objs, hierarchyPairs);
+
+    // The placeholder's name belongs to no object in the sync loader; a glTF node may take it from here on
+    RemovePlaceholder(scene, load, instance.placeholderId);
+    scene.Reserve(objs.size(), objs.size());
+    std::vector<uint32_t> goIds(objs.size(), UINT32_MAX);
+    for (size_t i = 0; i < objs.size(); ++i) {
+        const Object& obj = objs[i];
+        std::string goName = obj.name.empty() ? ("Object_" + std::to_string(i)) : obj.name;
+        const uint32_t goId = scene.CreateGameObject(goName);
+        goIds[i] = goId;
+
+        Transform t;
+        ObjectToTransform(obj, t);
+        scene.AddTransform(goId, t);
+
+        RendererComponent renderer;
+        ObjectToRenderer(obj, renderer);
+        scene.AddRenderer(goId, renderer);
+
+        if (!obj.name.empty())
+            load.nameToId.emplace(obj.name, goId);
+    }
+
+    // Same as LoadLevelFromFile: objects carry world transforms (desc.transform baked in), the glTF hierarchy links
+    // them, and a JSON parent then takes every object of the instance
+    for (const auto& pair : hierarchyPairs) {
+        if (pair.first < goIds.size() && pair.second < goIds.size())
+            scene.SetParent(goIds[pair.first], goIds[pair.second], true);
+    }
+    if (!desc.parentName.empty()) {
+        for (uint32_t goId : goIds)
+            load.pendingParents.push_back({goId, desc.parentName});
+    }
+}
+
+void SceneManager::FinishLevelLoad() {
+    if (!m_pAsyncLoad)
+        return;
+    AsyncLevelLoad& load = *m_pAsyncLoad;
+    if (m_currentScene)
+        ResolvePendingParents(*m_currentScene, load, true);
+
+    VulkanUtils::LogInfo("SceneManager: loaded level \"{}\" progressively in {:.1f} ms, {} ({} objects, {} lights, {} glTF sources parsed)",
+                         load.path, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load.startTime).count(),
+                         GetImportTemperature(m_meshImportStats, m_pTextureManager),
+                         m_currentScene ? m_currentScene->GetGameObjectCount() : 0u,
+                         m_currentScene ? m_currentScene->GetLights().size() : 0u, m_meshImportStats.lParsedSources);
+    LogMeshImportStats(m_meshImportStats);
+    LogTextureCookStats(m_pTextureManager);
+    s_preparedGltfMeshes.clear();
+    s_preparedGltfTextures.clear();
+    m_pAsyncLoad.reset();
+}
+
+void SceneManager::CancelLevelLoad() {
+    if (!m_pAsyncLoad)
+        return;
+    // Worker tasks write into state owned by m_pAsyncLoad and read cached models: drain them before dropping either
+    for (auto& [path, source] : m_pAsyncLoad->sources) {
+        m_pJobQueue->WaitForTask(source.pParseDone);
+        for (const std::shared_ptr<TaskResult>& handle : source.extractDone)
+            m_pJobQueue->WaitForTask(handle);
+    }
+    VulkanUtils::LogInfo("SceneManager: cancelled progressive load of \"{}\" ({}/{} instances resolved)",
+                         m_pAsyncLoad->path, m_pAsyncLoad->resolvedCount, m_pAsyncLoad->instances.size());
+    s_preparedGltfMeshes.clear();
+    s_preparedGltfTextures.clear();
+    m_pAsyncLoad.reset();
+}
+
+LevelLoadProgress SceneManager::GetLevelLoadProgress() const {
+    LevelLoadProgress progress;
+    if (!m_pAsyncLoad)
+        return progress;
+    const AsyncLevelLoad& load = *m_pAsyncLoad;
+    progress.isLoading = true;
+    progress.levelPath = load.path;
+    progress.totalInstances = static_cast<uint32_t>(load.instances.size());
+    progress.resolvedInstances = load.resolvedCount;
+    progress.totalSources = static_cast<uint32_t>(load.sources.size());
+    uint32_t doneSources = 0u;
+    for (const auto& [path, source] : load.sources) {
+        if (source.stage == AsyncGltfSource::Stage::Ready || source.stage == AsyncGltfSource::Stage::Failed)
+            ++doneSources;
+        else
+            ++progress.pendingSources;
+    }
+    const uint32_t steps = static_cast<uint32_t>(load.sources.size()) + progress.totalInstances;
+    progress.fraction = (steps > 0u) ? static_cast<float>(doneSources + progress.resolvedInstances) / static_cast<float>(steps) : 1.0f;
+    return progress;
+}
+
+void SceneManager::ConsumeLevelMaterialIds(std::vector<std::string>& vecIds_out) {
+    vecIds_out.insert(vecIds_out.end(), m_vecNewLevelMaterialIds.begin(), m_vecNewLevelMaterialIds.end());
+    m_vecNewLevelMaterialIds.clear();
+}
+
+void SceneManager::NoteLevelMaterial(const std::string& sMaterialId) {
+    if (m_levelMaterialIds.insert(sMaterialId).second)
+        m_vecNewLevelMaterialIds.push_back(sMaterialId);
+}
+
+void SceneManager::NoteGltfMaterials(const tinygltf::Model& model, RenderMode renderMode) {
+    for (const tinygltf::Mesh& mesh : model.meshes) {
+        for (const tinygltf::Primitive& prim : mesh.primitives) {
+            if (prim.material < 0 || size_t(prim.material) >= model.materials.size())
+                continue;
+            const tinygltf::Material& gltfMat = model.materials[size_t(prim.material)];
+            const bool hasTexture = (gltfMat.pbrMetallicRoughness.baseColorTexture.index >= 0);
+            const std::string pipelineKey = ResolvePipelineKey(gltfMat.alphaMode, renderMode, hasTexture, gltfMat.doubleSided);
+            if (!pipelineKey.empty())
+                NoteLevelMaterial(pipelineKey);
+        }
+    }
+}
+
+void SceneManager::ResetLevelMaterials() {
+    m_levelMaterialIds.clear();
+    m_vecNewLevelMaterialIds.clear();
+}
+
 bool SceneManager::LoadDefaultLevelOrCreate(const std::string& defaultLevelPath) {
     EnsureDefaultLevelFile(defaultLevelPath);
     if (!LoadLevelFromFile(defaultLevelPath)) {
@@ -1050,22 +1755,28 @@ const tinygltf::Model* SceneManager::GetOrLoadGltfModel(const std::string& path)
         return it->second.get();
     }
     
-    // Load from file
+    // Load from file (images stay encoded; textures decode them only on a .vtex cache miss)
+    m_gltfLoader.SetDeferImageDecode(true);
     if (!m_gltfLoader.LoadFromFile(path)) {
         VulkanUtils::LogErr("SceneManager: failed to load glTF \"{}\"", path);
         return nullptr;
     }
     
-    // Clone the model into cache (GltfLoader owns one model at a time)
-    const tinygltf::Model* pLoaded = m_gltfLoader.GetModel();
-    if (!pLoaded) {
+    // Take the model into the cache (no copy; GltfLoader owns one model at a time)
+    std::unique_ptr<tinygltf::Model> pCached = m_gltfLoader.ReleaseModel();
+    if (!pCached) {
         return nullptr;
     }
-    
-    // Move-construct a copy into the cache
-    auto pCached = std::make_unique<tinygltf::Model>(*pLoaded);
     const tinygltf::Model* pResult = pCached.get();
     s_gltfModelCache[path] = std::move(pCached);
+
+    if (m_pMeshManager && m_pMeshManager->IsMeshCookingEnabled()) {
+        const uint64_t uHash = ComputeGltfSourceHash(path, *pResult);
+        if (uHash != 0u)
+            s_gltfSourceHashCache[path] = uHash;
+        else
+            VulkanUtils::LogWarn("SceneManager: could not hash \"{}\", cooked meshes disabled for it", path);
+    }
     
     VulkanUtils::LogInfo("SceneManager: cached glTF \"{}\" ({} meshes, {} materials)",
                          path, pResult->meshes.size(), pResult->materials.size());
@@ -1073,11 +1784,62 @@ const tinygltf::Model* SceneManager::GetOrLoadGltfModel(const std::string& path)
     return pResult;
 }
 
+void SceneManager::PrefetchGltfSources(const std::vector<std::string>& vecPaths_ic) {
+    if (m_pJobQueue == nullptr || m_pMeshManager == nullptr || vecPaths_ic.empty())
+        return;
+    const auto phaseStart = std::chrono::steady_clock::now();
+    const bool hashSources = m_pMeshManager->IsMeshCookingEnabled();
+
+    // Phase 1: one task per uncached source (file read + parse + embedded image decode)
+    std::vector<std::unique_ptr<GltfParseTask>> parseTasks;
+    std::vector<std::shared_ptr<TaskResult>> handles;
+    for (const std::string& path : vecPaths_ic) {
+        if (s_gltfModelCache.count(path) != 0u)
+            continue;
+        auto pTask = std::make_unique<GltfParseTask>();
+        pTask->path = path;
+        pTask->hashSource = hashSources;
+        handles.push_back(m_pJobQueue->SubmitTask(std::bind(&RunGltfParseTask, pTask.get())));
+        parseTasks.push_back(std::move(pTask));
+    }
+    for (const std::shared_ptr<TaskResult>& handle : handles)
+        m_pJobQueue->WaitForTask(handle);
+    for (std::unique_ptr<GltfParseTask>& pTask : parseTasks) {
+        // Failures: GetOrLoadGltfModel retries serially and reports the error
+        if (AdoptParsedGltf(*pTask))
+            ++m_meshImportStats.lParsedSources;
+    }
+
+    // Phase 2: one task per primitive that is not resident yet (cooked ones are only validated)
+    // and one per embedded texture (mip chain + BC encode)
+    std::vector<std::unique_ptr<GltfMeshTask>> meshTasks;
+    std::vector<std::unique_ptr<GltfTextureTask>> textureTasks;
+    handles.clear();
+    std::set<std::string> seenPaths;
+    for (const std::string& path : vecPaths_ic) {
+        if (!seenPaths.insert(path).second)
+            continue;
+        SubmitGltfMeshTasks(*m_pMeshManager, *m_pJobQueue, path, meshTasks, handles);
+        if (m_pTextureManager)
+            SubmitGltfTextureTasks(*m_pTextureManager, *m_pJobQueue, path, textureTasks, handles);
+    }
+    for (const std::shared_ptr<TaskResult>& handle : handles)
+        m_pJobQueue->WaitForTask(handle);
+    HarvestGltfMeshTasks(meshTasks);
+    HarvestGltfTextureTasks(textureTasks);
+
+    m_meshImportStats.fParallelImportMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - phaseStart).count();
+    VulkanUtils::LogInfo("SceneManager: parallel import: {} sources parsed, {} primitives extracted, {} textures prepared on {} workers in {:.2f} ms",
+                         parseTasks.size(), s_preparedGltfMeshes.size(), s_preparedGltfTextures.size(),
+                         m_pJobQueue->GetWorkerThreadCount(), m_meshImportStats.fParallelImportMs);
+}
+
 void SceneManager::ClearGltfCache() {
     if (!s_gltfModelCache.empty()) {
         VulkanUtils::LogInfo("SceneManager: cleared {} cached glTF models", s_gltfModelCache.size());
         s_gltfModelCache.clear();
     }
+    s_gltfSourceHashCache.clear();
 }
 
 void SceneManager::LoadLightsFromJson(const nlohmann::json& j) {
@@ -1221,6 +1983,7 @@ uint32_t SceneManager::GenerateStressTestScene(const StressTestParams& params, c
     }
     
     UnloadScene();
+    CancelLevelLoad();
     m_currentScene = std::make_unique<Scene>("Stress Test");
     
     // Load the glTF model (uses cache)
@@ -1258,7 +2021,10 @@ uint32_t SceneManager::GenerateStressTestScene(const StressTestParams& params, c
                     const tinygltf::Image& img = pModel->images[size_t(tex.source)];
                     if (!img.image.empty() && img.width > 0 && img.height > 0) {
                         std::string texName = "stress_test_tex";
-                        pTexture = m_pTextureManager->GetOrCreateFromMemory(texName, img.width, img.height, img.component, img.image.data());
+                        if (img.as_is)
+                            pTexture = m_pTextureManager->GetOrCreateFromEncoded(texName, img.image.data(), img.image.size());
+                        else
+                            pTexture = m_pTextureManager->GetOrCreateFromMemory(texName, img.width, img.height, img.component, img.image.data());
                     }
                 }
             }
@@ -1305,16 +2071,27 @@ uint32_t SceneManager::GenerateStressTestScene(const StressTestParams& params, c
     
     uint32_t totalCount = GetStressTestObjectCount(params);
     uint32_t created = 0;
+    const auto spawnStart = std::chrono::steady_clock::now();
     
-    // Create objects for each tier
+    // Create objects for each tier: one bulk spawn per tier, then per-object values written in place
     auto createObjects = [&](uint32_t count, InstanceTier tier, const char* namePrefix) {
-        for (uint32_t i = 0; i < count && created < totalCount; ++i) {
-            Object obj;
-            obj.name = std::string(namePrefix) + "_" + std::to_string(i);
-            obj.instanceTier = tier;
-            obj.pMesh = pMesh;
-            obj.pMaterial = pMaterial;
-            obj.pTexture = pTexture;
+        count = std::min(count, totalCount - created);
+        Object templateObj;
+        templateObj.instanceTier = tier;
+        templateObj.pMesh = pMesh;
+        templateObj.pMaterial = pMaterial;
+        templateObj.pTexture = pTexture;
+        GameObjectArchetype archetype;
+        archetype.bHasRenderer = true;
+        ObjectToRenderer(templateObj, archetype.renderer);
+        archetype.namePrefix = namePrefix;
+        const SpawnRange range = m_currentScene->CreateGameObjects(count, archetype);
+        std::vector<Transform>& transforms = m_currentScene->GetTransforms();
+        std::vector<RendererComponent>& renderers = m_currentScene->GetRenderers();
+        
+        for (uint32_t i = 0; i < range.count; ++i) {
+            Transform& transform = transforms[range.firstTransform + i];
+            float* color = renderers[range.firstRenderer + i].matProps.baseColor;
             
             // Random position
             float px = nextFloatRange(-params.worldSize, params.worldSize);
@@ -1339,22 +2116,23 @@ uint32_t SceneManager::GenerateStressTestScene(const StressTestParams& params, c
                 float q = v * (1.0f - s * f);
                 float t = v * (1.0f - s * (1.0f - f));
                 switch (hi % 6) {
-                    case 0: obj.color[0] = v; obj.color[1] = t; obj.color[2] = p; break;
-                    case 1: obj.color[0] = q; obj.color[1] = v; obj.color[2] = p; break;
-                    case 2: obj.color[0] = p; obj.color[1] = v; obj.color[2] = t; break;
-                    case 3: obj.color[0] = p; obj.color[1] = q; obj.color[2] = v; break;
-                    case 4: obj.color[0] = t; obj.color[1] = p; obj.color[2] = v; break;
-                    default: obj.color[0] = v; obj.color[1] = p; obj.color[2] = q; break;
+                    case 0: color[0] = v; color[1] = t; color[2] = p; break;
+                    case 1: color[0] = q; color[1] = v; color[2] = p; break;
+                    case 2: color[0] = p; color[1] = v; color[2] = t; break;
+                    case 3: color[0] = p; color[1] = q; color[2] = v; break;
+                    case 4: color[0] = t; color[1] = p; color[2] = v; break;
+                    default: color[0] = v; color[1] = p; color[2] = q; break;
                 }
-                obj.color[3] = 1.0f;
+                color[3] = 1.0f;
             } else {
-                obj.color[0] = obj.color[1] = obj.color[2] = obj.color[3] = 1.0f;
+                color[0] = color[1] = color[2] = color[3] = 1.0f;
             }
             
-            ObjectSetFromPositionRotationScale(obj.localTransform, px, py, pz, qx, qy, qz, qw, scale, scale, scale);
-            AddObject(std::move(obj));
-            ++created;
+            transform.position[0] = px; transform.position[1] = py; transform.position[2] = pz;
+            transform.rotation[0] = qx; transform.rotation[1] = qy; transform.rotation[2] = qz; transform.rotation[3] = qw;
+            transform.scale[0] = transform.scale[1] = transform.scale[2] = scale;
         }
+        created += range.count;
     };
     
     createObjects(params.staticCount, InstanceTier::Static, "static");
@@ -1362,6 +2140,7 @@ uint32_t SceneManager::GenerateStressTestScene(const StressTestParams& params, c
     createObjects(params.dynamicCount, InstanceTier::Dynamic, "dynamic");
     createObjects(params.proceduralCount, InstanceTier::Procedural, "procedural");
     
-    VulkanUtils::LogInfo("Stress test generated: {} objects from {}", created, modelPath);
+    VulkanUtils::LogInfo("Stress test generated: {} objects from {} (spawn {:.2f} ms)", created, modelPath,
+                         std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - spawnStart).count());
     return created;
 }
@@ -2,22 +2,40 @@
 
 #include "gltf_loader.h"
 #include "scene/scene_unified.h"
+#include "scene/level_selector.h"
 #include "scene/stress_test_generator.h"
 #include "scene/object.h"
 #include <nlohmann/json_fwd.hpp>
 #include <memory>
 #include <string>
 #include <map>
+#include <set>
+#include <vector>
 
 namespace tinygltf {
 class Model;
 struct Primitive;
 }
 
+class JobQueue;
 class MaterialManager;
 class MeshManager;
+
+/**
+ * Per-level mesh import counters (reset by LoadLevelFromFile, logged when the level finishes loading).
+ */
+struct MeshImportStats {
+    uint32_t lDecodedPrimitives = 0u;  // Decoded from glTF accessors (cold)
+    uint32_t lCookedPrimitives  = 0u;  // Loaded from .vmesh (warm)
+    uint64_t uDecodedVertices   = 0u;
+    double   fDecodeMs          = 0.0; // Accessor decode + interleave + meshlet build (summed over workers)
+    uint32_t lParsedSources     = 0u;  // glTF files read + parsed (+ images decoded) on workers
+    double   fParallelImportMs  = 0.0; // Wall time of the worker phase (parse + decode)
+};
 class TextureManager;
 struct GltfNodeVisitorContext;
+struct LevelInstanceDesc;
+struct AsyncLevelLoad;
 
 /**
  * SceneManager: owns current scene and level loading. Level = JSON descriptor + many glTFs (one per instance).
@@ -27,8 +45,11 @@ struct GltfNodeVisitorContext;
 class SceneManager {
 public:
     SceneManager() = default;
+    ~SceneManager();
 
     void SetDependencies(MaterialManager* pMaterialManager_ic, MeshManager* pMeshManager_ic, TextureManager* pTextureManager_ic);
+    /** Worker pool for the CPU phase of level import (glTF read/parse/image decode, vertex extraction). Null = serial import. */
+    void SetJobQueue(JobQueue* pJobQueue_ic);
 
     void UnloadScene();
 
@@ -40,6 +61,28 @@ public:
 
     bool LoadLevelFromFile(const std::string& path);
 
+    /**
+     * Progressive level load: GameObjects, transforms and lights are created immediately, glTF instances start as
+     * placeholder cubes. Sources are parsed/extracted on the JobQueue; UpdateLevelLoad swaps in the real objects.
+     * Falls back to LoadLevelFromFile when no JobQueue is set.
+     */
+    bool BeginLevelLoadAsync(const std::string& path);
+    /**
+     * Per-frame pump: picks up finished worker tasks and resolves ready instances (mesh/texture upload) until
+     * fBudgetMs_ic is spent (at least one instance per call). Returns instances resolved; non-zero = draw list is stale.
+     */
+    uint32_t UpdateLevelLoad(float fBudgetMs_ic);
+    bool IsLevelLoading() const { return m_pAsyncLoad != nullptr; }
+    LevelLoadProgress GetLevelLoadProgress() const;
+    /** Drop an in-flight progressive load (waits for its worker tasks). Placeholders stay as they are. */
+    void CancelLevelLoad();
+    /**
+     * Material ids the current level resolves to (ResolvePipelineKey of every instance and glTF material), appended
+     * to vecIds_out once each as they become known: at load start, and as progressive-load sources finish parsing.
+     * The app prewarms their pipelines before objects draw with them.
+     */
+    void ConsumeLevelMaterialIds(std::vector<std::string>& vecIds_out);
+
     void EnsureDefaultLevelFile(const std::string& path);
 
     bool LoadDefaultLevelOrCreate(const std::string& defaultLevelPath);
@@ -52,6 +95,9 @@ public:
 
     uint32_t GenerateStressTestScene(const StressTestParams& params, const std::string& modelPath);
 
+    /** Mesh import counters of the last LoadLevelFromFile. */
+    const MeshImportStats& GetMeshImportStats() const { return m_meshImportStats; }
+
 private:
     std::shared_ptr<MeshHandle> LoadProceduralMesh(const std::string& source);
 
@@ -63,8 +109,32 @@ private:
 
     void VisitGltfNode(GltfNodeVisitorContext& ctx, int nodeIndex, const float* parentMatrix);
 
+    /** Record a material id of the loading level (see ConsumeLevelMaterialIds). */
+    void NoteLevelMaterial(const std::string& sMaterialId);
+    /** Record the material id of every primitive of model as drawn with renderMode. */
+    void NoteGltfMaterials(const tinygltf::Model& model, RenderMode renderMode);
+    void ResetLevelMaterials();
+
+    /** Build the Object of a "procedural:" instance. Returns false (logged) if mesh or material is missing. */
+    bool BuildProceduralObject(const LevelInstanceDesc& desc, Object& out);
+    /** Visit the glTF scene roots of one instance; appends Objects and (childObjIndex, parentObjIndex) pairs. */
+    void AppendGltfInstanceObjects(const LevelInstanceDesc& desc, const tinygltf::Model& model,
+                                   std::vector<Object>& objs, std::vector<std::pair<size_t, size_t>>& hierarchyPairs);
+    /** Replace the placeholder of a progressive-load instance with its glTF objects (same hierarchy as LoadLevelFromFile). */
+    void ResolveAsyncInstance(AsyncLevelLoad& load, size_t instanceIndex);
+    void FinishLevelLoad();
+
     const tinygltf::Model* GetOrLoadGltfModel(const std::string& path);
 
+    /**
+     * CPU phase of level import: parse every uncached glTF in vecPaths_ic on the JobQueue (one task per source,
+     * images decoded by tinygltf inside the task), then extract vertices + meshlets per primitive that is neither
+     * resident nor cooked (one task per primitive) and cook every embedded texture to its GPU format (one task per
+     * texture, see TextureManager::CookTexture). Results are consumed by VisitGltfNode on the main thread,
+     * which then only creates Vulkan objects and GameObjects.
+     */
+    void PrefetchGltfSources(const std::vector<std::string>& vecPaths_ic);
+
     void ClearGltfCache();
 
     /** Convert Object to Transform for AddTransform. */
@@ -77,7 +147,12 @@ private:
     MaterialManager* m_pMaterialManager = nullptr;
     MeshManager*     m_pMeshManager     = nullptr;
     TextureManager*  m_pTextureManager  = nullptr;
+    JobQueue*        m_pJobQueue        = nullptr;
     std::unique_ptr<Scene> m_currentScene;
+    std::unique_ptr<AsyncLevelLoad> m_pAsyncLoad;  // Non-null while a progressive load is in flight
+    std::set<std::string> m_levelMaterialIds;
+    std::vector<std::string> m_vecNewLevelMaterialIds;  // Not yet taken by ConsumeLevelMaterialIds
 
     std::map<std::string, std::shared_ptr<MeshHandle>> m_proceduralMeshCache;
+    MeshImportStats m_meshImportStats;
 };
@@ -0,0 +1,156 @@
+/*
+ * TextureArrayPool — small textures packed as layers of shared 2D-array images.
+ */
+#include "texture_array_pool.h"
+#include "vulkan/vulkan_utils.h"
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+// TextureArrayPage
+// -----------------------------------------------------------------------------
+TextureArrayPage::TextureArrayPage(VkDevice device, VkImage image, const MemoryAllocation& memory, uint32_t lLayerCount_ic, VkDeviceSize uBytes_ic)
+    : m_device(device)
+    , m_image(image)
+    , m_memory(memory)
+    , m_lLayerCount(lLayerCount_ic)
+    , m_uBytes(uBytes_ic) {
+    // Hand out low layers first (popped from the back)
+    this->m_vecFreeLayers.reserve(lLayerCount_ic);
+    for (uint32_t lLayer = lLayerCount_ic; lLayer > 0u; --lLayer)
+        this->m_vecFreeLayers.push_back(lLayer - 1u);
+}
+
+TextureArrayPage::~TextureArrayPage() {
+    if (this->m_image != VK_NULL_HANDLE)
+        vkDestroyImage(this->m_device, this->m_image, nullptr);
+    VulkanMemory::Free(this->m_device, this->m_memory);
+}
+
+bool TextureArrayPage::AcquireLayer(uint32_t& lLayer_out) {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    if (this->m_vecFreeLayers.empty() == true)
+        return false;
+    lLayer_out = this->m_vecFreeLayers.back();
+    this->m_vecFreeLayers.pop_back();
+    return true;
+}
+
+void TextureArrayPage::ReleaseLayer(uint32_t lLayer_ic) {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    if (lLayer_ic < this->m_lLayerCount)
+        this->m_vecFreeLayers.push_back(lLayer_ic);
+}
+
+uint32_t TextureArrayPage::GetUsedLayerCount() const {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    return this->m_lLayerCount - static_cast<uint32_t>(this->m_vecFreeLayers.size());
+}
+
+// -----------------------------------------------------------------------------
+// TextureArrayPool
+// -----------------------------------------------------------------------------
+void TextureArrayPool::SetDevice(VkDevice device, VkPhysicalDevice physicalDevice) {
+    this->m_device = device;
+    this->m_physicalDevice = physicalDevice;
+    this->m_lDeviceMaxLayers = 1u;
+    if (physicalDevice != VK_NULL_HANDLE) {
+        VkPhysicalDeviceProperties stProps = {};
+        vkGetPhysicalDeviceProperties(physicalDevice, &stProps);
+        this->m_lDeviceMaxLayers = std::max(stProps.limits.maxImageArrayLayers, 1u);
+    }
+}
+
+bool TextureArrayPool::IsEligible(uint32_t lWidth_ic, uint32_t lHeight_ic) const {
+    return (this->m_lMaxSize > 0u) && (this->m_device != VK_NULL_HANDLE) &&
+           (std::max(lWidth_ic, lHeight_ic) <= this->m_lMaxSize);
+}
+
+std::shared_ptr<TextureArrayPage> TextureArrayPool::AcquireLayer(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                                                                 uint32_t lMipLevels_ic, VkDeviceSize uLayerBytes_ic, uint32_t& lLayer_out) {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    std::vector<std::shared_ptr<TextureArrayPage>>& vecPages = this->m_pages[{ eFormat_ic, lWidth_ic, lHeight_ic, lMipLevels_ic }];
+    for (const std::shared_ptr<TextureArrayPage>& pPage : vecPages) {
+        if (pPage->AcquireLayer(lLayer_out) == true)
+            return pPage;
+    }
+
+    // Grow geometrically so a shape used once does not reserve a full page
+    const uint32_t lShift = std::min(static_cast<uint32_t>(vecPages.size()), 16u);
+    const uint32_t lBudgetLayers = static_cast<uint32_t>(std::max<VkDeviceSize>(kPageBudgetBytes / std::max<VkDeviceSize>(uLayerBytes_ic, 1u), 1u));
+    const uint32_t lLayers = std::max(std::min({ kFirstPageLayers << lShift, lBudgetLayers, kMaxLayersPerPage, this->m_lDeviceMaxLayers }), 1u);
+    std::shared_ptr<TextureArrayPage> pPage = CreatePage(eFormat_ic, lWidth_ic, lHeight_ic, lMipLevels_ic, lLayers);
+    if ((pPage == nullptr) || (pPage->AcquireLayer(lLayer_out) == false))
+        return nullptr;
+    vecPages.push_back(pPage);
+    VulkanUtils::LogDebug("TextureArrayPool: page {}x{} ({} mips, format {}) with {} layers, {} KB",
+                          lWidth_ic, lHeight_ic, lMipLevels_ic, static_cast<int>(eFormat_ic), lLayers, pPage->GetBytes() / 1024u);
+    return pPage;
+}
+
+std::shared_ptr<TextureArrayPage> TextureArrayPool::CreatePage(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                                                               uint32_t lMipLevels_ic, uint32_t lLayerCount_ic) {
+    VkImage image = VK_NULL_HANDLE;
+    VkImageCreateInfo imageInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = static_cast<VkImageCreateFlags>(0),
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = eFormat_ic,
+        .extent = { lWidth_ic, lHeight_ic, 1 },
+        .mipLevels = lMipLevels_ic,
+        .arrayLayers = lLayerCount_ic,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .tiling = VK_IMAGE_TILING_OPTIMAL,
+        // TRANSFER_SRC for GPU mip blits of the layers that need them
+        .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+    if (vkCreateImage(this->m_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        VulkanUtils::LogWarn("TextureArrayPool: failed to create {}x{} page with {} layers", lWidth_ic, lHeight_ic, lLayerCount_ic);
+        return nullptr;
+    }
+    MemoryAllocation memory;
+    if (VulkanMemory::AllocateForImage(this->m_device, this->m_physicalDevice, image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                       MemoryCategory::Texture, false, memory) != VK_SUCCESS) {
+        vkDestroyImage(this->m_device, image, nullptr);
+        VulkanUtils::LogWarn("TextureArrayPool: failed to allocate {}x{} page with {} layers", lWidth_ic, lHeight_ic, lLayerCount_ic);
+        return nullptr;
+    }
+    return std::make_shared<TextureArrayPage>(this->m_device, image, memory, lLayerCount_ic, memory.uSize);
+}
+
+void TextureArrayPool::TrimEmpty() {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    for (auto it = this->m_pages.begin(); it != this->m_pages.end(); ) {
+        std::vector<std::shared_ptr<TextureArrayPage>>& vecPages = it->second;
+        vecPages.erase(std::remove_if(vecPages.begin(), vecPages.end(), [](const std::shared_ptr<TextureArrayPage>& pPage) {
+            return pPage->GetUsedLayerCount() == 0u;
+        }), vecPages.end());
+        if (vecPages.empty() == true)
+            it = this->m_pages.erase(it);
+        else
+            ++it;
+    }
+}
+
+TextureArrayPoolStats TextureArrayPool::GetStats() const {
+    TextureArrayPoolStats stStats;
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    for (const auto& entry : this->m_pages) {
+        for (const std::shared_ptr<TextureArrayPage>& pPage : entry.second) {
+            ++stStats.lPages;
+            stStats.lLayers += pPage->GetLayerCount();
+            stStats.lUsedLayers += pPage->GetUsedLayerCount();
+            stStats.uBytes += pPage->GetBytes();
+        }
+    }
+    return stStats;
+}
+
+void TextureArrayPool::Destroy() {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->m_pages.clear();
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "vulkan/vulkan_memory.h"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+/**
+ * TextureArrayPage — one 2D-array VkImage whose layers each hold a small texture of the same shape
+ * (format, extent, mip count). Referenced by TextureArrayPool while it may hand out layers and by every
+ * TextureHandle living in it; the image and its memory are destroyed with the last reference.
+ * Layers are acquired on the upload thread and released from any thread (handle destruction).
+ */
+class TextureArrayPage {
+public:
+    TextureArrayPage(VkDevice device, VkImage image, const MemoryAllocation& memory, uint32_t lLayerCount_ic, VkDeviceSize uBytes_ic);
+    ~TextureArrayPage();
+
+    TextureArrayPage(const TextureArrayPage&) = delete;
+    TextureArrayPage& operator=(const TextureArrayPage&) = delete;
+
+    /** Take a free layer; false when every layer is in use. */
+    bool AcquireLayer(uint32_t& lLayer_out);
+    /** Give a layer back. Its view must already be destroyed and no frame in flight may still sample it. */
+    void ReleaseLayer(uint32_t lLayer_ic);
+
+    VkImage GetImage() const { return this->m_image; }
+    uint32_t GetLayerCount() const { return this->m_lLayerCount; }
+    uint32_t GetUsedLayerCount() const;
+    VkDeviceSize GetBytes() const { return this->m_uBytes; }
+
+private:
+    VkDevice       m_device = VK_NULL_HANDLE;
+    VkImage        m_image = VK_NULL_HANDLE;
+    MemoryAllocation m_memory;
+    uint32_t       m_lLayerCount = 0u;
+    VkDeviceSize   m_uBytes = 0u;
+    mutable std::mutex m_mutex;
+    std::vector<uint32_t> m_vecFreeLayers;
+};
+
+/** Page counters (see TextureArrayPool::GetStats). */
+struct TextureArrayPoolStats {
+    uint32_t lPages       = 0u;
+    uint32_t lLayers      = 0u;  // Summed page capacity
+    uint32_t lUsedLayers  = 0u;
+    uint64_t uBytes       = 0u;  // Device memory of every page
+};
+
+/**
+ * TextureArrayPool — packs small textures (max(width, height) <= GetMaxSize) into shared 2D-array pages so that
+ * hundreds of tiny images do not each cost a VkImage, a device allocation and its alignment padding.
+ *
+ * Each texture still gets its own single-layer VK_IMAGE_VIEW_TYPE_2D view, so shaders, samplers (REPEAT wrap) and
+ * the bindless table see an ordinary texture. Pages of one shape start at kFirstPageLayers layers and double per
+ * new page, capped by kPageBudgetBytes, kMaxLayersPerPage and the device's maxImageArrayLayers.
+ */
+class TextureArrayPool {
+public:
+    static constexpr uint32_t     kFirstPageLayers = 4u;
+    static constexpr uint32_t     kMaxLayersPerPage = 64u;
+    static constexpr VkDeviceSize kPageBudgetBytes = 4ull * 1024u * 1024u;
+
+    TextureArrayPool() = default;
+
+    TextureArrayPool(const TextureArrayPool&) = delete;
+    TextureArrayPool& operator=(const TextureArrayPool&) = delete;
+
+    /** Device used for new pages (queries maxImageArrayLayers). */
+    void SetDevice(VkDevice device, VkPhysicalDevice physicalDevice);
+    /** Largest side packed into pages; 0 disables pooling. Applies to textures created afterwards. */
+    void SetMaxSize(uint32_t lMaxSize_ic) { this->m_lMaxSize = lMaxSize_ic; }
+    uint32_t GetMaxSize() const { return this->m_lMaxSize; }
+    bool IsEligible(uint32_t lWidth_ic, uint32_t lHeight_ic) const;
+
+    /**
+     * A free layer of a page with this shape, creating a page when every existing one is full.
+     * uLayerBytes_ic (one layer's full mip chain) sizes new pages. nullptr if the page cannot be created.
+     */
+    std::shared_ptr<TextureArrayPage> AcquireLayer(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic, uint32_t lMipLevels_ic,
+                                                   VkDeviceSize uLayerBytes_ic, uint32_t& lLayer_out);
+    /** Drop the pool's reference to pages with no layer in use (their memory is freed). */
+    void TrimEmpty();
+    TextureArrayPoolStats GetStats() const;
+    /** Forget every page; pages still holding textures are destroyed with their last handle. */
+    void Destroy();
+
+private:
+    std::shared_ptr<TextureArrayPage> CreatePage(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic, uint32_t lMipLevels_ic,
+                                                 uint32_t lLayerCount_ic);
+
+    VkDevice         m_device = VK_NULL_HANDLE;
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    uint32_t         m_lMaxSize = 0u;
+    uint32_t         m_lDeviceMaxLayers = 1u;
+    mutable std::mutex m_mutex;
+    /** Pages per (format, width, height, mip levels). */
+    std::map<std::tuple<VkFormat, uint32_t, uint32_t, uint32_t>, std::vector<std::shared_ptr<TextureArrayPage>>> m_pages;
+};
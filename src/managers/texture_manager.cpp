@@ -1,22 +1,78 @@
 /*
- * TextureManager — load images (stb_image), upload to VkImage, cache by path. Async via JobQueue.
+ * TextureManager — load images (stb_image) or DDS/KTX2 containers, cook to BC or RGBA8, upload to VkImage,
+ * cache by path. Async via JobQueue.
  */
 #define STB_IMAGE_IMPLEMENTATION
 #include "texture_manager.h"
+#include "deferred_release_queue.h"
+#include "bc_codec.h"
+#include "mip_generator.h"
+#include "pixel_convert.h"
+#include "vmesh_format.h"
+#include "vtex_format.h"
+#include "core/frame_arena.h"
 #include "thread/job_queue.h"
 #include "vulkan/vulkan_utils.h"
 #include <stb_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 namespace {
 
-void TransitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout) {
+/** Uncompressed upload formats (colour roles / data roles). */
+constexpr VkFormat kTextureFormat     = VK_FORMAT_R8G8B8A8_SRGB;
+constexpr VkFormat kTextureFormatData = VK_FORMAT_R8G8B8A8_UNORM;
+
+bool IsColorRole(TextureRole eRole) {
+    return (eRole == TextureRole::BaseColor) || (eRole == TextureRole::Emissive);
+}
+
+bool IsSrgbFormat(VkFormat eFormat) {
+    return (eFormat == VK_FORMAT_R8G8B8A8_SRGB) || (eFormat == VK_FORMAT_BC1_RGBA_SRGB_BLOCK) ||
+           (eFormat == VK_FORMAT_BC3_SRGB_BLOCK) || (eFormat == VK_FORMAT_BC7_SRGB_BLOCK);
+}
+
+/**
+ * Devices without textureCompressionBC: decode every BC level back to RGBA8 (sRGB kept for colour formats).
+ * False if a block cannot be decoded (partitioned BC7 modes).
+ */
+bool DecodeToRGBA8(GpuTextureData& stData) {
+    BCFormat eBC = BCFormat::BC1;
+    if (GetBCFormat(stData.eFormat, eBC) == false)
+        return false;
+    GpuTextureData stOut;
+    stOut.eFormat = IsSrgbFormat(stData.eFormat) ? kTextureFormat : kTextureFormatData;
+    stOut.lWidth = stData.lWidth;
+    stOut.lHeight = stData.lHeight;
+    size_t zOffset = 0u;
+    for (const MipLevelDesc& st : stData.vecLevels) {
+        const size_t zSize = static_cast<size_t>(st.lWidth) * st.lHeight * 4u;
+        stOut.vecLevels.push_back({ st.lWidth, st.lHeight, zOffset, zSize });
+        zOffset += zSize;
+    }
+    stOut.vecData.resize(zOffset);
+    for (size_t i = 0; i < stData.vecLevels.size(); ++i) {
+        const MipLevelDesc& stSrc = stData.vecLevels[i];
+        if (DecodeBCImage(eBC, stData.vecData.data() + stSrc.zOffset, stSrc.lWidth, stSrc.lHeight,
+                          stOut.vecData.data() + stOut.vecLevels[i].zOffset) == false)
+            return false;
+    }
+    stData = std::move(stOut);
+    return true;
+}
+
+void ImageMipBarrier(VkCommandBuffer cmd, VkImage image, uint32_t lBaseMip, uint32_t lLevelCount,
+                     VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+                     VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage, uint32_t lLayer = 0u) {
     VkImageMemoryBarrier barrier = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
         .pNext = nullptr,
-        .srcAccessMask = static_cast<VkAccessFlags>(0),
-        .dstAccessMask = static_cast<VkAccessFlags>(0),
+        .srcAccessMask = srcAccess,
+        .dstAccessMask = dstAccess,
         .oldLayout = oldLayout,
         .newLayout = newLayout,
         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
@@ -24,27 +80,66 @@ void TransitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout old
         .image = image,
         .subresourceRange = {
             .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-            .baseMipLevel = 0,
-            .levelCount = 1,
-            .baseArrayLayer = 0,
+            .baseMipLevel = lBaseMip,
+            .levelCount = lLevelCount,
+            .baseArrayLayer = lLayer,
             .layerCount = 1,
         },
     };
-    VkPipelineStageFlags srcStage, dstStage;
+    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void TransitionImageLayout(VkCommandBuffer cmd, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t lMipLevels = 1u,
+                           uint32_t lLayer = 0u) {
     if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        ImageMipBarrier(cmd, image, 0u, lMipLevels, oldLayout, newLayout, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, lLayer);
     } else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    } else {
-        return;
+        ImageMipBarrier(cmd, image, 0u, lMipLevels, oldLayout, newLayout, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, lLayer);
     }
-    vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+/**
+ * Fill mips 1..lMipLevels-1 from level 0 with linear vkCmdBlitImage (each level halves the previous one).
+ * Expects every level in TRANSFER_DST_OPTIMAL with level 0 written; leaves every level in SHADER_READ_ONLY_OPTIMAL.
+ * Only array layer lLayer is touched.
+ */
+void RecordMipBlits(VkCommandBuffer cmd, VkImage image, uint32_t lWidth, uint32_t lHeight, uint32_t lMipLevels, uint32_t lLayer = 0u) {
+    int32_t iSrcW = static_cast<int32_t>(lWidth);
+    int32_t iSrcH = static_cast<int32_t>(lHeight);
+    for (uint32_t lLevel = 1u; lLevel < lMipLevels; ++lLevel) {
+        const int32_t iDstW = (iSrcW > 1) ? (iSrcW / 2) : 1;
+        const int32_t iDstH = (iSrcH > 1) ? (iSrcH / 2) : 1;
+        ImageMipBarrier(cmd, image, lLevel - 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, lLayer);
+        VkImageBlit blit = {
+            .srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, lLevel - 1u, lLayer, 1 },
+            .srcOffsets = { { 0, 0, 0 }, { iSrcW, iSrcH, 1 } },
+            .dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, lLevel, lLayer, 1 },
+            .dstOffsets = { { 0, 0, 0 }, { iDstW, iDstH, 1 } },
+        };
+        vkCmdBlitImage(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       1, &blit, VK_FILTER_LINEAR);
+        ImageMipBarrier(cmd, image, lLevel - 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
+                        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, lLayer);
+        iSrcW = iDstW;
+        iSrcH = iDstH;
+    }
+    ImageMipBarrier(cmd, image, lMipLevels - 1u, 1u, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, lLayer);
+}
+
+/** First level whose larger side is <= lTailSize (the always-resident mip tail). */
+uint32_t FindTailLevel(const std::vector<MipLevelDesc>& vecLevels, uint32_t lTailSize) {
+    for (uint32_t lL = 0u; lL < static_cast<uint32_t>(vecLevels.size()); ++lL) {
+        if (std::max(vecLevels[lL].lWidth, vecLevels[lL].lHeight) <= lTailSize)
+            return lL;
+    }
+    return vecLevels.empty() ? 0u : static_cast<uint32_t>(vecLevels.size() - 1u);
 }
 
 } // namespace
@@ -61,12 +156,13 @@ TextureHandle::TextureHandle(TextureHandle&& other) noexcept
     , m_image(other.m_image)
     , m_view(other.m_view)
     , m_sampler(other.m_sampler)
-    , m_memory(other.m_memory) {
+    , m_memory(std::exchange(other.m_memory, {}))
+    , m_pArrayPage(std::move(other.m_pArrayPage))
+    , m_lArrayLayer(other.m_lArrayLayer) {
     other.m_device = VK_NULL_HANDLE;
     other.m_image = VK_NULL_HANDLE;
     other.m_view = VK_NULL_HANDLE;
     other.m_sampler = VK_NULL_HANDLE;
-    other.m_memory = VK_NULL_HANDLE;
 }
 
 TextureHandle& TextureHandle::operator=(TextureHandle&& other) noexcept {
@@ -76,16 +172,17 @@ TextureHandle& TextureHandle::operator=(TextureHandle&& other) noexcept {
     m_image = other.m_image;
     m_view = other.m_view;
     m_sampler = other.m_sampler;
-    m_memory = other.m_memory;
+    m_memory = std::exchange(other.m_memory, {});
+    m_pArrayPage = std::move(other.m_pArrayPage);
+    m_lArrayLayer = other.m_lArrayLayer;
     other.m_device = VK_NULL_HANDLE;
     other.m_image = VK_NULL_HANDLE;
     other.m_view = VK_NULL_HANDLE;
     other.m_sampler = VK_NULL_HANDLE;
-    other.m_memory = VK_NULL_HANDLE;
     return *this;
 }
 
-void TextureHandle::Set(VkDevice device, VkImage image, VkImageView view, VkSampler sampler, VkDeviceMemory memory) {
+void TextureHandle::Set(VkDevice device, VkImage image, VkImageView view, VkSampler sampler, const MemoryAllocation& memory) {
     Destroy();
     m_device = device;
     m_image = image;
@@ -94,12 +191,18 @@ void TextureHandle::Set(VkDevice device, VkImage image, VkImageView view, VkSamp
     m_memory = memory;
 }
 
+void TextureHandle::SetArrayLayer(VkDevice device, VkImageView view, VkSampler sampler, std::shared_ptr<TextureArrayPage> pPage_in, uint32_t lLayer_ic) {
+    Destroy();
+    m_device = device;
+    m_view = view;
+    m_sampler = sampler;
+    m_pArrayPage = std::move(pPage_in);
+    m_lArrayLayer = lLayer_ic;
+}
+
 void TextureHandle::Destroy() {
     if (m_device == VK_NULL_HANDLE) return;
-    if (m_sampler != VK_NULL_HANDLE) {
-        vkDestroySampler(m_device, m_sampler, nullptr);
-        m_sampler = VK_NULL_HANDLE;
-    }
+    m_sampler = VK_NULL_HANDLE;
     if (m_view != VK_NULL_HANDLE) {
         vkDestroyImageView(m_device, m_view, nullptr);
         m_view = VK_NULL_HANDLE;
@@ -108,9 +211,10 @@ void TextureHandle::Destroy() {
         vkDestroyImage(m_device, m_image, nullptr);
         m_image = VK_NULL_HANDLE;
     }
-    if (m_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_device, m_memory, nullptr);
-        m_memory = VK_NULL_HANDLE;
+    VulkanMemory::Free(m_device, m_memory);
+    if (m_pArrayPage != nullptr) {
+        m_pArrayPage->ReleaseLayer(m_lArrayLayer);
+        m_pArrayPage.reset();
     }
     m_device = VK_NULL_HANDLE;
 }
@@ -124,10 +228,29 @@ void TextureManager::SetJobQueue(JobQueue* pJobQueue) {
 
 void TextureManager::SetDevice(VkDevice device) {
     m_device = device;
+    m_arrayPool.SetDevice(m_device, m_physicalDevice);
 }
 
 void TextureManager::SetPhysicalDevice(VkPhysicalDevice physicalDevice) {
     m_physicalDevice = physicalDevice;
+    m_arrayPool.SetDevice(m_device, m_physicalDevice);
+    m_bSamplerAnisotropy = false;
+    m_fMaxDeviceAnisotropy = 1.0f;
+    m_fMaxDeviceLodBias = 0.0f;
+    m_bTextureCompressionBC = false;
+    if (physicalDevice == VK_NULL_HANDLE)
+        return;
+    /* VulkanDevice enables every supported core feature, so support == enabled. */
+    VkPhysicalDeviceFeatures stFeatures = {};
+    vkGetPhysicalDeviceFeatures(physicalDevice, &stFeatures);
+    VkPhysicalDeviceProperties stProps = {};
+    vkGetPhysicalDeviceProperties(physicalDevice, &stProps);
+    m_bSamplerAnisotropy = (stFeatures.samplerAnisotropy == VK_TRUE);
+    m_fMaxDeviceAnisotropy = stProps.limits.maxSamplerAnisotropy;
+    m_fMaxDeviceLodBias = stProps.limits.maxSamplerLodBias;
+    m_bTextureCompressionBC = (stFeatures.textureCompressionBC == VK_TRUE);
+    VulkanUtils::LogInfo("TextureManager: samplerAnisotropy {} (max {}x), linear blit mips for R8G8B8A8_SRGB: {}, textureCompressionBC {}",
+        m_bSamplerAnisotropy, m_fMaxDeviceAnisotropy, SupportsLinearBlit(kTextureFormat), m_bTextureCompressionBC);
 }
 
 void TextureManager::SetQueue(VkQueue queue) {
@@ -210,146 +333,643 @@ std::shared_ptr<TextureHandle> TextureManager::GetOrCreateDefaultOcclusionTextur
     return pHandle;
 }
 
-std::shared_ptr<TextureHandle> TextureManager::GetOrCreateFromMemory(const std::string& cacheKey, int width, int height, int channels, const unsigned char* pPixels) {
+std::shared_ptr<TextureHandle> TextureManager::GetOrCreateFromMemory(const std::string& cacheKey, int width, int height, int channels, const unsigned char* pPixels,
+                                                                     TextureRole eRole) {
     if (cacheKey.empty() || pPixels == nullptr || width <= 0 || height <= 0 || channels <= 0)
         return nullptr;
     auto it = m_cache.find(cacheKey);
     if (it != m_cache.end())
         return it->second;
-    std::shared_ptr<TextureHandle> pHandle = UploadTexture(width, height, channels, pPixels);
+    std::shared_ptr<TextureHandle> pHandle = UploadTexture(width, height, channels, pPixels, eRole);
+    if (pHandle != nullptr)
+        m_cache[cacheKey] = pHandle;
+    return pHandle;
+}
+
+std::shared_ptr<TextureHandle> TextureManager::GetOrCreateFromCompressed(const std::string& cacheKey, const GpuTextureData& stData_ic) {
+    if (cacheKey.empty() || stData_ic.vecLevels.empty())
+        return nullptr;
+    auto it = m_cache.find(cacheKey);
+    if (it != m_cache.end())
+        return it->second;
+    std::shared_ptr<TextureHandle> pHandle;
+    if (IsBlockCompressedFormat(stData_ic.eFormat) == true && SupportsSampledFormat(stData_ic.eFormat) == false) {
+        GpuTextureData stDecoded = stData_ic;
+        if (DecodeToRGBA8(stDecoded) == false) {
+            VulkanUtils::LogErr("TextureManager: {} uses a BC format the device cannot sample and the CPU decoder does not support", cacheKey);
+            return nullptr;
+        }
+        pHandle = UploadTextureData(std::move(stDecoded));
+    } else {
+        pHandle = UploadTextureData(stData_ic);
+    }
+    if (pHandle != nullptr)
+        m_cache[cacheKey] = pHandle;
+    return pHandle;
+}
+
+std::shared_ptr<TextureHandle> TextureManager::GetOrCreateFromCooked(const std::string& cacheKey, uint64_t uSourceHash_ic, TextureRole eRole_ic) {
+    if (cacheKey.empty() || IsTextureCookingEnabled() == false)
+        return nullptr;
+    auto it = m_cache.find(cacheKey);
+    if (it != m_cache.end())
+        return it->second;
+
+    const uint64_t uSettingsHash = GetCookSettingsHash(eRole_ic);
+    const std::string sPath = GetVTexCachePath(m_sCookedTextureDir, uSourceHash_ic, uSettingsHash);
+    MappedFile stFile;
+    if (stFile.Open(sPath) == false)
+        return nullptr;
+    VTexView stView;
+    if (ParseVTex(stFile.GetData(), stFile.GetSize(), uSourceHash_ic, uSettingsHash, stView) == false) {
+        VulkanUtils::LogDebug("TextureManager: cooked texture \"{}\" is stale or invalid, re-cooking", sPath);
+        return nullptr;
+    }
+    const VTexHeader& stHeader = *stView.pHeader;
+    std::vector<MipLevelDesc> vecLevels;
+    vecLevels.reserve(stHeader.levelCount);
+    for (uint32_t lL = 0u; lL < stHeader.levelCount; ++lL) {
+        const VTexLevel& st = stView.pLevels[lL];
+        vecLevels.push_back({ st.width, st.height, static_cast<size_t>(st.offset), static_cast<size_t>(st.size) });
+    }
+    /* Single copy: mapping -> staging buffer (level offsets index the mapping directly). */
+    std::shared_ptr<TextureHandle> pHandle;
+    if (m_streaming.bEnabled == true) {
+        StreamedTexture stStream;
+        stStream.eFormat = static_cast<VkFormat>(stHeader.format);
+        stStream.sVTexPath = sPath;
+        stStream.uSourceHash = uSourceHash_ic;
+        stStream.uSettingsHash = uSettingsHash;
+        stStream.vecLevels = std::move(vecLevels);
+        pHandle = UploadStreamable(std::move(stStream), stFile.GetData());
+    } else {
+        pHandle = UploadTextureLevels(static_cast<VkFormat>(stHeader.format), stHeader.width, stHeader.height,
+                                      vecLevels, stFile.GetData());
+    }
     if (pHandle != nullptr)
         m_cache[cacheKey] = pHandle;
     return pHandle;
 }
 
+std::shared_ptr<TextureHandle> TextureManager::GetOrCreateFromCookResult(const std::string& cacheKey, TextureRole eRole_ic,
+                                                                         const CookedTextureResult& stResult_ic) {
+    if (stResult_ic.bFromCache == true) {
+        std::shared_ptr<TextureHandle> pHandle = GetOrCreateFromCooked(cacheKey, stResult_ic.uSourceHash, eRole_ic);
+        if (pHandle != nullptr)
+            ++m_cookStats.lFromCache;
+        return pHandle;
+    }
+    ++m_cookStats.lCooked;
+    m_cookStats.fCookMs += stResult_ic.fCookMs;
+    return GetOrCreateFromCompressed(cacheKey, stResult_ic.stData);
+}
+
+std::shared_ptr<TextureHandle> TextureManager::GetOrCreateFromEncoded(const std::string& cacheKey, const uint8_t* pBytes_ic, size_t zSize_ic,
+                                                                      TextureRole eRole_ic) {
+    if (cacheKey.empty() || pBytes_ic == nullptr || zSize_ic == 0u)
+        return nullptr;
+    auto it = m_cache.find(cacheKey);
+    if (it != m_cache.end())
+        return it->second;
+    CookedTextureResult stResult;
+    if (CookEncodedTexture(eRole_ic, pBytes_ic, zSize_ic, stResult, m_pJobQueue) == false)
+        return nullptr;
+    return GetOrCreateFromCookResult(cacheKey, eRole_ic, stResult);
+}
+
 void TextureManager::RequestLoadTexture(const std::string& path) {
     if (m_pJobQueue == nullptr) return;
     if (m_pendingPaths.count(path) != 0) return;
     if (m_cache.count(path) != 0) return;
     m_pendingPaths.insert(path);
-    m_pJobQueue->SubmitLoadTexture(path);
+    m_pJobQueue->SubmitLoadTexture(path, [this, path](std::vector<uint8_t>& vecData_io) {
+        DecodeLoadedTexture(path, vecData_io);
+    });
+}
+
+void TextureManager::DecodeLoadedTexture(const std::string& sPath_ic, std::vector<uint8_t>& vecData_io) {
+    DecodedTexture stDecoded;
+    if (vecData_io.empty() == false) {
+        if (IsTextureContainerPath(sPath_ic) == true) {
+            GpuTextureData& stData = stDecoded.stResult.stData;
+            stDecoded.bContainer = true;
+            stDecoded.bOk = ParseTextureContainer(vecData_io.data(), vecData_io.size(), stData);
+            if ((stDecoded.bOk == true) && (IsBlockCompressedFormat(stData.eFormat) == true) && (SupportsSampledFormat(stData.eFormat) == false))
+                stDecoded.bOk = DecodeToRGBA8(stData);
+        } else {
+            // Warm: only the hash (the upload maps the .vtex); cold: decoded, cooked and written back here
+            stDecoded.bOk = CookEncodedTexture(TextureRole::BaseColor, vecData_io.data(), vecData_io.size(), stDecoded.stResult);
+        }
+    }
+    std::vector<uint8_t>().swap(vecData_io);
+    std::lock_guard<std::mutex> lock(m_decodedMutex);
+    m_decoded[sPath_ic] = std::move(stDecoded);
 }
 
 void TextureManager::OnCompletedTexture(const std::string& sPath_ic, std::vector<uint8_t> vecData_in) {
+    (void)vecData_in;
+    DecodedTexture stDecoded;
+    {
+        std::lock_guard<std::mutex> lock(m_decodedMutex);
+        auto it = m_decoded.find(sPath_ic);
+        if (it != m_decoded.end()) {
+            stDecoded = std::move(it->second);
+            m_decoded.erase(it);
+        }
+    }
     if (this->m_pendingPaths.erase(sPath_ic) == 0)
         return;
+    if (stDecoded.bOk == false) {
+        VulkanUtils::LogErr("TextureManager: failed to decode {}", sPath_ic);
+        return;
+    }
+    if (stDecoded.bContainer == true) {
+        const GpuTextureData& stData = stDecoded.stResult.stData;
+        const uint32_t lWidth = stData.lWidth;
+        const uint32_t lHeight = stData.lHeight;
+        const size_t zLevels = stData.vecLevels.size();
+        const VkFormat eFormat = stData.eFormat;
+        if (CacheUploadedData(sPath_ic, std::move(stDecoded.stResult.stData)) != nullptr)
+            VulkanUtils::LogInfo("TextureManager: loaded {} ({}x{}, {} levels, format {})", sPath_ic,
+                lWidth, lHeight, zLevels, static_cast<int>(eFormat));
+        return;
+    }
+    std::shared_ptr<TextureHandle> pHandle;
+    if (stDecoded.stResult.bFromCache == true) {
+        pHandle = GetOrCreateFromCookResult(sPath_ic, TextureRole::BaseColor, stDecoded.stResult);
+    } else {
+        ++m_cookStats.lCooked;
+        m_cookStats.fCookMs += stDecoded.stResult.fCookMs;
+        pHandle = CacheUploadedData(sPath_ic, std::move(stDecoded.stResult.stData));
+    }
+    if (pHandle == nullptr) {
+        VulkanUtils::LogErr("TextureManager: failed to upload {}", sPath_ic);
+        return;
+    }
+    VulkanUtils::LogInfo("TextureManager: loaded {}", sPath_ic);
+}
+
+std::shared_ptr<TextureHandle> TextureManager::CacheUploadedData(const std::string& cacheKey, GpuTextureData&& stData_in) {
+    auto it = m_cache.find(cacheKey);
+    if (it != m_cache.end())
+        return it->second;
+    std::shared_ptr<TextureHandle> pHandle = UploadTextureData(std::move(stData_in));
+    if (pHandle != nullptr)
+        m_cache[cacheKey] = pHandle;
+    return pHandle;
+}
+
+VkFormat TextureManager::SelectFormat(TextureRole eRole_ic) const {
+    if (this->m_bCompression == true && this->m_bTextureCompressionBC == true) {
+        VkFormat eBC = VK_FORMAT_UNDEFINED;
+        switch (eRole_ic) {
+        case TextureRole::BaseColor:
+        case TextureRole::Emissive:          eBC = VK_FORMAT_BC7_SRGB_BLOCK; break;
+        case TextureRole::Normal:            eBC = VK_FORMAT_BC5_UNORM_BLOCK; break;
+        case TextureRole::MetallicRoughness: eBC = VK_FORMAT_BC1_RGBA_UNORM_BLOCK; break;
+        case TextureRole::Occlusion:         eBC = VK_FORMAT_BC4_UNORM_BLOCK; break;
+        }
+        if (SupportsSampledFormat(eBC) == true)
+            return eBC;
+    }
+    return IsColorRole(eRole_ic) ? kTextureFormat : kTextureFormatData;
+}
+
+bool TextureManager::CookTexture(TextureRole eRole_ic, int width, int height, int channels, const unsigned char* pPixels,
+                                 GpuTextureData& stData_out, JobQueue* pJobQueue_ic) const {
+    stData_out = GpuTextureData{};
+    if (pPixels == nullptr || width <= 0 || height <= 0 || channels <= 0 || channels > 4)
+        return false;
+    const uint32_t lWidth = static_cast<uint32_t>(width);
+    const uint32_t lHeight = static_cast<uint32_t>(height);
+    const VkFormat eFormat = SelectFormat(eRole_ic);
+    const uint32_t lMipLevels = (m_sampling.bGenerateMips == true) ? ComputeMipLevelCount(lWidth, lHeight) : 1u;
+    BCFormat eBC = BCFormat::BC1;
+    const bool bBlockCompressed = GetBCFormat(eFormat, eBC);
+
+    const size_t zPixels = static_cast<size_t>(lWidth) * lHeight;
+    stData_out.eFormat = eFormat;
+    stData_out.lWidth = lWidth;
+    stData_out.lHeight = lHeight;
+
+    // RGBA8 that can be blitted: level 0 only, UploadTextureData generates the rest on the GPU
+    const bool bGpuMips = (bBlockCompressed == false) && (lMipLevels > 1u) && (UsesGpuMips(eFormat) == true);
+    if (lMipLevels == 1u || bGpuMips == true) {
+        stData_out.vecData.resize(zPixels * 4u);
+        ExpandToRGBA8(pPixels, zPixels, static_cast<uint32_t>(channels), stData_out.vecData.data());
+        stData_out.vecLevels.push_back({ lWidth, lHeight, 0u, stData_out.vecData.size() });
+        return true;
+    }
+
+    // Level 0 is expanded straight into the chain; the CPU filter fills the rest in place
+    std::vector<MipLevelDesc> vecRgbaLevels;
+    std::vector<uint8_t> vecChain(ComputeMipChainLayout(lWidth, lHeight, lMipLevels, vecRgbaLevels));
+    ExpandToRGBA8(pPixels, zPixels, static_cast<uint32_t>(channels), vecChain.data());
+    GenerateMipLevelsRGBA8(vecChain.data(), vecRgbaLevels, IsColorRole(eRole_ic), pJobQueue_ic);
+    if (bBlockCompressed == false) {
+        stData_out.vecLevels = std::move(vecRgbaLevels);
+        stData_out.vecData = std::move(vecChain);
+        return true;
+    }
+
+    // BC: encode every RGBA8 level into a packed block chain
+    size_t zOffset = 0u;
+    for (const MipLevelDesc& st : vecRgbaLevels) {
+        const size_t zSize = GetBCImageSize(eBC, st.lWidth, st.lHeight);
+        stData_out.vecLevels.push_back({ st.lWidth, st.lHeight, zOffset, zSize });
+        zOffset += zSize;
+    }
+    stData_out.vecData.resize(zOffset);
+    for (size_t i = 0; i < vecRgbaLevels.size(); ++i) {
+        const MipLevelDesc& st = vecRgbaLevels[i];
+        EncodeBCImage(eBC, vecChain.data() + st.zOffset, st.lWidth, st.lHeight,
+                      stData_out.vecData.data() + stData_out.vecLevels[i].zOffset, pJobQueue_ic);
+    }
+    return true;
+}
+
+uint64_t TextureManager::GetCookSettingsHash(TextureRole eRole_ic) const {
+    const VkFormat eFormat = SelectFormat(eRole_ic);
+    /* Same decisions as CookTexture: RGBA8 with GPU mips stores level 0 only (never when streaming), colour roles
+       filter mips in linear space. */
+    const uint32_t uSettings[4] = {
+        static_cast<uint32_t>(eFormat),
+        (m_sampling.bGenerateMips == true) ? 1u : 0u,
+        (UsesGpuMips(eFormat) == true) ? 1u : 0u,
+        IsColorRole(eRole_ic) ? 1u : 0u,
+    };
+    return HashBytesFnv1a(uSettings, sizeof(uSettings));
+}
+
+bool TextureManager::CookEncodedTexture(TextureRole eRole_ic, const uint8_t* pBytes_ic, size_t zSize_ic,
+                                        CookedTextureResult& stResult_out, JobQueue* pJobQueue_ic) const {
+    stResult_out = CookedTextureResult{};
+    if (pBytes_ic == nullptr || zSize_ic == 0u)
+        return false;
+    stResult_out.uSourceHash = HashBytesFnv1a(pBytes_ic, zSize_ic);
+    const uint64_t uSettingsHash = GetCookSettingsHash(eRole_ic);
+    const std::string sPath = IsTextureCookingEnabled() ? GetVTexCachePath(m_sCookedTextureDir, stResult_out.uSourceHash, uSettingsHash) : std::string();
+    if (sPath.empty() == false) {
+        MappedFile stFile;
+        VTexView stView;
+        if (stFile.Open(sPath) && ParseVTex(stFile.GetData(), stFile.GetSize(), stResult_out.uSourceHash, uSettingsHash, stView)) {
+            stResult_out.bFromCache = true;
+            return true;
+        }
+    }
+
+    const auto cookStart = std::chrono::steady_clock::now();
     int iWidth = 0;
     int iHeight = 0;
     int iChannels = 0;
-    unsigned char* pPixels = stbi_load_from_memory(
-        vecData_in.data(), static_cast<int>(vecData_in.size()), &iWidth, &iHeight, &iChannels, 4);
+    unsigned char* pPixels = stbi_load_from_memory(pBytes_ic, static_cast<int>(zSize_ic), &iWidth, &iHeight, &iChannels, 0);
     if ((pPixels == nullptr) || (iWidth <= 0) || (iHeight <= 0)) {
-        VulkanUtils::LogErr("TextureManager: failed to decode {}", sPath_ic);
-        return;
+        if (pPixels != nullptr)
+            stbi_image_free(pPixels);
+        return false;
     }
-    std::shared_ptr<TextureHandle> pHandle = UploadTexture(iWidth, iHeight, 4, pPixels);
+    const bool bCooked = CookTexture(eRole_ic, iWidth, iHeight, iChannels, pPixels, stResult_out.stData, pJobQueue_ic);
     stbi_image_free(pPixels);
-    if (pHandle != nullptr) {
-        this->m_cache[sPath_ic] = pHandle;
-        VulkanUtils::LogInfo("TextureManager: loaded {} ({}x{})", sPath_ic, iWidth, iHeight);
+    if (bCooked == false)
+        return false;
+    if (sPath.empty() == false) {
+        VTexCookInput stInput;
+        stInput.sourceContentHash = stResult_out.uSourceHash;
+        stInput.cookSettingsHash  = uSettingsHash;
+        stInput.format            = static_cast<uint32_t>(stResult_out.stData.eFormat);
+        stInput.width             = stResult_out.stData.lWidth;
+        stInput.height            = stResult_out.stData.lHeight;
+        stInput.pLevels           = &stResult_out.stData.vecLevels;
+        stInput.pData             = stResult_out.stData.vecData.data();
+        if (WriteVTexFile(sPath, stInput) == false)
+            VulkanUtils::LogWarn("TextureManager: failed to write cooked texture \"{}\"", sPath);
     }
+    stResult_out.fCookMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cookStart).count();
+    return true;
 }
 
-std::shared_ptr<TextureHandle> TextureManager::UploadTexture(int width, int height, int channels, const unsigned char* pPixels) {
+std::shared_ptr<TextureHandle> TextureManager::UploadTexture(int width, int height, int channels, const unsigned char* pPixels,
+                                                             TextureRole eRole) {
     if (m_device == VK_NULL_HANDLE || m_physicalDevice == VK_NULL_HANDLE || m_queue == VK_NULL_HANDLE ||
-        pPixels == nullptr || width <= 0 || height <= 0)
+        pPixels == nullptr || width <= 0 || height <= 0 || channels <= 0 || channels > 4)
+        return nullptr;
+    /* One RGBA8 level that is not kept for streaming: expand straight into the mapped staging buffer. */
+    const VkFormat eFormat = SelectFormat(eRole);
+    const bool bMips = (m_sampling.bGenerateMips == true) && (ComputeMipLevelCount(static_cast<uint32_t>(width), static_cast<uint32_t>(height)) > 1u);
+    if ((m_streaming.bEnabled == false) && (IsBlockCompressedFormat(eFormat) == false) && ((bMips == false) || (UsesGpuMips(eFormat) == true))) {
+        const size_t zPixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+        const std::vector<MipLevelDesc> vecLevels = { { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0u, zPixels * 4u } };
+        return UploadStagedLevels(eFormat, static_cast<uint32_t>(width), static_cast<uint32_t>(height), vecLevels,
+                                  [pPixels, zPixels, channels](uint8_t* pStaging_out) {
+                                      ExpandToRGBA8(pPixels, zPixels, static_cast<uint32_t>(channels), pStaging_out);
+                                  });
+    }
+    GpuTextureData stData;
+    if (CookTexture(eRole, width, height, channels, pPixels, stData, m_pJobQueue) == false)
+        return nullptr;
+    return UploadTextureData(std::move(stData));
+}
+
+std::shared_ptr<TextureHandle> TextureManager::UploadTextureData(const GpuTextureData& stData_ic) {
+    if (stData_ic.vecData.empty())
+        return nullptr;
+    if (m_streaming.bEnabled == true)
+        return UploadTextureData(GpuTextureData(stData_ic));
+    return UploadTextureLevels(stData_ic.eFormat, stData_ic.lWidth, stData_ic.lHeight, stData_ic.vecLevels, stData_ic.vecData.data());
+}
+
+std::shared_ptr<TextureHandle> TextureManager::UploadTextureData(GpuTextureData&& stData_in) {
+    if (stData_in.vecData.empty())
+        return nullptr;
+    if (m_streaming.bEnabled == false)
+        return UploadTextureLevels(stData_in.eFormat, stData_in.lWidth, stData_in.lHeight, stData_in.vecLevels, stData_in.vecData.data());
+    StreamedTexture stStream;
+    stStream.eFormat = stData_in.eFormat;
+    stStream.vecLevels = stData_in.vecLevels;
+    stStream.stData = std::move(stData_in);
+    return UploadStreamable(std::move(stStream), nullptr);
+}
+
+std::shared_ptr<TextureHandle> TextureManager::UploadStreamable(StreamedTexture stStream_in, const uint8_t* pMapped_ic) {
+    if (stStream_in.vecLevels.empty())
         return nullptr;
+    const uint8_t* pData = (pMapped_ic != nullptr) ? pMapped_ic : stStream_in.stData.vecData.data();
+    const uint32_t lWidth = stStream_in.vecLevels[0].lWidth;
+    const uint32_t lHeight = stStream_in.vecLevels[0].lHeight;
+    const uint32_t lTailLevel = FindTailLevel(stStream_in.vecLevels, m_streaming.lTailSize);
+    if (lTailLevel == 0u)
+        return UploadTextureLevels(stStream_in.eFormat, lWidth, lHeight, stStream_in.vecLevels, pData);
 
-    // Always use RGBA format (4 channels) for Vulkan upload
-    const int targetChannels = 4;
-    const VkDeviceSize imageSize = static_cast<VkDeviceSize>(width) * height * targetChannels;
-    const VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
-    
-    // Convert input to RGBA if needed
-    std::vector<unsigned char> rgbaData;
-    const unsigned char* pUploadData = pPixels;
-    
-    if (channels != targetChannels) {
-        rgbaData.resize(static_cast<size_t>(imageSize));
-        for (int i = 0; i < width * height; ++i) {
-            const int srcIdx = i * channels;
-            const int dstIdx = i * targetChannels;
-            
-            // Copy existing channels
-            for (int c = 0; c < channels && c < targetChannels; ++c) {
-                rgbaData[dstIdx + c] = pPixels[srcIdx + c];
-            }
-            
-            // Fill missing channels (RGB->RGBA: alpha=255, Grayscale->RGBA: replicate to RGB, alpha=255)
-            if (channels == 1) {
-                // Grayscale -> RGB
-                rgbaData[dstIdx + 1] = pPixels[srcIdx];
-                rgbaData[dstIdx + 2] = pPixels[srcIdx];
-                rgbaData[dstIdx + 3] = 255;
-            } else if (channels == 2) {
-                // Grayscale+Alpha -> RGBA
-                rgbaData[dstIdx + 1] = pPixels[srcIdx];
-                rgbaData[dstIdx + 2] = pPixels[srcIdx];
-                rgbaData[dstIdx + 3] = pPixels[srcIdx + 1];
-            } else if (channels == 3) {
-                // RGB -> RGBA
-                rgbaData[dstIdx + 3] = 255;
-            }
+    std::shared_ptr<TextureHandle> pHandle = UploadTextureLevels(stStream_in.eFormat, lWidth, lHeight, stStream_in.vecLevels, pData, lTailLevel, true);
+    if (pHandle == nullptr)
+        return nullptr;
+    stStream_in.lTailLevel = lTailLevel;
+    stStream_in.lResidentLevel = lTailLevel;
+    stStream_in.lWantedLevel = lTailLevel;
+    stStream_in.uLastUsedFrame = m_uStreamFrame;
+    stStream_in.pHandle = pHandle;
+    pHandle->SetStreamSlot(static_cast<uint32_t>(m_streamed.size()));
+    m_streamed.push_back(std::move(stStream_in));
+    return pHandle;
+}
+
+uint64_t TextureManager::GetResidentBytes(const StreamedTexture& stStream_ic, uint32_t lBaseLevel_ic) {
+    uint64_t uBytes = 0u;
+    for (size_t i = lBaseLevel_ic; i < stStream_ic.vecLevels.size(); ++i)
+        uBytes += stStream_ic.vecLevels[i].zSize;
+    return uBytes;
+}
+
+bool TextureManager::SetResidentLevel(StreamedTexture& stStream_io, uint32_t lBaseLevel_ic) {
+    std::shared_ptr<TextureHandle> pHandle = stStream_io.pHandle.lock();
+    if (pHandle == nullptr)
+        return false;
+    MappedFile stFile;
+    const uint8_t* pData = stStream_io.stData.vecData.data();
+    if (stStream_io.sVTexPath.empty() == false) {
+        VTexView stView;
+        if ((stFile.Open(stStream_io.sVTexPath) == false) ||
+            (ParseVTex(stFile.GetData(), stFile.GetSize(), stStream_io.uSourceHash, stStream_io.uSettingsHash, stView) == false)) {
+            VulkanUtils::LogWarn("TextureManager: cooked texture \"{}\" is no longer readable, keeping its resident levels", stStream_io.sVTexPath);
+            return false;
+        }
+        pData = stFile.GetData();
+    }
+    std::shared_ptr<TextureHandle> pNew = UploadTextureLevels(stStream_io.eFormat, stStream_io.vecLevels[0].lWidth, stStream_io.vecLevels[0].lHeight,
+                                                              stStream_io.vecLevels, pData, lBaseLevel_ic, true);
+    if (pNew == nullptr)
+        return false;
+    /* Frames in flight may still sample the old image: hand it to the release queue, keep the handle's address. */
+    std::unique_ptr<TextureHandle> pOld = std::make_unique<TextureHandle>(std::move(*pHandle));
+    if (m_pReleaseQueue != nullptr)
+        m_pReleaseQueue->Retire(std::move(pOld));
+    *pHandle = std::move(*pNew);
+    stStream_io.lResidentLevel = lBaseLevel_ic;
+    return true;
+}
+
+void TextureManager::RequestResidency(const TextureHandle* pTexture_ic, float fScreenPixels_ic) {
+    if (pTexture_ic == nullptr)
+        return;
+    const uint32_t lSlot = pTexture_ic->GetStreamSlot();
+    if (lSlot >= m_streamed.size())
+        return;
+    StreamedTexture& stStream = m_streamed[lSlot];
+    stStream.fScreenPixels = std::max(stStream.fScreenPixels, fScreenPixels_ic);
+    stStream.uLastUsedFrame = m_uStreamFrame;
+}
+
+bool TextureManager::EvictLeastRecentlyUsed(uint64_t uUsedBefore_ic, uint64_t& uResidentBytes_io,
+                                            std::vector<TextureHandle*>& vecChanged_out) {
+    uint32_t lVictim = TextureHandle::kNotStreamed;
+    for (uint32_t lSlot = 0u; lSlot < static_cast<uint32_t>(m_streamed.size()); ++lSlot) {
+        const StreamedTexture& st = m_streamed[lSlot];
+        if ((st.lResidentLevel >= st.lTailLevel) || (st.uLastUsedFrame >= uUsedBefore_ic))
+            continue;
+        if ((lVictim == TextureHandle::kNotStreamed) || (st.uLastUsedFrame < m_streamed[lVictim].uLastUsedFrame))
+            lVictim = lSlot;
+    }
+    if (lVictim == TextureHandle::kNotStreamed)
+        return false;
+    StreamedTexture& stVictim = m_streamed[lVictim];
+    const uint64_t uBefore = GetResidentBytes(stVictim, stVictim.lResidentLevel);
+    if (SetResidentLevel(stVictim, stVictim.lTailLevel) == false)
+        return false;
+    uResidentBytes_io -= uBefore - GetResidentBytes(stVictim, stVictim.lTailLevel);
+    if (std::shared_ptr<TextureHandle> pVictim = stVictim.pHandle.lock())
+        vecChanged_out.push_back(pVictim.get());
+    ++m_streamStats.lEvictions;
+    return true;
+}
+
+void TextureManager::UpdateStreaming(std::vector<TextureHandle*>& vecChanged_out) {
+    ++m_uStreamFrame;
+    const uint64_t uBudgetBytes = static_cast<uint64_t>(m_streaming.lBudgetMB) * 1024u * 1024u;
+    m_streamStats = TextureStreamingStats{};
+    m_streamStats.uBudgetBytes = uBudgetBytes;
+
+    // Drop textures released by TrimUnused (swap-remove keeps slots dense)
+    for (size_t i = 0; i < m_streamed.size(); ) {
+        if (m_streamed[i].pHandle.expired() == false) {
+            ++i;
+            continue;
+        }
+        if (i + 1u != m_streamed.size()) {
+            m_streamed[i] = std::move(m_streamed.back());
+            if (std::shared_ptr<TextureHandle> pMoved = m_streamed[i].pHandle.lock())
+                pMoved->SetStreamSlot(static_cast<uint32_t>(i));
         }
-        pUploadData = rgbaData.data();
+        m_streamed.pop_back();
+    }
+    if (m_streamed.empty() == true)
+        return;
+
+    // Feedback from the last frame: one level per halving of the projected size (texels ~ pixels at the wanted level)
+    uint64_t uResidentBytes = 0u;
+    ScratchScope scratch;
+    ArenaVector<uint32_t> vecUpgrades(scratch.GetAllocator<uint32_t>());
+    vecUpgrades.reserve(m_streamed.size());
+    for (uint32_t lSlot = 0u; lSlot < static_cast<uint32_t>(m_streamed.size()); ++lSlot) {
+        StreamedTexture& st = m_streamed[lSlot];
+        if (st.fScreenPixels > 0.f) {
+            const float fLevel0 = static_cast<float>(std::max(st.vecLevels[0].lWidth, st.vecLevels[0].lHeight));
+            const float fLevels = std::floor(std::log2(fLevel0 / std::max(st.fScreenPixels, 1.f)));
+            st.lWantedLevel = std::min(static_cast<uint32_t>(std::max(fLevels, 0.f)), st.lTailLevel);
+            st.fScreenPixels = 0.f;
+        }
+        uResidentBytes += GetResidentBytes(st, st.lResidentLevel);
+        m_streamStats.uWantedBytes += GetResidentBytes(st, st.lWantedLevel);
+        if (st.lWantedLevel < st.lResidentLevel)
+            vecUpgrades.push_back(lSlot);
+    }
+    // Largest missing detail first, most recently used breaking ties
+    std::sort(vecUpgrades.begin(), vecUpgrades.end(), [this](uint32_t lA, uint32_t lB) {
+        const StreamedTexture& stA = this->m_streamed[lA];
+        const StreamedTexture& stB = this->m_streamed[lB];
+        const uint32_t lGapA = stA.lResidentLevel - stA.lWantedLevel;
+        const uint32_t lGapB = stB.lResidentLevel - stB.lWantedLevel;
+        if (lGapA != lGapB)
+            return lGapA > lGapB;
+        return stA.uLastUsedFrame > stB.uLastUsedFrame;
+    });
+
+    uint32_t lChanges = 0u;
+    // Budget lowered or textures added: shed what was not used last frame
+    while ((uResidentBytes > uBudgetBytes) && (lChanges < m_streaming.lMaxUploadsPerFrame) &&
+           (EvictLeastRecentlyUsed(m_uStreamFrame - 1u, uResidentBytes, vecChanged_out) == true))
+        ++lChanges;
+
+    for (uint32_t lSlot : vecUpgrades) {
+        if (lChanges >= m_streaming.lMaxUploadsPerFrame)
+            break;
+        StreamedTexture& st = m_streamed[lSlot];
+        const uint64_t uCurrent = GetResidentBytes(st, st.lResidentLevel);
+        while ((uResidentBytes - uCurrent + GetResidentBytes(st, st.lWantedLevel) > uBudgetBytes) &&
+               (lChanges < m_streaming.lMaxUploadsPerFrame) &&
+               (EvictLeastRecentlyUsed(st.uLastUsedFrame, uResidentBytes, vecChanged_out) == true))
+            ++lChanges;
+        if (lChanges >= m_streaming.lMaxUploadsPerFrame)
+            break;
+        // Finest level that fits what is left of the budget
+        uint32_t lLevel = st.lWantedLevel;
+        while ((lLevel < st.lResidentLevel) && (uResidentBytes - uCurrent + GetResidentBytes(st, lLevel) > uBudgetBytes))
+            ++lLevel;
+        if (lLevel >= st.lResidentLevel)
+            continue;
+        if (SetResidentLevel(st, lLevel) == false)
+            continue;
+        uResidentBytes += GetResidentBytes(st, lLevel) - uCurrent;
+        if (std::shared_ptr<TextureHandle> pHandle = st.pHandle.lock())
+            vecChanged_out.push_back(pHandle.get());
+        ++m_streamStats.lUpgrades;
+        ++lChanges;
     }
 
+    m_streamStats.lStreamed = static_cast<uint32_t>(m_streamed.size());
+    m_streamStats.uResidentBytes = uResidentBytes;
+    for (const StreamedTexture& st : m_streamed) {
+        if (st.lResidentLevel == 0u)
+            ++m_streamStats.lFullyResident;
+    }
+}
+
+std::shared_ptr<TextureHandle> TextureManager::UploadTextureLevels(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                                                                   const std::vector<MipLevelDesc>& vecLevels_ic, const uint8_t* pData_ic,
+                                                                   uint32_t lBaseLevel_ic, bool bStreamed_ic) {
+    if (m_device == VK_NULL_HANDLE || m_physicalDevice == VK_NULL_HANDLE || m_queue == VK_NULL_HANDLE ||
+        lBaseLevel_ic >= vecLevels_ic.size() || pData_ic == nullptr)
+        return nullptr;
+
+    const uint32_t lWidth = (lBaseLevel_ic == 0u) ? lWidth_ic : vecLevels_ic[lBaseLevel_ic].lWidth;
+    const uint32_t lHeight = (lBaseLevel_ic == 0u) ? lHeight_ic : vecLevels_ic[lBaseLevel_ic].lHeight;
+    // Levels [base, end) are contiguous in pData_ic: stage them as one range and rebase the copy offsets
+    std::vector<MipLevelDesc> vecLevels(vecLevels_ic.begin() + lBaseLevel_ic, vecLevels_ic.end());
+    const size_t zBaseOffset = vecLevels.front().zOffset;
+    for (MipLevelDesc& st : vecLevels)
+        st.zOffset -= zBaseOffset;
+    const unsigned char* pUploadData = pData_ic + zBaseOffset;
+    const size_t zUploadSize = vecLevels.back().zOffset + vecLevels.back().zSize;
+    return UploadStagedLevels(eFormat_ic, lWidth, lHeight, vecLevels, [pUploadData, zUploadSize](uint8_t* pStaging_out) {
+        std::memcpy(pStaging_out, pUploadData, zUploadSize);
+    }, bStreamed_ic == false);
+}
+
+std::shared_ptr<TextureHandle> TextureManager::UploadStagedLevels(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                                                                  const std::vector<MipLevelDesc>& vecLevels_ic,
+                                                                  const std::function<void(uint8_t*)>& fnFillStaging_ic,
+                                                                  bool bAllowArrayLayer_ic) {
+    if (vecLevels_ic.empty() == true)
+        return nullptr;
+    const VkFormat format = eFormat_ic;
+    // A single uncompressed level is expanded on the GPU; pre-built chains are uploaded as-is
+    const bool bGpuMips = (vecLevels_ic.size() == 1u) && (m_sampling.bGenerateMips == true) &&
+                          (IsBlockCompressedFormat(format) == false) && (ComputeMipLevelCount(lWidth_ic, lHeight_ic) > 1u) &&
+                          (SupportsLinearBlit(format) == true);
+    const uint32_t lMipLevels = (bGpuMips == true) ? ComputeMipLevelCount(lWidth_ic, lHeight_ic) : static_cast<uint32_t>(vecLevels_ic.size());
+    const VkDeviceSize uploadSize = static_cast<VkDeviceSize>(vecLevels_ic.back().zOffset + vecLevels_ic.back().zSize);
+
     VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    MemoryAllocation stagingMemory;
     {
-        if (VulkanUtils::CreateBuffer(m_device, m_physicalDevice, imageSize,
+        if (VulkanUtils::CreateBuffer(m_device, m_physicalDevice, uploadSize,
                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging,
                 &stagingBuffer, &stagingMemory) != VK_SUCCESS)
             return nullptr;
-        void* pMapped = nullptr;
-        vkMapMemory(m_device, stagingMemory, 0, imageSize, 0, &pMapped);
-        if (pMapped) {
-            std::memcpy(pMapped, pUploadData, static_cast<size_t>(imageSize));
-            vkUnmapMemory(m_device, stagingMemory);
-        }
+        if (stagingMemory.pMapped)
+            fnFillStaging_ic(static_cast<uint8_t*>(stagingMemory.pMapped));
     }
 
-    VkImage image = VK_NULL_HANDLE;
-    VkDeviceMemory imageMemory = VK_NULL_HANDLE;
-    {
+    // Small textures take a layer of a shared array page instead of their own image + allocation
+    std::shared_ptr<TextureArrayPage> pPage;
+    uint32_t lLayer = 0u;
+    if ((bAllowArrayLayer_ic == true) && (m_arrayPool.IsEligible(lWidth_ic, lHeight_ic) == true)) {
+        const VkDeviceSize uLayerBytes = (bGpuMips == true) ? (uploadSize + uploadSize / 3u) : uploadSize;
+        pPage = m_arrayPool.AcquireLayer(format, lWidth_ic, lHeight_ic, lMipLevels, uLayerBytes, lLayer);
+    }
+
+    VkImage image = (pPage != nullptr) ? pPage->GetImage() : VK_NULL_HANDLE;
+    MemoryAllocation imageMemory;
+    // Failure paths after the image exists: give the layer back, or destroy the texture's own image
+    auto releaseImage = [&]() {
+        if (pPage != nullptr) {
+            pPage->ReleaseLayer(lLayer);
+            return;
+        }
+        vkDestroyImage(m_device, image, nullptr);
+        VulkanMemory::Free(m_device, imageMemory);
+    };
+    if (pPage == nullptr) {
         VkImageCreateInfo imageInfo = {
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .pNext = nullptr,
             .flags = static_cast<VkImageCreateFlags>(0),
             .imageType = VK_IMAGE_TYPE_2D,
             .format = format,
-            .extent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 },
-            .mipLevels = 1,
+            .extent = { lWidth_ic, lHeight_ic, 1 },
+            .mipLevels = lMipLevels,
             .arrayLayers = 1,
             .samples = VK_SAMPLE_COUNT_1_BIT,
             .tiling = VK_IMAGE_TILING_OPTIMAL,
-            .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            .usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                     ((bGpuMips == true) ? static_cast<VkImageUsageFlags>(VK_IMAGE_USAGE_TRANSFER_SRC_BIT) : static_cast<VkImageUsageFlags>(0)),
             .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
             .queueFamilyIndexCount = 0,
             .pQueueFamilyIndices = nullptr,
             .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
         };
         if (vkCreateImage(m_device, &imageInfo, nullptr, &image) != VK_SUCCESS) {
-            vkFreeMemory(m_device, stagingMemory, nullptr);
+            VulkanMemory::Free(m_device, stagingMemory);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
             return nullptr;
         }
-        VkMemoryRequirements memReqs;
-        vkGetImageMemoryRequirements(m_device, image, &memReqs);
-        VkMemoryAllocateInfo allocInfo = {
-            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-            .pNext = nullptr,
-            .allocationSize = memReqs.size,
-            .memoryTypeIndex = VulkanUtils::FindMemoryType(m_physicalDevice, memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
-        };
-        if (vkAllocateMemory(m_device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
+        if (VulkanMemory::AllocateForImage(m_device, m_physicalDevice, image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                           MemoryCategory::Texture, false, imageMemory) != VK_SUCCESS) {
             vkDestroyImage(m_device, image, nullptr);
-            vkFreeMemory(m_device, stagingMemory, nullptr);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
+            VulkanMemory::Free(m_device, stagingMemory);
             return nullptr;
         }
-        vkBindImageMemory(m_device, image, imageMemory, 0);
     }
 
     VkCommandPool cmdPool = VK_NULL_HANDLE;
@@ -361,38 +981,44 @@ std::shared_ptr<TextureHandle> TextureManager::UploadTexture(int width, int heig
             .queueFamilyIndex = m_queueFamilyIndex,
         };
         if (vkCreateCommandPool(m_device, &poolInfo, nullptr, &cmdPool) != VK_SUCCESS) {
-            vkFreeMemory(m_device, imageMemory, nullptr);
-            vkDestroyImage(m_device, image, nullptr);
-            vkFreeMemory(m_device, stagingMemory, nullptr);
+            releaseImage();
+            VulkanMemory::Free(m_device, stagingMemory);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
             return nullptr;
         }
         VkCommandBuffer cmd = VulkanUtils::BeginSingleTimeCommands(m_device, cmdPool);
         if (cmd == VK_NULL_HANDLE) {
             vkDestroyCommandPool(m_device, cmdPool, nullptr);
-            vkFreeMemory(m_device, imageMemory, nullptr);
-            vkDestroyImage(m_device, image, nullptr);
-            vkFreeMemory(m_device, stagingMemory, nullptr);
+            releaseImage();
+            VulkanMemory::Free(m_device, stagingMemory);
             vkDestroyBuffer(m_device, stagingBuffer, nullptr);
             return nullptr;
         }
-        TransitionImageLayout(cmd, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-        VkBufferImageCopy region = {
-            .bufferOffset = 0,
-            .bufferRowLength = 0,
-            .bufferImageHeight = 0,
-            .imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
-            .imageOffset = { 0, 0, 0 },
-            .imageExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 },
-        };
-        vkCmdCopyBufferToImage(cmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-        TransitionImageLayout(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        TransitionImageLayout(cmd, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, lMipLevels, lLayer);
+        std::vector<VkBufferImageCopy> vecRegions;
+        vecRegions.reserve(vecLevels_ic.size());
+        for (size_t i = 0; i < vecLevels_ic.size(); ++i) {
+            vecRegions.push_back({
+                .bufferOffset = static_cast<VkDeviceSize>(vecLevels_ic[i].zOffset),
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, static_cast<uint32_t>(i), lLayer, 1 },
+                .imageOffset = { 0, 0, 0 },
+                .imageExtent = { vecLevels_ic[i].lWidth, vecLevels_ic[i].lHeight, 1 },
+            });
+        }
+        vkCmdCopyBufferToImage(cmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(vecRegions.size()), vecRegions.data());
+        if (bGpuMips == true)
+            RecordMipBlits(cmd, image, lWidth_ic, lHeight_ic, lMipLevels, lLayer);
+        else
+            TransitionImageLayout(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, lMipLevels, lLayer);
         VulkanUtils::EndSingleTimeCommands(m_device, m_queue, cmdPool, cmd);
         vkDestroyCommandPool(m_device, cmdPool, nullptr);
     }
 
     vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-    vkFreeMemory(m_device, stagingMemory, nullptr);
+    VulkanMemory::Free(m_device, stagingMemory);
 
     VkImageView view = VK_NULL_HANDLE;
     {
@@ -404,61 +1030,121 @@ std::shared_ptr<TextureHandle> TextureManager::UploadTexture(int width, int heig
             .viewType = VK_IMAGE_VIEW_TYPE_2D,
             .format = format,
             .components = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY },
-            .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 },
+            .subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, lMipLevels, lLayer, 1 },
         };
         if (vkCreateImageView(m_device, &viewInfo, nullptr, &view) != VK_SUCCESS) {
-            vkFreeMemory(m_device, imageMemory, nullptr);
-            vkDestroyImage(m_device, image, nullptr);
+            releaseImage();
             return nullptr;
         }
     }
 
-    VkSampler sampler = VK_NULL_HANDLE;
-    {
-        VkSamplerCreateInfo samplerInfo = {
-            .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = static_cast<VkSamplerCreateFlags>(0),
-            .magFilter = VK_FILTER_LINEAR,
-            .minFilter = VK_FILTER_LINEAR,
-            .mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR,
-            .addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
-            .addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
-            .addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
-            .mipLodBias = 0.f,
-            .anisotropyEnable = VK_FALSE,
-            .maxAnisotropy = 1.f,
-            .compareEnable = VK_FALSE,
-            .compareOp = VK_COMPARE_OP_NEVER,
-            .minLod = 0.f,
-            .maxLod = 0.f,
-            .borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
-            .unnormalizedCoordinates = VK_FALSE,
-        };
-        if (vkCreateSampler(m_device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
-            vkDestroyImageView(m_device, view, nullptr);
-            vkFreeMemory(m_device, imageMemory, nullptr);
-            vkDestroyImage(m_device, image, nullptr);
-            return nullptr;
-        }
+    VkSampler sampler = GetOrCreateSampler();
+    if (sampler == VK_NULL_HANDLE) {
+        vkDestroyImageView(m_device, view, nullptr);
+        releaseImage();
+        return nullptr;
     }
 
     auto handle = std::make_shared<TextureHandle>();
-    handle->Set(m_device, image, view, sampler, imageMemory);
+    if (pPage != nullptr)
+        handle->SetArrayLayer(m_device, view, sampler, std::move(pPage), lLayer);
+    else
+        handle->Set(m_device, image, view, sampler, imageMemory);
     return handle;
 }
 
+bool TextureManager::SupportsSampledFormat(VkFormat eFormat_ic) const {
+    if (m_physicalDevice == VK_NULL_HANDLE || eFormat_ic == VK_FORMAT_UNDEFINED)
+        return false;
+    VkFormatProperties stProps = {};
+    vkGetPhysicalDeviceFormatProperties(m_physicalDevice, eFormat_ic, &stProps);
+    const VkFormatFeatureFlags uRequired = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (stProps.optimalTilingFeatures & uRequired) == uRequired;
+}
+
+bool TextureManager::SupportsLinearBlit(VkFormat eFormat_ic) const {
+    if (m_physicalDevice == VK_NULL_HANDLE)
+        return false;
+    VkFormatProperties stProps = {};
+    vkGetPhysicalDeviceFormatProperties(m_physicalDevice, eFormat_ic, &stProps);
+    const VkFormatFeatureFlags uRequired = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                           VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+    return (stProps.optimalTilingFeatures & uRequired) == uRequired;
+}
+
+bool TextureManager::UsesGpuMips(VkFormat eFormat_ic) const {
+    return (m_sampling.bCpuMips == false) && (m_streaming.bEnabled == false) && (SupportsLinearBlit(eFormat_ic) == true);
+}
+
+VkSampler TextureManager::GetOrCreateSampler() {
+    const bool bAnisotropy = (m_bSamplerAnisotropy == true) && (m_sampling.fMaxAnisotropy > 1.0f);
+    const float fAnisotropy = bAnisotropy ? std::min(m_sampling.fMaxAnisotropy, m_fMaxDeviceAnisotropy) : 1.f;
+    const float fLodBias = std::clamp(m_sampling.fMipLodBias, -m_fMaxDeviceLodBias, m_fMaxDeviceLodBias);
+    /* No clamp to the level count: the image view bounds the sampled levels, so one sampler fits every texture. */
+    const float fMaxLod = std::max(m_sampling.fMaxLod, 0.f);
+    const std::tuple<float, float, float> key(fAnisotropy, fLodBias, fMaxLod);
+
+    std::lock_guard<std::mutex> lock(m_samplerMutex);
+    auto it = m_samplers.find(key);
+    if (it != m_samplers.end())
+        return it->second;
+    VkSamplerCreateInfo samplerInfo = {
+        .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = static_cast<VkSamplerCreateFlags>(0),
+        .magFilter = VK_FILTER_LINEAR,
+        .minFilter = VK_FILTER_LINEAR,
+        .mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR,
+        .addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+        .mipLodBias = fLodBias,
+        .anisotropyEnable = bAnisotropy ? VK_TRUE : VK_FALSE,
+        .maxAnisotropy = fAnisotropy,
+        .compareEnable = VK_FALSE,
+        .compareOp = VK_COMPARE_OP_NEVER,
+        .minLod = 0.f,
+        .maxLod = fMaxLod,
+        .borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK,
+        .unnormalizedCoordinates = VK_FALSE,
+    };
+    VkSampler sampler = VK_NULL_HANDLE;
+    if (vkCreateSampler(m_device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+    m_samplers.emplace(key, sampler);
+    VulkanUtils::LogDebug("TextureManager: sampler #{} (anisotropy {}, LOD bias {}, max LOD {})", m_samplers.size(), fAnisotropy, fLodBias, fMaxLod);
+    return sampler;
+}
+
 void TextureManager::TrimUnused() {
     for (auto it = m_cache.begin(); it != m_cache.end(); ) {
-        if (it->second.use_count() == 1)
+        if (it->second.use_count() == 1) {
+            /* Frames in flight may still sample it: the image (or array layer) is freed once their fences have signalled. */
+            if (m_pReleaseQueue != nullptr)
+                m_pReleaseQueue->Retire(std::move(it->second));
             it = m_cache.erase(it);
-        else
+        } else {
             ++it;
+        }
     }
+    m_arrayPool.TrimEmpty();
 }
 
 void TextureManager::Destroy() {
     m_pendingPaths.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_decodedMutex);
+        m_decoded.clear();
+    }
+    m_streamed.clear();
     m_cache.clear();
+    m_arrayPool.Destroy();
+    /* Handles still referenced elsewhere only borrow samplers; none may be used for drawing after Destroy. */
+    {
+        std::lock_guard<std::mutex> lock(m_samplerMutex);
+        for (const auto& entry : m_samplers)
+            vkDestroySampler(m_device, entry.second, nullptr);
+        m_samplers.clear();
+    }
     m_pJobQueue = nullptr;
 }
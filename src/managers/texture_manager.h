@@ -1,17 +1,94 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <shared_mutex>
 #include <vulkan/vulkan.h>
+#include "texture_array_pool.h"
+#include "texture_container.h"
 
+class DeferredReleaseQueue;
 class JobQueue;
 
 /**
- * Texture handle: owns VkImage, VkImageView, VkSampler, VkDeviceMemory. Destructor frees GPU resources.
+ * What a texture feeds in the material; picks the GPU format (see TextureManager::SelectFormat).
+ * Colour roles are sRGB, data roles (normal, metallic-roughness, occlusion) are UNORM.
+ */
+enum class TextureRole : uint8_t {
+    BaseColor,
+    Normal,
+    MetallicRoughness,
+    Occlusion,
+    Emissive,
+};
+
+/**
+ * Mip generation + sampler settings for textures created after SetSamplingSettings (see VulkanConfig assets section).
+ * GPU mips use vkCmdBlitImage in the upload command buffer; formats without blit + linear-filter support fall back
+ * to the CPU box filter (mip_generator.h) on JobQueue workers.
+ */
+struct TextureSamplingSettings {
+    bool  bGenerateMips  = true;
+    bool  bCpuMips       = false;  // Force the CPU path even when the format can be blitted
+    float fMaxAnisotropy = 8.0f;   // <= 1 disables; clamped to maxSamplerAnisotropy, off if samplerAnisotropy unsupported
+    float fMipLodBias    = 0.0f;
+    float fMaxLod        = VK_LOD_CLAMP_NONE;  // Levels past the image view's range are never sampled
+};
+
+/**
+ * Output of TextureManager::CookEncodedTexture (worker side of the persistent texture cache).
+ * Either a valid .vtex already exists for (uSourceHash, role) and the upload maps it, or stData holds the cooked levels.
+ */
+struct CookedTextureResult {
+    uint64_t uSourceHash = 0u;    // HashBytesFnv1a of the encoded image bytes
+    bool     bFromCache  = false;
+    GpuTextureData stData;        // Filled when bFromCache == false
+    double   fCookMs     = 0.0;   // Decode + mips + BC encode + file write
+};
+
+/** Persistent texture cache counters since the last ResetCookStats (main thread). */
+struct TextureCookStats {
+    uint32_t lFromCache = 0u;     // Mapped from .vtex (warm)
+    uint32_t lCooked    = 0u;     // Decoded and cooked from the source image (cold)
+    double   fCookMs    = 0.0;    // Summed over workers
+};
+
+/**
+ * Residency streaming (see VulkanConfig texture_streaming). Streamed textures start with only their mip tail
+ * (levels <= lTailSize) resident; the renderer reports projected screen size each frame (RequestResidency) and
+ * UpdateStreaming uploads finer levels within lMaxUploadsPerFrame, evicting least-recently-used textures back to
+ * their tail when the budget would be exceeded. Streaming keeps the full CPU chain, so GPU mip blits are disabled.
+ */
+struct TextureStreamingSettings {
+    bool     bEnabled            = false;
+    uint32_t lBudgetMB           = 512u;  // Resident bytes of streamed textures (non-streamed textures are not counted)
+    uint32_t lTailSize           = 64u;   // Largest level (max of width/height) kept resident at all times
+    uint32_t lMaxUploadsPerFrame = 2u;    // Residency changes (upgrades + evictions) per UpdateStreaming
+};
+
+/** Streaming counters from the last UpdateStreaming (main thread). */
+struct TextureStreamingStats {
+    uint32_t lStreamed      = 0u;  // Live streamed textures
+    uint32_t lFullyResident = 0u;  // Streamed textures with level 0 resident
+    uint32_t lUpgrades      = 0u;  // This frame
+    uint32_t lEvictions     = 0u;  // This frame
+    uint64_t uResidentBytes = 0u;
+    uint64_t uWantedBytes   = 0u;  // Bytes if every texture had its requested level resident
+    uint64_t uBudgetBytes   = 0u;
+};
+
+/**
+ * Texture handle: owns VkImage, VkImageView, VkDeviceMemory. Destructor frees GPU resources.
+ * Small textures own only their view onto one layer of a shared TextureArrayPage, released on destruction.
+ * The sampler is borrowed from TextureManager's sampler cache (shared by every texture with the same sampler state).
+ * Streamed handles keep their address when the resident mip range changes; only the Vulkan objects are replaced.
  */
 class TextureHandle {
 public:
@@ -23,11 +100,22 @@ public:
     TextureHandle(TextureHandle&& other) noexcept;
     TextureHandle& operator=(TextureHandle&& other) noexcept;
 
-    void Set(VkDevice device, VkImage image, VkImageView view, VkSampler sampler, VkDeviceMemory memory);
+    void Set(VkDevice device, VkImage image, VkImageView view, VkSampler sampler, const MemoryAllocation& memory);
+    /** View onto layer lLayer_ic of pPage_in (the page owns image and memory). */
+    void SetArrayLayer(VkDevice device, VkImageView view, VkSampler sampler, std::shared_ptr<TextureArrayPage> pPage_in, uint32_t lLayer_ic);
 
     VkImageView GetView() const { return m_view; }
     VkSampler GetSampler() const { return m_sampler; }
     bool IsValid() const { return m_view != VK_NULL_HANDLE && m_sampler != VK_NULL_HANDLE; }
+    /** Index into TextureManager's streamed textures (kNotStreamed for fully resident textures). */
+    static constexpr uint32_t kNotStreamed = UINT32_MAX;
+    uint32_t GetStreamSlot() const { return m_lStreamSlot; }
+    void SetStreamSlot(uint32_t lSlot_ic) { m_lStreamSlot = lSlot_ic; }
+    /** Slot in the bindless texture array (BindlessTextureTable); kNoBindlessIndex until registered. */
+    static constexpr uint32_t kNoBindlessIndex = UINT32_MAX;
+    uint32_t GetBindlessIndex() const { return m_lBindlessIndex; }
+    void SetBindlessIndex(uint32_t lIndex_ic) { m_lBindlessIndex = lIndex_ic; }
+    bool IsArrayLayer() const { return m_pArrayPage != nullptr; }
 
 private:
     void Destroy();
@@ -35,24 +123,83 @@ private:
     VkDevice       m_device = VK_NULL_HANDLE;
     VkImage        m_image  = VK_NULL_HANDLE;
     VkImageView    m_view   = VK_NULL_HANDLE;
-    VkSampler      m_sampler = VK_NULL_HANDLE;
-    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+    VkSampler      m_sampler = VK_NULL_HANDLE;  // Not owned
+    MemoryAllocation m_memory;
+    std::shared_ptr<TextureArrayPage> m_pArrayPage;  // Set instead of m_image / m_memory for pooled textures
+    uint32_t       m_lArrayLayer = 0u;
+    uint32_t       m_lStreamSlot = kNotStreamed;  // Not moved with the Vulkan objects
+    uint32_t       m_lBindlessIndex = kNoBindlessIndex;  // Not moved with the Vulkan objects
 };
 
 /**
  * Get-or-load textures by path. Async load via RequestLoadTexture + OnCompletedTexture (from job queue).
  * SetDevice/SetPhysicalDevice/SetQueue/SetQueueFamilyIndex before use. SetJobQueue before RequestLoadTexture.
- * Destroy() clears cache (call before device destroy).
+ * Destroy() clears cache and destroys the shared samplers (call before device destroy).
  */
 class TextureManager {
 public:
     TextureManager() = default;
 
     void SetJobQueue(JobQueue* pJobQueue);
+    /**
+     * Trimmed textures and images replaced by streaming are handed to this queue (destroyed once frames in flight
+     * are done). nullptr = destroy at once (device must be idle).
+     */
+    void SetReleaseQueue(DeferredReleaseQueue* pReleaseQueue) { this->m_pReleaseQueue = pReleaseQueue; }
     void SetDevice(VkDevice device);
     void SetPhysicalDevice(VkPhysicalDevice physicalDevice);
     void SetQueue(VkQueue queue);
     void SetQueueFamilyIndex(uint32_t queueFamilyIndex);
+    void SetSamplingSettings(const TextureSamplingSettings& stSettings_ic) { this->m_sampling = stSettings_ic; }
+    const TextureSamplingSettings& GetSamplingSettings() const { return this->m_sampling; }
+    /** BC1/BC4/BC5/BC7 cooking for new textures (only when the device supports textureCompressionBC). */
+    void SetCompressionEnabled(bool bEnabled_ic) { this->m_bCompression = bEnabled_ic; }
+    bool IsCompressionEnabled() const { return this->m_bCompression; }
+    /** Directory for cooked .vtex files (see vtex_format.h). Empty disables the persistent texture cache. */
+    void SetCookedTextureDir(const std::string& sDir_ic) { this->m_sCookedTextureDir = sDir_ic; }
+    bool IsTextureCookingEnabled() const { return this->m_sCookedTextureDir.empty() == false; }
+    const TextureCookStats& GetCookStats() const { return this->m_cookStats; }
+    void ResetCookStats() { this->m_cookStats = TextureCookStats{}; }
+    /** Applies to textures created afterwards (streaming also changes the cook settings: CPU mips). */
+    void SetStreamingSettings(const TextureStreamingSettings& stSettings_ic) { this->m_streaming = stSettings_ic; }
+    const TextureStreamingSettings& GetStreamingSettings() const { return this->m_streaming; }
+    const TextureStreamingStats& GetStreamingStats() const { return this->m_streamStats; }
+    /** Non-streamed textures with max(width, height) <= lMaxSize_ic share 2D-array pages (0 = own image each). */
+    void SetTextureArrayMaxSize(uint32_t lMaxSize_ic) { this->m_arrayPool.SetMaxSize(lMaxSize_ic); }
+    TextureArrayPoolStats GetTextureArrayStats() const { return this->m_arrayPool.GetStats(); }
+
+    /**
+     * Renderer feedback: pTexture_ic covers about fScreenPixels_ic pixels (largest projected extent) this frame.
+     * No-op for non-streamed textures. Main thread, between UpdateStreaming calls.
+     */
+    void RequestResidency(const TextureHandle* pTexture_ic, float fScreenPixels_ic);
+    /**
+     * Once per frame: upgrade/evict streamed textures (replaced images go to the release queue).
+     * Handles whose image was replaced are appended to vecChanged_out (descriptor sets referencing them are stale).
+     */
+    void UpdateStreaming(std::vector<TextureHandle*>& vecChanged_out);
+
+    /**
+     * Upload format for a role: BaseColor/Emissive -> BC7_SRGB, Normal -> BC5, MetallicRoughness -> BC1, Occlusion -> BC4
+     * when compression is enabled and the format is sampleable; otherwise R8G8B8A8_SRGB (colour) / R8G8B8A8_UNORM (data).
+     */
+    VkFormat SelectFormat(TextureRole eRole_ic) const;
+    /**
+     * CPU side of an upload: expand to RGBA8, build the mip chain and BC-encode every level for SelectFormat(eRole_ic).
+     * RGBA8 targets that can be blitted keep level 0 only (mips are generated on the GPU at upload).
+     * Safe to call from JobQueue workers (pass pJobQueue_ic = nullptr there); does not touch the cache.
+     */
+    bool CookTexture(TextureRole eRole_ic, int width, int height, int channels, const unsigned char* pPixels,
+                     GpuTextureData& stData_out, JobQueue* pJobQueue_ic = nullptr) const;
+    /** Everything that changes CookTexture output for a role (format, mip mode); part of the .vtex cache key. */
+    uint64_t GetCookSettingsHash(TextureRole eRole_ic) const;
+    /**
+     * Hash an encoded image (PNG/JPEG/...). If a valid .vtex exists for it only the hash is returned; otherwise
+     * decode (stb_image), CookTexture and write the .vtex (when the cache is enabled). Safe on JobQueue workers
+     * (pass pJobQueue_ic = nullptr there). False if the image cannot be decoded.
+     */
+    bool CookEncodedTexture(TextureRole eRole_ic, const uint8_t* pBytes_ic, size_t zSize_ic,
+                            CookedTextureResult& stResult_out, JobQueue* pJobQueue_ic = nullptr) const;
 
     /** Return cached texture or nullptr if not loaded yet. */
     std::shared_ptr<TextureHandle> GetTexture(const std::string& path) const;
@@ -67,22 +214,125 @@ public:
     /** Create and cache a 1x1 white texture for default occlusion (no occlusion). */
     std::shared_ptr<TextureHandle> GetOrCreateDefaultOcclusionTexture();
     /** Create and cache texture from memory (e.g. glTF embedded image). Cache key = cacheKey param. */
-    std::shared_ptr<TextureHandle> GetOrCreateFromMemory(const std::string& cacheKey, int width, int height, int channels, const unsigned char* pPixels);
+    std::shared_ptr<TextureHandle> GetOrCreateFromMemory(const std::string& cacheKey, int width, int height, int channels, const unsigned char* pPixels,
+                                                         TextureRole eRole = TextureRole::BaseColor);
+    /** Create and cache texture from cooked / container data (all levels already in stData_ic.eFormat). */
+    std::shared_ptr<TextureHandle> GetOrCreateFromCompressed(const std::string& cacheKey, const GpuTextureData& stData_ic);
+    /** Create and cache texture from its .vtex (memory-mapped; levels are copied straight from the mapping into staging). */
+    std::shared_ptr<TextureHandle> GetOrCreateFromCooked(const std::string& cacheKey, uint64_t uSourceHash_ic, TextureRole eRole_ic);
+    /** Create and cache texture from a CookEncodedTexture result (cooked file or cooked levels); updates GetCookStats. */
+    std::shared_ptr<TextureHandle> GetOrCreateFromCookResult(const std::string& cacheKey, TextureRole eRole_ic,
+                                                             const CookedTextureResult& stResult_ic);
+    /** CookEncodedTexture on the calling thread (mips/BC split over the JobQueue) + GetOrCreateFromCookResult. */
+    std::shared_ptr<TextureHandle> GetOrCreateFromEncoded(const std::string& cacheKey, const uint8_t* pBytes_ic, size_t zSize_ic,
+                                                          TextureRole eRole_ic = TextureRole::BaseColor);
+    /** Async load by path: a JobQueue worker reads, decodes and cooks the file (DecodeLoadedTexture). */
     void RequestLoadTexture(const std::string& path);
+    /** Main thread (ProcessCompletedJobs): upload what the worker prepared for sPath_ic. vecData_in is unused. */
     void OnCompletedTexture(const std::string& sPath_ic, std::vector<uint8_t> vecData_in);
 
+    /** Remove cache entries only the cache references (handed to the release queue). Main thread. */
     void TrimUnused();
     void Destroy();
 
 private:
-    std::shared_ptr<TextureHandle> UploadTexture(int width, int height, int channels, const unsigned char* pPixels);
+    std::shared_ptr<TextureHandle> UploadTexture(int width, int height, int channels, const unsigned char* pPixels,
+                                                 TextureRole eRole = TextureRole::BaseColor);
+    /** Upload every level of stData_ic; a single RGBA8 level gets its mips blitted on the GPU when enabled. */
+    std::shared_ptr<TextureHandle> UploadTextureData(const GpuTextureData& stData_ic);
+    /** Same; the chain is moved into the streaming source instead of copied when streaming is enabled. */
+    std::shared_ptr<TextureHandle> UploadTextureData(GpuTextureData&& stData_in);
+    /**
+     * UploadTextureData on borrowed memory (levels' zOffset index pData_ic, e.g. a mapped .vtex).
+     * lBaseLevel_ic > 0 uploads only levels [lBaseLevel_ic, end): the image is the size of that level (streaming).
+     * bStreamed_ic: the image belongs to a streamed texture and is never packed into an array page (evictions must
+     * free its memory).
+     */
+    std::shared_ptr<TextureHandle> UploadTextureLevels(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                                                       const std::vector<MipLevelDesc>& vecLevels_ic, const uint8_t* pData_ic,
+                                                       uint32_t lBaseLevel_ic = 0u, bool bStreamed_ic = false);
+    /**
+     * Create the image and record the upload of vecLevels_ic (zOffset relative to the staging buffer).
+     * fnFillStaging_ic writes every level into the mapped staging memory (copy from a chain, or convert in place).
+     * Small textures go to a layer of a TextureArrayPool page unless bAllowArrayLayer_ic is false.
+     */
+    std::shared_ptr<TextureHandle> UploadStagedLevels(VkFormat eFormat_ic, uint32_t lWidth_ic, uint32_t lHeight_ic,
+                                                      const std::vector<MipLevelDesc>& vecLevels_ic,
+                                                      const std::function<void(uint8_t*)>& fnFillStaging_ic,
+                                                      bool bAllowArrayLayer_ic = true);
+    /** Upload stData_in (chain moved into the streaming source when streaming) and cache it under cacheKey. */
+    std::shared_ptr<TextureHandle> CacheUploadedData(const std::string& cacheKey, GpuTextureData&& stData_in);
+    /**
+     * Worker side of RequestLoadTexture (JobQueue process callback): parse a DDS/KTX2 container (BC decoded to RGBA8
+     * when the device cannot sample it) or CookEncodedTexture the image as BaseColor. Consumes vecData_io.
+     */
+    void DecodeLoadedTexture(const std::string& sPath_ic, std::vector<uint8_t>& vecData_io);
+    /** Format supports vkCmdBlitImage src/dst with linear filtering in optimal tiling (GPU mip generation). */
+    bool SupportsLinearBlit(VkFormat eFormat_ic) const;
+    /** Format can be sampled with linear filtering in optimal tiling. */
+    bool SupportsSampledFormat(VkFormat eFormat_ic) const;
+    /** Shared sampler for the current TextureSamplingSettings (created on first use, destroyed in Destroy). */
+    VkSampler GetOrCreateSampler();
+    /** GPU blit mips for an RGBA8 format (off with bCpuMips, streaming, or without linear blit support). */
+    bool UsesGpuMips(VkFormat eFormat_ic) const;
+
+    /** A streamed texture: CPU source of every level plus residency bookkeeping. */
+    struct StreamedTexture {
+        std::weak_ptr<TextureHandle> pHandle;
+        VkFormat       eFormat = VK_FORMAT_UNDEFINED;
+        GpuTextureData stData;          // Owned chain (cooked / container); empty when sVTexPath is set
+        std::string    sVTexPath;       // Cooked file, re-mapped for each residency change
+        uint64_t       uSourceHash   = 0u;
+        uint64_t       uSettingsHash = 0u;
+        std::vector<MipLevelDesc> vecLevels;  // Level sizes (offsets into stData or the .vtex)
+        uint32_t lTailLevel     = 0u;   // Coarsest base level (always resident)
+        uint32_t lResidentLevel = 0u;   // Current base level
+        uint32_t lWantedLevel   = 0u;   // From feedback
+        float    fScreenPixels  = 0.f;  // Max RequestResidency since the last UpdateStreaming
+        uint64_t uLastUsedFrame = 0u;
+    };
+    /**
+     * Upload the tail of a full chain and register it for streaming; plain upload when the chain has no level above
+     * the tail. pMapped_ic: level data of a mapped .vtex (null = stStream_in.stData).
+     */
+    std::shared_ptr<TextureHandle> UploadStreamable(StreamedTexture stStream_in, const uint8_t* pMapped_ic);
+    /** Worker output of a path load, consumed by OnCompletedTexture. */
+    struct DecodedTexture {
+        bool bOk        = false;
+        bool bContainer = false;   // stResult.stData holds the container's levels as stored (not cooked)
+        CookedTextureResult stResult;
+    };
+    /** Replace the texture's image with levels [lBaseLevel_ic, end); retires the old image. */
+    bool SetResidentLevel(StreamedTexture& stStream_io, uint32_t lBaseLevel_ic);
+    /** Drop the least recently used texture last used before uUsedBefore_ic back to its tail. False if none qualifies. */
+    bool EvictLeastRecentlyUsed(uint64_t uUsedBefore_ic, uint64_t& uResidentBytes_io, std::vector<TextureHandle*>& vecChanged_out);
+    static uint64_t GetResidentBytes(const StreamedTexture& stStream_ic, uint32_t lBaseLevel_ic);
 
     JobQueue* m_pJobQueue = nullptr;
+    DeferredReleaseQueue* m_pReleaseQueue = nullptr;
     VkDevice m_device = VK_NULL_HANDLE;
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
     VkQueue m_queue = VK_NULL_HANDLE;
     uint32_t m_queueFamilyIndex = 0u;
+    TextureSamplingSettings m_sampling;
+    bool  m_bCompression = true;
+    bool  m_bTextureCompressionBC = false;  // Device feature (queried in SetPhysicalDevice)
+    std::string m_sCookedTextureDir;
+    TextureCookStats m_cookStats;
+    TextureStreamingSettings m_streaming;
+    TextureStreamingStats m_streamStats;
+    std::vector<StreamedTexture> m_streamed;  // Indexed by TextureHandle::GetStreamSlot
+    uint64_t m_uStreamFrame = 0u;
+    TextureArrayPool m_arrayPool;
+    bool  m_bSamplerAnisotropy = false;     // Device feature (queried in SetPhysicalDevice)
+    float m_fMaxDeviceAnisotropy = 1.0f;    // VkPhysicalDeviceLimits::maxSamplerAnisotropy
+    float m_fMaxDeviceLodBias = 0.0f;       // VkPhysicalDeviceLimits::maxSamplerLodBias
+    /** Sampler cache keyed by the effective (anisotropy, mip LOD bias, max LOD) state. */
+    std::map<std::tuple<float, float, float>, VkSampler> m_samplers;
+    std::mutex m_samplerMutex;
     mutable std::shared_mutex m_mutex;
     std::map<std::string, std::shared_ptr<TextureHandle>> m_cache;
     std::set<std::string> m_pendingPaths;
+    std::mutex m_decodedMutex;
+    std::map<std::string, DecodedTexture> m_decoded;  // Written by workers, keyed by path
 };
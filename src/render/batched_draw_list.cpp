@@ -78,6 +78,9 @@ namespace {
     // Sort batches by pipeline/mesh to minimize state changes
     bool BatchOrder(const DrawBatch& a, const DrawBatch& b) {
         if (a.pipeline != b.pipeline) return a.pipeline < b.pipeline;
+        // Within a pipeline, group equal dynamic state so the recorder skips redundant vkCmdSet* calls
+        if (a.rasterState.cullMode != b.rasterState.cullMode) return a.rasterState.cullMode < b.rasterState.cullMode;
+        if (a.rasterState.polygonMode != b.rasterState.polygonMode) return a.rasterState.polygonMode < b.rasterState.polygonMode;
         if (a.vertexBuffer != b.vertexBuffer) return a.vertexBuffer < b.vertexBuffer;
         return a.vertexCount < b.vertexCount;
     }
@@ -105,8 +108,7 @@ bool BatchedDrawList::RebuildIfDirty(
     PipelineManager* pPipelineManager,
     MaterialManager* pMaterialManager,
     VulkanShaderManager* pShaderManager,
-    const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets,
-    GetTextureDescriptorSetFunc getTextureDescriptorSet
+    const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets
 ) {
     size_t renderableCount = pScene ? pScene->GetRenderableCount() : 0;
     if (pScene != m_pLastScene || (pScene && renderableCount != m_lastObjectCount)) {
@@ -115,9 +117,13 @@ bool BatchedDrawList::RebuildIfDirty(
 
     if (!m_bDirty) return false;
 
-    m_lastRenderObjects = pScene ? pScene->BuildRenderList(nullptr, false) : std::vector<RenderObject>();
+    // Refill in place: the vector keeps its capacity across rebuilds
+    if (pScene)
+        pScene->BuildRenderList(m_lastRenderObjects, nullptr, false);
+    else
+        m_lastRenderObjects.clear();
     BuildBatches(m_lastRenderObjects, device, renderPass, hasDepth, pPipelineManager,
-                 pMaterialManager, pShaderManager, pPipelineDescriptorSets, getTextureDescriptorSet);
+                 pMaterialManager, pShaderManager, pPipelineDescriptorSets);
 
     m_pLastScene = pScene;
     m_lastObjectCount = renderableCount;
@@ -154,8 +160,7 @@ void BatchedDrawList::BuildBatches(
     PipelineManager* pPipelineManager,
     MaterialManager* pMaterialManager,
     VulkanShaderManager* pShaderManager,
-    const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets,
-    GetTextureDescriptorSetFunc getTextureDescriptorSet
+    const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets
 ) {
     m_opaqueBatches.clear();
     m_transparentBatches.clear();
@@ -179,11 +184,6 @@ void BatchedDrawList::BuildBatches(
         BatchKey key;
         key.mesh = ro.mesh;
         key.material = ro.material;
-        key.baseColorTexture = ro.texture;
-        key.metallicRoughnessTexture = ro.pMetallicRoughnessTexture;
-        key.emissiveTexture = ro.pEmissiveTexture;
-        key.normalTexture = ro.pNormalTexture;
-        key.occlusionTexture = ro.pOcclusionTexture;
         key.tier = static_cast<InstanceTier>(ro.instanceTier);
 
         batchGroups[key].push_back(static_cast<uint32_t>(i));
@@ -215,20 +215,12 @@ void BatchedDrawList::BuildBatches(
         batch.vertexCount = key.mesh->GetVertexCount();
         batch.firstVertex = key.mesh->GetFirstVertex();
         batch.pipelineKey = key.material->pipelineKey;
+        batch.rasterState = GetRasterDynamicState(key.material->pipelineParams);
         
         if (batch.vertexBuffer == VK_NULL_HANDLE || batch.vertexCount == 0) continue;
         
-        if (getTextureDescriptorSet && key.baseColorTexture && key.baseColorTexture->IsValid()) {
-            VkDescriptorSet texDescSet = getTextureDescriptorSet(
-                key.baseColorTexture, key.metallicRoughnessTexture,
-                key.emissiveTexture, key.normalTexture, key.occlusionTexture);
-            if (texDescSet != VK_NULL_HANDLE) {
-                batch.descriptorSets = { texDescSet };
-            }
-        }
-        
-        // Fallback to pipeline default descriptor sets
-        if (batch.descriptorSets.empty() && pPipelineDescriptorSets) {
+        // Per-pipeline descriptor sets (shared by every batch of the pipeline)
+        if (pPipelineDescriptorSets) {
             auto it = pPipelineDescriptorSets->find(batch.pipelineKey);
             if (it != pPipelineDescriptorSets->end() && !it->second.empty()) {
                 batch.descriptorSets = it->second;
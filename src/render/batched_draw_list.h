@@ -1,7 +1,7 @@
 /*
  * BatchedDrawList - Efficient instanced rendering with dirty tracking.
  * 
- * Groups objects by (mesh, material, textures) into batches.
+ * Groups objects by (mesh, material, tier) into batches. Textures are per object (bindless slots in ObjectData).
  * Each batch = 1 draw call with instanceCount = N objects.
  * Uses gl_InstanceIndex + batchStartIndex to index into ObjectData SSBO.
  * 
@@ -30,37 +30,24 @@ struct MaterialHandle;
 /**
  * Key for batching: objects with same key can be drawn in one instanced call.
  * Includes instanceTier to keep tiers separate (different update patterns).
+ * Textures are not part of the key: objects index the bindless texture array via ObjectData::texIndices.
  */
 struct BatchKey {
     std::shared_ptr<MeshHandle> mesh;
     std::shared_ptr<MaterialHandle> material;
-    std::shared_ptr<TextureHandle> baseColorTexture;
-    std::shared_ptr<TextureHandle> metallicRoughnessTexture;
-    std::shared_ptr<TextureHandle> emissiveTexture;
-    std::shared_ptr<TextureHandle> normalTexture;
-    std::shared_ptr<TextureHandle> occlusionTexture;
     InstanceTier tier = InstanceTier::Static;  // Objects batch only with same tier
     
     bool operator<(const BatchKey& other) const {
-        return std::tie(mesh, material, baseColorTexture, metallicRoughnessTexture, 
-                        emissiveTexture, normalTexture, occlusionTexture, tier) <
-               std::tie(other.mesh, other.material, other.baseColorTexture, other.metallicRoughnessTexture,
-                        other.emissiveTexture, other.normalTexture, other.occlusionTexture, other.tier);
+        return std::tie(mesh, material, tier) < std::tie(other.mesh, other.material, other.tier);
     }
     
     bool operator==(const BatchKey& other) const {
-        return mesh == other.mesh && material == other.material &&
-               baseColorTexture == other.baseColorTexture &&
-               metallicRoughnessTexture == other.metallicRoughnessTexture &&
-               emissiveTexture == other.emissiveTexture &&
-               normalTexture == other.normalTexture &&
-               occlusionTexture == other.occlusionTexture &&
-               tier == other.tier;
+        return mesh == other.mesh && material == other.material && tier == other.tier;
     }
 };
 
 /**
- * A batch of objects sharing the same mesh/material/textures.
+ * A batch of objects sharing the same mesh/material.
  */
 struct DrawBatch {
     BatchKey key;
@@ -75,6 +62,8 @@ struct DrawBatch {
     uint32_t firstVertex = 0;
     std::vector<VkDescriptorSet> descriptorSets;
     std::string pipelineKey;
+    // Material's cull / depth / polygon state (dynamic state: batches share a pipeline across cull modes)
+    RasterDynamicState rasterState;
     
     // First object index for gl_InstanceIndex offset
     uint32_t firstInstanceIndex = 0;
@@ -107,14 +96,6 @@ class BatchedDrawList {
 public:
     BatchedDrawList() = default;
     
-    /**
-     * Callback to get/create descriptor set for textures.
-     */
-    using GetTextureDescriptorSetFunc = std::function<VkDescriptorSet(
-        std::shared_ptr<TextureHandle>, std::shared_ptr<TextureHandle>,
-        std::shared_ptr<TextureHandle>, std::shared_ptr<TextureHandle>,
-        std::shared_ptr<TextureHandle>)>;
-    
     /**
      * Mark list as dirty - will rebuild on next RebuildIfDirty().
      */
@@ -137,8 +118,7 @@ public:
         PipelineManager* pPipelineManager,
         MaterialManager* pMaterialManager,
         VulkanShaderManager* pShaderManager,
-        const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets,
-        GetTextureDescriptorSetFunc getTextureDescriptorSet = nullptr
+        const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets
     );
     
     /**
@@ -212,8 +192,7 @@ private:
         PipelineManager* pPipelineManager,
         MaterialManager* pMaterialManager,
         VulkanShaderManager* pShaderManager,
-        const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets,
-        GetTextureDescriptorSetFunc getTextureDescriptorSet
+        const std::map<std::string, std::vector<VkDescriptorSet>>* pPipelineDescriptorSets
     );
 
     void SortBatches();
@@ -0,0 +1,235 @@
+/*
+ * BindlessTextureTable - descriptor-indexed texture array with deferred slot reuse.
+ */
+#include "bindless_texture_table.h"
+#include "managers/texture_manager.h"
+#include "vulkan/vulkan_utils.h"
+#include <algorithm>
+
+BindlessTextureTable::~BindlessTextureTable() {
+    Destroy();
+}
+
+bool BindlessTextureTable::Create(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t lMaxTextures_ic, uint32_t lFramesInFlight_ic) {
+    if ((device == VK_NULL_HANDLE) || (physicalDevice == VK_NULL_HANDLE)) {
+        VulkanUtils::LogErr("BindlessTextureTable::Create: invalid device");
+        return false;
+    }
+    Destroy();
+
+    /* A combined image sampler counts against both the sampler and the sampled image update-after-bind limits. */
+    VkPhysicalDeviceVulkan12Properties stProps12 = {};
+    stProps12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+    VkPhysicalDeviceProperties2 stProps = {};
+    stProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    stProps.pNext = &stProps12;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &stProps);
+    const uint32_t lDeviceMax = std::min({ stProps12.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                           stProps12.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                           stProps12.maxDescriptorSetUpdateAfterBindSamplers,
+                                           stProps12.maxDescriptorSetUpdateAfterBindSampledImages,
+                                           stProps12.maxPerStageUpdateAfterBindResources });
+    this->m_device = device;
+    this->m_lCapacity = std::max(std::min(lMaxTextures_ic, lDeviceMax), 1u);
+    this->m_lFramesInFlight = std::max(lFramesInFlight_ic, 1u);
+
+    const VkDescriptorBindingFlags uBindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+                                                   VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                                                   VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+    VkDescriptorSetLayoutBindingFlagsCreateInfo stFlagsInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+        .pNext = nullptr,
+        .bindingCount = 1u,
+        .pBindingFlags = &uBindingFlags,
+    };
+    VkDescriptorSetLayoutBinding stBinding = {
+        .binding            = 0u,
+        .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .descriptorCount    = this->m_lCapacity,
+        .stageFlags         = VK_SHADER_STAGE_FRAGMENT_BIT,
+        .pImmutableSamplers = nullptr,
+    };
+    VkDescriptorSetLayoutCreateInfo stLayoutInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = &stFlagsInfo,
+        .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+        .bindingCount = 1u,
+        .pBindings = &stBinding,
+    };
+    if (vkCreateDescriptorSetLayout(device, &stLayoutInfo, nullptr, &this->m_layout) != VK_SUCCESS) {
+        VulkanUtils::LogErr("BindlessTextureTable::Create: descriptor set layout failed");
+        Destroy();
+        return false;
+    }
+
+    VkDescriptorPoolSize stPoolSize = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, this->m_lCapacity };
+    VkDescriptorPoolCreateInfo stPoolInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+        .maxSets = 1u,
+        .poolSizeCount = 1u,
+        .pPoolSizes = &stPoolSize,
+    };
+    if (vkCreateDescriptorPool(device, &stPoolInfo, nullptr, &this->m_descriptorPool) != VK_SUCCESS) {
+        VulkanUtils::LogErr("BindlessTextureTable::Create: descriptor pool failed");
+        Destroy();
+        return false;
+    }
+
+    VkDescriptorSetAllocateInfo stAllocInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = nullptr,
+        .descriptorPool = this->m_descriptorPool,
+        .descriptorSetCount = 1u,
+        .pSetLayouts = &this->m_layout,
+    };
+    if (vkAllocateDescriptorSets(device, &stAllocInfo, &this->m_descriptorSet) != VK_SUCCESS) {
+        VulkanUtils::LogErr("BindlessTextureTable::Create: descriptor set allocation failed");
+        Destroy();
+        return false;
+    }
+
+    this->m_vecSlots.assign(this->m_lCapacity, nullptr);
+    /* Free list popped from the back: low slots are handed out first. */
+    this->m_vecFreeSlots.clear();
+    this->m_vecFreeSlots.reserve(this->m_lCapacity);
+    for (uint32_t lSlot = this->m_lCapacity - 1u; lSlot > kDefaultIndex; --lSlot)
+        this->m_vecFreeSlots.push_back(lSlot);
+    VulkanUtils::LogInfo("BindlessTextureTable: {} texture slots (device limit {})", this->m_lCapacity, lDeviceMax);
+    return true;
+}
+
+void BindlessTextureTable::Destroy() {
+    for (const std::shared_ptr<TextureHandle>& pTexture : this->m_vecSlots) {
+        if (pTexture != nullptr)
+            pTexture->SetBindlessIndex(TextureHandle::kNoBindlessIndex);
+    }
+    this->m_vecSlots.clear();
+    this->m_vecFreeSlots.clear();
+    this->m_retiredSlots.clear();
+    this->m_lRegistered = 0u;
+    this->m_bFullWarned = false;
+    if (this->m_device != VK_NULL_HANDLE) {
+        /* The set is freed with its pool. */
+        if (this->m_descriptorPool != VK_NULL_HANDLE)
+            vkDestroyDescriptorPool(this->m_device, this->m_descriptorPool, nullptr);
+        if (this->m_layout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(this->m_device, this->m_layout, nullptr);
+    }
+    this->m_descriptorPool = VK_NULL_HANDLE;
+    this->m_descriptorSet = VK_NULL_HANDLE;
+    this->m_layout = VK_NULL_HANDLE;
+    this->m_device = VK_NULL_HANDLE;
+    this->m_lCapacity = 0u;
+}
+
+void BindlessTextureTable::SetDefaultTexture(const std::shared_ptr<TextureHandle>& pTexture_ic) {
+    if ((this->IsValid() == false) || (pTexture_ic == nullptr) || (pTexture_ic->IsValid() == false))
+        return;
+    WriteSlot(kDefaultIndex, *pTexture_ic);
+    this->m_vecSlots[kDefaultIndex] = pTexture_ic;
+    pTexture_ic->SetBindlessIndex(kDefaultIndex);
+}
+
+void BindlessTextureTable::BeginFrame(uint64_t uFrameSerial_ic) {
+    this->m_uFrameSerial = uFrameSerial_ic;
+    /* Same rule as TextureManager's retired images: frame N is done once N + lFramesInFlight has started. */
+    while ((this->m_retiredSlots.empty() == false) &&
+           (this->m_retiredSlots.front().second + this->m_lFramesInFlight < uFrameSerial_ic)) {
+        const uint32_t lSlot = this->m_retiredSlots.front().first;
+        this->m_retiredSlots.pop_front();
+        this->m_vecSlots[lSlot].reset();
+        this->m_vecFreeSlots.push_back(lSlot);
+    }
+}
+
+bool BindlessTextureTable::Register(const std::shared_ptr<TextureHandle>& pTexture_ic) {
+    if ((this->IsValid() == false) || (pTexture_ic == nullptr) || (pTexture_ic->IsValid() == false))
+        return false;
+    if (pTexture_ic->GetBindlessIndex() != TextureHandle::kNoBindlessIndex)
+        return true;
+    const uint32_t lSlot = AllocateSlot();
+    if (lSlot == kDefaultIndex)
+        return false;
+    WriteSlot(lSlot, *pTexture_ic);
+    this->m_vecSlots[lSlot] = pTexture_ic;
+    pTexture_ic->SetBindlessIndex(lSlot);
+    ++this->m_lRegistered;
+    return true;
+}
+
+bool BindlessTextureTable::Rebind(TextureHandle* pTexture_ic) {
+    if ((this->IsValid() == false) || (pTexture_ic == nullptr))
+        return false;
+    const uint32_t lOldSlot = pTexture_ic->GetBindlessIndex();
+    if ((lOldSlot == TextureHandle::kNoBindlessIndex) || (lOldSlot >= this->m_lCapacity) ||
+        (this->m_vecSlots[lOldSlot].get() != pTexture_ic))
+        return false;
+    /* Pending frames may sample the old slot (UPDATE_UNUSED_WHILE_PENDING forbids rewriting it): use a new one. */
+    const uint32_t lNewSlot = AllocateSlot();
+    if (lNewSlot == kDefaultIndex) {
+        /* The old slot's view is about to be released with the replaced image: retire it and sample the default
+           texture until a slot frees up (the texture must be registered again). */
+        this->m_retiredSlots.emplace_back(lOldSlot, this->m_uFrameSerial);
+        pTexture_ic->SetBindlessIndex(TextureHandle::kNoBindlessIndex);
+        --this->m_lRegistered;
+        return true;
+    }
+    WriteSlot(lNewSlot, *pTexture_ic);
+    this->m_vecSlots[lNewSlot] = std::move(this->m_vecSlots[lOldSlot]);
+    this->m_retiredSlots.emplace_back(lOldSlot, this->m_uFrameSerial);
+    pTexture_ic->SetBindlessIndex(lNewSlot);
+    return true;
+}
+
+uint32_t BindlessTextureTable::ReleaseUnused(const std::set<const TextureHandle*>& setInUse_ic) {
+    uint32_t lReleased = 0u;
+    for (uint32_t lSlot = kDefaultIndex + 1u; lSlot < static_cast<uint32_t>(this->m_vecSlots.size()); ++lSlot) {
+        TextureHandle* pTexture = this->m_vecSlots[lSlot].get();
+        /* Skip empty and already released slots (a released slot no longer matches its texture's index). */
+        if ((pTexture == nullptr) || (pTexture->GetBindlessIndex() != lSlot) || (setInUse_ic.count(pTexture) != 0u))
+            continue;
+        /* The texture reference stays in the slot until it is reclaimed: frames in flight may still sample it. */
+        pTexture->SetBindlessIndex(TextureHandle::kNoBindlessIndex);
+        this->m_retiredSlots.emplace_back(lSlot, this->m_uFrameSerial);
+        --this->m_lRegistered;
+        ++lReleased;
+    }
+    return lReleased;
+}
+
+void BindlessTextureTable::WriteSlot(uint32_t lSlot_ic, const TextureHandle& texture_ic) {
+    VkDescriptorImageInfo stImageInfo = {
+        .sampler     = texture_ic.GetSampler(),
+        .imageView   = texture_ic.GetView(),
+        .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+    };
+    VkWriteDescriptorSet stWrite = {
+        .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .pNext            = nullptr,
+        .dstSet           = this->m_descriptorSet,
+        .dstBinding       = 0u,
+        .dstArrayElement  = lSlot_ic,
+        .descriptorCount  = 1u,
+        .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        .pImageInfo       = &stImageInfo,
+        .pBufferInfo      = nullptr,
+        .pTexelBufferView = nullptr,
+    };
+    vkUpdateDescriptorSets(this->m_device, 1u, &stWrite, 0u, nullptr);
+}
+
+uint32_t BindlessTextureTable::AllocateSlot() {
+    if (this->m_vecFreeSlots.empty() == true) {
+        if (this->m_bFullWarned == false) {
+            VulkanUtils::LogWarn("BindlessTextureTable: all {} slots in use; further textures sample the default texture",
+                                 this->m_lCapacity);
+            this->m_bFullWarned = true;
+        }
+        return kDefaultIndex;
+    }
+    const uint32_t lSlot = this->m_vecFreeSlots.back();
+    this->m_vecFreeSlots.pop_back();
+    return lSlot;
+}
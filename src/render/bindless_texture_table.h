@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+class TextureHandle;
+
+/**
+ * BindlessTextureTable — one descriptor-indexed array of every texture the scene samples.
+ *
+ * Set 1 of the main pipelines: binding 0 = sampler2D uTextures[capacity] (fragment stage), indexed in the shader
+ * with the per-object slots written to ObjectData::texIndices. Textures keep their slot while registered, so one
+ * descriptor set serves the whole frame and draw batches no longer depend on textures.
+ *
+ * The layout is UPDATE_AFTER_BIND + PARTIALLY_BOUND + UPDATE_UNUSED_WHILE_PENDING: slots are written between
+ * frames while earlier frames are still in flight, and unwritten slots are never read. A set with such a layout
+ * cannot also hold dynamic buffers, hence a separate set next to "main_frag_tex" (set 0).
+ *
+ * Slot 0 (kDefaultIndex) is the 1x1 white default texture. Released slots (and their texture reference) are
+ * reused only after lFramesInFlight further BeginFrame calls, when no submitted frame can still sample them.
+ */
+class BindlessTextureTable {
+public:
+    static constexpr uint32_t kDefaultIndex = 0u;
+    /** Requested array size; clamped to the device's update-after-bind sampler limits. */
+    static constexpr uint32_t kMaxTextures = 4096u;
+
+    BindlessTextureTable() = default;
+    ~BindlessTextureTable();
+
+    BindlessTextureTable(const BindlessTextureTable&) = delete;
+    BindlessTextureTable& operator=(const BindlessTextureTable&) = delete;
+
+    /**
+     * Create layout, pool and the single set.
+     * @param lMaxTextures_ic    Array size (clamped to device limits, at least 1 for the default slot).
+     * @param lFramesInFlight_ic Frames a released slot stays reserved.
+     * @return false on failure (table left invalid).
+     */
+    bool Create(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t lMaxTextures_ic, uint32_t lFramesInFlight_ic);
+    void Destroy();
+
+    /** Write slot 0. Every object without a registered texture for a role samples it. */
+    void SetDefaultTexture(const std::shared_ptr<TextureHandle>& pTexture_ic);
+
+    /** Once per frame before Register/Rebind/ReleaseUnused: reclaim slots released lFramesInFlight frames ago. */
+    void BeginFrame(uint64_t uFrameSerial_ic);
+
+    /**
+     * Give pTexture_ic a slot and write its descriptor (no-op if it already has one).
+     * False if the texture is invalid or the table is full (objects then sample the default texture).
+     */
+    bool Register(const std::shared_ptr<TextureHandle>& pTexture_ic);
+
+    /**
+     * The texture's image was replaced (streaming): write it to a fresh slot and release the old one, which
+     * frames in flight still sample. With no free slot the old one is released too and the texture is left
+     * unregistered (kNoBindlessIndex: objects sample the default texture until Register succeeds again).
+     * True if its bindless index changed; false if it is not registered.
+     */
+    bool Rebind(TextureHandle* pTexture_ic);
+
+    /** Release the slot of every registered texture not in setInUse_ic. Returns the number released. */
+    uint32_t ReleaseUnused(const std::set<const TextureHandle*>& setInUse_ic);
+
+    VkDescriptorSetLayout GetLayout() const { return this->m_layout; }
+    VkDescriptorSet GetSet() const { return this->m_descriptorSet; }
+    uint32_t GetCapacity() const { return this->m_lCapacity; }
+    /** Registered textures (excludes the default slot and slots waiting to be reclaimed). */
+    uint32_t GetRegisteredCount() const { return this->m_lRegistered; }
+    bool IsValid() const { return this->m_descriptorSet != VK_NULL_HANDLE; }
+
+private:
+    void WriteSlot(uint32_t lSlot_ic, const TextureHandle& texture_ic);
+    /** Pop a free slot (kDefaultIndex when none is left). */
+    uint32_t AllocateSlot();
+
+    VkDevice              m_device = VK_NULL_HANDLE;
+    VkDescriptorSetLayout m_layout = VK_NULL_HANDLE;
+    VkDescriptorPool      m_descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet       m_descriptorSet = VK_NULL_HANDLE;
+    uint32_t m_lCapacity = 0u;
+    uint32_t m_lFramesInFlight = 1u;
+    uint32_t m_lRegistered = 0u;
+    uint64_t m_uFrameSerial = 0u;
+    bool     m_bFullWarned = false;
+
+    /** Texture per slot: registered, or released and kept alive until the slot is reclaimed. */
+    std::vector<std::shared_ptr<TextureHandle>> m_vecSlots;
+    std::vector<uint32_t> m_vecFreeSlots;
+    /** Released slots with the frame they were released in. */
+    std::deque<std::pair<uint32_t, uint64_t>> m_retiredSlots;
+};
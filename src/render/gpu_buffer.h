@@ -11,12 +11,13 @@
 
 #pragma once
 
+#include "vulkan_memory.h"
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <cstddef>
 
 /**
- * GPUBuffer — Owns a VkBuffer + VkDeviceMemory with optional persistent mapping.
+ * GPUBuffer — Owns a VkBuffer and its memory (a DeviceMemoryAllocator range) with optional persistent mapping.
  *
  * For ring-buffered usage:
  *   - Create with totalSize = singleFrameSize * framesInFlight
@@ -49,6 +50,7 @@ public:
      * @param usage VkBufferUsageFlags (e.g., VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
      * @param properties VkMemoryPropertyFlags (e.g., VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
      * @param persistentMap If true, map the buffer at creation (for HOST_VISIBLE memory)
+     * @param category Memory statistics category
      * @return true on success
      */
     bool Create(VkDevice device,
@@ -56,7 +58,8 @@ public:
                 VkDeviceSize size,
                 VkBufferUsageFlags usage,
                 VkMemoryPropertyFlags properties,
-                bool persistentMap = false);
+                bool persistentMap = false,
+                MemoryCategory category = MemoryCategory::Buffer);
 
     /**
      * Destroy buffer and free memory.
@@ -71,7 +74,8 @@ public:
     void* GetMappedPtr(VkDeviceSize offset = 0) const;
 
     /**
-     * Map buffer memory (for non-persistent mapping scenario).
+     * Map buffer memory (for non-persistent mapping scenario). Host-visible memory stays mapped by the allocator,
+     * so this returns a pointer into that mapping.
      * @param offset Start offset
      * @param size Size to map (VK_WHOLE_SIZE for entire buffer)
      * @return Mapped pointer, or nullptr on failure
@@ -79,7 +83,7 @@ public:
     void* Map(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
 
     /**
-     * Unmap buffer memory (for non-persistent mapping scenario).
+     * Unmap buffer memory (for non-persistent mapping scenario). No-op: the mapping belongs to the memory block.
      */
     void Unmap();
 
@@ -99,19 +103,17 @@ public:
 
     // Accessors
     VkBuffer GetBuffer() const { return m_buffer; }
-    VkDeviceMemory GetMemory() const { return m_memory; }
+    VkDeviceMemory GetMemory() const { return m_allocation.memory; }
+    /** Offset of the buffer within GetMemory(). */
+    VkDeviceSize GetMemoryOffset() const { return m_allocation.uOffset; }
     VkDeviceSize GetSize() const { return m_size; }
     bool IsMapped() const { return m_mappedPtr != nullptr; }
     bool IsValid() const { return m_buffer != VK_NULL_HANDLE; }
 
 private:
-    static uint32_t FindMemoryType(VkPhysicalDevice physicalDevice,
-                                   uint32_t typeFilter,
-                                   VkMemoryPropertyFlags properties);
-
     VkDevice        m_device      = VK_NULL_HANDLE;
     VkBuffer        m_buffer      = VK_NULL_HANDLE;
-    VkDeviceMemory  m_memory      = VK_NULL_HANDLE;
+    MemoryAllocation m_allocation;
     VkDeviceSize    m_size        = 0;
     void*           m_mappedPtr   = nullptr;
     bool            m_persistent  = false;
@@ -11,7 +11,8 @@ bool GPUCuller::Create(VkDevice device,
                        VkPhysicalDevice physicalDevice,
                        VulkanShaderManager* pShaderManager,
                        uint32_t maxObjects,
-                       uint32_t maxBatches) {
+                       uint32_t maxBatches,
+                       VkPipelineCache pipelineCache) {
     VulkanUtils::LogTrace("GPUCuller::Create: maxObjects={}, maxBatches={}", maxObjects, maxBatches);
 
     if (device == VK_NULL_HANDLE || physicalDevice == VK_NULL_HANDLE) {
@@ -134,7 +135,7 @@ bool GPUCuller::Create(VkDevice device,
     // No push constants for now
 
     try {
-        m_computePipeline.Create(device, pShaderManager, "shaders/gpu_cull.comp.spv", layoutDesc);
+        m_computePipeline.Create(device, pShaderManager, "shaders/gpu_cull.comp.spv", layoutDesc, pipelineCache);
     } catch (const std::exception& e) {
         VulkanUtils::LogErr("GPUCuller::Create: failed to create compute pipeline: {}", e.what());
         Destroy();
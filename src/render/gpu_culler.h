@@ -100,13 +100,15 @@ public:
      * @param pShaderManager Shader manager for loading compute shader
      * @param maxObjects Maximum number of objects to cull
      * @param maxBatches Maximum number of draw batches (indirect commands)
+     * @param pipelineCache Pipeline cache for the compute pipeline (VK_NULL_HANDLE = none)
      * @return true on success
      */
     bool Create(VkDevice device,
                 VkPhysicalDevice physicalDevice,
                 VulkanShaderManager* pShaderManager,
                 uint32_t maxObjects,
-                uint32_t maxBatches = 1);
+                uint32_t maxBatches = 1,
+                VkPipelineCache pipelineCache = VK_NULL_HANDLE);
 
     /**
      * Destroy all GPU resources.
@@ -0,0 +1,328 @@
+#include "meshlet_culler.h"
+#include "vulkan/vulkan_shader_manager.h"
+#include "vulkan/vulkan_utils.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+/** Bindings 0–6 of meshlet_cull.comp: binding 0 is a UBO, the rest are storage buffers. */
+constexpr uint32_t kMeshletCullBindingCount = 7u;
+
+} // namespace
+
+MeshletCuller::~MeshletCuller() {
+    Destroy();
+}
+
+bool MeshletCuller::Create(VkDevice device, VkPhysicalDevice physicalDevice, VulkanShaderManager* pShaderManager,
+                           uint32_t lMaxMeshlets_ic, uint32_t lMaxInstances_ic, uint32_t lMaxDraws_ic, uint32_t lMaxBatches_ic,
+                           VkPipelineCache pipelineCache_ic) {
+    VulkanUtils::LogTrace("MeshletCuller::Create: maxMeshlets={}, maxInstances={}, maxDraws={}, maxBatches={}",
+                          lMaxMeshlets_ic, lMaxInstances_ic, lMaxDraws_ic, lMaxBatches_ic);
+
+    if ((device == VK_NULL_HANDLE) || (physicalDevice == VK_NULL_HANDLE)) {
+        VulkanUtils::LogErr("MeshletCuller::Create: invalid device");
+        return false;
+    }
+    if ((pShaderManager == nullptr) || (pShaderManager->IsValid() == false)) {
+        VulkanUtils::LogErr("MeshletCuller::Create: invalid shader manager");
+        return false;
+    }
+    if ((lMaxMeshlets_ic == 0u) || (lMaxInstances_ic == 0u) || (lMaxDraws_ic == 0u) || (lMaxBatches_ic == 0u)) {
+        VulkanUtils::LogErr("MeshletCuller::Create: capacities must be > 0");
+        return false;
+    }
+
+    this->m_device = device;
+    this->m_physicalDevice = physicalDevice;
+    this->m_lMaxMeshlets = lMaxMeshlets_ic;
+    this->m_lMaxInstances = lMaxInstances_ic;
+    this->m_lMaxDraws = lMaxDraws_ic;
+    this->m_lMaxBatches = lMaxBatches_ic;
+
+    /* All buffers host visible + coherent like GPUCuller: CPU writes inputs / resets counters directly. */
+    const VkMemoryPropertyFlags uHostProps = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    struct BufferSpec {
+        GPUBuffer* pBuffer;
+        VkDeviceSize size;
+        VkBufferUsageFlags usage;
+        const char* pName;
+    };
+    const BufferSpec stSpecs[kMeshletCullBindingCount] = {
+        { &this->m_paramsBuffer,       sizeof(MeshletCullParams), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, "params" },
+        { &this->m_meshletBuffer,      static_cast<VkDeviceSize>(lMaxMeshlets_ic) * sizeof(Meshlet), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, "meshlet" },
+        { &this->m_instanceBuffer,     static_cast<VkDeviceSize>(lMaxInstances_ic) * sizeof(MeshletCullInstance), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, "instance" },
+        { &this->m_batchBuffer,        static_cast<VkDeviceSize>(lMaxBatches_ic) * sizeof(MeshletCullBatch), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, "batch" },
+        { &this->m_drawBuffer,         static_cast<VkDeviceSize>(lMaxDraws_ic) * sizeof(VkDrawIndirectCommand),
+                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, "draw" },
+        { &this->m_drawCountBuffer,    static_cast<VkDeviceSize>(lMaxBatches_ic) * sizeof(uint32_t),
+                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, "draw count" },
+        { &this->m_visibleCountBuffer, sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, "visible count" },
+    };
+    for (const BufferSpec& stSpec : stSpecs) {
+        if (stSpec.pBuffer->Create(device, physicalDevice, stSpec.size, stSpec.usage, uHostProps, true) == false) {
+            VulkanUtils::LogErr("MeshletCuller::Create: failed to create {} buffer", stSpec.pName);
+            Destroy();
+            return false;
+        }
+    }
+
+    if (CreateDescriptorSetLayout() == false) {
+        VulkanUtils::LogErr("MeshletCuller::Create: failed to create descriptor set layout");
+        Destroy();
+        return false;
+    }
+    if (CreateDescriptorPool() == false) {
+        VulkanUtils::LogErr("MeshletCuller::Create: failed to create descriptor pool");
+        Destroy();
+        return false;
+    }
+    if (CreateDescriptorSet() == false) {
+        VulkanUtils::LogErr("MeshletCuller::Create: failed to create descriptor set");
+        Destroy();
+        return false;
+    }
+
+    ComputePipelineLayoutDescriptor layoutDesc;
+    layoutDesc.descriptorSetLayouts.push_back(this->m_descriptorSetLayout);
+    try {
+        this->m_computePipeline.Create(device, pShaderManager, "shaders/meshlet_cull.comp.spv", layoutDesc, pipelineCache_ic);
+    } catch (const std::exception& e) {
+        VulkanUtils::LogErr("MeshletCuller::Create: failed to create compute pipeline: {}", e.what());
+        Destroy();
+        return false;
+    }
+
+    VulkanUtils::LogInfo("MeshletCuller created: maxMeshlets={}, maxInstances={}, maxDraws={}, maxBatches={}",
+                         lMaxMeshlets_ic, lMaxInstances_ic, lMaxDraws_ic, lMaxBatches_ic);
+    return true;
+}
+
+void MeshletCuller::Destroy() {
+    this->m_computePipeline.Destroy();
+
+    if (this->m_descriptorPool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(this->m_device, this->m_descriptorPool, nullptr);
+        this->m_descriptorPool = VK_NULL_HANDLE;
+    }
+    this->m_descriptorSet = VK_NULL_HANDLE;  // Freed with pool
+
+    if (this->m_descriptorSetLayout != VK_NULL_HANDLE) {
+        vkDestroyDescriptorSetLayout(this->m_device, this->m_descriptorSetLayout, nullptr);
+        this->m_descriptorSetLayout = VK_NULL_HANDLE;
+    }
+
+    this->m_paramsBuffer.Destroy();
+    this->m_meshletBuffer.Destroy();
+    this->m_instanceBuffer.Destroy();
+    this->m_batchBuffer.Destroy();
+    this->m_drawBuffer.Destroy();
+    this->m_drawCountBuffer.Destroy();
+    this->m_visibleCountBuffer.Destroy();
+
+    this->m_device = VK_NULL_HANDLE;
+    this->m_physicalDevice = VK_NULL_HANDLE;
+    this->m_lMaxMeshlets = 0u;
+    this->m_lMaxInstances = 0u;
+    this->m_lMaxDraws = 0u;
+    this->m_lMaxBatches = 0u;
+    this->m_lCurrentInstanceCount = 0u;
+}
+
+bool MeshletCuller::CreateDescriptorSetLayout() {
+    VkDescriptorSetLayoutBinding bindings[kMeshletCullBindingCount] = {};
+    for (uint32_t lB = 0u; lB < kMeshletCullBindingCount; ++lB) {
+        bindings[lB].binding = lB;
+        bindings[lB].descriptorType = (lB == 0u) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[lB].descriptorCount = 1;
+        bindings[lB].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[lB].pImmutableSamplers = nullptr;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .bindingCount = kMeshletCullBindingCount,
+        .pBindings = bindings,
+    };
+
+    VkResult r = vkCreateDescriptorSetLayout(this->m_device, &layoutInfo, nullptr, &this->m_descriptorSetLayout);
+    return r == VK_SUCCESS;
+}
+
+bool MeshletCuller::CreateDescriptorPool() {
+    VkDescriptorPoolSize poolSizes[2] = {};
+    poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[0].descriptorCount = 1;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSizes[1].descriptorCount = kMeshletCullBindingCount - 1u;  // Bindings 1-6
+
+    VkDescriptorPoolCreateInfo poolInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .maxSets = 1,
+        .poolSizeCount = 2,
+        .pPoolSizes = poolSizes,
+    };
+
+    VkResult r = vkCreateDescriptorPool(this->m_device, &poolInfo, nullptr, &this->m_descriptorPool);
+    return r == VK_SUCCESS;
+}
+
+bool MeshletCuller::CreateDescriptorSet() {
+    VkDescriptorSetAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+        .pNext = nullptr,
+        .descriptorPool = this->m_descriptorPool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = &this->m_descriptorSetLayout,
+    };
+
+    VkResult r = vkAllocateDescriptorSets(this->m_device, &allocInfo, &this->m_descriptorSet);
+    if (r != VK_SUCCESS) {
+        return false;
+    }
+
+    const GPUBuffer* pBuffers[kMeshletCullBindingCount] = {
+        &this->m_paramsBuffer, &this->m_meshletBuffer, &this->m_instanceBuffer, &this->m_batchBuffer,
+        &this->m_drawBuffer, &this->m_drawCountBuffer, &this->m_visibleCountBuffer,
+    };
+    VkDescriptorBufferInfo bufferInfos[kMeshletCullBindingCount] = {};
+    VkWriteDescriptorSet writes[kMeshletCullBindingCount] = {};
+    for (uint32_t lB = 0u; lB < kMeshletCullBindingCount; ++lB) {
+        bufferInfos[lB].buffer = pBuffers[lB]->GetBuffer();
+        bufferInfos[lB].offset = 0;
+        bufferInfos[lB].range = (lB == 0u) ? sizeof(MeshletCullParams) : VK_WHOLE_SIZE;
+
+        writes[lB].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[lB].dstSet = this->m_descriptorSet;
+        writes[lB].dstBinding = lB;
+        writes[lB].dstArrayElement = 0;
+        writes[lB].descriptorType = (lB == 0u) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[lB].descriptorCount = 1;
+        writes[lB].pBufferInfo = &bufferInfos[lB];
+    }
+
+    vkUpdateDescriptorSets(this->m_device, kMeshletCullBindingCount, writes, 0, nullptr);
+    return true;
+}
+
+bool MeshletCuller::UploadMeshlets(const Meshlet* pMeshlets_ic, uint32_t lCount_ic) {
+    if ((pMeshlets_ic == nullptr) || (lCount_ic == 0u)) {
+        return true;
+    }
+    if (lCount_ic > this->m_lMaxMeshlets) {
+        VulkanUtils::LogWarn("MeshletCuller: {} meshlets exceed capacity {}", lCount_ic, this->m_lMaxMeshlets);
+        return false;
+    }
+    void* pDst = this->m_meshletBuffer.GetMappedPtr();
+    if (pDst != nullptr) {
+        std::memcpy(pDst, pMeshlets_ic, static_cast<size_t>(lCount_ic) * sizeof(Meshlet));
+    }
+    return true;
+}
+
+void MeshletCuller::UploadInstances(const MeshletCullInstance* pInstances_ic, uint32_t lCount_ic) {
+    if ((pInstances_ic == nullptr) || (lCount_ic == 0u)) {
+        return;
+    }
+    const uint32_t lUploadCount = (lCount_ic <= this->m_lMaxInstances) ? lCount_ic : this->m_lMaxInstances;
+    void* pDst = this->m_instanceBuffer.GetMappedPtr();
+    if (pDst != nullptr) {
+        std::memcpy(pDst, pInstances_ic, static_cast<size_t>(lUploadCount) * sizeof(MeshletCullInstance));
+    }
+}
+
+void MeshletCuller::UploadBatches(const MeshletCullBatch* pBatches_ic, uint32_t lCount_ic) {
+    if ((pBatches_ic == nullptr) || (lCount_ic == 0u)) {
+        return;
+    }
+    const uint32_t lUploadCount = (lCount_ic <= this->m_lMaxBatches) ? lCount_ic : this->m_lMaxBatches;
+    void* pDst = this->m_batchBuffer.GetMappedPtr();
+    if (pDst != nullptr) {
+        std::memcpy(pDst, pBatches_ic, static_cast<size_t>(lUploadCount) * sizeof(MeshletCullBatch));
+    }
+}
+
+void MeshletCuller::UpdateParams(const float planes[6][4], const float* pCameraPos_ic,
+                                 uint32_t lInstanceCount_ic, uint32_t lBatchCount_ic, uint32_t lMeshletCount_ic) {
+    this->m_lCurrentInstanceCount = (lInstanceCount_ic <= this->m_lMaxInstances) ? lInstanceCount_ic : this->m_lMaxInstances;
+
+    MeshletCullParams* pParams = static_cast<MeshletCullParams*>(this->m_paramsBuffer.GetMappedPtr());
+    if (pParams != nullptr) {
+        std::memcpy(pParams->planes, planes, sizeof(pParams->planes));
+        pParams->cameraPos[0] = pCameraPos_ic[0];
+        pParams->cameraPos[1] = pCameraPos_ic[1];
+        pParams->cameraPos[2] = pCameraPos_ic[2];
+        pParams->cameraPos[3] = 1.f;
+        pParams->instanceCount = this->m_lCurrentInstanceCount;
+        pParams->batchCount = (lBatchCount_ic <= this->m_lMaxBatches) ? lBatchCount_ic : this->m_lMaxBatches;
+        pParams->meshletCount = (lMeshletCount_ic <= this->m_lMaxMeshlets) ? lMeshletCount_ic : this->m_lMaxMeshlets;
+        pParams->_pad0 = 0u;
+    }
+}
+
+void MeshletCuller::ResetCounters(VkCommandBuffer cmdBuffer) {
+    uint32_t* pVisible = static_cast<uint32_t*>(this->m_visibleCountBuffer.GetMappedPtr());
+    if (pVisible != nullptr) {
+        *pVisible = 0u;
+    }
+    uint32_t* pCounts = static_cast<uint32_t*>(this->m_drawCountBuffer.GetMappedPtr());
+    if (pCounts != nullptr) {
+        std::memset(pCounts, 0, static_cast<size_t>(this->m_lMaxBatches) * sizeof(uint32_t));
+    }
+
+    VkMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = VK_ACCESS_HOST_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+    };
+    vkCmdPipelineBarrier(cmdBuffer,
+                         VK_PIPELINE_STAGE_HOST_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         0,
+                         1, &barrier,
+                         0, nullptr,
+                         0, nullptr);
+}
+
+void MeshletCuller::Dispatch(VkCommandBuffer cmdBuffer) {
+    if (this->m_lCurrentInstanceCount == 0u) {
+        return;
+    }
+
+    vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->m_computePipeline.Get());
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                            this->m_computePipeline.GetLayout(),
+                            0, 1, &this->m_descriptorSet,
+                            0, nullptr);
+
+    /* One workgroup (local_size_x = 64 in meshlet_cull.comp) per instance; threads stride over its meshlets. */
+    vkCmdDispatch(cmdBuffer, this->m_lCurrentInstanceCount, 1, 1);
+}
+
+void MeshletCuller::BarrierAfterDispatch(VkCommandBuffer cmdBuffer) {
+    /* Draw commands and counts are both consumed by vkCmdDrawIndirectCount (DRAW_INDIRECT stage). */
+    VkMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .pNext = nullptr,
+        .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+    };
+    vkCmdPipelineBarrier(cmdBuffer,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                         0,
+                         1, &barrier,
+                         0, nullptr,
+                         0, nullptr);
+}
+
+uint32_t MeshletCuller::ReadbackVisibleCount() {
+    uint32_t* pCounter = static_cast<uint32_t*>(this->m_visibleCountBuffer.GetMappedPtr());
+    return (pCounter != nullptr) ? *pCounter : 0u;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "gpu_buffer.h"
+#include "meshlet_builder.h"
+#include "vulkan/vulkan_compute_pipeline.h"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+class VulkanShaderManager;
+
+/**
+ * MeshletCullInstance — One (object, mesh) pair whose meshlets are culled on the GPU.
+ *
+ * Meshlet bounds are mesh-local; the compute shader transforms them with the model matrix.
+ * Must match meshlet_cull.comp MeshletCullInstance struct (96 bytes).
+ */
+struct MeshletCullInstance {
+    float    model[16];       // Object world matrix (column-major)
+    uint32_t objectIndex;     // ObjectData SSBO index (written to firstInstance of each emitted draw)
+    uint32_t batchId;         // Output section (see MeshletCullBatch)
+    uint32_t meshletOffset;   // First meshlet of the mesh in the meshlet buffer
+    uint32_t meshletCount;    // Meshlets of the mesh
+    uint32_t flags;           // kMeshletCullFlagCone: back-face cone test allowed (single-sided material, model
+                              // is rotation + uniform scale: the shader transforms the cone with the model basis)
+    uint32_t firstVertex;     // Mesh base vertex (added to Meshlet::firstVertex)
+    uint32_t _pad0;
+    uint32_t _pad1;
+};
+static_assert(sizeof(MeshletCullInstance) == 96, "MeshletCullInstance must be 96 bytes");
+
+constexpr uint32_t kMeshletCullFlagCone = 1u;
+
+/**
+ * MeshletCullBatch — Output section for one draw batch: draws [drawOffset, drawOffset + drawCapacity).
+ * Must match meshlet_cull.comp MeshletCullBatch struct (16 bytes).
+ */
+struct MeshletCullBatch {
+    uint32_t drawOffset;
+    uint32_t drawCapacity;
+    uint32_t _pad0;
+    uint32_t _pad1;
+};
+static_assert(sizeof(MeshletCullBatch) == 16, "MeshletCullBatch must be 16 bytes");
+
+/**
+ * MeshletCullParams — Per-frame camera data for meshlet culling.
+ * Must match meshlet_cull.comp MeshletCullParams struct (128 bytes).
+ */
+struct MeshletCullParams {
+    float planes[6][4];       // left, right, bottom, top, near, far (Ax + By + Cz + D, normals inward)
+    float cameraPos[4];       // xyz = camera world position
+    uint32_t instanceCount;
+    uint32_t batchCount;
+    uint32_t meshletCount;
+    uint32_t _pad0;
+};
+static_assert(sizeof(MeshletCullParams) == 128, "MeshletCullParams must be 128 bytes");
+
+/**
+ * MeshletCuller — cluster-level GPU culling for the plain vertex pipeline (no mesh shaders).
+ *
+ * Runs next to GPUCuller: one workgroup per instance, threads stride over the instance's meshlets,
+ * testing the transformed bounding sphere against the frustum and the normal cone against the camera.
+ * Survivors are appended as VkDrawIndirectCommand (vertexCount, 1, firstVertex, objectIndex) into the
+ * batch's section and counted per batch, so each batch draws with one vkCmdDrawIndirectCount.
+ *
+ * Buffers (set 0):
+ *   0 Params UBO, 1 Meshlets SSBO, 2 Instances SSBO, 3 Batches SSBO,
+ *   4 Draw commands SSBO (indirect), 5 Per-batch draw counts SSBO (indirect count), 6 Visible meshlet counter (stats)
+ */
+class MeshletCuller {
+public:
+    MeshletCuller() = default;
+    ~MeshletCuller();
+
+    MeshletCuller(const MeshletCuller&) = delete;
+    MeshletCuller& operator=(const MeshletCuller&) = delete;
+
+    /**
+     * Create buffers, descriptor set and compute pipeline.
+     * @param lMaxMeshlets_ic  Capacity of the meshlet table (all meshes in use).
+     * @param lMaxInstances_ic Capacity of instance list (also max workgroups per dispatch).
+     * @param lMaxDraws_ic     Capacity of emitted draw commands across all batches.
+     * @param lMaxBatches_ic   Number of batch sections / draw counters.
+     * @param pipelineCache_ic Pipeline cache for the compute pipeline (VK_NULL_HANDLE = none).
+     * @return true on success (false leaves the culler invalid; caller falls back to per-object culling).
+     */
+    bool Create(VkDevice device, VkPhysicalDevice physicalDevice, VulkanShaderManager* pShaderManager,
+                uint32_t lMaxMeshlets_ic, uint32_t lMaxInstances_ic, uint32_t lMaxDraws_ic, uint32_t lMaxBatches_ic,
+                VkPipelineCache pipelineCache_ic = VK_NULL_HANDLE);
+
+    void Destroy();
+
+    /** Upload meshlet table (mesh-local bounds). Returns false if count exceeds capacity (nothing written). */
+    bool UploadMeshlets(const Meshlet* pMeshlets_ic, uint32_t lCount_ic);
+
+    /** Upload instances and batch sections for this frame. Counts are clamped to capacity. */
+    void UploadInstances(const MeshletCullInstance* pInstances_ic, uint32_t lCount_ic);
+    void UploadBatches(const MeshletCullBatch* pBatches_ic, uint32_t lCount_ic);
+
+    /** Update camera planes/position and active counts. Call each frame before Dispatch(). */
+    void UpdateParams(const float planes[6][4], const float* pCameraPos_ic,
+                      uint32_t lInstanceCount_ic, uint32_t lBatchCount_ic, uint32_t lMeshletCount_ic);
+
+    /** Zero per-batch draw counts and visible counter (host writes + HOST→COMPUTE barrier). */
+    void ResetCounters(VkCommandBuffer cmdBuffer);
+
+    void Dispatch(VkCommandBuffer cmdBuffer);
+
+    /** Compute writes → indirect command / count reads. */
+    void BarrierAfterDispatch(VkCommandBuffer cmdBuffer);
+
+    VkBuffer GetDrawBuffer() const { return m_drawBuffer.GetBuffer(); }
+    VkBuffer GetDrawCountBuffer() const { return m_drawCountBuffer.GetBuffer(); }
+
+    /** Visible meshlets from the last completed dispatch (call after fence wait). */
+    uint32_t ReadbackVisibleCount();
+
+    uint32_t GetMaxDraws() const { return m_lMaxDraws; }
+    uint32_t GetMaxBatches() const { return m_lMaxBatches; }
+    uint32_t GetMaxMeshlets() const { return m_lMaxMeshlets; }
+    uint32_t GetMaxInstances() const { return m_lMaxInstances; }
+
+    bool IsValid() const { return (m_device != VK_NULL_HANDLE) && m_computePipeline.IsValid(); }
+
+private:
+    bool CreateDescriptorSetLayout();
+    bool CreateDescriptorPool();
+    bool CreateDescriptorSet();
+
+    VkDevice         m_device = VK_NULL_HANDLE;
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+
+    uint32_t m_lMaxMeshlets = 0u;
+    uint32_t m_lMaxInstances = 0u;
+    uint32_t m_lMaxDraws = 0u;
+    uint32_t m_lMaxBatches = 0u;
+    uint32_t m_lCurrentInstanceCount = 0u;
+
+    VulkanComputePipeline m_computePipeline;
+
+    VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool      m_descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet       m_descriptorSet = VK_NULL_HANDLE;
+
+    GPUBuffer m_paramsBuffer;      // Binding 0: Params UBO
+    GPUBuffer m_meshletBuffer;     // Binding 1: Meshlet table
+    GPUBuffer m_instanceBuffer;    // Binding 2: Instances
+    GPUBuffer m_batchBuffer;       // Binding 3: Batch sections
+    GPUBuffer m_drawBuffer;        // Binding 4: VkDrawIndirectCommand output
+    GPUBuffer m_drawCountBuffer;   // Binding 5: Per-batch draw counts
+    GPUBuffer m_visibleCountBuffer;// Binding 6: Visible meshlet counter (stats)
+};
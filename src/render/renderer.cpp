@@ -421,25 +421,11 @@ bool Renderer::CreateDepthResources() {
         return false;
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(m_context.device, m_depthImage, &memRequirements);
-
-    uint32_t memTypeIndex = m_context.FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    if (memTypeIndex == UINT32_MAX) {
+    if (VulkanMemory::AllocateForImage(m_context.device, m_context.physicalDevice, m_depthImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                       MemoryCategory::RenderTarget, true, m_depthMemory) != VK_SUCCESS) {
         return false;
     }
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = memTypeIndex;
-
-    if (vkAllocateMemory(m_context.device, &allocInfo, nullptr, &m_depthMemory) != VK_SUCCESS) {
-        return false;
-    }
-
-    vkBindImageMemory(m_context.device, m_depthImage, m_depthMemory, 0);
-
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
     viewInfo.image = m_depthImage;
@@ -463,10 +449,7 @@ void Renderer::DestroyDepthResources() {
         vkDestroyImage(m_context.device, m_depthImage, nullptr);
         m_depthImage = VK_NULL_HANDLE;
     }
-    if (m_depthMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_context.device, m_depthMemory, nullptr);
-        m_depthMemory = VK_NULL_HANDLE;
-    }
+    VulkanMemory::Free(m_context.device, m_depthMemory);
 }
 
 bool Renderer::CreateFramebuffers() {
@@ -211,7 +211,7 @@ private:
 
     // Depth buffer
     VkImage                     m_depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory              m_depthMemory = VK_NULL_HANDLE;
+    MemoryAllocation            m_depthMemory;
     VkImageView                 m_depthImageView = VK_NULL_HANDLE;
 
     // Render pass (owned)
@@ -4,6 +4,17 @@
 #include "tiered_instance_manager.h"
 #include "batched_draw_list.h"
 #include "app/vulkan_app.h"
+#include "managers/texture_manager.h"
+#include <algorithm>
+
+namespace {
+    /** Bindless slot of a texture; unset or unregistered textures sample slot 0 (default white). */
+    uint32_t GetTextureIndex(const std::shared_ptr<TextureHandle>& pTexture) {
+        if (!pTexture || pTexture->GetBindlessIndex() == TextureHandle::kNoBindlessIndex)
+            return 0u;
+        return pTexture->GetBindlessIndex();
+    }
+}
 
 TierUpdateStats TieredInstanceManager::UpdateSSBO(
     ObjectData* pObjectData,
@@ -13,7 +24,7 @@ TierUpdateStats TieredInstanceManager::UpdateSSBO(
     const std::vector<DrawBatch>& transparentBatches,
     bool bSceneRebuilt,
     bool bForceFullUploadThisFrame,
-    const std::unordered_set<uint32_t>* pMovedObjectIds
+    std::span<const uint32_t> movedObjectIds
 ) {
     TierUpdateStats stats;
     if (!pObjectData || renderObjects.empty()) {
@@ -41,10 +52,10 @@ TierUpdateStats TieredInstanceManager::UpdateSSBO(
     }
 
     for (const auto& batch : opaqueBatches) {
-        ProcessBatch(pObjectData, maxObjects, renderObjects, batch, bFullUpload, pMovedObjectIds, stats);
+        ProcessBatch(pObjectData, maxObjects, renderObjects, batch, bFullUpload, movedObjectIds, stats);
     }
     for (const auto& batch : transparentBatches) {
-        ProcessBatch(pObjectData, maxObjects, renderObjects, batch, bFullUpload, pMovedObjectIds, stats);
+        ProcessBatch(pObjectData, maxObjects, renderObjects, batch, bFullUpload, movedObjectIds, stats);
     }
     m_lastStats = stats;
     return stats;
@@ -56,13 +67,13 @@ void TieredInstanceManager::ProcessBatch(
     const std::vector<RenderObject>& renderObjects,
     const DrawBatch& batch,
     bool bFullUpload,
-    const std::unordered_set<uint32_t>* pMovedObjectIds,
+    std::span<const uint32_t> movedObjectIds,
     TierUpdateStats& stats
 ) {
     const InstanceTier tier = batch.key.tier;
     uint32_t ssboOffset = batch.firstInstanceIndex;
-    const auto isMoved = [pMovedObjectIds](uint32_t goId) {
-        return pMovedObjectIds && pMovedObjectIds->count(goId) != 0;
+    const auto isMoved = [movedObjectIds](uint32_t goId) {
+        return !movedObjectIds.empty() && std::binary_search(movedObjectIds.begin(), movedObjectIds.end(), goId);
     };
 
     for (uint32_t objIdx : batch.objectIndices) {
@@ -100,4 +111,7 @@ void TieredInstanceManager::WriteObjectToSSBO(ObjectData& od, const RenderObject
     }
     od.matProps = glm::vec4(metallic, roughness, normalScale, occlusionStrength);
     od.baseColor = glm::vec4(ro.color[0], ro.color[1], ro.color[2], ro.color[3]);
+    od.texIndices = glm::uvec4(GetTextureIndex(ro.texture), GetTextureIndex(ro.pMetallicRoughnessTexture),
+                               GetTextureIndex(ro.pEmissiveTexture), GetTextureIndex(ro.pNormalTexture));
+    od.texIndices2 = glm::uvec4(GetTextureIndex(ro.pOcclusionTexture), 0u, 0u, 0u);
 }
@@ -27,7 +27,7 @@
 #include "scene/scene_unified.h"
 #include <glm/glm.hpp>
 #include <cstdint>
-#include <unordered_set>
+#include <span>
 #include <vector>
 
 struct DrawBatch;
@@ -81,7 +81,7 @@ public:
     /**
      * Update SSBO with object data from render list (unified Scene path).
      * @param bForceFullUploadThisFrame If true, upload all tiers this frame.
-     * @param pMovedObjectIds If non-null (e.g. in editor), also upload Static/SemiStatic/Procedural objects whose gameObjectId is in this set, so only moved objects are re-uploaded.
+     * @param movedObjectIds Sorted gameObjectIds (e.g. gizmo moves in the editor): Static/SemiStatic/Procedural objects in it are also uploaded, so only moved objects are re-uploaded.
      */
     TierUpdateStats UpdateSSBO(
         ObjectData* pObjectData,
@@ -91,7 +91,7 @@ public:
         const std::vector<DrawBatch>& transparentBatches,
         bool bSceneRebuilt,
         bool bForceFullUploadThisFrame = false,
-        const std::unordered_set<uint32_t>* pMovedObjectIds = nullptr
+        std::span<const uint32_t> movedObjectIds = {}
     );
     
     /**
@@ -113,7 +113,7 @@ private:
         const std::vector<RenderObject>& renderObjects,
         const DrawBatch& batch,
         bool bFullUpload,
-        const std::unordered_set<uint32_t>* pMovedObjectIds,
+        std::span<const uint32_t> movedObjectIds,
         TierUpdateStats& stats
     );
     
@@ -176,7 +176,7 @@ void ViewportManager::ResizeViewport(uint32_t id, uint32_t width, uint32_t heigh
     }
 }
 
-void ViewportManager::BeginViewportRender(uint32_t id, VkCommandBuffer cmd) {
+void ViewportManager::BeginViewportRender(uint32_t id, VkCommandBuffer cmd, VkSubpassContents contents) {
     Viewport* pViewport = GetViewport(id);
     if (!pViewport) {
         return;
@@ -207,7 +207,10 @@ void ViewportManager::BeginViewportRender(uint32_t id, VkCommandBuffer cmd) {
     renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassInfo.pClearValues = clearValues.data();
     
-    vkCmdBeginRenderPass(cmd, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(cmd, &renderPassInfo, contents);
+    if (contents != VK_SUBPASS_CONTENTS_INLINE) {
+        return;
+    }
     
     // Set viewport and scissor
     VkViewport vkViewport{};
@@ -353,20 +356,11 @@ void ViewportManager::CreateRenderTarget(ViewportRenderTarget& target, uint32_t
         throw std::runtime_error("Failed to create viewport color image");
     }
     
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(m_device, target.colorImage, &memRequirements);
-    
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = VulkanUtils::FindMemoryType(m_physicalDevice, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    if (vkAllocateMemory(m_device, &allocInfo, nullptr, &target.colorMemory) != VK_SUCCESS) {
+    if (VulkanMemory::AllocateForImage(m_device, m_physicalDevice, target.colorImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                       MemoryCategory::RenderTarget, true, target.colorMemory) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate viewport color memory");
     }
     
-    vkBindImageMemory(m_device, target.colorImage, target.colorMemory, 0);
-    
     // Create color image view
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -391,16 +385,11 @@ void ViewportManager::CreateRenderTarget(ViewportRenderTarget& target, uint32_t
         throw std::runtime_error("Failed to create viewport depth image");
     }
     
-    vkGetImageMemoryRequirements(m_device, target.depthImage, &memRequirements);
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = VulkanUtils::FindMemoryType(m_physicalDevice, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    
-    if (vkAllocateMemory(m_device, &allocInfo, nullptr, &target.depthMemory) != VK_SUCCESS) {
+    if (VulkanMemory::AllocateForImage(m_device, m_physicalDevice, target.depthImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                       MemoryCategory::RenderTarget, true, target.depthMemory) != VK_SUCCESS) {
         throw std::runtime_error("Failed to allocate viewport depth memory");
     }
     
-    vkBindImageMemory(m_device, target.depthImage, target.depthMemory, 0);
-    
     // Create depth image view
     viewInfo.image = target.depthImage;
     viewInfo.format = m_depthFormat;
@@ -489,10 +478,7 @@ void ViewportManager::DestroyRenderTarget(ViewportRenderTarget& target) {
         target.depthImage = VK_NULL_HANDLE;
     }
     
-    if (target.depthMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_device, target.depthMemory, nullptr);
-        target.depthMemory = VK_NULL_HANDLE;
-    }
+    VulkanMemory::Free(m_device, target.depthMemory);
     
     if (target.colorView != VK_NULL_HANDLE) {
         vkDestroyImageView(m_device, target.colorView, nullptr);
@@ -504,10 +490,7 @@ void ViewportManager::DestroyRenderTarget(ViewportRenderTarget& target) {
         target.colorImage = VK_NULL_HANDLE;
     }
     
-    if (target.colorMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(m_device, target.colorMemory, nullptr);
-        target.colorMemory = VK_NULL_HANDLE;
-    }
+    VulkanMemory::Free(m_device, target.colorMemory);
     
     target.width = 0;
     target.height = 0;
@@ -6,6 +6,7 @@
 
 #include "viewport_config.h"
 #include "../camera/camera.h"
+#include "vulkan_memory.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -20,10 +21,10 @@ struct VulkanConfig;
 struct ViewportRenderTarget {
     /** Vulkan resources. */
     VkImage colorImage = VK_NULL_HANDLE;
-    VkDeviceMemory colorMemory = VK_NULL_HANDLE;
+    MemoryAllocation colorMemory;  // Dedicated
     VkImageView colorView = VK_NULL_HANDLE;
     VkImage depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory depthMemory = VK_NULL_HANDLE;
+    MemoryAllocation depthMemory;  // Dedicated
     VkImageView depthView = VK_NULL_HANDLE;
     VkFramebuffer framebuffer = VK_NULL_HANDLE;
     VkSampler sampler = VK_NULL_HANDLE;
@@ -102,8 +103,9 @@ public:
     /** Resize a viewport's render target. */
     void ResizeViewport(uint32_t id, uint32_t width, uint32_t height);
     
-    /** Begin rendering to a viewport. Returns command buffer to use. */
-    void BeginViewportRender(uint32_t id, VkCommandBuffer cmd);
+    /** Begin rendering to a viewport. With VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS only the render pass is begun
+     *  (the executed secondaries set viewport and scissor). */
+    void BeginViewportRender(uint32_t id, VkCommandBuffer cmd, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
     
     /** End rendering to a viewport. */
     void EndViewportRender(uint32_t id, VkCommandBuffer cmd);
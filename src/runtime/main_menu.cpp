@@ -6,6 +6,7 @@
 
 #include <imgui.h>
 #include <algorithm>
+#include <cstdio>
 
 void MainMenu::Init(
     SDL_Window* pWindow,
@@ -81,6 +82,9 @@ void MainMenu::DrawMainPage() {
         ImGui::SetCursorPosX((viewport->WorkSize.x - subtitleSize.x) * 0.5f);
         ImGui::TextDisabled("%s", subtitle);
         
+        // Progressive level load still streaming in behind the menu
+        DrawLoadProgress(viewport->WorkSize.x);
+        
         // Menu buttons - centered
         ImGui::Spacing();
         ImGui::Spacing();
@@ -265,6 +269,21 @@ void MainMenu::DrawLevelSelectPage() {
     ImGui::End();
 }
 
+void MainMenu::DrawLoadProgress(float windowWidth) {
+    if (!m_pLevelSelector) return;
+    const LevelLoadProgress& progress = m_pLevelSelector->GetLoadProgress();
+    if (!progress.isLoading) return;
+    
+    const float barWidth = 250.0f;
+    char overlay[64];
+    if (progress.resolvedInstances < progress.totalInstances || progress.pipelinesReady >= progress.pipelinesTotal)
+        std::snprintf(overlay, sizeof(overlay), "Loading %u/%u", progress.resolvedInstances, progress.totalInstances);
+    else
+        std::snprintf(overlay, sizeof(overlay), "Compiling pipelines %u/%u", progress.pipelinesReady, progress.pipelinesTotal);
+    ImGui::SetCursorPosX((windowWidth - barWidth) * 0.5f);
+    ImGui::ProgressBar(progress.fraction, ImVec2(barWidth, 0.0f), overlay);
+}
+
 void MainMenu::DrawLevelCard(const LevelInfo& level, int index, bool isSelected) {
     const float cardWidth = ImGui::GetContentRegionAvail().x - 10.0f;
     const float cardHeight = 60.0f;
@@ -117,6 +117,8 @@ private:
     void DrawLevelSelectPage();
     void DrawSettingsPage(VulkanConfig* pConfig);
     void DrawLevelCard(const LevelInfo& level, int index, bool isSelected);
+    /** Progress bar of a progressive level load (no-op when idle). */
+    void DrawLoadProgress(float windowWidth);
 
     bool m_bVisible = true;
     MainMenuState m_state = MainMenuState::Main;
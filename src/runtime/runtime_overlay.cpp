@@ -7,6 +7,7 @@
 
 #include <imgui.h>
 #include <algorithm>
+#include <cstdio>
 
 void RuntimeOverlay::Init(
     SDL_Window* pWindow,
@@ -177,6 +178,53 @@ void RuntimeOverlay::DrawStatsWindow(const Camera* pCamera, const VulkanConfig*
             }
         }
         
+        // Meshlet culling statistics
+        if (m_renderStats.meshletCullerActive && m_renderStats.meshletsSubmitted > 0) {
+            ImGui::Text("Meshlets: %u / %u", m_renderStats.meshletsVisible, m_renderStats.meshletsSubmitted);
+        }
+        
+        // CPU frame graph
+        if (m_renderStats.cpuPrepMs > 0.f) {
+            ImGui::Text("CPU prep: %.2f ms (%.2f ms serial, %u workers)", m_renderStats.cpuPrepMs,
+                        m_renderStats.cpuPrepSerialMs, m_renderStats.cpuWorkers);
+        }
+        
+        // Command recording per thread
+        if (m_renderStats.recordSecondaries > 0) {
+            ImGui::Text("Cmd record: %u secondaries, main %.3f ms", m_renderStats.recordSecondaries, m_renderStats.recordMainMs);
+            for (uint32_t i = 0; i < m_renderStats.recordWorkers; ++i) {
+                if (m_renderStats.recordWorkerMs[i] > 0.f) {
+                    ImGui::Text("  worker %u: %.3f ms", i, m_renderStats.recordWorkerMs[i]);
+                }
+            }
+        }
+        
+        // Per-frame memory
+        if (m_renderStats.heapCounted) {
+            ImGui::Text("Heap allocs/frame: %u (frame arena %.1f KB)", m_renderStats.heapAllocsPerFrame, m_renderStats.frameArenaKB);
+        }
+        
+        // Device memory
+        if (m_renderStats.gpuMemBlocks > 0 || m_renderStats.gpuMemDedicated > 0) {
+            ImGui::Text("GPU mem: %.1f / %.1f MB in %u blocks (frag %.0f%%)", m_renderStats.gpuMemUsedMB,
+                        m_renderStats.gpuMemBlockMB, m_renderStats.gpuMemBlocks, m_renderStats.gpuMemFragmentation * 100.0f);
+            ImGui::Text("  dedicated: %u, %.1f MB", m_renderStats.gpuMemDedicated, m_renderStats.gpuMemDedicatedMB);
+            ImGui::Text("  buf %.1f  mesh %.1f  tex %.1f  rt %.1f  stg %.1f MB", m_renderStats.gpuMemCategoryMB[0],
+                        m_renderStats.gpuMemCategoryMB[1], m_renderStats.gpuMemCategoryMB[2],
+                        m_renderStats.gpuMemCategoryMB[3], m_renderStats.gpuMemCategoryMB[4]);
+            ImGui::Text("VRAM heap: %.0f / %.0f MB%s", m_renderStats.gpuHeapUsageMB, m_renderStats.gpuHeapBudgetMB,
+                        m_renderStats.gpuHeapDriverBudget ? "" : " (est.)");
+        }
+        
+        // Texture streaming residency
+        if (m_renderStats.texturesStreamed > 0) {
+            ImGui::Text("Textures: %u streamed, %u full res", m_renderStats.texturesStreamed, m_renderStats.texturesFullyResident);
+            ImGui::Text("Tex VRAM: %.1f / %.1f MB (wants %.1f)", m_renderStats.textureResidentMB,
+                        m_renderStats.textureBudgetMB, m_renderStats.textureWantedMB);
+            if (m_renderStats.textureStreamChanges > 0)
+                ImGui::Text("Tex streaming: %u changes", m_renderStats.textureStreamChanges);
+        }
+        
         // Camera info (if available)
         if (pCamera) {
             ImGui::Separator();
@@ -230,6 +278,15 @@ void RuntimeOverlay::DrawLevelSelector() {
             ImGui::TextDisabled("Current: %s", currentPath.c_str());
         }
         
+        // Progressive load: placeholders are being replaced as the level streams in
+        const LevelLoadProgress& progress = m_pLevelSelector->GetLoadProgress();
+        if (progress.isLoading) {
+            char overlay[96];
+            std::snprintf(overlay, sizeof(overlay), "%u/%u instances, %u files, %u/%u pipelines", progress.resolvedInstances,
+                          progress.totalInstances, progress.pendingSources, progress.pipelinesReady, progress.pipelinesTotal);
+            ImGui::ProgressBar(progress.fraction, ImVec2(200.0f, 0.0f), overlay);
+        }
+        
         // Level combo box
         int selectedIdx = m_pLevelSelector->GetSelectedIndex();
         const char* previewName = (selectedIdx >= 0 && selectedIdx < static_cast<int>(levels.size())) 
@@ -39,6 +39,48 @@ struct RenderStats {
     bool     gpuCullerActive  = false;  // Whether GPU culler is running
     bool     gpuCpuMismatch   = false;  // GPU visible != CPU visible counts
     
+    // Meshlet culling statistics (cluster-level, from meshlet_cull.comp)
+    bool     meshletCullerActive = false;
+    uint32_t meshletsVisible     = 0;   // Meshlets drawn after frustum + cone culling
+    uint32_t meshletsSubmitted   = 0;   // Meshlet instances submitted (objects x meshlets)
+    
+    // Texture streaming statistics (TextureManager residency)
+    uint32_t texturesStreamed      = 0;    // Textures managed by the streamer
+    uint32_t texturesFullyResident = 0;    // Of those, with mip 0 resident
+    float    textureResidentMB     = 0.f;  // Resident bytes of streamed textures
+    float    textureWantedMB       = 0.f;  // Bytes if every requested level were resident
+    float    textureBudgetMB       = 0.f;
+    uint32_t textureStreamChanges  = 0;    // Upgrades + evictions this frame
+    
+    // CPU frame graph (render prep stages run in parallel on the task scheduler)
+    float    cpuPrepMs       = 0.f;  // Wall time of the frame graph
+    float    cpuPrepSerialMs = 0.f;  // Sum of its stage times
+    uint32_t cpuWorkers      = 0;
+    
+    // Command recording (secondary command buffers recorded in parallel)
+    static constexpr uint32_t kMaxRecordWorkers = 16;
+    float    recordMainMs      = 0.f;  // Main thread (UI and its share of the scene ranges)
+    float    recordWorkerMs[kMaxRecordWorkers] = {};  // Per scheduler worker
+    uint32_t recordWorkers     = 0;
+    uint32_t recordSecondaries = 0;
+    
+    // Per-frame memory (heap count needs ENGINE_COUNT_ALLOCATIONS; steady state should be 0)
+    bool     heapCounted        = false;
+    uint32_t heapAllocsPerFrame = 0;    // operator new calls during the last frame
+    float    frameArenaKB       = 0.f;  // Frame arena bytes used this frame
+    
+    // Device memory (DeviceMemoryAllocator)
+    uint32_t gpuMemBlocks        = 0;
+    uint32_t gpuMemDedicated     = 0;    // Dedicated allocations (render targets, large resources)
+    float    gpuMemBlockMB       = 0.f;  // Size of all blocks
+    float    gpuMemUsedMB        = 0.f;  // Sub-allocated from blocks
+    float    gpuMemDedicatedMB   = 0.f;
+    float    gpuMemFragmentation = 0.f;  // 0..1, see DeviceMemoryStats::fFragmentation
+    float    gpuMemCategoryMB[5] = {};   // Buffer, Mesh, Texture, RenderTarget, Staging
+    float    gpuHeapUsageMB      = 0.f;  // First device-local heap
+    float    gpuHeapBudgetMB     = 0.f;
+    bool     gpuHeapDriverBudget = false;
+    
     // Instance tier statistics
     uint32_t instancesStatic     = 0;  // Tier 0: GPU-resident, never moves
     uint32_t instancesSemiStatic = 0;  // Tier 1: Dirty flag updates
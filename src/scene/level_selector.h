@@ -22,6 +22,22 @@ struct LevelInfo {
     int specialId = 0;          // For special levels: stress test preset ID (1-4)
 };
 
+/**
+ * Progress of a progressive (async) level load. Filled by SceneManager, VulkanApp adds the level's pipeline
+ * prewarm (a load is not done until its pipelines are built); shown by MainMenu / RuntimeOverlay.
+ */
+struct LevelLoadProgress {
+    bool isLoading = false;
+    std::string levelPath;
+    uint32_t totalInstances = 0;     // glTF instances that started as placeholders
+    uint32_t resolvedInstances = 0;  // Instances whose meshes/textures are resident
+    uint32_t totalSources = 0;       // Distinct glTF files of the level
+    uint32_t pendingSources = 0;     // glTF files still being parsed/extracted on workers
+    uint32_t pipelinesTotal = 0;     // Pipelines prewarmed for the level's materials
+    uint32_t pipelinesReady = 0;
+    float fraction = 1.0f;           // 0..1 over sources parsed + instances resolved + pipelines built
+};
+
 /**
  * LevelSelector - Discovers levels and tracks selection.
  */
@@ -81,6 +97,12 @@ public:
     StressTestParams& GetCustomParams() { return m_customParams; }
     const StressTestParams& GetCustomParams() const { return m_customParams; }
     
+    /**
+     * Progress of the level currently streaming in (isLoading = false when idle). Updated once per frame by the app.
+     */
+    void SetLoadProgress(const LevelLoadProgress& progress) { m_loadProgress = progress; }
+    const LevelLoadProgress& GetLoadProgress() const { return m_loadProgress; }
+    
 private:
     void AddSpecialLevels();
     
@@ -89,4 +111,5 @@ private:
     bool m_loadRequested = false;
     std::string m_currentLevelPath;
     StressTestParams m_customParams;  // Custom stress test parameters
+    LevelLoadProgress m_loadProgress;
 };
@@ -9,6 +9,7 @@
 #include "core/transform.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <functional>
 #include <glm/glm.hpp>
@@ -20,6 +21,7 @@ void Scene::Clear() {
     m_gameObjects.clear();
     m_idToIndex.clear();
     m_nextId = 1;
+    m_nameBatches.clear();
     m_transforms.clear();
     m_renderers.clear();
     m_lights.clear();
@@ -63,6 +65,33 @@ void Scene::AddObject(const Object& obj) {
     AddRenderer(goId, r);
 }
 
+void Scene::Reserve(size_t additionalGameObjects, size_t additionalRenderers) {
+    const size_t objectCount = m_gameObjects.size() + additionalGameObjects;
+    const size_t rendererCount = m_renderers.size() + additionalRenderers;
+    m_gameObjects.reserve(objectCount);
+    m_idToIndex.reserve(objectCount);
+    m_transforms.reserve(objectCount);
+    m_transformMap.reserve(objectCount);
+    m_renderers.reserve(rendererCount);
+    m_rendererMap.reserve(rendererCount);
+}
+
+void Scene::BeginBulkEdit() {
+    ++m_bulkEditDepth;
+}
+
+void Scene::EndBulkEdit() {
+    if (m_bulkEditDepth == 0 || --m_bulkEditDepth > 0) {
+        return;
+    }
+    if (m_bulkChangePending) {
+        m_bulkChangePending = false;
+        if (m_onChangeCallback) {
+            m_onChangeCallback();
+        }
+    }
+}
+
 /* ======== GameObject Management ======== */
 
 uint32_t Scene::CreateGameObject(const std::string& name) {
@@ -81,6 +110,57 @@ uint32_t Scene::CreateGameObject(const std::string& name) {
     return id;
 }
 
+SpawnRange Scene::CreateGameObjects(uint32_t count, const GameObjectArchetype& archetype) {
+    SpawnRange range;
+    if (count == 0) {
+        return range;
+    }
+
+    const size_t firstObject = m_gameObjects.size();
+    const size_t firstTransform = m_transforms.size();
+    const size_t firstRenderer = m_renderers.size();
+    Reserve(count, archetype.bHasRenderer ? count : 0);
+
+    range.firstId = m_nextId;
+    range.count = count;
+    range.firstTransform = static_cast<uint32_t>(firstTransform);
+    if (archetype.bHasRenderer) {
+        range.firstRenderer = static_cast<uint32_t>(firstRenderer);
+    }
+    m_nextId += count;
+
+    // Pools are filled by copy; only the index bookkeeping is per object
+    m_gameObjects.resize(firstObject + count);
+    m_transforms.resize(firstTransform + count, archetype.transform);
+    if (archetype.bHasRenderer) {
+        m_renderers.resize(firstRenderer + count, archetype.renderer);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t id = range.firstId + i;
+        GameObject& go = m_gameObjects[firstObject + i];
+        go.id = id;
+        go.transformIndex = range.firstTransform + i;
+        m_idToIndex.emplace(id, firstObject + i);
+        m_transformMap.emplace(id, go.transformIndex);
+        if (archetype.bHasRenderer) {
+            go.rendererIndex = range.firstRenderer + i;
+            m_rendererMap.emplace(id, go.rendererIndex);
+        }
+    }
+
+    // Names are generated from the batch when asked for (GetGameObjectName)
+    if (!archetype.namePrefix.empty()) {
+        m_nameBatches.push_back({range.firstId, count, archetype.namePrefix});
+    }
+
+    MarkDirty(SceneDirtyFlags::Structure | SceneDirtyFlags::Transforms);
+    if (archetype.bHasRenderer) {
+        MarkDirty(SceneDirtyFlags::Renderers);
+    }
+    NotifyChange();
+    return range;
+}
+
 bool Scene::DestroyGameObject(uint32_t id) {
     auto it = m_idToIndex.find(id);
     if (it == m_idToIndex.end()) {
@@ -128,23 +208,50 @@ const GameObject* Scene::FindGameObject(uint32_t id) const {
 }
 
 GameObject* Scene::FindGameObjectByName(const std::string& name) {
-    for (auto& go : m_gameObjects) {
-        if (go.name == name) {
-            return &go;
-        }
-    }
-    return nullptr;
+    const GameObject* go = static_cast<const Scene*>(this)->FindGameObjectByName(name);
+    return const_cast<GameObject*>(go);
 }
 
 const GameObject* Scene::FindGameObjectByName(const std::string& name) const {
+    char buf[128];
     for (const auto& go : m_gameObjects) {
-        if (go.name == name) {
+        if (!go.name.empty() ? (go.name == name) : (name == GetGameObjectName(go, buf, sizeof(buf)))) {
             return &go;
         }
     }
     return nullptr;
 }
 
+const Scene::NameBatch* Scene::FindNameBatch(uint32_t id) const {
+    auto it = std::upper_bound(m_nameBatches.begin(), m_nameBatches.end(), id,
+        [](uint32_t value, const NameBatch& batch) { return value < batch.firstId; });
+    if (it == m_nameBatches.begin()) {
+        return nullptr;
+    }
+    --it;
+    return (id - it->firstId < it->count) ? &*it : nullptr;
+}
+
+std::string Scene::GetGameObjectName(const GameObject& go) const {
+    if (!go.name.empty()) {
+        return go.name;
+    }
+    char buf[128];
+    return GetGameObjectName(go, buf, sizeof(buf));
+}
+
+const char* Scene::GetGameObjectName(const GameObject& go, char* buf, size_t bufSize) const {
+    if (!go.name.empty()) {
+        return go.name.c_str();
+    }
+    if (const NameBatch* batch = FindNameBatch(go.id)) {
+        std::snprintf(buf, bufSize, "%s_%u", batch->prefix.c_str(), go.id - batch->firstId);
+    } else {
+        std::snprintf(buf, bufSize, "GameObject_%u", go.id);
+    }
+    return buf;
+}
+
 /* ======== Component Add/Remove ======== */
 
 uint32_t Scene::AddTransform(uint32_t gameObjectId, const Transform& transform) {
@@ -220,6 +327,23 @@ uint32_t Scene::AddCamera(uint32_t gameObjectId, const CameraComponent& camera)
     return componentIndex;
 }
 
+bool Scene::RemoveRenderer(uint32_t gameObjectId) {
+    auto it = m_rendererMap.find(gameObjectId);
+    if (it == m_rendererMap.end()) {
+        return false;
+    }
+    
+    // Pool slot is left orphaned (same as DestroyGameObject); only the mapping is dropped
+    m_rendererMap.erase(it);
+    if (auto* go = FindGameObject(gameObjectId)) {
+        go->rendererIndex = INVALID_COMPONENT_INDEX;
+    }
+    
+    MarkDirty(SceneDirtyFlags::Renderers);
+    NotifyChange();
+    return true;
+}
+
 Transform* Scene::GetTransform(uint32_t gameObjectId) {
     auto it = m_transformMap.find(gameObjectId);
     if (it == m_transformMap.end() || it->second >= m_transforms.size()) {
@@ -308,21 +432,31 @@ void Scene::UpdateTransformHierarchy() {
     for (auto& transform : m_transforms) {
         TransformBuildModelMatrix(transform);
     }
-    std::vector<uint32_t> roots = GetRootObjects();
-    std::function<void(uint32_t, const float*)> updateRecursive =
-        [this, &updateRecursive](uint32_t goId, const float* parentWorld) {
-            Transform* pTransform = GetTransform(goId);
-            if (!pTransform) return;
-            TransformComputeWorldMatrix(*pTransform, parentWorld);
-            const GameObject* pGO = FindGameObject(goId);
-            if (pGO) {
-                for (uint32_t childId : pGO->children) {
-                    updateRecursive(childId, pTransform->worldMatrix);
-                }
+    /* Depth-first with an explicit stack on the thread's scratch arena (runs every frame: no heap allocation).
+       Parents are always processed before their children. */
+    struct PendingNode {
+        uint32_t     goId;
+        const float* parentWorld;
+    };
+    ScratchScope scratch;
+    ArenaVector<PendingNode> stack(scratch.GetAllocator<PendingNode>());
+    stack.reserve(m_gameObjects.size());
+    for (const auto& go : m_gameObjects) {
+        const Transform* p = GetTransform(go.id);
+        if (p && p->parentId == NO_PARENT) stack.push_back({go.id, nullptr});
+    }
+    while (!stack.empty()) {
+        const PendingNode node = stack.back();
+        stack.pop_back();
+        Transform* pTransform = GetTransform(node.goId);
+        if (!pTransform) continue;
+        TransformComputeWorldMatrix(*pTransform, node.parentWorld);
+        const GameObject* pGO = FindGameObject(node.goId);
+        if (pGO) {
+            for (uint32_t childId : pGO->children) {
+                stack.push_back({childId, pTransform->worldMatrix});
             }
-        };
-    for (uint32_t rootId : roots) {
-        updateRecursive(rootId, nullptr);
+        }
     }
     ClearDirty(SceneDirtyFlags::Transforms);
 }
@@ -397,6 +531,14 @@ std::vector<uint32_t> Scene::GetRootObjects() const {
     return roots;
 }
 
+void Scene::GetRootObjects(ArenaVector<uint32_t>& outRoots) const {
+    outRoots.clear();
+    for (const auto& go : m_gameObjects) {
+        const Transform* p = GetTransform(go.id);
+        if (p && p->parentId == NO_PARENT) outRoots.push_back(go.id);
+    }
+}
+
 const std::vector<uint32_t>* Scene::GetChildren(uint32_t gameObjectId) const {
     const GameObject* pGO = FindGameObject(gameObjectId);
     return pGO ? &pGO->children : nullptr;
@@ -482,7 +624,16 @@ std::vector<RenderObject> Scene::BuildRenderList(const float* viewProj,
                                                    bool frustumCull,
                                                    uint32_t* outCulledCount) const {
     std::vector<RenderObject> result;
-    result.reserve(m_renderers.size());
+    BuildRenderList(result, viewProj, frustumCull, outCulledCount);
+    return result;
+}
+
+void Scene::BuildRenderList(std::vector<RenderObject>& outResult,
+                            const float* viewProj,
+                            bool frustumCull,
+                            uint32_t* outCulledCount) const {
+    outResult.clear();
+    outResult.reserve(m_renderers.size());
     
     uint32_t culledCount = 0;
     
@@ -566,14 +717,12 @@ std::vector<RenderObject> Scene::BuildRenderList(const float* viewProj,
             }
         }
         
-        result.push_back(std::move(ro));
+        outResult.push_back(std::move(ro));
     }
     
     if (outCulledCount != nullptr) {
         *outCulledCount = culledCount;
     }
-    
-    return result;
 }
 
 uint32_t Scene::GetRenderableCount() const {
@@ -22,6 +22,7 @@
 #include "camera_component.h"
 #include "component.h"
 #include "gameobject.h"
+#include "core/frame_arena.h"
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -106,6 +107,31 @@ inline bool HasFlag(SceneDirtyFlags flags, SceneDirtyFlags flag) {
  */
 using SceneChangeCallback = std::function<void()>;
 
+/**
+ * GameObjectArchetype — Template for Scene::CreateGameObjects. Every spawned object starts
+ * with a copy of the transform (and renderer, if bHasRenderer); callers then fill per-object
+ * values through the returned SpawnRange.
+ */
+struct GameObjectArchetype {
+    Transform transform;
+    bool bHasRenderer = false;
+    RendererComponent renderer;
+    /** Objects are named "<namePrefix>_<n>" (n = index in the batch), generated on demand. Empty = "GameObject_<id>". */
+    std::string namePrefix;
+};
+
+/**
+ * SpawnRange — Result of Scene::CreateGameObjects. IDs and pool indices are contiguous:
+ * object i has ID firstId + i, transform GetTransforms()[firstTransform + i] and
+ * renderer GetRenderers()[firstRenderer + i].
+ */
+struct SpawnRange {
+    uint32_t firstId        = 0;
+    uint32_t count          = 0;
+    uint32_t firstTransform = INVALID_COMPONENT_INDEX;
+    uint32_t firstRenderer  = INVALID_COMPONENT_INDEX;  // INVALID_COMPONENT_INDEX if the archetype has no renderer
+};
+
 /**
  * Scene — Unified ECS scene container.
  *
@@ -145,6 +171,16 @@ public:
     /** Add a renderable from Object (e.g. stress test generator). Converts to GameObject + Transform + Renderer. */
     void AddObject(const Object& obj);
 
+    /** Reserve pool and map capacity for that many more GameObjects (and renderers) before a large load. */
+    void Reserve(size_t additionalGameObjects, size_t additionalRenderers);
+
+    /**
+     * Defer change notifications: changes made between BeginBulkEdit and the outermost
+     * EndBulkEdit fire the change callback once, at EndBulkEdit. Calls nest.
+     */
+    void BeginBulkEdit();
+    void EndBulkEdit();
+
     /* ======== GameObject Management ======== */
 
     /**
@@ -154,6 +190,13 @@ public:
      */
     uint32_t CreateGameObject(const std::string& name = "");
 
+    /**
+     * Create count GameObjects from an archetype in one step: pools and maps are reserved up
+     * front, names are not built (see GetGameObjectName) and the change callback fires once.
+     * @return Contiguous ID / component ranges of the new objects
+     */
+    SpawnRange CreateGameObjects(uint32_t count, const GameObjectArchetype& archetype);
+
     /**
      * Destroy a GameObject and all its components.
      * @param id GameObject ID
@@ -175,6 +218,14 @@ public:
     GameObject* FindGameObjectByName(const std::string& name);
     const GameObject* FindGameObjectByName(const std::string& name) const;
 
+    /**
+     * Display name of a GameObject: its name, or the name generated from its spawn batch
+     * (CreateGameObjects) when it has none.
+     */
+    std::string GetGameObjectName(const GameObject& go) const;
+    /** Same without allocating: returns go.name, or formats the generated name into buf. */
+    const char* GetGameObjectName(const GameObject& go, char* buf, size_t bufSize) const;
+
     /**
      * Get all GameObjects (read-only).
      */
@@ -222,6 +273,9 @@ public:
     /** Add a CameraComponent to a GameObject. Returns component index. */
     uint32_t AddCamera(uint32_t gameObjectId, const CameraComponent& camera);
 
+    /** Remove the RendererComponent of a GameObject (it stays, e.g. as a hierarchy root). Returns false if it had none. */
+    bool RemoveRenderer(uint32_t gameObjectId);
+
     /** Get Transform for a GameObject. Returns nullptr if not found. */
     Transform* GetTransform(uint32_t gameObjectId);
     const Transform* GetTransform(uint32_t gameObjectId) const;
@@ -254,6 +308,8 @@ public:
 
     /** Get root GameObjects (no parent). */
     std::vector<uint32_t> GetRootObjects() const;
+    /** Same, into an arena vector (per-frame callers: no heap allocation). */
+    void GetRootObjects(ArenaVector<uint32_t>& outRoots) const;
 
     /** Get children of a GameObject. Returns nullptr if not found. */
     const std::vector<uint32_t>* GetChildren(uint32_t gameObjectId) const;
@@ -276,6 +332,11 @@ public:
     std::vector<RenderObject> BuildRenderList(const float* viewProj = nullptr,
                                                bool frustumCull = true,
                                                uint32_t* outCulledCount = nullptr) const;
+    /** Same, into outResult (cleared first; its capacity is reused across rebuilds). */
+    void BuildRenderList(std::vector<RenderObject>& outResult,
+                         const float* viewProj = nullptr,
+                         bool frustumCull = true,
+                         uint32_t* outCulledCount = nullptr) const;
 
     /**
      * Get count of renderable objects (GameObjects with RendererComponent).
@@ -319,11 +380,23 @@ public:
 private:
     void NotifyChange() {
         ++m_version;
+        if (m_bulkEditDepth > 0) {
+            m_bulkChangePending = true;
+            return;
+        }
         if (m_onChangeCallback) {
             m_onChangeCallback();
         }
     }
 
+    /** Spawn batch whose objects have no stored name (see GetGameObjectName). */
+    struct NameBatch {
+        uint32_t firstId = 0;
+        uint32_t count = 0;
+        std::string prefix;
+    };
+    const NameBatch* FindNameBatch(uint32_t id) const;
+
     // Scene properties
     std::string m_name;
 
@@ -331,6 +404,7 @@ private:
     std::vector<GameObject> m_gameObjects;
     std::unordered_map<uint32_t, size_t> m_idToIndex;
     uint32_t m_nextId = 1;
+    std::vector<NameBatch> m_nameBatches;  // Ascending firstId (IDs are never reused until Clear)
 
     // Component pools (Structure of Arrays)
     std::vector<Transform>          m_transforms;
@@ -347,6 +421,8 @@ private:
     // Dirty tracking
     SceneDirtyFlags m_dirtyFlags = SceneDirtyFlags::None;
     uint32_t m_version = 0;
+    uint32_t m_bulkEditDepth = 0;
+    bool m_bulkChangePending = false;
 
     // Change callback
     SceneChangeCallback m_onChangeCallback;
@@ -6,6 +6,7 @@
 #include "object.h"
 #include "managers/mesh_manager.h"
 #include "managers/material_manager.h"
+#include <algorithm>
 #include <cmath>
 #include <random>
 
@@ -84,6 +85,7 @@ uint32_t GenerateStressTestScene(
     
     uint32_t totalCount = GetStressTestObjectCount(params);
     uint32_t created = 0;
+    bool cancelled = false;
     
     // Use cube mesh for all stress test objects
     auto cubeMesh = pMeshManager->GetOrCreateProcedural("cube");
@@ -94,15 +96,25 @@ uint32_t GenerateStressTestScene(
     // Lambda to create objects of a specific tier
     // Each tier gets its own RNG offset so different tiers don't overlap spatially
     auto createObjects = [&](uint32_t count, InstanceTier tier, const char* namePrefix, uint32_t tierSeedOffset) {
+        if (cancelled) return;
         FastRandom tierRng(params.seed + tierSeedOffset);  // Unique RNG per tier
         
-        for (uint32_t i = 0; i < count && created < totalCount; ++i) {
-            Object obj;
-            obj.name = std::string(namePrefix) + "_" + std::to_string(i);
-            obj.instanceTier = tier;
-            
-            obj.pMesh = cubeMesh;
-            obj.pMaterial = defaultMaterial;
+        // One bulk spawn per tier (names generated on demand, one change notification);
+        // per-object values are then written straight into the pools
+        GameObjectArchetype archetype;
+        archetype.bHasRenderer = true;
+        archetype.renderer.mesh = cubeMesh;
+        archetype.renderer.material = defaultMaterial;
+        archetype.renderer.matProps.metallic = 1.0f;  // Object default
+        archetype.renderer.instanceTier = static_cast<uint8_t>(tier);
+        archetype.namePrefix = namePrefix;
+        const SpawnRange range = scene.CreateGameObjects(std::min(count, totalCount - created), archetype);
+        std::vector<Transform>& transforms = scene.GetTransforms();
+        std::vector<RendererComponent>& renderers = scene.GetRenderers();
+        
+        for (uint32_t i = 0; i < range.count; ++i) {
+            Transform& transform = transforms[range.firstTransform + i];
+            float* color = renderers[range.firstRenderer + i].matProps.baseColor;
             
             // Random position (using tier-specific RNG)
             float px, py, pz;
@@ -120,25 +132,20 @@ uint32_t GenerateStressTestScene(
             
             // Random color
             if (params.randomColors) {
-                RandomColor(tierRng, obj.color);
+                RandomColor(tierRng, color);
             } else {
-                obj.color[0] = obj.color[1] = obj.color[2] = obj.color[3] = 1.0f;
+                color[0] = color[1] = color[2] = color[3] = 1.0f;
             }
             
-            // Build local transform matrix using helper
-            ObjectSetFromPositionRotationScale(obj.localTransform,
-                px, py, pz,
-                qx, qy, qz, qw,
-                scale, scale, scale);
-            
-            scene.AddObject(std::move(obj));
+            transform.position[0] = px; transform.position[1] = py; transform.position[2] = pz;
+            transform.rotation[0] = qx; transform.rotation[1] = qy; transform.rotation[2] = qz; transform.rotation[3] = qw;
+            transform.scale[0] = transform.scale[1] = transform.scale[2] = scale;
             ++created;
             
-            // Progress callback every 1000 objects
-            if (progressCallback && (created % 1000 == 0)) {
-                if (!progressCallback(created, totalCount)) {
-                    return; // Cancelled
-                }
+            // Progress callback every 1000 objects. A cancel skips the remaining tiers; the
+            // current tier's objects already exist, so their values are still filled in
+            if (!cancelled && progressCallback && (created % 1000 == 0)) {
+                cancelled = !progressCallback(created, totalCount);
             }
         }
     };
@@ -0,0 +1,310 @@
+/*
+ * CpuTopology — allowed CPUs, NUMA nodes and hybrid core types; worker pool placement and thread pinning.
+ */
+#include "cpu_topology.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+#if defined(__linux__)
+bool ReadText(const std::string& sPath_ic, std::string& sOut_out) {
+    std::ifstream stm(sPath_ic);
+    if (stm.is_open() == false)
+        return false;
+    std::getline(stm, sOut_out);
+    return true;
+}
+
+bool ReadUint(const std::string& sPath_ic, uint32_t& lOut_out) {
+    std::ifstream stm(sPath_ic);
+    if (stm.is_open() == false)
+        return false;
+    unsigned long uValue = 0u;
+    if (!(stm >> uValue))
+        return false;
+    lOut_out = static_cast<uint32_t>(uValue);
+    return true;
+}
+
+/* sysfs CPU list ("0-3,8,10-11"). */
+std::vector<uint32_t> ParseCpuList(const std::string& sList_ic) {
+    std::vector<uint32_t> vecCpus;
+    size_t zPos = 0u;
+    while (zPos < sList_ic.size()) {
+        size_t zEnd = sList_ic.find(',', zPos);
+        if (zEnd == std::string::npos)
+            zEnd = sList_ic.size();
+        const std::string sRange = sList_ic.substr(zPos, zEnd - zPos);
+        zPos = zEnd + 1u;
+        if (sRange.empty() == true)
+            continue;
+        try {
+            const size_t zDash = sRange.find('-');
+            const uint32_t lFirst = static_cast<uint32_t>(std::stoul(sRange.substr(0u, zDash)));
+            const uint32_t lLast = (zDash == std::string::npos) ? lFirst : static_cast<uint32_t>(std::stoul(sRange.substr(zDash + 1u)));
+            for (uint32_t lCpu = lFirst; lCpu <= lLast; ++lCpu)
+                vecCpus.push_back(lCpu);
+        } catch (...) {
+            // Malformed entry: skip it
+        }
+    }
+    return vecCpus;
+}
+#endif
+
+/* Usable cores ordered for placement: one logical CPU per physical core first, SMT siblings after. */
+std::vector<const CpuCore*> OrderPhysicalFirst(std::vector<const CpuCore*> vecCores_ic) {
+    std::vector<std::pair<uint32_t, const CpuCore*>> vecRanked;
+    vecRanked.reserve(vecCores_ic.size());
+    for (const CpuCore* pCore : vecCores_ic) {
+        uint32_t lSiblingRank = 0u;
+        for (const auto& stRanked : vecRanked) {
+            if ((stRanked.second->lPackage == pCore->lPackage) && (stRanked.second->lCoreId == pCore->lCoreId))
+                ++lSiblingRank;
+        }
+        vecRanked.push_back({ lSiblingRank, pCore });
+    }
+    std::stable_sort(vecRanked.begin(), vecRanked.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<const CpuCore*> vecOrdered;
+    vecOrdered.reserve(vecRanked.size());
+    for (const auto& stRanked : vecRanked)
+        vecOrdered.push_back(stRanked.second);
+    return vecOrdered;
+}
+
+} // namespace
+
+CpuTopology CpuTopology::Query() {
+    CpuTopology stTopology;
+#if defined(__linux__)
+    cpu_set_t stAllowed;
+    CPU_ZERO(&stAllowed);
+    if (sched_getaffinity(0, sizeof(stAllowed), &stAllowed) == 0) {
+        for (uint32_t lCpu = 0u; lCpu < static_cast<uint32_t>(CPU_SETSIZE); ++lCpu) {
+            if (CPU_ISSET(lCpu, &stAllowed) == 0)
+                continue;
+            CpuCore stCore;
+            stCore.lCpu = lCpu;
+            stCore.lCoreId = lCpu;
+            const std::string sBase = "/sys/devices/system/cpu/cpu" + std::to_string(lCpu) + "/topology/";
+            ReadUint(sBase + "physical_package_id", stCore.lPackage);
+            ReadUint(sBase + "core_id", stCore.lCoreId);
+            stTopology.vecCores.push_back(stCore);
+        }
+    }
+    if (stTopology.vecCores.empty() == false) {
+        stTopology.bFromOs = true;
+
+        // NUMA nodes: /sys/devices/system/node/nodeN/cpulist (absent on non-NUMA kernels: everything on node 0)
+        std::vector<uint32_t> vecNodes;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+            const std::string sName = entry.path().filename().string();
+            if ((sName.rfind("node", 0) != 0) || (sName.size() <= 4u) || (std::isdigit(static_cast<unsigned char>(sName[4])) == 0))
+                continue;
+            std::string sList;
+            if (ReadText(entry.path().string() + "/cpulist", sList) == false)
+                continue;
+            const uint32_t lNode = static_cast<uint32_t>(std::stoul(sName.substr(4u)));
+            for (uint32_t lCpu : ParseCpuList(sList)) {
+                for (CpuCore& stCore : stTopology.vecCores) {
+                    if (stCore.lCpu == lCpu)
+                        stCore.lNode = lNode;
+                }
+            }
+        }
+        for (const CpuCore& stCore : stTopology.vecCores) {
+            if (std::find(vecNodes.begin(), vecNodes.end(), stCore.lNode) == vecNodes.end())
+                vecNodes.push_back(stCore.lNode);
+        }
+        stTopology.lNodeCount = static_cast<uint32_t>(vecNodes.size());
+
+        // Hybrid: Intel exposes the E-core PMU (cpu_atom) with its CPU list; ARM big.LITTLE reports cpu_capacity
+        std::string sAtomList;
+        if ((ReadText("/sys/devices/cpu_atom/cpus", sAtomList) == true) && (sAtomList.empty() == false)) {
+            for (uint32_t lCpu : ParseCpuList(sAtomList)) {
+                for (CpuCore& stCore : stTopology.vecCores) {
+                    if (stCore.lCpu == lCpu)
+                        stCore.bEfficiency = true;
+                }
+            }
+        } else {
+            std::vector<uint32_t> vecCapacity(stTopology.vecCores.size(), 0u);
+            uint32_t lMaxCapacity = 0u;
+            for (size_t i = 0u; i < stTopology.vecCores.size(); ++i) {
+                ReadUint("/sys/devices/system/cpu/cpu" + std::to_string(stTopology.vecCores[i].lCpu) + "/cpu_capacity", vecCapacity[i]);
+                lMaxCapacity = std::max(lMaxCapacity, vecCapacity[i]);
+            }
+            for (size_t i = 0u; i < stTopology.vecCores.size(); ++i)
+                stTopology.vecCores[i].bEfficiency = (vecCapacity[i] != 0u) && (vecCapacity[i] < lMaxCapacity);
+        }
+        const bool bAnyEfficiency = std::any_of(stTopology.vecCores.begin(), stTopology.vecCores.end(),
+                                                [](const CpuCore& c) { return c.bEfficiency == true; });
+        const bool bAnyPerformance = std::any_of(stTopology.vecCores.begin(), stTopology.vecCores.end(),
+                                                 [](const CpuCore& c) { return c.bEfficiency == false; });
+        stTopology.bHybrid = bAnyEfficiency && bAnyPerformance;
+        return stTopology;
+    }
+#endif
+    uint32_t lCount = static_cast<uint32_t>(std::thread::hardware_concurrency());
+    if (lCount == 0u)
+        lCount = 2u;
+    for (uint32_t lCpu = 0u; lCpu < lCount; ++lCpu) {
+        CpuCore stCore;
+        stCore.lCpu = lCpu;
+        stCore.lCoreId = lCpu;
+        stTopology.vecCores.push_back(stCore);
+    }
+    return stTopology;
+}
+
+uint32_t CpuTopology::GetPhysicalCoreCount() const {
+    std::vector<std::pair<uint32_t, uint32_t>> vecSeen;
+    for (const CpuCore& stCore : this->vecCores) {
+        const std::pair<uint32_t, uint32_t> stKey{ stCore.lPackage, stCore.lCoreId };
+        if (std::find(vecSeen.begin(), vecSeen.end(), stKey) == vecSeen.end())
+            vecSeen.push_back(stKey);
+    }
+    return static_cast<uint32_t>(vecSeen.size());
+}
+
+WorkerAffinity WorkerAffinityFromString(const std::string& s) {
+    if (s == "pin")
+        return WorkerAffinity::Pin;
+    if (s == "numa")
+        return WorkerAffinity::Numa;
+    return WorkerAffinity::None;
+}
+
+const char* WorkerAffinityToString(WorkerAffinity eAffinity) {
+    switch (eAffinity) {
+        case WorkerAffinity::Pin:  return "pin";
+        case WorkerAffinity::Numa: return "numa";
+        default:                   return "none";
+    }
+}
+
+WorkerPoolPlan PlanWorkerPool(const CpuTopology& topology_ic, const WorkerPoolOptions& stOptions_ic) {
+    WorkerPoolPlan stPlan;
+
+    std::vector<const CpuCore*> vecUsable;
+    for (const CpuCore& stCore : topology_ic.vecCores) {
+        if ((stOptions_ic.bAvoidEfficiencyCores == true) && (topology_ic.bHybrid == true) && (stCore.bEfficiency == true))
+            continue;
+        vecUsable.push_back(&stCore);
+    }
+    const bool bRestricted = (vecUsable.size() != topology_ic.vecCores.size());
+
+    // Main core: first usable core of the lowest node; its SMT siblings stay free too when enough cores remain
+    if ((stOptions_ic.eAffinity != WorkerAffinity::None) && (stOptions_ic.bReserveMainCore == true) && (vecUsable.size() > 1u)) {
+        const CpuCore* pMain = vecUsable.front();
+        for (const CpuCore* pCore : vecUsable) {
+            if (pCore->lNode < pMain->lNode)
+                pMain = pCore;
+        }
+        std::vector<const CpuCore*> vecWithoutCore;
+        for (const CpuCore* pCore : vecUsable) {
+            if ((pCore->lPackage != pMain->lPackage) || (pCore->lCoreId != pMain->lCoreId))
+                vecWithoutCore.push_back(pCore);
+        }
+        if (vecWithoutCore.empty() == true) {
+            for (const CpuCore* pCore : vecUsable) {
+                if (pCore != pMain)
+                    vecWithoutCore.push_back(pCore);
+            }
+        }
+        stPlan.iMainCpu = static_cast<int32_t>(pMain->lCpu);
+        vecUsable = std::move(vecWithoutCore);
+    }
+
+    uint32_t lCount = stOptions_ic.lWorkerThreads;
+    if (lCount == 0u)
+        lCount = std::clamp(static_cast<uint32_t>(vecUsable.size()), 1u, WorkerPoolOptions::kMaxAutoWorkers);
+    stPlan.vecWorkers.resize(lCount);
+    if (vecUsable.empty() == true)
+        return stPlan;
+
+    switch (stOptions_ic.eAffinity) {
+        case WorkerAffinity::None: {
+            // Only restricted when efficiency cores are excluded; otherwise the OS places the workers freely
+            if (bRestricted == true) {
+                std::vector<uint32_t> vecCpus;
+                for (const CpuCore* pCore : vecUsable)
+                    vecCpus.push_back(pCore->lCpu);
+                for (WorkerPlacement& stWorker : stPlan.vecWorkers)
+                    stWorker.vecCpus = vecCpus;
+            }
+            break;
+        }
+        case WorkerAffinity::Pin: {
+            const std::vector<const CpuCore*> vecOrdered = OrderPhysicalFirst(vecUsable);
+            for (uint32_t i = 0u; i < lCount; ++i)
+                stPlan.vecWorkers[i].vecCpus = { vecOrdered[i % vecOrdered.size()]->lCpu };
+            break;
+        }
+        case WorkerAffinity::Numa: {
+            std::vector<uint32_t> vecNodes;
+            for (const CpuCore* pCore : vecUsable) {
+                if (std::find(vecNodes.begin(), vecNodes.end(), pCore->lNode) == vecNodes.end())
+                    vecNodes.push_back(pCore->lNode);
+            }
+            std::sort(vecNodes.begin(), vecNodes.end());
+            std::vector<std::vector<uint32_t>> vecNodeCpus(vecNodes.size());
+            for (const CpuCore* pCore : vecUsable) {
+                const size_t zGroup = static_cast<size_t>(std::find(vecNodes.begin(), vecNodes.end(), pCore->lNode) - vecNodes.begin());
+                vecNodeCpus[zGroup].push_back(pCore->lCpu);
+            }
+            // Each worker goes to the node with the fewest workers per core so far
+            std::vector<uint32_t> vecAssigned(vecNodes.size(), 0u);
+            for (uint32_t i = 0u; i < lCount; ++i) {
+                size_t zBest = 0u;
+                for (size_t g = 1u; g < vecNodes.size(); ++g) {
+                    if (static_cast<uint64_t>(vecAssigned[g]) * vecNodeCpus[zBest].size() <
+                        static_cast<uint64_t>(vecAssigned[zBest]) * vecNodeCpus[g].size())
+                        zBest = g;
+                }
+                ++vecAssigned[zBest];
+                stPlan.vecWorkers[i].vecCpus = vecNodeCpus[zBest];
+                stPlan.vecWorkers[i].lGroup = static_cast<uint32_t>(zBest);
+            }
+            stPlan.lGroupCount = static_cast<uint32_t>(vecNodes.size());
+            break;
+        }
+    }
+    return stPlan;
+}
+
+bool SetCurrentThreadAffinity(const std::vector<uint32_t>& vecCpus_ic) {
+    if (vecCpus_ic.empty() == true)
+        return false;
+#if defined(_WIN32) || defined(_WIN64)
+    DWORD_PTR uMask = 0u;
+    for (uint32_t lCpu : vecCpus_ic) {
+        if (lCpu < sizeof(DWORD_PTR) * 8u)
+            uMask |= (static_cast<DWORD_PTR>(1u) << lCpu);
+    }
+    return (uMask != 0u) && (SetThreadAffinityMask(GetCurrentThread(), uMask) != 0u);
+#elif defined(__linux__)
+    cpu_set_t stSet;
+    CPU_ZERO(&stSet);
+    for (uint32_t lCpu : vecCpus_ic) {
+        if (lCpu < static_cast<uint32_t>(CPU_SETSIZE))
+            CPU_SET(lCpu, &stSet);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(stSet), &stSet) == 0;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* One logical CPU the process may run on. */
+struct CpuCore {
+    uint32_t lCpu     = 0u;  // OS CPU index (affinity masks, /sys/devices/system/cpu/cpuN)
+    uint32_t lNode    = 0u;  // NUMA node
+    uint32_t lPackage = 0u;  // Socket
+    uint32_t lCoreId  = 0u;  // Physical core within the package (SMT siblings share it)
+    bool bEfficiency  = false;  // Hybrid CPUs: efficiency core (Intel E-core, ARM LITTLE)
+};
+
+/*
+ * CPU topology of the process. On Linux, Query reads the allowed CPU set (sched_getaffinity, so taskset / cgroup
+ * limits are honoured) and sysfs (package / core ids, NUMA nodes, cpu_atom or cpu_capacity for hybrid parts).
+ * Elsewhere it falls back to hardware_concurrency logical CPUs on one node, without hybrid information.
+ */
+struct CpuTopology {
+    std::vector<CpuCore> vecCores;  // Ascending lCpu
+    uint32_t lNodeCount = 1u;
+    bool bHybrid = false;   // Both performance and efficiency cores are allowed
+    bool bFromOs = false;   // Read from the OS (false: fallback guess)
+
+    static CpuTopology Query();
+    /* Physical cores (distinct package / core id pairs). */
+    uint32_t GetPhysicalCoreCount() const;
+};
+
+/* Worker thread placement (VulkanConfig::sWorkerAffinity). */
+enum class WorkerAffinity : uint8_t {
+    None,  // OS schedules the workers (restricted to performance cores on hybrid CPUs if requested)
+    Pin,   // Each worker pinned to one logical CPU, one per physical core first
+    Numa,  // Workers split across NUMA nodes in proportion to their cores; each may run on its node's cores only
+};
+
+/* "none" / "pin" / "numa"; unknown strings map to None. */
+WorkerAffinity WorkerAffinityFromString(const std::string& s);
+const char* WorkerAffinityToString(WorkerAffinity eAffinity);
+
+struct WorkerPoolOptions {
+    uint32_t lWorkerThreads = 0u;  // 0 = one per usable logical CPU, at most kMaxAutoWorkers
+    WorkerAffinity eAffinity = WorkerAffinity::None;
+    bool bReserveMainCore = true;       // Pin / Numa: keep one performance core (and its SMT siblings) for the main thread
+    bool bAvoidEfficiencyCores = true;  // Hybrid CPUs: no workers on efficiency cores
+
+    static constexpr uint32_t kMaxAutoWorkers = 16u;
+};
+
+/* Where one worker may run. */
+struct WorkerPlacement {
+    std::vector<uint32_t> vecCpus;  // Allowed logical CPUs (empty = no restriction)
+    uint32_t lGroup = 0u;           // Steal group (NUMA node index); workers steal within their group first
+};
+
+struct WorkerPoolPlan {
+    std::vector<WorkerPlacement> vecWorkers;  // One per worker thread
+    int32_t iMainCpu = -1;                    // CPU reserved for the main thread (-1 = none)
+    uint32_t lGroupCount = 1u;
+};
+
+/* Decide worker count and placement for the options on this topology. */
+WorkerPoolPlan PlanWorkerPool(const CpuTopology& topology_ic, const WorkerPoolOptions& stOptions_ic);
+
+/* Restrict the calling thread to vecCpus_ic. False if unsupported or the OS refused (the thread keeps running anywhere). */
+bool SetCurrentThreadAffinity(const std::vector<uint32_t>& vecCpus_ic);
@@ -0,0 +1,233 @@
+/*
+ * FrameGraph — per-frame CPU stages with declared resource access, run as a dependency graph.
+ */
+#include "frame_graph.h"
+#include "vulkan/vulkan_utils.h"
+#include <bit>
+#include <chrono>
+#include <stdexcept>
+
+namespace {
+
+#ifndef NDEBUG
+/* Stage running on the calling thread (debug access checks); restored after nested stages. */
+thread_local const FrameGraph* t_pRunningGraph = nullptr;
+thread_local const void* t_pRunningStage = nullptr;
+#endif
+
+uint64_t ResourceMask(std::initializer_list<FrameResourceId> resources_ic) {
+    uint64_t uMask = 0u;
+    for (FrameResourceId lResource : resources_ic)
+        uMask |= (1ull << lResource);
+    return uMask;
+}
+
+} // namespace
+
+FrameResourceId FrameGraph::AddResource(const std::string& sName_ic) {
+    if (this->m_vecResourceNames.size() >= kMaxResources) {
+        VulkanUtils::LogErr("FrameGraph: more than {} resources (adding '{}')", kMaxResources, sName_ic);
+        throw std::runtime_error("FrameGraph::AddResource: too many resources");
+    }
+    this->m_vecResourceNames.push_back(sName_ic);
+    return static_cast<FrameResourceId>(this->m_vecResourceNames.size() - 1u);
+}
+
+void FrameGraph::AddStage(const std::string& sName_ic, std::initializer_list<FrameResourceId> reads_ic,
+                          std::initializer_list<FrameResourceId> writes_ic, TaskAffinity eAffinity_ic, FrameStageFunction fnRun_in) {
+    for (std::initializer_list<FrameResourceId> resources : { reads_ic, writes_ic }) {
+        for (FrameResourceId lResource : resources) {
+            if (lResource >= this->m_vecResourceNames.size()) {
+                VulkanUtils::LogErr("FrameGraph: stage '{}' uses undeclared resource {}", sName_ic, lResource);
+                throw std::runtime_error("FrameGraph::AddStage: undeclared resource");
+            }
+        }
+    }
+    std::unique_ptr<Stage> pStage = std::make_unique<Stage>();
+    pStage->sName = sName_ic;
+    pStage->uReads = ResourceMask(reads_ic);
+    pStage->uWrites = ResourceMask(writes_ic);
+    pStage->eAffinity = eAffinity_ic;
+    pStage->fnRun = std::move(fnRun_in);
+    this->m_vecStages.push_back(std::move(pStage));
+    this->m_bCompiled = false;
+}
+
+void FrameGraph::Compile() {
+    this->m_stats = FrameGraphStats{};
+    this->m_stats.lStages = static_cast<uint32_t>(this->m_vecStages.size());
+    for (const std::unique_ptr<Stage>& pStage : this->m_vecStages) {
+        pStage->vecSuccessors.clear();
+        pStage->lDependencyCount = 0u;
+    }
+    for (size_t zLater = 0u; zLater < this->m_vecStages.size(); ++zLater) {
+        Stage& later = *this->m_vecStages[zLater];
+        for (size_t zEarlier = 0u; zEarlier < zLater; ++zEarlier) {
+            Stage& earlier = *this->m_vecStages[zEarlier];
+            // Write-after-write, read-after-write and write-after-read keep declaration order
+            const bool bConflict = ((earlier.uWrites & (later.uReads | later.uWrites)) != 0u) ||
+                                   ((earlier.uReads & later.uWrites) != 0u);
+            if (bConflict == false)
+                continue;
+            earlier.vecSuccessors.push_back(&later);
+            ++later.lDependencyCount;
+            ++this->m_stats.lEdges;
+        }
+        if (later.eAffinity == TaskAffinity::MainThread)
+            ++this->m_stats.lMainThreadStages;
+        VulkanUtils::LogDebug("FrameGraph: '{}'{} reads [{}] writes [{}], {} dependencies", later.sName,
+                              (later.eAffinity == TaskAffinity::MainThread) ? " (main thread)" : "",
+                              DescribeMask(later.uReads), DescribeMask(later.uWrites), later.lDependencyCount);
+    }
+    this->m_bCompiled = true;
+}
+
+void FrameGraph::Execute(TaskScheduler& scheduler_io) {
+    if (this->m_bCompiled == false)
+        Compile();
+    if (this->m_vecStages.empty() == true)
+        return;
+
+    const auto tStart = std::chrono::steady_clock::now();
+    if (scheduler_io.GetWorkerCount() == 0u) {
+        // Declaration order is a valid topological order
+        for (const std::unique_ptr<Stage>& pStage : this->m_vecStages)
+            RunStage(scheduler_io, pStage.get());
+    } else {
+        this->m_lStagesLeft.store(static_cast<uint32_t>(this->m_vecStages.size()), std::memory_order_relaxed);
+        for (const std::unique_ptr<Stage>& pStage : this->m_vecStages)
+            pStage->lRemaining.store(pStage->lDependencyCount, std::memory_order_relaxed);
+        for (const std::unique_ptr<Stage>& pStage : this->m_vecStages) {
+            if (pStage->lDependencyCount == 0u)
+                Launch(scheduler_io, pStage.get());
+        }
+        // Run main-thread stages as they become ready until the last stage (on any thread) has finished
+        std::unique_lock<std::mutex> lock(this->m_mainMutex);
+        while (true) {
+            this->m_mainCv.wait(lock, [this]() {
+                return (this->m_readyMain.Empty() == false) || (this->m_lStagesLeft.load(std::memory_order_acquire) == 0u);
+            });
+            if (this->m_readyMain.Empty() == true)
+                break;
+            Stage* pStage = this->m_readyMain.PopFront();
+            lock.unlock();
+            RunStage(scheduler_io, pStage);
+            lock.lock();
+        }
+    }
+
+    this->m_stats.fWallMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+    this->m_stats.fSerialMs = 0.f;
+    for (const std::unique_ptr<Stage>& pStage : this->m_vecStages)
+        this->m_stats.fSerialMs += pStage->fLastMs;
+}
+
+void FrameGraph::Launch(TaskScheduler& scheduler_io, Stage* pStage_in) {
+    if (pStage_in->eAffinity == TaskAffinity::MainThread) {
+        std::lock_guard<std::mutex> lock(this->m_mainMutex);
+        this->m_readyMain.PushBack(pStage_in);
+        this->m_mainCv.notify_one();
+        return;
+    }
+    // Ahead of queued load jobs: the frame waits on this stage
+    scheduler_io.Submit([this, &scheduler_io, pStage_in]() { RunStage(scheduler_io, pStage_in); }, nullptr, TaskAffinity::Any,
+                        TaskPriority::High);
+}
+
+void FrameGraph::RunStage(TaskScheduler& scheduler_io, Stage* pStage_in) {
+#ifndef NDEBUG
+    uint64_t uHeldReads = 0u;
+    uint64_t uHeldWrites = 0u;
+    BeginAccess(*pStage_in, uHeldReads, uHeldWrites);
+    const FrameGraph* pOuterGraph = t_pRunningGraph;
+    const void* pOuterStage = t_pRunningStage;
+    t_pRunningGraph = this;
+    t_pRunningStage = pStage_in;
+#endif
+    const auto tStart = std::chrono::steady_clock::now();
+    pStage_in->fnRun();
+    pStage_in->fLastMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+#ifndef NDEBUG
+    t_pRunningGraph = pOuterGraph;
+    t_pRunningStage = pOuterStage;
+    EndAccess(uHeldReads, uHeldWrites);
+#endif
+    if (scheduler_io.GetWorkerCount() == 0u)
+        return;  // Inline run: Execute walks the stages itself
+
+    for (Stage* pNext : pStage_in->vecSuccessors) {
+        if (pNext->lRemaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            Launch(scheduler_io, pNext);
+    }
+    // Under the lock so Execute cannot return (and the graph go away) before the wake-up is done
+    std::lock_guard<std::mutex> lock(this->m_mainMutex);
+    if (this->m_lStagesLeft.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        this->m_mainCv.notify_one();
+}
+
+void FrameGraph::Clear() {
+    this->m_vecStages.clear();
+    this->m_vecResourceNames.clear();
+    this->m_bCompiled = false;
+    this->m_stats = FrameGraphStats{};
+}
+
+std::string FrameGraph::DescribeMask(uint64_t uMask_ic) const {
+    std::string sOut;
+    for (uint64_t uMask = uMask_ic; uMask != 0u; uMask &= (uMask - 1u)) {
+        const uint32_t lResource = static_cast<uint32_t>(std::countr_zero(uMask));
+        if (sOut.empty() == false)
+            sOut += ", ";
+        sOut += (lResource < this->m_vecResourceNames.size()) ? this->m_vecResourceNames[lResource] : std::to_string(lResource);
+    }
+    return sOut;
+}
+
+#ifndef NDEBUG
+void FrameGraph::AssertAccess(FrameResourceId lResource_ic, bool bWrite_ic) const {
+    if ((t_pRunningGraph != this) || (t_pRunningStage == nullptr))
+        return;
+    const Stage* pStage = static_cast<const Stage*>(t_pRunningStage);
+    const uint64_t uBit = 1ull << lResource_ic;
+    const uint64_t uDeclared = (bWrite_ic == true) ? pStage->uWrites : (pStage->uReads | pStage->uWrites);
+    if ((uDeclared & uBit) == 0u)
+        VulkanUtils::LogErr("FrameGraph race: stage '{}' {} '{}' without declaring it", pStage->sName,
+                            (bWrite_ic == true) ? "writes" : "reads", DescribeMask(uBit));
+}
+
+void FrameGraph::BeginAccess(const Stage& stage_ic, uint64_t& uHeldReads_out, uint64_t& uHeldWrites_out) {
+    uHeldReads_out = 0u;
+    uHeldWrites_out = 0u;
+    for (uint64_t uMask = stage_ic.uWrites; uMask != 0u; uMask &= (uMask - 1u)) {
+        const uint32_t lResource = static_cast<uint32_t>(std::countr_zero(uMask));
+        int32_t iUse = 0;
+        if (this->m_resourceUse[lResource].compare_exchange_strong(iUse, -1, std::memory_order_acq_rel) == true)
+            uHeldWrites_out |= (1ull << lResource);
+        else
+            VulkanUtils::LogErr("FrameGraph race: stage '{}' writes '{}' while another stage {} it", stage_ic.sName,
+                                this->m_vecResourceNames[lResource], (iUse < 0) ? "writes" : "reads");
+    }
+    for (uint64_t uMask = stage_ic.uReads & ~stage_ic.uWrites; uMask != 0u; uMask &= (uMask - 1u)) {
+        const uint32_t lResource = static_cast<uint32_t>(std::countr_zero(uMask));
+        int32_t iUse = this->m_resourceUse[lResource].load(std::memory_order_acquire);
+        while (true) {
+            if (iUse < 0) {
+                VulkanUtils::LogErr("FrameGraph race: stage '{}' reads '{}' while another stage writes it", stage_ic.sName,
+                                    this->m_vecResourceNames[lResource]);
+                break;
+            }
+            if (this->m_resourceUse[lResource].compare_exchange_weak(iUse, iUse + 1, std::memory_order_acq_rel) == true) {
+                uHeldReads_out |= (1ull << lResource);
+                break;
+            }
+        }
+    }
+}
+
+void FrameGraph::EndAccess(uint64_t uHeldReads_ic, uint64_t uHeldWrites_ic) {
+    for (uint64_t uMask = uHeldWrites_ic; uMask != 0u; uMask &= (uMask - 1u))
+        this->m_resourceUse[static_cast<uint32_t>(std::countr_zero(uMask))].store(0, std::memory_order_release);
+    for (uint64_t uMask = uHeldReads_ic; uMask != 0u; uMask &= (uMask - 1u))
+        this->m_resourceUse[static_cast<uint32_t>(std::countr_zero(uMask))].fetch_sub(1, std::memory_order_acq_rel);
+}
+#endif
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "inplace_function.h"
+#include "ring_queue.h"
+#include "task_scheduler.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Index of a resource declared with FrameGraph::AddResource (one bit of the stage access masks). */
+using FrameResourceId = uint32_t;
+
+/* Stage body. Stored inline like TaskFunction; a capture of `this` (plus a pointer or two) fits. */
+using FrameStageFunction = InplaceFunction<void(), 32>;
+
+/* Shape and timing of the last FrameGraph::Execute. */
+struct FrameGraphStats {
+    uint32_t lStages           = 0u;
+    uint32_t lEdges            = 0u;   // Dependencies derived from the declarations
+    uint32_t lMainThreadStages = 0u;
+    float    fWallMs           = 0.f;  // Execute, first stage start to last stage end
+    float    fSerialMs         = 0.f;  // Sum of stage times (what a single thread would have spent)
+};
+
+/*
+ * FrameGraph — the per-frame CPU stages as a dependency graph run on the TaskScheduler.
+ *
+ * Each stage declares the resources it reads and writes. Compile orders stages by declaration: a stage depends on
+ * every earlier stage that writes something it reads or writes, or reads something it writes. Stages with no path
+ * between them run in parallel: TaskAffinity::Any stages on scheduler workers, TaskAffinity::MainThread stages
+ * (Vulkan, ImGui, anything main-thread-owned) on the thread calling Execute, which does nothing else meanwhile.
+ *
+ * Debug builds check the declarations while the graph runs: two stages holding conflicting access to a resource at
+ * the same time, or AssertAccess from a stage that did not declare the access, are logged as races.
+ * Build once (AddResource / AddStage), then call Execute once per frame from the main thread.
+ */
+class FrameGraph {
+public:
+    static constexpr uint32_t kMaxResources = 64u;
+
+    FrameGraph() = default;
+
+    FrameGraph(const FrameGraph&) = delete;
+    FrameGraph& operator=(const FrameGraph&) = delete;
+
+    /* Declare a resource (a piece of engine state stages share). Throws past kMaxResources. */
+    FrameResourceId AddResource(const std::string& sName_ic);
+    /* Append a stage. Declaration order is the serial order the graph must be equivalent to. */
+    void AddStage(const std::string& sName_ic, std::initializer_list<FrameResourceId> reads_ic,
+                  std::initializer_list<FrameResourceId> writes_ic, TaskAffinity eAffinity_ic, FrameStageFunction fnRun_in);
+    /* Derive the dependencies (done by the first Execute after a change). */
+    void Compile();
+    /* Run every stage once and return when all are done. Inline in declaration order without workers. */
+    void Execute(TaskScheduler& scheduler_io);
+    /* Forget every stage and resource. */
+    void Clear();
+
+    /*
+     * Debug builds: log a race if the stage running on this thread did not declare this access.
+     * No-op in release builds and on threads not running a stage of this graph.
+     */
+#ifdef NDEBUG
+    void AssertAccess(FrameResourceId, bool) const {}
+#else
+    void AssertAccess(FrameResourceId lResource_ic, bool bWrite_ic) const;
+#endif
+
+    const FrameGraphStats& GetStats() const { return this->m_stats; }
+
+private:
+    struct Stage {
+        std::string           sName;
+        uint64_t              uReads = 0u;
+        uint64_t              uWrites = 0u;
+        TaskAffinity          eAffinity = TaskAffinity::Any;
+        FrameStageFunction    fnRun;
+        std::vector<Stage*>   vecSuccessors;
+        uint32_t              lDependencyCount = 0u;
+        std::atomic<uint32_t> lRemaining{0u};  // Unfinished dependencies this frame
+        float                 fLastMs = 0.f;
+    };
+
+    /* Queue a stage whose dependencies are done (scheduler for Any, m_readyMain for MainThread). */
+    void Launch(TaskScheduler& scheduler_io, Stage* pStage_in);
+    /* Run the stage, then launch successors that became ready; the last stage wakes Execute. */
+    void RunStage(TaskScheduler& scheduler_io, Stage* pStage_in);
+    /* "a, b, c" for the resources of a mask. */
+    std::string DescribeMask(uint64_t uMask_ic) const;
+
+#ifndef NDEBUG
+    /* Take / drop the stage's declared access; logs a race when another running stage conflicts. */
+    void BeginAccess(const Stage& stage_ic, uint64_t& uHeldReads_out, uint64_t& uHeldWrites_out);
+    void EndAccess(uint64_t uHeldReads_ic, uint64_t uHeldWrites_ic);
+    /* Per resource: readers running (> 0), a writer running (-1) or unused (0). */
+    std::array<std::atomic<int32_t>, kMaxResources> m_resourceUse{};
+#endif
+
+    std::vector<std::string> m_vecResourceNames;
+    std::vector<std::unique_ptr<Stage>> m_vecStages;
+    bool m_bCompiled = false;
+
+    std::atomic<uint32_t> m_lStagesLeft{0u};
+    std::mutex m_mainMutex;                // Guards m_readyMain and the final wake-up
+    std::condition_variable m_mainCv;
+    RingQueue<Stage*> m_readyMain;
+
+    FrameGraphStats m_stats;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, size_t zCapacity>
+class InplaceFunction;
+
+/*
+ * InplaceFunction — move-only callable stored in a fixed inline buffer of zCapacity bytes; never allocates.
+ * A callable that does not fit is a compile error (capture a pointer to shared state instead of growing the buffer).
+ * Used where std::function would allocate on every submit (scheduler tasks: libstdc++ only stores trivially
+ * copyable callables of up to 16 bytes inline, so any lambda capturing a std::string or shared_ptr goes to the heap).
+ */
+template <typename R, typename... Args, size_t zCapacity>
+class InplaceFunction<R(Args...), zCapacity> {
+public:
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {}
+
+    template <typename F, typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<(std::is_same_v<Fn, InplaceFunction> == false) && std::is_invocable_r_v<R, Fn&, Args...>>>
+    InplaceFunction(F&& fn_in) {
+        static_assert(sizeof(Fn) <= zCapacity, "InplaceFunction: callable too large for the inline buffer");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "InplaceFunction: callable over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "InplaceFunction: callable must be nothrow movable");
+        ::new (static_cast<void*>(this->m_storage)) Fn(std::forward<F>(fn_in));
+        this->m_pOps = &OpsFor<Fn>::kOps;
+    }
+
+    InplaceFunction(InplaceFunction&& other_io) noexcept { MoveFrom(other_io); }
+    InplaceFunction& operator=(InplaceFunction&& other_io) noexcept {
+        if (this != &other_io) {
+            Reset();
+            MoveFrom(other_io);
+        }
+        return *this;
+    }
+    InplaceFunction& operator=(std::nullptr_t) noexcept {
+        Reset();
+        return *this;
+    }
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { Reset(); }
+
+    R operator()(Args... args) { return this->m_pOps->pInvoke(this->m_storage, std::forward<Args>(args)...); }
+    explicit operator bool() const { return this->m_pOps != nullptr; }
+
+private:
+    struct Ops {
+        R    (*pInvoke)(void*, Args&&...);
+        void (*pMoveDestroy)(void* pDst, void* pSrc);  // Move-construct at pDst, destroy pSrc
+        void (*pDestroy)(void*);
+    };
+    template <typename Fn>
+    struct OpsFor {
+        static R Invoke(void* p, Args&&... args) { return (*static_cast<Fn*>(p))(std::forward<Args>(args)...); }
+        static void MoveDestroy(void* pDst, void* pSrc) {
+            ::new (pDst) Fn(std::move(*static_cast<Fn*>(pSrc)));
+            static_cast<Fn*>(pSrc)->~Fn();
+        }
+        static void Destroy(void* p) { static_cast<Fn*>(p)->~Fn(); }
+        static constexpr Ops kOps{ &Invoke, &MoveDestroy, &Destroy };
+    };
+
+    void MoveFrom(InplaceFunction& other_io) noexcept {
+        if (other_io.m_pOps == nullptr)
+            return;
+        other_io.m_pOps->pMoveDestroy(this->m_storage, other_io.m_storage);
+        this->m_pOps = other_io.m_pOps;
+        other_io.m_pOps = nullptr;
+    }
+    void Reset() noexcept {
+        if (this->m_pOps == nullptr)
+            return;
+        this->m_pOps->pDestroy(this->m_storage);
+        this->m_pOps = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[zCapacity];
+    const Ops* m_pOps = nullptr;
+};
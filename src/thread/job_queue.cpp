@@ -1,9 +1,12 @@
 /*
- * JobQueue — worker threads for async file loads. SubmitLoadFile() enqueues; workers call ReadFileBinary
+ * JobQueue — async file loads on TaskScheduler workers. SubmitLoadFile() enqueues; workers call ReadFileBinary
  * and set result; main thread drains completed jobs via ProcessCompletedJobs(). Used by VulkanShaderManager.
+ * SubmitLoadTexture() jobs also run their process callback (texture decode) on the worker.
+ * SubmitTask() runs CPU work (level import parse/decode) on the same workers.
  */
 #include "job_queue.h"
 #include "vulkan/vulkan_utils.h"
+#include <algorithm>
 #include <fstream>
 
 std::vector<uint8_t> JobQueue::ReadFileBinary(const std::string& sPath) {
@@ -19,101 +22,114 @@ std::vector<uint8_t> JobQueue::ReadFileBinary(const std::string& sPath) {
     return vecData;
 }
 
-void JobQueue::WorkerLoop() {
-    while (true) {
-        Job stJob;
-        {
-            std::unique_lock<std::mutex> lock(this->m_mutex);
-            while ((this->m_queue.empty() == true) && (this->m_stop.load() == false))
-                this->m_cv.wait(lock);
-            if (this->m_stop.load() == true)
-                break;
-            stJob = this->m_queue.front();
-            this->m_queue.pop();
-        }
-        std::vector<uint8_t> vecData = ReadFileBinary(stJob.sPath);
+void JobQueue::RunLoadJob(LoadJobType eType_ic, const std::string& sPath_ic, const std::shared_ptr<LoadFileResult>& pResult_ic,
+                          const ProcessFn& fnProcess_ic) {
+    std::vector<uint8_t> vecData = ReadFileBinary(sPath_ic);
+    if (fnProcess_ic)
+        fnProcess_ic(vecData);
 
-        if (stJob.pResult != nullptr) {
-            std::lock_guard<std::mutex> lock(stJob.pResult->mtx);
-            stJob.pResult->vecData = vecData;
-            stJob.pResult->bDone = true;
-            stJob.pResult->cv.notify_all();
-        }
-
-        {
-            CompletedLoadJob stCompleted;
-            stCompleted.eType = stJob.eType;
-            stCompleted.sPath = stJob.sPath;
-            stCompleted.vecData = std::move(vecData);
-            std::lock_guard<std::mutex> clock(this->m_completedMutex);
-            this->m_completed.push(std::move(stCompleted));
-        }
+    CompletedLoadJob stCompleted;
+    stCompleted.eType = eType_ic;
+    stCompleted.sPath = sPath_ic;
+    if (pResult_ic != nullptr) {
+        // The waiter owns the bytes; the completion only reports the path
+        std::lock_guard<std::mutex> lock(pResult_ic->mtx);
+        pResult_ic->vecData = std::move(vecData);
+        pResult_ic->bDone = true;
+        pResult_ic->cv.notify_all();
+    } else {
+        stCompleted.vecData = std::move(vecData);
     }
+    this->PushCompleted(stCompleted);
 }
 
-unsigned int JobQueue::GetWorkerCount() {
-    unsigned int n = static_cast<unsigned int>(std::thread::hardware_concurrency());
-    if (n == static_cast<unsigned int>(0))
-        n = static_cast<unsigned int>(2);
-    return (n > static_cast<unsigned int>(16)) ? static_cast<unsigned int>(16) : n;
+void JobQueue::PushCompleted(CompletedLoadJob& stJob_io) {
+    if (this->m_completed.TryPush(stJob_io) == true)
+        return;
+    std::lock_guard<std::mutex> lock(this->m_overflowMutex);
+    this->m_completedOverflow.push_back(std::move(stJob_io));
+    this->m_lOverflowCount.store(static_cast<uint32_t>(this->m_completedOverflow.size()), std::memory_order_release);
 }
 
-void JobQueue::Start() {
-    this->m_stop.store(false);
-    unsigned int n = this->GetWorkerCount();
-    this->m_workers.reserve(n);
-    for (unsigned int i = static_cast<unsigned int>(0); i < n; ++i)
-        this->m_workers.emplace_back(&JobQueue::WorkerLoop, this);
+void JobQueue::Start(const WorkerPoolOptions& stOptions_ic) {
+    const CpuTopology stTopology = CpuTopology::Query();
+    const WorkerPoolPlan stPlan = PlanWorkerPool(stTopology, stOptions_ic);
+    const uint32_t lEfficiency = static_cast<uint32_t>(std::count_if(stTopology.vecCores.begin(), stTopology.vecCores.end(),
+                                                                     [](const CpuCore& c) { return c.bEfficiency == true; }));
+    VulkanUtils::LogInfo("JobQueue: {} logical CPUs ({} physical, {} efficiency, {} NUMA nodes{}), {} workers, affinity \"{}\", main core {}",
+                         stTopology.vecCores.size(), stTopology.GetPhysicalCoreCount(), lEfficiency, stTopology.lNodeCount,
+                         (stTopology.bFromOs == true) ? "" : ", guessed", stPlan.vecWorkers.size(),
+                         WorkerAffinityToString(stOptions_ic.eAffinity), stPlan.iMainCpu);
+    if ((stPlan.iMainCpu >= 0) && (SetCurrentThreadAffinity({ static_cast<uint32_t>(stPlan.iMainCpu) }) == false))
+        VulkanUtils::LogWarn("JobQueue: could not pin the main thread to CPU {}", stPlan.iMainCpu);
+    this->m_scheduler.Start(static_cast<uint32_t>(stPlan.vecWorkers.size()), &stPlan.vecWorkers);
 }
 
 void JobQueue::Stop() {
-    this->m_stop.store(true);
-    this->m_cv.notify_all();
-    for (std::thread& t : this->m_workers) {
-        if (t.joinable() == true)
-            t.join();
-    }
-    this->m_workers.clear();
+    this->m_scheduler.Stop();
 }
 
 std::shared_ptr<LoadFileResult> JobQueue::SubmitLoadFile(const std::string& sPath) {
     auto pResult = std::make_shared<LoadFileResult>();
-    {
-        std::lock_guard<std::mutex> lock(this->m_mutex);
-        Job stJob;
-        stJob.eType = LoadJobType::LoadFile;
-        stJob.sPath = sPath;
-        stJob.pResult = pResult;
-        this->m_queue.push(std::move(stJob));
+    // Init-capture: a plain copy of a const& capture stays const and would copy again when the task is moved
+    this->m_scheduler.Submit([this, sPathCopy = sPath, pResult]() {
+        this->RunLoadJob(LoadJobType::LoadFile, sPathCopy, pResult, nullptr);
+    });
+    return pResult;
+}
+
+void JobQueue::SubmitLoadTexture(const std::string& sPath, ProcessFn fnProcess_ic) {
+    /* no wait handle for texture loads */
+    this->m_scheduler.Submit([this, sPathCopy = sPath, fnProcess = std::move(fnProcess_ic)]() {
+        this->RunLoadJob(LoadJobType::LoadTexture, sPathCopy, nullptr, fnProcess);
+    });
+}
+
+std::shared_ptr<TaskResult> JobQueue::SubmitTask(std::function<void()> fnTask) {
+    auto pResult = std::make_shared<TaskResult>();
+    if (this->m_scheduler.GetWorkerCount() == 0u) {
+        if (fnTask)
+            fnTask();
+        return pResult;
     }
-    this->m_cv.notify_all();
+    /* The task does not hold the handle: the group must stay alive until the scheduler has finished with it,
+     * which the caller's handle guarantees (it waits or polls before letting go). */
+    this->m_scheduler.Submit([fnTask = std::move(fnTask)]() {
+        if (fnTask)
+            fnTask();
+    }, &pResult->group);
     return pResult;
 }
 
-void JobQueue::SubmitLoadTexture(const std::string& sPath) {
-    std::lock_guard<std::mutex> lock(this->m_mutex);
-    Job stJob;
-    stJob.eType = LoadJobType::LoadTexture;
-    stJob.sPath = sPath;
-    stJob.pResult = nullptr;  /* no wait handle for texture loads */
-    this->m_queue.push(std::move(stJob));
-    this->m_cv.notify_all();
+void JobQueue::WaitForTask(const std::shared_ptr<TaskResult>& pResult_ic) {
+    if (pResult_ic == nullptr)
+        return;
+    this->m_scheduler.Wait(pResult_ic->group);
+}
+
+bool JobQueue::IsTaskDone(const std::shared_ptr<TaskResult>& pResult_ic) {
+    if (pResult_ic == nullptr)
+        return true;
+    return pResult_ic->group.IsDone();
 }
 
 void JobQueue::ProcessCompletedJobs(const CompletedJobHandler& pHandler_ic) {
-    std::queue<CompletedLoadJob> vecBatch;
-    {
-        std::lock_guard<std::mutex> lock(this->m_completedMutex);
-        while (this->m_completed.empty() == false) {
-            vecBatch.push(std::move(this->m_completed.front()));
-            this->m_completed.pop();
-        }
+    this->m_scheduler.RunMainThreadTasks();
+    // Take a batch first: handlers may submit jobs that complete while the batch is dispatched
+    std::vector<CompletedLoadJob>& vecBatch = this->m_vecCompletedBatch;
+    CompletedLoadJob stJob;
+    while (this->m_completed.TryPop(stJob) == true)
+        vecBatch.push_back(std::move(stJob));
+    if (this->m_lOverflowCount.load(std::memory_order_acquire) != 0u) {
+        std::lock_guard<std::mutex> lock(this->m_overflowMutex);
+        for (CompletedLoadJob& st : this->m_completedOverflow)
+            vecBatch.push_back(std::move(st));
+        this->m_completedOverflow.clear();
+        this->m_lOverflowCount.store(0u, std::memory_order_relaxed);
     }
-    while (vecBatch.empty() == false) {
-        CompletedLoadJob& st = vecBatch.front();
+    for (CompletedLoadJob& st : vecBatch)
         pHandler_ic(st.eType, st.sPath, std::move(st.vecData));
-        vecBatch.pop();
-    }
+    vecBatch.clear();
 }
 
 JobQueue::~JobQueue() {
@@ -1,23 +1,27 @@
 #pragma once
 
+#include "mpsc_ring.h"
+#include "task_scheduler.h"
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
 
 /*
- * Job type for loader work. LoadFile = read binary file; LoadMesh/LoadTexture reserved for later.
+ * Job type for loader work. LoadFile = read binary file; LoadTexture = read + optional worker-side decode;
+ * LoadMesh reserved for later. Task = CPU work (parse/decode) submitted via SubmitTask; not reported through
+ * ProcessCompletedJobs.
  */
 enum class LoadJobType {
     LoadFile,
     LoadMesh,
     LoadTexture,
+    Task,
 };
 
 /*
@@ -31,7 +35,17 @@ struct LoadFileResult {
 };
 
 /*
- * One completed load job: type, path, and data. Main thread drains these via ProcessCompletedJobs.
+ * Completion handle of a CPU task: the TaskGroup the task was submitted with. Wait with JobQueue::WaitForTask (helps
+ * run queued tasks) or poll IsTaskDone. The handle owns the group, so keep it until the task is done.
+ */
+struct TaskResult {
+    TaskGroup group;
+};
+
+/*
+ * One completed load job: type, path, and data (the file bytes, or what the job's process callback left in them;
+ * empty for SubmitLoadFile jobs, whose bytes are moved into their LoadFileResult). Main thread drains these via
+ * ProcessCompletedJobs.
  */
 struct CompletedLoadJob {
     LoadJobType         eType = LoadJobType::LoadFile;
@@ -40,45 +54,78 @@ struct CompletedLoadJob {
 };
 
 /*
- * Job queue for loader work. Multiple worker threads run load jobs in parallel (use available cores).
+ * Job queue for loader work: a thin layer over TaskScheduler (work-stealing workers, one per core up to 16).
  * SubmitLoadFile() posts a job and returns a result handle; caller may wait on result until bDone.
- * Workers push completed jobs to a queue; main thread calls ProcessCompletedJobs(handler) to drain and dispatch by type.
- * All Vulkan/engine work stays on the calling thread; workers only do I/O (and later: parse/decode).
+ * Workers push completed jobs to a lock-free MPSC ring (a locked overflow list takes them when the ring is full);
+ * main thread calls ProcessCompletedJobs(handler) to drain and dispatch by type.
+ * All Vulkan/engine work stays on the calling thread; workers do I/O plus the CPU-only callbacks they are given.
+ * New parallel code (fork-join, continuations, main-thread tasks) should use GetScheduler() directly.
  */
 class JobQueue {
 public:
     JobQueue() = default;
     ~JobQueue();
 
-    void Start();
+    /*
+     * Start the workers. stOptions_ic sets count and placement (pinning, NUMA groups, reserved main core); the
+     * calling thread is the main thread and is pinned to the reserved core if the plan has one.
+     */
+    void Start(const WorkerPoolOptions& stOptions_ic = WorkerPoolOptions());
     void Stop();
 
     /* Post a load-file job; returns shared result. Caller may wait on result->cv until result->bDone, then use result->vecData. */
     std::shared_ptr<LoadFileResult> SubmitLoadFile(const std::string& sPath);
 
-    /* Post a load-texture job (I/O only; decode/upload on main thread via ProcessCompletedJobs). No wait handle. */
-    void SubmitLoadTexture(const std::string& sPath);
+    /*
+     * Worker-side step of a load job, run right after the read with the file bytes (may consume them).
+     * Must not touch Vulkan objects or engine state owned by the main thread.
+     */
+    using ProcessFn = std::function<void(std::vector<uint8_t>&)>;
+    /*
+     * Post a load-texture job: the worker reads the file, runs fnProcess_ic (decode/cook) if set, and reports the
+     * job through ProcessCompletedJobs, where the main thread only uploads. No wait handle.
+     */
+    void SubmitLoadTexture(const std::string& sPath, ProcessFn fnProcess_ic = nullptr);
 
-    /* Drain completed jobs and call handler for each (type, path, data). Call from main thread; handler may create Vulkan objects. */
+    /*
+     * Post a CPU task (file read + parse, vertex extraction, image decode). The task must not touch Vulkan or
+     * engine managers; the caller collects its output after WaitForTask. Runs inline if no workers are running.
+     */
+    std::shared_ptr<TaskResult> SubmitTask(std::function<void()> fnTask);
+    /*
+     * Return once the task has finished. Goes through TaskScheduler::Wait: the calling thread runs queued tasks
+     * meanwhile, so a worker waiting on a task still sitting in its own deque runs it instead of deadlocking.
+     */
+    void WaitForTask(const std::shared_ptr<TaskResult>& pResult_ic);
+    /* Non-blocking completion check (per-frame polling, e.g. progressive level load). */
+    static bool IsTaskDone(const std::shared_ptr<TaskResult>& pResult_ic);
+    /* Number of worker threads (0 before Start / after Stop). */
+    size_t GetWorkerThreadCount() const { return this->m_scheduler.GetWorkerCount(); }
+    TaskScheduler& GetScheduler() { return this->m_scheduler; }
+    const TaskScheduler& GetScheduler() const { return this->m_scheduler; }
+
+    /*
+     * Run queued MainThread tasks, then drain completed jobs and call handler for each (type, path, data).
+     * Call from main thread; handler may create Vulkan objects.
+     */
     using CompletedJobHandler = std::function<void(LoadJobType, const std::string&, std::vector<uint8_t>)>;
     void ProcessCompletedJobs(const CompletedJobHandler& pHandler_ic);
 
 private:
-    struct Job {
-        LoadJobType eType = LoadJobType::LoadFile;
-        std::string sPath;
-        std::shared_ptr<LoadFileResult> pResult;
-    };
-
-    void WorkerLoop();
+    /* Worker body of SubmitLoadFile / SubmitLoadTexture: read, process, signal, report. */
+    void RunLoadJob(LoadJobType eType_ic, const std::string& sPath_ic, const std::shared_ptr<LoadFileResult>& pResult_ic,
+                    const ProcessFn& fnProcess_ic);
     static std::vector<uint8_t> ReadFileBinary(const std::string& sPath);
-    static unsigned int GetWorkerCount();
 
-    std::queue<Job>            m_queue;
-    std::mutex                 m_mutex;
-    std::condition_variable    m_cv;
-    std::queue<CompletedLoadJob> m_completed;
-    std::mutex                 m_completedMutex;
-    std::atomic<bool>          m_stop{false};
-    std::vector<std::thread>   m_workers;
+    /* Worker side: hand a finished job to the main thread. */
+    void PushCompleted(CompletedLoadJob& stJob_io);
+
+    static constexpr uint32_t kCompletedRingCapacity = 256u;
+
+    TaskScheduler              m_scheduler;
+    MpscRing<CompletedLoadJob> m_completed{ kCompletedRingCapacity };
+    std::mutex                 m_overflowMutex;
+    std::vector<CompletedLoadJob> m_completedOverflow;  // Ring was full (level load bursts)
+    std::atomic<uint32_t>      m_lOverflowCount{0u};
+    std::vector<CompletedLoadJob> m_vecCompletedBatch;  // ProcessCompletedJobs scratch (main thread)
 };
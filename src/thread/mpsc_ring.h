@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/*
+ * Bounded lock-free multi-producer / single-consumer ring (D. Vyukov's bounded queue with per-slot sequence
+ * numbers, consumer side simplified for one thread). Producers claim a slot with one CAS on the tail and publish
+ * it with a release store of its sequence; the consumer never writes shared indices other than the slot's.
+ * TryPush returns false when full: the caller falls back to a locked overflow path instead of blocking.
+ */
+template <typename T>
+class MpscRing {
+public:
+    /* lCapacity_ic is rounded up to a power of two. T must be default-constructible and movable. */
+    explicit MpscRing(uint32_t lCapacity_ic = 256u) {
+        uint32_t lCapacity = 2u;
+        while (lCapacity < lCapacity_ic)
+            lCapacity <<= 1u;
+        this->m_uMask = lCapacity - 1u;
+        this->m_pCells = std::make_unique<Cell[]>(lCapacity);
+        for (uint32_t i = 0u; i < lCapacity; ++i)
+            this->m_pCells[i].uSeq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /* Any thread. Moves from item_io on success; leaves it untouched and returns false when the ring is full. */
+    bool TryPush(T& item_io) {
+        uint64_t uPos = this->m_uTail.load(std::memory_order_relaxed);
+        Cell* pCell = nullptr;
+        while (true) {
+            pCell = &this->m_pCells[uPos & this->m_uMask];
+            const uint64_t uSeq = pCell->uSeq.load(std::memory_order_acquire);
+            const int64_t iDiff = static_cast<int64_t>(uSeq) - static_cast<int64_t>(uPos);
+            if (iDiff == 0) {
+                if (this->m_uTail.compare_exchange_weak(uPos, uPos + 1u, std::memory_order_relaxed) == true)
+                    break;
+            } else if (iDiff < 0) {
+                return false;  // Slot still holds an item from the previous lap
+            } else {
+                uPos = this->m_uTail.load(std::memory_order_relaxed);
+            }
+        }
+        pCell->value = std::move(item_io);
+        pCell->uSeq.store(uPos + 1u, std::memory_order_release);
+        return true;
+    }
+
+    /* Consumer thread only. False when empty (or the oldest claimed slot is not published yet). */
+    bool TryPop(T& item_out) {
+        Cell& cell = this->m_pCells[this->m_uHead & this->m_uMask];
+        if (cell.uSeq.load(std::memory_order_acquire) != this->m_uHead + 1u)
+            return false;
+        item_out = std::move(cell.value);
+        cell.value = T{};  // Release what the moved-from item still owns now, not a lap later
+        cell.uSeq.store(this->m_uHead + this->m_uMask + 1u, std::memory_order_release);
+        ++this->m_uHead;
+        return true;
+    }
+
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(this->m_uMask + 1u); }
+
+private:
+    struct Cell {
+        std::atomic<uint64_t> uSeq{0u};
+        T value{};
+    };
+
+    alignas(64) std::atomic<uint64_t> m_uTail{0u};  // Producers
+    alignas(64) uint64_t m_uHead = 0u;              // Consumer
+    uint64_t m_uMask = 0u;
+    std::unique_ptr<Cell[]> m_pCells;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/*
+ * Unbounded FIFO on a power-of-two ring that only grows (doubling when full) and never shrinks. Unlike std::deque,
+ * which frees and allocates a block whenever the head and tail cross block boundaries, a queue that reached its
+ * working size stops touching the heap. Not thread-safe (callers hold their own lock). T must be default-
+ * constructible and movable; cheap types (pointers) are the intended use.
+ */
+template <typename T>
+class RingQueue {
+public:
+    /* lCapacity_ic is rounded up to a power of two. */
+    explicit RingQueue(uint32_t lCapacity_ic = 64u) { this->Grow(lCapacity_ic); }
+
+    RingQueue(const RingQueue&) = delete;
+    RingQueue& operator=(const RingQueue&) = delete;
+
+    bool Empty() const { return this->m_lSize == 0u; }
+    uint32_t Size() const { return this->m_lSize; }
+
+    void PushBack(T item_in) {
+        if (this->m_lSize > this->m_lMask)
+            this->Grow((this->m_lMask + 1u) * 2u);
+        this->m_pItems[(this->m_lHead + this->m_lSize) & this->m_lMask] = std::move(item_in);
+        ++this->m_lSize;
+    }
+    void PushFront(T item_in) {
+        if (this->m_lSize > this->m_lMask)
+            this->Grow((this->m_lMask + 1u) * 2u);
+        this->m_lHead = (this->m_lHead - 1u) & this->m_lMask;
+        this->m_pItems[this->m_lHead] = std::move(item_in);
+        ++this->m_lSize;
+    }
+    /* Must not be empty. */
+    T PopFront() {
+        T item = std::move(this->m_pItems[this->m_lHead]);
+        this->m_lHead = (this->m_lHead + 1u) & this->m_lMask;
+        --this->m_lSize;
+        return item;
+    }
+    /* Exchange contents and buffers (no allocation). */
+    void Swap(RingQueue& other_io) {
+        std::swap(this->m_pItems, other_io.m_pItems);
+        std::swap(this->m_lMask, other_io.m_lMask);
+        std::swap(this->m_lHead, other_io.m_lHead);
+        std::swap(this->m_lSize, other_io.m_lSize);
+    }
+
+private:
+    void Grow(uint32_t lCapacity_ic) {
+        uint32_t lCapacity = 2u;
+        while (lCapacity < lCapacity_ic)
+            lCapacity <<= 1u;
+        std::unique_ptr<T[]> pItems = std::make_unique<T[]>(lCapacity);
+        for (uint32_t i = 0u; i < this->m_lSize; ++i)
+            pItems[i] = std::move(this->m_pItems[(this->m_lHead + i) & this->m_lMask]);
+        this->m_pItems = std::move(pItems);
+        this->m_lMask = lCapacity - 1u;
+        this->m_lHead = 0u;
+    }
+
+    std::unique_ptr<T[]> m_pItems;
+    uint32_t m_lMask = 0u;
+    uint32_t m_lHead = 0u;
+    uint32_t m_lSize = 0u;
+};
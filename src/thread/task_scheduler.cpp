@@ -0,0 +1,443 @@
+/*
+ * TaskScheduler — work-stealing worker pool with task groups, continuations and main-thread tasks.
+ */
+#include "task_scheduler.h"
+#include "vulkan/vulkan_utils.h"
+#include <algorithm>
+
+/* One queued unit of work. */
+struct SchedulerTask {
+    TaskFunction fn;
+    TaskGroup*   pGroup = nullptr;
+    TaskAffinity eAffinity = TaskAffinity::Any;
+};
+
+namespace {
+
+/* Task objects created by Start: more than a frame has in flight, so steady-state submits never reach `new`. */
+constexpr size_t kPreallocatedTasks = 256u;
+
+/* Worker identity of the calling thread (set once per worker thread). */
+thread_local const TaskScheduler* t_pWorkerScheduler = nullptr;
+thread_local uint32_t t_lWorkerIndex = UINT32_MAX;
+/* xorshift32 state for victim selection; seeded per thread. */
+thread_local uint32_t t_lRandom = 0u;
+
+uint32_t NextRandom() {
+    if (t_lRandom == 0u)
+        t_lRandom = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+    t_lRandom ^= t_lRandom << 13;
+    t_lRandom ^= t_lRandom >> 17;
+    t_lRandom ^= t_lRandom << 5;
+    return t_lRandom;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// TaskGroup
+// -----------------------------------------------------------------------------
+TaskGroup::~TaskGroup() {
+    /* The last task releases the mutex after its final decrement: wait until it has. */
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+}
+
+// -----------------------------------------------------------------------------
+// TaskScheduler
+// -----------------------------------------------------------------------------
+TaskScheduler::~TaskScheduler() {
+    this->Stop();
+    for (SchedulerTask* pTask : this->m_vecFreeTasks)
+        delete pTask;
+}
+
+void TaskScheduler::Start(uint32_t lWorkers_ic, const std::vector<WorkerPlacement>* pPlacement_ic) {
+    if (this->m_workers.empty() == false)
+        return;
+    this->m_mainThreadId = std::this_thread::get_id();
+    this->m_bStop.store(false);
+    this->m_vecWorkerState.clear();
+    this->m_bGrouped = false;
+    for (uint32_t i = 0u; i < lWorkers_ic; ++i) {
+        this->m_vecWorkerState.push_back(std::make_unique<Worker>());
+        if ((pPlacement_ic != nullptr) && (i < pPlacement_ic->size())) {
+            this->m_vecWorkerState[i]->placement = (*pPlacement_ic)[i];
+            this->m_bGrouped |= (this->m_vecWorkerState[i]->placement.lGroup != this->m_vecWorkerState[0]->placement.lGroup);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->m_poolMutex);
+        this->m_vecFreeTasks.reserve(kPreallocatedTasks);
+        while (this->m_vecFreeTasks.size() < kPreallocatedTasks)
+            this->m_vecFreeTasks.push_back(new SchedulerTask);
+    }
+    // Tasks submitted before Start sit in the shared queue and are picked up now
+    this->m_workers.reserve(lWorkers_ic);
+    for (uint32_t i = 0u; i < lWorkers_ic; ++i)
+        this->m_workers.emplace_back(&TaskScheduler::WorkerLoop, this, i);
+}
+
+void TaskScheduler::Stop() {
+    if (this->m_workers.empty() == true)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+        this->m_bStop.store(true);
+    }
+    this->m_sleepCv.notify_all();
+    for (std::thread& t : this->m_workers) {
+        if (t.joinable() == true)
+            t.join();
+    }
+    this->m_workers.clear();
+
+    const TaskSchedulerStats stStats = this->GetStats();
+    VulkanUtils::LogDebug("TaskScheduler: {} tasks ({} local, {} shared, {} stolen ({} across groups), {} failed steals, {} contended, {} sleeps)",
+                          stStats.uExecuted, stStats.uLocalPops, stStats.uInjectedPops, stStats.uSteals,
+                          stStats.uCrossGroupSteals, stStats.uFailedSteals, stStats.uSharedContended, stStats.uSleeps);
+
+    // Drop what never ran; complete its groups so nobody waits forever (released continuations are dropped too)
+    size_t zDropped = 0u;
+    std::vector<SchedulerTask*> vecLeft;
+    do {
+        vecLeft.clear();
+        for (std::unique_ptr<Worker>& pWorker : this->m_vecWorkerState) {
+            while (SchedulerTask* pTask = pWorker->deque.Pop())
+                vecLeft.push_back(pTask);
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->m_sharedMutex);
+            while (this->m_sharedQueue.Empty() == false)
+                vecLeft.push_back(this->m_sharedQueue.PopFront());
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->m_mainMutex);
+            while (this->m_mainQueue.Empty() == false)
+                vecLeft.push_back(this->m_mainQueue.PopFront());
+        }
+        for (SchedulerTask* pTask : vecLeft) {
+            TaskGroup* pGroup = pTask->pGroup;
+            this->FreeTask(pTask);
+            this->FinishTask(pGroup);
+        }
+        zDropped += vecLeft.size();
+    } while (vecLeft.empty() == false);
+    this->m_iQueued.store(0);
+    if (zDropped != 0u)
+        VulkanUtils::LogWarn("TaskScheduler: dropped {} queued tasks at shutdown", zDropped);
+}
+
+uint32_t TaskScheduler::GetCurrentWorkerIndex() const {
+    return (t_pWorkerScheduler == this) ? t_lWorkerIndex : kNotWorker;
+}
+
+uint32_t TaskScheduler::GetThreadSlot() const {
+    const uint32_t lWorker = this->GetCurrentWorkerIndex();
+    return (lWorker != kNotWorker) ? lWorker : this->GetWorkerCount();
+}
+
+TaskScheduler::Counters& TaskScheduler::GetCounters(uint32_t lWorkerIndex_ic) {
+    return (lWorkerIndex_ic < this->m_vecWorkerState.size()) ? this->m_vecWorkerState[lWorkerIndex_ic]->stats : this->m_helperStats;
+}
+
+void TaskScheduler::Submit(TaskFunction fnTask_in, TaskGroup* pGroup_io, TaskAffinity eAffinity_ic, TaskPriority ePriority_ic) {
+    if (pGroup_io != nullptr)
+        pGroup_io->m_lPending.fetch_add(1u, std::memory_order_relaxed);
+    this->Enqueue(this->AllocateTask(std::move(fnTask_in), pGroup_io, eAffinity_ic), ePriority_ic);
+}
+
+void TaskScheduler::Then(TaskGroup& group_io, TaskFunction fnTask_in, TaskGroup* pGroup_io, TaskAffinity eAffinity_ic) {
+    if (pGroup_io != nullptr)
+        pGroup_io->m_lPending.fetch_add(1u, std::memory_order_relaxed);
+    SchedulerTask* pTask = this->AllocateTask(std::move(fnTask_in), pGroup_io, eAffinity_ic);
+    {
+        std::lock_guard<std::mutex> lock(group_io.m_mutex);
+        if (group_io.m_lPending.load(std::memory_order_acquire) != 0u) {
+            group_io.m_vecContinuations.push_back(pTask);
+            return;
+        }
+    }
+    this->Enqueue(pTask);
+}
+
+SchedulerTask* TaskScheduler::AllocateTask(TaskFunction fnTask_in, TaskGroup* pGroup_io, TaskAffinity eAffinity_ic) {
+    SchedulerTask* pTask = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(this->m_poolMutex);
+        if (this->m_vecFreeTasks.empty() == false) {
+            pTask = this->m_vecFreeTasks.back();
+            this->m_vecFreeTasks.pop_back();
+        }
+    }
+    if (pTask == nullptr)
+        pTask = new SchedulerTask;
+    pTask->fn = std::move(fnTask_in);
+    pTask->pGroup = pGroup_io;
+    pTask->eAffinity = eAffinity_ic;
+    return pTask;
+}
+
+void TaskScheduler::FreeTask(SchedulerTask* pTask_in) {
+    pTask_in->fn = nullptr;  // Captures are destroyed outside the pool lock
+    pTask_in->pGroup = nullptr;
+    std::lock_guard<std::mutex> lock(this->m_poolMutex);
+    this->m_vecFreeTasks.push_back(pTask_in);
+}
+
+void TaskScheduler::Enqueue(SchedulerTask* pTask_in, TaskPriority ePriority_ic) {
+    if (pTask_in->eAffinity == TaskAffinity::MainThread) {
+        {
+            std::lock_guard<std::mutex> lock(this->m_mainMutex);
+            this->m_mainQueue.PushBack(pTask_in);
+        }
+        this->WakeHelpers();  // The main thread may be helping in Wait
+        return;
+    }
+    this->m_iQueued.fetch_add(1);
+    const uint32_t lWorker = this->GetCurrentWorkerIndex();
+    bool bQueued = false;
+    if ((lWorker != kNotWorker) && (ePriority_ic == TaskPriority::Normal)) {
+        bQueued = this->m_vecWorkerState[lWorker]->deque.Push(pTask_in);
+        if (bQueued == false)
+            this->m_uDequeOverflows.fetch_add(1u, std::memory_order_relaxed);
+    }
+    if (bQueued == false) {
+        std::unique_lock<std::mutex> lock(this->m_sharedMutex, std::try_to_lock);
+        if (lock.owns_lock() == false) {
+            this->m_uSharedContended.fetch_add(1u, std::memory_order_relaxed);
+            lock.lock();
+        }
+        if (ePriority_ic == TaskPriority::High)
+            this->m_sharedQueue.PushFront(pTask_in);
+        else
+            this->m_sharedQueue.PushBack(pTask_in);
+    }
+    // Wake one sleeper, and only if there is one (m_iQueued was raised first: see WorkerLoop)
+    if (this->m_lSleeping.load() != 0u) {
+        std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+        this->m_sleepCv.notify_one();
+    }
+    this->WakeHelpers();
+}
+
+void TaskScheduler::WakeHelpers() {
+    /* Same handshake as the worker sleep: the epoch is bumped before the waiter count is read (both seq_cst). */
+    this->m_uHelpEpoch.fetch_add(1u);
+    if (this->m_lHelpersWaiting.load() != 0u) {
+        std::lock_guard<std::mutex> lock(this->m_sleepMutex);
+        this->m_helpCv.notify_all();
+    }
+}
+
+SchedulerTask* TaskScheduler::PopShared() {
+    std::unique_lock<std::mutex> lock(this->m_sharedMutex, std::try_to_lock);
+    if (lock.owns_lock() == false) {
+        this->m_uSharedContended.fetch_add(1u, std::memory_order_relaxed);
+        lock.lock();
+    }
+    if (this->m_sharedQueue.Empty() == true)
+        return nullptr;
+    return this->m_sharedQueue.PopFront();
+}
+
+SchedulerTask* TaskScheduler::PopMainThread() {
+    std::lock_guard<std::mutex> lock(this->m_mainMutex);
+    if (this->m_mainQueue.Empty() == true)
+        return nullptr;
+    return this->m_mainQueue.PopFront();
+}
+
+SchedulerTask* TaskScheduler::FindTask(uint32_t lSelfIndex_ic, Counters& stats_io) {
+    if (this->m_iQueued.load(std::memory_order_relaxed) <= 0)
+        return nullptr;
+    SchedulerTask* pTask = nullptr;
+    if (lSelfIndex_ic != kNotWorker) {
+        pTask = this->m_vecWorkerState[lSelfIndex_ic]->deque.Pop();
+        if (pTask != nullptr) {
+            stats_io.uLocalPops.fetch_add(1u, std::memory_order_relaxed);
+            this->m_iQueued.fetch_sub(1);
+            return pTask;
+        }
+    }
+    pTask = this->PopShared();
+    if (pTask != nullptr) {
+        stats_io.uInjectedPops.fetch_add(1u, std::memory_order_relaxed);
+        this->m_iQueued.fetch_sub(1);
+        return pTask;
+    }
+    // Grouped workers try their own group (NUMA node) before crossing over
+    if ((this->m_bGrouped == true) && (lSelfIndex_ic != kNotWorker)) {
+        pTask = this->StealPass(lSelfIndex_ic, StealScope::OwnGroup, stats_io);
+        return (pTask != nullptr) ? pTask : this->StealPass(lSelfIndex_ic, StealScope::OtherGroups, stats_io);
+    }
+    return this->StealPass(lSelfIndex_ic, StealScope::All, stats_io);
+}
+
+SchedulerTask* TaskScheduler::StealPass(uint32_t lSelfIndex_ic, StealScope eScope_ic, Counters& stats_io) {
+    const uint32_t lCount = static_cast<uint32_t>(this->m_vecWorkerState.size());
+    if (lCount == 0u)
+        return nullptr;
+    const uint32_t lOwnGroup = (lSelfIndex_ic < lCount) ? this->m_vecWorkerState[lSelfIndex_ic]->placement.lGroup : 0u;
+    const uint32_t lStart = NextRandom() % lCount;
+    for (uint32_t i = 0u; i < lCount; ++i) {
+        const uint32_t lVictim = (lStart + i) % lCount;
+        if ((lVictim == lSelfIndex_ic) || (this->m_vecWorkerState[lVictim]->deque.SizeApprox() <= 0))
+            continue;
+        const bool bSameGroup = (this->m_vecWorkerState[lVictim]->placement.lGroup == lOwnGroup);
+        if (((eScope_ic == StealScope::OwnGroup) && (bSameGroup == false)) ||
+            ((eScope_ic == StealScope::OtherGroups) && (bSameGroup == true)))
+            continue;
+        SchedulerTask* pTask = this->m_vecWorkerState[lVictim]->deque.Steal();
+        if (pTask != nullptr) {
+            stats_io.uSteals.fetch_add(1u, std::memory_order_relaxed);
+            if (eScope_ic == StealScope::OtherGroups)
+                stats_io.uCrossGroupSteals.fetch_add(1u, std::memory_order_relaxed);
+            this->m_iQueued.fetch_sub(1);
+            return pTask;
+        }
+        stats_io.uFailedSteals.fetch_add(1u, std::memory_order_relaxed);
+    }
+    return nullptr;
+}
+
+void TaskScheduler::Execute(SchedulerTask* pTask_in, Counters& stats_io) {
+    if (pTask_in->fn)
+        pTask_in->fn();
+    TaskGroup* pGroup = pTask_in->pGroup;
+    this->FreeTask(pTask_in);
+    stats_io.uExecuted.fetch_add(1u, std::memory_order_relaxed);
+    this->FinishTask(pGroup);
+}
+
+void TaskScheduler::FinishTask(TaskGroup* pGroup_io) {
+    if (pGroup_io == nullptr)
+        return;
+    std::vector<SchedulerTask*> vecContinuations;
+    {
+        /* Decrement under the lock: a waiter that sees zero may destroy the group once it can take the mutex. */
+        std::lock_guard<std::mutex> lock(pGroup_io->m_mutex);
+        if (pGroup_io->m_lPending.fetch_sub(1u, std::memory_order_acq_rel) != 1u)
+            return;
+        vecContinuations.swap(pGroup_io->m_vecContinuations);
+        pGroup_io->m_cv.notify_all();
+    }
+    // The group may be gone now; only scheduler state is touched from here on
+    this->WakeHelpers();
+    for (SchedulerTask* pTask : vecContinuations)
+        this->Enqueue(pTask);
+}
+
+void TaskScheduler::WorkerLoop(uint32_t lIndex_ic) {
+    t_pWorkerScheduler = this;
+    t_lWorkerIndex = lIndex_ic;
+    const WorkerPlacement& stPlacement = this->m_vecWorkerState[lIndex_ic]->placement;
+    if ((stPlacement.vecCpus.empty() == false) && (SetCurrentThreadAffinity(stPlacement.vecCpus) == false))
+        VulkanUtils::LogWarn("TaskScheduler: could not set the CPU affinity of worker {}", lIndex_ic);
+    Counters& stats = this->m_vecWorkerState[lIndex_ic]->stats;
+    while (this->m_bStop.load() == false) {
+        SchedulerTask* pTask = this->FindTask(lIndex_ic, stats);
+        if (pTask != nullptr) {
+            this->Execute(pTask, stats);
+            continue;
+        }
+        /*
+         * Sleep until something is queued. m_lSleeping is raised before m_iQueued is re-read and Enqueue raises
+         * m_iQueued before reading m_lSleeping (both seq_cst), so a submit cannot slip between check and wait.
+         */
+        std::unique_lock<std::mutex> lock(this->m_sleepMutex);
+        this->m_lSleeping.fetch_add(1u);
+        if ((this->m_iQueued.load() <= 0) && (this->m_bStop.load() == false)) {
+            stats.uSleeps.fetch_add(1u, std::memory_order_relaxed);
+            this->m_sleepCv.wait(lock, [this]() { return (this->m_iQueued.load() > 0) || (this->m_bStop.load() == true); });
+        }
+        this->m_lSleeping.fetch_sub(1u);
+    }
+    t_pWorkerScheduler = nullptr;
+    t_lWorkerIndex = kNotWorker;
+}
+
+void TaskScheduler::Wait(TaskGroup& group_io) {
+    const uint32_t lSelf = this->GetCurrentWorkerIndex();
+    Counters& stats = this->GetCounters(lSelf);
+    const bool bMainThread = this->IsMainThread();
+    while (group_io.IsDone() == false) {
+        // Read before looking for work: anything queued or finished after this point changes it
+        const uint32_t uEpoch = this->m_uHelpEpoch.load();
+        SchedulerTask* pTask = this->FindTask(lSelf, stats);
+        if (pTask != nullptr) {
+            this->Execute(pTask, stats);
+            continue;
+        }
+        if (bMainThread == true) {
+            pTask = this->PopMainThread();
+            if (pTask != nullptr) {
+                this->Execute(pTask, stats);
+                this->m_uMainThreadRun.fetch_add(1u, std::memory_order_relaxed);
+                continue;
+            }
+        }
+        // Remaining tasks are running elsewhere: sleep until one finishes a group or more work is queued
+        std::unique_lock<std::mutex> lock(this->m_sleepMutex);
+        this->m_lHelpersWaiting.fetch_add(1u);
+        this->m_helpCv.wait(lock, [this, &group_io, uEpoch]() {
+            return (group_io.IsDone() == true) || (this->m_uHelpEpoch.load() != uEpoch);
+        });
+        this->m_lHelpersWaiting.fetch_sub(1u);
+    }
+    /* Let the finishing thread leave the group's mutex before the caller may destroy the group. */
+    std::lock_guard<std::mutex> lock(group_io.m_mutex);
+}
+
+void TaskScheduler::ParallelForRanges(uint32_t lCount_ic, uint32_t lGrain_ic, void* pContext_ic,
+                                      void (*pfnRange_ic)(void*, uint32_t, uint32_t), TaskPriority ePriority_ic) {
+    if (lCount_ic == 0u)
+        return;
+    const uint32_t lGrain = std::max(lGrain_ic, 1u);
+    if ((this->m_workers.empty() == true) || (lCount_ic <= lGrain)) {
+        pfnRange_ic(pContext_ic, 0u, lCount_ic);
+        return;
+    }
+    TaskGroup group;
+    for (uint32_t lBegin = lGrain; lBegin < lCount_ic; lBegin += lGrain) {
+        const uint32_t lEnd = std::min(lBegin + lGrain, lCount_ic);
+        this->Submit([pContext_ic, pfnRange_ic, lBegin, lEnd]() { pfnRange_ic(pContext_ic, lBegin, lEnd); }, &group,
+                     TaskAffinity::Any, ePriority_ic);
+    }
+    pfnRange_ic(pContext_ic, 0u, lGrain);
+    this->Wait(group);
+}
+
+uint32_t TaskScheduler::RunMainThreadTasks() {
+    // Only what is queued now: tasks queued by these tasks run next call
+    {
+        std::lock_guard<std::mutex> lock(this->m_mainMutex);
+        this->m_mainBatch.Swap(this->m_mainQueue);
+    }
+    const uint32_t lCount = this->m_mainBatch.Size();
+    while (this->m_mainBatch.Empty() == false)
+        this->Execute(this->m_mainBatch.PopFront(), this->m_helperStats);
+    this->m_uMainThreadRun.fetch_add(lCount, std::memory_order_relaxed);
+    return lCount;
+}
+
+TaskSchedulerStats TaskScheduler::GetStats() const {
+    TaskSchedulerStats stStats;
+    stStats.lWorkers = static_cast<uint32_t>(this->m_workers.size());
+    auto add = [&stStats](const Counters& st) {
+        stStats.uExecuted     += st.uExecuted.load(std::memory_order_relaxed);
+        stStats.uLocalPops    += st.uLocalPops.load(std::memory_order_relaxed);
+        stStats.uInjectedPops += st.uInjectedPops.load(std::memory_order_relaxed);
+        stStats.uSteals       += st.uSteals.load(std::memory_order_relaxed);
+        stStats.uCrossGroupSteals += st.uCrossGroupSteals.load(std::memory_order_relaxed);
+        stStats.uFailedSteals += st.uFailedSteals.load(std::memory_order_relaxed);
+        stStats.uSleeps       += st.uSleeps.load(std::memory_order_relaxed);
+    };
+    for (const std::unique_ptr<Worker>& pWorker : this->m_vecWorkerState)
+        add(pWorker->stats);
+    add(this->m_helperStats);
+    stStats.uMainThreadRun   = this->m_uMainThreadRun.load(std::memory_order_relaxed);
+    stStats.uExecuted       -= std::min(stStats.uExecuted, stStats.uMainThreadRun);
+    stStats.uSharedContended = this->m_uSharedContended.load(std::memory_order_relaxed);
+    stStats.uDequeOverflows  = this->m_uDequeOverflows.load(std::memory_order_relaxed);
+    return stStats;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "cpu_topology.h"
+#include "inplace_function.h"
+#include "ring_queue.h"
+#include "work_stealing_deque.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/* Where a task may run. MainThread tasks only run in TaskScheduler::RunMainThreadTasks / Wait on the main thread. */
+enum class TaskAffinity : uint8_t {
+    Any,
+    MainThread,
+};
+
+/* Queue position of a task. High tasks go to the front of the shared queue (frame-critical work ahead of loads). */
+enum class TaskPriority : uint8_t {
+    Normal,
+    High,
+};
+
+/*
+ * Task body. Stored inline in the task (no allocation per submit); captures must fit in 80 bytes, which holds a
+ * std::string plus a std::function and a pointer. Larger state goes behind a pointer.
+ */
+using TaskFunction = InplaceFunction<void(), 80>;
+
+struct SchedulerTask;
+
+/*
+ * Completion counter for fork-join: every task submitted with a group increments it, every finished task
+ * decrements it. Continuations registered with TaskScheduler::Then are submitted when it reaches zero.
+ * The group must outlive its tasks (destroy it only after TaskScheduler::Wait returns). Reusable once done.
+ */
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    bool IsDone() const { return this->m_lPending.load(std::memory_order_acquire) == 0u; }
+
+private:
+    friend class TaskScheduler;
+
+    std::atomic<uint32_t> m_lPending{0u};
+    std::mutex m_mutex;                  // Guards the last decrement, continuations and the wake-up
+    std::condition_variable m_cv;
+    std::vector<SchedulerTask*> m_vecContinuations;
+};
+
+/* Counters since Start (summed over workers; see TaskScheduler::GetStats). */
+struct TaskSchedulerStats {
+    uint32_t lWorkers         = 0u;
+    uint64_t uExecuted        = 0u;  // Tasks run on workers and helping threads (main-thread tasks excluded)
+    uint64_t uMainThreadRun   = 0u;  // MainThread tasks run
+    uint64_t uLocalPops       = 0u;  // Taken from the running worker's own deque
+    uint64_t uInjectedPops    = 0u;  // Taken from the shared queue (submits from non-worker threads, full deques)
+    uint64_t uSteals          = 0u;  // Taken from another worker's deque
+    uint64_t uCrossGroupSteals = 0u; // Of those, taken from a worker of another group (NUMA node)
+    uint64_t uFailedSteals    = 0u;  // Steal attempts that found nothing or lost a race
+    uint64_t uSharedContended = 0u;  // Shared-queue lock acquisitions that had to wait
+    uint64_t uDequeOverflows  = 0u;  // Worker submits that went to the shared queue because the deque was full
+    uint64_t uSleeps          = 0u;  // Times a worker went idle
+};
+
+/*
+ * TaskScheduler — work-stealing thread pool. Each worker owns a Chase-Lev deque: tasks submitted from a worker go
+ * to its own deque (LIFO for the owner); tasks submitted from other threads go to one shared queue. Idle workers
+ * pop locally, then the shared queue, then steal from other workers, and sleep only when nothing is queued anywhere
+ * (submits wake one sleeper, and only if someone sleeps). TaskPriority::High submits skip the deque and go to the
+ * front of the shared queue.
+ *
+ * Workers may be placed (WorkerPlacement: CPU set + steal group). Workers of one group steal from each other before
+ * trying other groups, so with one group per NUMA node tasks (and the data they touch) stay on their node.
+ *
+ * Wait(group) helps: the waiting thread runs queued tasks (plus MainThread tasks on the main thread) until the
+ * group is done, so nested fork-join from inside a task cannot deadlock the pool.
+ * Tasks must not touch Vulkan or main-thread-owned engine state unless submitted with TaskAffinity::MainThread.
+ */
+class TaskScheduler {
+public:
+    TaskScheduler() = default;
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /*
+     * Start lWorkers_ic threads. The calling thread becomes the main thread (MainThread affinity).
+     * pPlacement_ic (optional, one entry per worker): each worker restricts itself to its CPUs and steals within its
+     * group first.
+     */
+    void Start(uint32_t lWorkers_ic, const std::vector<WorkerPlacement>* pPlacement_ic = nullptr);
+    /* Join the workers. Tasks still queued are dropped (their groups are completed so no waiter hangs). */
+    void Stop();
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(this->m_workers.size()); }
+    bool IsMainThread() const { return std::this_thread::get_id() == this->m_mainThreadId; }
+    /*
+     * Index of the calling thread for per-thread state: worker i -> i, any other thread -> GetWorkerCount().
+     * Unique per thread as long as tasks only run on the workers and one other (the main) thread.
+     */
+    uint32_t GetThreadSlot() const;
+
+    /* Queue fnTask_in. pGroup_io (optional) is incremented now and decremented when the task has run. */
+    void Submit(TaskFunction fnTask_in, TaskGroup* pGroup_io = nullptr, TaskAffinity eAffinity_ic = TaskAffinity::Any,
+                TaskPriority ePriority_ic = TaskPriority::Normal);
+    /*
+     * Continuation: submit fnTask_in once every task of group_io has finished (immediately if it is done).
+     * pGroup_io counts the continuation itself (may be another group for chaining).
+     */
+    void Then(TaskGroup& group_io, TaskFunction fnTask_in, TaskGroup* pGroup_io = nullptr,
+              TaskAffinity eAffinity_ic = TaskAffinity::Any);
+    /* Run queued tasks on the calling thread until group_io is done; sleeps (no polling) while nothing is runnable. */
+    void Wait(TaskGroup& group_io);
+    /*
+     * Split [0, lCount_ic) into ranges of lGrain_ic and run fnRange_ic(begin, end) on them in parallel; the calling
+     * thread takes the first range and then helps. Returns when every range is done. Inline without workers.
+     * TaskPriority::High for ranges the frame waits on (ahead of queued load jobs). fnRange_ic is called by
+     * reference (no std::function: large captures would allocate on every call).
+     */
+    template <typename Fn>
+    void ParallelFor(uint32_t lCount_ic, uint32_t lGrain_ic, Fn&& fnRange_ic, TaskPriority ePriority_ic = TaskPriority::Normal) {
+        using Callable = std::remove_reference_t<Fn>;
+        this->ParallelForRanges(lCount_ic, lGrain_ic, const_cast<void*>(static_cast<const void*>(std::addressof(fnRange_ic))),
+                                [](void* pContext, uint32_t lBegin, uint32_t lEnd) { (*static_cast<Callable*>(pContext))(lBegin, lEnd); },
+                                ePriority_ic);
+    }
+    /* Main thread, once per frame: run the MainThread tasks queued so far. Returns how many ran. */
+    uint32_t RunMainThreadTasks();
+
+    TaskSchedulerStats GetStats() const;
+
+private:
+    /* Counters of one worker (or of every helping thread); relaxed, read only by GetStats. */
+    struct alignas(64) Counters {
+        std::atomic<uint64_t> uExecuted{0u};
+        std::atomic<uint64_t> uLocalPops{0u};
+        std::atomic<uint64_t> uInjectedPops{0u};
+        std::atomic<uint64_t> uSteals{0u};
+        std::atomic<uint64_t> uCrossGroupSteals{0u};
+        std::atomic<uint64_t> uFailedSteals{0u};
+        std::atomic<uint64_t> uSleeps{0u};
+    };
+    /* Per-worker state (own cache lines: the deque indices and counters are hot). */
+    struct alignas(64) Worker {
+        WorkStealingDeque<SchedulerTask> deque;
+        Counters stats;
+        WorkerPlacement placement;
+    };
+
+    void WorkerLoop(uint32_t lIndex_ic);
+    void ParallelForRanges(uint32_t lCount_ic, uint32_t lGrain_ic, void* pContext_ic,
+                           void (*pfnRange_ic)(void*, uint32_t, uint32_t), TaskPriority ePriority_ic);
+    /* Task objects come from a free list (pre-filled by Start): no allocation per submit below the peak in flight. */
+    SchedulerTask* AllocateTask(TaskFunction fnTask_in, TaskGroup* pGroup_io, TaskAffinity eAffinity_ic);
+    void FreeTask(SchedulerTask* pTask_in);
+    void Enqueue(SchedulerTask* pTask_in, TaskPriority ePriority_ic = TaskPriority::Normal);
+    /* Local pop (workers only), shared queue, then steal. nullptr if nothing is queued. */
+    SchedulerTask* FindTask(uint32_t lSelfIndex_ic, Counters& stats_io);
+    /* Which workers a steal pass visits (groups only matter for workers of a grouped pool). */
+    enum class StealScope : uint8_t { All, OwnGroup, OtherGroups };
+    /* One pass over the other workers in eScope_ic from a random start. */
+    SchedulerTask* StealPass(uint32_t lSelfIndex_ic, StealScope eScope_ic, Counters& stats_io);
+    SchedulerTask* PopShared();
+    SchedulerTask* PopMainThread();
+    void Execute(SchedulerTask* pTask_in, Counters& stats_io);
+    void FinishTask(TaskGroup* pGroup_io);
+    /* Something a helping thread may wait for happened (task queued, group done): wake threads blocked in Wait. */
+    void WakeHelpers();
+    /* Index of the calling thread if it is a worker of this scheduler, otherwise kNotWorker. */
+    static constexpr uint32_t kNotWorker = UINT32_MAX;
+    uint32_t GetCurrentWorkerIndex() const;
+    Counters& GetCounters(uint32_t lWorkerIndex_ic);
+
+    std::vector<std::unique_ptr<Worker>> m_vecWorkerState;
+    std::vector<std::thread> m_workers;
+    bool m_bGrouped = false;  // Workers belong to more than one steal group
+    std::thread::id m_mainThreadId;
+
+    std::mutex m_sharedMutex;
+    RingQueue<SchedulerTask*> m_sharedQueue;
+    std::mutex m_mainMutex;
+    RingQueue<SchedulerTask*> m_mainQueue;
+    RingQueue<SchedulerTask*> m_mainBatch;  // RunMainThreadTasks scratch (main thread)
+    std::mutex m_poolMutex;
+    std::vector<SchedulerTask*> m_vecFreeTasks;
+
+    /* Tasks queued in deques + shared queue (not yet taken); sleepers wait for it to become non-zero. */
+    std::atomic<int64_t> m_iQueued{0};
+    std::atomic<uint32_t> m_lSleeping{0u};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCv;
+    std::atomic<bool> m_bStop{false};
+    /* Threads blocked in Wait (on m_helpCv under m_sleepMutex) and the event counter they wait to change. */
+    std::condition_variable m_helpCv;
+    std::atomic<uint32_t> m_lHelpersWaiting{0u};
+    std::atomic<uint32_t> m_uHelpEpoch{0u};
+
+    Counters m_helperStats;  // Non-worker threads helping inside Wait / ParallelFor
+    std::atomic<uint64_t> m_uSharedContended{0u};
+    std::atomic<uint64_t> m_uDequeOverflows{0u};
+    std::atomic<uint64_t> m_uMainThreadRun{0u};
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/*
+ * Chase-Lev work-stealing deque of pointers (Le, Pop, Cohen, Zappa Nardelli: "Correct and Efficient Work-Stealing
+ * for Weak Memory Models", PPoPP 2013), fixed capacity.
+ * The owning thread pushes and pops at the bottom (LIFO, cache-warm); any thread steals from the top (FIFO).
+ * Push returns false when full; the caller falls back to a shared queue instead of growing the ring, so no
+ * buffer ever has to be reclaimed while a thief may still read it.
+ */
+template <typename T>
+class WorkStealingDeque {
+public:
+    /* lCapacity_ic is rounded up to a power of two. */
+    explicit WorkStealingDeque(uint32_t lCapacity_ic = 4096u) {
+        uint32_t lCapacity = 1u;
+        while (lCapacity < lCapacity_ic)
+            lCapacity <<= 1u;
+        this->m_lMask = static_cast<int64_t>(lCapacity) - 1;
+        this->m_pBuffer = std::make_unique<std::atomic<T*>[]>(lCapacity);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /* Owner only. False when the ring is full. */
+    bool Push(T* pItem_ic) {
+        const int64_t iBottom = this->m_iBottom.load(std::memory_order_relaxed);
+        const int64_t iTop = this->m_iTop.load(std::memory_order_acquire);
+        if (iBottom - iTop > this->m_lMask)
+            return false;
+        this->m_pBuffer[iBottom & this->m_lMask].store(pItem_ic, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        this->m_iBottom.store(iBottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /* Owner only. Most recently pushed item, or nullptr when empty (or the last item was stolen meanwhile). */
+    T* Pop() {
+        const int64_t iBottom = this->m_iBottom.load(std::memory_order_relaxed) - 1;
+        this->m_iBottom.store(iBottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t iTop = this->m_iTop.load(std::memory_order_relaxed);
+        if (iTop > iBottom) {
+            this->m_iBottom.store(iBottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* pItem = this->m_pBuffer[iBottom & this->m_lMask].load(std::memory_order_relaxed);
+        if (iTop == iBottom) {
+            // Last item: race thieves for it
+            if (this->m_iTop.compare_exchange_strong(iTop, iTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed) == false)
+                pItem = nullptr;
+            this->m_iBottom.store(iBottom + 1, std::memory_order_relaxed);
+        }
+        return pItem;
+    }
+
+    /* Any thread. Oldest item, or nullptr when empty or another thread won the race. */
+    T* Steal() {
+        int64_t iTop = this->m_iTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t iBottom = this->m_iBottom.load(std::memory_order_acquire);
+        if (iTop >= iBottom)
+            return nullptr;
+        T* pItem = this->m_pBuffer[iTop & this->m_lMask].load(std::memory_order_relaxed);
+        if (this->m_iTop.compare_exchange_strong(iTop, iTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed) == false)
+            return nullptr;
+        return pItem;
+    }
+
+    /* Approximate (racy) size, for heuristics only. */
+    int64_t SizeApprox() const {
+        return this->m_iBottom.load(std::memory_order_relaxed) - this->m_iTop.load(std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> m_iTop{0};
+    alignas(64) std::atomic<int64_t> m_iBottom{0};
+    int64_t m_lMask = 0;
+    std::unique_ptr<std::atomic<T*>[]> m_pBuffer;
+};
@@ -0,0 +1,337 @@
+/*
+ * DeviceMemoryAllocator — per-memory-type block pools with TLSF sub-allocation, dedicated allocations, budgets.
+ */
+#include "device_memory_allocator.h"
+#include "vulkan_utils.h"
+#include <algorithm>
+
+namespace {
+
+constexpr VkDeviceSize kSmallHeapSize = 1024ull * 1024ull * 1024ull;
+constexpr VkDeviceSize kMinBlockSize = 1024ull * 1024ull;
+/* Blocks start at 1/8 of the preferred size and double with each block in the pool. */
+constexpr uint32_t kBlockGrowthSteps = 3u;
+
+} // namespace
+
+const char* MemoryCategoryToString(MemoryCategory eCategory_ic) {
+    switch (eCategory_ic) {
+        case MemoryCategory::Buffer:       return "buffer";
+        case MemoryCategory::Mesh:         return "mesh";
+        case MemoryCategory::Texture:      return "texture";
+        case MemoryCategory::RenderTarget: return "render target";
+        case MemoryCategory::Staging:      return "staging";
+        default:                           return "?";
+    }
+}
+
+DeviceMemoryAllocator::~DeviceMemoryAllocator() {
+    this->Destroy();
+}
+
+void DeviceMemoryAllocator::Create(DeviceMemoryBackend* pBackend_ic, const VkPhysicalDeviceMemoryProperties& stProps_ic,
+                                   VkDeviceSize uBlockSize_ic) {
+    this->Destroy();
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->m_pBackend = pBackend_ic;
+    this->m_memoryProperties = stProps_ic;
+    this->m_uBlockSize = std::max(uBlockSize_ic, kMinBlockSize);
+    this->m_vecPools.resize(static_cast<size_t>(stProps_ic.memoryTypeCount) * 2u);
+    for (uint32_t lType = 0u; lType < stProps_ic.memoryTypeCount; ++lType) {
+        this->m_vecPools[this->PoolIndex(lType, false)].lMemoryType = lType;
+        this->m_vecPools[this->PoolIndex(lType, true)].lMemoryType = lType;
+    }
+    for (uint32_t lHeap = 0u; lHeap < stProps_ic.memoryHeapCount; ++lHeap) {
+        this->m_astHeaps[lHeap] = {};
+        this->m_astHeaps[lHeap].uSize = stProps_ic.memoryHeaps[lHeap].size;
+        this->m_abBudgetWarned[lHeap] = false;
+    }
+    this->RefreshBudget();
+    VulkanUtils::LogInfo("DeviceMemoryAllocator: {} memory types, {} heaps, block size {} MiB, budget from driver: {}",
+                         stProps_ic.memoryTypeCount, stProps_ic.memoryHeapCount, this->m_uBlockSize >> 20u,
+                         this->m_bDriverBudget);
+}
+
+void DeviceMemoryAllocator::Destroy() {
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    if (this->m_pBackend == nullptr)
+        return;
+    uint32_t lLeaked = 0u;
+    for (Pool& stPool : this->m_vecPools) {
+        for (std::unique_ptr<Block>& pBlock : stPool.vecBlocks) {
+            if (pBlock == nullptr)
+                continue;
+            lLeaked += pBlock->tlsf.GetAllocationCount();
+            this->FreeDeviceMemory(stPool.lMemoryType, pBlock->uSize, pBlock->memory, pBlock->pMapped);
+            pBlock.reset();
+        }
+    }
+    if ((lLeaked > 0u) || (this->m_lDedicatedCount > 0u))
+        VulkanUtils::LogWarn("DeviceMemoryAllocator::Destroy: {} sub-allocations and {} dedicated allocations not freed",
+                             lLeaked, this->m_lDedicatedCount);
+    this->m_vecPools.clear();
+    this->m_lDedicatedCount = 0u;
+    this->m_uDedicatedBytes = 0u;
+    for (size_t i = 0u; i < static_cast<size_t>(MemoryCategory::Count); ++i) {
+        this->m_auCategoryBytes[i] = 0u;
+        this->m_alCategoryCount[i] = 0u;
+    }
+    this->m_pBackend = nullptr;
+}
+
+bool DeviceMemoryAllocator::IsHostVisible(uint32_t lMemoryType_ic) const {
+    return (this->m_memoryProperties.memoryTypes[lMemoryType_ic].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0u;
+}
+
+VkDeviceSize DeviceMemoryAllocator::GetPreferredBlockSize(uint32_t lMemoryType_ic) const {
+    const uint32_t lHeap = this->m_memoryProperties.memoryTypes[lMemoryType_ic].heapIndex;
+    const VkDeviceSize uHeapSize = this->m_memoryProperties.memoryHeaps[lHeap].size;
+    if (uHeapSize <= kSmallHeapSize)
+        return std::max(std::min(this->m_uBlockSize, uHeapSize / 8u), kMinBlockSize);
+    return this->m_uBlockSize;
+}
+
+void DeviceMemoryAllocator::RefreshBudget() {
+    VkDeviceSize auBudget[VK_MAX_MEMORY_HEAPS] = {};
+    VkDeviceSize auUsage[VK_MAX_MEMORY_HEAPS] = {};
+    this->m_bDriverBudget = (this->m_pBackend != nullptr) && this->m_pBackend->QueryBudget(auBudget, auUsage);
+    for (uint32_t lHeap = 0u; lHeap < this->m_memoryProperties.memoryHeapCount; ++lHeap) {
+        MemoryHeapBudget& stHeap = this->m_astHeaps[lHeap];
+        if (this->m_bDriverBudget == true) {
+            stHeap.uBudget = auBudget[lHeap];
+            stHeap.uUsage = auUsage[lHeap];
+        } else {
+            stHeap.uBudget = stHeap.uSize / 10u * 8u;
+            stHeap.uUsage = stHeap.uAllocated;
+        }
+    }
+}
+
+VkResult DeviceMemoryAllocator::AllocateDeviceMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic,
+                                                     const MemoryRequest& stRequest_ic, bool bDedicated_ic,
+                                                     VkDeviceMemory& memory_out, void*& pMapped_out) {
+    const uint32_t lHeap = this->m_memoryProperties.memoryTypes[lMemoryType_ic].heapIndex;
+    MemoryHeapBudget& stHeap = this->m_astHeaps[lHeap];
+    if (this->m_bDriverBudget == true)
+        this->RefreshBudget();
+    else
+        stHeap.uUsage = stHeap.uAllocated;
+    if ((stHeap.uUsage + uSize_ic > stHeap.uBudget) && (this->m_abBudgetWarned[lHeap] == false)) {
+        this->m_abBudgetWarned[lHeap] = true;
+        VulkanUtils::LogWarn("DeviceMemoryAllocator: heap {} over budget ({} MiB used + {} MiB requested > {} MiB)",
+                             lHeap, stHeap.uUsage >> 20u, uSize_ic >> 20u, stHeap.uBudget >> 20u);
+    }
+
+    memory_out = VK_NULL_HANDLE;
+    pMapped_out = nullptr;
+    VkResult r = this->m_pBackend->AllocateMemory(lMemoryType_ic, uSize_ic,
+                                                  bDedicated_ic ? stRequest_ic.dedicatedImage : VK_NULL_HANDLE,
+                                                  bDedicated_ic ? stRequest_ic.dedicatedBuffer : VK_NULL_HANDLE, memory_out);
+    if (r != VK_SUCCESS)
+        return r;
+    if (this->IsHostVisible(lMemoryType_ic) == true) {
+        r = this->m_pBackend->MapMemory(memory_out, pMapped_out);
+        if (r != VK_SUCCESS) {
+            this->m_pBackend->FreeMemory(memory_out);
+            memory_out = VK_NULL_HANDLE;
+            pMapped_out = nullptr;
+            return r;
+        }
+    }
+    stHeap.uAllocated += uSize_ic;
+    return VK_SUCCESS;
+}
+
+void DeviceMemoryAllocator::FreeDeviceMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic, VkDeviceMemory memory_ic,
+                                             void* pMapped_ic) {
+    if (pMapped_ic != nullptr)
+        this->m_pBackend->UnmapMemory(memory_ic);
+    this->m_pBackend->FreeMemory(memory_ic);
+    MemoryHeapBudget& stHeap = this->m_astHeaps[this->m_memoryProperties.memoryTypes[lMemoryType_ic].heapIndex];
+    stHeap.uAllocated -= std::min(stHeap.uAllocated, uSize_ic);
+}
+
+bool DeviceMemoryAllocator::AllocateDedicated(uint32_t lMemoryType_ic, const MemoryRequest& stRequest_ic,
+                                              MemoryAllocation& stAlloc_out) {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    void* pMapped = nullptr;
+    const VkDeviceSize uSize = stRequest_ic.requirements.size;
+    if (this->AllocateDeviceMemory(lMemoryType_ic, uSize, stRequest_ic, true, memory, pMapped) != VK_SUCCESS)
+        return false;
+    stAlloc_out.memory = memory;
+    stAlloc_out.uOffset = 0u;
+    stAlloc_out.uSize = uSize;
+    stAlloc_out.uMemorySize = uSize;
+    stAlloc_out.pMapped = pMapped;
+    stAlloc_out.lMemoryType = lMemoryType_ic;
+    stAlloc_out.lPool = UINT32_MAX;
+    ++this->m_lDedicatedCount;
+    this->m_uDedicatedBytes += uSize;
+    return true;
+}
+
+bool DeviceMemoryAllocator::AllocateInPool(uint32_t lMemoryType_ic, const MemoryRequest& stRequest_ic,
+                                           MemoryAllocation& stAlloc_out) {
+    const uint32_t lPoolIndex = this->PoolIndex(lMemoryType_ic, stRequest_ic.bOptimalImage);
+    Pool& stPool = this->m_vecPools[lPoolIndex];
+    const VkDeviceSize uSize = stRequest_ic.requirements.size;
+    const VkDeviceSize uAlign = std::max<VkDeviceSize>(stRequest_ic.requirements.alignment, 1u);
+
+    const auto fnTake = [&](uint32_t lBlock_ic, uint32_t lNode_ic, VkDeviceSize uOffset_ic) {
+        const Block& stBlock = *stPool.vecBlocks[lBlock_ic];
+        stAlloc_out.memory = stBlock.memory;
+        stAlloc_out.uOffset = uOffset_ic;
+        stAlloc_out.uSize = uSize;
+        stAlloc_out.uMemorySize = stBlock.uSize;
+        stAlloc_out.pMapped = (stBlock.pMapped != nullptr) ? static_cast<uint8_t*>(stBlock.pMapped) + uOffset_ic : nullptr;
+        stAlloc_out.lMemoryType = lMemoryType_ic;
+        stAlloc_out.lPool = lPoolIndex;
+        stAlloc_out.lBlock = lBlock_ic;
+        stAlloc_out.lNode = lNode_ic;
+    };
+
+    uint32_t lLiveBlocks = 0u;
+    uint32_t lFreeSlot = static_cast<uint32_t>(stPool.vecBlocks.size());
+    for (uint32_t lBlock = 0u; lBlock < static_cast<uint32_t>(stPool.vecBlocks.size()); ++lBlock) {
+        Block* pBlock = stPool.vecBlocks[lBlock].get();
+        if (pBlock == nullptr) {
+            lFreeSlot = std::min(lFreeSlot, lBlock);
+            continue;
+        }
+        ++lLiveBlocks;
+        VkDeviceSize uOffset = 0u;
+        const uint32_t lNode = pBlock->tlsf.Allocate(uSize, uAlign, uOffset);
+        if (lNode != TlsfAllocator::kInvalidNode) {
+            fnTake(lBlock, lNode, uOffset);
+            return true;
+        }
+    }
+
+    /* New block: grows with the pool, never smaller than the request. On failure retry smaller, down to the request. */
+    const VkDeviceSize uPreferred = this->GetPreferredBlockSize(lMemoryType_ic);
+    VkDeviceSize uBlockSize = std::max(uPreferred >> (kBlockGrowthSteps - std::min(lLiveBlocks, kBlockGrowthSteps)), kMinBlockSize);
+    uBlockSize = std::max(uBlockSize, uSize);
+    auto pBlock = std::make_unique<Block>();
+    while (true) {
+        const VkResult r = this->AllocateDeviceMemory(lMemoryType_ic, uBlockSize, stRequest_ic, false, pBlock->memory, pBlock->pMapped);
+        if (r == VK_SUCCESS)
+            break;
+        if (uBlockSize <= uSize)
+            return false;
+        uBlockSize = std::max(uBlockSize / 2u, uSize);
+    }
+    pBlock->uSize = uBlockSize;
+    pBlock->tlsf.Reset(uBlockSize);
+    VkDeviceSize uOffset = 0u;
+    const uint32_t lNode = pBlock->tlsf.Allocate(uSize, uAlign, uOffset);
+    if (lFreeSlot == stPool.vecBlocks.size())
+        stPool.vecBlocks.emplace_back();
+    stPool.vecBlocks[lFreeSlot] = std::move(pBlock);
+    fnTake(lFreeSlot, lNode, uOffset);
+    return true;
+}
+
+bool DeviceMemoryAllocator::Allocate(const MemoryRequest& stRequest_ic, MemoryAllocation& stAlloc_out) {
+    stAlloc_out = {};
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    if ((this->m_pBackend == nullptr) || (stRequest_ic.requirements.size == 0u))
+        return false;
+
+    /* Memory types in index order (the order the driver lists them in is its preference). */
+    for (uint32_t lType = 0u; lType < this->m_memoryProperties.memoryTypeCount; ++lType) {
+        if ((stRequest_ic.requirements.memoryTypeBits & (1u << lType)) == 0u)
+            continue;
+        if ((this->m_memoryProperties.memoryTypes[lType].propertyFlags & stRequest_ic.properties) != stRequest_ic.properties)
+            continue;
+        const bool bDedicated = (stRequest_ic.bDedicated == true) ||
+                                (stRequest_ic.requirements.size > this->GetPreferredBlockSize(lType) / 2u);
+        const bool bOk = bDedicated ? this->AllocateDedicated(lType, stRequest_ic, stAlloc_out)
+                                    : this->AllocateInPool(lType, stRequest_ic, stAlloc_out);
+        if (bOk == false)
+            continue;
+        stAlloc_out.pAllocator = this;
+        stAlloc_out.eCategory = stRequest_ic.eCategory;
+        const size_t zCategory = static_cast<size_t>(stRequest_ic.eCategory);
+        this->m_auCategoryBytes[zCategory] += stAlloc_out.uSize;
+        ++this->m_alCategoryCount[zCategory];
+        return true;
+    }
+    VulkanUtils::LogErr("DeviceMemoryAllocator: no memory for {} bytes ({}, type bits {:#x}, properties {:#x})",
+                        stRequest_ic.requirements.size, MemoryCategoryToString(stRequest_ic.eCategory),
+                        stRequest_ic.requirements.memoryTypeBits, static_cast<uint32_t>(stRequest_ic.properties));
+    return false;
+}
+
+void DeviceMemoryAllocator::Free(MemoryAllocation& stAlloc_io) {
+    if (stAlloc_io.IsValid() == false)
+        return;
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    if (this->m_pBackend == nullptr) {
+        stAlloc_io = {};
+        return;
+    }
+    const size_t zCategory = static_cast<size_t>(stAlloc_io.eCategory);
+    this->m_auCategoryBytes[zCategory] -= std::min(this->m_auCategoryBytes[zCategory], stAlloc_io.uSize);
+    if (this->m_alCategoryCount[zCategory] > 0u)
+        --this->m_alCategoryCount[zCategory];
+
+    if (stAlloc_io.IsDedicated() == true) {
+        void* pMapped = (stAlloc_io.pMapped != nullptr) ? static_cast<uint8_t*>(stAlloc_io.pMapped) - stAlloc_io.uOffset : nullptr;
+        this->FreeDeviceMemory(stAlloc_io.lMemoryType, stAlloc_io.uMemorySize, stAlloc_io.memory, pMapped);
+        --this->m_lDedicatedCount;
+        this->m_uDedicatedBytes -= std::min(this->m_uDedicatedBytes, stAlloc_io.uMemorySize);
+        stAlloc_io = {};
+        return;
+    }
+
+    Pool& stPool = this->m_vecPools[stAlloc_io.lPool];
+    std::unique_ptr<Block>& pBlock = stPool.vecBlocks[stAlloc_io.lBlock];
+    pBlock->tlsf.Free(stAlloc_io.lNode);
+    /* Keep one empty block per pool so an allocate / free cycle at a block boundary does not hit the driver. */
+    if (pBlock->tlsf.IsEmpty() == true) {
+        const bool bOtherEmpty = std::any_of(stPool.vecBlocks.begin(), stPool.vecBlocks.end(),
+            [&](const std::unique_ptr<Block>& pOther) {
+                return (pOther != nullptr) && (pOther.get() != pBlock.get()) && (pOther->tlsf.IsEmpty() == true);
+            });
+        if (bOtherEmpty == true) {
+            this->FreeDeviceMemory(stPool.lMemoryType, pBlock->uSize, pBlock->memory, pBlock->pMapped);
+            pBlock.reset();
+        }
+    }
+    stAlloc_io = {};
+}
+
+DeviceMemoryStats DeviceMemoryAllocator::GetStats() {
+    DeviceMemoryStats stStats;
+    std::lock_guard<std::mutex> lock(this->m_mutex);
+    this->RefreshBudget();
+    VkDeviceSize uFreeBytes = 0u;
+    VkDeviceSize uLargestFreeSum = 0u;
+    for (const Pool& stPool : this->m_vecPools) {
+        for (const std::unique_ptr<Block>& pBlock : stPool.vecBlocks) {
+            if (pBlock == nullptr)
+                continue;
+            ++stStats.lBlocks;
+            stStats.uBlockBytes += pBlock->uSize;
+            stStats.uBlockUsedBytes += pBlock->tlsf.GetUsedBytes();
+            stStats.lAllocations += pBlock->tlsf.GetAllocationCount();
+            stStats.lFreeRanges += pBlock->tlsf.GetFreeRangeCount();
+            uFreeBytes += pBlock->tlsf.GetFreeBytes();
+            uLargestFreeSum += pBlock->tlsf.GetLargestFreeRange();
+        }
+    }
+    stStats.fFragmentation = (uFreeBytes > 0u)
+        ? 1.0f - static_cast<float>(static_cast<double>(uLargestFreeSum) / static_cast<double>(uFreeBytes))
+        : 0.0f;
+    stStats.lDedicated = this->m_lDedicatedCount;
+    stStats.uDedicatedBytes = this->m_uDedicatedBytes;
+    for (size_t i = 0u; i < static_cast<size_t>(MemoryCategory::Count); ++i) {
+        stStats.auCategoryBytes[i] = this->m_auCategoryBytes[i];
+        stStats.alCategoryCount[i] = this->m_alCategoryCount[i];
+    }
+    stStats.lHeapCount = this->m_memoryProperties.memoryHeapCount;
+    for (uint32_t lHeap = 0u; lHeap < stStats.lHeapCount; ++lHeap)
+        stStats.astHeaps[lHeap] = this->m_astHeaps[lHeap];
+    stStats.bDriverBudget = this->m_bDriverBudget;
+    return stStats;
+}
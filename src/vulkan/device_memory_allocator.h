@@ -0,0 +1,171 @@
+#pragma once
+
+#include "tlsf_allocator.h"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/* What an allocation is for (statistics only). */
+enum class MemoryCategory : uint8_t {
+    Buffer,        // GPUBuffer: UBOs, SSBOs, ring buffers, culling buffers
+    Mesh,          // Vertex / index buffers
+    Texture,       // Sampled images and texture arrays
+    RenderTarget,  // Depth and offscreen color / depth attachments
+    Staging,       // Upload buffers
+    Count
+};
+
+const char* MemoryCategoryToString(MemoryCategory eCategory_ic);
+
+class DeviceMemoryAllocator;
+
+/** A range of VkDeviceMemory handed out by DeviceMemoryAllocator. Bind with (memory, uOffset). */
+struct MemoryAllocation {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize uOffset = 0u;      // Bind offset into memory
+    VkDeviceSize uSize = 0u;
+    VkDeviceSize uMemorySize = 0u;  // Size of memory (whole block, or the dedicated allocation)
+    void* pMapped = nullptr;        // Host-visible types: CPU address of uOffset (memory stays mapped for its lifetime)
+    DeviceMemoryAllocator* pAllocator = nullptr;  // nullptr: allocated directly with vkAllocateMemory (no allocator)
+    uint32_t lMemoryType = UINT32_MAX;
+    uint32_t lPool = UINT32_MAX;    // UINT32_MAX: dedicated
+    uint32_t lBlock = UINT32_MAX;
+    uint32_t lNode = TlsfAllocator::kInvalidNode;
+    MemoryCategory eCategory = MemoryCategory::Buffer;
+
+    bool IsValid() const { return this->memory != VK_NULL_HANDLE; }
+    bool IsDedicated() const { return this->lPool == UINT32_MAX; }
+};
+
+struct MemoryRequest {
+    VkMemoryRequirements requirements = {};
+    VkMemoryPropertyFlags properties = 0u;  // Required property flags
+    MemoryCategory eCategory = MemoryCategory::Buffer;
+    /* Optimal-tiling images live in blocks apart from buffers and linear images, so bufferImageGranularity never
+       applies between neighbours. */
+    bool bOptimalImage = false;
+    /* Own VkDeviceMemory (render targets: large, recreated on resize). Resources above half a block get one anyway. */
+    bool bDedicated = false;
+    VkImage dedicatedImage = VK_NULL_HANDLE;    // Passed to VkMemoryDedicatedAllocateInfo for dedicated allocations
+    VkBuffer dedicatedBuffer = VK_NULL_HANDLE;
+};
+
+/**
+ * Where the allocator gets device memory. VulkanMemoryBackend (vulkan_memory.h) calls the driver; a fake backend
+ * handing out made-up handles and host memory lets the allocator run on the CPU alone.
+ */
+class DeviceMemoryBackend {
+public:
+    virtual ~DeviceMemoryBackend() = default;
+
+    /** dedicatedImage_ic / dedicatedBuffer_ic (at most one set) name the resource of a dedicated allocation. */
+    virtual VkResult AllocateMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic, VkImage dedicatedImage_ic,
+                                    VkBuffer dedicatedBuffer_ic, VkDeviceMemory& memory_out) = 0;
+    virtual void FreeMemory(VkDeviceMemory memory_ic) = 0;
+    /** Map the whole allocation. */
+    virtual VkResult MapMemory(VkDeviceMemory memory_ic, void*& pData_out) = 0;
+    virtual void UnmapMemory(VkDeviceMemory memory_ic) = 0;
+    /** Per-heap budget and process usage (VK_EXT_memory_budget). False when the driver does not report them. */
+    virtual bool QueryBudget(VkDeviceSize* pBudget_out, VkDeviceSize* pUsage_out) = 0;
+};
+
+struct MemoryHeapBudget {
+    VkDeviceSize uSize = 0u;
+    VkDeviceSize uBudget = 0u;     // Driver budget, or 80% of the heap without VK_EXT_memory_budget
+    VkDeviceSize uUsage = 0u;      // Driver-reported process usage, or uAllocated without VK_EXT_memory_budget
+    VkDeviceSize uAllocated = 0u;  // Blocks + dedicated allocations made by this allocator
+};
+
+struct DeviceMemoryStats {
+    uint32_t lBlocks = 0u;
+    uint32_t lDedicated = 0u;
+    uint32_t lAllocations = 0u;    // Sub-allocations in blocks
+    uint32_t lFreeRanges = 0u;
+    VkDeviceSize uBlockBytes = 0u;
+    VkDeviceSize uBlockUsedBytes = 0u;
+    VkDeviceSize uDedicatedBytes = 0u;
+    /* Share of free block space outside each block's largest free range: 0 = free space is contiguous per block,
+       near 1 = scattered in small holes. */
+    float fFragmentation = 0.0f;
+    VkDeviceSize auCategoryBytes[static_cast<size_t>(MemoryCategory::Count)] = {};
+    uint32_t alCategoryCount[static_cast<size_t>(MemoryCategory::Count)] = {};
+    uint32_t lHeapCount = 0u;
+    MemoryHeapBudget astHeaps[VK_MAX_MEMORY_HEAPS] = {};
+    bool bDriverBudget = false;    // Heap budget / usage come from VK_EXT_memory_budget
+};
+
+/**
+ * DeviceMemoryAllocator — sub-allocates VkDeviceMemory. Each memory type has two block pools (buffers and linear
+ * images; optimal-tiling images); a block is one VkDeviceMemory split with a TlsfAllocator. Blocks start at 1/8 of
+ * the block size and double per block up to it, so lightly used types stay small. Host-visible blocks are mapped
+ * once when created, and every allocation in them gets a pointer into that mapping. Render targets and resources
+ * above half a block get a dedicated VkDeviceMemory. Heap budgets come from the backend when available; a new block
+ * that would exceed the budget is still attempted, with a warning. Thread-safe (one mutex).
+ */
+class DeviceMemoryAllocator {
+public:
+    static constexpr VkDeviceSize kDefaultBlockSize = 64ull * 1024ull * 1024ull;
+
+    DeviceMemoryAllocator() = default;
+    ~DeviceMemoryAllocator();
+
+    DeviceMemoryAllocator(const DeviceMemoryAllocator&) = delete;
+    DeviceMemoryAllocator& operator=(const DeviceMemoryAllocator&) = delete;
+
+    /** pBackend_ic must outlive the allocator. Heaps of 1 GiB or less use blocks of 1/8 of the heap at most. */
+    void Create(DeviceMemoryBackend* pBackend_ic, const VkPhysicalDeviceMemoryProperties& stProps_ic,
+                VkDeviceSize uBlockSize_ic = kDefaultBlockSize);
+    /** Frees every block; allocations still alive are reported and become invalid. */
+    void Destroy();
+    bool IsValid() const { return this->m_pBackend != nullptr; }
+
+    /** False when no memory type matches or the device is out of memory (stAlloc_out left invalid). */
+    bool Allocate(const MemoryRequest& stRequest_ic, MemoryAllocation& stAlloc_out);
+    /** Release and reset stAlloc_io. Invalid allocations are ignored. */
+    void Free(MemoryAllocation& stAlloc_io);
+
+    /** Snapshot of blocks, usage per category and heap budgets (queries the backend for the budget). */
+    DeviceMemoryStats GetStats();
+
+    const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return this->m_memoryProperties; }
+
+private:
+    struct Block {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize uSize = 0u;
+        void* pMapped = nullptr;
+        TlsfAllocator tlsf;
+    };
+    struct Pool {
+        uint32_t lMemoryType = 0u;
+        std::vector<std::unique_ptr<Block>> vecBlocks;  // Null slots are reused (allocations keep their index)
+    };
+
+    uint32_t PoolIndex(uint32_t lMemoryType_ic, bool bOptimalImage_ic) const {
+        return lMemoryType_ic * 2u + (bOptimalImage_ic ? 1u : 0u);
+    }
+    VkDeviceSize GetPreferredBlockSize(uint32_t lMemoryType_ic) const;
+    bool IsHostVisible(uint32_t lMemoryType_ic) const;
+    /** Allocate device memory, tracking heap usage; warns when past the heap budget. */
+    VkResult AllocateDeviceMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic, const MemoryRequest& stRequest_ic,
+                                  bool bDedicated_ic, VkDeviceMemory& memory_out, void*& pMapped_out);
+    void FreeDeviceMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic, VkDeviceMemory memory_ic, void* pMapped_ic);
+    bool AllocateDedicated(uint32_t lMemoryType_ic, const MemoryRequest& stRequest_ic, MemoryAllocation& stAlloc_out);
+    bool AllocateInPool(uint32_t lMemoryType_ic, const MemoryRequest& stRequest_ic, MemoryAllocation& stAlloc_out);
+    void RefreshBudget();
+
+    DeviceMemoryBackend* m_pBackend = nullptr;
+    VkPhysicalDeviceMemoryProperties m_memoryProperties = {};
+    VkDeviceSize m_uBlockSize = kDefaultBlockSize;
+    std::vector<Pool> m_vecPools;  // Two per memory type (PoolIndex)
+    uint32_t m_lDedicatedCount = 0u;
+    VkDeviceSize m_uDedicatedBytes = 0u;
+    VkDeviceSize m_auCategoryBytes[static_cast<size_t>(MemoryCategory::Count)] = {};
+    uint32_t m_alCategoryCount[static_cast<size_t>(MemoryCategory::Count)] = {};
+    MemoryHeapBudget m_astHeaps[VK_MAX_MEMORY_HEAPS] = {};
+    bool m_bDriverBudget = false;
+    bool m_abBudgetWarned[VK_MAX_MEMORY_HEAPS] = {};
+    std::mutex m_mutex;
+};
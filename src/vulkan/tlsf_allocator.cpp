@@ -0,0 +1,244 @@
+/*
+ * TlsfAllocator — two-level segregated fit offset allocator.
+ */
+#include "tlsf_allocator.h"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+uint64_t AlignUp(uint64_t uValue_ic, uint64_t uAlign_ic) {
+    return (uValue_ic + uAlign_ic - 1u) & ~(uAlign_ic - 1u);
+}
+
+} // namespace
+
+TlsfAllocator::TlsfAllocator(uint64_t uSize_ic) {
+    this->Reset(uSize_ic);
+}
+
+void TlsfAllocator::Reset(uint64_t uSize_ic) {
+    this->m_vecNodes.clear();
+    this->m_vecFreeNodes.clear();
+    for (uint32_t lFl = 0u; lFl < kFlCount; ++lFl) {
+        for (uint32_t lSl = 0u; lSl < kSlCount; ++lSl)
+            this->m_aBinHeads[lFl][lSl] = kInvalidNode;
+        this->m_aSlBitmap[lFl] = 0u;
+    }
+    this->m_uFlBitmap = 0u;
+    this->m_uSize = uSize_ic;
+    this->m_uUsed = 0u;
+    this->m_lAllocations = 0u;
+    this->m_lFreeRanges = 0u;
+    if (uSize_ic == 0u)
+        return;
+    const uint32_t lNode = this->NewNode();
+    this->m_vecNodes[lNode].uOffset = 0u;
+    this->m_vecNodes[lNode].uSize = uSize_ic;
+    this->InsertFree(lNode);
+}
+
+void TlsfAllocator::Mapping(uint64_t uSize_ic, uint32_t& lFl_out, uint32_t& lSl_out) {
+    if (uSize_ic < (uint64_t{1} << kSmallLog2)) {
+        lFl_out = 0u;
+        lSl_out = static_cast<uint32_t>(uSize_ic >> (kSmallLog2 - kSlBits));
+        return;
+    }
+    const uint32_t lLog2 = static_cast<uint32_t>(std::bit_width(uSize_ic)) - 1u;
+    lFl_out = lLog2 - kSmallLog2 + 1u;
+    lSl_out = static_cast<uint32_t>(uSize_ic >> (lLog2 - kSlBits)) & (kSlCount - 1u);
+}
+
+uint32_t TlsfAllocator::NewNode() {
+    if (this->m_vecFreeNodes.empty() == false) {
+        const uint32_t lNode = this->m_vecFreeNodes.back();
+        this->m_vecFreeNodes.pop_back();
+        this->m_vecNodes[lNode] = Node{};
+        return lNode;
+    }
+    this->m_vecNodes.emplace_back();
+    return static_cast<uint32_t>(this->m_vecNodes.size() - 1u);
+}
+
+void TlsfAllocator::ReleaseNode(uint32_t lNode_ic) {
+    this->m_vecNodes[lNode_ic] = Node{};
+    this->m_vecFreeNodes.push_back(lNode_ic);
+}
+
+void TlsfAllocator::InsertFree(uint32_t lNode_ic) {
+    Node& stNode = this->m_vecNodes[lNode_ic];
+    uint32_t lFl = 0u;
+    uint32_t lSl = 0u;
+    Mapping(stNode.uSize, lFl, lSl);
+    const uint32_t lHead = this->m_aBinHeads[lFl][lSl];
+    stNode.bFree = true;
+    stNode.lPrevFree = kInvalidNode;
+    stNode.lNextFree = lHead;
+    if (lHead != kInvalidNode)
+        this->m_vecNodes[lHead].lPrevFree = lNode_ic;
+    this->m_aBinHeads[lFl][lSl] = lNode_ic;
+    this->m_aSlBitmap[lFl] = static_cast<uint8_t>(this->m_aSlBitmap[lFl] | (1u << lSl));
+    this->m_uFlBitmap |= uint64_t{1} << lFl;
+    ++this->m_lFreeRanges;
+}
+
+void TlsfAllocator::RemoveFree(uint32_t lNode_ic) {
+    Node& stNode = this->m_vecNodes[lNode_ic];
+    uint32_t lFl = 0u;
+    uint32_t lSl = 0u;
+    Mapping(stNode.uSize, lFl, lSl);
+    if (stNode.lPrevFree != kInvalidNode)
+        this->m_vecNodes[stNode.lPrevFree].lNextFree = stNode.lNextFree;
+    else
+        this->m_aBinHeads[lFl][lSl] = stNode.lNextFree;
+    if (stNode.lNextFree != kInvalidNode)
+        this->m_vecNodes[stNode.lNextFree].lPrevFree = stNode.lPrevFree;
+    if (this->m_aBinHeads[lFl][lSl] == kInvalidNode) {
+        this->m_aSlBitmap[lFl] = static_cast<uint8_t>(this->m_aSlBitmap[lFl] & ~(1u << lSl));
+        if (this->m_aSlBitmap[lFl] == 0u)
+            this->m_uFlBitmap &= ~(uint64_t{1} << lFl);
+    }
+    stNode.bFree = false;
+    stNode.lPrevFree = kInvalidNode;
+    stNode.lNextFree = kInvalidNode;
+    --this->m_lFreeRanges;
+}
+
+uint32_t TlsfAllocator::FindFree(uint64_t uSize_ic) const {
+    /* Round up to the next bin boundary so any range in the bin found is large enough. */
+    uint64_t uRounded = uSize_ic;
+    if (uRounded < (uint64_t{1} << kSmallLog2)) {
+        uRounded += (uint64_t{1} << (kSmallLog2 - kSlBits)) - 1u;
+    } else {
+        const uint32_t lLog2 = static_cast<uint32_t>(std::bit_width(uRounded)) - 1u;
+        uRounded += (uint64_t{1} << (lLog2 - kSlBits)) - 1u;
+    }
+    uint32_t lFl = 0u;
+    uint32_t lSl = 0u;
+    Mapping(uRounded, lFl, lSl);
+    if (lFl >= kFlCount)
+        return kInvalidNode;
+
+    uint32_t lSlMap = static_cast<uint32_t>(this->m_aSlBitmap[lFl]) & (~0u << lSl);
+    if (lSlMap == 0u) {
+        const uint64_t uFlMap = (lFl + 1u < 64u) ? (this->m_uFlBitmap & (~uint64_t{0} << (lFl + 1u))) : 0u;
+        if (uFlMap == 0u)
+            return kInvalidNode;
+        lFl = static_cast<uint32_t>(std::countr_zero(uFlMap));
+        lSlMap = this->m_aSlBitmap[lFl];
+    }
+    lSl = static_cast<uint32_t>(std::countr_zero(lSlMap));
+    return this->m_aBinHeads[lFl][lSl];
+}
+
+uint32_t TlsfAllocator::Allocate(uint64_t uSize_ic, uint64_t uAlign_ic, uint64_t& uOffset_out) {
+    const uint64_t uSize = std::max<uint64_t>(uSize_ic, 1u);
+    const uint64_t uAlign = std::max<uint64_t>(uAlign_ic, 1u);
+    if ((uSize > this->m_uSize - this->m_uUsed) || (uAlign - 1u > this->m_uSize))
+        return kInvalidNode;
+
+    /* Good fit: any range in a bin for size + alignment slack fits. Otherwise check the ranges in the exact bin,
+       which may still hold one that fits once aligned. */
+    uint32_t lNode = this->FindFree(uSize + uAlign - 1u);
+    if (lNode == kInvalidNode) {
+        uint32_t lFl = 0u;
+        uint32_t lSl = 0u;
+        Mapping(uSize, lFl, lSl);
+        for (uint32_t lCandidate = this->m_aBinHeads[lFl][lSl]; lCandidate != kInvalidNode;
+             lCandidate = this->m_vecNodes[lCandidate].lNextFree) {
+            const Node& stCandidate = this->m_vecNodes[lCandidate];
+            if (AlignUp(stCandidate.uOffset, uAlign) + uSize <= stCandidate.uOffset + stCandidate.uSize) {
+                lNode = lCandidate;
+                break;
+            }
+        }
+        if (lNode == kInvalidNode)
+            return kInvalidNode;
+    }
+    this->RemoveFree(lNode);
+
+    /* Split off the alignment padding in front and the remainder behind. Physical neighbours of a free range are
+       always in use (free ranges are merged on Free), so neither split needs merging. Nodes are re-fetched by index
+       after NewNode, which may grow the node array. */
+    const uint64_t uRangeOffset = this->m_vecNodes[lNode].uOffset;
+    const uint64_t uAligned = AlignUp(uRangeOffset, uAlign);
+    if (uAligned > uRangeOffset) {
+        const uint32_t lPad = this->NewNode();
+        Node& stPad = this->m_vecNodes[lPad];
+        Node& stNode = this->m_vecNodes[lNode];
+        stPad.uOffset = uRangeOffset;
+        stPad.uSize = uAligned - uRangeOffset;
+        stPad.lPrevPhys = stNode.lPrevPhys;
+        stPad.lNextPhys = lNode;
+        if (stNode.lPrevPhys != kInvalidNode)
+            this->m_vecNodes[stNode.lPrevPhys].lNextPhys = lPad;
+        stNode.lPrevPhys = lPad;
+        stNode.uOffset = uAligned;
+        stNode.uSize -= stPad.uSize;
+        this->InsertFree(lPad);
+    }
+    if (this->m_vecNodes[lNode].uSize > uSize) {
+        const uint32_t lTail = this->NewNode();
+        Node& stTail = this->m_vecNodes[lTail];
+        Node& stNode = this->m_vecNodes[lNode];
+        stTail.uOffset = uAligned + uSize;
+        stTail.uSize = stNode.uSize - uSize;
+        stTail.lPrevPhys = lNode;
+        stTail.lNextPhys = stNode.lNextPhys;
+        if (stNode.lNextPhys != kInvalidNode)
+            this->m_vecNodes[stNode.lNextPhys].lPrevPhys = lTail;
+        stNode.lNextPhys = lTail;
+        stNode.uSize = uSize;
+        this->InsertFree(lTail);
+    }
+
+    this->m_uUsed += uSize;
+    ++this->m_lAllocations;
+    uOffset_out = uAligned;
+    return lNode;
+}
+
+void TlsfAllocator::Free(uint32_t lNode_ic) {
+    if ((lNode_ic >= this->m_vecNodes.size()) || (this->m_vecNodes[lNode_ic].bFree == true) ||
+        (this->m_vecNodes[lNode_ic].uSize == 0u))
+        return;
+    this->m_uUsed -= this->m_vecNodes[lNode_ic].uSize;
+    --this->m_lAllocations;
+
+    uint32_t lNode = lNode_ic;
+    const uint32_t lPrev = this->m_vecNodes[lNode].lPrevPhys;
+    if ((lPrev != kInvalidNode) && (this->m_vecNodes[lPrev].bFree == true)) {
+        this->RemoveFree(lPrev);
+        Node& stPrev = this->m_vecNodes[lPrev];
+        const Node& stNode = this->m_vecNodes[lNode];
+        stPrev.uSize += stNode.uSize;
+        stPrev.lNextPhys = stNode.lNextPhys;
+        if (stNode.lNextPhys != kInvalidNode)
+            this->m_vecNodes[stNode.lNextPhys].lPrevPhys = lPrev;
+        this->ReleaseNode(lNode);
+        lNode = lPrev;
+    }
+    const uint32_t lNext = this->m_vecNodes[lNode].lNextPhys;
+    if ((lNext != kInvalidNode) && (this->m_vecNodes[lNext].bFree == true)) {
+        this->RemoveFree(lNext);
+        Node& stNode = this->m_vecNodes[lNode];
+        const Node& stNext = this->m_vecNodes[lNext];
+        stNode.uSize += stNext.uSize;
+        stNode.lNextPhys = stNext.lNextPhys;
+        if (stNext.lNextPhys != kInvalidNode)
+            this->m_vecNodes[stNext.lNextPhys].lPrevPhys = lNode;
+        this->ReleaseNode(lNext);
+    }
+    this->InsertFree(lNode);
+}
+
+uint64_t TlsfAllocator::GetLargestFreeRange() const {
+    if (this->m_uFlBitmap == 0u)
+        return 0u;
+    const uint32_t lFl = static_cast<uint32_t>(std::bit_width(this->m_uFlBitmap)) - 1u;
+    const uint32_t lSl = static_cast<uint32_t>(std::bit_width(static_cast<uint32_t>(this->m_aSlBitmap[lFl]))) - 1u;
+    uint64_t uLargest = 0u;
+    for (uint32_t lNode = this->m_aBinHeads[lFl][lSl]; lNode != kInvalidNode; lNode = this->m_vecNodes[lNode].lNextFree)
+        uLargest = std::max(uLargest, this->m_vecNodes[lNode].uSize);
+    return uLargest;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * TlsfAllocator — two-level segregated fit sub-allocator over an abstract range [0, size). It hands out offsets only;
+ * it never touches memory, so it can manage a VkDeviceMemory block (DeviceMemoryAllocator) and be exercised on the
+ * CPU alone. Free ranges are binned by size class (first level: power of two, second level: 8 linear steps), and two
+ * bitmaps locate a fitting bin in constant time. Freed ranges are merged with free neighbours at once.
+ * Not thread-safe: the owner serializes access.
+ */
+class TlsfAllocator {
+public:
+    static constexpr uint32_t kInvalidNode = UINT32_MAX;
+
+    explicit TlsfAllocator(uint64_t uSize_ic = 0u);
+
+    /** Forget all allocations and manage a range of uSize_ic bytes. */
+    void Reset(uint64_t uSize_ic);
+
+    /**
+     * Allocate uSize_ic bytes at an offset aligned to uAlign_ic (power of two). Returns the node handle to pass to
+     * Free, or kInvalidNode when no free range fits.
+     */
+    uint32_t Allocate(uint64_t uSize_ic, uint64_t uAlign_ic, uint64_t& uOffset_out);
+    /** Release an allocation returned by Allocate. */
+    void Free(uint32_t lNode_ic);
+
+    uint64_t GetSize() const { return this->m_uSize; }
+    uint64_t GetUsedBytes() const { return this->m_uUsed; }
+    uint64_t GetFreeBytes() const { return this->m_uSize - this->m_uUsed; }
+    uint32_t GetAllocationCount() const { return this->m_lAllocations; }
+    uint32_t GetFreeRangeCount() const { return this->m_lFreeRanges; }
+    bool IsEmpty() const { return this->m_lAllocations == 0u; }
+    /** Largest single free range (what the next allocation can get at most, before alignment). */
+    uint64_t GetLargestFreeRange() const;
+
+private:
+    static constexpr uint32_t kSlBits = 3u;
+    static constexpr uint32_t kSlCount = 1u << kSlBits;
+    static constexpr uint32_t kSmallLog2 = 8u;  // Ranges below 256 bytes share first-level bin 0 (32-byte steps)
+    static constexpr uint32_t kFlCount = 64u - kSmallLog2 + 1u;
+
+    struct Node {
+        uint64_t uOffset = 0u;
+        uint64_t uSize = 0u;
+        uint32_t lPrevPhys = kInvalidNode;  // Neighbouring ranges in address order
+        uint32_t lNextPhys = kInvalidNode;
+        uint32_t lPrevFree = kInvalidNode;  // Bin list links (free ranges only)
+        uint32_t lNextFree = kInvalidNode;
+        bool bFree = false;
+    };
+
+    static void Mapping(uint64_t uSize_ic, uint32_t& lFl_out, uint32_t& lSl_out);
+    uint32_t NewNode();
+    void ReleaseNode(uint32_t lNode_ic);
+    void InsertFree(uint32_t lNode_ic);
+    void RemoveFree(uint32_t lNode_ic);
+    /** First free range in a bin at or above the one for uSize_ic (every range in it is >= uSize_ic). */
+    uint32_t FindFree(uint64_t uSize_ic) const;
+
+    std::vector<Node> m_vecNodes;
+    std::vector<uint32_t> m_vecFreeNodes;  // Recycled node slots
+    uint32_t m_aBinHeads[kFlCount][kSlCount] = {};
+    uint64_t m_uFlBitmap = 0u;
+    uint8_t m_aSlBitmap[kFlCount] = {};
+    uint64_t m_uSize = 0u;
+    uint64_t m_uUsed = 0u;
+    uint32_t m_lAllocations = 0u;
+    uint32_t m_lFreeRanges = 0u;
+};
@@ -2,6 +2,7 @@
  * VulkanCommandBuffers — one command pool and one primary command buffer per swapchain image.
  * Record() encodes: begin render pass, set viewport/scissor, then for each DrawCall bind pipeline,
  * push constants, and vkCmdDraw; end render pass.
+ * Secondary pools: one per (frame in flight, thread slot), reset per frame with vkResetCommandPool.
  */
 #include "vulkan_command_buffers.h"
 #include "vulkan_utils.h"
@@ -15,6 +16,7 @@ void VulkanCommandBuffers::Create(VkDevice pDevice_ic, uint32_t lQueueFamilyInde
     }
 
     this->m_device = pDevice_ic;
+    this->m_lQueueFamilyIndex = lQueueFamilyIndex_ic;
 
     VkCommandPoolCreateInfo stPoolInfo = {
         .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
@@ -49,6 +51,7 @@ void VulkanCommandBuffers::Create(VkDevice pDevice_ic, uint32_t lQueueFamilyInde
 }
 
 void VulkanCommandBuffers::Destroy() {
+    DestroySecondaryPools();
     if ((this->m_device != VK_NULL_HANDLE) && (this->m_commandPool != VK_NULL_HANDLE) && (this->m_commandBuffers.empty() == false)) {
         vkFreeCommandBuffers(this->m_device, this->m_commandPool, static_cast<uint32_t>(this->m_commandBuffers.size()), this->m_commandBuffers.data());
         this->m_commandBuffers.clear();
@@ -81,25 +84,7 @@ void VulkanCommandBuffers::Record(uint32_t lIndex_ic, VkRenderPass pRenderPass_i
         }
     }
 
-    VkCommandBuffer pCmd = this->m_commandBuffers[lIndex_ic];
-
-    VkResult result = vkResetCommandBuffer(pCmd, static_cast<VkCommandBufferResetFlags>(0));
-    if (result != VK_SUCCESS) {
-        VulkanUtils::LogErr("vkResetCommandBuffer failed: {}", static_cast<int>(result));
-        throw std::runtime_error("VulkanCommandBuffers::Record: reset failed");
-    }
-
-    VkCommandBufferBeginInfo stBeginInfo = {
-        .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-        .pNext            = nullptr,
-        .flags            = static_cast<VkCommandBufferUsageFlags>(0),
-        .pInheritanceInfo = nullptr,
-    };
-    result = vkBeginCommandBuffer(pCmd, &stBeginInfo);
-    if (result != VK_SUCCESS) {
-        VulkanUtils::LogErr("vkBeginCommandBuffer failed: {}", static_cast<int>(result));
-        throw std::runtime_error("VulkanCommandBuffers::Record: begin failed");
-    }
+    VkCommandBuffer pCmd = BeginPrimary(lIndex_ic);
 
     // Pre-scene callback (for offscreen/PIP viewport rendering)
     if (preSceneCallback) {
@@ -120,9 +105,18 @@ void VulkanCommandBuffers::Record(uint32_t lIndex_ic, VkRenderPass pRenderPass_i
     vkCmdSetViewport(pCmd, 0, 1, &stViewport_ic);
     vkCmdSetScissor(pCmd, 0, 1, &stScissor_ic);
 
+    /* Batches share the per-pipeline sets (bindless textures): skip binds identical to the previous draw's. */
+    VkPipeline pBoundPipeline = VK_NULL_HANDLE;
+    const DrawCall* pBoundSets = nullptr;
     for (const auto& stD : vecDrawCalls_ic) {
-        vkCmdBindPipeline(pCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, stD.pipeline);
-        if (!stD.descriptorSets.empty()) {
+        if (stD.pipeline != pBoundPipeline) {
+            vkCmdBindPipeline(pCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, stD.pipeline);
+            pBoundPipeline = stD.pipeline;
+        }
+        const bool bSameSets = (pBoundSets != nullptr) && (pBoundSets->pipelineLayout == stD.pipelineLayout) &&
+                               (pBoundSets->descriptorSets == stD.descriptorSets) && (pBoundSets->dynamicOffsets == stD.dynamicOffsets);
+        if ((!stD.descriptorSets.empty()) && (bSameSets == false)) {
+            pBoundSets = &stD;
             /* Bind descriptor sets with or without dynamic offsets. */
             if (!stD.dynamicOffsets.empty()) {
                 vkCmdBindDescriptorSets(pCmd, VK_PIPELINE_BIND_POINT_GRAPHICS, stD.pipelineLayout, 0,
@@ -153,7 +147,11 @@ void VulkanCommandBuffers::Record(uint32_t lIndex_ic, VkRenderPass pRenderPass_i
         if ((stD.pPushConstants != nullptr) && (stD.pushConstantSize > 0))
             vkCmdPushConstants(pCmd, stD.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, stD.pushConstantSize, stD.pPushConstants);
         
-        if (stD.indirectBuffer != VK_NULL_HANDLE) {
+        if ((stD.indirectBuffer != VK_NULL_HANDLE) && (stD.indirectCountBuffer != VK_NULL_HANDLE)) {
+            // GPU meshlet draw: commands and count written by compute shader
+            vkCmdDrawIndirectCount(pCmd, stD.indirectBuffer, stD.indirectOffset, stD.indirectCountBuffer, stD.indirectCountOffset,
+                                   stD.maxIndirectDrawCount, sizeof(VkDrawIndirectCommand));
+        } else if (stD.indirectBuffer != VK_NULL_HANDLE) {
             // GPU indirect draw: instanceCount written by compute shader
             vkCmdDrawIndirect(pCmd, stD.indirectBuffer, stD.indirectOffset, 1, sizeof(VkDrawIndirectCommand));
         } else {
@@ -169,13 +167,189 @@ void VulkanCommandBuffers::Record(uint32_t lIndex_ic, VkRenderPass pRenderPass_i
 
     vkCmdEndRenderPass(pCmd);
 
-    result = vkEndCommandBuffer(pCmd);
+    VkResult result = vkEndCommandBuffer(pCmd);
     if (result != VK_SUCCESS) {
         VulkanUtils::LogErr("vkEndCommandBuffer failed: {}", static_cast<int>(result));
         throw std::runtime_error("VulkanCommandBuffers::Record: end failed");
     }
 }
 
+void VulkanCommandBuffers::RecordSecondaries(uint32_t lIndex_ic, VkRenderPass pRenderPass_ic, VkFramebuffer pFramebuffer_ic,
+                                             VkRect2D stRenderArea_ic, const std::vector<VkCommandBuffer>& vecSecondaries_ic,
+                                             const VkClearValue* pClearValues_ic, uint32_t lClearValueCount_ic,
+                                             std::function<void(VkCommandBuffer)> preSceneCallback) {
+    if ((lIndex_ic >= this->m_commandBuffers.size()) || (pRenderPass_ic == VK_NULL_HANDLE) || (pFramebuffer_ic == VK_NULL_HANDLE)) {
+        VulkanUtils::LogErr("VulkanCommandBuffers::RecordSecondaries: invalid index or handles");
+        throw std::runtime_error("VulkanCommandBuffers::RecordSecondaries: invalid parameters");
+    }
+    if ((lClearValueCount_ic > 0) && (pClearValues_ic == nullptr)) {
+        VulkanUtils::LogErr("VulkanCommandBuffers::RecordSecondaries: clearValueCount > 0 but pClearValues is null");
+        throw std::runtime_error("VulkanCommandBuffers::RecordSecondaries: invalid clear values");
+    }
+
+    VkCommandBuffer pCmd = BeginPrimary(lIndex_ic);
+
+    if (preSceneCallback) {
+        preSceneCallback(pCmd);
+    }
+
+    VkRenderPassBeginInfo stRpBegin = {
+        .sType             = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+        .pNext             = nullptr,
+        .renderPass        = pRenderPass_ic,
+        .framebuffer       = pFramebuffer_ic,
+        .renderArea        = stRenderArea_ic,
+        .clearValueCount   = lClearValueCount_ic,
+        .pClearValues      = pClearValues_ic,
+    };
+    vkCmdBeginRenderPass(pCmd, &stRpBegin, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    if (vecSecondaries_ic.empty() == false)
+        vkCmdExecuteCommands(pCmd, static_cast<uint32_t>(vecSecondaries_ic.size()), vecSecondaries_ic.data());
+    vkCmdEndRenderPass(pCmd);
+
+    VkResult result = vkEndCommandBuffer(pCmd);
+    if (result != VK_SUCCESS) {
+        VulkanUtils::LogErr("vkEndCommandBuffer failed: {}", static_cast<int>(result));
+        throw std::runtime_error("VulkanCommandBuffers::RecordSecondaries: end failed");
+    }
+}
+
+VkCommandBuffer VulkanCommandBuffers::BeginPrimary(uint32_t lIndex_ic) {
+    VkCommandBuffer pCmd = this->m_commandBuffers[lIndex_ic];
+
+    VkResult result = vkResetCommandBuffer(pCmd, static_cast<VkCommandBufferResetFlags>(0));
+    if (result != VK_SUCCESS) {
+        VulkanUtils::LogErr("vkResetCommandBuffer failed: {}", static_cast<int>(result));
+        throw std::runtime_error("VulkanCommandBuffers::Record: reset failed");
+    }
+
+    VkCommandBufferBeginInfo stBeginInfo = {
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext            = nullptr,
+        .flags            = static_cast<VkCommandBufferUsageFlags>(0),
+        .pInheritanceInfo = nullptr,
+    };
+    result = vkBeginCommandBuffer(pCmd, &stBeginInfo);
+    if (result != VK_SUCCESS) {
+        VulkanUtils::LogErr("vkBeginCommandBuffer failed: {}", static_cast<int>(result));
+        throw std::runtime_error("VulkanCommandBuffers::Record: begin failed");
+    }
+    return pCmd;
+}
+
+void VulkanCommandBuffers::CreateSecondaryPools(uint32_t lFramesInFlight_ic, uint32_t lThreadSlots_ic) {
+    if ((this->m_device == VK_NULL_HANDLE) || (lFramesInFlight_ic == 0) || (lThreadSlots_ic == 0)) {
+        VulkanUtils::LogErr("VulkanCommandBuffers::CreateSecondaryPools: no device or zero frames/slots");
+        throw std::runtime_error("VulkanCommandBuffers::CreateSecondaryPools: invalid parameters");
+    }
+    DestroySecondaryPools();
+
+    /* Transient: buffers are re-recorded every frame and only ever reset with the whole pool. */
+    VkCommandPoolCreateInfo stPoolInfo = {
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .pNext            = nullptr,
+        .flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = this->m_lQueueFamilyIndex,
+    };
+    this->m_vecSecondaryPools = std::vector<SecondaryPool>(static_cast<size_t>(lFramesInFlight_ic) * lThreadSlots_ic);
+    this->m_lSecondarySlots = lThreadSlots_ic;
+    for (SecondaryPool& stPool : this->m_vecSecondaryPools) {
+        VkResult r = vkCreateCommandPool(this->m_device, &stPoolInfo, nullptr, &stPool.pool);
+        if (r != VK_SUCCESS) {
+            DestroySecondaryPools();
+            VulkanUtils::LogErr("vkCreateCommandPool (secondary) failed: {}", static_cast<int>(r));
+            throw std::runtime_error("VulkanCommandBuffers::CreateSecondaryPools: command pool failed");
+        }
+    }
+    VulkanUtils::LogInfo("VulkanCommandBuffers: {} secondary pools ({} frames x {} threads)",
+                         this->m_vecSecondaryPools.size(), lFramesInFlight_ic, lThreadSlots_ic);
+}
+
+void VulkanCommandBuffers::ResetSecondaryPools(uint32_t lFrame_ic) {
+    if (this->m_lSecondarySlots == 0)
+        return;
+    const size_t zFirst = static_cast<size_t>(lFrame_ic) * this->m_lSecondarySlots;
+    if (zFirst >= this->m_vecSecondaryPools.size())
+        return;
+    for (size_t z = zFirst; z < zFirst + this->m_lSecondarySlots; ++z) {
+        SecondaryPool& stPool = this->m_vecSecondaryPools[z];
+        if (stPool.lUsed == 0)
+            continue;
+        VkResult r = vkResetCommandPool(this->m_device, stPool.pool, static_cast<VkCommandPoolResetFlags>(0));
+        if (r != VK_SUCCESS)
+            VulkanUtils::LogErr("vkResetCommandPool failed: {}", static_cast<int>(r));
+        stPool.lUsed = 0;
+    }
+}
+
+VkCommandBuffer VulkanCommandBuffers::BeginSecondary(uint32_t lFrame_ic, uint32_t lSlot_ic, VkRenderPass pRenderPass_ic,
+                                                     VkFramebuffer pFramebuffer_ic) {
+    const size_t zPool = static_cast<size_t>(lFrame_ic) * this->m_lSecondarySlots + lSlot_ic;
+    if ((lSlot_ic >= this->m_lSecondarySlots) || (zPool >= this->m_vecSecondaryPools.size()) || (pRenderPass_ic == VK_NULL_HANDLE)) {
+        VulkanUtils::LogErr("VulkanCommandBuffers::BeginSecondary: invalid frame {} / slot {} or render pass", lFrame_ic, lSlot_ic);
+        throw std::runtime_error("VulkanCommandBuffers::BeginSecondary: invalid parameters");
+    }
+    SecondaryPool& stPool = this->m_vecSecondaryPools[zPool];
+    if (stPool.lUsed == stPool.vecBuffers.size()) {
+        VkCommandBufferAllocateInfo stAllocInfo = {
+            .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .pNext              = nullptr,
+            .commandPool        = stPool.pool,
+            .level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+            .commandBufferCount = 1,
+        };
+        VkCommandBuffer pNew = VK_NULL_HANDLE;
+        VkResult r = vkAllocateCommandBuffers(this->m_device, &stAllocInfo, &pNew);
+        if (r != VK_SUCCESS) {
+            VulkanUtils::LogErr("vkAllocateCommandBuffers (secondary) failed: {}", static_cast<int>(r));
+            throw std::runtime_error("VulkanCommandBuffers::BeginSecondary: allocate failed");
+        }
+        stPool.vecBuffers.push_back(pNew);
+    }
+    VkCommandBuffer pCmd = stPool.vecBuffers[stPool.lUsed++];
+
+    VkCommandBufferInheritanceInfo stInheritance = {
+        .sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext                = nullptr,
+        .renderPass           = pRenderPass_ic,
+        .subpass              = 0,
+        .framebuffer          = pFramebuffer_ic,
+        .occlusionQueryEnable = VK_FALSE,
+        .queryFlags           = static_cast<VkQueryControlFlags>(0),
+        .pipelineStatistics   = static_cast<VkQueryPipelineStatisticFlags>(0),
+    };
+    VkCommandBufferBeginInfo stBeginInfo = {
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext            = nullptr,
+        .flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        .pInheritanceInfo = &stInheritance,
+    };
+    VkResult r = vkBeginCommandBuffer(pCmd, &stBeginInfo);
+    if (r != VK_SUCCESS) {
+        VulkanUtils::LogErr("vkBeginCommandBuffer (secondary) failed: {}", static_cast<int>(r));
+        throw std::runtime_error("VulkanCommandBuffers::BeginSecondary: begin failed");
+    }
+    return pCmd;
+}
+
+void VulkanCommandBuffers::EndSecondary(VkCommandBuffer pCmd_ic) {
+    VkResult r = vkEndCommandBuffer(pCmd_ic);
+    if (r != VK_SUCCESS) {
+        VulkanUtils::LogErr("vkEndCommandBuffer (secondary) failed: {}", static_cast<int>(r));
+        throw std::runtime_error("VulkanCommandBuffers::EndSecondary: end failed");
+    }
+}
+
+void VulkanCommandBuffers::DestroySecondaryPools() {
+    /* Destroying a pool frees its buffers. */
+    for (SecondaryPool& stPool : this->m_vecSecondaryPools) {
+        if (stPool.pool != VK_NULL_HANDLE)
+            vkDestroyCommandPool(this->m_device, stPool.pool, nullptr);
+    }
+    this->m_vecSecondaryPools.clear();
+    this->m_lSecondarySlots = 0;
+}
+
 VkCommandBuffer VulkanCommandBuffers::Get(uint32_t lIndex_ic) const {
     if (lIndex_ic >= this->m_commandBuffers.size())
         return VK_NULL_HANDLE;
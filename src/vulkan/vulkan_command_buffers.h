@@ -1,5 +1,6 @@
 #pragma once
 
+#include "vulkan_types.h"
 #include <string>
 #include <vector>
 #include <functional>
@@ -30,6 +31,10 @@ struct DrawCall {
     /** GPU indirect draw support (instanceCount written by GPU compute). */
     VkBuffer          indirectBuffer   = VK_NULL_HANDLE;  /**< Indirect buffer for vkCmdDrawIndirect. */
     VkDeviceSize      indirectOffset   = 0;               /**< Offset into indirect buffer. */
+    /** Optional GPU-written draw count (meshlet culling). When valid, vkCmdDrawIndirectCount draws up to maxIndirectDrawCount commands. */
+    VkBuffer          indirectCountBuffer  = VK_NULL_HANDLE;
+    VkDeviceSize      indirectCountOffset  = 0;
+    uint32_t          maxIndirectDrawCount = 0;
     
     /** Per-object data for per-viewport MVP recalculation. */
     const float*      pLocalTransform  = nullptr;  /**< Pointer to object's 4x4 model matrix (column-major). */
@@ -38,11 +43,16 @@ struct DrawCall {
     
     /** Pipeline key for per-viewport render mode switching. */
     std::string       pipelineKey;
+    /** Cull / front face / depth / polygon mode; recorded per draw when the device has extended dynamic state. */
+    RasterDynamicState rasterState;
 };
 
 /*
  * Command pool and primary command buffers (one per swapchain image).
  * Recreated when swapchain is recreated. Record() fills a buffer with render pass + list of draws.
+ * Secondary command buffers for parallel recording come from one pool per (frame in flight, thread slot):
+ * each thread records into its own pool without locking, and a frame's pools are reset together once its
+ * fence has been waited on. RecordSecondaries() executes them in order inside the render pass.
  */
 class VulkanCommandBuffers {
 public:
@@ -62,12 +72,43 @@ public:
                 std::function<void(VkCommandBuffer)> preSceneCallback = nullptr,
                 std::function<void(VkCommandBuffer)> postSceneCallback = nullptr);
 
+    /** Record buffer: begin render pass with secondary contents, execute vecSecondaries_ic in order, end render pass.
+     *  @param preSceneCallback Optional callback invoked before the render pass (compute dispatches, offscreen passes). */
+    void RecordSecondaries(uint32_t lIndex_ic, VkRenderPass pRenderPass_ic, VkFramebuffer pFramebuffer_ic,
+                           VkRect2D stRenderArea_ic, const std::vector<VkCommandBuffer>& vecSecondaries_ic,
+                           const VkClearValue* pClearValues_ic, uint32_t lClearValueCount_ic,
+                           std::function<void(VkCommandBuffer)> preSceneCallback = nullptr);
+
+    /** Create lFramesInFlight_ic x lThreadSlots_ic secondary pools (after Create; destroyed by Destroy). */
+    void CreateSecondaryPools(uint32_t lFramesInFlight_ic, uint32_t lThreadSlots_ic);
+    /** Main thread, after frame lFrame_ic's fence has been waited on: reset its pools so their buffers can be re-recorded. */
+    void ResetSecondaryPools(uint32_t lFrame_ic);
+    /** Begin a secondary buffer of (lFrame_ic, lSlot_ic) continuing subpass 0 of pRenderPass_ic. Only thread lSlot_ic may call.
+     *  Dynamic state is not inherited: set viewport and scissor in the buffer. */
+    VkCommandBuffer BeginSecondary(uint32_t lFrame_ic, uint32_t lSlot_ic, VkRenderPass pRenderPass_ic, VkFramebuffer pFramebuffer_ic);
+    void EndSecondary(VkCommandBuffer pCmd_ic);
+    uint32_t GetSecondarySlotCount() const { return this->m_lSecondarySlots; }
+
     VkCommandBuffer Get(uint32_t lIndex_ic) const;
     uint32_t GetCount() const { return static_cast<uint32_t>(this->m_commandBuffers.size()); }
     bool IsValid() const { return this->m_commandPool != VK_NULL_HANDLE; }
 
 private:
+    /* One thread's pool for one frame; own cache line (slots are bumped by different threads). */
+    struct alignas(64) SecondaryPool {
+        VkCommandPool                pool   = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> vecBuffers;  // Allocated on demand, kept across resets
+        uint32_t                     lUsed  = 0;  // Buffers handed out since the last reset
+    };
+
+    /* Reset and begin primary buffer lIndex_ic. */
+    VkCommandBuffer BeginPrimary(uint32_t lIndex_ic);
+    void DestroySecondaryPools();
+
     VkDevice m_device = VK_NULL_HANDLE;
+    uint32_t m_lQueueFamilyIndex = 0;
     VkCommandPool m_commandPool = VK_NULL_HANDLE;
     std::vector<VkCommandBuffer> m_commandBuffers;
+    std::vector<SecondaryPool> m_vecSecondaryPools;  // [frame * m_lSecondarySlots + slot]
+    uint32_t m_lSecondarySlots = 0;
 };
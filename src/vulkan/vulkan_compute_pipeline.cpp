@@ -5,7 +5,8 @@
 void VulkanComputePipeline::Create(VkDevice pDevice_ic,
                                    VulkanShaderManager* pShaderManager_ic,
                                    const std::string& sCompPath_ic,
-                                   const ComputePipelineLayoutDescriptor& stLayoutDescriptor_ic) {
+                                   const ComputePipelineLayoutDescriptor& stLayoutDescriptor_ic,
+                                   VkPipelineCache pipelineCache_ic) {
     VulkanUtils::LogTrace("VulkanComputePipeline::Create: {}", sCompPath_ic);
     
     if (pDevice_ic == VK_NULL_HANDLE) {
@@ -72,7 +73,7 @@ void VulkanComputePipeline::Create(VkDevice pDevice_ic,
         .basePipelineIndex  = -1,
     };
 
-    r = vkCreateComputePipelines(pDevice_ic, VK_NULL_HANDLE, 1, &stPipelineInfo, nullptr, &m_pipeline);
+    r = vkCreateComputePipelines(pDevice_ic, pipelineCache_ic, 1, &stPipelineInfo, nullptr, &m_pipeline);
     if (r != VK_SUCCESS) {
         VulkanUtils::LogErr("VulkanComputePipeline::Create: vkCreateComputePipelines failed: {}", static_cast<int>(r));
         vkDestroyPipelineLayout(pDevice_ic, m_pipelineLayout, nullptr);
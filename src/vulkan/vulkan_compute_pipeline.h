@@ -31,11 +31,13 @@ public:
      * @param pShaderManager_ic Shader manager for loading SPIR-V
      * @param sCompPath_ic Path to compiled .comp.spv shader
      * @param stLayoutDescriptor_ic Push constants and descriptor set layouts
+     * @param pipelineCache_ic Pipeline cache (VulkanPipelineCache), or VK_NULL_HANDLE
      */
     void Create(VkDevice pDevice_ic,
                 VulkanShaderManager* pShaderManager_ic,
                 const std::string& sCompPath_ic,
-                const ComputePipelineLayoutDescriptor& stLayoutDescriptor_ic);
+                const ComputePipelineLayoutDescriptor& stLayoutDescriptor_ic,
+                VkPipelineCache pipelineCache_ic = VK_NULL_HANDLE);
     
     void Destroy();
 
@@ -66,23 +66,14 @@ void VulkanDepthImage::Create(VkDevice pDevice_ic, VkPhysicalDevice pPhysicalDev
         throw std::runtime_error("VulkanDepthImage::Create: image failed");
     }
 
-    VkMemoryRequirements stMemReqs = {};
-    vkGetImageMemoryRequirements(pDevice_ic, this->m_image, &stMemReqs);
-    VkMemoryAllocateInfo stAllocInfo = {
-        .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        .pNext           = nullptr,
-        .allocationSize  = stMemReqs.size,
-        .memoryTypeIndex = VulkanUtils::FindMemoryType(pPhysicalDevice_ic, stMemReqs.memoryTypeBits,
-                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
-    };
-    r = vkAllocateMemory(pDevice_ic, &stAllocInfo, nullptr, &this->m_memory);
+    r = VulkanMemory::AllocateForImage(pDevice_ic, pPhysicalDevice_ic, this->m_image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                       MemoryCategory::RenderTarget, true, this->m_memory);
     if (r != VK_SUCCESS) {
         vkDestroyImage(pDevice_ic, this->m_image, nullptr);
         this->m_image = VK_NULL_HANDLE;
-        VulkanUtils::LogErr("vkAllocateMemory (depth) failed: {}", static_cast<int>(r));
+        VulkanUtils::LogErr("Depth image memory allocation failed: {}", static_cast<int>(r));
         throw std::runtime_error("VulkanDepthImage::Create: memory failed");
     }
-    vkBindImageMemory(pDevice_ic, this->m_image, this->m_memory, static_cast<VkDeviceSize>(0));
 
     VkImageViewCreateInfo stViewInfo = {
         .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
@@ -107,9 +98,8 @@ void VulkanDepthImage::Create(VkDevice pDevice_ic, VkPhysicalDevice pPhysicalDev
     };
     r = vkCreateImageView(pDevice_ic, &stViewInfo, nullptr, &this->m_view);
     if (r != VK_SUCCESS) {
-        vkFreeMemory(pDevice_ic, this->m_memory, nullptr);
         vkDestroyImage(pDevice_ic, this->m_image, nullptr);
-        this->m_memory = VK_NULL_HANDLE;
+        VulkanMemory::Free(pDevice_ic, this->m_memory);
         this->m_image  = VK_NULL_HANDLE;
         VulkanUtils::LogErr("vkCreateImageView (depth) failed: {}", static_cast<int>(r));
         throw std::runtime_error("VulkanDepthImage::Create: view failed");
@@ -127,10 +117,7 @@ void VulkanDepthImage::Destroy() {
         vkDestroyImage(this->m_device, this->m_image, nullptr);
         this->m_image = VK_NULL_HANDLE;
     }
-    if (this->m_memory != VK_NULL_HANDLE) {
-        vkFreeMemory(this->m_device, this->m_memory, nullptr);
-        this->m_memory = VK_NULL_HANDLE;
-    }
+    VulkanMemory::Free(this->m_device, this->m_memory);
     this->m_device = VK_NULL_HANDLE;
     this->m_format = VK_FORMAT_UNDEFINED;
 }
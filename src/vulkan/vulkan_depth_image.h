@@ -1,5 +1,6 @@
 #pragma once
 
+#include "vulkan_memory.h"
 #include <vulkan/vulkan.h>
 
 /*
@@ -25,7 +26,7 @@ public:
 private:
     VkDevice       m_device = VK_NULL_HANDLE;
     VkImage        m_image  = VK_NULL_HANDLE;
-    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+    MemoryAllocation m_memory;  // Dedicated (render target)
     VkImageView    m_view   = VK_NULL_HANDLE;
     VkFormat       m_format = VK_FORMAT_UNDEFINED;
 };
@@ -1,6 +1,10 @@
 #include "vulkan_device.h"
 #include "vulkan_utils.h"
+#include <cstring>
+#include <format>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 static constexpr const char* DEVICE_EXTENSION_SWAPCHAIN = VK_KHR_SWAPCHAIN_EXTENSION_NAME;
@@ -136,16 +140,125 @@ void VulkanDevice::Create(VkInstance pInstance_ic, VkSurfaceKHR surface_ic) {
         throw std::runtime_error("Physical device does not support geometry shaders");
     }
 
+    std::vector<const char*> vecExtensions = { DEVICE_EXTENSION_SWAPCHAIN };
+    uint32_t lExtensionCount = static_cast<uint32_t>(0);
+    vkEnumerateDeviceExtensionProperties(this->m_physicalDevice, nullptr, &lExtensionCount, nullptr);
+    std::vector<VkExtensionProperties> vecAvailableExtensions(lExtensionCount);
+    vkEnumerateDeviceExtensionProperties(this->m_physicalDevice, nullptr, &lExtensionCount, vecAvailableExtensions.data());
+    auto hasExtension = [&vecAvailableExtensions](const char* pName_ic) {
+        for (const VkExtensionProperties& stExt : vecAvailableExtensions) {
+            if (std::strcmp(stExt.extensionName, pName_ic) == 0)
+                return true;
+        }
+        return false;
+    };
+    /* Extended dynamic state is core in 1.3 (no feature bit); older devices need the extension and its feature. */
+    const bool bCoreDynamicState = (stBestProps.apiVersion >= VK_API_VERSION_1_3);
+    const bool bExtDynamicState = (bCoreDynamicState == false) && hasExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+    const bool bExtDynamicState3 = hasExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT stSupportedDynamic3 = {};
+    stSupportedDynamic3.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT stSupportedDynamic = {};
+    stSupportedDynamic.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+    /* VkPhysicalDeviceVulkan12Features may only be chained (queried or enabled) on a 1.2+ device; the required descriptor
+       indexing below is core 1.2, so an older device fails the same way a device without the features does. */
+    if (stBestProps.apiVersion < VK_API_VERSION_1_2) {
+        const std::string sVersion = std::format("Vulkan 1.2 (device reports {}.{}.{})", VK_API_VERSION_MAJOR(stBestProps.apiVersion),
+                                                 VK_API_VERSION_MINOR(stBestProps.apiVersion), VK_API_VERSION_PATCH(stBestProps.apiVersion));
+        VulkanUtils::LogErr("Physical device does not support descriptor indexing (bindless textures), missing: {}", sVersion);
+        throw std::runtime_error("Physical device does not support descriptor indexing (bindless textures), missing: " + sVersion);
+    }
+    /* Vulkan 1.2 features: drawIndirectCount (optional) lets GPU culling passes (meshlet culler) emit a variable number of draws. */
+    VkPhysicalDeviceVulkan12Features stSupported12 = {};
+    stSupported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    if (bExtDynamicState3 == true) {
+        stSupportedDynamic3.pNext = stSupported12.pNext;
+        stSupported12.pNext = &stSupportedDynamic3;
+    }
+    if (bExtDynamicState == true) {
+        stSupportedDynamic.pNext = stSupported12.pNext;
+        stSupported12.pNext = &stSupportedDynamic;
+    }
+    VkPhysicalDeviceFeatures2 stSupported = {};
+    stSupported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    stSupported.pNext = &stSupported12;
+    vkGetPhysicalDeviceFeatures2(this->m_physicalDevice, &stSupported);
+
+    VkPhysicalDeviceVulkan12Features stEnabled12 = {};
+    stEnabled12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    stEnabled12.drawIndirectCount = stSupported12.drawIndirectCount;
+    this->m_bDrawIndirectCount = (stSupported12.drawIndirectCount == VK_TRUE);
+    VulkanUtils::LogInfo("Device feature drawIndirectCount: {}", this->m_bDrawIndirectCount);
+
+    /* Required descriptor indexing (core 1.2): the bindless texture array (BindlessTextureTable) is indexed per object
+       with nonuniformEXT and updated while earlier frames are still in flight. There is no per-material descriptor set
+       fallback; README "Requirements" lists these features. */
+    const std::pair<VkBool32, const char*> stRequired12[] = {
+        { stSupported12.runtimeDescriptorArray, "runtimeDescriptorArray" },
+        { stSupported12.descriptorBindingPartiallyBound, "descriptorBindingPartiallyBound" },
+        { stSupported12.shaderSampledImageArrayNonUniformIndexing, "shaderSampledImageArrayNonUniformIndexing" },
+        { stSupported12.descriptorBindingSampledImageUpdateAfterBind, "descriptorBindingSampledImageUpdateAfterBind" },
+        { stSupported12.descriptorBindingUpdateUnusedWhilePending, "descriptorBindingUpdateUnusedWhilePending" },
+    };
+    std::string sMissing12;
+    for (const auto& [bSupported, pName] : stRequired12) {
+        if (bSupported == VK_TRUE)
+            continue;
+        if (sMissing12.empty() == false)
+            sMissing12 += ", ";
+        sMissing12 += pName;
+    }
+    if (sMissing12.empty() == false) {
+        VulkanUtils::LogErr("Physical device does not support descriptor indexing (bindless textures), missing: {}", sMissing12);
+        throw std::runtime_error("Physical device does not support descriptor indexing (bindless textures), missing: " + sMissing12);
+    }
+    stEnabled12.descriptorIndexing = stSupported12.descriptorIndexing;
+    stEnabled12.runtimeDescriptorArray = VK_TRUE;
+    stEnabled12.descriptorBindingPartiallyBound = VK_TRUE;
+    stEnabled12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    stEnabled12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    stEnabled12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+
+    /* Optional VK_EXT_memory_budget: DeviceMemoryAllocator reads per-heap budget and usage from the driver. */
+    this->m_bMemoryBudget = hasExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (this->m_bMemoryBudget == true)
+        vecExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    VulkanUtils::LogInfo("Device extension VK_EXT_memory_budget: {}", this->m_bMemoryBudget);
+
+    /* Optional extended dynamic state: cull mode, front face and depth state (and polygon mode with
+       VK_EXT_extended_dynamic_state3) are set per draw, so PipelineManager builds one pipeline where materials
+       differ only in those. Without it every combination stays a static pipeline variant. */
+    const bool bDynamicState = (bCoreDynamicState == true) || (stSupportedDynamic.extendedDynamicState == VK_TRUE);
+    const bool bDynamicPolygonMode = (bDynamicState == true) &&
+        (stSupportedDynamic3.extendedDynamicState3PolygonMode == VK_TRUE) && (stDeviceFeatures.fillModeNonSolid == VK_TRUE);
+    VkPhysicalDeviceExtendedDynamicStateFeaturesEXT stEnabledDynamic = {};
+    stEnabledDynamic.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT;
+    VkPhysicalDeviceExtendedDynamicState3FeaturesEXT stEnabledDynamic3 = {};
+    stEnabledDynamic3.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+    if ((bDynamicState == true) && (bCoreDynamicState == false)) {
+        vecExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME);
+        stEnabledDynamic.extendedDynamicState = VK_TRUE;
+        stEnabledDynamic.pNext = stEnabled12.pNext;
+        stEnabled12.pNext = &stEnabledDynamic;
+    }
+    if (bDynamicPolygonMode == true) {
+        vecExtensions.push_back(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+        stEnabledDynamic3.extendedDynamicState3PolygonMode = VK_TRUE;
+        stEnabledDynamic3.pNext = stEnabled12.pNext;
+        stEnabled12.pNext = &stEnabledDynamic3;
+    }
+
     VkDeviceCreateInfo stCreateInfo = {
         .sType                 = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        .pNext                 = nullptr,
+        .pNext                 = &stEnabled12,
         .flags                 = 0,
         .queueCreateInfoCount  = static_cast<uint32_t>(vecQueueCreateInfos.size()),
         .pQueueCreateInfos     = vecQueueCreateInfos.data(),
         .enabledLayerCount     = VulkanUtils::ENABLE_VALIDATION_LAYERS ? static_cast<uint32_t>(VulkanUtils::VALIDATION_LAYERS.size()) : static_cast<uint32_t>(0u),
         .ppEnabledLayerNames   = VulkanUtils::ENABLE_VALIDATION_LAYERS ? VulkanUtils::VALIDATION_LAYERS.data() : nullptr,
-        .enabledExtensionCount = static_cast<uint32_t>(1),
-        .ppEnabledExtensionNames = &DEVICE_EXTENSION_SWAPCHAIN,
+        .enabledExtensionCount = static_cast<uint32_t>(vecExtensions.size()),
+        .ppEnabledExtensionNames = vecExtensions.data(),
         .pEnabledFeatures      = &stDeviceFeatures,
     };
 
@@ -162,6 +275,40 @@ void VulkanDevice::Create(VkInstance pInstance_ic, VkSurfaceKHR surface_ic) {
     } else {
         this->m_presentQueue = this->m_graphicsQueue;
     }
+
+    this->m_extendedDynamicState = {};
+    if (bDynamicState == true)
+        this->LoadExtendedDynamicState(bCoreDynamicState, bDynamicPolygonMode);
+    VulkanUtils::LogInfo("Device extended dynamic state: {} ({}), dynamic polygon mode: {}",
+                         this->m_extendedDynamicState.bEnabled, (bCoreDynamicState == true) ? "core 1.3" : "extension",
+                         this->m_extendedDynamicState.bPolygonMode);
+}
+
+void VulkanDevice::LoadExtendedDynamicState(bool bCore_ic, bool bPolygonMode_ic) {
+    ExtendedDynamicState& stState = this->m_extendedDynamicState;
+    auto load = [this, bCore_ic](const char* pCoreName_ic, const char* pExtName_ic) {
+        return vkGetDeviceProcAddr(this->m_logicalDevice, (bCore_ic == true) ? pCoreName_ic : pExtName_ic);
+    };
+    stState.pfnCmdSetCullMode = reinterpret_cast<PFN_vkCmdSetCullMode>(load("vkCmdSetCullMode", "vkCmdSetCullModeEXT"));
+    stState.pfnCmdSetFrontFace = reinterpret_cast<PFN_vkCmdSetFrontFace>(load("vkCmdSetFrontFace", "vkCmdSetFrontFaceEXT"));
+    stState.pfnCmdSetDepthTestEnable = reinterpret_cast<PFN_vkCmdSetDepthTestEnable>(
+        load("vkCmdSetDepthTestEnable", "vkCmdSetDepthTestEnableEXT"));
+    stState.pfnCmdSetDepthWriteEnable = reinterpret_cast<PFN_vkCmdSetDepthWriteEnable>(
+        load("vkCmdSetDepthWriteEnable", "vkCmdSetDepthWriteEnableEXT"));
+    stState.pfnCmdSetDepthCompareOp = reinterpret_cast<PFN_vkCmdSetDepthCompareOp>(
+        load("vkCmdSetDepthCompareOp", "vkCmdSetDepthCompareOpEXT"));
+    stState.bEnabled = (stState.pfnCmdSetCullMode != nullptr) && (stState.pfnCmdSetFrontFace != nullptr) &&
+                       (stState.pfnCmdSetDepthTestEnable != nullptr) && (stState.pfnCmdSetDepthWriteEnable != nullptr) &&
+                       (stState.pfnCmdSetDepthCompareOp != nullptr);
+    if ((stState.bEnabled == true) && (bPolygonMode_ic == true)) {
+        stState.pfnCmdSetPolygonMode = reinterpret_cast<PFN_vkCmdSetPolygonModeEXT>(
+            vkGetDeviceProcAddr(this->m_logicalDevice, "vkCmdSetPolygonModeEXT"));
+        stState.bPolygonMode = (stState.pfnCmdSetPolygonMode != nullptr);
+    }
+    if (stState.bEnabled == false) {
+        VulkanUtils::LogWarn("VulkanDevice: extended dynamic state entry points missing; using static pipeline state");
+        stState = {};
+    }
 }
 
 void VulkanDevice::Destroy() {
@@ -173,6 +320,7 @@ void VulkanDevice::Destroy() {
     this->m_graphicsQueue = VK_NULL_HANDLE;
     this->m_presentQueue  = VK_NULL_HANDLE;
     this->m_queueFamilyIndices = {};
+    this->m_extendedDynamicState = {};
     this->m_instance = VK_NULL_HANDLE;
 }
 
@@ -31,10 +31,18 @@ public:
     uint64_t GetMaxMemoryAllocationCount() const { return m_limits.maxMemoryAllocationCount; }
     VkDeviceSize GetMaxStorageBufferRange() const { return m_limits.maxStorageBufferRange; }
     const VkPhysicalDeviceLimits& GetLimits() const { return m_limits; }
+    /** True when vkCmdDrawIndirectCount (Vulkan 1.2 drawIndirectCount feature) was enabled. */
+    bool SupportsDrawIndirectCount() const { return this->m_bDrawIndirectCount; }
+    /** True when VK_EXT_memory_budget was enabled (heap budget / usage queries). */
+    bool SupportsMemoryBudget() const { return this->m_bMemoryBudget; }
+    /** Extended dynamic state enabled on the device and its entry points (bEnabled false: static pipeline state). */
+    const ExtendedDynamicState& GetExtendedDynamicState() const { return this->m_extendedDynamicState; }
 
 private:
     uint32_t RateSuitability(VkPhysicalDevice pPhysicalDevice_ic, const VkPhysicalDeviceProperties& stProps_ic);
     QueueFamilyIndices FindQueueFamilyIndices(VkPhysicalDevice pPhysicalDevice_ic, VkSurfaceKHR surface_ic);
+    /* Resolve the extended dynamic state entry points (core or EXT names) after vkCreateDevice. */
+    void LoadExtendedDynamicState(bool bCore_ic, bool bPolygonMode_ic);
 
     VkInstance m_instance = VK_NULL_HANDLE;
     VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
@@ -43,4 +51,7 @@ private:
     VkQueue m_graphicsQueue = VK_NULL_HANDLE;
     VkQueue m_presentQueue  = VK_NULL_HANDLE;
     VkPhysicalDeviceLimits m_limits = {};
+    bool m_bDrawIndirectCount = false;
+    bool m_bMemoryBudget = false;
+    ExtendedDynamicState m_extendedDynamicState = {};
 };
@@ -0,0 +1,197 @@
+/*
+ * VulkanMemory — Vulkan backend for DeviceMemoryAllocator and the resource allocate / bind / free helpers.
+ */
+#include "vulkan_memory.h"
+#include "vulkan_utils.h"
+#include <algorithm>
+#include <atomic>
+
+void VulkanMemoryBackend::Create(VkDevice device_ic, VkPhysicalDevice physicalDevice_ic, bool bMemoryBudget_ic) {
+    this->m_device = device_ic;
+    this->m_physicalDevice = physicalDevice_ic;
+    this->m_bMemoryBudget = bMemoryBudget_ic;
+}
+
+VkResult VulkanMemoryBackend::AllocateMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic, VkImage dedicatedImage_ic,
+                                             VkBuffer dedicatedBuffer_ic, VkDeviceMemory& memory_out) {
+    VkMemoryDedicatedAllocateInfo stDedicated = {
+        .sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+        .pNext  = nullptr,
+        .image  = dedicatedImage_ic,
+        .buffer = dedicatedBuffer_ic,
+    };
+    const bool bDedicated = (dedicatedImage_ic != VK_NULL_HANDLE) || (dedicatedBuffer_ic != VK_NULL_HANDLE);
+    VkMemoryAllocateInfo stAllocInfo = {
+        .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext           = bDedicated ? &stDedicated : nullptr,
+        .allocationSize  = uSize_ic,
+        .memoryTypeIndex = lMemoryType_ic,
+    };
+    return vkAllocateMemory(this->m_device, &stAllocInfo, nullptr, &memory_out);
+}
+
+void VulkanMemoryBackend::FreeMemory(VkDeviceMemory memory_ic) {
+    vkFreeMemory(this->m_device, memory_ic, nullptr);
+}
+
+VkResult VulkanMemoryBackend::MapMemory(VkDeviceMemory memory_ic, void*& pData_out) {
+    return vkMapMemory(this->m_device, memory_ic, 0u, VK_WHOLE_SIZE, 0u, &pData_out);
+}
+
+void VulkanMemoryBackend::UnmapMemory(VkDeviceMemory memory_ic) {
+    vkUnmapMemory(this->m_device, memory_ic);
+}
+
+bool VulkanMemoryBackend::QueryBudget(VkDeviceSize* pBudget_out, VkDeviceSize* pUsage_out) {
+    if (this->m_bMemoryBudget == false)
+        return false;
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT stBudget = {};
+    stBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    VkPhysicalDeviceMemoryProperties2 stProps = {};
+    stProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    stProps.pNext = &stBudget;
+    vkGetPhysicalDeviceMemoryProperties2(this->m_physicalDevice, &stProps);
+    for (uint32_t lHeap = 0u; lHeap < stProps.memoryProperties.memoryHeapCount; ++lHeap) {
+        pBudget_out[lHeap] = stBudget.heapBudget[lHeap];
+        pUsage_out[lHeap] = stBudget.heapUsage[lHeap];
+    }
+    return true;
+}
+
+namespace {
+
+std::atomic<DeviceMemoryAllocator*> g_pAllocator{nullptr};
+/* Largest nonCoherentAtomSize the spec allows: a safe rounding until SetAllocator provides the device's. */
+VkDeviceSize g_uNonCoherentAtomSize = 256u;
+
+/* No allocator installed: one vkAllocateMemory per resource, mapped whole when host-visible. */
+VkResult AllocateDirect(VkDevice device, VkPhysicalDevice physicalDevice, const MemoryRequest& stRequest_ic,
+                        MemoryAllocation& stAlloc_out) {
+    stAlloc_out = {};
+    const uint32_t lMemoryType = VulkanUtils::FindMemoryType(physicalDevice, stRequest_ic.requirements.memoryTypeBits,
+                                                             stRequest_ic.properties);
+    VkMemoryAllocateInfo stAllocInfo = {
+        .sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext           = nullptr,
+        .allocationSize  = stRequest_ic.requirements.size,
+        .memoryTypeIndex = lMemoryType,
+    };
+    VkResult r = vkAllocateMemory(device, &stAllocInfo, nullptr, &stAlloc_out.memory);
+    if (r != VK_SUCCESS)
+        return r;
+    if ((stRequest_ic.properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0u) {
+        r = vkMapMemory(device, stAlloc_out.memory, 0u, VK_WHOLE_SIZE, 0u, &stAlloc_out.pMapped);
+        if (r != VK_SUCCESS) {
+            vkFreeMemory(device, stAlloc_out.memory, nullptr);
+            stAlloc_out = {};
+            return r;
+        }
+    }
+    stAlloc_out.uSize = stRequest_ic.requirements.size;
+    stAlloc_out.uMemorySize = stRequest_ic.requirements.size;
+    stAlloc_out.lMemoryType = lMemoryType;
+    stAlloc_out.eCategory = stRequest_ic.eCategory;
+    return VK_SUCCESS;
+}
+
+VkResult Allocate(VkDevice device, VkPhysicalDevice physicalDevice, const MemoryRequest& stRequest_ic,
+                  MemoryAllocation& stAlloc_out) {
+    DeviceMemoryAllocator* pAllocator = g_pAllocator.load(std::memory_order_acquire);
+    if (pAllocator == nullptr)
+        return AllocateDirect(device, physicalDevice, stRequest_ic, stAlloc_out);
+    return pAllocator->Allocate(stRequest_ic, stAlloc_out) ? VK_SUCCESS : VK_ERROR_OUT_OF_DEVICE_MEMORY;
+}
+
+/* Allocation-relative range to a VkMappedMemoryRange: offset rounded down and end rounded up to the atom size,
+   clamped to the memory object (the end of the memory is always a valid range end). */
+VkMappedMemoryRange MakeRange(const MemoryAllocation& stAlloc_ic, VkDeviceSize uOffset_ic, VkDeviceSize uSize_ic) {
+    const VkDeviceSize uAtom = g_uNonCoherentAtomSize;
+    const VkDeviceSize uSize = (uSize_ic == VK_WHOLE_SIZE) ? (stAlloc_ic.uSize - std::min(uOffset_ic, stAlloc_ic.uSize)) : uSize_ic;
+    const VkDeviceSize uBegin = ((stAlloc_ic.uOffset + uOffset_ic) / uAtom) * uAtom;
+    const VkDeviceSize uEnd = ((stAlloc_ic.uOffset + uOffset_ic + uSize + uAtom - 1u) / uAtom) * uAtom;
+    VkMappedMemoryRange stRange = {
+        .sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+        .pNext  = nullptr,
+        .memory = stAlloc_ic.memory,
+        .offset = uBegin,
+        .size   = (uEnd >= stAlloc_ic.uMemorySize) ? VK_WHOLE_SIZE : (uEnd - uBegin),
+    };
+    return stRange;
+}
+
+} // namespace
+
+namespace VulkanMemory {
+
+void SetAllocator(DeviceMemoryAllocator* pAllocator_ic, VkDeviceSize uNonCoherentAtomSize_ic) {
+    g_uNonCoherentAtomSize = std::max<VkDeviceSize>(uNonCoherentAtomSize_ic, 1u);
+    g_pAllocator.store(pAllocator_ic, std::memory_order_release);
+}
+
+DeviceMemoryAllocator* GetAllocator() {
+    return g_pAllocator.load(std::memory_order_acquire);
+}
+
+VkResult AllocateForBuffer(VkDevice device, VkPhysicalDevice physicalDevice, VkBuffer buffer_ic,
+                           VkMemoryPropertyFlags properties_ic, MemoryCategory eCategory_ic, MemoryAllocation& stAlloc_out) {
+    MemoryRequest stRequest;
+    vkGetBufferMemoryRequirements(device, buffer_ic, &stRequest.requirements);
+    stRequest.properties = properties_ic;
+    stRequest.eCategory = eCategory_ic;
+    stRequest.dedicatedBuffer = buffer_ic;
+    VkResult r = Allocate(device, physicalDevice, stRequest, stAlloc_out);
+    if (r != VK_SUCCESS)
+        return r;
+    r = vkBindBufferMemory(device, buffer_ic, stAlloc_out.memory, stAlloc_out.uOffset);
+    if (r != VK_SUCCESS)
+        Free(device, stAlloc_out);
+    return r;
+}
+
+VkResult AllocateForImage(VkDevice device, VkPhysicalDevice physicalDevice, VkImage image_ic,
+                          VkMemoryPropertyFlags properties_ic, MemoryCategory eCategory_ic, bool bDedicated_ic,
+                          MemoryAllocation& stAlloc_out) {
+    MemoryRequest stRequest;
+    vkGetImageMemoryRequirements(device, image_ic, &stRequest.requirements);
+    stRequest.properties = properties_ic;
+    stRequest.eCategory = eCategory_ic;
+    stRequest.bOptimalImage = true;
+    stRequest.bDedicated = bDedicated_ic;
+    stRequest.dedicatedImage = image_ic;
+    VkResult r = Allocate(device, physicalDevice, stRequest, stAlloc_out);
+    if (r != VK_SUCCESS)
+        return r;
+    r = vkBindImageMemory(device, image_ic, stAlloc_out.memory, stAlloc_out.uOffset);
+    if (r != VK_SUCCESS)
+        Free(device, stAlloc_out);
+    return r;
+}
+
+void Free(VkDevice device, MemoryAllocation& stAlloc_io) {
+    if (stAlloc_io.IsValid() == false)
+        return;
+    if (stAlloc_io.pAllocator != nullptr) {
+        stAlloc_io.pAllocator->Free(stAlloc_io);
+        return;
+    }
+    if (stAlloc_io.pMapped != nullptr)
+        vkUnmapMemory(device, stAlloc_io.memory);
+    vkFreeMemory(device, stAlloc_io.memory, nullptr);
+    stAlloc_io = {};
+}
+
+VkResult Flush(VkDevice device, const MemoryAllocation& stAlloc_ic, VkDeviceSize uOffset_ic, VkDeviceSize uSize_ic) {
+    if (stAlloc_ic.IsValid() == false)
+        return VK_SUCCESS;
+    const VkMappedMemoryRange stRange = MakeRange(stAlloc_ic, uOffset_ic, uSize_ic);
+    return vkFlushMappedMemoryRanges(device, 1u, &stRange);
+}
+
+VkResult Invalidate(VkDevice device, const MemoryAllocation& stAlloc_ic, VkDeviceSize uOffset_ic, VkDeviceSize uSize_ic) {
+    if (stAlloc_ic.IsValid() == false)
+        return VK_SUCCESS;
+    const VkMappedMemoryRange stRange = MakeRange(stAlloc_ic, uOffset_ic, uSize_ic);
+    return vkInvalidateMappedMemoryRanges(device, 1u, &stRange);
+}
+
+} // namespace VulkanMemory
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "device_memory_allocator.h"
+#include <vulkan/vulkan.h>
+
+/* DeviceMemoryBackend on a VkDevice. Reports heap budgets when VK_EXT_memory_budget is enabled. */
+class VulkanMemoryBackend : public DeviceMemoryBackend {
+public:
+    void Create(VkDevice device_ic, VkPhysicalDevice physicalDevice_ic, bool bMemoryBudget_ic);
+
+    VkResult AllocateMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic, VkImage dedicatedImage_ic,
+                            VkBuffer dedicatedBuffer_ic, VkDeviceMemory& memory_out) override;
+    void FreeMemory(VkDeviceMemory memory_ic) override;
+    VkResult MapMemory(VkDeviceMemory memory_ic, void*& pData_out) override;
+    void UnmapMemory(VkDeviceMemory memory_ic) override;
+    bool QueryBudget(VkDeviceSize* pBudget_out, VkDeviceSize* pUsage_out) override;
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+    bool m_bMemoryBudget = false;
+};
+
+/*
+ * Resource memory for the engine. VulkanApp installs its DeviceMemoryAllocator after device creation and removes
+ * it before destroying the device; with none installed (tools, early startup) each resource gets its own
+ * vkAllocateMemory as before. Host-visible allocations come back mapped (MemoryAllocation::pMapped): memory shared
+ * by several resources must not be mapped again with vkMapMemory.
+ */
+namespace VulkanMemory {
+
+    /** uNonCoherentAtomSize_ic: VkPhysicalDeviceLimits::nonCoherentAtomSize (Flush / Invalidate range rounding). */
+    void SetAllocator(DeviceMemoryAllocator* pAllocator_ic, VkDeviceSize uNonCoherentAtomSize_ic);
+    DeviceMemoryAllocator* GetAllocator();
+
+    /** Allocate memory for buffer_ic and bind it. */
+    VkResult AllocateForBuffer(VkDevice device, VkPhysicalDevice physicalDevice, VkBuffer buffer_ic,
+                               VkMemoryPropertyFlags properties_ic, MemoryCategory eCategory_ic, MemoryAllocation& stAlloc_out);
+    /** Allocate memory for an optimal-tiling image_ic and bind it. bDedicated_ic: own VkDeviceMemory (render targets). */
+    VkResult AllocateForImage(VkDevice device, VkPhysicalDevice physicalDevice, VkImage image_ic,
+                              VkMemoryPropertyFlags properties_ic, MemoryCategory eCategory_ic, bool bDedicated_ic,
+                              MemoryAllocation& stAlloc_out);
+    /** Release and reset stAlloc_io (destroy the resource bound to it first, or in the same frame-safe point). */
+    void Free(VkDevice device, MemoryAllocation& stAlloc_io);
+
+    /** Flush / invalidate [uOffset_ic, uOffset_ic + uSize_ic) of the allocation (VK_WHOLE_SIZE: to its end). */
+    VkResult Flush(VkDevice device, const MemoryAllocation& stAlloc_ic, VkDeviceSize uOffset_ic = 0u,
+                   VkDeviceSize uSize_ic = VK_WHOLE_SIZE);
+    VkResult Invalidate(VkDevice device, const MemoryAllocation& stAlloc_ic, VkDeviceSize uOffset_ic = 0u,
+                        VkDeviceSize uSize_ic = VK_WHOLE_SIZE);
+
+} // namespace VulkanMemory
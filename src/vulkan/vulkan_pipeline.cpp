@@ -7,7 +7,9 @@ void VulkanPipeline::Create(VkDevice pDevice_ic, VkRenderPass renderPass_ic,
                             const std::string& sVertPath_ic, const std::string& sFragPath_ic,
                             const GraphicsPipelineParams& stPipelineParams_ic,
                             const PipelineLayoutDescriptor& stLayoutDescriptor_ic,
-                            bool bRenderPassHasDepth_ic) {
+                            bool bRenderPassHasDepth_ic,
+                            VkPipelineCache pipelineCache_ic,
+                            const ExtendedDynamicState& stDynamic_ic) {
     VulkanUtils::LogTrace("VulkanPipeline::Create");
     if (pDevice_ic == VK_NULL_HANDLE) {
         VulkanUtils::LogErr("VulkanPipeline::Create: invalid device");
@@ -109,12 +111,23 @@ void VulkanPipeline::Create(VkDevice pDevice_ic, VkRenderPass renderPass_ic,
         .pScissors     = nullptr,
     };
 
-    VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    /* Extended dynamic state: cull / front face / depth (and polygon mode) come from the draw, not the pipeline. */
+    VkDynamicState dynamicStates[9] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    uint32_t lDynamicStateCount = static_cast<uint32_t>(2);
+    if (stDynamic_ic.bEnabled == true) {
+        dynamicStates[lDynamicStateCount++] = VK_DYNAMIC_STATE_CULL_MODE;
+        dynamicStates[lDynamicStateCount++] = VK_DYNAMIC_STATE_FRONT_FACE;
+        dynamicStates[lDynamicStateCount++] = VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE;
+        dynamicStates[lDynamicStateCount++] = VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE;
+        dynamicStates[lDynamicStateCount++] = VK_DYNAMIC_STATE_DEPTH_COMPARE_OP;
+    }
+    if (stDynamic_ic.bPolygonMode == true)
+        dynamicStates[lDynamicStateCount++] = VK_DYNAMIC_STATE_POLYGON_MODE_EXT;
     VkPipelineDynamicStateCreateInfo stDynamicState = {
         .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
         .pNext             = nullptr,
         .flags             = static_cast<VkPipelineDynamicStateCreateFlags>(0),
-        .dynamicStateCount = static_cast<uint32_t>(2),
+        .dynamicStateCount = lDynamicStateCount,
         .pDynamicStates    = dynamicStates,
     };
 
@@ -221,7 +234,7 @@ void VulkanPipeline::Create(VkDevice pDevice_ic, VkRenderPass renderPass_ic,
         .basePipelineHandle  = VK_NULL_HANDLE,
         .basePipelineIndex   = static_cast<int32_t>(-1),
     };
-    r = vkCreateGraphicsPipelines(pDevice_ic, VK_NULL_HANDLE, static_cast<uint32_t>(1), &stPipelineInfo, nullptr, &this->m_pipeline);
+    r = vkCreateGraphicsPipelines(pDevice_ic, pipelineCache_ic, static_cast<uint32_t>(1), &stPipelineInfo, nullptr, &this->m_pipeline);
     if (r != VK_SUCCESS) {
         vkDestroyPipelineLayout(pDevice_ic, this->m_pipelineLayout, nullptr);
         this->m_pipelineLayout = VK_NULL_HANDLE;
@@ -249,3 +262,22 @@ void VulkanPipeline::Destroy() {
 VulkanPipeline::~VulkanPipeline() {
     this->Destroy();
 }
+
+void CmdSetRasterDynamicState(VkCommandBuffer cmd, const ExtendedDynamicState& stDynamic_ic,
+                              const RasterDynamicState& stState_ic, const RasterDynamicState* pPrevious_ic) {
+    if (stDynamic_ic.bEnabled == false)
+        return;
+    const bool bAll = (pPrevious_ic == nullptr);
+    if ((bAll == true) || (pPrevious_ic->cullMode != stState_ic.cullMode))
+        stDynamic_ic.pfnCmdSetCullMode(cmd, stState_ic.cullMode);
+    if ((bAll == true) || (pPrevious_ic->frontFace != stState_ic.frontFace))
+        stDynamic_ic.pfnCmdSetFrontFace(cmd, stState_ic.frontFace);
+    if ((bAll == true) || (pPrevious_ic->depthTestEnable != stState_ic.depthTestEnable))
+        stDynamic_ic.pfnCmdSetDepthTestEnable(cmd, stState_ic.depthTestEnable);
+    if ((bAll == true) || (pPrevious_ic->depthWriteEnable != stState_ic.depthWriteEnable))
+        stDynamic_ic.pfnCmdSetDepthWriteEnable(cmd, stState_ic.depthWriteEnable);
+    if ((bAll == true) || (pPrevious_ic->depthCompareOp != stState_ic.depthCompareOp))
+        stDynamic_ic.pfnCmdSetDepthCompareOp(cmd, stState_ic.depthCompareOp);
+    if ((stDynamic_ic.bPolygonMode == true) && ((bAll == true) || (pPrevious_ic->polygonMode != stState_ic.polygonMode)))
+        stDynamic_ic.pfnCmdSetPolygonMode(cmd, stState_ic.polygonMode);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "vulkan_shader_manager.h"
+#include "vulkan_types.h"
 #include <vulkan/vulkan.h>
 #include <memory>
 #include <string>
@@ -62,9 +63,45 @@ inline bool operator==(const GraphicsPipelineParams& a, const GraphicsPipelinePa
         && a.alphaBlendOp == b.alphaBlendOp;
 }
 
+/** The part of stParams_ic a draw sets itself when the pipeline was built with extended dynamic state. */
+inline RasterDynamicState GetRasterDynamicState(const GraphicsPipelineParams& stParams_ic) {
+    RasterDynamicState stState;
+    stState.cullMode         = stParams_ic.cullMode;
+    stState.frontFace        = stParams_ic.frontFace;
+    stState.depthTestEnable  = stParams_ic.depthTestEnable;
+    stState.depthWriteEnable = stParams_ic.depthWriteEnable;
+    stState.depthCompareOp   = stParams_ic.depthCompareOp;
+    stState.polygonMode      = stParams_ic.polygonMode;
+    return stState;
+}
+
+/** stParams_ic with the states stDynamic_ic makes dynamic reset to defaults, so params that differ only there
+ *  compare equal (one pipeline for all of them). */
+inline GraphicsPipelineParams StripDynamicState(const GraphicsPipelineParams& stParams_ic, const ExtendedDynamicState& stDynamic_ic) {
+    GraphicsPipelineParams stParams = stParams_ic;
+    const RasterDynamicState stDefault = {};
+    if (stDynamic_ic.bEnabled == true) {
+        stParams.cullMode         = stDefault.cullMode;
+        stParams.frontFace        = stDefault.frontFace;
+        stParams.depthTestEnable  = stDefault.depthTestEnable;
+        stParams.depthWriteEnable = stDefault.depthWriteEnable;
+        stParams.depthCompareOp   = stDefault.depthCompareOp;
+    }
+    if (stDynamic_ic.bPolygonMode == true)
+        stParams.polygonMode = stDefault.polygonMode;
+    return stParams;
+}
+
+/** Record the states of stState_ic that stDynamic_ic makes dynamic. pPrevious_ic: state already set in this
+ *  command buffer (only changed values are recorded); nullptr = record all. */
+void CmdSetRasterDynamicState(VkCommandBuffer cmd, const ExtendedDynamicState& stDynamic_ic,
+                              const RasterDynamicState& stState_ic, const RasterDynamicState* pPrevious_ic);
+
 /*
  * Graphics pipeline: vert + frag stages, fixed-function state. Holds shared_ptr to shader modules
  * so shaders stay alive while the pipeline exists; when pipeline is destroyed the shared_ptrs are dropped.
+ * Create may run on a worker thread (PipelineManager builds pipelines off the main thread).
+ * With stDynamic_ic enabled, the states it covers are dynamic: every draw must set them (CmdSetRasterDynamicState).
  */
 class VulkanPipeline {
 public:
@@ -76,7 +113,9 @@ public:
                 const std::string& sVertPath_ic, const std::string& sFragPath_ic,
                 const GraphicsPipelineParams& stPipelineParams_ic,
                 const PipelineLayoutDescriptor& stLayoutDescriptor_ic,
-                bool bRenderPassHasDepth_ic);
+                bool bRenderPassHasDepth_ic,
+                VkPipelineCache pipelineCache_ic = VK_NULL_HANDLE,
+                const ExtendedDynamicState& stDynamic_ic = {});
     void Destroy();
 
     VkPipeline Get() const { return this->m_pipeline; }
@@ -0,0 +1,172 @@
+/*
+ * VulkanPipelineCache — VkPipelineCache persisted across runs, validated against the device and driver.
+ */
+#include "vulkan_pipeline_cache.h"
+#include "vulkan_utils.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+uint64_t HashCacheData(const uint8_t* pData_ic, size_t zSize_ic) {
+    uint64_t uHash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < zSize_ic; ++i) {
+        uHash ^= pData_ic[i];
+        uHash *= 0x100000001b3ull;
+    }
+    return uHash;
+}
+
+/* The driver's own header (VkPipelineCacheHeaderVersionOne) must name this device too; some drivers do not
+   reject foreign data gracefully. */
+bool DriverHeaderMatches(const std::vector<uint8_t>& vecData_ic, const VkPhysicalDeviceProperties& stProps_ic) {
+    if (vecData_ic.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+        return false;
+    VkPipelineCacheHeaderVersionOne stHeader = {};
+    std::memcpy(&stHeader, vecData_ic.data(), sizeof(stHeader));
+    return (stHeader.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)) &&
+           (stHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) &&
+           (stHeader.vendorID == stProps_ic.vendorID) && (stHeader.deviceID == stProps_ic.deviceID) &&
+           (std::memcmp(stHeader.pipelineCacheUUID, stProps_ic.pipelineCacheUUID, VK_UUID_SIZE) == 0);
+}
+
+} // namespace
+
+void VulkanPipelineCache::Create(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& sPath_ic) {
+    this->Destroy();
+    this->m_device = device;
+    this->m_sPath = sPath_ic;
+    vkGetPhysicalDeviceProperties(physicalDevice, &this->m_deviceProperties);
+
+    /* Read and validate the file; any mismatch falls back to an empty cache. */
+    std::vector<uint8_t> vecData;
+    const char* pReject = nullptr;
+    if (sPath_ic.empty() == false) {
+        std::ifstream stmIn(sPath_ic, std::ios::binary);
+        FileHeader stHeader = {};
+        if (stmIn.is_open() == false) {
+            pReject = "no cache file";
+        } else if (stmIn.read(reinterpret_cast<char*>(&stHeader), sizeof(stHeader)).good() == false) {
+            pReject = "truncated header";
+        } else if ((stHeader.magic != kFileMagic) || (stHeader.version != kFileVersion)) {
+            pReject = "unknown format";
+        } else if ((stHeader.vendorID != this->m_deviceProperties.vendorID) ||
+                   (stHeader.deviceID != this->m_deviceProperties.deviceID) ||
+                   (stHeader.driverVersion != this->m_deviceProperties.driverVersion) ||
+                   (std::memcmp(stHeader.pipelineCacheUUID, this->m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)) {
+            pReject = "device or driver changed";
+        } else if (stHeader.dataSize > kMaxDataSize) {
+            pReject = "corrupt header";
+        } else {
+            vecData.resize(static_cast<size_t>(stHeader.dataSize));
+            if ((stmIn.read(reinterpret_cast<char*>(vecData.data()), static_cast<std::streamsize>(vecData.size())).good() == false) ||
+                (HashCacheData(vecData.data(), vecData.size()) != stHeader.dataHash)) {
+                pReject = "corrupt data";
+            } else if (DriverHeaderMatches(vecData, this->m_deviceProperties) == false) {
+                pReject = "driver header mismatch";
+            }
+        }
+        if (pReject != nullptr)
+            vecData.clear();
+    }
+
+    VkPipelineCacheCreateInfo stCreateInfo = {
+        .sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext           = nullptr,
+        .flags           = static_cast<VkPipelineCacheCreateFlags>(0),
+        .initialDataSize = vecData.size(),
+        .pInitialData    = (vecData.empty() == true) ? nullptr : vecData.data(),
+    };
+    VkResult r = vkCreatePipelineCache(device, &stCreateInfo, nullptr, &this->m_cache);
+    if ((r != VK_SUCCESS) && (vecData.empty() == false)) {
+        /* Data the driver refuses after all: start empty. */
+        pReject = "rejected by driver";
+        vecData.clear();
+        stCreateInfo.initialDataSize = 0u;
+        stCreateInfo.pInitialData = nullptr;
+        r = vkCreatePipelineCache(device, &stCreateInfo, nullptr, &this->m_cache);
+    }
+    if (r != VK_SUCCESS) {
+        this->m_cache = VK_NULL_HANDLE;
+        VulkanUtils::LogErr("vkCreatePipelineCache failed: {}", static_cast<int>(r));
+        throw std::runtime_error("VulkanPipelineCache::Create: vkCreatePipelineCache failed");
+    }
+    this->m_zLoadedBytes = vecData.size();
+
+    if (sPath_ic.empty() == true)
+        VulkanUtils::LogInfo("Pipeline cache: in memory only");
+    else if (this->m_zLoadedBytes > 0u)
+        VulkanUtils::LogInfo("Pipeline cache: loaded {} KB from {}", this->m_zLoadedBytes / 1024u, sPath_ic);
+    else
+        VulkanUtils::LogInfo("Pipeline cache: cold start ({}: {})", pReject, sPath_ic);
+}
+
+bool VulkanPipelineCache::Save() {
+    if ((this->m_cache == VK_NULL_HANDLE) || (this->m_sPath.empty() == true))
+        return false;
+    size_t zSize = 0u;
+    VkResult r = vkGetPipelineCacheData(this->m_device, this->m_cache, &zSize, nullptr);
+    if ((r != VK_SUCCESS) || (zSize == 0u))
+        return false;
+    std::vector<uint8_t> vecData(zSize);
+    r = vkGetPipelineCacheData(this->m_device, this->m_cache, &zSize, vecData.data());
+    if ((r != VK_SUCCESS) && (r != VK_INCOMPLETE))
+        return false;
+    vecData.resize(zSize);
+
+    FileHeader stHeader = {};
+    stHeader.magic         = kFileMagic;
+    stHeader.version       = kFileVersion;
+    stHeader.vendorID      = this->m_deviceProperties.vendorID;
+    stHeader.deviceID      = this->m_deviceProperties.deviceID;
+    stHeader.driverVersion = this->m_deviceProperties.driverVersion;
+    std::memcpy(stHeader.pipelineCacheUUID, this->m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+    stHeader.dataSize      = vecData.size();
+    stHeader.dataHash      = HashCacheData(vecData.data(), vecData.size());
+
+    std::error_code ec;
+    const std::filesystem::path finalPath(this->m_sPath);
+    if (finalPath.has_parent_path() == true)
+        std::filesystem::create_directories(finalPath.parent_path(), ec);
+    std::filesystem::path tmpPath = finalPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream stmOut(tmpPath, std::ios::binary | std::ios::trunc);
+        if (stmOut.is_open() == false) {
+            VulkanUtils::LogWarn("Pipeline cache: cannot write {}", tmpPath.string());
+            return false;
+        }
+        stmOut.write(reinterpret_cast<const char*>(&stHeader), sizeof(stHeader));
+        stmOut.write(reinterpret_cast<const char*>(vecData.data()), static_cast<std::streamsize>(vecData.size()));
+        if (stmOut.good() == false) {
+            stmOut.close();
+            std::filesystem::remove(tmpPath, ec);
+            VulkanUtils::LogWarn("Pipeline cache: write failed: {}", tmpPath.string());
+            return false;
+        }
+    }
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        VulkanUtils::LogWarn("Pipeline cache: cannot replace {}", this->m_sPath);
+        return false;
+    }
+    VulkanUtils::LogInfo("Pipeline cache: saved {} KB to {}", vecData.size() / 1024u, this->m_sPath);
+    return true;
+}
+
+void VulkanPipelineCache::Destroy() {
+    if (this->m_cache != VK_NULL_HANDLE) {
+        vkDestroyPipelineCache(this->m_device, this->m_cache, nullptr);
+        this->m_cache = VK_NULL_HANDLE;
+    }
+    this->m_device = VK_NULL_HANDLE;
+    this->m_zLoadedBytes = 0u;
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+    this->Destroy();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+ * Persistent VkPipelineCache shared by every pipeline the engine creates. Create() seeds the cache from the file when
+ * it was written by the same device and driver (vendor / device id, driver version, pipelineCacheUUID) and its data
+ * is intact; anything else starts an empty cache. Save() writes the driver's cache data back (temp file + rename).
+ * The driver synchronizes access to the cache, so worker threads may build pipelines with it concurrently.
+ */
+class VulkanPipelineCache {
+public:
+    VulkanPipelineCache() = default;
+    ~VulkanPipelineCache();
+
+    VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+    VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+    /** sPath_ic empty: in-memory cache only (nothing loaded or saved). Throws if vkCreatePipelineCache fails. */
+    void Create(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& sPath_ic);
+    /** Write the cache file. Call with no pipeline creation in flight (shutdown). False on I/O failure. */
+    bool Save();
+    void Destroy();
+
+    VkPipelineCache Get() const { return this->m_cache; }
+    bool IsValid() const { return this->m_cache != VK_NULL_HANDLE; }
+    /** True when Create seeded the cache from disk (warm start). */
+    bool WasLoaded() const { return this->m_zLoadedBytes > 0u; }
+    size_t GetLoadedBytes() const { return this->m_zLoadedBytes; }
+
+private:
+    /* File prefix ahead of the driver's cache data. */
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint32_t driverVersion;
+        uint8_t  pipelineCacheUUID[VK_UUID_SIZE];
+        uint64_t dataSize;
+        uint64_t dataHash;
+    };
+    static constexpr uint32_t kFileMagic = 0x43504B56u;  // "VKPC"
+    static constexpr uint32_t kFileVersion = 1u;
+    static constexpr uint64_t kMaxDataSize = 256ull * 1024ull * 1024ull;  // Larger sizes mean a corrupt header
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkPipelineCache m_cache = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties m_deviceProperties = {};
+    std::string m_sPath;
+    size_t m_zLoadedBytes = 0u;
+};
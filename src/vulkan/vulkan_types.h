@@ -15,3 +15,36 @@ struct QueueFamilyIndices {
     uint32_t graphicsFamily = QUEUE_FAMILY_IGNORED;
     uint32_t presentFamily  = QUEUE_FAMILY_IGNORED;
 };
+
+/*
+ * Extended dynamic state enabled on the device (VulkanDevice::Create). bEnabled: cull mode, front face and depth
+ * test / write / compare op are set per draw (core Vulkan 1.3 or VK_EXT_extended_dynamic_state). bPolygonMode:
+ * polygon mode too (VK_EXT_extended_dynamic_state3). Pipelines built with it leave those states out, so materials
+ * that differ only there share one VkPipeline. Entry points are null when the matching flag is false.
+ */
+struct ExtendedDynamicState {
+    bool bEnabled     = false;
+    bool bPolygonMode = false;
+    PFN_vkCmdSetCullMode         pfnCmdSetCullMode         = nullptr;
+    PFN_vkCmdSetFrontFace        pfnCmdSetFrontFace        = nullptr;
+    PFN_vkCmdSetDepthTestEnable  pfnCmdSetDepthTestEnable  = nullptr;
+    PFN_vkCmdSetDepthWriteEnable pfnCmdSetDepthWriteEnable = nullptr;
+    PFN_vkCmdSetDepthCompareOp   pfnCmdSetDepthCompareOp   = nullptr;
+    PFN_vkCmdSetPolygonModeEXT   pfnCmdSetPolygonMode      = nullptr;
+};
+
+/* Rasterization / depth state of one draw, recorded as dynamic state when ExtendedDynamicState is enabled. */
+struct RasterDynamicState {
+    VkCullModeFlags cullMode         = VK_CULL_MODE_NONE;
+    VkFrontFace     frontFace        = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    VkBool32        depthTestEnable  = VK_TRUE;
+    VkBool32        depthWriteEnable = VK_TRUE;
+    VkCompareOp     depthCompareOp   = VK_COMPARE_OP_LESS_OR_EQUAL;
+    VkPolygonMode   polygonMode      = VK_POLYGON_MODE_FILL;
+};
+
+inline bool operator==(const RasterDynamicState& a, const RasterDynamicState& b) {
+    return a.cullMode == b.cullMode && a.frontFace == b.frontFace && a.depthTestEnable == b.depthTestEnable
+        && a.depthWriteEnable == b.depthWriteEnable && a.depthCompareOp == b.depthCompareOp
+        && a.polygonMode == b.polygonMode;
+}
@@ -201,8 +201,8 @@ uint32_t FindMemoryType(VkPhysicalDevice physicalDevice, uint32_t lTypeFilter, V
 }
 
 VkResult CreateBuffer(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize size,
-                      VkBufferUsageFlags usage, VkMemoryPropertyFlags memProps,
-                      VkBuffer* outBuffer, VkDeviceMemory* outMemory) {
+                      VkBufferUsageFlags usage, VkMemoryPropertyFlags memProps, MemoryCategory eCategory,
+                      VkBuffer* outBuffer, MemoryAllocation* outMemory) {
     VkBufferCreateInfo bufInfo = {
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
@@ -216,23 +216,12 @@ VkResult CreateBuffer(VkDevice device, VkPhysicalDevice physicalDevice, VkDevice
     VkResult r = vkCreateBuffer(device, &bufInfo, nullptr, outBuffer);
     if (r != VK_SUCCESS) return r;
     
-    VkMemoryRequirements memReqs;
-    vkGetBufferMemoryRequirements(device, *outBuffer, &memReqs);
-    
-    VkMemoryAllocateInfo allocInfo = {
-        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        .pNext = nullptr,
-        .allocationSize = memReqs.size,
-        .memoryTypeIndex = FindMemoryType(physicalDevice, memReqs.memoryTypeBits, memProps),
-    };
-    r = vkAllocateMemory(device, &allocInfo, nullptr, outMemory);
+    r = VulkanMemory::AllocateForBuffer(device, physicalDevice, *outBuffer, memProps, eCategory, *outMemory);
     if (r != VK_SUCCESS) {
         vkDestroyBuffer(device, *outBuffer, nullptr);
         *outBuffer = VK_NULL_HANDLE;
         return r;
     }
-    
-    vkBindBufferMemory(device, *outBuffer, *outMemory, 0);
     return VK_SUCCESS;
 }
 
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.h>
+#include "vulkan_memory.h"
 
 namespace VulkanUtils {
 
@@ -156,19 +157,20 @@ namespace VulkanUtils {
     uint32_t FindMemoryType(VkPhysicalDevice physicalDevice, uint32_t lTypeFilter, VkMemoryPropertyFlags properties);
     
     /**
-     * Create a VkBuffer with allocated and bound memory.
+     * Create a VkBuffer with allocated and bound memory (VulkanMemory::AllocateForBuffer).
      * @param device Logical device
      * @param physicalDevice Physical device (for memory type selection)
      * @param size Buffer size in bytes
      * @param usage VkBufferUsageFlags (e.g., VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
      * @param memProps VkMemoryPropertyFlags (e.g., VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+     * @param eCategory Memory statistics category
      * @param outBuffer Output buffer handle
-     * @param outMemory Output memory handle
+     * @param outMemory Output allocation (host-visible: outMemory->pMapped is the CPU pointer); release with VulkanMemory::Free
      * @return VK_SUCCESS on success, error code otherwise
      */
     VkResult CreateBuffer(VkDevice device, VkPhysicalDevice physicalDevice, VkDeviceSize size,
-                          VkBufferUsageFlags usage, VkMemoryPropertyFlags memProps,
-                          VkBuffer* outBuffer, VkDeviceMemory* outMemory);
+                          VkBufferUsageFlags usage, VkMemoryPropertyFlags memProps, MemoryCategory eCategory,
+                          VkBuffer* outBuffer, MemoryAllocation* outMemory);
     
     /**
      * Begin a single-time-submit command buffer.
@@ -0,0 +1,200 @@
+/*
+ * BC codec round trip: encode known RGBA8 images with every BCFormat, decode them, and check the error of the
+ * channels each format stores against a per-format bound. Also checks sizes, determinism and that the JobQueue
+ * path writes the same bytes as the calling thread.
+ */
+#include "test_common.h"
+#include "bc_codec.h"
+#include "thread/job_queue.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+struct TestImage {
+    const char* pName = nullptr;
+    uint32_t lWidth = 0u;
+    uint32_t lHeight = 0u;
+    std::vector<uint8_t> vecRgba;
+};
+
+/* Smooth ramps in every channel (alpha included); what BC formats are designed for. */
+TestImage MakeGradient(uint32_t lWidth_ic, uint32_t lHeight_ic, const char* pName_ic) {
+    TestImage stImage{ pName_ic, lWidth_ic, lHeight_ic, std::vector<uint8_t>(size_t(lWidth_ic) * lHeight_ic * 4u) };
+    for (uint32_t y = 0u; y < lHeight_ic; ++y) {
+        for (uint32_t x = 0u; x < lWidth_ic; ++x) {
+            uint8_t* pTexel = &stImage.vecRgba[(size_t(y) * lWidth_ic + x) * 4u];
+            pTexel[0] = static_cast<uint8_t>((x * 255u) / std::max(1u, lWidth_ic - 1u));
+            pTexel[1] = static_cast<uint8_t>((y * 255u) / std::max(1u, lHeight_ic - 1u));
+            pTexel[2] = static_cast<uint8_t>(((x + y) * 255u) / std::max(1u, lWidth_ic + lHeight_ic - 2u));
+            pTexel[3] = static_cast<uint8_t>(255u - (x * 128u) / std::max(1u, lWidth_ic - 1u));
+        }
+    }
+    return stImage;
+}
+
+/* Gradient plus +-12 of deterministic noise per channel: closer to a photographic texture. */
+TestImage MakeNoisyGradient(uint32_t lWidth_ic, uint32_t lHeight_ic) {
+    TestImage stImage = MakeGradient(lWidth_ic, lHeight_ic, "noisy gradient");
+    uint32_t uState = 12345u;
+    for (uint8_t& cValue : stImage.vecRgba) {
+        uState = uState * 1664525u + 1013904223u;
+        const int iNoise = static_cast<int>((uState >> 24) % 25u) - 12;
+        cValue = static_cast<uint8_t>(std::clamp(static_cast<int>(cValue) + iNoise, 0, 255));
+    }
+    return stImage;
+}
+
+/* Channels each format stores (the decoder fills the rest with 0 / 255). */
+uint32_t StoredChannelCount(BCFormat eFormat_ic) {
+    switch (eFormat_ic) {
+    case BCFormat::BC1: return 3u;
+    case BCFormat::BC4: return 1u;
+    case BCFormat::BC5: return 2u;
+    case BCFormat::BC3:
+    case BCFormat::BC7:
+    default:            return 4u;
+    }
+}
+
+const char* FormatName(BCFormat eFormat_ic) {
+    switch (eFormat_ic) {
+    case BCFormat::BC1: return "BC1";
+    case BCFormat::BC3: return "BC3";
+    case BCFormat::BC4: return "BC4";
+    case BCFormat::BC5: return "BC5";
+    case BCFormat::BC7: return "BC7";
+    default:            return "?";
+    }
+}
+
+struct ErrorBound {
+    BCFormat eFormat;
+    double dMaxRmse;      // Over the stored channels of the whole image
+    int iMaxAbsError;     // Worst single channel of any texel
+};
+
+/*
+ * About 30% headroom over the worst of the three test images (the noisy gradient). BC7 is only emitted as mode 6,
+ * one RGBA line per block, so it does not beat BC3's separate alpha block on these images.
+ */
+constexpr ErrorBound kBounds[] = {
+    { BCFormat::BC1, 8.0, 28 },
+    { BCFormat::BC3, 7.5, 28 },
+    { BCFormat::BC4, 1.5, 4 },
+    { BCFormat::BC5, 1.5, 4 },
+    { BCFormat::BC7, 7.5, 26 },
+};
+
+void CheckRoundTrip(const TestImage& stImage_ic, const ErrorBound& stBound_ic) {
+    const BCFormat eFormat = stBound_ic.eFormat;
+    std::vector<uint8_t> vecEncoded(GetBCImageSize(eFormat, stImage_ic.lWidth, stImage_ic.lHeight));
+    EncodeBCImage(eFormat, stImage_ic.vecRgba.data(), stImage_ic.lWidth, stImage_ic.lHeight, vecEncoded.data());
+
+    std::vector<uint8_t> vecDecoded(stImage_ic.vecRgba.size());
+    TEST_CHECK(DecodeBCImage(eFormat, vecEncoded.data(), stImage_ic.lWidth, stImage_ic.lHeight, vecDecoded.data()));
+
+    const uint32_t lChannels = StoredChannelCount(eFormat);
+    double dSquaredSum = 0.0;
+    int iMaxAbs = 0;
+    for (size_t i = 0; i < vecDecoded.size(); i += 4u) {
+        for (uint32_t c = 0u; c < lChannels; ++c) {
+            const int iDiff = std::abs(static_cast<int>(vecDecoded[i + c]) - static_cast<int>(stImage_ic.vecRgba[i + c]));
+            dSquaredSum += double(iDiff) * double(iDiff);
+            iMaxAbs = std::max(iMaxAbs, iDiff);
+        }
+    }
+    const double dRmse = std::sqrt(dSquaredSum / (double(vecDecoded.size() / 4u) * lChannels));
+    std::printf("  %-16s %ux%u %s: rmse %.2f, max %d\n", stImage_ic.pName, stImage_ic.lWidth, stImage_ic.lHeight,
+                FormatName(eFormat), dRmse, iMaxAbs);
+    TEST_CHECK_LE(dRmse, stBound_ic.dMaxRmse);
+    TEST_CHECK_LE(iMaxAbs, stBound_ic.iMaxAbsError);
+
+    // Unstored channels decode to the documented constants
+    if (lChannels < 4u) {
+        bool bConstants = true;
+        for (size_t i = 0; i < vecDecoded.size(); i += 4u) {
+            for (uint32_t c = lChannels; c < 4u; ++c)
+                bConstants = bConstants && (vecDecoded[i + c] == ((c == 3u) ? 255u : 0u));
+        }
+        TEST_CHECK(bConstants);
+    }
+
+    // Encoders are deterministic
+    std::vector<uint8_t> vecEncodedAgain(vecEncoded.size());
+    EncodeBCImage(eFormat, stImage_ic.vecRgba.data(), stImage_ic.lWidth, stImage_ic.lHeight, vecEncodedAgain.data());
+    TEST_CHECK(vecEncodedAgain == vecEncoded);
+}
+
+/* A block of one colour: every format reproduces it to within its endpoint precision. */
+void CheckSolidBlocks() {
+    const uint8_t kColours[][4] = { { 0, 0, 0, 255 }, { 255, 255, 255, 255 }, { 200, 100, 50, 128 }, { 17, 230, 99, 0 } };
+    for (const ErrorBound& stBound : kBounds) {
+        const uint32_t lChannels = StoredChannelCount(stBound.eFormat);
+        // BC1 (and BC3's colour block) store 5:6:5 endpoints; the interpolated colours land within 4 of any 8-bit value
+        const bool bRgb565 = (stBound.eFormat == BCFormat::BC1) || (stBound.eFormat == BCFormat::BC3);
+        const int iTolerance = (bRgb565 == true) ? 4 : 1;
+        for (const uint8_t* pColour : kColours) {
+            uint8_t cBlock[16 * 4];
+            for (uint32_t t = 0u; t < 16u; ++t)
+                std::copy(pColour, pColour + 4, cBlock + t * 4u);
+            uint8_t cEncoded[16];
+            uint8_t cDecoded[16 * 4];
+            EncodeBCBlock(stBound.eFormat, cBlock, cEncoded);
+            TEST_CHECK(DecodeBCBlock(stBound.eFormat, cEncoded, cDecoded));
+            int iMaxAbs = 0;
+            for (uint32_t t = 0u; t < 16u; ++t) {
+                for (uint32_t c = 0u; c < lChannels; ++c)
+                    iMaxAbs = std::max(iMaxAbs, std::abs(static_cast<int>(cDecoded[t * 4u + c]) - static_cast<int>(pColour[c])));
+            }
+            TEST_CHECK_LE(iMaxAbs, iTolerance);
+        }
+    }
+}
+
+void CheckSizes() {
+    TEST_CHECK_EQ(GetBCBlockBytes(BCFormat::BC1), 8);
+    TEST_CHECK_EQ(GetBCBlockBytes(BCFormat::BC4), 8);
+    TEST_CHECK_EQ(GetBCBlockBytes(BCFormat::BC3), 16);
+    TEST_CHECK_EQ(GetBCBlockBytes(BCFormat::BC5), 16);
+    TEST_CHECK_EQ(GetBCBlockBytes(BCFormat::BC7), 16);
+    TEST_CHECK_EQ(GetBCImageSize(BCFormat::BC1, 64u, 64u), 16 * 16 * 8);
+    TEST_CHECK_EQ(GetBCImageSize(BCFormat::BC7, 37u, 21u), 10 * 6 * 16);  // Partial edge blocks count as whole blocks
+    TEST_CHECK_EQ(GetBCImageSize(BCFormat::BC4, 1u, 1u), 8);
+}
+
+/* Band-split encode on JobQueue workers must write exactly what the calling thread writes. */
+void CheckJobQueueMatches(const TestImage& stImage_ic) {
+    JobQueue jobQueue;
+    jobQueue.Start();
+    for (const ErrorBound& stBound : kBounds) {
+        const size_t zSize = GetBCImageSize(stBound.eFormat, stImage_ic.lWidth, stImage_ic.lHeight);
+        std::vector<uint8_t> vecSerial(zSize);
+        std::vector<uint8_t> vecParallel(zSize);
+        EncodeBCImage(stBound.eFormat, stImage_ic.vecRgba.data(), stImage_ic.lWidth, stImage_ic.lHeight, vecSerial.data());
+        EncodeBCImage(stBound.eFormat, stImage_ic.vecRgba.data(), stImage_ic.lWidth, stImage_ic.lHeight, vecParallel.data(), &jobQueue);
+        TEST_CHECK(vecParallel == vecSerial);
+    }
+    jobQueue.Stop();
+}
+
+} // namespace
+
+int main() {
+    const TestImage stImages[] = {
+        MakeGradient(64u, 64u, "gradient"),
+        MakeGradient(37u, 21u, "odd gradient"),
+        MakeNoisyGradient(64u, 64u),
+    };
+    for (const TestImage& stImage : stImages) {
+        for (const ErrorBound& stBound : kBounds)
+            CheckRoundTrip(stImage, stBound);
+    }
+    CheckSolidBlocks();
+    CheckSizes();
+    CheckJobQueueMatches(MakeNoisyGradient(512u, 256u));
+    return Test::Finish("test_bc_codec");
+}
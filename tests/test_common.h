@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdio>
+
+/*
+ * Minimal check macros for the engine tests (one executable per file in tests/, registered with CTest).
+ * A failed check prints file:line and the expression, and the test keeps going; Test::Finish turns the failure
+ * count into the process exit code.
+ */
+namespace Test {
+
+inline int g_iFailures = 0;
+
+inline int Finish(const char* pName_ic) {
+    if (g_iFailures == 0)
+        std::printf("%s: all checks passed\n", pName_ic);
+    else
+        std::printf("%s: %d check(s) failed\n", pName_ic, g_iFailures);
+    return (g_iFailures == 0) ? 0 : 1;
+}
+
+} // namespace Test
+
+#define TEST_CHECK(cond)                                                                     \
+    do {                                                                                     \
+        if (static_cast<bool>(cond) == false) {                                              \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            ++Test::g_iFailures;                                                             \
+        }                                                                                    \
+    } while (0)
+
+/* a <= b for numbers; prints both values on failure. */
+#define TEST_CHECK_LE(a, b)                                                                  \
+    do {                                                                                     \
+        const double dTestA = static_cast<double>(a);                                        \
+        const double dTestB = static_cast<double>(b);                                        \
+        if ((dTestA <= dTestB) == false) {                                                   \
+            std::fprintf(stderr, "%s:%d: check failed: %s <= %s (%g > %g)\n", __FILE__, __LINE__, \
+                         #a, #b, dTestA, dTestB);                                            \
+            ++Test::g_iFailures;                                                             \
+        }                                                                                    \
+    } while (0)
+
+/* a == b for integers and enums; prints both values on failure. */
+#define TEST_CHECK_EQ(a, b)                                                                  \
+    do {                                                                                     \
+        const long long llTestA = static_cast<long long>(a);                                 \
+        const long long llTestB = static_cast<long long>(b);                                 \
+        if (llTestA != llTestB) {                                                            \
+            std::fprintf(stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, \
+                         #a, #b, llTestA, llTestB);                                          \
+            ++Test::g_iFailures;                                                             \
+        }                                                                                    \
+    } while (0)
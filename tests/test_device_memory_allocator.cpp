@@ -0,0 +1,437 @@
+/*
+ * DeviceMemoryAllocator (vulkan/device_memory_allocator) on a fake DeviceMemoryBackend: made-up VkDeviceMemory
+ * handles backed by host memory, so the allocator runs without a GPU. Covers memory type selection, pool vs.
+ * dedicated placement, block growth and release, separate pools for optimal-tiling images, alignment, persistent
+ * mapping, the retry with smaller blocks when the device refuses, per-category stats and heap budget accounting.
+ */
+#include "test_common.h"
+#include "device_memory_allocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+constexpr VkDeviceSize kMiB = 1024ull * 1024ull;
+constexpr VkDeviceSize kBlockSize = 64ull * kMiB;
+constexpr uint32_t kDeviceLocalType = 0u;  // Heap 0 (4 GiB): blocks of kBlockSize
+constexpr uint32_t kHostVisibleType = 1u;  // Heap 1 (256 MiB, small): blocks of 256 MiB / 8 = 32 MiB
+
+/* Non-dispatchable handles are pointers on 64-bit targets and uint64_t elsewhere. */
+template<typename Handle>
+Handle MakeHandle(uint64_t uValue_ic) {
+    if constexpr (std::is_pointer_v<Handle>)
+        return reinterpret_cast<Handle>(static_cast<uintptr_t>(uValue_ic));
+    else
+        return static_cast<Handle>(uValue_ic);
+}
+
+class FakeBackend : public DeviceMemoryBackend {
+public:
+    struct Memory {
+        uint32_t lMemoryType = 0u;
+        VkDeviceSize uSize = 0u;
+        VkImage dedicatedImage = VK_NULL_HANDLE;
+        VkBuffer dedicatedBuffer = VK_NULL_HANDLE;
+        std::unique_ptr<uint8_t[]> pBytes;
+        bool bMapped = false;
+    };
+
+    VkResult AllocateMemory(uint32_t lMemoryType_ic, VkDeviceSize uSize_ic, VkImage dedicatedImage_ic,
+                            VkBuffer dedicatedBuffer_ic, VkDeviceMemory& memory_out) override {
+        ++this->lAllocateCalls;
+        if (uSize_ic > this->uLargestAllowed)
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        memory_out = MakeHandle<VkDeviceMemory>(++this->m_uNextHandle);
+        Memory& stMemory = this->mapMemory[memory_out];
+        stMemory.lMemoryType = lMemoryType_ic;
+        stMemory.uSize = uSize_ic;
+        stMemory.dedicatedImage = dedicatedImage_ic;
+        stMemory.dedicatedBuffer = dedicatedBuffer_ic;
+        return VK_SUCCESS;
+    }
+    void FreeMemory(VkDeviceMemory memory_ic) override {
+        const auto it = this->mapMemory.find(memory_ic);
+        TEST_CHECK(it != this->mapMemory.end());
+        if (it == this->mapMemory.end())
+            return;
+        TEST_CHECK(it->second.bMapped == false);  // Unmapped before it is freed
+        this->mapMemory.erase(it);
+    }
+    VkResult MapMemory(VkDeviceMemory memory_ic, void*& pData_out) override {
+        Memory& stMemory = this->mapMemory.at(memory_ic);
+        TEST_CHECK(stMemory.bMapped == false);
+        // Host memory only once mapped: device-local blocks of a few hundred MiB cost nothing here
+        stMemory.pBytes = std::make_unique<uint8_t[]>(static_cast<size_t>(stMemory.uSize));
+        stMemory.bMapped = true;
+        pData_out = stMemory.pBytes.get();
+        return VK_SUCCESS;
+    }
+    void UnmapMemory(VkDeviceMemory memory_ic) override {
+        Memory& stMemory = this->mapMemory.at(memory_ic);
+        TEST_CHECK(stMemory.bMapped == true);
+        stMemory.bMapped = false;
+    }
+    bool QueryBudget(VkDeviceSize* pBudget_out, VkDeviceSize* pUsage_out) override {
+        if (this->bReportBudget == false)
+            return false;
+        for (uint32_t i = 0u; i < VK_MAX_MEMORY_HEAPS; ++i) {
+            pBudget_out[i] = this->auBudget[i];
+            pUsage_out[i] = this->auUsage[i];
+        }
+        return true;
+    }
+
+    /* Bytes of live device memory of lMemoryType_ic. */
+    VkDeviceSize GetLiveBytes(uint32_t lMemoryType_ic) const {
+        VkDeviceSize uBytes = 0u;
+        for (const auto& [memory, stMemory] : this->mapMemory)
+            uBytes += (stMemory.lMemoryType == lMemoryType_ic) ? stMemory.uSize : 0u;
+        return uBytes;
+    }
+
+    std::map<VkDeviceMemory, Memory> mapMemory;
+    VkDeviceSize uLargestAllowed = ~VkDeviceSize{0};
+    uint32_t lAllocateCalls = 0u;
+    bool bReportBudget = false;
+    VkDeviceSize auBudget[VK_MAX_MEMORY_HEAPS] = {};
+    VkDeviceSize auUsage[VK_MAX_MEMORY_HEAPS] = {};
+
+private:
+    uint64_t m_uNextHandle = 0x1000u;
+};
+
+VkPhysicalDeviceMemoryProperties MakeProperties() {
+    VkPhysicalDeviceMemoryProperties stProps = {};
+    stProps.memoryHeapCount = 2u;
+    stProps.memoryHeaps[0].size = 4096ull * kMiB;
+    stProps.memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    stProps.memoryHeaps[1].size = 256ull * kMiB;
+    stProps.memoryTypeCount = 2u;
+    stProps.memoryTypes[kDeviceLocalType].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    stProps.memoryTypes[kDeviceLocalType].heapIndex = 0u;
+    stProps.memoryTypes[kHostVisibleType].propertyFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    stProps.memoryTypes[kHostVisibleType].heapIndex = 1u;
+    return stProps;
+}
+
+MemoryRequest MakeRequest(VkDeviceSize uSize_ic, VkDeviceSize uAlign_ic, VkMemoryPropertyFlags properties_ic,
+                          MemoryCategory eCategory_ic = MemoryCategory::Buffer) {
+    MemoryRequest stRequest;
+    stRequest.requirements.size = uSize_ic;
+    stRequest.requirements.alignment = uAlign_ic;
+    stRequest.requirements.memoryTypeBits = 0x3u;
+    stRequest.properties = properties_ic;
+    stRequest.eCategory = eCategory_ic;
+    return stRequest;
+}
+
+bool Overlaps(const MemoryAllocation& a_ic, const MemoryAllocation& b_ic) {
+    return (a_ic.memory == b_ic.memory) && (a_ic.uOffset < b_ic.uOffset + b_ic.uSize) && (b_ic.uOffset < a_ic.uOffset + a_ic.uSize);
+}
+
+void TestTypeSelection() {
+    FakeBackend backend;
+    DeviceMemoryAllocator allocator;
+    allocator.Create(&backend, MakeProperties(), kBlockSize);
+
+    MemoryAllocation stAlloc;
+    TEST_CHECK(allocator.Allocate(MakeRequest(kMiB, 256u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT), stAlloc));
+    TEST_CHECK_EQ(stAlloc.lMemoryType, kDeviceLocalType);
+    TEST_CHECK(stAlloc.pMapped == nullptr);
+    allocator.Free(stAlloc);
+    TEST_CHECK(stAlloc.IsValid() == false);
+
+    TEST_CHECK(allocator.Allocate(MakeRequest(kMiB, 256u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT), stAlloc));
+    TEST_CHECK_EQ(stAlloc.lMemoryType, kHostVisibleType);
+    allocator.Free(stAlloc);
+
+    // No property requirement: first allowed type in index order; type bits exclude type 0
+    MemoryRequest stRequest = MakeRequest(kMiB, 256u, 0u);
+    TEST_CHECK(allocator.Allocate(stRequest, stAlloc));
+    TEST_CHECK_EQ(stAlloc.lMemoryType, kDeviceLocalType);
+    allocator.Free(stAlloc);
+    stRequest.requirements.memoryTypeBits = 0x2u;
+    TEST_CHECK(allocator.Allocate(stRequest, stAlloc));
+    TEST_CHECK_EQ(stAlloc.lMemoryType, kHostVisibleType);
+    allocator.Free(stAlloc);
+
+    // Nothing matches, or nothing to allocate: fails, allocation left invalid
+    stRequest = MakeRequest(kMiB, 256u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+    TEST_CHECK(allocator.Allocate(stRequest, stAlloc) == false);
+    TEST_CHECK(stAlloc.IsValid() == false);
+    stRequest = MakeRequest(kMiB, 256u, 0u);
+    stRequest.requirements.memoryTypeBits = 0u;
+    TEST_CHECK(allocator.Allocate(stRequest, stAlloc) == false);
+    TEST_CHECK(allocator.Allocate(MakeRequest(0u, 256u, 0u), stAlloc) == false);
+    allocator.Destroy();
+    TEST_CHECK(backend.mapMemory.empty());
+}
+
+void TestPoolsAndBlocks() {
+    FakeBackend backend;
+    DeviceMemoryAllocator allocator;
+    allocator.Create(&backend, MakeProperties(), kBlockSize);
+    const VkMemoryPropertyFlags eDeviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    // Many small buffers share blocks; offsets are aligned and ranges never overlap
+    std::vector<MemoryAllocation> vecAllocs;
+    const VkDeviceSize aAlign[] = { 1u, 16u, 256u, 4096u, 65536u };
+    for (uint32_t i = 0u; i < 200u; ++i) {
+        const VkDeviceSize uAlign = aAlign[i % 5u];
+        MemoryAllocation stAlloc;
+        TEST_CHECK(allocator.Allocate(MakeRequest(100000u + 4099u * i, uAlign, eDeviceLocal), stAlloc));
+        TEST_CHECK(stAlloc.IsDedicated() == false);
+        TEST_CHECK_EQ(stAlloc.uOffset % uAlign, 0u);
+        TEST_CHECK_LE(stAlloc.uOffset + stAlloc.uSize, stAlloc.uMemorySize);
+        vecAllocs.push_back(stAlloc);
+    }
+    bool bOverlap = false;
+    for (size_t i = 0u; i < vecAllocs.size(); ++i) {
+        for (size_t j = i + 1u; j < vecAllocs.size(); ++j)
+            bOverlap |= Overlaps(vecAllocs[i], vecAllocs[j]);
+    }
+    TEST_CHECK(bOverlap == false);
+
+    // Blocks start at 1/8 of the block size and double up to it
+    std::vector<VkDeviceSize> vecBlockSizes;
+    for (const auto& [memory, stMemory] : backend.mapMemory)
+        vecBlockSizes.push_back(stMemory.uSize);
+    std::sort(vecBlockSizes.begin(), vecBlockSizes.end());
+    TEST_CHECK(vecBlockSizes.size() >= 4u);
+    if (vecBlockSizes.size() >= 4u) {
+        TEST_CHECK_EQ(vecBlockSizes[0], kBlockSize / 8u);
+        TEST_CHECK_EQ(vecBlockSizes[1], kBlockSize / 4u);
+        TEST_CHECK_EQ(vecBlockSizes[2], kBlockSize / 2u);
+        TEST_CHECK_EQ(vecBlockSizes[3], kBlockSize);
+    }
+    DeviceMemoryStats stStats = allocator.GetStats();
+    TEST_CHECK_EQ(stStats.lBlocks, backend.mapMemory.size());
+    TEST_CHECK_EQ(stStats.lAllocations, vecAllocs.size());
+    TEST_CHECK_EQ(stStats.uBlockBytes, backend.GetLiveBytes(kDeviceLocalType));
+    TEST_CHECK_EQ(stStats.lDedicated, 0u);
+
+    // Optimal-tiling images never share a block with buffers, even with room left
+    MemoryRequest stImageRequest = MakeRequest(4096u, 4096u, eDeviceLocal, MemoryCategory::Texture);
+    stImageRequest.bOptimalImage = true;
+    MemoryAllocation stImage;
+    TEST_CHECK(allocator.Allocate(stImageRequest, stImage));
+    for (const MemoryAllocation& stAlloc : vecAllocs)
+        TEST_CHECK(stAlloc.memory != stImage.memory);
+    TEST_CHECK(stImage.lPool != vecAllocs[0].lPool);
+    allocator.Free(stImage);
+    TEST_CHECK_EQ(allocator.GetStats().lBlocks, stStats.lBlocks + 1u);  // Last block of its pool: kept
+
+    // Freeing everything keeps one empty block per pool and returns the others to the device
+    for (MemoryAllocation& stAlloc : vecAllocs)
+        allocator.Free(stAlloc);
+    stStats = allocator.GetStats();
+    TEST_CHECK_EQ(stStats.lAllocations, 0u);
+    TEST_CHECK_EQ(stStats.lBlocks, 2u);
+    TEST_CHECK_EQ(backend.mapMemory.size(), 2u);
+    TEST_CHECK(stStats.fFragmentation == 0.0f);
+
+    // The kept block serves the next allocation without a device call
+    const uint32_t lCallsBefore = backend.lAllocateCalls;
+    MemoryAllocation stAgain;
+    TEST_CHECK(allocator.Allocate(MakeRequest(kMiB, 256u, eDeviceLocal), stAgain));
+    TEST_CHECK_EQ(backend.lAllocateCalls, lCallsBefore);
+    allocator.Free(stAgain);
+    allocator.Destroy();
+    TEST_CHECK(backend.mapMemory.empty());
+}
+
+void TestDedicated() {
+    FakeBackend backend;
+    DeviceMemoryAllocator allocator;
+    allocator.Create(&backend, MakeProperties(), kBlockSize);
+    const VkMemoryPropertyFlags eDeviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    // Asked for (render target): own memory, named image passed through to the backend
+    MemoryRequest stTarget = MakeRequest(8u * kMiB, 4096u, eDeviceLocal, MemoryCategory::RenderTarget);
+    stTarget.bDedicated = true;
+    stTarget.dedicatedImage = MakeHandle<VkImage>(0xABCDu);
+    MemoryAllocation stTargetAlloc;
+    TEST_CHECK(allocator.Allocate(stTarget, stTargetAlloc));
+    TEST_CHECK(stTargetAlloc.IsDedicated());
+    TEST_CHECK_EQ(stTargetAlloc.uOffset, 0u);
+    TEST_CHECK_EQ(stTargetAlloc.uMemorySize, 8u * kMiB);
+    TEST_CHECK(backend.mapMemory.at(stTargetAlloc.memory).dedicatedImage == stTarget.dedicatedImage);
+
+    // Above half a block: dedicated without asking; at half a block: pooled (in a block at least that large)
+    MemoryAllocation stLarge;
+    TEST_CHECK(allocator.Allocate(MakeRequest(kBlockSize / 2u + 1u, 256u, eDeviceLocal), stLarge));
+    TEST_CHECK(stLarge.IsDedicated());
+    TEST_CHECK(backend.mapMemory.at(stLarge.memory).dedicatedImage == VK_NULL_HANDLE);
+    MemoryAllocation stHalf;
+    TEST_CHECK(allocator.Allocate(MakeRequest(kBlockSize / 2u, 256u, eDeviceLocal), stHalf));
+    TEST_CHECK(stHalf.IsDedicated() == false);
+    TEST_CHECK(stHalf.uMemorySize >= kBlockSize / 2u);
+    // The small heap uses 32 MiB blocks, so more than 16 MiB there is dedicated
+    MemoryAllocation stHostLarge;
+    TEST_CHECK(allocator.Allocate(MakeRequest(16u * kMiB + 1u, 256u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT), stHostLarge));
+    TEST_CHECK(stHostLarge.IsDedicated());
+    TEST_CHECK(stHostLarge.pMapped != nullptr);
+
+    DeviceMemoryStats stStats = allocator.GetStats();
+    TEST_CHECK_EQ(stStats.lDedicated, 3u);
+    TEST_CHECK_EQ(stStats.uDedicatedBytes, 8u * kMiB + kBlockSize / 2u + 1u + 16u * kMiB + 1u);
+    TEST_CHECK_EQ(stStats.lAllocations, 1u);
+
+    // Dedicated memory goes back to the device on Free (mapped ones unmapped first: see FakeBackend::FreeMemory)
+    const size_t zLiveBefore = backend.mapMemory.size();
+    allocator.Free(stTargetAlloc);
+    allocator.Free(stLarge);
+    allocator.Free(stHostLarge);
+    TEST_CHECK_EQ(backend.mapMemory.size(), zLiveBefore - 3u);
+    TEST_CHECK_EQ(allocator.GetStats().lDedicated, 0u);
+    TEST_CHECK_EQ(allocator.GetStats().uDedicatedBytes, 0u);
+    allocator.Free(stHalf);
+    allocator.Destroy();
+}
+
+void TestHostMapping() {
+    FakeBackend backend;
+    DeviceMemoryAllocator allocator;
+    allocator.Create(&backend, MakeProperties(), kBlockSize);
+
+    // Every allocation in a mapped block gets base + offset; writes land in the backing memory
+    std::vector<MemoryAllocation> vecAllocs(16u);
+    for (uint32_t i = 0u; i < vecAllocs.size(); ++i) {
+        TEST_CHECK(allocator.Allocate(MakeRequest(1000u + i, 64u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, MemoryCategory::Staging),
+                                      vecAllocs[i]));
+        std::memset(vecAllocs[i].pMapped, static_cast<int>(i + 1u), static_cast<size_t>(vecAllocs[i].uSize));
+    }
+    for (uint32_t i = 0u; i < vecAllocs.size(); ++i) {
+        const MemoryAllocation& stAlloc = vecAllocs[i];
+        const FakeBackend::Memory& stMemory = backend.mapMemory.at(stAlloc.memory);
+        TEST_CHECK(stMemory.bMapped);
+        TEST_CHECK(stAlloc.pMapped == stMemory.pBytes.get() + stAlloc.uOffset);
+        const uint8_t* pBytes = stMemory.pBytes.get() + stAlloc.uOffset;
+        TEST_CHECK((pBytes[0] == i + 1u) && (pBytes[stAlloc.uSize - 1u] == i + 1u));
+    }
+    // All in one block, mapped once
+    TEST_CHECK_EQ(backend.mapMemory.size(), 1u);
+    for (MemoryAllocation& stAlloc : vecAllocs)
+        allocator.Free(stAlloc);
+    allocator.Destroy();
+    TEST_CHECK(backend.mapMemory.empty());
+}
+
+void TestDeviceRefusal() {
+    FakeBackend backend;
+    DeviceMemoryAllocator allocator;
+    allocator.Create(&backend, MakeProperties(), kBlockSize);
+    const VkMemoryPropertyFlags eDeviceLocal = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    // A refused block is retried at half the size, down to the request itself
+    backend.uLargestAllowed = 2u * kMiB;
+    MemoryAllocation stAlloc;
+    TEST_CHECK(allocator.Allocate(MakeRequest(kMiB, 256u, eDeviceLocal), stAlloc));
+    TEST_CHECK_EQ(stAlloc.uMemorySize, 2u * kMiB);
+    allocator.Free(stAlloc);
+
+    // Nothing the device accepts: Allocate fails cleanly
+    backend.uLargestAllowed = kMiB / 2u;
+    MemoryAllocation stBlocked;
+    TEST_CHECK(allocator.Allocate(MakeRequest(3u * kMiB, 256u, eDeviceLocal), stBlocked) == false);
+    TEST_CHECK(stBlocked.IsValid() == false);
+    allocator.Destroy();
+    TEST_CHECK(backend.mapMemory.empty());
+}
+
+void TestStatsAndBudget() {
+    FakeBackend backend;
+    DeviceMemoryAllocator allocator;
+    const VkPhysicalDeviceMemoryProperties stProps = MakeProperties();
+    allocator.Create(&backend, stProps, kBlockSize);
+
+    // Without VK_EXT_memory_budget: budget is 80% of the heap, usage is what this allocator holds
+    MemoryAllocation stMesh;
+    MemoryAllocation stTexture;
+    MemoryAllocation stStaging;
+    TEST_CHECK(allocator.Allocate(MakeRequest(3u * kMiB, 256u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Mesh), stMesh));
+    TEST_CHECK(allocator.Allocate(MakeRequest(5u * kMiB, 4096u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Texture), stTexture));
+    TEST_CHECK(allocator.Allocate(MakeRequest(kMiB, 256u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, MemoryCategory::Staging), stStaging));
+    DeviceMemoryStats stStats = allocator.GetStats();
+    TEST_CHECK(stStats.bDriverBudget == false);
+    TEST_CHECK_EQ(stStats.lHeapCount, 2u);
+    TEST_CHECK_EQ(stStats.auCategoryBytes[static_cast<size_t>(MemoryCategory::Mesh)], 3u * kMiB);
+    TEST_CHECK_EQ(stStats.auCategoryBytes[static_cast<size_t>(MemoryCategory::Texture)], 5u * kMiB);
+    TEST_CHECK_EQ(stStats.alCategoryCount[static_cast<size_t>(MemoryCategory::Staging)], 1u);
+    for (uint32_t lHeap = 0u; lHeap < 2u; ++lHeap) {
+        const MemoryHeapBudget& stHeap = stStats.astHeaps[lHeap];
+        TEST_CHECK_EQ(stHeap.uSize, stProps.memoryHeaps[lHeap].size);
+        TEST_CHECK_EQ(stHeap.uBudget, stProps.memoryHeaps[lHeap].size / 10u * 8u);
+        TEST_CHECK_EQ(stHeap.uAllocated, backend.GetLiveBytes(lHeap));  // One memory type per heap here
+        TEST_CHECK_EQ(stHeap.uUsage, stHeap.uAllocated);
+    }
+    TEST_CHECK(stStats.astHeaps[0].uAllocated > 0u);
+
+    // Past the budget: a warning, and the allocation is still made
+    MemoryAllocation stOver;
+    TEST_CHECK(allocator.Allocate(MakeRequest(210u * kMiB, 256u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT), stOver));
+    stStats = allocator.GetStats();
+    TEST_CHECK(stStats.astHeaps[1].uAllocated > stStats.astHeaps[1].uBudget);
+    allocator.Free(stOver);
+    TEST_CHECK_EQ(allocator.GetStats().astHeaps[1].uAllocated, backend.GetLiveBytes(kHostVisibleType));
+
+    // Category totals follow frees
+    allocator.Free(stMesh);
+    stStats = allocator.GetStats();
+    TEST_CHECK_EQ(stStats.auCategoryBytes[static_cast<size_t>(MemoryCategory::Mesh)], 0u);
+    TEST_CHECK_EQ(stStats.alCategoryCount[static_cast<size_t>(MemoryCategory::Mesh)], 0u);
+    allocator.Free(stTexture);
+    allocator.Free(stStaging);
+
+    // With VK_EXT_memory_budget the driver's numbers are reported as they are
+    backend.bReportBudget = true;
+    backend.auBudget[0] = 3000u * kMiB;
+    backend.auUsage[0] = 1234u * kMiB;
+    backend.auBudget[1] = 200u * kMiB;
+    backend.auUsage[1] = 7u * kMiB;
+    stStats = allocator.GetStats();
+    TEST_CHECK(stStats.bDriverBudget);
+    TEST_CHECK_EQ(stStats.astHeaps[0].uBudget, 3000u * kMiB);
+    TEST_CHECK_EQ(stStats.astHeaps[0].uUsage, 1234u * kMiB);
+    TEST_CHECK_EQ(stStats.astHeaps[1].uUsage, 7u * kMiB);
+    TEST_CHECK_EQ(stStats.astHeaps[0].uAllocated, backend.GetLiveBytes(kDeviceLocalType));
+    allocator.Destroy();
+    TEST_CHECK(backend.mapMemory.empty());
+}
+
+void TestDestroyWithLiveAllocations() {
+    FakeBackend backend;
+    DeviceMemoryAllocator allocator;
+    allocator.Create(&backend, MakeProperties(), kBlockSize);
+    MemoryAllocation stPooled;
+    MemoryAllocation stDedicated;
+    TEST_CHECK(allocator.Allocate(MakeRequest(kMiB, 256u, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT), stPooled));
+    MemoryRequest stRequest = MakeRequest(kMiB, 256u, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    stRequest.bDedicated = true;
+    TEST_CHECK(allocator.Allocate(stRequest, stDedicated));
+    // Blocks are freed (and unmapped); the leak is reported. Freeing afterwards is ignored.
+    allocator.Destroy();
+    TEST_CHECK(allocator.IsValid() == false);
+    TEST_CHECK_EQ(backend.mapMemory.size(), 1u);  // Destroy owns blocks only; the live dedicated one is just reported
+    allocator.Free(stPooled);
+    TEST_CHECK(stPooled.IsValid() == false);
+    backend.FreeMemory(stDedicated.memory);
+}
+
+} // namespace
+
+int main() {
+    TestTypeSelection();
+    TestPoolsAndBlocks();
+    TestDedicated();
+    TestHostMapping();
+    TestDeviceRefusal();
+    TestStatsAndBudget();
+    TestDestroyWithLiveAllocations();
+    return Test::Finish("test_device_memory_allocator");
+}
@@ -0,0 +1,196 @@
+/*
+ * BuildMeshlets (loaders/meshlet_builder) on a UV sphere and a flat grid: meshlet size limits, every triangle in exactly
+ * one meshlet in index order, bounding spheres that contain their vertices, and normal cones that contain every
+ * triangle normal (cutoff = sin(spread), so cos(spread) = sqrt(1 - cutoff^2)). Malformed input is rejected.
+ */
+#include "test_common.h"
+#include "meshlet_builder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct TestMesh {
+    std::vector<float> vecPositions;   // 3 floats per source vertex
+    std::vector<uint32_t> vecIndices;  // Triangle list, CCW front faces
+};
+
+/* Unit sphere, outward-facing CCW triangles; shared vertices so the unique-vertex limit is what closes meshlets. */
+TestMesh MakeSphere(uint32_t lRings_ic, uint32_t lSegments_ic) {
+    TestMesh stMesh;
+    const float fPi = 3.14159265358979f;
+    for (uint32_t lR = 0u; lR <= lRings_ic; ++lR) {
+        const float fTheta = fPi * static_cast<float>(lR) / static_cast<float>(lRings_ic);
+        for (uint32_t lS = 0u; lS <= lSegments_ic; ++lS) {
+            const float fPhi = 2.f * fPi * static_cast<float>(lS) / static_cast<float>(lSegments_ic);
+            stMesh.vecPositions.insert(stMesh.vecPositions.end(),
+                                       { std::sin(fTheta) * std::cos(fPhi), std::cos(fTheta), -std::sin(fTheta) * std::sin(fPhi) });
+        }
+    }
+    const uint32_t lStride = lSegments_ic + 1u;
+    for (uint32_t lR = 0u; lR < lRings_ic; ++lR) {
+        for (uint32_t lS = 0u; lS < lSegments_ic; ++lS) {
+            const uint32_t lA = lR * lStride + lS;
+            const uint32_t lB = lA + lStride;
+            /* Pole rows collapse to degenerate triangles; keep them, the builder must tolerate them. */
+            stMesh.vecIndices.insert(stMesh.vecIndices.end(), { lA, lB, lA + 1u, lA + 1u, lB, lB + 1u });
+        }
+    }
+    return stMesh;
+}
+
+/* Flat grid in the XZ plane facing +Y. */
+TestMesh MakeGrid(uint32_t lCells_ic) {
+    TestMesh stMesh;
+    for (uint32_t lZ = 0u; lZ <= lCells_ic; ++lZ)
+        for (uint32_t lX = 0u; lX <= lCells_ic; ++lX)
+            stMesh.vecPositions.insert(stMesh.vecPositions.end(), { static_cast<float>(lX), 0.f, static_cast<float>(lZ) });
+    const uint32_t lStride = lCells_ic + 1u;
+    for (uint32_t lZ = 0u; lZ < lCells_ic; ++lZ) {
+        for (uint32_t lX = 0u; lX < lCells_ic; ++lX) {
+            const uint32_t lA = lZ * lStride + lX;
+            const uint32_t lB = lA + lStride;
+            stMesh.vecIndices.insert(stMesh.vecIndices.end(), { lA, lB, lA + 1u, lA + 1u, lB, lB + 1u });
+        }
+    }
+    return stMesh;
+}
+
+/* Unit face normal of triangle lTri_ic; false when degenerate. */
+bool FaceNormal(const TestMesh& mesh_ic, uint32_t lTri_ic, float (&fN_out)[3]) {
+    const float* pA = &mesh_ic.vecPositions[static_cast<size_t>(mesh_ic.vecIndices[lTri_ic * 3u + 0u]) * 3u];
+    const float* pB = &mesh_ic.vecPositions[static_cast<size_t>(mesh_ic.vecIndices[lTri_ic * 3u + 1u]) * 3u];
+    const float* pC = &mesh_ic.vecPositions[static_cast<size_t>(mesh_ic.vecIndices[lTri_ic * 3u + 2u]) * 3u];
+    const float fE1[3] = { pB[0] - pA[0], pB[1] - pA[1], pB[2] - pA[2] };
+    const float fE2[3] = { pC[0] - pA[0], pC[1] - pA[1], pC[2] - pA[2] };
+    fN_out[0] = fE1[1] * fE2[2] - fE1[2] * fE2[1];
+    fN_out[1] = fE1[2] * fE2[0] - fE1[0] * fE2[2];
+    fN_out[2] = fE1[0] * fE2[1] - fE1[1] * fE2[0];
+    const float fLen = std::sqrt(fN_out[0] * fN_out[0] + fN_out[1] * fN_out[1] + fN_out[2] * fN_out[2]);
+    if (fLen <= 1e-12f)
+        return false;
+    fN_out[0] /= fLen;
+    fN_out[1] /= fLen;
+    fN_out[2] /= fLen;
+    return true;
+}
+
+/* Checks every meshlet invariant; returns the number of meshlets with a usable (non-degenerate) cone. */
+uint32_t CheckMeshlets(const TestMesh& mesh_ic, const std::vector<Meshlet>& vecMeshlets_ic,
+                       uint32_t lMaxVertices_ic, uint32_t lMaxTriangles_ic) {
+    const uint32_t lTriangleCount = static_cast<uint32_t>(mesh_ic.vecIndices.size() / 3u);
+    std::vector<uint32_t> vecTriangleHits(lTriangleCount, 0u);
+    std::vector<uint32_t> vecUnique;
+    uint32_t lConeCount = 0u;
+    for (const Meshlet& stMeshlet : vecMeshlets_ic) {
+        TEST_CHECK_EQ(stMeshlet.firstVertex % 3u, 0u);
+        TEST_CHECK_EQ(stMeshlet.vertexCount % 3u, 0u);
+        TEST_CHECK(stMeshlet.vertexCount > 0u);
+        TEST_CHECK_LE(stMeshlet.firstVertex + stMeshlet.vertexCount, mesh_ic.vecIndices.size());
+        if (stMeshlet.firstVertex + stMeshlet.vertexCount > mesh_ic.vecIndices.size())
+            continue;
+        const uint32_t lFirstTri = stMeshlet.firstVertex / 3u;
+        const uint32_t lTriCount = stMeshlet.vertexCount / 3u;
+        TEST_CHECK_LE(lTriCount, lMaxTriangles_ic);
+
+        vecUnique.assign(mesh_ic.vecIndices.begin() + stMeshlet.firstVertex,
+                         mesh_ic.vecIndices.begin() + stMeshlet.firstVertex + stMeshlet.vertexCount);
+        std::sort(vecUnique.begin(), vecUnique.end());
+        vecUnique.erase(std::unique(vecUnique.begin(), vecUnique.end()), vecUnique.end());
+        TEST_CHECK_LE(vecUnique.size(), lMaxVertices_ic);
+
+        // Bounding sphere holds every vertex (relative slack for float rounding)
+        const float* pSphere = stMeshlet.boundingSphere;
+        float fWorstExcess = 0.f;
+        for (uint32_t lIdx : vecUnique) {
+            const float* pP = &mesh_ic.vecPositions[static_cast<size_t>(lIdx) * 3u];
+            const float fDx = pP[0] - pSphere[0];
+            const float fDy = pP[1] - pSphere[1];
+            const float fDz = pP[2] - pSphere[2];
+            fWorstExcess = std::max(fWorstExcess, std::sqrt(fDx * fDx + fDy * fDy + fDz * fDz) - pSphere[3]);
+        }
+        TEST_CHECK_LE(fWorstExcess, 1e-5f * std::max(1.f, pSphere[3]));
+
+        // Every non-degenerate face normal lies inside the cone: dot(n, axis) >= cos(spread)
+        const bool bCone = (stMeshlet.coneCutoff < 1.f);
+        if (bCone == true) {
+            ++lConeCount;
+            const float* pAxis = stMeshlet.coneAxis;
+            TEST_CHECK_LE(std::fabs(pAxis[0] * pAxis[0] + pAxis[1] * pAxis[1] + pAxis[2] * pAxis[2] - 1.f), 1e-5f);
+            TEST_CHECK(stMeshlet.coneCutoff >= 0.f);
+        }
+        const float fCosSpread = std::sqrt(std::max(0.f, 1.f - stMeshlet.coneCutoff * stMeshlet.coneCutoff));
+        float fWorstDot = 1.f;
+        for (uint32_t lT = lFirstTri; lT < lFirstTri + lTriCount; ++lT) {
+            ++vecTriangleHits[lT];
+            float fN[3];
+            if ((bCone == true) && (FaceNormal(mesh_ic, lT, fN) == true))
+                fWorstDot = std::min(fWorstDot, fN[0] * stMeshlet.coneAxis[0] + fN[1] * stMeshlet.coneAxis[1] + fN[2] * stMeshlet.coneAxis[2]);
+        }
+        if (bCone == true)
+            TEST_CHECK_LE(fCosSpread - 1e-4f, fWorstDot);
+    }
+
+    // Each triangle in exactly one meshlet, and meshlets tile the index stream in order
+    uint32_t lMissedOrRepeated = 0u;
+    for (uint32_t lHits : vecTriangleHits)
+        lMissedOrRepeated += (lHits != 1u) ? 1u : 0u;
+    TEST_CHECK_EQ(lMissedOrRepeated, 0u);
+    uint32_t lExpectedFirst = 0u;
+    for (const Meshlet& stMeshlet : vecMeshlets_ic) {
+        TEST_CHECK_EQ(stMeshlet.firstVertex, lExpectedFirst);
+        lExpectedFirst = stMeshlet.firstVertex + stMeshlet.vertexCount;
+    }
+    TEST_CHECK_EQ(lExpectedFirst, mesh_ic.vecIndices.size());
+    return lConeCount;
+}
+
+void TestSphere() {
+    const TestMesh stMesh = MakeSphere(48u, 64u);
+    std::vector<Meshlet> vecMeshlets;
+    TEST_CHECK(BuildMeshlets(stMesh.vecPositions.data(), stMesh.vecPositions.size() / 3u, stMesh.vecIndices, vecMeshlets));
+    TEST_CHECK(vecMeshlets.size() > 1u);
+    const uint32_t lCones = CheckMeshlets(stMesh, vecMeshlets, kMeshletMaxVertices, kMeshletMaxTriangles);
+    // Sphere meshlets are small patches: most must get a usable cone or cone culling never fires
+    TEST_CHECK(lCones * 2u > static_cast<uint32_t>(vecMeshlets.size()));
+
+    // Tighter limits split more and still hold every invariant
+    TEST_CHECK(BuildMeshlets(stMesh.vecPositions.data(), stMesh.vecPositions.size() / 3u, stMesh.vecIndices, vecMeshlets, 16u, 10u));
+    CheckMeshlets(stMesh, vecMeshlets, 16u, 10u);
+}
+
+void TestFlatGrid() {
+    const TestMesh stMesh = MakeGrid(40u);
+    std::vector<Meshlet> vecMeshlets;
+    TEST_CHECK(BuildMeshlets(stMesh.vecPositions.data(), stMesh.vecPositions.size() / 3u, stMesh.vecIndices, vecMeshlets));
+    const uint32_t lCones = CheckMeshlets(stMesh, vecMeshlets, kMeshletMaxVertices, kMeshletMaxTriangles);
+    TEST_CHECK_EQ(lCones, vecMeshlets.size());
+    // Coplanar triangles: axis is +Y and the cone has no spread
+    for (const Meshlet& stMeshlet : vecMeshlets) {
+        TEST_CHECK_LE(std::fabs(stMeshlet.coneAxis[1] - 1.f), 1e-5f);
+        TEST_CHECK_LE(stMeshlet.coneCutoff, 1e-3f);
+    }
+}
+
+void TestMalformedInput() {
+    const TestMesh stMesh = MakeGrid(2u);
+    const size_t zCount = stMesh.vecPositions.size() / 3u;
+    std::vector<Meshlet> vecMeshlets(3u);
+    TEST_CHECK(BuildMeshlets(stMesh.vecPositions.data(), zCount, {}, vecMeshlets) == false);
+    TEST_CHECK(vecMeshlets.empty());
+    TEST_CHECK(BuildMeshlets(stMesh.vecPositions.data(), zCount, { 0u, 1u }, vecMeshlets) == false);
+    TEST_CHECK(BuildMeshlets(nullptr, zCount, stMesh.vecIndices, vecMeshlets) == false);
+    TEST_CHECK(BuildMeshlets(stMesh.vecPositions.data(), zCount, { 0u, 1u, static_cast<uint32_t>(zCount) }, vecMeshlets) == false);
+    TEST_CHECK(BuildMeshlets(stMesh.vecPositions.data(), zCount, stMesh.vecIndices, vecMeshlets, 2u, 8u) == false);
+}
+
+} // namespace
+
+int main() {
+    TestSphere();
+    TestFlatGrid();
+    TestMalformedInput();
+    return Test::Finish("test_meshlet_builder");
+}
@@ -0,0 +1,171 @@
+/*
+ * pixel_convert against a per-pixel reference written from the header contract. Built three times (see
+ * CMakeLists.txt): default flags (SSE2 on x86-64, NEON on arm64), -mssse3 on x86 (the pshufb RGB kernel) and
+ * PIXCONV_FORCE_SCALAR. Every width from 0 to 80 pixels and unaligned source / destination offsets exercise the
+ * SIMD loops and their scalar tails; a guard band after each destination catches writes past the end.
+ */
+#include "test_common.h"
+#include "pixel_convert.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr size_t kMaxPixels = 80u;   // 5 x 16-pixel SIMD iterations plus every tail length
+constexpr size_t kMaxOffset = 3u;    // Misalign source and destination by 0..3 bytes
+constexpr size_t kGuardBytes = 64u;
+constexpr uint8_t kGuardValue = 0xCDu;
+
+uint32_t NextRandom(uint32_t& uState_io) {
+    uState_io = uState_io * 1664525u + 1013904223u;
+    return uState_io >> 8;
+}
+
+void ReferenceExpand(const uint8_t* pSrc_ic, size_t zPixels_ic, uint32_t lChannels_ic, uint8_t* pDst_out) {
+    for (size_t i = 0; i < zPixels_ic; ++i) {
+        const uint8_t* pIn = pSrc_ic + i * lChannels_ic;
+        uint8_t* pOut = pDst_out + i * 4u;
+        switch (lChannels_ic) {
+        case 1u: pOut[0] = pIn[0]; pOut[1] = pIn[0]; pOut[2] = pIn[0]; pOut[3] = 255u; break;
+        case 2u: pOut[0] = pIn[0]; pOut[1] = pIn[0]; pOut[2] = pIn[0]; pOut[3] = pIn[1]; break;
+        case 3u: pOut[0] = pIn[0]; pOut[1] = pIn[1]; pOut[2] = pIn[2]; pOut[3] = 255u; break;
+        default: std::memcpy(pOut, pIn, 4u); break;
+        }
+    }
+}
+
+/* The same float operations as the library tables, so results match bit for bit. */
+float ReferenceSrgbToLinear(uint8_t cValue_ic) {
+    const float fC = static_cast<float>(cValue_ic) / 255.0f;
+    return (fC <= 0.04045f) ? (fC / 12.92f) : std::pow((fC + 0.055f) / 1.055f, 2.4f);
+}
+
+uint8_t ReferenceLinearToSrgb(float fValue_ic) {
+    const float fClamped = (fValue_ic > 0.0f) ? std::min(fValue_ic, 1.0f) : 0.0f;
+    const uint32_t lIndex = static_cast<uint32_t>(fClamped * 4095.0f + 0.5f);
+    const float fL = static_cast<float>(lIndex) / 4095.0f;
+    const float fS = (fL <= 0.0031308f) ? (fL * 12.92f) : (1.055f * std::pow(fL, 1.0f / 2.4f) - 0.055f);
+    return static_cast<uint8_t>(std::clamp(fS * 255.0f + 0.5f, 0.0f, 255.0f));
+}
+
+uint8_t ReferenceAlpha(float fValue_ic) {
+    const float fClamped = (fValue_ic > 0.0f) ? std::min(fValue_ic, 1.0f) : 0.0f;
+    return static_cast<uint8_t>(fClamped * 255.0f + 0.5f);
+}
+
+bool GuardIntact(const std::vector<uint8_t>& vecBuffer_ic, size_t zEnd_ic) {
+    return std::all_of(vecBuffer_ic.begin() + static_cast<std::ptrdiff_t>(zEnd_ic), vecBuffer_ic.end(),
+                       [](uint8_t cByte) { return cByte == kGuardValue; });
+}
+
+void CheckExpand() {
+    uint32_t uState = 1u;
+    std::vector<uint8_t> vecSrc(kMaxPixels * 4u + kMaxOffset);
+    for (uint8_t& cByte : vecSrc)
+        cByte = static_cast<uint8_t>(NextRandom(uState));
+    std::vector<uint8_t> vecExpected(kMaxPixels * 4u);
+    std::vector<uint8_t> vecDst(kMaxPixels * 4u + kMaxOffset + kGuardBytes);
+    int iMismatches = 0;
+    int iGuardHits = 0;
+    for (uint32_t lChannels = 1u; lChannels <= 4u; ++lChannels) {
+        for (size_t zPixels = 0u; zPixels <= kMaxPixels; ++zPixels) {
+            for (size_t zSrcOffset = 0u; zSrcOffset <= kMaxOffset; ++zSrcOffset) {
+                for (size_t zDstOffset = 0u; zDstOffset <= kMaxOffset; ++zDstOffset) {
+                    std::fill(vecDst.begin(), vecDst.end(), kGuardValue);
+                    ReferenceExpand(vecSrc.data() + zSrcOffset, zPixels, lChannels, vecExpected.data());
+                    ExpandToRGBA8(vecSrc.data() + zSrcOffset, zPixels, lChannels, vecDst.data() + zDstOffset);
+                    if (std::memcmp(vecDst.data() + zDstOffset, vecExpected.data(), zPixels * 4u) != 0)
+                        ++iMismatches;
+                    if (GuardIntact(vecDst, zDstOffset + zPixels * 4u) == false)
+                        ++iGuardHits;
+                }
+            }
+        }
+    }
+    TEST_CHECK_EQ(iMismatches, 0);
+    TEST_CHECK_EQ(iGuardHits, 0);
+
+    // A large odd count (many SIMD iterations, 15-pixel tail) per channel count
+    constexpr size_t kLargePixels = 4096u * 3u + 15u;
+    std::vector<uint8_t> vecLargeSrc(kLargePixels * 4u);
+    for (uint8_t& cByte : vecLargeSrc)
+        cByte = static_cast<uint8_t>(NextRandom(uState));
+    std::vector<uint8_t> vecLargeExpected(kLargePixels * 4u);
+    std::vector<uint8_t> vecLargeDst(kLargePixels * 4u);
+    for (uint32_t lChannels = 1u; lChannels <= 4u; ++lChannels) {
+        ReferenceExpand(vecLargeSrc.data(), kLargePixels, lChannels, vecLargeExpected.data());
+        ExpandToRGBA8(vecLargeSrc.data(), kLargePixels, lChannels, vecLargeDst.data());
+        TEST_CHECK(vecLargeDst == vecLargeExpected);
+    }
+}
+
+void CheckDecodeSrgb() {
+    std::vector<uint8_t> vecSrc(256u * 4u);
+    for (uint32_t i = 0u; i < 256u; ++i) {
+        vecSrc[i * 4u + 0u] = static_cast<uint8_t>(i);
+        vecSrc[i * 4u + 1u] = static_cast<uint8_t>(255u - i);
+        vecSrc[i * 4u + 2u] = static_cast<uint8_t>((i * 7u) & 0xFFu);
+        vecSrc[i * 4u + 3u] = static_cast<uint8_t>(i);
+    }
+    std::vector<float> vecDst(256u * 4u);
+    DecodeSrgbRGBA8ToLinear(vecSrc.data(), 256u, vecDst.data());
+    int iMismatches = 0;
+    for (size_t i = 0; i < vecSrc.size(); ++i) {
+        const float fExpected = ((i % 4u) == 3u) ? (static_cast<float>(vecSrc[i]) * (1.0f / 255.0f)) : ReferenceSrgbToLinear(vecSrc[i]);
+        if (vecDst[i] != fExpected)
+            ++iMismatches;
+    }
+    TEST_CHECK_EQ(iMismatches, 0);
+}
+
+void CheckEncodeSrgb() {
+    // Edge values: out of range, NaN, +-inf, denormal, curve knee, exact table points and half-way cases
+    std::vector<float> vecValues = { 0.0f, -0.0f, 1.0f, -1.0f, 2.0f, 0.5f, 0.0031308f, 0.0031309f, 1.0e-40f,
+                                     std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(),
+                                     -std::numeric_limits<float>::infinity(), 1.0f / 4095.0f, 0.5f / 4095.0f,
+                                     0.5f / 255.0f, 254.5f / 255.0f, 0.99999994f };
+    uint32_t uState = 7u;
+    while (vecValues.size() < kMaxPixels * 4u)
+        vecValues.push_back(static_cast<float>(NextRandom(uState) % 1200000u) / 1000000.0f - 0.1f);
+
+    std::vector<uint8_t> vecDst(kMaxPixels * 4u + kGuardBytes);
+    int iMismatches = 0;
+    int iGuardHits = 0;
+    for (size_t zPixels = 0u; zPixels <= kMaxPixels; ++zPixels) {
+        std::fill(vecDst.begin(), vecDst.end(), kGuardValue);
+        EncodeLinearToSrgbRGBA8(vecValues.data(), zPixels, vecDst.data());
+        for (size_t i = 0; i < zPixels * 4u; ++i) {
+            const uint8_t cExpected = ((i % 4u) == 3u) ? ReferenceAlpha(vecValues[i]) : ReferenceLinearToSrgb(vecValues[i]);
+            if (vecDst[i] != cExpected)
+                ++iMismatches;
+        }
+        if (GuardIntact(vecDst, zPixels * 4u) == false)
+            ++iGuardHits;
+    }
+    TEST_CHECK_EQ(iMismatches, 0);
+    TEST_CHECK_EQ(iGuardHits, 0);
+
+    // Every 8-bit value survives decode -> encode (RGB through the curve, alpha linear)
+    std::vector<uint8_t> vecBytes(256u * 4u);
+    for (uint32_t i = 0u; i < 256u; ++i)
+        std::fill(vecBytes.begin() + i * 4u, vecBytes.begin() + i * 4u + 4u, static_cast<uint8_t>(i));
+    std::vector<float> vecLinear(vecBytes.size());
+    std::vector<uint8_t> vecRoundTrip(vecBytes.size());
+    DecodeSrgbRGBA8ToLinear(vecBytes.data(), 256u, vecLinear.data());
+    EncodeLinearToSrgbRGBA8(vecLinear.data(), 256u, vecRoundTrip.data());
+    TEST_CHECK(vecRoundTrip == vecBytes);
+}
+
+} // namespace
+
+int main() {
+    std::printf("pixel_convert path: %s\n", GetPixelConvertPath());
+    CheckExpand();
+    CheckDecodeSrgb();
+    CheckEncodeSrgb();
+    return Test::Finish("test_pixel_convert");
+}
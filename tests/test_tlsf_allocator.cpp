@@ -0,0 +1,209 @@
+/*
+ * TlsfAllocator (vulkan/tlsf_allocator) on the CPU: exact fits and exhaustion, merging of freed neighbours in every
+ * order, alignment, and a long random allocate / free run checked against a list of live ranges (no overlap, used
+ * bytes, and one free range per gap between live ranges, i.e. nothing left unmerged).
+ */
+#include "test_common.h"
+#include "tlsf_allocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+struct LiveRange {
+    uint64_t uOffset = 0u;
+    uint64_t uSize = 0u;
+    uint32_t lNode = TlsfAllocator::kInvalidNode;
+};
+
+uint32_t NextRandom(uint32_t& uState_io) {
+    uState_io = uState_io * 1664525u + 1013904223u;
+    return uState_io >> 8;
+}
+
+/* Live ranges must not overlap or leave the managed range; free ranges must be exactly the gaps between them. */
+void CheckAgainstLive(const TlsfAllocator& tlsf_ic, std::vector<LiveRange> vecLive_ic) {
+    std::sort(vecLive_ic.begin(), vecLive_ic.end(), [](const LiveRange& a, const LiveRange& b) { return a.uOffset < b.uOffset; });
+    uint64_t uUsed = 0u;
+    uint32_t lGaps = 0u;
+    uint64_t uEnd = 0u;
+    bool bOverlap = false;
+    for (const LiveRange& stRange : vecLive_ic) {
+        bOverlap |= (stRange.uOffset < uEnd);
+        lGaps += (stRange.uOffset > uEnd) ? 1u : 0u;
+        uEnd = stRange.uOffset + stRange.uSize;
+        uUsed += stRange.uSize;
+    }
+    lGaps += (uEnd < tlsf_ic.GetSize()) ? 1u : 0u;
+    TEST_CHECK(bOverlap == false);
+    TEST_CHECK_LE(uEnd, tlsf_ic.GetSize());
+    TEST_CHECK_EQ(tlsf_ic.GetUsedBytes(), uUsed);
+    TEST_CHECK_EQ(tlsf_ic.GetAllocationCount(), vecLive_ic.size());
+    TEST_CHECK_EQ(tlsf_ic.GetFreeRangeCount(), lGaps);
+}
+
+void TestExactFitAndExhaustion() {
+    TlsfAllocator tlsf(1u << 20);
+    uint64_t uOffset = 1u;
+    const uint32_t lWhole = tlsf.Allocate(1u << 20, 1u, uOffset);
+    TEST_CHECK(lWhole != TlsfAllocator::kInvalidNode);
+    TEST_CHECK_EQ(uOffset, 0u);
+    TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 0u);
+    TEST_CHECK(tlsf.Allocate(1u, 1u, uOffset) == TlsfAllocator::kInvalidNode);
+    tlsf.Free(lWhole);
+    TEST_CHECK(tlsf.IsEmpty());
+    TEST_CHECK_EQ(tlsf.GetLargestFreeRange(), 1u << 20);
+
+    // Equal blocks fill the range exactly, then nothing more fits
+    std::vector<uint32_t> vecNodes;
+    while (true) {
+        const uint32_t lNode = tlsf.Allocate(4096u, 4096u, uOffset);
+        if (lNode == TlsfAllocator::kInvalidNode)
+            break;
+        TEST_CHECK_EQ(uOffset % 4096u, 0u);
+        vecNodes.push_back(lNode);
+    }
+    TEST_CHECK_EQ(vecNodes.size(), (1u << 20) / 4096u);
+    TEST_CHECK_EQ(tlsf.GetFreeBytes(), 0u);
+    for (uint32_t lNode : vecNodes)
+        tlsf.Free(lNode);
+    TEST_CHECK(tlsf.IsEmpty());
+    TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 1u);
+
+    // Too large and over-aligned requests fail without changing anything
+    TEST_CHECK(tlsf.Allocate((1u << 20) + 1u, 1u, uOffset) == TlsfAllocator::kInvalidNode);
+    TEST_CHECK(tlsf.Allocate(16u, uint64_t{1} << 40, uOffset) == TlsfAllocator::kInvalidNode);
+    TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 1u);
+}
+
+/* Three neighbours A B C, freed in each of the six orders: the free list always ends as one range. */
+void TestCoalescing() {
+    const uint32_t aOrders[6][3] = { {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0} };
+    for (const auto& aOrder : aOrders) {
+        TlsfAllocator tlsf(3u * 4096u);
+        std::vector<LiveRange> vecLive(3u);
+        for (LiveRange& stRange : vecLive) {
+            stRange.uSize = 4096u;
+            stRange.lNode = tlsf.Allocate(stRange.uSize, 256u, stRange.uOffset);
+            TEST_CHECK(stRange.lNode != TlsfAllocator::kInvalidNode);
+        }
+        TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 0u);
+        for (uint32_t lIndex : aOrder) {
+            tlsf.Free(vecLive[lIndex].lNode);
+            vecLive[lIndex].uSize = 0u;
+            std::vector<LiveRange> vecStill;
+            for (const LiveRange& stRange : vecLive) {
+                if (stRange.uSize != 0u)
+                    vecStill.push_back(stRange);
+            }
+            CheckAgainstLive(tlsf, vecStill);
+        }
+        TEST_CHECK(tlsf.IsEmpty());
+        TEST_CHECK_EQ(tlsf.GetLargestFreeRange(), 3u * 4096u);
+    }
+
+    // Freeing a middle range between two free ones merges all three; the whole range is allocatable again
+    TlsfAllocator tlsf(1u << 16);
+    uint64_t uOffset = 0u;
+    const uint32_t lA = tlsf.Allocate(1000u, 1u, uOffset);
+    const uint32_t lB = tlsf.Allocate(3000u, 1u, uOffset);
+    const uint32_t lC = tlsf.Allocate(5000u, 1u, uOffset);
+    tlsf.Free(lA);
+    tlsf.Free(lC);
+    TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 2u);
+    tlsf.Free(lB);
+    TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 1u);
+    TEST_CHECK(tlsf.Allocate(1u << 16, 1u, uOffset) != TlsfAllocator::kInvalidNode);
+}
+
+void TestAlignment() {
+    TlsfAllocator tlsf(1u << 22);
+    std::vector<LiveRange> vecLive;
+    uint64_t uOffset = 0u;
+    // An odd-sized allocation first, so every later one starts misaligned
+    LiveRange stOdd;
+    stOdd.uSize = 1u;
+    stOdd.lNode = tlsf.Allocate(1u, 1u, stOdd.uOffset);
+    vecLive.push_back(stOdd);
+    for (uint64_t uAlign = 1u; uAlign <= 65536u; uAlign <<= 1) {
+        LiveRange stRange;
+        stRange.uSize = 3u * uAlign + 7u;
+        stRange.lNode = tlsf.Allocate(stRange.uSize, uAlign, stRange.uOffset);
+        TEST_CHECK(stRange.lNode != TlsfAllocator::kInvalidNode);
+        TEST_CHECK_EQ(stRange.uOffset % uAlign, 0u);
+        vecLive.push_back(stRange);
+    }
+    CheckAgainstLive(tlsf, vecLive);
+
+    // Alignment padding stays allocatable: a small request goes into a hole, not the free tail
+    uint64_t uLiveEnd = 0u;
+    for (const LiveRange& stRange : vecLive)
+        uLiveEnd = std::max(uLiveEnd, stRange.uOffset + stRange.uSize);
+    const uint32_t lSmall = tlsf.Allocate(16u, 1u, uOffset);
+    TEST_CHECK(lSmall != TlsfAllocator::kInvalidNode);
+    TEST_CHECK(uOffset < uLiveEnd);
+    tlsf.Free(lSmall);
+    for (const LiveRange& stRange : vecLive)
+        tlsf.Free(stRange.lNode);
+    TEST_CHECK(tlsf.IsEmpty());
+    TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 1u);
+}
+
+void TestRandomized() {
+    constexpr uint64_t kSize = 16ull << 20;
+    TlsfAllocator tlsf(kSize);
+    std::vector<LiveRange> vecLive;
+    uint32_t uState = 12345u;
+    uint32_t lFailures = 0u;
+    for (uint32_t lStep = 0u; lStep < 20000u; ++lStep) {
+        const bool bFree = (vecLive.empty() == false) && ((NextRandom(uState) % 100u) < 45u);
+        if (bFree == true) {
+            const size_t zIndex = NextRandom(uState) % vecLive.size();
+            tlsf.Free(vecLive[zIndex].lNode);
+            vecLive[zIndex] = vecLive.back();
+            vecLive.pop_back();
+        } else {
+            LiveRange stRange;
+            // Mostly small, sometimes up to 1 MiB; alignments 1 .. 64 KiB
+            const uint32_t lShift = NextRandom(uState) % ((NextRandom(uState) % 8u == 0u) ? 20u : 14u);
+            stRange.uSize = 1u + NextRandom(uState) % (uint32_t{1} << lShift);
+            const uint64_t uAlign = uint64_t{1} << (NextRandom(uState) % 17u);
+            stRange.lNode = tlsf.Allocate(stRange.uSize, uAlign, stRange.uOffset);
+            if (stRange.lNode == TlsfAllocator::kInvalidNode) {
+                ++lFailures;
+                continue;
+            }
+            TEST_CHECK_EQ(stRange.uOffset % uAlign, 0u);
+            vecLive.push_back(stRange);
+        }
+        if (lStep % 500u == 0u)
+            CheckAgainstLive(tlsf, vecLive);
+    }
+    CheckAgainstLive(tlsf, vecLive);
+    std::printf("test_tlsf_allocator: random run ended with %zu live ranges, %u free ranges, %u failed requests\n",
+                vecLive.size(), tlsf.GetFreeRangeCount(), lFailures);
+    for (const LiveRange& stRange : vecLive)
+        tlsf.Free(stRange.lNode);
+    TEST_CHECK(tlsf.IsEmpty());
+    TEST_CHECK_EQ(tlsf.GetFreeRangeCount(), 1u);
+    TEST_CHECK_EQ(tlsf.GetLargestFreeRange(), kSize);
+
+    // Reset forgets everything
+    uint64_t uOffset = 0u;
+    tlsf.Allocate(4096u, 1u, uOffset);
+    tlsf.Reset(8192u);
+    TEST_CHECK(tlsf.IsEmpty());
+    TEST_CHECK_EQ(tlsf.GetSize(), 8192u);
+    TEST_CHECK_EQ(tlsf.GetLargestFreeRange(), 8192u);
+}
+
+} // namespace
+
+int main() {
+    TestExactFitAndExhaustion();
+    TestCoalescing();
+    TestAlignment();
+    TestRandomized();
+    return Test::Finish("test_tlsf_allocator");
+}